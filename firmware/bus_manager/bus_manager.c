@@ -59,6 +59,11 @@ esp_err_t busmngr_ClaimInterface(BusUser_t user, BusMode_t mode) {
                 gpio_set_level((gpio_num_t)CONFIG_BUS_VOLTAGE_VOUT_CTRL, 1u);
                 retval = linmaster_enable();
                 break;
+            case MODE_MONITOR:
+                /* the bus is only listened to, the LIN master stays disabled */
+                gpio_set_level((gpio_num_t)CONFIG_BUS_VOLTAGE_VOUT_CTRL, 1u);
+                retval = ESP_OK;
+                break;
             default:
                 retval = ESP_OK;
                 break;
@@ -84,6 +89,9 @@ esp_err_t busmngr_ReleaseInterface(BusUser_t user, BusMode_t mode) {
                 gpio_set_level((gpio_num_t)CONFIG_BUS_VOLTAGE_VOUT_CTRL, 0u);
                 (void)linmaster_disable();
                 break;
+            case MODE_MONITOR:
+                gpio_set_level((gpio_num_t)CONFIG_BUS_VOLTAGE_VOUT_CTRL, 0u);
+                break;
             default:
                 break;
         }
@@ -30,6 +30,7 @@ typedef enum BusUser_e {
     USER_UNKNOWN = 0,
     USER_WIFI,
     USER_USB_VENDOR,
+    USER_STANDALONE,
 } BusUser_t;
 
 typedef enum UartMode_e {
@@ -37,6 +38,7 @@ typedef enum UartMode_e {
     MODE_BOOTLOADER,
     MODE_APPLICATION,
     MODE_OTA,
+    MODE_MONITOR,
 } BusMode_t;
 
 /** initialize the bus manager module */
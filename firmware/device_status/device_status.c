@@ -29,6 +29,8 @@
 static bool booting = true;
 static uint8_t identify_cnt = 0u;
 static uint8_t heartbeat_cnt = 0u;
+static volatile devstat_job_t job_status = DEVSTAT_JOB_NONE;
+static uint8_t job_cnt = 0u;
 
 static void devstat_enableHeartbeat(void) {
     gpio_set_level((gpio_num_t)CONFIG_LED_HEARTBEAT, 0u);
@@ -46,6 +48,33 @@ static void devstat_disableStatus(void) {
     gpio_set_level((gpio_num_t)CONFIG_LED_STATUS, 1u);
 }
 
+static void devstat_showJobStatus(void) {
+    switch (job_status) {
+        case DEVSTAT_JOB_BUSY:
+            if ((job_cnt % 2) == 0) {
+                devstat_enableStatus();
+            } else {
+                devstat_disableStatus();
+            }
+            break;
+        case DEVSTAT_JOB_PASS:
+            devstat_enableStatus();
+            break;
+        case DEVSTAT_JOB_FAIL:
+            /* two short flashes every 8 ticks */
+            if (((job_cnt % 8) == 0) || ((job_cnt % 8) == 2)) {
+                devstat_enableStatus();
+            } else {
+                devstat_disableStatus();
+            }
+            break;
+        default:
+            break;
+    }
+
+    job_cnt++;
+}
+
 void devstat_init(void) {
     gpio_reset_pin((gpio_num_t)CONFIG_LED_HEARTBEAT);
     gpio_set_direction((gpio_num_t)CONFIG_LED_HEARTBEAT, GPIO_MODE_OUTPUT);
@@ -81,6 +110,8 @@ void devstat_tick(void) {
             hb_mask = 0x3;
         }
         heartbeat_cnt &= hb_mask;
+
+        devstat_showJobStatus();
     } else {
         /* identification ongoing */
         if ((identify_cnt % 2) == 0) {
@@ -108,3 +139,8 @@ void devstat_stopIdentify(void) {
     devstat_disableHeartbeat();
     devstat_disableStatus();
 }
+
+void devstat_setJobStatus(devstat_job_t job) {
+    job_cnt = 0u;
+    job_status = job;
+}
@@ -22,6 +22,14 @@
 #ifndef DEVICE_STATUS_H_
     #define CHIP_UART_ITF_H_
 
+/** state of a stand-alone programming job, shown on the status LED */
+typedef enum devstat_job_e {
+    DEVSTAT_JOB_NONE = 0,                       /**< no job was started, the status LED is off */
+    DEVSTAT_JOB_BUSY,                           /**< job is running, the status LED blinks */
+    DEVSTAT_JOB_PASS,                           /**< last job passed, the status LED is on */
+    DEVSTAT_JOB_FAIL,                           /**< last job failed, the status LED flashes twice every 2 s */
+} devstat_job_t;
+
 /** initialize the device status module */
 void devstat_init(void);
 
@@ -33,4 +41,10 @@ void devstat_startIdentify(void);
 
 void devstat_stopIdentify(void);
 
+/** show the state of a stand-alone programming job
+ *
+ * @param[in]  job  state of the job.
+ */
+void devstat_setJobStatus(devstat_job_t job);
+
 #endif  /* DEVICE_STATUS_H_ */
@@ -0,0 +1,479 @@
+/**
+ * @file
+ * @brief Firmware image cache routines.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the implementations of the firmware image cache.
+ */
+#include <dirent.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_spiffs.h"
+#include "mbedtls/sha256.h"
+
+#include "sdkconfig.h"
+#include "jobs.h"
+#include "mlx_err.h"
+
+#include "fw_cache.h"
+
+static const char *TAG = "fw-cache";
+
+/** mount point of the cache partition */
+#define FWCACHE_BASE_PATH "/cache"
+
+/** path of the stored index */
+#define FWCACHE_INDEX_PATH FWCACHE_BASE_PATH "/index"
+
+/** path of the index while it is written */
+#define FWCACHE_INDEX_TMP_PATH FWCACHE_BASE_PATH "/index.tmp"
+
+/** number of hash characters in the file name of an image, spiffs limits the length of the names */
+#define FWCACHE_NAME_HASH_CHARS 32u
+
+/** maximum length of the path of an image */
+#define FWCACHE_PATH_LEN (sizeof(FWCACHE_BASE_PATH "/.img") + FWCACHE_NAME_HASH_CHARS)
+
+/** number of bytes read from an image file at once */
+#define FWCACHE_READ_CHUNK 512u
+
+/** Output of the binary image writer, hashes and optionally stores the image */
+typedef struct fwcache_writer_s {
+    mbedtls_sha256_context *sha;                /**< hash of the image, NULL to skip hashing */
+    FILE *file;                                 /**< file to store the image in, NULL to skip storing */
+    uint32_t size;                              /**< number of bytes written */
+} fwcache_writer_t;
+
+/** index of the cached images */
+static fwcache_index_t cache_index;
+
+/** space available for the images (bytes), 0 when the cache is not mounted */
+static uint32_t cache_capacity = 0u;
+
+/** lock of the cache, the USB and websocket interfaces can use it at the same time */
+static SemaphoreHandle_t cache_lock = NULL;
+
+/** Binary image writer output
+ *
+ * @param[in]  data  next bytes of the binary image.
+ * @param[in]  length  number of bytes.
+ * @param[in]  ctx  writer.
+ * @returns  true when the bytes are written.
+ */
+static bool fwcache_writer_output(const uint8_t *data, size_t length, void *ctx);
+
+/** Write an image, hashing and/or storing it
+ *
+ * @param[in]  image  image.
+ * @param[out]  hash  content hash, NULL to skip hashing.
+ * @param[in]  file  file to store the image in, NULL to skip storing.
+ * @returns  size of the binary image (bytes), 0 when writing the file failed.
+ */
+static uint32_t fwcache_write(const fwimg_t *image, uint8_t *hash, FILE *file);
+
+/** Get the path of a cached image
+ *
+ * @param[in]  hash  content hash of the image.
+ * @param[out]  path  path of FWCACHE_PATH_LEN characters.
+ */
+static void fwcache_path(const uint8_t *hash, char *path);
+
+/** Store the index
+ *
+ * @returns  true when the index is stored.
+ */
+static bool fwcache_save_index(void);
+
+/** Read the index, drop the images without a file and delete the files without an image
+ *
+ * @retval  true  index was changed and must be stored.
+ */
+static bool fwcache_load_index(void);
+
+/** Store an image copy in the cache, in the job worker task
+ *
+ * @param[in]  id  job id (not used).
+ * @param[in]  arg  image copy (fwimg_t).
+ * @param[out]  error  mlx error code when the image could not be stored.
+ * @returns  true when the image is cached.
+ */
+static bool fwcache_store_job_run(uint32_t id, void *arg, int32_t *error);
+
+/** Release the image copy of a store job, in the job worker task
+ *
+ * @param[in]  id  job id (not used).
+ * @param[in]  state  final state of the job (not used).
+ * @param[in]  error  error code of a failed job (not used).
+ * @param[in]  arg  image copy (fwimg_t).
+ */
+static void fwcache_store_job_done(uint32_t id, job_state_t state, int32_t error, void *arg);
+
+
+static bool fwcache_writer_output(const uint8_t *data, size_t length, void *ctx) {
+    fwcache_writer_t *writer = (fwcache_writer_t *)ctx;
+    bool retval = true;
+
+    if (writer->sha != NULL) {
+        (void)mbedtls_sha256_update(writer->sha, data, length);
+    }
+    if (writer->file != NULL) {
+        retval = (fwrite(data, 1u, length, writer->file) == length);
+    }
+    writer->size += (uint32_t)length;
+
+    return retval;
+}
+
+static uint32_t fwcache_write(const fwimg_t *image, uint8_t *hash, FILE *file) {
+    mbedtls_sha256_context sha;
+    fwcache_writer_t writer = {
+        .sha = (hash != NULL) ? &sha : NULL,
+        .file = file,
+        .size = 0u,
+    };
+
+    mbedtls_sha256_init(&sha);
+    (void)mbedtls_sha256_starts(&sha, 0);
+    bool written = fwimg_bin_write(image, fwcache_writer_output, &writer);
+    if (hash != NULL) {
+        (void)mbedtls_sha256_finish(&sha, hash);
+    }
+    mbedtls_sha256_free(&sha);
+
+    return written ? writer.size : 0u;
+}
+
+static void fwcache_path(const uint8_t *hash, char *path) {
+    char hash_str[FWCACHE_HASH_STR_LEN];
+
+    fwcache_hash_to_string(hash, hash_str);
+    (void)snprintf(path, FWCACHE_PATH_LEN, FWCACHE_BASE_PATH "/%.32s.img", hash_str);
+}
+
+static bool fwcache_save_index(void) {
+    bool retval = false;
+    FILE *file = fopen(FWCACHE_INDEX_TMP_PATH, "wb");
+
+    if (file != NULL) {
+        retval = (fwrite(&cache_index, sizeof(cache_index), 1u, file) == 1u);
+        retval = (fclose(file) == 0) && retval;
+    }
+    /* spiffs does not rename onto an existing file */
+    if (retval) {
+        (void)unlink(FWCACHE_INDEX_PATH);
+        retval = (rename(FWCACHE_INDEX_TMP_PATH, FWCACHE_INDEX_PATH) == 0);
+    }
+    if (!retval) {
+        ESP_LOGE(TAG, "storing the index failed");
+    }
+
+    return retval;
+}
+
+static bool fwcache_load_index(void) {
+    bool changed = false;
+    FILE *file = fopen(FWCACHE_INDEX_PATH, "rb");
+
+    if ((file == NULL) ||
+        (fread(&cache_index, sizeof(cache_index), 1u, file) != 1u) ||
+        !fwcache_index_valid(&cache_index)) {
+        ESP_LOGW(TAG, "no valid index, the cache is cleared");
+        fwcache_index_init(&cache_index);
+        changed = true;
+    }
+    if (file != NULL) {
+        (void)fclose(file);
+    }
+
+    /* images of which the file is lost, e.g. by a power loss while storing */
+    uint32_t i = 0u;
+    while (i < cache_index.nr_of_entries) {
+        char path[FWCACHE_PATH_LEN];
+        struct stat st;
+        fwcache_path(cache_index.entries[i].hash, path);
+        if ((stat(path, &st) != 0) || ((uint32_t)st.st_size != cache_index.entries[i].size)) {
+            ESP_LOGW(TAG, "dropping %s", path);
+            (void)unlink(path);
+            (void)fwcache_index_remove(&cache_index, cache_index.entries[i].hash);
+            changed = true;
+        } else {
+            i++;
+        }
+    }
+
+    /* files which are not in the index */
+    DIR *dir = opendir(FWCACHE_BASE_PATH);
+    if (dir != NULL) {
+        struct dirent *entry;
+        while ((entry = readdir(dir)) != NULL) {
+            char path[FWCACHE_PATH_LEN + 64u];
+            bool known = (strcmp(entry->d_name, "index") == 0);
+            (void)snprintf(path, sizeof(path), FWCACHE_BASE_PATH "/%s", entry->d_name);
+            for (i = 0u; !known && (i < cache_index.nr_of_entries); i++) {
+                char image_path[FWCACHE_PATH_LEN];
+                fwcache_path(cache_index.entries[i].hash, image_path);
+                known = (strcmp(path, image_path) == 0);
+            }
+            if (!known) {
+                ESP_LOGW(TAG, "deleting %s", path);
+                (void)unlink(path);
+            }
+        }
+        (void)closedir(dir);
+    }
+
+    return changed;
+}
+
+esp_err_t fwcache_init(void) {
+    const esp_vfs_spiffs_conf_t conf = {
+        .base_path = FWCACHE_BASE_PATH,
+        .partition_label = CONFIG_FW_CACHE_PARTITION_LABEL,
+        .max_files = 2,
+        .format_if_mount_failed = true,
+    };
+    size_t total = 0u;
+    size_t used = 0u;
+
+    cache_lock = xSemaphoreCreateMutex();
+    esp_err_t retval = esp_vfs_spiffs_register(&conf);
+    if (retval == ESP_OK) {
+        retval = esp_spiffs_info(conf.partition_label, &total, &used);
+    }
+    if (retval == ESP_OK) {
+        if (fwcache_load_index()) {
+            (void)fwcache_save_index();
+        }
+        /* spiffs slows down when it is almost full */
+        cache_capacity = (uint32_t)((total * CONFIG_FW_CACHE_FILL_PERCENT) / 100u);
+        ESP_LOGI(TAG, "%lu images, %lu of %lu bytes used",
+                 cache_index.nr_of_entries,
+                 fwcache_index_used(&cache_index),
+                 cache_capacity);
+    } else {
+        ESP_LOGE(TAG, "mounting partition %s failed (%s)", conf.partition_label, esp_err_to_name(retval));
+    }
+
+    return retval;
+}
+
+esp_err_t fwcache_hash(const fwimg_t *image, uint8_t *hash) {
+    esp_err_t retval = ESP_ERR_INVALID_ARG;
+
+    if (fwimg_pages_present(image) > 0u) {
+        (void)fwcache_write(image, hash, NULL);
+        retval = ESP_OK;
+    }
+
+    return retval;
+}
+
+esp_err_t fwcache_store(const fwimg_t *image, uint8_t *hash) {
+    esp_err_t retval = ESP_ERR_INVALID_STATE;
+
+    if (cache_capacity == 0u) {
+        ESP_LOGW(TAG, "cache is not mounted");
+    } else if (fwimg_pages_present(image) == 0u) {
+        retval = ESP_ERR_INVALID_ARG;
+    } else {
+        /* hash first, a cached image is not written again */
+        uint32_t size = fwcache_write(image, hash, NULL);
+
+        (void)xSemaphoreTake(cache_lock, portMAX_DELAY);
+        fwcache_entry_t *entry = fwcache_index_find(&cache_index, hash);
+        if (entry != NULL) {
+            fwcache_index_touch(&cache_index, entry);
+            retval = fwcache_save_index() ? ESP_OK : ESP_FAIL;
+        } else if (size > cache_capacity) {
+            retval = ESP_ERR_NO_MEM;
+        } else {
+            char path[FWCACHE_PATH_LEN];
+            fwcache_entry_t evicted;
+            while (fwcache_index_evict(&cache_index, size, cache_capacity, &evicted)) {
+                fwcache_path(evicted.hash, path);
+                ESP_LOGI(TAG, "evicting %s", path);
+                (void)unlink(path);
+            }
+            /* the index is stored before the new image, an unfinished image is deleted at startup */
+            (void)fwcache_save_index();
+
+            fwcache_path(hash, path);
+            FILE *file = fopen(path, "wb");
+            if (file != NULL) {
+                bool written = (fwcache_write(image, NULL, file) == size);
+                written = (fclose(file) == 0) && written;
+                if (written && (fwcache_index_add(&cache_index, hash, size) != NULL) && fwcache_save_index()) {
+                    ESP_LOGI(TAG, "stored %s (%lu bytes)", path, size);
+                    retval = ESP_OK;
+                } else {
+                    (void)fwcache_index_remove(&cache_index, hash);
+                    (void)unlink(path);
+                    retval = ESP_FAIL;
+                }
+            } else {
+                retval = ESP_FAIL;
+            }
+        }
+        (void)xSemaphoreGive(cache_lock);
+    }
+
+    return retval;
+}
+
+static bool fwcache_store_job_run(uint32_t id, void *arg, int32_t *error) {
+    (void)id;
+    uint8_t hash[FWCACHE_HASH_LEN];
+    esp_err_t cached = fwcache_store((const fwimg_t *)arg, hash);
+
+    if (cached != ESP_OK) {
+        ESP_LOGW(TAG, "image not cached (%s)", esp_err_to_name(cached));
+        *error = MLX_FAIL_SERVER_ERR;
+    }
+
+    return cached == ESP_OK;
+}
+
+static void fwcache_store_job_done(uint32_t id, job_state_t state, int32_t error, void *arg) {
+    (void)id;
+    (void)state;
+    (void)error;
+    fwimg_t *copy = (fwimg_t *)arg;
+
+    fwimg_free(copy);
+    free(copy);
+}
+
+esp_err_t fwcache_store_background(const fwimg_t *image, uint8_t *hash) {
+    esp_err_t retval = ESP_ERR_INVALID_STATE;
+
+    if (cache_capacity != 0u) {
+        retval = fwcache_hash(image, hash);
+    }
+
+    if (retval == ESP_OK) {
+        /* the job gets its own image, the caller may change or free it meanwhile */
+        fwimg_t *copy = malloc(sizeof(fwimg_t));
+        if (copy != NULL) {
+            fwimg_init_psram(copy);
+        }
+        if ((copy == NULL) || !fwimg_copy(image, copy)) {
+            retval = ESP_ERR_NO_MEM;
+        } else if (jobs_submit(JOB_KIND_CACHE_STORE, fwcache_store_job_run, fwcache_store_job_done, copy, NULL) != ESP_OK) {
+            retval = ESP_ERR_NO_MEM;
+        }
+        if ((retval != ESP_OK) && (copy != NULL)) {
+            fwimg_free(copy);
+            free(copy);
+        }
+    }
+
+    return retval;
+}
+
+esp_err_t fwcache_load(const uint8_t *hash, fwimg_t *image) {
+    esp_err_t retval = ESP_ERR_NOT_FOUND;
+
+    if (cache_capacity == 0u) {
+        retval = ESP_ERR_INVALID_STATE;
+    } else {
+        (void)xSemaphoreTake(cache_lock, portMAX_DELAY);
+        fwcache_entry_t *entry = fwcache_index_find(&cache_index, hash);
+        if (entry != NULL) {
+            char path[FWCACHE_PATH_LEN];
+            uint8_t chunk[FWCACHE_READ_CHUNK];
+            fwimg_loader_t loader;
+            fwimg_load_result_t load = FWIMG_LOAD_ERR_INCOMPLETE;
+
+            fwcache_path(hash, path);
+            FILE *file = fopen(path, "rb");
+            if (file != NULL) {
+                size_t length;
+                fwimg_loader_init(&loader, image);
+                while ((length = fread(chunk, 1u, sizeof(chunk), file)) > 0u) {
+                    (void)fwimg_loader_feed(&loader, chunk, length);
+                }
+                (void)fclose(file);
+                load = fwimg_loader_finish(&loader);
+            }
+
+            if (load == FWIMG_LOAD_OK) {
+                fwcache_index_touch(&cache_index, entry);
+                retval = fwcache_save_index() ? ESP_OK : ESP_FAIL;
+            } else {
+                /* a corrupt image is removed, it has to be uploaded again */
+                ESP_LOGE(TAG, "%s: %s", path, fwimg_loader_result_to_string(load));
+                (void)fwcache_index_remove(&cache_index, hash);
+                (void)fwcache_save_index();
+                (void)unlink(path);
+                retval = ESP_ERR_INVALID_CRC;
+            }
+        }
+        (void)xSemaphoreGive(cache_lock);
+    }
+
+    return retval;
+}
+
+bool fwcache_contains(const uint8_t *hash) {
+    bool retval = false;
+
+    if (cache_capacity != 0u) {
+        (void)xSemaphoreTake(cache_lock, portMAX_DELAY);
+        retval = (fwcache_index_find(&cache_index, hash) != NULL);
+        (void)xSemaphoreGive(cache_lock);
+    }
+
+    return retval;
+}
+
+esp_err_t fwcache_pin(const uint8_t *hash, bool pinned) {
+    esp_err_t retval = ESP_ERR_INVALID_STATE;
+
+    if (cache_capacity != 0u) {
+        (void)xSemaphoreTake(cache_lock, portMAX_DELAY);
+        if (fwcache_index_pin(&cache_index, hash, pinned)) {
+            retval = fwcache_save_index() ? ESP_OK : ESP_FAIL;
+        } else {
+            retval = ESP_ERR_NOT_FOUND;
+        }
+        (void)xSemaphoreGive(cache_lock);
+    }
+
+    return retval;
+}
+
+uint32_t fwcache_list(fwcache_entry_t *entries) {
+    uint32_t retval = 0u;
+
+    if (cache_capacity != 0u) {
+        (void)xSemaphoreTake(cache_lock, portMAX_DELAY);
+        retval = fwcache_index_sorted(&cache_index, entries);
+        (void)xSemaphoreGive(cache_lock);
+    }
+
+    return retval;
+}
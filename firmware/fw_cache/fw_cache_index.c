@@ -0,0 +1,189 @@
+/**
+ * @file
+ * @brief Firmware image cache index routines.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the implementations of the index of the firmware image cache.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "fw_cache_index.h"
+
+/** Get the value of a hexadecimal character
+ *
+ * @param[in]  chr  character.
+ * @returns  value (0..15), -1 when chr is not a hexadecimal character.
+ */
+static int fwcache_hex_value(char chr);
+
+
+static int fwcache_hex_value(char chr) {
+    int retval = -1;
+
+    if ((chr >= '0') && (chr <= '9')) {
+        retval = chr - '0';
+    } else if ((chr >= 'a') && (chr <= 'f')) {
+        retval = chr - 'a' + 10;
+    } else if ((chr >= 'A') && (chr <= 'F')) {
+        retval = chr - 'A' + 10;
+    }
+
+    return retval;
+}
+
+void fwcache_index_init(fwcache_index_t *index) {
+    memset(index, 0, sizeof(fwcache_index_t));
+    index->magic = FWCACHE_INDEX_MAGIC;
+}
+
+bool fwcache_index_valid(const fwcache_index_t *index) {
+    bool retval = (index->magic == FWCACHE_INDEX_MAGIC) && (index->nr_of_entries <= FWCACHE_MAX_ENTRIES);
+
+    for (uint32_t i = 0u; retval && (i < index->nr_of_entries); i++) {
+        retval = (index->entries[i].last_used <= index->sequence);
+    }
+
+    return retval;
+}
+
+fwcache_entry_t *fwcache_index_find(fwcache_index_t *index, const uint8_t *hash) {
+    fwcache_entry_t *retval = NULL;
+
+    for (uint32_t i = 0u; (retval == NULL) && (i < index->nr_of_entries); i++) {
+        if (memcmp(index->entries[i].hash, hash, FWCACHE_HASH_LEN) == 0) {
+            retval = &index->entries[i];
+        }
+    }
+
+    return retval;
+}
+
+void fwcache_index_touch(fwcache_index_t *index, fwcache_entry_t *entry) {
+    index->sequence++;
+    entry->last_used = index->sequence;
+}
+
+uint32_t fwcache_index_used(const fwcache_index_t *index) {
+    uint32_t retval = 0u;
+
+    for (uint32_t i = 0u; i < index->nr_of_entries; i++) {
+        retval += index->entries[i].size;
+    }
+
+    return retval;
+}
+
+bool fwcache_index_evict(fwcache_index_t *index, uint32_t size, uint32_t capacity, fwcache_entry_t *evicted) {
+    bool retval = false;
+
+    if ((index->nr_of_entries == FWCACHE_MAX_ENTRIES) || ((fwcache_index_used(index) + size) > capacity)) {
+        uint32_t lru = index->nr_of_entries;
+        for (uint32_t i = 0u; i < index->nr_of_entries; i++) {
+            if ((index->entries[i].pinned == 0u) &&
+                ((lru == index->nr_of_entries) || (index->entries[i].last_used < index->entries[lru].last_used))) {
+                lru = i;
+            }
+        }
+        if (lru < index->nr_of_entries) {
+            *evicted = index->entries[lru];
+            index->nr_of_entries--;
+            index->entries[lru] = index->entries[index->nr_of_entries];
+            retval = true;
+        }
+    }
+
+    return retval;
+}
+
+fwcache_entry_t *fwcache_index_add(fwcache_index_t *index, const uint8_t *hash, uint32_t size) {
+    fwcache_entry_t *retval = fwcache_index_find(index, hash);
+
+    if ((retval == NULL) && (index->nr_of_entries < FWCACHE_MAX_ENTRIES)) {
+        retval = &index->entries[index->nr_of_entries];
+        index->nr_of_entries++;
+        memcpy(retval->hash, hash, FWCACHE_HASH_LEN);
+        retval->pinned = 0u;
+    }
+    if (retval != NULL) {
+        retval->size = size;
+        fwcache_index_touch(index, retval);
+    }
+
+    return retval;
+}
+
+bool fwcache_index_pin(fwcache_index_t *index, const uint8_t *hash, bool pinned) {
+    fwcache_entry_t *entry = fwcache_index_find(index, hash);
+
+    if (entry != NULL) {
+        entry->pinned = pinned ? 1u : 0u;
+    }
+
+    return (entry != NULL);
+}
+
+bool fwcache_index_remove(fwcache_index_t *index, const uint8_t *hash) {
+    fwcache_entry_t *entry = fwcache_index_find(index, hash);
+
+    if (entry != NULL) {
+        index->nr_of_entries--;
+        *entry = index->entries[index->nr_of_entries];
+    }
+
+    return (entry != NULL);
+}
+
+uint32_t fwcache_index_sorted(const fwcache_index_t *index, fwcache_entry_t *entries) {
+    /* insertion sort, the index holds only a few images */
+    for (uint32_t i = 0u; i < index->nr_of_entries; i++) {
+        uint32_t pos = i;
+        while ((pos > 0u) && (entries[pos - 1u].last_used < index->entries[i].last_used)) {
+            entries[pos] = entries[pos - 1u];
+            pos--;
+        }
+        entries[pos] = index->entries[i];
+    }
+
+    return index->nr_of_entries;
+}
+
+void fwcache_hash_to_string(const uint8_t *hash, char *str) {
+    static const char digits[] = "0123456789abcdef";
+
+    for (uint32_t i = 0u; i < FWCACHE_HASH_LEN; i++) {
+        str[2u * i] = digits[hash[i] >> 4];
+        str[(2u * i) + 1u] = digits[hash[i] & 0x0Fu];
+    }
+    str[2u * FWCACHE_HASH_LEN] = '\0';
+}
+
+bool fwcache_hash_from_string(const char *str, uint8_t *hash) {
+    bool retval = (strlen(str) == (2u * FWCACHE_HASH_LEN));
+
+    for (uint32_t i = 0u; retval && (i < FWCACHE_HASH_LEN); i++) {
+        int high = fwcache_hex_value(str[2u * i]);
+        int low = fwcache_hex_value(str[(2u * i) + 1u]);
+        if ((high < 0) || (low < 0)) {
+            retval = false;
+        } else {
+            hash[i] = (uint8_t)((high << 4) | low);
+        }
+    }
+
+    return retval;
+}
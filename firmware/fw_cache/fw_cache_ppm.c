@@ -0,0 +1,163 @@
+/**
+ * @file
+ * @brief Differential programming with the firmware image cache.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the implementations of programming with the PPM bootloader which
+ * remembers the image programmed in every memory. A differential program compares the new image
+ * with that image page by page and only programs the pages which differ.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "esp_err.h"
+#include "esp_log.h"
+
+#include "ppm_bootloader.h"
+
+#include "fw_cache.h"
+
+static const char *TAG = "fw-cache-ppm";
+
+/** number of memories of which the programmed image is remembered */
+#define FWCACHE_NR_OF_MEMORIES 3u
+
+/** content hash of the image programmed last, per memory */
+static uint8_t programmed_hash[FWCACHE_NR_OF_MEMORIES][FWCACHE_HASH_LEN];
+
+/** programmed_hash holds the image programmed last, per memory */
+static bool programmed_valid[FWCACHE_NR_OF_MEMORIES] = {false};
+
+/** Get the index of a memory in the programmed images
+ *
+ * @param[in]  memory  memory.
+ * @returns  index, FWCACHE_NR_OF_MEMORIES for an invalid memory.
+ */
+static uint32_t fwcache_memory_index(ppm_memory_t memory);
+
+/** Program the pages of an image which differ from the image in the memory
+ *
+ * The chip is first verified against the reference image, such that no pages are skipped when the
+ * memory was changed in the meantime (e.g. another chip is connected). After programming the
+ * pages which differ, the complete image is verified.
+ *
+ * @param[in]  manpow  true: manual power cycling.
+ * @param[in]  bitrate  bitrate of the bootloader.
+ * @param[in]  memory  memory to program.
+ * @param[in]  image  image to program.
+ * @param[in]  reference_hash  content hash of the image programmed before.
+ * @param[out]  skipped  number of pages which were not programmed.
+ * @retval  true  the memory holds the image.
+ * @retval  false  the reference is not available or not in the memory, or programming failed.
+ */
+static bool fwcache_ppm_delta(bool manpow,
+                              uint32_t bitrate,
+                              ppm_memory_t memory,
+                              const fwimg_t *image,
+                              const uint8_t *reference_hash,
+                              uint32_t *skipped);
+
+
+static uint32_t fwcache_memory_index(ppm_memory_t memory) {
+    uint32_t retval = FWCACHE_NR_OF_MEMORIES;
+
+    switch (memory) {
+        case PPM_MEM_NVRAM:
+            retval = 0u;
+            break;
+        case PPM_MEM_FLASH:
+            retval = 1u;
+            break;
+        case PPM_MEM_FLASH_CS:
+            retval = 2u;
+            break;
+        default:
+            break;
+    }
+
+    return retval;
+}
+
+static bool fwcache_ppm_delta(bool manpow,
+                              uint32_t bitrate,
+                              ppm_memory_t memory,
+                              const fwimg_t *image,
+                              const uint8_t *reference_hash,
+                              uint32_t *skipped) {
+    bool retval = false;
+    fwimg_t reference;
+    fwimg_t delta;
+
+    fwimg_init_psram(&reference);
+    fwimg_init_psram(&delta);
+    if ((fwcache_load(reference_hash, &reference) == ESP_OK) &&
+        fwimg_delta(image, &reference, &delta, skipped) &&
+        (fwimg_ppm_action(manpow, false, bitrate, memory, PPM_ACT_VERIFY, &reference) == PPM_OK)) {
+        retval = (fwimg_pages_present(&delta) == 0u) ||
+                 ((fwimg_ppm_action(manpow, false, bitrate, memory, PPM_ACT_PROGRAM, &delta) == PPM_OK) &&
+                  (fwimg_ppm_action(manpow, false, bitrate, memory, PPM_ACT_VERIFY, image) == PPM_OK));
+    }
+
+    if (retval) {
+        ESP_LOGI(TAG, "%lu of %lu pages skipped", *skipped, fwimg_pages_present(image));
+    } else {
+        ESP_LOGI(TAG, "differential program not possible, programming all pages");
+    }
+    fwimg_free(&delta);
+    fwimg_free(&reference);
+
+    return retval;
+}
+
+ppm_err_t fwcache_ppm_program(bool manpow,
+                              bool broadcast,
+                              uint32_t bitrate,
+                              ppm_memory_t memory,
+                              const fwimg_t *image,
+                              bool differential,
+                              uint32_t *skipped) {
+    ppm_err_t retval = PPM_OK;
+    uint8_t hash[FWCACHE_HASH_LEN];
+    uint32_t mem_index = fwcache_memory_index(memory);
+    bool hashed = (fwcache_hash(image, hash) == ESP_OK);
+    bool programmed = false;
+
+    /* the image is written to the cache, to be the reference of the next program, only when
+     * differential programming is used; a cached image is marked as most recently used */
+    if (hashed && (differential || fwcache_contains(hash))) {
+        (void)fwcache_store(image, hash);
+    }
+
+    *skipped = 0u;
+    /* in broadcast mode the chips do not respond to the verification of the reference */
+    if (differential && !broadcast && (mem_index < FWCACHE_NR_OF_MEMORIES) && programmed_valid[mem_index]) {
+        programmed = fwcache_ppm_delta(manpow, bitrate, memory, image, programmed_hash[mem_index], skipped);
+    }
+    if (!programmed) {
+        *skipped = 0u;
+        retval = fwimg_ppm_action(manpow, broadcast, bitrate, memory, PPM_ACT_PROGRAM, image);
+    }
+
+    /* only the hash is remembered, the delta falls back to programming all pages when the
+     * reference is not cached (anymore) */
+    if (mem_index < FWCACHE_NR_OF_MEMORIES) {
+        programmed_valid[mem_index] = hashed && (retval == PPM_OK);
+        memcpy(programmed_hash[mem_index], hash, FWCACHE_HASH_LEN);
+    }
+
+    return retval;
+}
@@ -0,0 +1,136 @@
+/**
+ * @file
+ * @brief Firmware image cache definitions.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the definitions of the firmware image cache.
+ *
+ * Uploaded images are stored in the spiffs data partition in the binary image format, keyed by the
+ * SHA-256 hash of that binary image. The hash of an image equals the hash of the file produced by
+ * the converter script, such that a client can program a cached image without uploading it again.
+ * When the partition is full, or the maximum number of images is reached, the least recently used
+ * images are removed, except for pinned images such as the image of the stand-alone mode.
+ *
+ * The image programmed last in every memory is remembered, such that a differential program only
+ * programs the pages which changed since.
+ */
+
+#ifndef FW_CACHE_H_
+    #define FW_CACHE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+#include "fw_image.h"
+#include "ppm_bootloader.h"
+
+#include "fw_cache_index.h"
+
+/** Mount the cache partition and read the index of the cached images
+ *
+ * @returns  ESP_OK when the cache can be used.
+ */
+esp_err_t fwcache_init(void);
+
+/** Calculate the content hash of an image
+ *
+ * @param[in]  image  image.
+ * @param[out]  hash  content hash (FWCACHE_HASH_LEN bytes).
+ * @returns  ESP_OK when the hash is calculated, ESP_ERR_INVALID_ARG when the image is empty.
+ */
+esp_err_t fwcache_hash(const fwimg_t *image, uint8_t *hash);
+
+/** Store an image in the cache, or mark it as most recently used when it is already cached
+ *
+ * @param[in]  image  finalized image.
+ * @param[out]  hash  content hash of the image (FWCACHE_HASH_LEN bytes).
+ * @returns  ESP_OK when the image is cached, ESP_ERR_NO_MEM when it does not fit in the partition.
+ */
+esp_err_t fwcache_store(const fwimg_t *image, uint8_t *hash);
+
+/** Store an image in the cache from a job, such that the caller does not wait for the flash writes
+ *
+ * The image is copied, the caller keeps ownership of it.
+ *
+ * @param[in]  image  finalized image.
+ * @param[out]  hash  content hash of the image (FWCACHE_HASH_LEN bytes).
+ * @retval  ESP_OK  the image will be stored (or marked as most recently used when it is already cached).
+ * @retval  ESP_ERR_INVALID_STATE  the cache is not mounted.
+ * @retval  ESP_ERR_INVALID_ARG  the image is empty.
+ * @retval  ESP_ERR_NO_MEM  no memory for the copy or the job queue is full.
+ */
+esp_err_t fwcache_store_background(const fwimg_t *image, uint8_t *hash);
+
+/** Load an image from the cache
+ *
+ * @param[in]  hash  content hash of the image.
+ * @param[in|out]  image  empty image to fill.
+ * @returns  ESP_OK when the image is loaded, ESP_ERR_NOT_FOUND when it is not cached.
+ */
+esp_err_t fwcache_load(const uint8_t *hash, fwimg_t *image);
+
+/** Check whether an image is cached
+ *
+ * @param[in]  hash  content hash of the image.
+ * @retval  true  the image is cached.
+ * @retval  false  the image is not cached, or the cache is not mounted.
+ */
+bool fwcache_contains(const uint8_t *hash);
+
+/** Pin or unpin a cached image, a pinned image is not removed to make room for new images
+ *
+ * @param[in]  hash  content hash of the image.
+ * @param[in]  pinned  true: keep the image in the cache.
+ * @returns  ESP_OK when the image is (un)pinned, ESP_ERR_NOT_FOUND when it is not cached.
+ */
+esp_err_t fwcache_pin(const uint8_t *hash, bool pinned);
+
+/** Get the cached images
+ *
+ * @param[out]  entries  cached images from most to least recently used, at least FWCACHE_MAX_ENTRIES entries.
+ * @returns  number of cached images.
+ */
+uint32_t fwcache_list(fwcache_entry_t *entries);
+
+/** Program an image with the PPM bootloader
+ *
+ * The image is remembered as content of the memory when programming succeeds. It is only stored
+ * in the cache, as reference of the next differential program, when a differential program is
+ * requested or the image is cached already. A differential program verifies that the chip holds the image remembered for the
+ * memory, programs only the pages which differ from it and verifies the complete image. All pages
+ * are programmed when any of this is not possible, e.g. in broadcast mode, after a reboot or when
+ * another chip is connected.
+ *
+ * @param[in]  manpow  true: manual power cycling.
+ * @param[in]  broadcast  true: program in broadcast mode.
+ * @param[in]  bitrate  bitrate of the bootloader.
+ * @param[in]  memory  memory to program.
+ * @param[in]  image  finalized image.
+ * @param[in]  differential  true: only program the pages which differ.
+ * @param[out]  skipped  number of pages which were not programmed.
+ * @returns  PPM_OK when the memory holds the image.
+ */
+ppm_err_t fwcache_ppm_program(bool manpow,
+                              bool broadcast,
+                              uint32_t bitrate,
+                              ppm_memory_t memory,
+                              const fwimg_t *image,
+                              bool differential,
+                              uint32_t *skipped);
+
+#endif /* FW_CACHE_H_ */
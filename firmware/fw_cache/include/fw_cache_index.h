@@ -0,0 +1,160 @@
+/**
+ * @file
+ * @brief Firmware image cache index definitions.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the definitions of the index of the firmware image cache. The index
+ * holds the content hash, the size and the last use of every cached image, and selects the least
+ * recently used images to evict when room is needed. Pinned images are never evicted. This part has no dependencies on the ESP-IDF
+ * such that it can be built and tested on the host, the caller stores the images and the index.
+ */
+
+#ifndef FW_CACHE_INDEX_H_
+    #define FW_CACHE_INDEX_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** length of the content hash of an image (SHA-256) */
+#define FWCACHE_HASH_LEN 32u
+
+/** length of the content hash as hexadecimal string, including the terminating zero */
+#define FWCACHE_HASH_STR_LEN ((2u * FWCACHE_HASH_LEN) + 1u)
+
+/** maximum number of cached images */
+#define FWCACHE_MAX_ENTRIES 16u
+
+/** magic of a stored index, changes with the layout of the index */
+#define FWCACHE_INDEX_MAGIC 0x32434346u
+
+/** cached image */
+typedef struct fwcache_entry_s {
+    uint8_t hash[FWCACHE_HASH_LEN];             /**< content hash of the binary image */
+    uint32_t size;                              /**< size of the binary image (bytes) */
+    uint32_t last_used;                         /**< sequence number of the last store or load */
+    uint32_t pinned;                            /**< non-zero: image is not evicted */
+} fwcache_entry_t;
+
+/** index of the cached images */
+typedef struct fwcache_index_s {
+    uint32_t magic;                             /**< FWCACHE_INDEX_MAGIC */
+    uint32_t sequence;                          /**< sequence number of the last use of any image */
+    uint32_t nr_of_entries;                     /**< number of cached images */
+    fwcache_entry_t entries[FWCACHE_MAX_ENTRIES];  /**< cached images, in no particular order */
+} fwcache_index_t;
+
+/** Clear the index
+ *
+ * @param[out]  index  index to clear.
+ */
+void fwcache_index_init(fwcache_index_t *index);
+
+/** Check an index read back from storage
+ *
+ * @param[in]  index  index to check.
+ * @retval  true  index can be used.
+ * @retval  false  index is corrupt or has another layout.
+ */
+bool fwcache_index_valid(const fwcache_index_t *index);
+
+/** Find a cached image
+ *
+ * @param[in]  index  index to search.
+ * @param[in]  hash  content hash of the image.
+ * @returns  cached image, NULL when the image is not cached.
+ */
+fwcache_entry_t *fwcache_index_find(fwcache_index_t *index, const uint8_t *hash);
+
+/** Mark a cached image as most recently used
+ *
+ * @param[in|out]  index  index holding the image.
+ * @param[in|out]  entry  cached image.
+ */
+void fwcache_index_touch(fwcache_index_t *index, fwcache_entry_t *entry);
+
+/** Get the total size of the cached images
+ *
+ * @param[in]  index  index.
+ * @returns  total size (bytes).
+ */
+uint32_t fwcache_index_used(const fwcache_index_t *index);
+
+/** Remove the least recently used image when there is no room for a new image
+ *
+ * Pinned images are skipped. Call repeatedly until it returns false, and delete the stored image of every evicted entry.
+ *
+ * @param[in|out]  index  index to evict from.
+ * @param[in]  size  size of the new image (bytes).
+ * @param[in]  capacity  space available for all images (bytes).
+ * @param[out]  evicted  image which was removed from the index.
+ * @retval  true  an image was evicted.
+ * @retval  false  there is room for the new image, or no image can be evicted.
+ */
+bool fwcache_index_evict(fwcache_index_t *index, uint32_t size, uint32_t capacity, fwcache_entry_t *evicted);
+
+/** Add an image as most recently used
+ *
+ * @param[in|out]  index  index to add to.
+ * @param[in]  hash  content hash of the image.
+ * @param[in]  size  size of the image (bytes).
+ * @returns  added image, NULL when the index is full.
+ */
+fwcache_entry_t *fwcache_index_add(fwcache_index_t *index, const uint8_t *hash, uint32_t size);
+
+/** Pin or unpin a cached image
+ *
+ * @param[in|out]  index  index holding the image.
+ * @param[in]  hash  content hash of the image.
+ * @param[in]  pinned  true: the image is not evicted.
+ * @retval  true  image is (un)pinned.
+ * @retval  false  image is not cached.
+ */
+bool fwcache_index_pin(fwcache_index_t *index, const uint8_t *hash, bool pinned);
+
+/** Remove an image from the index
+ *
+ * @param[in|out]  index  index to remove from.
+ * @param[in]  hash  content hash of the image.
+ * @retval  true  image is removed.
+ * @retval  false  image was not cached.
+ */
+bool fwcache_index_remove(fwcache_index_t *index, const uint8_t *hash);
+
+/** Sort the cached images from most to least recently used
+ *
+ * @param[in]  index  index.
+ * @param[out]  entries  sorted images, at least FWCACHE_MAX_ENTRIES entries.
+ * @returns  number of images.
+ */
+uint32_t fwcache_index_sorted(const fwcache_index_t *index, fwcache_entry_t *entries);
+
+/** Format a content hash as lowercase hexadecimal string
+ *
+ * @param[in]  hash  content hash.
+ * @param[out]  str  string of FWCACHE_HASH_STR_LEN characters.
+ */
+void fwcache_hash_to_string(const uint8_t *hash, char *str);
+
+/** Parse a content hash from a hexadecimal string
+ *
+ * @param[in]  str  string of 2 * FWCACHE_HASH_LEN hexadecimal characters.
+ * @param[out]  hash  content hash.
+ * @retval  true  hash is parsed.
+ * @retval  false  string is not a content hash.
+ */
+bool fwcache_hash_from_string(const char *str, uint8_t *hash);
+
+#endif /* FW_CACHE_INDEX_H_ */
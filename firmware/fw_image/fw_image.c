@@ -0,0 +1,211 @@
+/**
+ * @file
+ * @brief Firmware image routines.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the implementations of the firmware images kept in PSRAM for the PPM
+ * bootloader.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "sdkconfig.h"
+
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+
+#include "intelhex.h"
+#include "ppm_bootloader.h"
+#include "progress.h"
+
+#include "fw_image.h"
+
+static const char *TAG = "fw-image";
+
+/** maximum number of data bytes in an Intel HEX record */
+#define FWIMG_RECORD_MAX_DATA 255u
+
+/** rough number of bit times per page byte of a bootloader action, including the protocol and
+ * the flash write time, to estimate the progress until the throughput is measured */
+#define FWIMG_PPM_BITS_PER_BYTE 20u
+
+/** Allocate the image buffers in PSRAM
+ *
+ * @param[in]  ptr  block to resize, NULL to allocate a new block.
+ * @param[in]  size  new size of the block, 0 to free the block.
+ * @returns  resized block, NULL when out of memory.
+ */
+static void *fwimg_psram_realloc(void *ptr, size_t size);
+
+/** Parse an Intel HEX record into a container and append it to a list
+ *
+ * @param[in]  line  record.
+ * @param[in|out]  ext_address  extended address of the records.
+ * @param[in|out]  first  first container of the list.
+ * @param[in|out]  last  last container of the list.
+ * @returns  true when the record is parsed.
+ */
+static bool fwimg_append_record(char *line,
+                                uint32_t *ext_address,
+                                ihexContainer_t **first,
+                                ihexContainer_t **last);
+
+/** Convert the pages of an image into a list of containers
+ *
+ * Every page is formatted as Intel HEX data records of at most FWIMG_RECORD_MAX_DATA bytes, which
+ * are parsed by intelhex_readLine into one container each. An extended linear address record, and
+ * its container, is inserted whenever the upper 16 address bits change.
+ *
+ * @param[in]  image  image to convert.
+ * @returns  first container, NULL when the image is empty or out of memory.
+ */
+static ihexContainer_t *fwimg_to_containers(const fwimg_t *image);
+
+
+static void *fwimg_psram_realloc(void *ptr, size_t size) {
+    void *retval = NULL;
+
+    if (size == 0u) {
+        heap_caps_free(ptr);
+    } else {
+        retval = heap_caps_realloc(ptr, size, MALLOC_CAP_SPIRAM);
+    }
+
+    return retval;
+}
+
+static bool fwimg_append_record(char *line,
+                                uint32_t *ext_address,
+                                ihexContainer_t **first,
+                                ihexContainer_t **last) {
+    ihexContainer_t *container = NULL;
+    bool retval = intelhex_readLine(line, ext_address, &container);
+
+    if (retval && (container != NULL)) {
+        container->prev = *last;
+        if (*last != NULL) {
+            (*last)->next = container;
+        } else {
+            *first = container;
+        }
+        *last = container;
+    }
+
+    return retval;
+}
+
+static ihexContainer_t *fwimg_to_containers(const fwimg_t *image) {
+    /* ':' + 2 * (count + address + type + data + checksum) + '\0' */
+    char line[1u + (2u * (FWIMG_RECORD_MAX_DATA + 5u)) + 1u];
+    ihexContainer_t *first = NULL;
+    ihexContainer_t *last = NULL;
+    uint32_t ext_address = 0u;
+    uint32_t line_ext_address = UINT32_MAX;
+    bool valid = true;
+    uint32_t index = 0u;
+
+    while (valid && fwimg_next_page(image, &index)) {
+        uint32_t address = fwimg_page_address(image, index);
+        const uint8_t *data = fwimg_page(image, address);
+
+        /* a page is handed over as records of its own, a page size of up to 255 takes one record */
+        for (uint32_t pos = 0u; valid && (pos < image->page_size); pos += FWIMG_RECORD_MAX_DATA) {
+            uint32_t rec_address = address + pos;
+            uint8_t count = (uint8_t)(((image->page_size - pos) < FWIMG_RECORD_MAX_DATA) ?
+                                      (image->page_size - pos) : FWIMG_RECORD_MAX_DATA);
+
+            if ((rec_address >> 16) != line_ext_address) {
+                line_ext_address = rec_address >> 16;
+                uint8_t checksum = (uint8_t)(0u - (2u + 4u + (line_ext_address >> 8) + line_ext_address));
+                (void)snprintf(line, sizeof(line), ":02000004%04X%02X", (unsigned int)line_ext_address, checksum);
+                valid = fwimg_append_record(line, &ext_address, &first, &last);
+            }
+
+            uint8_t checksum = (uint8_t)(count + (rec_address >> 8) + rec_address);
+            size_t len = (size_t)snprintf(line, sizeof(line), ":%02X%04X00", count,
+                                          (unsigned int)(rec_address & 0xFFFFu));
+            for (uint32_t i = 0u; i < count; i++) {
+                len += (size_t)snprintf(&line[len], sizeof(line) - len, "%02X", data[pos + i]);
+                checksum += data[pos + i];
+            }
+            (void)snprintf(&line[len], sizeof(line) - len, "%02X", (uint8_t)(0u - checksum));
+            valid = valid && fwimg_append_record(line, &ext_address, &first, &last);
+        }
+        index++;
+    }
+
+    if (!valid) {
+        ESP_LOGE(TAG, "failed to convert page %lu", index);
+        if (first != NULL) {
+            intelhex_free(first);
+        }
+        first = NULL;
+    }
+
+    return first;
+}
+
+bool fwimg_memory_matches(const fwimg_t *image, ppm_memory_t memory) {
+    bool retval = true;
+
+    if (image->memory == FWIMG_MEMORY_NVRAM) {
+        retval = (memory == PPM_MEM_NVRAM);
+    } else if (image->memory == FWIMG_MEMORY_FLASH) {
+        retval = (memory == PPM_MEM_FLASH);
+    } else if (image->memory == FWIMG_MEMORY_FLASH_CS) {
+        retval = (memory == PPM_MEM_FLASH_CS);
+    }
+
+    return retval;
+}
+
+void fwimg_init_psram(fwimg_t *image) {
+    fwimg_init(image, CONFIG_FW_IMAGE_PAGE_SIZE, CONFIG_FW_IMAGE_MAX_SIZE, fwimg_psram_realloc);
+}
+
+ppm_err_t fwimg_ppm_action(bool manpow,
+                           bool broadcast,
+                           uint32_t bitrate,
+                           ppm_memory_t memory,
+                           ppm_action_t action,
+                           const fwimg_t *image) {
+    ihexContainer_t *containers = NULL;
+
+    if (image != NULL) {
+        containers = fwimg_to_containers(image);
+        ESP_LOGI(TAG, "%lu pages from 0x%08lx", fwimg_pages_present(image), image->base);
+
+        /* the bootloader does not report its progress, it is estimated from the elapsed time */
+        progress_phase((action == PPM_ACT_VERIFY) ? PROGRESS_PHASE_VERIFY : PROGRESS_PHASE_PROGRAM,
+                       fwimg_pages_present(image) * image->page_size,
+                       image->page_size,
+                       bitrate / FWIMG_PPM_BITS_PER_BYTE);
+    }
+
+    ppm_err_t retval = ppmbtl_doAction(manpow, broadcast, bitrate, memory, action, containers);
+
+    if ((image != NULL) && (retval == PPM_OK)) {
+        progress_phase_end();
+    }
+
+    if (containers != NULL) {
+        intelhex_free(containers);
+    }
+
+    return retval;
+}
@@ -0,0 +1,331 @@
+/**
+ * @file
+ * @brief Firmware image loader routines.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the implementations of the firmware image loader.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "mlx_crc.h"
+
+#include "fw_image_loader.h"
+
+/** magic of a binary image */
+static const uint8_t fwimg_bin_magic[4] = {'M', 'C', 'M', 'I'};
+
+/** length of the address of a page */
+#define FWIMG_BIN_ADDRESS_LEN 4u
+
+/** length of the trailer */
+#define FWIMG_BIN_TRAILER_LEN 2u
+
+/** Record handler of an Intel HEX file
+ *
+ * @param[in]  line  record without line ending.
+ * @param[in]  length  length of the record.
+ * @param[in]  ctx  image to write the record into.
+ * @returns  true when the record is written.
+ */
+static bool fwimg_loader_hex_line(const char *line, size_t length, void *ctx);
+
+/** Collect the bytes of a header, address or trailer field
+ *
+ * @param[in|out]  loader  loader.
+ * @param[in]  data  received data.
+ * @param[in]  length  length of the received data.
+ * @param[in]  field_len  length of the field.
+ * @returns  number of bytes taken from data.
+ */
+static size_t fwimg_loader_collect(fwimg_loader_t *loader, const uint8_t *data, size_t length, uint32_t field_len);
+
+/** Check the header of a binary image
+ *
+ * @param[in|out]  loader  loader with the complete header in field.
+ */
+static void fwimg_loader_header(fwimg_loader_t *loader);
+
+/** Decode a chunk of a binary image
+ *
+ * @param[in|out]  loader  loader.
+ * @param[in]  data  chunk of the image.
+ * @param[in]  length  length of the chunk.
+ */
+static void fwimg_loader_binary(fwimg_loader_t *loader, const uint8_t *data, size_t length);
+
+/** Read a little endian value
+ *
+ * @param[in]  data  bytes of the value.
+ * @param[in]  length  number of bytes of the value.
+ * @returns  value.
+ */
+static uint32_t fwimg_loader_le(const uint8_t *data, size_t length);
+
+/** Store a little endian value
+ *
+ * @param[out]  data  bytes of the value.
+ * @param[in]  value  value.
+ * @param[in]  length  number of bytes of the value.
+ */
+static void fwimg_bin_le(uint8_t *data, uint32_t value, size_t length);
+
+/** Write bytes of a binary image and update its crc
+ *
+ * @param[in]  data  bytes to write.
+ * @param[in]  length  number of bytes.
+ * @param[in]  write_fn  output of the binary image.
+ * @param[in]  ctx  context passed to write_fn.
+ * @param[in|out]  crc  crc of the binary image so far.
+ * @returns  true when the bytes are written.
+ */
+static bool fwimg_bin_output(const uint8_t *data, size_t length, fwimg_bin_write_t write_fn, void *ctx, uint16_t *crc);
+
+
+static bool fwimg_loader_hex_line(const char *line, size_t length, void *ctx) {
+    return fwimg_write_hex_record((fwimg_t *)ctx, line, length);
+}
+
+static size_t fwimg_loader_collect(fwimg_loader_t *loader, const uint8_t *data, size_t length, uint32_t field_len) {
+    size_t count = field_len - loader->field_len;
+
+    if (count > length) {
+        count = length;
+    }
+    memcpy(&loader->field[loader->field_len], data, count);
+    loader->field_len += (uint32_t)count;
+
+    return count;
+}
+
+static void fwimg_loader_header(fwimg_loader_t *loader) {
+    const uint8_t *header = loader->field;
+    uint8_t memory = header[5];
+
+    loader->page_size = (uint16_t)fwimg_loader_le(&header[6], sizeof(uint16_t));
+    loader->nr_of_pages = fwimg_loader_le(&header[8], sizeof(uint32_t));
+
+    if ((memcmp(header, fwimg_bin_magic, sizeof(fwimg_bin_magic)) != 0) ||
+        (header[4] != FWIMG_BIN_VERSION) ||
+        ((memory > FWIMG_MEMORY_FLASH_CS) && (memory != FWIMG_MEMORY_ANY)) ||
+        (loader->page_size == 0u) ||
+        (loader->page_size > FWIMG_BIN_MAX_PAGE_SIZE) ||
+        ((loader->page_size & (loader->page_size - 1u)) != 0u)) {
+        loader->result = FWIMG_LOAD_ERR_HEADER;
+    } else {
+        loader->image->memory = memory;
+        loader->state = (loader->nr_of_pages > 0u) ? FWIMG_BIN_ADDRESS : FWIMG_BIN_TRAILER;
+    }
+}
+
+static void fwimg_loader_binary(fwimg_loader_t *loader, const uint8_t *data, size_t length) {
+    size_t pos = 0u;
+
+    while ((loader->result == FWIMG_LOAD_OK) && (pos < length)) {
+        size_t count = 0u;
+        /* the crc covers the header and the pages, not the trailer */
+        bool crc_covered = (loader->state != FWIMG_BIN_TRAILER);
+
+        switch (loader->state) {
+            case FWIMG_BIN_HEADER:
+                count = fwimg_loader_collect(loader, &data[pos], length - pos, FWIMG_BIN_HEADER_LEN);
+                if (loader->field_len == FWIMG_BIN_HEADER_LEN) {
+                    loader->field_len = 0u;
+                    fwimg_loader_header(loader);
+                }
+                break;
+            case FWIMG_BIN_ADDRESS:
+                count = fwimg_loader_collect(loader, &data[pos], length - pos, FWIMG_BIN_ADDRESS_LEN);
+                if (loader->field_len == FWIMG_BIN_ADDRESS_LEN) {
+                    loader->field_len = 0u;
+                    loader->address = fwimg_loader_le(loader->field, FWIMG_BIN_ADDRESS_LEN);
+                    loader->offset = 0u;
+                    loader->state = FWIMG_BIN_DATA;
+                }
+                break;
+            case FWIMG_BIN_DATA:
+                /* the page data is written into the image as it arrives */
+                count = loader->page_size - loader->offset;
+                if (count > (length - pos)) {
+                    count = length - pos;
+                }
+                if (!fwimg_write(loader->image, loader->address + loader->offset, &data[pos], count)) {
+                    loader->result = FWIMG_LOAD_ERR_WRITE;
+                }
+                loader->offset += (uint32_t)count;
+                if (loader->offset == loader->page_size) {
+                    loader->pages++;
+                    loader->state = (loader->pages < loader->nr_of_pages) ? FWIMG_BIN_ADDRESS : FWIMG_BIN_TRAILER;
+                }
+                break;
+            case FWIMG_BIN_TRAILER:
+                count = fwimg_loader_collect(loader, &data[pos], length - pos, FWIMG_BIN_TRAILER_LEN);
+                if (loader->field_len == FWIMG_BIN_TRAILER_LEN) {
+                    if ((uint16_t)fwimg_loader_le(loader->field, FWIMG_BIN_TRAILER_LEN) == loader->crc) {
+                        loader->state = FWIMG_BIN_DONE;
+                    } else {
+                        loader->result = FWIMG_LOAD_ERR_CRC;
+                    }
+                }
+                break;
+            default:
+                loader->result = FWIMG_LOAD_ERR_INCOMPLETE;
+                break;
+        }
+
+        if (crc_covered) {
+            loader->crc = crc_calc16bitCrc(&data[pos], count, loader->crc);
+        }
+        pos += count;
+    }
+}
+
+static uint32_t fwimg_loader_le(const uint8_t *data, size_t length) {
+    uint32_t value = 0u;
+
+    for (size_t i = length; i-- > 0u;) {
+        value = (value << 8) | data[i];
+    }
+
+    return value;
+}
+
+static void fwimg_bin_le(uint8_t *data, uint32_t value, size_t length) {
+    for (size_t i = 0u; i < length; i++) {
+        data[i] = (uint8_t)(value >> (8u * i));
+    }
+}
+
+static bool fwimg_bin_output(const uint8_t *data, size_t length, fwimg_bin_write_t write_fn, void *ctx, uint16_t *crc) {
+    *crc = crc_calc16bitCrc(data, length, *crc);
+    return write_fn(data, length, ctx);
+}
+
+void fwimg_loader_init(fwimg_loader_t *loader, fwimg_t *image) {
+    memset(loader, 0, sizeof(fwimg_loader_t));
+    loader->image = image;
+    loader->crc = FWIMG_BIN_CRC_SEED;
+    hexstream_init(&loader->hex);
+}
+
+fwimg_load_result_t fwimg_loader_feed(fwimg_loader_t *loader, const uint8_t *data, size_t length) {
+    if ((loader->format == FWIMG_FORMAT_UNKNOWN) && (length > 0u)) {
+        if ((data[0] == ':') || (data[0] == '\r') || (data[0] == '\n')) {
+            loader->format = FWIMG_FORMAT_HEX;
+        } else if (data[0] == fwimg_bin_magic[0]) {
+            loader->format = FWIMG_FORMAT_BINARY;
+        } else {
+            loader->result = FWIMG_LOAD_ERR_FORMAT;
+        }
+    }
+
+    if (loader->result == FWIMG_LOAD_OK) {
+        if (loader->format == FWIMG_FORMAT_HEX) {
+            if (hexstream_feed(&loader->hex, data, length, fwimg_loader_hex_line, loader->image) != HEXSTREAM_OK) {
+                loader->result = FWIMG_LOAD_ERR_RECORD;
+            }
+        } else if (loader->format == FWIMG_FORMAT_BINARY) {
+            fwimg_loader_binary(loader, data, length);
+        }
+    }
+    loader->bytes += (uint32_t)length;
+
+    return loader->result;
+}
+
+fwimg_load_result_t fwimg_loader_finish(fwimg_loader_t *loader) {
+    if (loader->result == FWIMG_LOAD_OK) {
+        if (loader->format == FWIMG_FORMAT_HEX) {
+            if (hexstream_finish(&loader->hex, fwimg_loader_hex_line, loader->image) != HEXSTREAM_OK) {
+                loader->result = FWIMG_LOAD_ERR_RECORD;
+            }
+        } else if ((loader->format == FWIMG_FORMAT_BINARY) && (loader->state != FWIMG_BIN_DONE)) {
+            loader->result = FWIMG_LOAD_ERR_INCOMPLETE;
+        }
+    }
+    if ((loader->result == FWIMG_LOAD_OK) && (fwimg_pages_present(loader->image) == 0u)) {
+        loader->result = FWIMG_LOAD_ERR_EMPTY;
+    }
+    if (loader->result == FWIMG_LOAD_OK) {
+        fwimg_finalize(loader->image);
+    }
+
+    return loader->result;
+}
+
+const char *fwimg_loader_result_to_string(fwimg_load_result_t result) {
+    const char *retval = "Unknown error";
+
+    switch (result) {
+        case FWIMG_LOAD_OK:
+            retval = "OK";
+            break;
+        case FWIMG_LOAD_ERR_FORMAT:
+            retval = "Unknown image format";
+            break;
+        case FWIMG_LOAD_ERR_RECORD:
+            retval = "Invalid hex record";
+            break;
+        case FWIMG_LOAD_ERR_HEADER:
+            retval = "Invalid image header";
+            break;
+        case FWIMG_LOAD_ERR_WRITE:
+            retval = "Image too large";
+            break;
+        case FWIMG_LOAD_ERR_INCOMPLETE:
+            retval = "Image incomplete";
+            break;
+        case FWIMG_LOAD_ERR_CRC:
+            retval = "Image crc mismatch";
+            break;
+        case FWIMG_LOAD_ERR_EMPTY:
+            retval = "Image is empty";
+            break;
+        default:
+            break;
+    }
+
+    return retval;
+}
+
+bool fwimg_bin_write(const fwimg_t *image, fwimg_bin_write_t write_fn, void *ctx) {
+    uint8_t field[FWIMG_BIN_HEADER_LEN] = {0};
+    uint16_t crc = FWIMG_BIN_CRC_SEED;
+    uint32_t index = 0u;
+
+    memcpy(field, fwimg_bin_magic, sizeof(fwimg_bin_magic));
+    field[4] = FWIMG_BIN_VERSION;
+    field[5] = image->memory;
+    fwimg_bin_le(&field[6], image->page_size, sizeof(uint16_t));
+    fwimg_bin_le(&field[8], fwimg_pages_present(image), sizeof(uint32_t));
+    bool retval = fwimg_bin_output(field, FWIMG_BIN_HEADER_LEN, write_fn, ctx, &crc);
+
+    while (retval && fwimg_next_page(image, &index)) {
+        fwimg_bin_le(field, fwimg_page_address(image, index), FWIMG_BIN_ADDRESS_LEN);
+        retval = fwimg_bin_output(field, FWIMG_BIN_ADDRESS_LEN, write_fn, ctx, &crc) &&
+                 fwimg_bin_output(&image->data[index * image->page_size], image->page_size, write_fn, ctx, &crc);
+        index++;
+    }
+
+    if (retval) {
+        fwimg_bin_le(field, crc, FWIMG_BIN_TRAILER_LEN);
+        retval = write_fn(field, FWIMG_BIN_TRAILER_LEN, ctx);
+    }
+
+    return retval;
+}
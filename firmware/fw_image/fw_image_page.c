@@ -0,0 +1,393 @@
+/**
+ * @file
+ * @brief Firmware image page routines.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the implementations of the page indexed firmware image.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "mlx_crc.h"
+
+#include "fw_image_page.h"
+
+/** minimum number of pages allocated */
+#define FWIMG_MIN_CAPACITY 16u
+
+/** seed of the page crcs */
+#define FWIMG_CRC_SEED 0xFFFFu
+
+/** Intel HEX record types */
+#define IHEX_TYPE_DATA 0x00u
+#define IHEX_TYPE_EOF 0x01u
+#define IHEX_TYPE_EXT_SEGMENT 0x02u
+#define IHEX_TYPE_START_SEGMENT 0x03u
+#define IHEX_TYPE_EXT_LINEAR 0x04u
+#define IHEX_TYPE_START_LINEAR 0x05u
+
+/** flag of a valid hex digit in fwimg_hex_digits */
+#define FWIMG_HEX_VALID 0x10u
+
+/** value of the hex digit characters, or-ed with FWIMG_HEX_VALID, other characters are 0 */
+static const uint8_t fwimg_hex_digits[256] = {
+    ['0'] = 0x10u, ['1'] = 0x11u, ['2'] = 0x12u, ['3'] = 0x13u, ['4'] = 0x14u,
+    ['5'] = 0x15u, ['6'] = 0x16u, ['7'] = 0x17u, ['8'] = 0x18u, ['9'] = 0x19u,
+    ['A'] = 0x1Au, ['B'] = 0x1Bu, ['C'] = 0x1Cu, ['D'] = 0x1Du, ['E'] = 0x1Eu, ['F'] = 0x1Fu,
+    ['a'] = 0x1Au, ['b'] = 0x1Bu, ['c'] = 0x1Cu, ['d'] = 0x1Du, ['e'] = 0x1Eu, ['f'] = 0x1Fu,
+};
+
+/** Resize the buffers of the image
+ *
+ * @param[in|out]  image  image to resize.
+ * @param[in]  capacity  new number of pages.
+ * @retval  true  buffers are resized.
+ * @retval  false  out of memory, the image is unchanged.
+ */
+static bool fwimg_reserve(fwimg_t *image, uint32_t capacity);
+
+/** Make the image cover an address range
+ *
+ * @param[in|out]  image  image to extend.
+ * @param[in]  first  first page address of the range.
+ * @param[in]  last  last page address of the range.
+ * @retval  true  the image covers the range.
+ * @retval  false  out of memory, or the image would exceed its maximum size.
+ */
+static bool fwimg_cover(fwimg_t *image, uint32_t first, uint32_t last);
+
+/** Convert hex characters to bytes
+ *
+ * @param[in]  chars  hex characters, two per byte.
+ * @param[out]  bytes  converted bytes.
+ * @param[in]  nr_of_bytes  number of bytes to convert.
+ * @param[out]  sum  sum of the converted bytes (modulo 256).
+ * @retval  true  bytes are converted.
+ * @retval  false  invalid hex character.
+ */
+static bool fwimg_hex_bytes(const char *chars, uint8_t *bytes, size_t nr_of_bytes, uint8_t *sum);
+
+
+static bool fwimg_reserve(fwimg_t *image, uint32_t capacity) {
+    uint32_t bitmap_words = (capacity + 31u) / 32u;
+    uint32_t old_words = (image->capacity + 31u) / 32u;
+
+    bool retval = false;
+
+    /* a buffer which was grown already is kept when a later one fails, the capacity stays the minimum */
+    uint8_t *data = image->realloc_fn(image->data, (size_t)capacity * image->page_size);
+    if (data != NULL) {
+        image->data = data;
+        uint32_t *present = image->realloc_fn(image->present, bitmap_words * sizeof(uint32_t));
+        if (present != NULL) {
+            image->present = present;
+            memset(&image->present[old_words], 0, (bitmap_words - old_words) * sizeof(uint32_t));
+            uint16_t *page_crc = image->realloc_fn(image->page_crc, capacity * sizeof(uint16_t));
+            if (page_crc != NULL) {
+                image->page_crc = page_crc;
+                image->capacity = capacity;
+                retval = true;
+            }
+        }
+    }
+
+    return retval;
+}
+
+static bool fwimg_cover(fwimg_t *image, uint32_t first, uint32_t last) {
+    bool retval = false;
+    uint32_t base = image->base;
+    uint32_t end = image->base + (image->nr_of_pages * image->page_size);
+
+    if (image->nr_of_pages == 0u) {
+        base = first;
+        end = first;
+    }
+    if (first < base) {
+        base = first;
+    }
+    if (last >= end) {
+        end = last + image->page_size;
+    }
+
+    uint32_t nr_of_pages = (end - base) / image->page_size;
+    if ((end > base) && ((end - base) <= image->max_size)) {
+        if (nr_of_pages <= image->capacity) {
+            retval = true;
+        } else {
+            uint32_t capacity = (image->capacity < FWIMG_MIN_CAPACITY) ? FWIMG_MIN_CAPACITY : image->capacity;
+            while (capacity < nr_of_pages) {
+                capacity *= 2u;
+            }
+            /* fall back to the exact size when doubling does not fit */
+            retval = fwimg_reserve(image, capacity) || fwimg_reserve(image, nr_of_pages);
+        }
+    }
+
+    if (retval) {
+        if (image->nr_of_pages == 0u) {
+            image->base = base;
+        } else if (base < image->base) {
+            /* move the pages up, records normally come in order such that this is rare */
+            uint32_t shift = (image->base - base) / image->page_size;
+            memmove(&image->data[(size_t)shift * image->page_size],
+                    image->data,
+                    (size_t)image->nr_of_pages * image->page_size);
+            for (uint32_t index = image->nr_of_pages; index-- > 0u;) {
+                bool present = fwimg_page_present(image, index);
+                image->present[index / 32u] &= ~(1u << (index % 32u));
+                if (present) {
+                    image->present[(index + shift) / 32u] |= (1u << ((index + shift) % 32u));
+                }
+            }
+            image->base = base;
+        }
+        image->nr_of_pages = nr_of_pages;
+    }
+
+    return retval;
+}
+
+static bool fwimg_hex_bytes(const char *chars, uint8_t *bytes, size_t nr_of_bytes, uint8_t *sum) {
+    const uint8_t *digits = (const uint8_t *)chars;
+    uint8_t valid = FWIMG_HEX_VALID;
+    uint8_t total = 0u;
+
+    /* the validity is accumulated, such that the loop does not branch per character */
+    for (size_t i = 0u; i < nr_of_bytes; i++) {
+        uint8_t high = fwimg_hex_digits[digits[2u * i]];
+        uint8_t low = fwimg_hex_digits[digits[(2u * i) + 1u]];
+        valid &= high & low;
+        bytes[i] = (uint8_t)((uint8_t)(high << 4) | (low & 0x0Fu));
+        total += bytes[i];
+    }
+    *sum = total;
+
+    return valid != 0u;
+}
+
+void fwimg_init(fwimg_t *image, uint16_t page_size, uint32_t max_size, fwimg_realloc_t realloc_fn) {
+    memset(image, 0, sizeof(fwimg_t));
+    image->page_size = page_size;
+    image->max_size = max_size;
+    image->realloc_fn = realloc_fn;
+    image->memory = FWIMG_MEMORY_ANY;
+}
+
+void fwimg_free(fwimg_t *image) {
+    if (image->realloc_fn != NULL) {
+        if (image->data != NULL) {
+            (void)image->realloc_fn(image->data, 0u);
+        }
+        if (image->present != NULL) {
+            (void)image->realloc_fn(image->present, 0u);
+        }
+        if (image->page_crc != NULL) {
+            (void)image->realloc_fn(image->page_crc, 0u);
+        }
+    }
+    fwimg_init(image, image->page_size, image->max_size, image->realloc_fn);
+}
+
+bool fwimg_write(fwimg_t *image, uint32_t address, const uint8_t *data, size_t length) {
+    bool retval = true;
+
+    if (length > 0u) {
+        uint32_t mask = ~((uint32_t)image->page_size - 1u);
+        uint32_t end = (uint32_t)(address + (length - 1u));
+        uint32_t first = address & mask;
+        uint32_t last = end & mask;
+
+        retval = (length <= image->max_size) && (end >= address) && fwimg_cover(image, first, last);
+        if (retval) {
+            for (uint32_t index = (first - image->base) / image->page_size;
+                 index <= ((last - image->base) / image->page_size);
+                 index++) {
+                if (!fwimg_page_present(image, index)) {
+                    memset(&image->data[(size_t)index * image->page_size], FWIMG_FILL_BYTE, image->page_size);
+                    image->present[index / 32u] |= (1u << (index % 32u));
+                }
+            }
+            memcpy(&image->data[address - image->base], data, length);
+            image->finalized = false;
+        }
+    }
+
+    return retval;
+}
+
+bool fwimg_write_hex_record(fwimg_t *image, const char *line, size_t length) {
+    bool retval = false;
+    uint8_t record[255u + 5u];
+    uint8_t checksum = 0u;
+
+    /* ':' count(1) address(2) type(1) data(count) checksum(1) */
+    size_t nr_of_bytes = (length - 1u) / 2u;
+    bool valid = (length >= 11u) && (line[0] == ':') && ((length % 2u) == 1u) && (nr_of_bytes <= sizeof(record)) &&
+                 fwimg_hex_bytes(&line[1], record, nr_of_bytes, &checksum);
+
+    if (valid && (checksum == 0u) && (nr_of_bytes == ((size_t)record[0] + 5u))) {
+        uint8_t count = record[0];
+        uint16_t offset = (uint16_t)(((uint16_t)record[1] << 8) | record[2]);
+
+        switch (record[3]) {
+            case IHEX_TYPE_DATA:
+                retval = fwimg_write(image, image->ext_address + offset, &record[4], count);
+                break;
+            case IHEX_TYPE_EOF:
+                retval = (count == 0u);
+                break;
+            case IHEX_TYPE_EXT_SEGMENT:
+                if (count == 2u) {
+                    image->ext_address = (((uint32_t)record[4] << 8) | record[5]) << 4;
+                    retval = true;
+                }
+                break;
+            case IHEX_TYPE_EXT_LINEAR:
+                if (count == 2u) {
+                    image->ext_address = (((uint32_t)record[4] << 8) | record[5]) << 16;
+                    retval = true;
+                }
+                break;
+            case IHEX_TYPE_START_SEGMENT:
+            case IHEX_TYPE_START_LINEAR:
+                retval = (count == 4u);
+                break;
+            default:
+                break;
+        }
+    }
+
+    return retval;
+}
+
+void fwimg_finalize(fwimg_t *image) {
+    uint32_t index = 0u;
+
+    while (fwimg_next_page(image, &index)) {
+        image->page_crc[index] = crc_calc16bitCrc(&image->data[(size_t)index * image->page_size],
+                                                  image->page_size,
+                                                  FWIMG_CRC_SEED);
+        index++;
+    }
+    image->finalized = true;
+}
+
+uint32_t fwimg_pages_present(const fwimg_t *image) {
+    uint32_t count = 0u;
+
+    for (uint32_t word = 0u; word < ((image->nr_of_pages + 31u) / 32u); word++) {
+        count += (uint32_t)__builtin_popcount(image->present[word]);
+    }
+
+    return count;
+}
+
+bool fwimg_page_present(const fwimg_t *image, uint32_t index) {
+    return (index < image->nr_of_pages) && ((image->present[index / 32u] & (1u << (index % 32u))) != 0u);
+}
+
+const uint8_t *fwimg_page(const fwimg_t *image, uint32_t address) {
+    const uint8_t *retval = NULL;
+
+    if ((image->nr_of_pages != 0u) && (address >= image->base)) {
+        uint32_t index = (address - image->base) / image->page_size;
+        if (fwimg_page_present(image, index)) {
+            retval = &image->data[(size_t)index * image->page_size];
+        }
+    }
+
+    return retval;
+}
+
+bool fwimg_next_page(const fwimg_t *image, uint32_t *index) {
+    bool retval = false;
+    uint32_t candidate = *index;
+
+    while (!retval && (candidate < image->nr_of_pages)) {
+        uint32_t bits = image->present[candidate / 32u] >> (candidate % 32u);
+        if (bits != 0u) {
+            candidate += (uint32_t)__builtin_ctz(bits);
+            retval = (candidate < image->nr_of_pages);
+        } else {
+            candidate = (candidate | 31u) + 1u;
+        }
+    }
+    if (retval) {
+        *index = candidate;
+    }
+
+    return retval;
+}
+
+uint32_t fwimg_page_address(const fwimg_t *image, uint32_t index) {
+    return image->base + (index * image->page_size);
+}
+
+bool fwimg_delta(const fwimg_t *image, const fwimg_t *reference, fwimg_t *delta, uint32_t *skipped) {
+    bool retval = image->finalized && reference->finalized && (image->page_size == reference->page_size);
+    uint32_t index = 0u;
+
+    *skipped = 0u;
+    while (retval && fwimg_next_page(reference, &index)) {
+        retval = (fwimg_page(image, fwimg_page_address(reference, index)) != NULL);
+        index++;
+    }
+
+    index = 0u;
+    while (retval && fwimg_next_page(image, &index)) {
+        uint32_t address = fwimg_page_address(image, index);
+        const uint8_t *data = &image->data[(size_t)index * image->page_size];
+        const uint8_t *ref_data = fwimg_page(reference, address);
+        if ((ref_data != NULL) &&
+            (reference->page_crc[(address - reference->base) / reference->page_size] == image->page_crc[index]) &&
+            (memcmp(ref_data, data, image->page_size) == 0)) {
+            (*skipped)++;
+        } else {
+            retval = fwimg_write(delta, address, data, image->page_size);
+        }
+        index++;
+    }
+
+    if (retval) {
+        delta->memory = image->memory;
+        fwimg_finalize(delta);
+    }
+
+    return retval;
+}
+
+bool fwimg_copy(const fwimg_t *image, fwimg_t *copy) {
+    bool retval = (image->page_size == copy->page_size);
+    uint32_t index = 0u;
+
+    while (retval && fwimg_next_page(image, &index)) {
+        retval = fwimg_write(copy,
+                             fwimg_page_address(image, index),
+                             &image->data[(size_t)index * image->page_size],
+                             image->page_size);
+        index++;
+    }
+
+    if (retval) {
+        copy->memory = image->memory;
+        fwimg_finalize(copy);
+    }
+
+    return retval;
+}
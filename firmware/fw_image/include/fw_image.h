@@ -0,0 +1,69 @@
+/**
+ * @file
+ * @brief Firmware image definitions.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the definitions of the firmware images kept in PSRAM for the PPM
+ * bootloader.
+ */
+
+#ifndef FW_IMAGE_H_
+    #define FW_IMAGE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "ppm_bootloader.h"
+
+#include "fw_image_loader.h"
+#include "fw_image_page.h"
+
+/** Initialize an empty image in PSRAM with the configured page size and maximum size
+ *
+ * @param[out]  image  image to initialize.
+ */
+void fwimg_init_psram(fwimg_t *image);
+
+/** Check whether an image can be used for a memory
+ *
+ * @param[in]  image  image.
+ * @param[in]  memory  memory to perform a bootloader action on.
+ * @returns  true when the image is meant for the memory, or for any memory.
+ */
+bool fwimg_memory_matches(const fwimg_t *image, ppm_memory_t memory);
+
+/** Perform a PPM bootloader action with the pages of an image
+ *
+ * The pages are written back as Intel HEX records of at most 255 data bytes, with an extended
+ * linear address record in front of every 64 KiB segment, and handed over to the bootloader as
+ * the containers parsed from these records.
+ *
+ * @param[in]  manpow  manual power cycling.
+ * @param[in]  broadcast  bootload in broadcast mode.
+ * @param[in]  bitrate  bitrate of the bootloader.
+ * @param[in]  memory  memory to perform the action on.
+ * @param[in]  action  action to perform.
+ * @param[in]  image  image with the pages.
+ * @returns  result of the bootloader action.
+ */
+ppm_err_t fwimg_ppm_action(bool manpow,
+                           bool broadcast,
+                           uint32_t bitrate,
+                           ppm_memory_t memory,
+                           ppm_action_t action,
+                           const fwimg_t *image);
+
+#endif /* FW_IMAGE_H_ */
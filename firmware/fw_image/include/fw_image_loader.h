@@ -0,0 +1,153 @@
+/**
+ * @file
+ * @brief Firmware image loader definitions.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the definitions of the firmware image loader.
+ *
+ * The loader fills an image from a file which arrives in chunks of arbitrary size. The format is
+ * taken from the first byte: an Intel HEX file starts with ':', a binary image with its magic.
+ *
+ * A binary image is little endian and holds:
+ * - a header: magic "MCMI" (4), version (uint8), memory (uint8, FWIMG_MEMORY_x), page size (uint16),
+ *   number of pages (uint32), reserved (uint32, 0).
+ * - the pages: address (uint32) followed by page size bytes of data.
+ * - a trailer: crc (uint16) over the header and the pages, CRC-16/CCITT with seed 0xFFFF.
+ *
+ * This part has no dependencies on the ESP-IDF such that it can be built and tested on the host.
+ */
+
+#ifndef FW_IMAGE_LOADER_H_
+    #define FW_IMAGE_LOADER_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "fw_image_page.h"
+#include "hex_stream.h"
+
+/** length of the binary image header */
+#define FWIMG_BIN_HEADER_LEN 16u
+
+/** version of the binary image format */
+#define FWIMG_BIN_VERSION 1u
+
+/** maximum page size of a binary image */
+#define FWIMG_BIN_MAX_PAGE_SIZE 4096u
+
+/** seed of the binary image crc */
+#define FWIMG_BIN_CRC_SEED 0xFFFFu
+
+/** file format enum */
+typedef enum fwimg_format_e {
+    FWIMG_FORMAT_UNKNOWN = 0,                   /**< no data received yet */
+    FWIMG_FORMAT_HEX = 1,                       /**< Intel HEX file */
+    FWIMG_FORMAT_BINARY = 2,                    /**< binary image */
+} fwimg_format_t;                               /**< file format */
+
+/** loader result enum */
+typedef enum fwimg_load_result_e {
+    FWIMG_LOAD_OK = 0,                          /**< file is loaded so far */
+    FWIMG_LOAD_ERR_FORMAT = 1,                  /**< file format is not recognized */
+    FWIMG_LOAD_ERR_RECORD = 2,                  /**< invalid Intel HEX record */
+    FWIMG_LOAD_ERR_HEADER = 3,                  /**< invalid binary image header */
+    FWIMG_LOAD_ERR_WRITE = 4,                   /**< out of memory, or the image is too large */
+    FWIMG_LOAD_ERR_INCOMPLETE = 5,              /**< file ended early, or has data after its end */
+    FWIMG_LOAD_ERR_CRC = 6,                     /**< binary image crc does not match */
+    FWIMG_LOAD_ERR_EMPTY = 7,                   /**< file holds no data */
+} fwimg_load_result_t;                          /**< loader result */
+
+/** binary image decoding state enum */
+typedef enum fwimg_bin_state_e {
+    FWIMG_BIN_HEADER = 0,                       /**< receiving the header */
+    FWIMG_BIN_ADDRESS = 1,                      /**< receiving the address of a page */
+    FWIMG_BIN_DATA = 2,                         /**< receiving the data of a page */
+    FWIMG_BIN_TRAILER = 3,                      /**< receiving the crc */
+    FWIMG_BIN_DONE = 4,                         /**< image is complete */
+} fwimg_bin_state_t;                            /**< binary image decoding state */
+
+/** Firmware image loader */
+typedef struct fwimg_loader_s {
+    fwimg_t *image;                             /**< image to fill */
+    fwimg_format_t format;                      /**< format of the file */
+    fwimg_load_result_t result;                 /**< first error, the loader stops at an error */
+    uint32_t bytes;                             /**< number of bytes fed */
+    hexstream_t hex;                            /**< record splitter of an Intel HEX file */
+    fwimg_bin_state_t state;                    /**< binary image decoding state */
+    uint8_t field[FWIMG_BIN_HEADER_LEN];        /**< header, address or crc being received */
+    uint32_t field_len;                         /**< number of bytes in field */
+    uint16_t page_size;                         /**< page size of the binary image */
+    uint32_t nr_of_pages;                       /**< number of pages of the binary image */
+    uint32_t pages;                             /**< number of pages received */
+    uint32_t address;                           /**< address of the page being received */
+    uint32_t offset;                            /**< number of data bytes of the page received */
+    uint16_t crc;                               /**< crc of the binary image so far */
+} fwimg_loader_t;
+
+/** Output of the binary image writer
+ *
+ * @param[in]  data  next bytes of the binary image.
+ * @param[in]  length  number of bytes.
+ * @param[in]  ctx  context passed to fwimg_bin_write.
+ * @returns  true when the bytes are written.
+ */
+typedef bool (* fwimg_bin_write_t)(const uint8_t *data, size_t length, void *ctx);
+
+/** Start loading a file into an image
+ *
+ * @param[out]  loader  loader to initialize.
+ * @param[in]  image  empty image to fill.
+ */
+void fwimg_loader_init(fwimg_loader_t *loader, fwimg_t *image);
+
+/** Feed the next chunk of the file
+ *
+ * @param[in|out]  loader  loader to feed.
+ * @param[in]  data  chunk of the file.
+ * @param[in]  length  length of the chunk.
+ * @returns  result of the load so far.
+ */
+fwimg_load_result_t fwimg_loader_feed(fwimg_loader_t *loader, const uint8_t *data, size_t length);
+
+/** Finish loading the file, finalizes the image when it is complete
+ *
+ * @param[in|out]  loader  loader to finish.
+ * @returns  result of the load.
+ */
+fwimg_load_result_t fwimg_loader_finish(fwimg_loader_t *loader);
+
+/** Get a description of a loader result
+ *
+ * @param[in]  result  loader result.
+ * @returns  description.
+ */
+const char *fwimg_loader_result_to_string(fwimg_load_result_t result);
+
+/** Write an image in the binary image format
+ *
+ * The pages are written in address order, an image always results in the same bytes as the
+ * converter script produces for it.
+ *
+ * @param[in]  image  image to write.
+ * @param[in]  write_fn  output of the binary image.
+ * @param[in]  ctx  context passed to write_fn.
+ * @retval  true  image is written.
+ * @retval  false  write_fn failed.
+ */
+bool fwimg_bin_write(const fwimg_t *image, fwimg_bin_write_t write_fn, void *ctx);
+
+#endif /* FW_IMAGE_LOADER_H_ */
@@ -0,0 +1,178 @@
+/**
+ * @file
+ * @brief Firmware image page definitions.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the definitions of the page indexed firmware image.
+ *
+ * The image is one flat buffer which starts at a page aligned address, with a bitmap of the pages
+ * which hold data and a crc per page. Bytes of a present page which are not part of the image are
+ * 0xFF. The buffer grows by doubling when data is written outside of it, such that an image takes
+ * a few allocations instead of one per record, and a page is found by its index.
+ *
+ * This part has no dependencies on the ESP-IDF such that it can be built and tested on the host.
+ */
+
+#ifndef FW_IMAGE_PAGE_H_
+    #define FW_IMAGE_PAGE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** value of the bytes which are not part of the image */
+#define FWIMG_FILL_BYTE 0xFFu
+
+/** memory types an image can be meant for (same values as the USB bootloader request) */
+#define FWIMG_MEMORY_NVRAM 0u
+#define FWIMG_MEMORY_FLASH 1u
+#define FWIMG_MEMORY_FLASH_CS 2u
+#define FWIMG_MEMORY_ANY 0xFFu
+
+/** Memory (re)allocation function, same contract as realloc
+ *
+ * @param[in]  ptr  block to resize, NULL to allocate a new block.
+ * @param[in]  size  new size of the block, 0 to free the block.
+ * @returns  resized block, NULL when out of memory (ptr stays valid).
+ */
+typedef void *(* fwimg_realloc_t)(void *ptr, size_t size);
+
+/** Firmware image */
+typedef struct fwimg_s {
+    uint8_t *data;                              /**< page data, starts at base */
+    uint32_t *present;                          /**< bitmap of the pages holding data */
+    uint16_t *page_crc;                         /**< crc per page, valid after fwimg_finalize */
+    uint32_t base;                              /**< address of the first byte of data */
+    uint32_t nr_of_pages;                       /**< number of pages from base to the last page holding data */
+    uint32_t capacity;                          /**< number of pages allocated */
+    uint32_t max_size;                          /**< maximum address span of the image (bytes) */
+    uint16_t page_size;                         /**< page size (bytes), a power of two */
+    uint32_t ext_address;                       /**< extended address of the Intel HEX records */
+    uint8_t memory;                             /**< memory the image is meant for, FWIMG_MEMORY_x */
+    bool finalized;                             /**< page crcs are calculated */
+    fwimg_realloc_t realloc_fn;                 /**< allocator of the buffers */
+} fwimg_t;
+
+/** Initialize an empty image
+ *
+ * @param[out]  image  image to initialize.
+ * @param[in]  page_size  page size (bytes), a power of two.
+ * @param[in]  max_size  maximum address span of the image (bytes).
+ * @param[in]  realloc_fn  allocator of the buffers.
+ */
+void fwimg_init(fwimg_t *image, uint16_t page_size, uint32_t max_size, fwimg_realloc_t realloc_fn);
+
+/** Release the buffers of an image, the image is empty afterwards
+ *
+ * @param[in|out]  image  image to release.
+ */
+void fwimg_free(fwimg_t *image);
+
+/** Write data into the image
+ *
+ * @param[in|out]  image  image to write into.
+ * @param[in]  address  address of the data.
+ * @param[in]  data  data to write.
+ * @param[in]  length  length of the data.
+ * @retval  true  data is written.
+ * @retval  false  out of memory, or the image would exceed its maximum size.
+ */
+bool fwimg_write(fwimg_t *image, uint32_t address, const uint8_t *data, size_t length);
+
+/** Write an Intel HEX record into the image
+ *
+ * Data, end of file, extended segment address and extended linear address records are handled,
+ * start address records are ignored.
+ *
+ * @param[in|out]  image  image to write into.
+ * @param[in]  line  record without line ending.
+ * @param[in]  length  length of the record.
+ * @retval  true  record is handled.
+ * @retval  false  record is invalid or could not be written.
+ */
+bool fwimg_write_hex_record(fwimg_t *image, const char *line, size_t length);
+
+/** Calculate the page crcs, to be called when all data is written
+ *
+ * @param[in|out]  image  image to finalize.
+ */
+void fwimg_finalize(fwimg_t *image);
+
+/** Get the number of pages holding data
+ *
+ * @param[in]  image  image.
+ * @returns  number of pages holding data.
+ */
+uint32_t fwimg_pages_present(const fwimg_t *image);
+
+/** Check whether a page holds data
+ *
+ * @param[in]  image  image.
+ * @param[in]  index  page index, counted from the base of the image.
+ * @returns  true when the page holds data.
+ */
+bool fwimg_page_present(const fwimg_t *image, uint32_t index);
+
+/** Get the data of a page by its address
+ *
+ * @param[in]  image  image.
+ * @param[in]  address  any address in the page.
+ * @returns  page data (page_size bytes), NULL when the page does not hold data.
+ */
+const uint8_t *fwimg_page(const fwimg_t *image, uint32_t address);
+
+/** Find the next page holding data
+ *
+ * @param[in]  image  image.
+ * @param[in|out]  index  page index to start searching at, the index of the page found.
+ * @retval  true  page found.
+ * @retval  false  no more pages hold data.
+ */
+bool fwimg_next_page(const fwimg_t *image, uint32_t *index);
+
+/** Get the address of a page
+ *
+ * @param[in]  image  image.
+ * @param[in]  index  page index, counted from the base of the image.
+ * @returns  address of the first byte of the page.
+ */
+uint32_t fwimg_page_address(const fwimg_t *image, uint32_t index);
+
+/** Collect the pages of an image which differ from a reference image
+ *
+ * Pages are compared by their crc first and by their data when the crcs are equal. The delta is
+ * only useful when writing it over the reference results in the image, which is not the case when
+ * the reference holds pages which the image does not hold.
+ *
+ * @param[in]  image  finalized image.
+ * @param[in]  reference  finalized image which is in the memory now.
+ * @param[in|out]  delta  empty image which receives the pages which differ, finalized.
+ * @param[out]  skipped  number of pages which are equal.
+ * @retval  true  delta holds the pages to write over the reference.
+ * @retval  false  page sizes differ, the reference holds other pages, or out of memory.
+ */
+bool fwimg_delta(const fwimg_t *image, const fwimg_t *reference, fwimg_t *delta, uint32_t *skipped);
+
+/** Copy the pages of an image, e.g. to hand an image over to a job while the original may change
+ *
+ * @param[in]  image  image to copy.
+ * @param[in|out]  copy  empty image with the same page size which receives the pages, finalized.
+ * @retval  true  copy holds the pages of the image.
+ * @retval  false  page sizes differ, or out of memory.
+ */
+bool fwimg_copy(const fwimg_t *image, fwimg_t *copy);
+
+#endif /* FW_IMAGE_PAGE_H_ */
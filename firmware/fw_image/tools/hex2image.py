@@ -0,0 +1,126 @@
+#!/bin/env python3
+"""Convert an Intel HEX file into a binary image for the PPM bootloader
+
+The binary image is accepted by the USB hex transfer and the websocket upload as an alternative to
+the Intel HEX file. It holds the data per page, such that the device does not need to parse text,
+and is less than half the size of the Intel HEX file. The SHA-256 hash of the binary image is the
+key of the image in the firmware image cache of the device.
+
+Copyright Melexis N.V.
+
+This product includes software developed at Melexis N.V. (https://www.melexis.com).
+
+Melexis N.V. has provided this code according to LICENSE file attached to repository
+"""
+import argparse
+import hashlib
+import struct
+from pathlib import Path
+
+MAGIC = b"MCMI"
+VERSION = 1
+MEMORIES = {
+    "nvram": 0,
+    "flash": 1,
+    "flash_cs": 2,
+    "any": 0xFF,
+}
+FILL_BYTE = 0xFF
+CRC_SEED = 0xFFFF
+
+
+def crc16(data, crc=CRC_SEED):
+    """CRC-16/CCITT (polynomial 0x1021, MSB first, no final xor)"""
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def read_hex(path):
+    """Read an Intel HEX file into a dictionary of address: byte"""
+    memory = {}
+    ext_address = 0
+    with open(path, "r") as fd:
+        for line_nr, line in enumerate(fd, start=1):
+            line = line.strip()
+            if not line:
+                continue
+            if not line.startswith(":"):
+                raise ValueError(f"line {line_nr}: record does not start with ':'")
+            record = bytes.fromhex(line[1:])
+            if (len(record) < 5) or (len(record) != record[0] + 5):
+                raise ValueError(f"line {line_nr}: invalid record length")
+            if (sum(record) & 0xFF) != 0:
+                raise ValueError(f"line {line_nr}: invalid checksum")
+            count, offset, rectype = record[0], (record[1] << 8) | record[2], record[3]
+            data = record[4:4 + count]
+            if rectype == 0x00:
+                for index, byte in enumerate(data):
+                    memory[ext_address + offset + index] = byte
+            elif rectype == 0x01:
+                break
+            elif rectype == 0x02:
+                ext_address = ((data[0] << 8) | data[1]) << 4
+            elif rectype == 0x04:
+                ext_address = ((data[0] << 8) | data[1]) << 16
+            elif rectype not in (0x03, 0x05):
+                raise ValueError(f"line {line_nr}: unknown record type {rectype:#04x}")
+    return memory
+
+
+def build_image(memory, memory_type, page_size):
+    """Build the binary image from the data, a page is included when it holds data"""
+    pages = sorted({address - (address % page_size) for address in memory})
+    image = bytearray(MAGIC)
+    image += struct.pack("<BBHII", VERSION, memory_type, page_size, len(pages), 0)
+    for page in pages:
+        image += struct.pack("<I", page)
+        image += bytes(memory.get(page + index, FILL_BYTE) for index in range(page_size))
+    image += struct.pack("<H", crc16(image))
+    return bytes(image)
+
+
+def page_size_type(value):
+    size = int(value, 0)
+    if (size <= 0) or (size > 4096) or (size & (size - 1)):
+        raise argparse.ArgumentTypeError("page size must be a power of two up to 4096")
+    return size
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Melexis Intel HEX to bootloader image converter")
+    parser.add_argument("hexfile",
+                        action="store",
+                        type=Path,
+                        help="path to the Intel HEX file")
+    parser.add_argument("image",
+                        action="store",
+                        type=Path,
+                        help="path of the binary image to write")
+    parser.add_argument("--memory",
+                        action="store",
+                        choices=MEMORIES.keys(),
+                        default="any",
+                        help="memory the image is meant for (default: any)")
+    parser.add_argument("--page-size",
+                        action="store",
+                        type=page_size_type,
+                        default=128,
+                        help="page size of the image in bytes (default: 128)")
+    args = parser.parse_args()
+
+    memory = read_hex(args.hexfile)
+    image = build_image(memory, MEMORIES[args.memory], args.page_size)
+    with open(args.image, "wb") as fd:
+        fd.write(image)
+
+    print(f"{len(memory)} bytes in {(len(image) - 18) // (args.page_size + 4)} pages, "
+          f"{args.hexfile.stat().st_size} -> {len(image)} bytes")
+    print(f"sha256 {hashlib.sha256(image).hexdigest()}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,172 @@
+/**
+ * @file
+ * @brief Intel HEX stream routines.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the implementations of the Intel HEX stream line splitter.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "hex_stream.h"
+
+/** bytes of a word set to the line feed character */
+#define HEXSTREAM_LF_WORD 0x0A0A0A0Au
+
+/** bytes of a word set to the carriage return character */
+#define HEXSTREAM_CR_WORD 0x0D0D0D0Du
+
+/** Check whether a word holds a zero byte, may report bytes following a zero byte as well */
+#define HEXSTREAM_HAS_ZERO(word) (((word) - 0x01010101u) & ~(word) & 0x80808080u)
+
+/** Find the end of a record
+ *
+ * @param[in]  data  start of the data to search.
+ * @param[in]  end  end of the data to search.
+ * @returns  first CR or LF character, end when there is none.
+ */
+static const uint8_t *hexstream_find_eol(const uint8_t *data, const uint8_t *end);
+
+/** Hand a record over to the handler, empty records are skipped
+ *
+ * @param[in|out]  stream  stream the record belongs to.
+ * @param[in]  line  record without line ending.
+ * @param[in]  length  length of the record.
+ * @param[in]  handler  record handler.
+ * @param[in]  ctx  context pointer to pass to the handler.
+ */
+static void hexstream_handle(hexstream_t *stream,
+                             const char *line,
+                             size_t length,
+                             hexstream_line_handler_t handler,
+                             void *ctx);
+
+/** Append a part of a record to the pending record
+ *
+ * @param[in|out]  stream  stream to append to.
+ * @param[in]  data  part of the record.
+ * @param[in]  length  length of the part.
+ */
+static void hexstream_append(hexstream_t *stream, const uint8_t *data, size_t length);
+
+
+static const uint8_t *hexstream_find_eol(const uint8_t *data, const uint8_t *end) {
+    const uint8_t *pos = data;
+    bool found = false;
+
+    /* bytes up to the first word boundary */
+    while (!found && (pos < end) && (((uintptr_t)pos % sizeof(uint32_t)) != 0u)) {
+        found = (*pos == '\n') || (*pos == '\r');
+        if (!found) {
+            pos++;
+        }
+    }
+
+    /* whole words, until a word which might hold a line ending */
+    while (!found && ((size_t)(end - pos) >= sizeof(uint32_t))) {
+        uint32_t word;
+        memcpy(&word, pos, sizeof(uint32_t));
+        if ((HEXSTREAM_HAS_ZERO(word ^ HEXSTREAM_LF_WORD) | HEXSTREAM_HAS_ZERO(word ^ HEXSTREAM_CR_WORD)) != 0u) {
+            break;
+        }
+        pos += sizeof(uint32_t);
+    }
+
+    /* locate the line ending in the word, or check the tail */
+    while (!found && (pos < end)) {
+        found = (*pos == '\n') || (*pos == '\r');
+        if (!found) {
+            pos++;
+        }
+    }
+
+    return pos;
+}
+
+static void hexstream_handle(hexstream_t *stream,
+                             const char *line,
+                             size_t length,
+                             hexstream_line_handler_t handler,
+                             void *ctx) {
+    if (length > HEXSTREAM_MAX_LINE_LEN) {
+        stream->result = HEXSTREAM_ERR_LINE_TOO_LONG;
+    } else if (length > 0u) {
+        if (handler(line, length, ctx)) {
+            stream->lines++;
+        } else {
+            stream->result = HEXSTREAM_ERR_RECORD;
+        }
+    }
+}
+
+static void hexstream_append(hexstream_t *stream, const uint8_t *data, size_t length) {
+    if ((stream->length + length) > HEXSTREAM_MAX_LINE_LEN) {
+        stream->result = HEXSTREAM_ERR_LINE_TOO_LONG;
+    } else {
+        memcpy(&stream->line[stream->length], data, length);
+        stream->length += length;
+    }
+}
+
+void hexstream_init(hexstream_t *stream) {
+    stream->length = 0u;
+    stream->lines = 0u;
+    stream->bytes = 0u;
+    stream->result = HEXSTREAM_OK;
+}
+
+hexstream_result_t hexstream_feed(hexstream_t *stream,
+                                  const uint8_t *data,
+                                  size_t length,
+                                  hexstream_line_handler_t handler,
+                                  void *ctx) {
+    const uint8_t *pos = data;
+    const uint8_t *end = &data[length];
+
+    while ((stream->result == HEXSTREAM_OK) && (pos < end)) {
+        const uint8_t *eol = hexstream_find_eol(pos, end);
+
+        if (eol == end) {
+            /* keep the incomplete record for the next chunk */
+            hexstream_append(stream, pos, (size_t)(end - pos));
+        } else if (stream->length == 0u) {
+            /* complete record in the chunk, handled in place */
+            hexstream_handle(stream, (const char *)pos, (size_t)(eol - pos), handler, ctx);
+        } else {
+            /* record started in a previous chunk */
+            hexstream_append(stream, pos, (size_t)(eol - pos));
+            if (stream->result == HEXSTREAM_OK) {
+                hexstream_handle(stream, stream->line, stream->length, handler, ctx);
+                stream->length = 0u;
+            }
+        }
+        pos = (eol == end) ? end : (eol + 1);
+    }
+    stream->bytes += (uint32_t)length;
+
+    return stream->result;
+}
+
+hexstream_result_t hexstream_finish(hexstream_t *stream, hexstream_line_handler_t handler, void *ctx) {
+    if (stream->result == HEXSTREAM_OK) {
+        hexstream_handle(stream, stream->line, stream->length, handler, ctx);
+        stream->length = 0u;
+    }
+
+    return stream->result;
+}
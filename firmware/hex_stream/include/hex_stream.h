@@ -0,0 +1,101 @@
+/**
+ * @file
+ * @brief Intel HEX stream definitions.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the definitions of the Intel HEX stream line splitter.
+ *
+ * An Intel HEX file which arrives in chunks of arbitrary size is split in records (lines) as the
+ * chunks arrive, such that the records can be parsed while the rest of the file is still being
+ * transferred. Only the incomplete record at the end of a chunk is kept in between chunks, the
+ * memory needed does not depend on the size of the file.
+ *
+ * Every byte is scanned once, the line endings are searched a word at a time. Records which are
+ * complete within a chunk are handed to the handler in place, only a record split over two chunks
+ * is copied.
+ *
+ * This part has no dependencies on the ESP-IDF such that it can be built and tested on the host.
+ */
+
+#ifndef HEX_STREAM_H_
+    #define HEX_STREAM_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** maximum length of an Intel HEX record: ':' followed by 2 * (1 + 2 + 1 + 255 + 1) characters */
+#define HEXSTREAM_MAX_LINE_LEN 521u
+
+/** Intel HEX stream result enum */
+typedef enum hexstream_result_e {
+    HEXSTREAM_OK = 0,                           /**< chunk is handled */
+    HEXSTREAM_ERR_LINE_TOO_LONG = 1,            /**< a record exceeds the maximum record length */
+    HEXSTREAM_ERR_RECORD = 2,                   /**< the record handler refused a record */
+} hexstream_result_t;                           /**< Intel HEX stream result */
+
+/** Record handler
+ *
+ * @param[in]  line  record without line ending, not zero terminated.
+ * @param[in]  length  length of the record.
+ * @param[in]  ctx  context pointer as passed to hexstream_feed.
+ * @retval  true  record is handled.
+ * @retval  false  record is invalid, the stream stops.
+ */
+typedef bool (* hexstream_line_handler_t)(const char *line, size_t length, void *ctx);
+
+/** Intel HEX stream state */
+typedef struct hexstream_s {
+    char line[HEXSTREAM_MAX_LINE_LEN];          /**< incomplete record of the previous chunk */
+    size_t length;                              /**< length of the incomplete record */
+    uint32_t lines;                             /**< number of records handled */
+    uint32_t bytes;                             /**< number of bytes fed */
+    hexstream_result_t result;                  /**< first error of the stream, the stream stops at an error */
+} hexstream_t;
+
+/** Start a new stream
+ *
+ * @param[out]  stream  stream to initialize.
+ */
+void hexstream_init(hexstream_t *stream);
+
+/** Feed the next chunk of the file
+ *
+ * The handler is called for every complete record in the chunk, empty lines are skipped.
+ *
+ * @param[in|out]  stream  stream to feed.
+ * @param[in]  data  chunk of the file.
+ * @param[in]  length  length of the chunk.
+ * @param[in]  handler  record handler.
+ * @param[in]  ctx  context pointer to pass to the handler.
+ * @returns  result of the stream so far.
+ */
+hexstream_result_t hexstream_feed(hexstream_t *stream,
+                                  const uint8_t *data,
+                                  size_t length,
+                                  hexstream_line_handler_t handler,
+                                  void *ctx);
+
+/** Finish the stream, handles the last record when the file does not end with a line ending
+ *
+ * @param[in|out]  stream  stream to finish.
+ * @param[in]  handler  record handler.
+ * @param[in]  ctx  context pointer to pass to the handler.
+ * @returns  result of the stream.
+ */
+hexstream_result_t hexstream_finish(hexstream_t *stream, hexstream_line_handler_t handler, void *ctx);
+
+#endif /* HEX_STREAM_H_ */
@@ -0,0 +1,181 @@
+/**
+ * @file
+ * @brief Job table definitions.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the definitions of the job table, which keeps the state of the
+ * queued, running and recently finished jobs.
+ *
+ * A job is queued, runs and ends as done, failed or cancelled. A queued job is cancelled at once,
+ * a running job only gets its cancel request flagged as the job itself decides where it can stop.
+ * Finished jobs are kept such that their state can be polled, the oldest finished job makes room
+ * for a new one. This part has no dependencies on the ESP-IDF such that it can be built and
+ * tested on the host, the caller passes the time and takes care of the locking.
+ */
+
+#ifndef JOB_TABLE_H_
+    #define JOB_TABLE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** number of jobs kept in the table */
+#define JOB_TABLE_SIZE 16u
+
+/** job id which never identifies a job */
+#define JOB_ID_NONE 0u
+
+/** kind of work done by a job */
+typedef enum job_kind_e {
+    JOB_KIND_BOOTLOADER = 0,                    /**< PPM bootloader action */
+    JOB_KIND_OTA_VALIDATE,                      /**< validation of a firmware update */
+    JOB_KIND_LIN_BATCH,                         /**< batch of LIN frames */
+    JOB_KIND_CACHE_STORE,                       /**< write of an image to the image cache */
+    JOB_NR_OF_KINDS
+} job_kind_t;
+
+/** state of a job */
+typedef enum job_state_e {
+    JOB_STATE_QUEUED = 0,                       /**< waiting for the worker */
+    JOB_STATE_RUNNING,                          /**< being run by the worker */
+    JOB_STATE_DONE,                             /**< finished successfully */
+    JOB_STATE_FAILED,                           /**< finished with an error */
+    JOB_STATE_CANCELLED,                        /**< cancelled before or while running */
+} job_state_t;
+
+/** cancel request result */
+typedef enum job_cancel_result_e {
+    JOB_CANCEL_DONE = 0,                        /**< queued job is cancelled */
+    JOB_CANCEL_REQUESTED,                       /**< running job is requested to stop */
+    JOB_CANCEL_TOO_LATE,                        /**< job has already finished */
+    JOB_CANCEL_UNKNOWN,                         /**< job is not known (anymore) */
+} job_cancel_result_t;
+
+/** job information, also the payload of the USB bulk job messages */
+typedef struct job_info_s {
+    uint32_t id;                                /**< job id */
+    uint8_t kind;                               /**< job_kind_t */
+    uint8_t state;                              /**< job_state_t */
+    uint8_t cancel_requested;                   /**< 1: job is requested to stop */
+    uint8_t reserved;                           /**< reserved, 0 */
+    int32_t error;                              /**< error code of a failed job, 0 otherwise */
+    uint32_t created_ms;                        /**< time the job was queued (ms) */
+    uint32_t started_ms;                        /**< time the job started running (ms), 0 when queued */
+    uint32_t finished_ms;                       /**< time the job finished (ms), 0 when pending */
+} job_info_t;
+
+/** job table */
+typedef struct job_table_s {
+    job_info_t jobs[JOB_TABLE_SIZE];            /**< jobs, id JOB_ID_NONE for a free slot */
+    uint32_t next_id;                           /**< id of the next job */
+} job_table_t;
+
+/** Initialize a job table
+ *
+ * @param[out]  table  job table.
+ */
+void job_table_init(job_table_t *table);
+
+/** Add a queued job to the table
+ *
+ * @param[in|out]  table  job table.
+ * @param[in]  kind  kind of job.
+ * @param[in]  max_pending  maximum number of queued and running jobs.
+ * @param[in]  now_ms  current time (ms).
+ * @returns  the slot of the job, -1 when the maximum number of pending jobs is reached.
+ */
+int job_table_add(job_table_t *table, job_kind_t kind, size_t max_pending, uint32_t now_ms);
+
+/** Find a job in the table
+ *
+ * @param[in]  table  job table.
+ * @param[in]  id  job id.
+ * @returns  the slot of the job, -1 when the job is not known (anymore).
+ */
+int job_table_find(const job_table_t *table, uint32_t id);
+
+/** Mark a queued job as running
+ *
+ * @param[in|out]  table  job table.
+ * @param[in]  slot  slot of the job.
+ * @param[in]  now_ms  current time (ms).
+ * @retval  true  job is running.
+ * @retval  false  job was cancelled and shall not run.
+ */
+bool job_table_start(job_table_t *table, int slot, uint32_t now_ms);
+
+/** Mark a running job as finished
+ *
+ * A job which fails after a cancel request is considered cancelled.
+ *
+ * @param[in|out]  table  job table.
+ * @param[in]  slot  slot of the job.
+ * @param[in]  success  true: the job succeeded.
+ * @param[in]  error  error code of a failed job.
+ * @param[in]  now_ms  current time (ms).
+ * @returns  the final state of the job.
+ */
+job_state_t job_table_finish(job_table_t *table, int slot, bool success, int32_t error, uint32_t now_ms);
+
+/** Cancel a job
+ *
+ * @param[in|out]  table  job table.
+ * @param[in]  id  job id.
+ * @param[in]  now_ms  current time (ms).
+ * @returns  the result of the cancel request.
+ */
+job_cancel_result_t job_table_cancel(job_table_t *table, uint32_t id, uint32_t now_ms);
+
+/** Get the number of queued and running jobs
+ *
+ * @param[in]  table  job table.
+ * @returns  number of pending jobs.
+ */
+size_t job_table_pending(const job_table_t *table);
+
+/** Get the jobs in the table, oldest first
+ *
+ * @param[in]  table  job table.
+ * @param[out]  infos  buffer for the jobs.
+ * @param[in]  max_infos  size of the buffer in jobs.
+ * @returns  number of jobs copied into the buffer.
+ */
+size_t job_table_list(const job_table_t *table, job_info_t *infos, size_t max_infos);
+
+/** Check whether a job state is final
+ *
+ * @param[in]  state  job state.
+ * @retval  true  job has finished.
+ * @retval  false  job is queued or running.
+ */
+bool job_state_is_final(job_state_t state);
+
+/** Get the name of a job state
+ *
+ * @param[in]  state  job state.
+ * @returns  name of the state.
+ */
+const char *job_state_to_string(job_state_t state);
+
+/** Get the name of a job kind
+ *
+ * @param[in]  kind  job kind.
+ * @returns  name of the kind.
+ */
+const char *job_kind_to_string(job_kind_t kind);
+
+#endif /* JOB_TABLE_H_ */
@@ -0,0 +1,143 @@
+/**
+ * @file
+ * @brief Asynchronous job engine definitions.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the definitions of the asynchronous job engine.
+ *
+ * Long running device operations, such as a bootloader action, are submitted as a job by the
+ * interface which received the request, such that the web server and USB tasks stay responsive.
+ * One worker task runs the jobs in order from a bounded queue. Every job gets an id by which its
+ * state can be polled and by which it can be cancelled. The submitter learns the outcome through
+ * its done callback, other interested parties through a job listener.
+ */
+
+#ifndef JOBS_H_
+    #define JOBS_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+#include "job_table.h"
+
+/** Job function, called from the worker task
+ *
+ * A job which can stop early shall check jobs_cancel_requested() at convenient points.
+ *
+ * @param[in]  id  job id.
+ * @param[in]  arg  argument as passed at submission.
+ * @param[out]  error  error code to report when the job fails.
+ * @retval  true  job succeeded.
+ * @retval  false  job failed or stopped on a cancel request.
+ */
+typedef bool (* jobs_run_t)(uint32_t id, void *arg, int32_t *error);
+
+/** Job done callback, called from the worker task exactly once per submitted job
+ *
+ * Also called for a job which was cancelled before it ran, such that the submitter can always
+ * answer the request and release the argument.
+ *
+ * @param[in]  id  job id.
+ * @param[in]  state  final state of the job.
+ * @param[in]  error  error code of a failed job, 0 otherwise.
+ * @param[in]  arg  argument as passed at submission.
+ */
+typedef void (* jobs_done_t)(uint32_t id, job_state_t state, int32_t error, void *arg);
+
+/** Job listener, called on every state change of a job
+ *
+ * Called with the job engine locked, a listener shall not block for long.
+ *
+ * @param[in]  info  job information.
+ * @param[in]  ctx  context pointer as passed during registration.
+ */
+typedef void (* jobs_listener_t)(const job_info_t *info, void *ctx);
+
+/** Initialize the job engine and start its worker task
+ *
+ * @returns  ESP_OK when jobs can be submitted.
+ */
+esp_err_t jobs_init(void);
+
+/** Submit a job
+ *
+ * @param[in]  kind  kind of job.
+ * @param[in]  run  job function.
+ * @param[in]  done  done callback, may be NULL.
+ * @param[in]  arg  argument for the job function and the done callback.
+ * @param[out]  id  id of the submitted job, may be NULL. It is written with the engine locked
+ *                  before the job can run, such that the done callback can clear it. JOB_ID_NONE
+ *                  when the job is refused.
+ * @retval  ESP_OK  job is queued, the done callback will be called.
+ * @retval  ESP_ERR_NO_MEM  job queue is full, the done callback will not be called.
+ * @retval  ESP_ERR_INVALID_STATE  job engine is not initialized.
+ */
+esp_err_t jobs_submit(job_kind_t kind, jobs_run_t run, jobs_done_t done, void *arg, uint32_t *id);
+
+/** Get the state of a job
+ *
+ * @param[in]  id  job id.
+ * @param[out]  info  job information.
+ * @retval  ESP_OK  job information is copied.
+ * @retval  ESP_ERR_NOT_FOUND  job is not known (anymore).
+ */
+esp_err_t jobs_get(uint32_t id, job_info_t *info);
+
+/** Get the queued, running and recently finished jobs, oldest first
+ *
+ * @param[out]  infos  buffer for the jobs.
+ * @param[in]  max_infos  size of the buffer in jobs.
+ * @returns  number of jobs copied into the buffer.
+ */
+size_t jobs_list(job_info_t *infos, size_t max_infos);
+
+/** Cancel a job
+ *
+ * A queued job is cancelled at once, a running job stops at its next cancel check.
+ *
+ * @param[in]  id  job id.
+ * @returns  the result of the cancel request.
+ */
+job_cancel_result_t jobs_cancel(uint32_t id);
+
+/** Check whether a job is requested to stop
+ *
+ * @param[in]  id  job id.
+ * @retval  true  job shall stop.
+ * @retval  false  job can continue.
+ */
+bool jobs_cancel_requested(uint32_t id);
+
+/** Register a job listener
+ *
+ * @param[in]  listener  listener to register.
+ * @param[in]  ctx  context pointer to be passed to the listener.
+ * @retval  ESP_OK  listener is registered.
+ * @retval  ESP_ERR_NO_MEM  maximum number of listeners is reached.
+ */
+esp_err_t jobs_add_listener(jobs_listener_t listener, void *ctx);
+
+/** Unregister a job listener
+ *
+ * @param[in]  listener  listener to unregister.
+ * @param[in]  ctx  context pointer as passed during registration.
+ */
+void jobs_remove_listener(jobs_listener_t listener, void *ctx);
+
+#endif /* JOBS_H_ */
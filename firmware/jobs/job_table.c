@@ -0,0 +1,234 @@
+/**
+ * @file
+ * @brief Job table routines.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the implementations of the job table.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "job_table.h"
+
+/** Get a slot for a new job, a free slot or else the slot of the oldest finished job
+ *
+ * @param[in]  table  job table.
+ * @returns  the slot, -1 when all slots hold a pending job.
+ */
+static int job_table_free_slot(const job_table_t *table) {
+    int retval = -1;
+
+    for (size_t i = 0; i < JOB_TABLE_SIZE; i++) {
+        const job_info_t *job = &table->jobs[i];
+        if (job->id == JOB_ID_NONE) {
+            retval = (int)i;
+            break;
+        }
+        if (job_state_is_final((job_state_t)job->state) &&
+            ((retval < 0) || (job->id < table->jobs[retval].id))) {
+            retval = (int)i;
+        }
+    }
+
+    return retval;
+}
+
+void job_table_init(job_table_t *table) {
+    memset(table, 0, sizeof(job_table_t));
+    table->next_id = JOB_ID_NONE + 1u;
+}
+
+int job_table_add(job_table_t *table, job_kind_t kind, size_t max_pending, uint32_t now_ms) {
+    int retval = -1;
+
+    if (job_table_pending(table) < max_pending) {
+        retval = job_table_free_slot(table);
+    }
+    if (retval >= 0) {
+        job_info_t *job = &table->jobs[retval];
+        memset(job, 0, sizeof(job_info_t));
+        job->id = table->next_id;
+        job->kind = (uint8_t)kind;
+        job->state = (uint8_t)JOB_STATE_QUEUED;
+        job->created_ms = now_ms;
+        table->next_id++;
+        if (table->next_id == JOB_ID_NONE) {
+            table->next_id++;
+        }
+    }
+
+    return retval;
+}
+
+int job_table_find(const job_table_t *table, uint32_t id) {
+    int retval = -1;
+
+    if (id != JOB_ID_NONE) {
+        for (size_t i = 0; i < JOB_TABLE_SIZE; i++) {
+            if (table->jobs[i].id == id) {
+                retval = (int)i;
+                break;
+            }
+        }
+    }
+
+    return retval;
+}
+
+bool job_table_start(job_table_t *table, int slot, uint32_t now_ms) {
+    bool retval = false;
+    job_info_t *job = &table->jobs[slot];
+
+    if (job->state == (uint8_t)JOB_STATE_QUEUED) {
+        job->state = (uint8_t)JOB_STATE_RUNNING;
+        job->started_ms = now_ms;
+        retval = true;
+    }
+
+    return retval;
+}
+
+job_state_t job_table_finish(job_table_t *table, int slot, bool success, int32_t error, uint32_t now_ms) {
+    job_info_t *job = &table->jobs[slot];
+
+    if (success) {
+        job->state = (uint8_t)JOB_STATE_DONE;
+    } else if (job->cancel_requested != 0u) {
+        job->state = (uint8_t)JOB_STATE_CANCELLED;
+    } else {
+        job->state = (uint8_t)JOB_STATE_FAILED;
+    }
+    job->error = success ? 0 : error;
+    job->finished_ms = now_ms;
+
+    return (job_state_t)job->state;
+}
+
+job_cancel_result_t job_table_cancel(job_table_t *table, uint32_t id, uint32_t now_ms) {
+    job_cancel_result_t retval = JOB_CANCEL_UNKNOWN;
+    int slot = job_table_find(table, id);
+
+    if (slot >= 0) {
+        job_info_t *job = &table->jobs[slot];
+        if (job->state == (uint8_t)JOB_STATE_QUEUED) {
+            job->state = (uint8_t)JOB_STATE_CANCELLED;
+            job->cancel_requested = 1u;
+            job->finished_ms = now_ms;
+            retval = JOB_CANCEL_DONE;
+        } else if (job->state == (uint8_t)JOB_STATE_RUNNING) {
+            job->cancel_requested = 1u;
+            retval = JOB_CANCEL_REQUESTED;
+        } else {
+            retval = JOB_CANCEL_TOO_LATE;
+        }
+    }
+
+    return retval;
+}
+
+size_t job_table_pending(const job_table_t *table) {
+    size_t retval = 0u;
+
+    for (size_t i = 0; i < JOB_TABLE_SIZE; i++) {
+        if ((table->jobs[i].id != JOB_ID_NONE) && !job_state_is_final((job_state_t)table->jobs[i].state)) {
+            retval++;
+        }
+    }
+
+    return retval;
+}
+
+size_t job_table_list(const job_table_t *table, job_info_t *infos, size_t max_infos) {
+    size_t retval = 0u;
+
+    for (size_t i = 0; i < JOB_TABLE_SIZE; i++) {
+        const job_info_t *job = &table->jobs[i];
+        if (job->id == JOB_ID_NONE) {
+            continue;
+        }
+        /* insertion sort on the job id, dropping the newest jobs when the buffer is full */
+        size_t pos = retval;
+        while ((pos > 0u) && (infos[pos - 1u].id > job->id)) {
+            if (pos < max_infos) {
+                infos[pos] = infos[pos - 1u];
+            }
+            pos--;
+        }
+        if (pos < max_infos) {
+            infos[pos] = *job;
+            if (retval < max_infos) {
+                retval++;
+            }
+        }
+    }
+
+    return retval;
+}
+
+bool job_state_is_final(job_state_t state) {
+    return (state == JOB_STATE_DONE) || (state == JOB_STATE_FAILED) || (state == JOB_STATE_CANCELLED);
+}
+
+const char *job_state_to_string(job_state_t state) {
+    const char *retval = "unknown";
+
+    switch (state) {
+        case JOB_STATE_QUEUED:
+            retval = "queued";
+            break;
+        case JOB_STATE_RUNNING:
+            retval = "running";
+            break;
+        case JOB_STATE_DONE:
+            retval = "done";
+            break;
+        case JOB_STATE_FAILED:
+            retval = "failed";
+            break;
+        case JOB_STATE_CANCELLED:
+            retval = "cancelled";
+            break;
+        default:
+            break;
+    }
+
+    return retval;
+}
+
+const char *job_kind_to_string(job_kind_t kind) {
+    const char *retval = "unknown";
+
+    switch (kind) {
+        case JOB_KIND_BOOTLOADER:
+            retval = "bootloader";
+            break;
+        case JOB_KIND_OTA_VALIDATE:
+            retval = "ota_validate";
+            break;
+        case JOB_KIND_LIN_BATCH:
+            retval = "lin_batch";
+            break;
+        case JOB_KIND_CACHE_STORE:
+            retval = "cache_store";
+            break;
+        default:
+            break;
+    }
+
+    return retval;
+}
@@ -0,0 +1,280 @@
+/**
+ * @file
+ * @brief Asynchronous job engine routines.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the implementations of the asynchronous job engine. The job table
+ * and the job queue are updated together with the lock taken, such that a job in the queue always
+ * has an entry in the table until it was cancelled.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+#include "sdkconfig.h"
+
+#include "jobs.h"
+
+/** maximum number of job listeners */
+#define JOBS_MAX_LISTENERS 4u
+
+static const char *TAG = "jobs";
+
+typedef struct jobs_item_s {
+    uint32_t id;                                /**< job id */
+    jobs_run_t run;                             /**< job function */
+    jobs_done_t done;                           /**< done callback, or NULL */
+    void *arg;                                  /**< argument for the job function and the done callback */
+} jobs_item_t;
+
+typedef struct jobs_listener_entry_s {
+    jobs_listener_t listener;                   /**< registered listener, or NULL */
+    void *ctx;                                  /**< context for the listener */
+} jobs_listener_entry_t;
+
+static job_table_t table;
+static SemaphoreHandle_t jobs_lock = NULL;
+static QueueHandle_t jobs_queue = NULL;
+static jobs_listener_entry_t listeners[JOBS_MAX_LISTENERS];
+
+/** Get the current time for the job table
+ *
+ * @returns  time since boot (ms).
+ */
+static uint32_t jobs_now_ms(void) {
+    return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
+/** Hand a job state change over to the listeners, to be called with the lock taken
+ *
+ * @param[in]  slot  slot of the job in the table.
+ */
+static void jobs_notify(int slot) {
+    for (size_t i = 0; i < JOBS_MAX_LISTENERS; i++) {
+        if (listeners[i].listener != NULL) {
+            listeners[i].listener(&table.jobs[slot], listeners[i].ctx);
+        }
+    }
+}
+
+/** Worker task, runs the queued jobs one by one
+ *
+ * @param[in]  pvParameters  task parameters (not used).
+ */
+static void jobs_task(void *pvParameters) {
+    (void)pvParameters;
+    jobs_item_t item;
+
+    for (;;) {
+        if (xQueueReceive(jobs_queue, &item, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+
+        (void)xSemaphoreTake(jobs_lock, portMAX_DELAY);
+        int slot = job_table_find(&table, item.id);
+        bool started = (slot >= 0) && job_table_start(&table, slot, jobs_now_ms());
+        if (started) {
+            jobs_notify(slot);
+        }
+        (void)xSemaphoreGive(jobs_lock);
+
+        job_state_t state = JOB_STATE_CANCELLED;
+        int32_t error = 0;
+        if (started) {
+            ESP_LOGI(TAG, "job %lu started", (unsigned long)item.id);
+            bool success = item.run(item.id, item.arg, &error);
+
+            (void)xSemaphoreTake(jobs_lock, portMAX_DELAY);
+            state = job_table_finish(&table, slot, success, error, jobs_now_ms());
+            jobs_notify(slot);
+            (void)xSemaphoreGive(jobs_lock);
+            if (success) {
+                error = 0;
+            }
+        }
+        ESP_LOGI(TAG, "job %lu %s", (unsigned long)item.id, job_state_to_string(state));
+
+        if (item.done != NULL) {
+            item.done(item.id, state, error, item.arg);
+        }
+    }
+}
+
+esp_err_t jobs_init(void) {
+    esp_err_t retval = ESP_OK;
+
+    if (jobs_lock == NULL) {
+        job_table_init(&table);
+        jobs_queue = xQueueCreate(CONFIG_JOBS_QUEUE_LEN, sizeof(jobs_item_t));
+        SemaphoreHandle_t lock = xSemaphoreCreateMutex();
+        if ((jobs_queue == NULL) || (lock == NULL)) {
+            retval = ESP_ERR_NO_MEM;
+        } else if (xTaskCreate(jobs_task,
+                               "jobs_task",
+                               CONFIG_JOBS_TASK_STACK_SIZE,
+                               NULL,
+                               CONFIG_JOBS_TASK_PRIORITY,
+                               NULL) != pdPASS) {
+            retval = ESP_ERR_NO_MEM;
+        } else {
+            jobs_lock = lock;
+        }
+        if (retval != ESP_OK) {
+            ESP_LOGE(TAG, "initialization failed (%s)", esp_err_to_name(retval));
+        }
+    }
+
+    return retval;
+}
+
+esp_err_t jobs_submit(job_kind_t kind, jobs_run_t run, jobs_done_t done, void *arg, uint32_t *id) {
+    esp_err_t retval = ESP_ERR_NO_MEM;
+
+    if (jobs_lock == NULL) {
+        retval = ESP_ERR_INVALID_STATE;
+    } else {
+        (void)xSemaphoreTake(jobs_lock, portMAX_DELAY);
+        /* the running job has left the queue */
+        int slot = job_table_add(&table, kind, CONFIG_JOBS_QUEUE_LEN + 1u, jobs_now_ms());
+        if (slot >= 0) {
+            jobs_item_t item = {
+                .id = table.jobs[slot].id,
+                .run = run,
+                .done = done,
+                .arg = arg,
+            };
+            /* the id is handed out before the job is queued, the worker may finish it right away */
+            if (id != NULL) {
+                *id = item.id;
+            }
+            if (xQueueSend(jobs_queue, &item, 0) == pdTRUE) {
+                jobs_notify(slot);
+                retval = ESP_OK;
+            } else {
+                /* cancelled jobs still wait in the queue, forget the new job */
+                table.jobs[slot].id = JOB_ID_NONE;
+            }
+        }
+        if ((retval != ESP_OK) && (id != NULL)) {
+            *id = JOB_ID_NONE;
+        }
+        (void)xSemaphoreGive(jobs_lock);
+        if (retval != ESP_OK) {
+            ESP_LOGW(TAG, "%s job refused, queue is full", job_kind_to_string(kind));
+        }
+    }
+
+    return retval;
+}
+
+esp_err_t jobs_get(uint32_t id, job_info_t *info) {
+    esp_err_t retval = ESP_ERR_NOT_FOUND;
+
+    if (jobs_lock != NULL) {
+        (void)xSemaphoreTake(jobs_lock, portMAX_DELAY);
+        int slot = job_table_find(&table, id);
+        if (slot >= 0) {
+            *info = table.jobs[slot];
+            retval = ESP_OK;
+        }
+        (void)xSemaphoreGive(jobs_lock);
+    }
+
+    return retval;
+}
+
+size_t jobs_list(job_info_t *infos, size_t max_infos) {
+    size_t retval = 0u;
+
+    if (jobs_lock != NULL) {
+        (void)xSemaphoreTake(jobs_lock, portMAX_DELAY);
+        retval = job_table_list(&table, infos, max_infos);
+        (void)xSemaphoreGive(jobs_lock);
+    }
+
+    return retval;
+}
+
+job_cancel_result_t jobs_cancel(uint32_t id) {
+    job_cancel_result_t retval = JOB_CANCEL_UNKNOWN;
+
+    if (jobs_lock != NULL) {
+        (void)xSemaphoreTake(jobs_lock, portMAX_DELAY);
+        retval = job_table_cancel(&table, id, jobs_now_ms());
+        if ((retval == JOB_CANCEL_DONE) || (retval == JOB_CANCEL_REQUESTED)) {
+            jobs_notify(job_table_find(&table, id));
+        }
+        (void)xSemaphoreGive(jobs_lock);
+    }
+
+    return retval;
+}
+
+bool jobs_cancel_requested(uint32_t id) {
+    bool retval = false;
+
+    if (jobs_lock != NULL) {
+        (void)xSemaphoreTake(jobs_lock, portMAX_DELAY);
+        int slot = job_table_find(&table, id);
+        retval = (slot < 0) || (table.jobs[slot].cancel_requested != 0u);
+        (void)xSemaphoreGive(jobs_lock);
+    }
+
+    return retval;
+}
+
+esp_err_t jobs_add_listener(jobs_listener_t listener, void *ctx) {
+    esp_err_t retval = ESP_ERR_NO_MEM;
+
+    if (jobs_lock == NULL) {
+        retval = ESP_ERR_INVALID_STATE;
+    } else {
+        (void)xSemaphoreTake(jobs_lock, portMAX_DELAY);
+        for (size_t i = 0; i < JOBS_MAX_LISTENERS; i++) {
+            if (listeners[i].listener == NULL) {
+                listeners[i].listener = listener;
+                listeners[i].ctx = ctx;
+                retval = ESP_OK;
+                break;
+            }
+        }
+        (void)xSemaphoreGive(jobs_lock);
+    }
+
+    return retval;
+}
+
+void jobs_remove_listener(jobs_listener_t listener, void *ctx) {
+    if (jobs_lock != NULL) {
+        (void)xSemaphoreTake(jobs_lock, portMAX_DELAY);
+        for (size_t i = 0; i < JOBS_MAX_LISTENERS; i++) {
+            if ((listeners[i].listener == listener) && (listeners[i].ctx == ctx)) {
+                listeners[i].listener = NULL;
+                listeners[i].ctx = NULL;
+            }
+        }
+        (void)xSemaphoreGive(jobs_lock);
+    }
+}
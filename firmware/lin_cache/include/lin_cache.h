@@ -0,0 +1,79 @@
+/**
+ * @file
+ * @brief LIN last-value cache definitions.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the definitions of the last-value cache of slave responses.
+ *
+ * All slave response (S2M) transactions of the front ends and of the schedule executor go through
+ * lincache_send_s2m, which records the outcome per frame identifier. Clients can read the cached
+ * responses without using the bus, or request a response with a maximum age such that the bus is
+ * only used when the cached response is too old.
+ *
+ * The cache is protected by a spinlock, updates only copy a few bytes such that the schedule task
+ * is not delayed.
+ */
+
+#ifndef LIN_CACHE_H_
+    #define LIN_CACHE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "lin_err.h"
+
+#include "lin_cache_table.h"
+
+/** initialize the LIN last-value cache */
+void lincache_init(void);
+
+/** Handle a slave response frame on the bus and record the outcome in the cache
+ *
+ * The caller has to own the bus, see linmaster_send_s2m.
+ *
+ * @param[in]  baudrate  baudrate to use.
+ * @param[in]  enhanced_crc  true: use enhanced checksum.
+ * @param[in]  frameid  frame identifier.
+ * @param[out]  data  received data.
+ * @param[in]  datalength  number of data bytes to receive.
+ * @returns  lin error code of the transaction.
+ */
+lin_err_t lincache_send_s2m(uint16_t baudrate, bool enhanced_crc, uint8_t frameid, uint8_t *data, uint8_t datalength);
+
+/** Get the cached entry of a frame identifier
+ *
+ * @param[in]  frameid  frame identifier (0..63).
+ * @param[out]  entry  cached entry.
+ * @retval  true  entry holds the cached state of the frame.
+ * @retval  false  frame identifier is invalid or no transaction was recorded for it.
+ */
+bool lincache_get(uint8_t frameid, lincache_entry_t *entry);
+
+/** Get the cached response of a frame identifier when it is recent enough
+ *
+ * @param[in]  frameid  frame identifier (0..63).
+ * @param[in]  datalength  expected number of data bytes.
+ * @param[in]  max_age_ms  maximum age of the response (ms).
+ * @param[out]  entry  cached entry.
+ * @retval  true  entry holds a response received without error within max_age_ms.
+ * @retval  false  a new transaction on the bus is needed.
+ */
+bool lincache_get_fresh(uint8_t frameid, uint8_t datalength, uint32_t max_age_ms, lincache_entry_t *entry);
+
+/** Clear all cached responses */
+void lincache_clear(void);
+
+#endif /* LIN_CACHE_H_ */
@@ -0,0 +1,116 @@
+/**
+ * @file
+ * @brief LIN last-value cache table definitions.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the definitions of the table which holds the last slave response per
+ * frame identifier. This part has no dependencies on the ESP-IDF such that it can be built and
+ * tested on the host, the caller provides the time and the locking.
+ */
+
+#ifndef LIN_CACHE_TABLE_H_
+    #define LIN_CACHE_TABLE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** number of frame identifiers */
+#define LINCACHE_NR_OF_FRAMES 64u
+
+/** maximum number of data bytes in a LIN frame */
+#define LINCACHE_MAX_DATA_LEN 8u
+
+/** cached slave response of one frame identifier */
+typedef struct lincache_entry_s {
+    uint32_t age_ms;                            /**< time since the last transaction (ms) */
+    uint32_t count;                             /**< number of responses received */
+    uint32_t errors;                            /**< number of transactions which failed */
+    int16_t status;                             /**< lin error code of the last transaction */
+    uint8_t frameid;                            /**< frame identifier */
+    uint8_t datalength;                         /**< number of valid bytes in data (0: nothing received yet) */
+    uint8_t data[LINCACHE_MAX_DATA_LEN];        /**< last response which was received without error */
+} lincache_entry_t;
+
+/** cache slot of one frame identifier */
+typedef struct lincache_slot_s {
+    uint64_t timestamp_us;                      /**< time of the last transaction (us) */
+    uint32_t count;                             /**< number of responses received */
+    uint32_t errors;                            /**< number of transactions which failed */
+    int16_t status;                             /**< lin error code of the last transaction */
+    uint8_t datalength;                         /**< number of valid bytes in data */
+    uint8_t data[LINCACHE_MAX_DATA_LEN];        /**< last response which was received without error */
+} lincache_slot_t;
+
+/** last-value cache of all frame identifiers */
+typedef struct lincache_table_s {
+    lincache_slot_t slots[LINCACHE_NR_OF_FRAMES];
+} lincache_table_t;
+
+/** Clear all entries of the cache
+ *
+ * @param[out]  table  cache to clear.
+ */
+void lincache_table_clear(lincache_table_t *table);
+
+/** Record the result of a slave response transaction
+ *
+ * The data is only replaced when the transaction succeeded, the status, the time and the counters
+ * are updated for every transaction.
+ *
+ * @param[in|out]  table  cache to update.
+ * @param[in]  frameid  frame identifier (0..63).
+ * @param[in]  status  lin error code of the transaction (0: success).
+ * @param[in]  data  received data.
+ * @param[in]  datalength  number of received data bytes (1..8).
+ * @param[in]  now_us  current time (us).
+ */
+void lincache_table_update(lincache_table_t *table,
+                           uint8_t frameid,
+                           int16_t status,
+                           const uint8_t *data,
+                           uint8_t datalength,
+                           uint64_t now_us);
+
+/** Get the cached entry of a frame identifier
+ *
+ * @param[in]  table  cache to read from.
+ * @param[in]  frameid  frame identifier (0..63).
+ * @param[in]  now_us  current time (us), used to calculate the age.
+ * @param[out]  entry  cached entry.
+ * @retval  true  entry holds the cached state of the frame.
+ * @retval  false  frame identifier is invalid or no transaction was recorded for it.
+ */
+bool lincache_table_get(const lincache_table_t *table, uint8_t frameid, uint64_t now_us, lincache_entry_t *entry);
+
+/** Get the cached response of a frame identifier when it is recent enough
+ *
+ * @param[in]  table  cache to read from.
+ * @param[in]  frameid  frame identifier (0..63).
+ * @param[in]  datalength  expected number of data bytes.
+ * @param[in]  max_age_ms  maximum age of the response (ms).
+ * @param[in]  now_us  current time (us), used to calculate the age.
+ * @param[out]  entry  cached entry.
+ * @retval  true  the last transaction succeeded with the expected length within max_age_ms.
+ * @retval  false  a new transaction on the bus is needed.
+ */
+bool lincache_table_fresh(const lincache_table_t *table,
+                          uint8_t frameid,
+                          uint8_t datalength,
+                          uint32_t max_age_ms,
+                          uint64_t now_us,
+                          lincache_entry_t *entry);
+
+#endif /* LIN_CACHE_TABLE_H_ */
@@ -0,0 +1,76 @@
+/**
+ * @file
+ * @brief LIN last-value cache.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the implementations of the last-value cache of slave responses.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_timer.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "lin_err.h"
+#include "lin_timing.h"
+
+#include "lin_cache.h"
+
+static lincache_table_t cache;
+static portMUX_TYPE cache_lock = portMUX_INITIALIZER_UNLOCKED;
+
+void lincache_init(void) {
+    lincache_clear();
+}
+
+lin_err_t lincache_send_s2m(uint16_t baudrate, bool enhanced_crc, uint8_t frameid, uint8_t *data, uint8_t datalength) {
+    lin_err_t error = lintiming_send_s2m(baudrate, enhanced_crc, frameid, data, datalength);
+    uint64_t now = (uint64_t)esp_timer_get_time();
+
+    taskENTER_CRITICAL(&cache_lock);
+    lincache_table_update(&cache, frameid, (int16_t)error, data, datalength, now);
+    taskEXIT_CRITICAL(&cache_lock);
+
+    return error;
+}
+
+bool lincache_get(uint8_t frameid, lincache_entry_t *entry) {
+    uint64_t now = (uint64_t)esp_timer_get_time();
+
+    taskENTER_CRITICAL(&cache_lock);
+    bool retval = lincache_table_get(&cache, frameid, now, entry);
+    taskEXIT_CRITICAL(&cache_lock);
+
+    return retval;
+}
+
+bool lincache_get_fresh(uint8_t frameid, uint8_t datalength, uint32_t max_age_ms, lincache_entry_t *entry) {
+    uint64_t now = (uint64_t)esp_timer_get_time();
+
+    taskENTER_CRITICAL(&cache_lock);
+    bool retval = lincache_table_fresh(&cache, frameid, datalength, max_age_ms, now, entry);
+    taskEXIT_CRITICAL(&cache_lock);
+
+    return retval;
+}
+
+void lincache_clear(void) {
+    taskENTER_CRITICAL(&cache_lock);
+    lincache_table_clear(&cache);
+    taskEXIT_CRITICAL(&cache_lock);
+}
@@ -0,0 +1,87 @@
+/**
+ * @file
+ * @brief LIN last-value cache table routines.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the implementations of the table which holds the last slave response
+ * per frame identifier.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lin_cache_table.h"
+
+void lincache_table_clear(lincache_table_t *table) {
+    memset(table, 0, sizeof(lincache_table_t));
+}
+
+void lincache_table_update(lincache_table_t *table,
+                           uint8_t frameid,
+                           int16_t status,
+                           const uint8_t *data,
+                           uint8_t datalength,
+                           uint64_t now_us) {
+    if (frameid < LINCACHE_NR_OF_FRAMES) {
+        lincache_slot_t *slot = &table->slots[frameid];
+
+        slot->timestamp_us = now_us;
+        slot->status = status;
+        if ((status == 0) && (datalength > 0u) && (datalength <= LINCACHE_MAX_DATA_LEN)) {
+            memcpy(slot->data, data, datalength);
+            slot->datalength = datalength;
+            slot->count++;
+        } else {
+            slot->errors++;
+        }
+    }
+}
+
+bool lincache_table_get(const lincache_table_t *table, uint8_t frameid, uint64_t now_us, lincache_entry_t *entry) {
+    bool retval = false;
+
+    if (frameid < LINCACHE_NR_OF_FRAMES) {
+        const lincache_slot_t *slot = &table->slots[frameid];
+
+        if ((slot->count + slot->errors) > 0u) {
+            uint64_t age_ms = (now_us > slot->timestamp_us) ? ((now_us - slot->timestamp_us) / 1000u) : 0u;
+
+            memset(entry, 0, sizeof(lincache_entry_t));
+            entry->age_ms = (age_ms > UINT32_MAX) ? UINT32_MAX : (uint32_t)age_ms;
+            entry->count = slot->count;
+            entry->errors = slot->errors;
+            entry->status = slot->status;
+            entry->frameid = frameid;
+            entry->datalength = slot->datalength;
+            memcpy(entry->data, slot->data, slot->datalength);
+            retval = true;
+        }
+    }
+
+    return retval;
+}
+
+bool lincache_table_fresh(const lincache_table_t *table,
+                          uint8_t frameid,
+                          uint8_t datalength,
+                          uint32_t max_age_ms,
+                          uint64_t now_us,
+                          lincache_entry_t *entry) {
+    return lincache_table_get(table, frameid, now_us, entry) &&
+           (entry->status == 0) &&
+           (entry->datalength == datalength) &&
+           (entry->age_ms <= max_age_ms);
+}
@@ -0,0 +1,124 @@
+/**
+ * @file
+ * @brief LIN bus monitor definitions.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the definitions of the passive LIN bus monitor.
+ *
+ * The monitor only listens on the bus: every header and response is captured with a time stamp,
+ * its checksum status and error flags (linmon_record_t). The records are stored in a ring buffer in
+ * PSRAM by a capture task, a separate streaming task hands them over in batches to the registered
+ * listeners (USB bulk, websocket). Records remain in the ring buffer until a listener accepted them,
+ * as such a slow or absent consumer does not lose records until the ring buffer is full.
+ *
+ * The monitor uses the receiver of the LIN interface, the caller has to claim the bus in monitor
+ * mode before starting the monitor and has to stop the monitor before releasing the bus.
+ */
+
+#ifndef LIN_MONITOR_H_
+    #define LIN_MONITOR_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+#include "lin_monitor_record.h"
+
+/** monitor status */
+typedef struct linmon_status_s {
+    uint8_t running;                            /**< 1: the monitor is capturing */
+    uint8_t reserved;
+    uint16_t baudrate;                          /**< baudrate of the capture */
+    uint32_t records;                           /**< number of records captured since the start */
+    uint32_t records_lost;                      /**< number of records lost since the ring buffer was full */
+    uint32_t rx_overflows;                      /**< number of receiver overflows */
+    uint32_t ring_used;                         /**< number of records waiting in the ring buffer */
+    uint32_t ring_size;                         /**< number of records the ring buffer can hold */
+} linmon_status_t;
+
+/** Record listener
+ *
+ * Called from the streaming task, a listener shall not block for long.
+ *
+ * @param[in]  records  captured records, in order of capture.
+ * @param[in]  nr_of_records  number of records.
+ * @param[in]  ctx  context pointer as passed during registration.
+ * @retval  true  records are accepted.
+ * @retval  false  records could not be accepted, they are offered again later unless another
+ *                 listener accepted them.
+ */
+typedef bool (* linmon_listener_t)(const linmon_record_t *records, size_t nr_of_records, void *ctx);
+
+/** initialize the LIN bus monitor module */
+void linmon_init(void);
+
+/** Start capturing
+ *
+ * Records of a previous capture which were not streamed yet are discarded.
+ *
+ * @param[in]  baudrate  baudrate of the bus.
+ * @retval  ESP_OK  monitor is started.
+ * @retval  ESP_ERR_INVALID_ARG  baudrate is invalid.
+ * @retval  ESP_ERR_INVALID_STATE  monitor is already running.
+ * @retval  ESP_ERR_NO_MEM  no ring buffer is available.
+ * @retval  ESP_ERR_TIMEOUT  capture task did not respond.
+ * @retval  others  receiver could not be set up.
+ */
+esp_err_t linmon_start(uint16_t baudrate);
+
+/** Stop capturing
+ *
+ * Returns after the receiver is released, records which were not streamed yet remain available.
+ *
+ * @retval  ESP_OK  monitor is stopped (or was not running).
+ * @retval  ESP_ERR_TIMEOUT  capture task did not respond.
+ */
+esp_err_t linmon_stop(void);
+
+/** Check whether the monitor is capturing
+ *
+ * @retval  true  monitor is running.
+ * @retval  false  monitor is not running.
+ */
+bool linmon_running(void);
+
+/** Get the status of the monitor
+ *
+ * @param[out]  status  status of the monitor.
+ */
+void linmon_get_status(linmon_status_t *status);
+
+/** Register a record listener
+ *
+ * A listener which is registered already with the same context stays registered once.
+ *
+ * @param[in]  listener  listener to register.
+ * @param[in]  ctx  context pointer to be passed to the listener.
+ * @retval  ESP_OK  listener is registered (or was registered already).
+ * @retval  ESP_ERR_NO_MEM  maximum number of listeners is reached.
+ */
+esp_err_t linmon_add_listener(linmon_listener_t listener, void *ctx);
+
+/** Unregister a record listener
+ *
+ * @param[in]  listener  listener to unregister.
+ * @param[in]  ctx  context pointer the listener was registered with.
+ */
+void linmon_remove_listener(linmon_listener_t listener, void *ctx);
+
+#endif /* LIN_MONITOR_H_ */
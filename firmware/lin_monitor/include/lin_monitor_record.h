@@ -0,0 +1,188 @@
+/**
+ * @file
+ * @brief LIN bus monitor record definitions.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the definitions of the bus monitor record format, of the parser which
+ * assembles the records from the received bytes and of the record ring buffer.
+ *
+ * A frame is delimited by break fields. The bytes following the sync byte and the protected
+ * identifier are the response, the last byte of a response is taken as its checksum since a passive
+ * monitor does not know the frame lengths. Both the classic and the enhanced checksum are checked.
+ * The receiver reports a break field as a zero byte, such a byte at the end of a response is only
+ * kept when it completes a valid response.
+ *
+ * This part has no dependencies on the ESP-IDF such that it can be built and tested on the host.
+ */
+
+#ifndef LIN_MONITOR_RECORD_H_
+    #define LIN_MONITOR_RECORD_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** maximum number of data bytes in a frame */
+#define LINMON_MAX_DATA_LEN 8u
+
+/** protected identifier parity is wrong */
+#define LINMON_FLAG_PARITY_ERROR 0x01u
+
+/** checksum matches the classic checksum */
+#define LINMON_FLAG_CHECKSUM_CLASSIC 0x02u
+
+/** checksum matches the enhanced checksum */
+#define LINMON_FLAG_CHECKSUM_ENHANCED 0x04u
+
+/** header was not followed by a response */
+#define LINMON_FLAG_NO_RESPONSE 0x08u
+
+/** sync byte was not 0x55, or the header is incomplete */
+#define LINMON_FLAG_SYNC_ERROR 0x10u
+
+/** framing error, or the response is too short or too long */
+#define LINMON_FLAG_FRAMING_ERROR 0x20u
+
+/** bytes were lost in the receiver */
+#define LINMON_FLAG_RX_OVERFLOW 0x40u
+
+/** records were lost before this record since the ring buffer was full */
+#define LINMON_FLAG_RECORDS_LOST 0x80u
+
+/** monitored frame (20 bytes) */
+typedef struct linmon_record_s {
+    uint32_t timestamp_us;                      /**< start of the break field since the monitor start (us) */
+    uint16_t sequence;                          /**< record number since the monitor start (wraps) */
+    uint8_t pid;                                /**< protected identifier as received */
+    uint8_t flags;                              /**< LINMON_FLAG_x flags */
+    uint8_t datalength;                         /**< number of valid bytes in data */
+    uint8_t checksum;                           /**< checksum as received */
+    uint8_t reserved[2];
+    uint8_t data[LINMON_MAX_DATA_LEN];          /**< response data */
+} linmon_record_t;
+
+/** frame assembly state */
+typedef struct linmon_parser_s {
+    linmon_record_t record;                     /**< record being assembled */
+    uint8_t state;                              /**< position in the frame */
+    uint8_t count;                              /**< number of response bytes received */
+    uint8_t bytes[LINMON_MAX_DATA_LEN + 1u];    /**< response bytes including the checksum */
+    uint16_t sequence;                          /**< sequence number of the next record */
+} linmon_parser_t;
+
+/** ring buffer of records, for one producer and one consumer */
+typedef struct linmon_ring_s {
+    linmon_record_t *records;                   /**< record storage */
+    uint32_t capacity;                          /**< number of records in the storage */
+    volatile uint32_t head;                     /**< number of records written */
+    volatile uint32_t tail;                     /**< number of records read */
+    uint32_t lost;                              /**< number of records which did not fit */
+    bool lost_pending;                          /**< mark the next stored record with LINMON_FLAG_RECORDS_LOST */
+} linmon_ring_t;
+
+/** Reset the frame assembly
+ *
+ * @param[out]  parser  parser to reset.
+ */
+void linmon_parser_init(linmon_parser_t *parser);
+
+/** Handle a break field
+ *
+ * @param[in|out]  parser  parser state.
+ * @param[in]  timestamp_us  start of the break field.
+ * @param[out]  record  previous frame, when it was still being assembled.
+ * @retval  true  record holds the completed previous frame.
+ * @retval  false  no frame was being assembled.
+ */
+bool linmon_parser_break(linmon_parser_t *parser, uint32_t timestamp_us, linmon_record_t *record);
+
+/** Handle a received byte
+ *
+ * @param[in|out]  parser  parser state.
+ * @param[in]  byte  received byte.
+ * @param[out]  record  completed frame.
+ * @retval  true  record holds a completed frame (maximum response length was reached).
+ * @retval  false  frame is not complete yet.
+ */
+bool linmon_parser_byte(linmon_parser_t *parser, uint8_t byte, linmon_record_t *record);
+
+/** Flag an error on the frame being assembled
+ *
+ * Errors before the sync byte are taken as part of the break field and are ignored.
+ *
+ * @param[in|out]  parser  parser state.
+ * @param[in]  flags  LINMON_FLAG_x flags to add.
+ */
+void linmon_parser_error(linmon_parser_t *parser, uint8_t flags);
+
+/** Handle an idle bus, completes the frame being assembled
+ *
+ * @param[in|out]  parser  parser state.
+ * @param[out]  record  completed frame.
+ * @retval  true  record holds the completed frame.
+ * @retval  false  no frame was being assembled.
+ */
+bool linmon_parser_idle(linmon_parser_t *parser, linmon_record_t *record);
+
+/** Calculate the parity bits of a frame identifier
+ *
+ * @param[in]  frameid  frame identifier (0..0x3F).
+ * @returns  protected identifier.
+ */
+uint8_t linmon_protected_id(uint8_t frameid);
+
+/** Initialize a record ring buffer
+ *
+ * @param[out]  ring  ring buffer to initialize.
+ * @param[in]  records  storage for the records.
+ * @param[in]  capacity  number of records in the storage, rounded down to a power of two.
+ */
+void linmon_ring_init(linmon_ring_t *ring, linmon_record_t *records, uint32_t capacity);
+
+/** Store a record, from the producer
+ *
+ * @param[in|out]  ring  ring buffer.
+ * @param[in]  record  record to store.
+ * @retval  true  record is stored.
+ * @retval  false  ring buffer is full, the record is lost.
+ */
+bool linmon_ring_push(linmon_ring_t *ring, const linmon_record_t *record);
+
+/** Get the number of stored records
+ *
+ * @param[in]  ring  ring buffer.
+ * @returns  number of records which can be read.
+ */
+uint32_t linmon_ring_used(const linmon_ring_t *ring);
+
+/** Copy the oldest records out of the ring buffer, from the consumer
+ *
+ * The records remain stored until they are consumed.
+ *
+ * @param[in]  ring  ring buffer.
+ * @param[out]  records  buffer for the records.
+ * @param[in]  max_records  maximum number of records to copy.
+ * @returns  number of records copied.
+ */
+uint32_t linmon_ring_peek(const linmon_ring_t *ring, linmon_record_t *records, uint32_t max_records);
+
+/** Remove the oldest records from the ring buffer, from the consumer
+ *
+ * @param[in|out]  ring  ring buffer.
+ * @param[in]  count  number of records to remove (at most the number returned by linmon_ring_peek).
+ */
+void linmon_ring_consume(linmon_ring_t *ring, uint32_t count);
+
+#endif /* LIN_MONITOR_RECORD_H_ */
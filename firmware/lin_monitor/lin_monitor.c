@@ -0,0 +1,436 @@
+/**
+ * @file
+ * @brief LIN bus monitor routines.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the implementations of the passive LIN bus monitor.
+ *
+ * The receiver is a UART with break detection. The capture task installs the UART driver itself,
+ * as such the UART interrupt runs on the same core as the capture task which keeps the latency
+ * between the break detection and its time stamp low. The time stamp of a break detection is
+ * corrected with the time the UART needs to detect the break.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "driver/uart.h"
+#include "esp_err.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+#include "sdkconfig.h"
+
+#include "lin_monitor.h"
+
+/** maximum number of record listeners */
+#define LINMON_MAX_LISTENERS 4u
+
+/** maximum number of records handed over to the listeners at once (fits a bulk message) */
+#define LINMON_REPORT_BATCH 200u
+
+/** number of bit times the UART needs to detect a break field */
+#define LINMON_BREAK_DETECT_BITS 10u
+
+/** idle time of the receiver (in symbols) before the received bytes are reported */
+#define LINMON_RX_TIMEOUT_SYMBOLS 2u
+
+/** size of the UART receive buffer */
+#define LINMON_UART_RX_BUFFER 1024u
+
+/** number of UART events which can be queued */
+#define LINMON_UART_QUEUE_LEN 64u
+
+/** maximum time to wait for the capture task to start or stop */
+#define LINMON_SYNC_TIMEOUT pdMS_TO_TICKS(1000)
+
+static const char *TAG = "lin-monitor";
+
+typedef struct linmon_listener_entry_s {
+    linmon_listener_t listener;                 /**< registered listener, or NULL */
+    void *ctx;                                  /**< context for the listener */
+} linmon_listener_entry_t;
+
+static linmon_ring_t ring;
+static linmon_record_t *ring_storage = NULL;
+static volatile bool running = false;
+static uint16_t capture_baudrate = 0u;
+static esp_err_t capture_error = ESP_OK;
+static linmon_status_t status;
+static portMUX_TYPE status_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static TaskHandle_t captureTaskHandle = NULL;
+static SemaphoreHandle_t capture_done = NULL;
+static SemaphoreHandle_t control_lock = NULL;
+static SemaphoreHandle_t stream_lock = NULL;
+
+static linmon_listener_entry_t listeners[LINMON_MAX_LISTENERS];
+static SemaphoreHandle_t listener_lock = NULL;
+
+/** Store a completed record in the ring buffer
+ *
+ * @param[in]  record  record to store.
+ */
+static void linmon_store(const linmon_record_t *record);
+
+/** Read the received bytes from the UART and assemble the frames
+ *
+ * @param[in]  parser  frame assembly state.
+ */
+static void linmon_read_bytes(linmon_parser_t *parser);
+
+/** Capture frames until the monitor is stopped
+ *
+ * @param[in]  uart_queue  UART event queue.
+ */
+static void linmon_capture(QueueHandle_t uart_queue);
+
+/** Capture task, installs the receiver at each start
+ *
+ * @param[in]  arg  task argument (not used).
+ */
+static void linmon_capture_task(void *arg);
+
+/** Streaming task, hands the records over to the listeners
+ *
+ * @param[in]  arg  task argument (not used).
+ */
+static void linmon_stream_task(void *arg);
+
+
+static void linmon_store(const linmon_record_t *record) {
+    bool stored = linmon_ring_push(&ring, record);
+    taskENTER_CRITICAL(&status_lock);
+    status.records++;
+    if (!stored) {
+        status.records_lost++;
+    }
+    taskEXIT_CRITICAL(&status_lock);
+}
+
+static void linmon_read_bytes(linmon_parser_t *parser) {
+    uint8_t buffer[64];
+    size_t available = 0u;
+    linmon_record_t record;
+
+    (void)uart_get_buffered_data_len(CONFIG_LIN_MONITOR_UART_NUM, &available);
+    while (available > 0u) {
+        size_t chunk = (available < sizeof(buffer)) ? available : sizeof(buffer);
+        int length = uart_read_bytes(CONFIG_LIN_MONITOR_UART_NUM, buffer, chunk, 0);
+        if (length <= 0) {
+            break;
+        }
+        for (int i = 0; i < length; i++) {
+            if (linmon_parser_byte(parser, buffer[i], &record)) {
+                linmon_store(&record);
+            }
+        }
+        available -= (size_t)length;
+    }
+}
+
+static void linmon_capture(QueueHandle_t uart_queue) {
+    static linmon_parser_t parser;
+    linmon_record_t record;
+    uart_event_t event;
+    int64_t start_time = esp_timer_get_time();
+    uint32_t break_detect_us = (LINMON_BREAK_DETECT_BITS * 1000000u) / capture_baudrate;
+    /* a response may follow its header after a while on slow busses, wait for 20 byte times */
+    uint32_t idle_ms = (200u * 1000u) / capture_baudrate;
+    TickType_t idle_ticks = pdMS_TO_TICKS((idle_ms > 10u) ? idle_ms : 10u) + 1u;
+
+    linmon_parser_init(&parser);
+
+    while (running) {
+        if (xQueueReceive(uart_queue, &event, idle_ticks) == pdTRUE) {
+            int64_t now = esp_timer_get_time();
+            switch (event.type) {
+                case UART_DATA:
+                    linmon_read_bytes(&parser);
+                    break;
+
+                case UART_BREAK:
+                    /* the bytes before the break belong to the previous frame */
+                    linmon_read_bytes(&parser);
+                    if (linmon_parser_break(&parser,
+                                            (uint32_t)(now - start_time) - break_detect_us,
+                                            &record)) {
+                        linmon_store(&record);
+                    }
+                    break;
+
+                case UART_FRAME_ERR:
+                case UART_PARITY_ERR:
+                    linmon_read_bytes(&parser);
+                    linmon_parser_error(&parser, LINMON_FLAG_FRAMING_ERROR);
+                    break;
+
+                case UART_FIFO_OVF:
+                case UART_BUFFER_FULL:
+                    (void)uart_flush_input(CONFIG_LIN_MONITOR_UART_NUM);
+                    (void)xQueueReset(uart_queue);
+                    linmon_parser_error(&parser, LINMON_FLAG_RX_OVERFLOW);
+                    taskENTER_CRITICAL(&status_lock);
+                    status.rx_overflows++;
+                    taskEXIT_CRITICAL(&status_lock);
+                    break;
+
+                default:
+                    break;
+            }
+        } else {
+            /* bus is idle, the last frame is complete */
+            linmon_read_bytes(&parser);
+            if (linmon_parser_idle(&parser, &record)) {
+                linmon_store(&record);
+            }
+        }
+    }
+
+    if (linmon_parser_idle(&parser, &record)) {
+        linmon_store(&record);
+    }
+}
+
+static void linmon_capture_task(void *arg) {
+    (void)arg;
+
+    while (1) {
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        QueueHandle_t uart_queue = NULL;
+        uart_config_t uart_config = {
+            .baud_rate = capture_baudrate,
+            .data_bits = UART_DATA_8_BITS,
+            .parity = UART_PARITY_DISABLE,
+            .stop_bits = UART_STOP_BITS_1,
+            .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
+            .source_clk = UART_SCLK_DEFAULT,
+        };
+        esp_err_t error = uart_driver_install(CONFIG_LIN_MONITOR_UART_NUM,
+                                              LINMON_UART_RX_BUFFER,
+                                              0,
+                                              LINMON_UART_QUEUE_LEN,
+                                              &uart_queue,
+                                              0);
+        if (error == ESP_OK) {
+            error = uart_param_config(CONFIG_LIN_MONITOR_UART_NUM, &uart_config);
+        }
+        if (error == ESP_OK) {
+            error = uart_set_pin(CONFIG_LIN_MONITOR_UART_NUM,
+                                 UART_PIN_NO_CHANGE,
+                                 CONFIG_LIN_MONITOR_RX_PIN,
+                                 UART_PIN_NO_CHANGE,
+                                 UART_PIN_NO_CHANGE);
+        }
+        if (error == ESP_OK) {
+            error = uart_set_rx_timeout(CONFIG_LIN_MONITOR_UART_NUM, LINMON_RX_TIMEOUT_SYMBOLS);
+        }
+
+        if (error == ESP_OK) {
+            ESP_LOGI(TAG, "capturing at %u baud", capture_baudrate);
+            (void)xSemaphoreGive(capture_done);
+            linmon_capture(uart_queue);
+        } else {
+            ESP_LOGE(TAG, "receiver setup failed: %s", esp_err_to_name(error));
+            capture_error = error;
+            running = false;
+        }
+
+        if (uart_is_driver_installed(CONFIG_LIN_MONITOR_UART_NUM)) {
+            (void)uart_driver_delete(CONFIG_LIN_MONITOR_UART_NUM);
+        }
+        (void)xSemaphoreGive(capture_done);
+    }
+}
+
+static void linmon_stream_task(void *arg) {
+    (void)arg;
+    static linmon_record_t records[LINMON_REPORT_BATCH];
+
+    while (1) {
+        vTaskDelay(pdMS_TO_TICKS(CONFIG_LIN_MONITOR_REPORT_INTERVAL));
+
+        bool accepted = true;
+        (void)xSemaphoreTake(stream_lock, portMAX_DELAY);
+        while (accepted && (linmon_ring_used(&ring) > 0u)) {
+            uint32_t nr_of_records = linmon_ring_peek(&ring, records, LINMON_REPORT_BATCH);
+
+            accepted = false;
+            (void)xSemaphoreTake(listener_lock, portMAX_DELAY);
+            for (size_t i = 0; i < LINMON_MAX_LISTENERS; i++) {
+                if ((listeners[i].listener != NULL) &&
+                    listeners[i].listener(records, nr_of_records, listeners[i].ctx)) {
+                    accepted = true;
+                }
+            }
+            (void)xSemaphoreGive(listener_lock);
+
+            if (accepted) {
+                linmon_ring_consume(&ring, nr_of_records);
+            }
+        }
+        (void)xSemaphoreGive(stream_lock);
+    }
+}
+
+void linmon_init(void) {
+    memset(listeners, 0, sizeof(listeners));
+    memset(&status, 0, sizeof(status));
+
+    ring_storage = heap_caps_malloc(CONFIG_LIN_MONITOR_RING_RECORDS * sizeof(linmon_record_t), MALLOC_CAP_SPIRAM);
+    if (ring_storage == NULL) {
+        ESP_LOGE(TAG, "no memory for the ring buffer");
+    }
+    linmon_ring_init(&ring, ring_storage, (ring_storage != NULL) ? CONFIG_LIN_MONITOR_RING_RECORDS : 0u);
+
+    capture_done = xSemaphoreCreateBinary();
+    control_lock = xSemaphoreCreateMutex();
+    stream_lock = xSemaphoreCreateMutex();
+    listener_lock = xSemaphoreCreateMutex();
+
+    xTaskCreatePinnedToCore(linmon_capture_task,
+                            "lin_monitor_task",
+                            2048 * 2,
+                            NULL,
+                            CONFIG_LIN_MONITOR_TASK_PRIORITY,
+                            &captureTaskHandle,
+                            CONFIG_LIN_MONITOR_TASK_CORE);
+    xTaskCreate(linmon_stream_task, "lin_stream_task", 2048 * 2, NULL, 5, NULL);
+}
+
+esp_err_t linmon_start(uint16_t baudrate) {
+    esp_err_t retval = ESP_ERR_TIMEOUT;
+
+    if (xSemaphoreTake(control_lock, LINMON_SYNC_TIMEOUT) == pdTRUE) {
+        retval = ESP_OK;
+        if ((baudrate < 1000u) || (baudrate > 20000u)) {
+            retval = ESP_ERR_INVALID_ARG;
+        } else if (running) {
+            retval = ESP_ERR_INVALID_STATE;
+        } else if (ring_storage == NULL) {
+            retval = ESP_ERR_NO_MEM;
+        }
+
+        if (retval == ESP_OK) {
+            /* discard the records of the previous capture */
+            (void)xSemaphoreTake(stream_lock, portMAX_DELAY);
+            linmon_ring_init(&ring, ring_storage, CONFIG_LIN_MONITOR_RING_RECORDS);
+            (void)xSemaphoreGive(stream_lock);
+
+            taskENTER_CRITICAL(&status_lock);
+            memset(&status, 0, sizeof(status));
+            status.running = 1u;
+            status.baudrate = baudrate;
+            taskEXIT_CRITICAL(&status_lock);
+
+            capture_baudrate = baudrate;
+            running = true;
+            capture_error = ESP_OK;
+            xTaskNotifyGive(captureTaskHandle);
+            if (xSemaphoreTake(capture_done, LINMON_SYNC_TIMEOUT) != pdTRUE) {
+                running = false;
+                retval = ESP_ERR_TIMEOUT;
+            } else if (!running) {
+                retval = capture_error;
+            }
+        }
+
+        if (retval != ESP_OK) {
+            taskENTER_CRITICAL(&status_lock);
+            status.running = running ? 1u : 0u;
+            taskEXIT_CRITICAL(&status_lock);
+        }
+        (void)xSemaphoreGive(control_lock);
+    }
+
+    return retval;
+}
+
+esp_err_t linmon_stop(void) {
+    esp_err_t retval = ESP_ERR_TIMEOUT;
+
+    if (xSemaphoreTake(control_lock, LINMON_SYNC_TIMEOUT) == pdTRUE) {
+        retval = ESP_OK;
+        if (running) {
+            running = false;
+            /* the capture task notices the stop within its idle time */
+            if (xSemaphoreTake(capture_done, LINMON_SYNC_TIMEOUT) != pdTRUE) {
+                retval = ESP_ERR_TIMEOUT;
+            }
+            taskENTER_CRITICAL(&status_lock);
+            status.running = 0u;
+            taskEXIT_CRITICAL(&status_lock);
+            ESP_LOGI(TAG, "stopped");
+        }
+        (void)xSemaphoreGive(control_lock);
+    }
+
+    return retval;
+}
+
+bool linmon_running(void) {
+    return running;
+}
+
+void linmon_get_status(linmon_status_t *stat) {
+    taskENTER_CRITICAL(&status_lock);
+    *stat = status;
+    taskEXIT_CRITICAL(&status_lock);
+    stat->ring_used = linmon_ring_used(&ring);
+    stat->ring_size = ring.capacity;
+}
+
+esp_err_t linmon_add_listener(linmon_listener_t listener, void *ctx) {
+    esp_err_t retval = ESP_ERR_NO_MEM;
+
+    (void)xSemaphoreTake(listener_lock, portMAX_DELAY);
+    size_t free_slot = LINMON_MAX_LISTENERS;
+    for (size_t i = 0; i < LINMON_MAX_LISTENERS; i++) {
+        if ((listeners[i].listener == listener) && (listeners[i].ctx == ctx)) {
+            /* registered already, e.g. by a previous enable of the interface */
+            retval = ESP_OK;
+        } else if ((listeners[i].listener == NULL) && (free_slot == LINMON_MAX_LISTENERS)) {
+            free_slot = i;
+        }
+    }
+    if ((retval != ESP_OK) && (free_slot < LINMON_MAX_LISTENERS)) {
+        listeners[free_slot].listener = listener;
+        listeners[free_slot].ctx = ctx;
+        retval = ESP_OK;
+    }
+    (void)xSemaphoreGive(listener_lock);
+
+    return retval;
+}
+
+void linmon_remove_listener(linmon_listener_t listener, void *ctx) {
+    (void)xSemaphoreTake(listener_lock, portMAX_DELAY);
+    for (size_t i = 0; i < LINMON_MAX_LISTENERS; i++) {
+        if ((listeners[i].listener == listener) && (listeners[i].ctx == ctx)) {
+            listeners[i].listener = NULL;
+            listeners[i].ctx = NULL;
+        }
+    }
+    (void)xSemaphoreGive(listener_lock);
+}
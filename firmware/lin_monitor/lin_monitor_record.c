@@ -0,0 +1,267 @@
+/**
+ * @file
+ * @brief LIN bus monitor record routines.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the implementations of the bus monitor frame assembly and of the
+ * record ring buffer.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lin_monitor_record.h"
+
+/** sync byte of a header */
+#define LIN_SYNC_BYTE 0x55u
+
+typedef enum linmon_parser_state_e {
+    PARSER_IDLE = 0,                            /**< waiting for a break field */
+    PARSER_SYNC,                                /**< waiting for the sync byte */
+    PARSER_PID,                                 /**< waiting for the protected identifier */
+    PARSER_RESPONSE,                            /**< receiving the response */
+} linmon_parser_state_t;
+
+/** Complete the frame being assembled
+ *
+ * @param[in|out]  parser  parser state.
+ * @param[out]  record  completed frame.
+ */
+static void linmon_parser_complete(linmon_parser_t *parser, linmon_record_t *record);
+
+/** Calculate a LIN checksum
+ *
+ * @param[in]  seed  initial value (0 for the classic, protected identifier for the enhanced checksum).
+ * @param[in]  data  data bytes.
+ * @param[in]  length  number of data bytes.
+ * @returns  checksum.
+ */
+static uint8_t linmon_checksum(uint8_t seed, const uint8_t *data, uint8_t length);
+
+/** Check whether the first bytes of the received response form a response with a valid checksum
+ *
+ * @param[in]  parser  parser state.
+ * @param[in]  count  number of response bytes to check, including the checksum.
+ * @retval  true  checksum of the response is valid (classic or enhanced).
+ * @retval  false  response is too short or the checksum is invalid.
+ */
+static bool linmon_response_valid(const linmon_parser_t *parser, uint8_t count);
+
+
+static uint8_t linmon_checksum(uint8_t seed, const uint8_t *data, uint8_t length) {
+    uint16_t sum = seed;
+    for (uint8_t i = 0u; i < length; i++) {
+        sum += data[i];
+        if (sum > 0xFFu) {
+            sum -= 0xFFu;
+        }
+    }
+    return (uint8_t)(~sum & 0xFFu);
+}
+
+static bool linmon_response_valid(const linmon_parser_t *parser, uint8_t count) {
+    bool retval = false;
+    if (count >= 2u) {
+        uint8_t checksum = parser->bytes[count - 1u];
+        retval = (linmon_checksum(0u, parser->bytes, count - 1u) == checksum) ||
+                 (linmon_checksum(parser->record.pid, parser->bytes, count - 1u) == checksum);
+    }
+    return retval;
+}
+
+static void linmon_parser_complete(linmon_parser_t *parser, linmon_record_t *record) {
+    linmon_record_t *current = &parser->record;
+
+    if (parser->state != PARSER_RESPONSE) {
+        /* break without a complete header */
+        current->flags |= LINMON_FLAG_SYNC_ERROR;
+    } else if (parser->count == 0u) {
+        current->flags |= LINMON_FLAG_NO_RESPONSE;
+    } else if (parser->count == 1u) {
+        current->flags |= LINMON_FLAG_FRAMING_ERROR;
+        current->checksum = parser->bytes[0];
+    } else {
+        current->datalength = parser->count - 1u;
+        current->checksum = parser->bytes[current->datalength];
+        memcpy(current->data, parser->bytes, current->datalength);
+        if (linmon_checksum(0u, current->data, current->datalength) == current->checksum) {
+            current->flags |= LINMON_FLAG_CHECKSUM_CLASSIC;
+        }
+        if (linmon_checksum(current->pid, current->data, current->datalength) == current->checksum) {
+            current->flags |= LINMON_FLAG_CHECKSUM_ENHANCED;
+        }
+    }
+
+    current->sequence = parser->sequence++;
+    *record = *current;
+    parser->state = PARSER_IDLE;
+}
+
+uint8_t linmon_protected_id(uint8_t frameid) {
+    uint8_t id = frameid & 0x3Fu;
+    uint8_t p0 = ((id >> 0) ^ (id >> 1) ^ (id >> 2) ^ (id >> 4)) & 0x01u;
+    uint8_t p1 = ~((id >> 1) ^ (id >> 3) ^ (id >> 4) ^ (id >> 5)) & 0x01u;
+    return (uint8_t)(id | (p0 << 6) | (p1 << 7));
+}
+
+void linmon_parser_init(linmon_parser_t *parser) {
+    memset(parser, 0, sizeof(linmon_parser_t));
+    parser->state = PARSER_IDLE;
+}
+
+bool linmon_parser_break(linmon_parser_t *parser, uint32_t timestamp_us, linmon_record_t *record) {
+    bool retval = false;
+
+    if ((parser->state == PARSER_RESPONSE) &&
+        (parser->count > 0u) &&
+        (parser->bytes[parser->count - 1u] == 0x00u)) {
+        /* the break field is received as a zero byte, which may be read before the break is
+         * signaled; keep it only when it completes a valid response which is not valid without it */
+        if (!linmon_response_valid(parser, parser->count) || linmon_response_valid(parser, parser->count - 1u)) {
+            parser->count--;
+        }
+    }
+
+    if (parser->state != PARSER_IDLE) {
+        linmon_parser_complete(parser, record);
+        retval = true;
+    }
+
+    memset(&parser->record, 0, sizeof(linmon_record_t));
+    parser->record.timestamp_us = timestamp_us;
+    parser->count = 0u;
+    parser->state = PARSER_SYNC;
+
+    return retval;
+}
+
+bool linmon_parser_byte(linmon_parser_t *parser, uint8_t byte, linmon_record_t *record) {
+    bool retval = false;
+
+    switch ((linmon_parser_state_t)parser->state) {
+        case PARSER_SYNC:
+            if (byte == LIN_SYNC_BYTE) {
+                parser->state = PARSER_PID;
+            } else if (byte != 0x00u) {
+                /* a zero byte is the break field itself, anything else is a bad sync */
+                parser->record.flags |= LINMON_FLAG_SYNC_ERROR;
+                parser->state = PARSER_PID;
+            }
+            break;
+
+        case PARSER_PID:
+            parser->record.pid = byte;
+            if (linmon_protected_id(byte) != byte) {
+                parser->record.flags |= LINMON_FLAG_PARITY_ERROR;
+            }
+            parser->state = PARSER_RESPONSE;
+            break;
+
+        case PARSER_RESPONSE:
+            parser->bytes[parser->count++] = byte;
+            if (parser->count >= sizeof(parser->bytes)) {
+                linmon_parser_complete(parser, record);
+                retval = true;
+            }
+            break;
+
+        case PARSER_IDLE:
+        default:
+            /* not part of a frame */
+            break;
+    }
+
+    return retval;
+}
+
+void linmon_parser_error(linmon_parser_t *parser, uint8_t flags) {
+    /* the break field itself is received as a zero byte with a framing error */
+    if ((parser->state == PARSER_PID) || (parser->state == PARSER_RESPONSE)) {
+        parser->record.flags |= flags;
+    }
+}
+
+bool linmon_parser_idle(linmon_parser_t *parser, linmon_record_t *record) {
+    bool retval = false;
+
+    if (parser->state != PARSER_IDLE) {
+        linmon_parser_complete(parser, record);
+        retval = true;
+    }
+
+    return retval;
+}
+
+void linmon_ring_init(linmon_ring_t *ring, linmon_record_t *records, uint32_t capacity) {
+    /* a power of two keeps the positions consistent when the counters wrap */
+    while ((capacity & (capacity - 1u)) != 0u) {
+        capacity &= capacity - 1u;
+    }
+    ring->records = records;
+    ring->capacity = capacity;
+    ring->head = 0u;
+    ring->tail = 0u;
+    ring->lost = 0u;
+    ring->lost_pending = false;
+}
+
+bool linmon_ring_push(linmon_ring_t *ring, const linmon_record_t *record) {
+    bool retval = false;
+    uint32_t head = ring->head;
+
+    if ((head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE)) < ring->capacity) {
+        linmon_record_t *slot = &ring->records[head % ring->capacity];
+        *slot = *record;
+        if (ring->lost_pending) {
+            slot->flags |= LINMON_FLAG_RECORDS_LOST;
+            ring->lost_pending = false;
+        }
+        __atomic_store_n(&ring->head, head + 1u, __ATOMIC_RELEASE);
+        retval = true;
+    } else {
+        ring->lost++;
+        ring->lost_pending = true;
+    }
+
+    return retval;
+}
+
+uint32_t linmon_ring_used(const linmon_ring_t *ring) {
+    return __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+}
+
+uint32_t linmon_ring_peek(const linmon_ring_t *ring, linmon_record_t *records, uint32_t max_records) {
+    uint32_t tail = ring->tail;
+    uint32_t count = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) - tail;
+
+    if (count > max_records) {
+        count = max_records;
+    }
+
+    uint32_t offset = tail % ring->capacity;
+    uint32_t first = ring->capacity - offset;
+    if (first > count) {
+        first = count;
+    }
+    memcpy(records, &ring->records[offset], first * sizeof(linmon_record_t));
+    memcpy(&records[first], ring->records, (count - first) * sizeof(linmon_record_t));
+
+    return count;
+}
+
+void linmon_ring_consume(linmon_ring_t *ring, uint32_t count) {
+    __atomic_store_n(&ring->tail, ring->tail + count, __ATOMIC_RELEASE);
+}
@@ -0,0 +1,193 @@
+/**
+ * @file
+ * @brief LIN schedule table executor definitions.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the definitions of the LIN schedule table executor.
+ *
+ * Schedule tables are uploaded once and executed on the device by a high priority task. The frame
+ * slots are timed with a hardware timer, as such the slot timing does not depend on the host or on
+ * the connection with it. The results of the frames are collected in a queue and handed over in
+ * batches to the registered listeners (USB bulk, websocket) by a separate reporting task.
+ *
+ * A collision on an event triggered frame is resolved within its slot by handling all associated
+ * unconditional frames, the slot then reports one result per unconditional frame.
+ *
+ * The executor uses the LIN master, the caller has to claim the bus before starting a schedule and
+ * has to stop the schedule before releasing the bus.
+ */
+
+#ifndef LIN_SCHEDULE_H_
+    #define LIN_SCHEDULE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+#include "lin_schedule_event.h"
+#include "lin_schedule_table.h"
+
+/** result of one executed frame slot */
+typedef struct linsched_result_s {
+    uint32_t timestamp_us;                      /**< start of the slot relative to the schedule start (us) */
+    uint32_t sequence;                          /**< slot number since the schedule start */
+    int16_t status;                             /**< lin error code of the frame */
+    uint16_t late_us;                           /**< delay of the slot start versus its nominal start (us) */
+    uint8_t table;                              /**< table the entry belongs to */
+    uint8_t entry;                              /**< index of the entry in the table */
+    uint8_t type;                               /**< entry type (linsched_frame_type_t) */
+    uint8_t frameid;                            /**< frame identifier */
+    uint8_t datalength;                         /**< number of valid bytes in data */
+    uint8_t event;                              /**< outcome of an event triggered frame (linsched_event_outcome_t) */
+    uint8_t reserved[2];
+    uint8_t data[LINSCHED_MAX_DATA_LEN];        /**< data sent (M2S) or received (S2M) */
+} linsched_result_t;
+
+/** schedule executor status */
+typedef struct linsched_status_s {
+    uint8_t running;                            /**< 1: a schedule is being executed */
+    uint8_t table;                              /**< table being executed */
+    uint8_t pending;                            /**< table to switch to, or LINSCHED_NO_TABLE */
+    uint8_t reserved;
+    uint32_t slots;                             /**< number of slots executed since the start */
+    uint32_t errors;                            /**< number of frames which failed since the start */
+    uint32_t overruns;                          /**< number of slots which started after their nominal end */
+    uint32_t max_late_us;                       /**< maximum delay of a slot start versus its nominal start */
+    uint32_t results_dropped;                   /**< number of results which could not be reported */
+} linsched_status_t;
+
+/** Schedule result listener
+ *
+ * Called from the reporting task, a listener shall not block for long.
+ *
+ * @param[in]  results  results of the executed slots, in order of execution.
+ * @param[in]  nr_of_results  number of results.
+ * @param[in]  ctx  context pointer as passed during registration.
+ */
+typedef void (* linsched_listener_t)(const linsched_result_t *results, size_t nr_of_results, void *ctx);
+
+/** initialize the LIN schedule module */
+void linsched_init(void);
+
+/** Upload a schedule table
+ *
+ * @param[in]  table  index of the table to upload (0..CONFIG_LIN_SCHEDULE_MAX_TABLES-1).
+ * @param[in]  baudrate  baudrate to be used for all frames in the table.
+ * @param[in]  entries  entries of the table.
+ * @param[in]  nr_of_entries  number of entries (0 to clear the table).
+ * @retval  ESP_OK  table is stored.
+ * @retval  ESP_ERR_INVALID_ARG  table index or one of the entries is invalid.
+ * @retval  ESP_ERR_INVALID_STATE  table is being executed or is about to be executed.
+ * @retval  ESP_ERR_NO_MEM  not enough memory to store the table.
+ */
+esp_err_t linsched_upload(uint8_t table, uint16_t baudrate, const linsched_entry_t *entries, uint8_t nr_of_entries);
+
+/** Start the execution of a schedule table
+ *
+ * @param[in]  table  index of the table to execute.
+ * @retval  ESP_OK  schedule is started.
+ * @retval  ESP_ERR_INVALID_ARG  table index is invalid.
+ * @retval  ESP_ERR_NOT_FOUND  table is empty.
+ * @retval  ESP_ERR_INVALID_STATE  a schedule is already running.
+ */
+esp_err_t linsched_start(uint8_t table);
+
+/** Switch the running schedule to another table
+ *
+ * The slot which is running completes, the new table starts with its first entry in the next slot.
+ *
+ * @param[in]  table  index of the table to switch to.
+ * @retval  ESP_OK  switch is scheduled.
+ * @retval  ESP_ERR_INVALID_ARG  table index is invalid.
+ * @retval  ESP_ERR_NOT_FOUND  table is empty.
+ * @retval  ESP_ERR_INVALID_STATE  no schedule is running.
+ */
+esp_err_t linsched_switch(uint8_t table);
+
+/** Stop the execution of the schedule
+ *
+ * Returns after the slot which is running has completed, the LIN master is not used afterwards.
+ *
+ * @retval  ESP_OK  schedule is stopped (or was not running).
+ * @retval  ESP_ERR_TIMEOUT  running slot did not complete in time.
+ */
+esp_err_t linsched_stop(void);
+
+/** Update the data of a sporadic frame
+ *
+ * The frame is sent in the next slot of a sporadic entry it is associated with, unless a frame with
+ * a higher priority in that entry is pending as well.
+ *
+ * @param[in]  frameid  frame identifier of the unconditional frame.
+ * @param[in]  data  data of the frame.
+ * @param[in]  datalength  number of data bytes.
+ * @retval  ESP_OK  frame is pending.
+ * @retval  ESP_ERR_INVALID_ARG  frame identifier or data length is invalid.
+ */
+esp_err_t linsched_sporadic_update(uint8_t frameid, const uint8_t *data, uint8_t datalength);
+
+/** Handle an event triggered frame on the bus, including the collision resolution
+ *
+ * The caller has to own the bus and no schedule may be running.
+ *
+ * @param[in]  baudrate  baudrate to use.
+ * @param[in]  entry  event triggered entry.
+ * @param[out]  results  results of the unconditional frames, LINSCHED_MAX_ASSOCIATED entries.
+ * @param[out]  nr_of_results  number of results.
+ * @param[out]  outcome  outcome of the event triggered frame.
+ * @retval  ESP_OK  frame is handled, see outcome.
+ * @retval  ESP_ERR_INVALID_ARG  entry is invalid.
+ */
+esp_err_t linsched_event_triggered(uint16_t baudrate,
+                                   const linsched_entry_t *entry,
+                                   linsched_event_result_t *results,
+                                   uint8_t *nr_of_results,
+                                   linsched_event_outcome_t *outcome);
+
+/** Check whether a schedule is being executed
+ *
+ * @retval  true  a schedule is running.
+ * @retval  false  no schedule is running.
+ */
+bool linsched_running(void);
+
+/** Get the status of the schedule executor
+ *
+ * @param[out]  status  status of the executor.
+ */
+void linsched_get_status(linsched_status_t *status);
+
+/** Register a result listener
+ *
+ * A listener which is registered already with the same context stays registered once.
+ *
+ * @param[in]  listener  listener to register.
+ * @param[in]  ctx  context pointer to be passed to the listener.
+ * @retval  ESP_OK  listener is registered (or was registered already).
+ * @retval  ESP_ERR_NO_MEM  maximum number of listeners is reached.
+ */
+esp_err_t linsched_add_listener(linsched_listener_t listener, void *ctx);
+
+/** Unregister a result listener
+ *
+ * @param[in]  listener  listener to unregister.
+ * @param[in]  ctx  context pointer the listener was registered with.
+ */
+void linsched_remove_listener(linsched_listener_t listener, void *ctx);
+
+#endif /* LIN_SCHEDULE_H_ */
@@ -0,0 +1,103 @@
+/**
+ * @file
+ * @brief LIN event triggered and sporadic frame definitions.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the definitions of the event triggered and sporadic frame handling.
+ *
+ * An event triggered frame header is answered by the slaves of which the associated unconditional
+ * frame was updated, the first data byte holds the protected identifier of that unconditional
+ * frame. When no slave answers, the frame is silent. When more slaves answer at once, the response
+ * is corrupted (collision, stop bit or checksum error) and the master resolves the collision by
+ * handling all associated unconditional frames right away, in one transaction, instead of leaving
+ * this to the host.
+ *
+ * A sporadic frame slot carries the associated unconditional master to slave frame with the
+ * highest priority (first in the list) of which the data was updated, or is silent when none was.
+ *
+ * The associated frame identifiers are listed in the payload of the schedule entry, unused
+ * positions hold LINSCHED_NO_FRAME.
+ *
+ * This part has no dependencies on the ESP-IDF such that it can be built and tested on the host.
+ */
+
+#ifndef LIN_SCHEDULE_EVENT_H_
+    #define LIN_SCHEDULE_EVENT_H_
+
+#include <stdint.h>
+
+#include "lin_schedule_table.h"
+
+/** maximum number of unconditional frames associated with an event triggered or sporadic frame */
+#define LINSCHED_MAX_ASSOCIATED LINSCHED_MAX_DATA_LEN
+
+/** outcome of an event triggered frame enum */
+typedef enum linsched_event_outcome_e {
+    LINSCHED_EVENT_NONE = 0,                    /**< no slave answered */
+    LINSCHED_EVENT_RESPONSE = 1,                /**< one slave answered */
+    LINSCHED_EVENT_COLLISION = 2,               /**< collision, resolved by handling the associated frames */
+    LINSCHED_EVENT_ERROR = 3,                   /**< bus error, the frame could not be handled */
+} linsched_event_outcome_t;                     /**< outcome of an event triggered frame */
+
+/** result of one unconditional frame of an event triggered frame */
+typedef struct linsched_event_result_s {
+    int16_t status;                             /**< lin error code of the frame */
+    uint8_t frameid;                            /**< unconditional frame identifier */
+    uint8_t datalength;                         /**< number of valid bytes in data */
+    uint8_t data[LINSCHED_MAX_DATA_LEN];        /**< received data, data[0] holds the protected identifier */
+} linsched_event_result_t;
+
+/** Slave to master frame handler
+ *
+ * @param[in]  frameid  frame identifier.
+ * @param[out]  data  received data.
+ * @param[in]  datalength  number of data bytes to receive.
+ * @param[in]  ctx  context pointer as passed to linsched_event_execute.
+ * @returns  lin error code of the frame (mlx_err_t).
+ */
+typedef int16_t (* linsched_s2m_handler_t)(uint8_t frameid, uint8_t *data, uint8_t datalength, void *ctx);
+
+/** Calculate the protected identifier of a frame
+ *
+ * @param[in]  frameid  frame identifier (0..63).
+ * @returns  protected identifier.
+ */
+uint8_t linsched_protected_id(uint8_t frameid);
+
+/** Handle an event triggered frame and resolve a collision
+ *
+ * @param[in]  entry  event triggered entry.
+ * @param[in]  s2m  handler which handles a slave to master frame on the bus.
+ * @param[in]  ctx  context pointer to pass to the handler.
+ * @param[out]  results  results of the unconditional frames, LINSCHED_MAX_ASSOCIATED entries.
+ * @param[out]  nr_of_results  number of results (0 when no slave answered).
+ * @returns  outcome of the event triggered frame, for LINSCHED_EVENT_ERROR results[0] holds the error.
+ */
+linsched_event_outcome_t linsched_event_execute(const linsched_entry_t *entry,
+                                                linsched_s2m_handler_t s2m,
+                                                void *ctx,
+                                                linsched_event_result_t *results,
+                                                uint8_t *nr_of_results);
+
+/** Select the frame to send in a sporadic frame slot
+ *
+ * @param[in]  entry  sporadic entry.
+ * @param[in]  pending  bitmap of the frame identifiers of which the data was updated.
+ * @returns  associated frame with the highest priority which is pending, or LINSCHED_NO_FRAME.
+ */
+uint8_t linsched_sporadic_select(const linsched_entry_t *entry, uint64_t pending);
+
+#endif /* LIN_SCHEDULE_EVENT_H_ */
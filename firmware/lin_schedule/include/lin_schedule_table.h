@@ -0,0 +1,130 @@
+/**
+ * @file
+ * @brief LIN schedule table definitions.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the definitions of the schedule tables and of the cursor which walks
+ * through them slot by slot. This part has no dependencies on the ESP-IDF such that it can be built
+ * and tested on the host.
+ */
+
+#ifndef LIN_SCHEDULE_TABLE_H_
+    #define LIN_SCHEDULE_TABLE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** maximum number of data bytes in a LIN frame */
+#define LINSCHED_MAX_DATA_LEN 8u
+
+/** number of frame identifiers on a LIN bus */
+#define LINSCHED_NR_OF_FRAMES 64u
+
+/** table index used when no table is selected */
+#define LINSCHED_NO_TABLE 0xFFu
+
+/** frame identifier used for the unused positions in a list of associated frames */
+#define LINSCHED_NO_FRAME 0xFFu
+
+/** schedule entry type enum */
+typedef enum linsched_frame_type_e {
+    LINSCHED_M2S = 0,                           /**< master to slave frame */
+    LINSCHED_S2M = 1,                           /**< slave to master frame */
+    LINSCHED_WAKEUP = 2,                        /**< wake up pulse, pulse time (us) in payload[0..1] */
+    LINSCHED_EVENT_TRIGGERED = 3,               /**< event triggered frame, associated frame identifiers in payload */
+    LINSCHED_SPORADIC = 4,                      /**< sporadic frame, associated frame identifiers in payload */
+} linsched_frame_type_t;                        /**< schedule entry type */
+
+/** schedule table entry (frame slot) */
+typedef struct linsched_entry_s {
+    uint8_t type;                               /**< entry type (linsched_frame_type_t) */
+    uint8_t frameid;                            /**< frame identifier */
+    uint8_t datalength;                         /**< number of data bytes */
+    uint8_t enhanced_crc;                       /**< 1: use enhanced checksum */
+    uint32_t slot_us;                           /**< length of the frame slot (us) */
+    uint8_t payload[LINSCHED_MAX_DATA_LEN];     /**< data for M2S frames, associated frames otherwise */
+} linsched_entry_t;
+
+/** schedule table */
+typedef struct linsched_table_s {
+    uint16_t baudrate;                          /**< baudrate used for all frames in the table */
+    uint8_t nr_of_entries;                      /**< number of entries in the table (0: table is empty) */
+    linsched_entry_t *entries;                  /**< entries of the table */
+} linsched_table_t;
+
+/** schedule cursor, keeps track of the slot to be executed next */
+typedef struct linsched_cursor_s {
+    uint8_t table;                              /**< table being executed */
+    uint8_t pending;                            /**< table to switch to at the next slot, or LINSCHED_NO_TABLE */
+    uint8_t position;                           /**< entry to be executed in the next slot */
+    uint64_t slot_start;                        /**< nominal start time of the next slot (us) */
+    uint32_t sequence;                          /**< number of slots executed since the start */
+    uint32_t overruns;                          /**< number of slots which started after their nominal end */
+} linsched_cursor_t;
+
+/** Check whether a schedule entry is valid
+ *
+ * @param[in]  entry  entry to check.
+ * @param[in]  min_slot_us  minimum slot length (us).
+ * @retval  true  entry can be executed.
+ * @retval  false  entry is invalid.
+ */
+bool linsched_entry_valid(const linsched_entry_t *entry, uint32_t min_slot_us);
+
+/** Get the number of unconditional frames associated with an entry
+ *
+ * The associated frame identifiers of an event triggered or sporadic entry are listed in its
+ * payload, in order of priority, unused positions at the end hold LINSCHED_NO_FRAME.
+ *
+ * @param[in]  entry  event triggered or sporadic entry.
+ * @returns  number of associated frames, 0 when the list is empty or invalid.
+ */
+uint8_t linsched_nr_of_associated(const linsched_entry_t *entry);
+
+/** Start a cursor at the first slot of a table
+ *
+ * @param[out]  cursor  cursor to start.
+ * @param[in]  table  index of the table to execute.
+ * @param[in]  now  current time (us).
+ */
+void linsched_cursor_start(linsched_cursor_t *cursor, uint8_t table, uint64_t now);
+
+/** Request a switch to another table
+ *
+ * The switch takes effect at the start of the next slot, the slot which is running completes.
+ *
+ * @param[in|out]  cursor  cursor to update.
+ * @param[in]  table  index of the table to switch to.
+ */
+void linsched_cursor_switch(linsched_cursor_t *cursor, uint8_t table);
+
+/** Advance the cursor to the slot which starts at the current time
+ *
+ * A slot which starts later than its nominal end time is counted as an overrun, the slot timing
+ * restarts from the current time in that case instead of trying to catch up.
+ *
+ * @param[in|out]  cursor  cursor to advance, slot_start holds the start of the next slot afterwards.
+ * @param[in]  tables  schedule tables (indexed by table number).
+ * @param[in]  now  current time (us).
+ * @param[out]  late_us  time between the nominal start of the slot and now (us).
+ * @returns  index of the entry to execute in the slot.
+ */
+uint8_t linsched_cursor_next(linsched_cursor_t *cursor,
+                             const linsched_table_t *tables,
+                             uint64_t now,
+                             uint32_t *late_us);
+
+#endif /* LIN_SCHEDULE_TABLE_H_ */
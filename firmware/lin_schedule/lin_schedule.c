@@ -0,0 +1,603 @@
+/**
+ * @file
+ * @brief LIN schedule table executor routines.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the implementations of the LIN schedule table executor.
+ *
+ * A general purpose timer counts in micro seconds since the initialization. At the start of each
+ * slot the alarm of the timer is set to the nominal start of the next slot, the alarm interrupt
+ * wakes the schedule task which then executes the next slot. Since the slot starts are derived
+ * from the nominal start times, the execution time of the frames does not accumulate as drift.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "driver/gptimer.h"
+#include "esp_attr.h"
+#include "esp_err.h"
+#include "esp_log.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+#include "sdkconfig.h"
+
+#include "lin_cache.h"
+#include "lin_err.h"
+#include "lin_master.h"
+#include "lin_timing.h"
+
+#include "lin_schedule.h"
+
+/** maximum number of result listeners */
+#define LINSCHED_MAX_LISTENERS 4u
+
+/** maximum number of results handed over to the listeners at once */
+#define LINSCHED_REPORT_BATCH 32u
+
+/** maximum time to wait for a running slot to complete */
+#define LINSCHED_LOCK_TIMEOUT pdMS_TO_TICKS(1000)
+
+/** resolution of the slot timer */
+#define LINSCHED_TIMER_RESOLUTION_HZ 1000000u
+
+static const char *TAG = "lin-schedule";
+
+typedef struct linsched_bus_ctx_s {
+    uint16_t baudrate;                          /**< baudrate to use */
+    bool enhanced_crc;                          /**< true: use enhanced checksum */
+} linsched_bus_ctx_t;
+
+typedef struct linsched_listener_entry_s {
+    linsched_listener_t listener;               /**< registered listener, or NULL */
+    void *ctx;                                  /**< context for the listener */
+} linsched_listener_entry_t;
+
+static linsched_table_t tables[CONFIG_LIN_SCHEDULE_MAX_TABLES];
+static linsched_cursor_t cursor;
+static volatile bool running = false;
+static uint64_t start_time = 0u;
+static linsched_status_t status;
+static portMUX_TYPE status_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static SemaphoreHandle_t sched_lock = NULL;
+static gptimer_handle_t slot_timer = NULL;
+static TaskHandle_t schedTaskHandle = NULL;
+
+static uint64_t sporadic_pending = 0u;
+static uint8_t sporadic_data[LINSCHED_NR_OF_FRAMES][LINSCHED_MAX_DATA_LEN];
+static uint8_t sporadic_length[LINSCHED_NR_OF_FRAMES];
+static portMUX_TYPE sporadic_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static QueueHandle_t result_queue = NULL;
+static linsched_listener_entry_t listeners[LINSCHED_MAX_LISTENERS];
+static SemaphoreHandle_t listener_lock = NULL;
+
+/** Slot timer alarm interrupt handler
+ *
+ * @param[in]  timer  timer which raised the alarm.
+ * @param[in]  edata  alarm event data.
+ * @param[in]  user_ctx  user context (not used).
+ * @retval  true  a higher priority task was woken.
+ * @retval  false  no task switch is needed.
+ */
+static bool linsched_slot_alarm(gptimer_handle_t timer, const gptimer_alarm_event_data_t *edata, void *user_ctx);
+
+/** Handle a slave to master frame for the event triggered frame handling
+ *
+ * @param[in]  frameid  frame identifier.
+ * @param[out]  data  received data.
+ * @param[in]  datalength  number of data bytes to receive.
+ * @param[in]  ctx  bus settings (linsched_bus_ctx_t).
+ * @returns  lin error code of the frame.
+ */
+static int16_t linsched_event_s2m(uint8_t frameid, uint8_t *data, uint8_t datalength, void *ctx);
+
+/** Execute an event triggered frame slot
+ *
+ * @param[in]  table  table the entry belongs to.
+ * @param[in]  entry  event triggered entry.
+ * @param[in|out]  results  results[0] holds the slot information, one result per unconditional frame afterwards.
+ * @returns  number of results.
+ */
+static uint8_t linsched_execute_event(const linsched_table_t *table,
+                                      const linsched_entry_t *entry,
+                                      linsched_result_t *results);
+
+/** Execute a sporadic frame slot
+ *
+ * @param[in]  table  table the entry belongs to.
+ * @param[in]  entry  sporadic entry.
+ * @param[in|out]  result  result of the slot.
+ * @returns  lin error code of the frame.
+ */
+static lin_err_t linsched_execute_sporadic(const linsched_table_t *table,
+                                           const linsched_entry_t *entry,
+                                           linsched_result_t *result);
+
+/** Execute the frame slot which starts now
+ *
+ * To be called with the schedule lock taken.
+ */
+static void linsched_execute_slot(void);
+
+/** Schedule task, executes one slot per alarm
+ *
+ * @param[in]  arg  task argument (not used).
+ */
+static void linsched_task(void *arg);
+
+/** Report task, hands the results over to the listeners
+ *
+ * @param[in]  arg  task argument (not used).
+ */
+static void linsched_report_task(void *arg);
+
+/** Check whether a table index refers to an uploaded table
+ *
+ * @param[in]  table  table index.
+ * @returns  ESP_OK, ESP_ERR_INVALID_ARG for an invalid index or ESP_ERR_NOT_FOUND for an empty table.
+ */
+static esp_err_t linsched_check_table(uint8_t table);
+
+
+static bool IRAM_ATTR linsched_slot_alarm(gptimer_handle_t timer,
+                                          const gptimer_alarm_event_data_t *edata,
+                                          void *user_ctx) {
+    (void)timer;
+    (void)edata;
+    (void)user_ctx;
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(schedTaskHandle, &woken);
+    return woken == pdTRUE;
+}
+
+static int16_t linsched_event_s2m(uint8_t frameid, uint8_t *data, uint8_t datalength, void *ctx) {
+    const linsched_bus_ctx_t *bus = (const linsched_bus_ctx_t*)ctx;
+    return (int16_t)lincache_send_s2m(bus->baudrate, bus->enhanced_crc, frameid, data, datalength);
+}
+
+static uint8_t linsched_execute_event(const linsched_table_t *table,
+                                      const linsched_entry_t *entry,
+                                      linsched_result_t *results) {
+    linsched_bus_ctx_t bus = {
+        .baudrate = table->baudrate,
+        .enhanced_crc = entry->enhanced_crc != 0u,
+    };
+    linsched_event_result_t events[LINSCHED_MAX_ASSOCIATED];
+    uint8_t nr_of_events = 0u;
+    linsched_event_outcome_t outcome = linsched_event_execute(entry, linsched_event_s2m, &bus, events, &nr_of_events);
+
+    results[0].event = (uint8_t)outcome;
+    if (outcome == LINSCHED_EVENT_ERROR) {
+        results[0].status = events[0].status;
+        nr_of_events = 0u;
+    }
+
+    /* one result per unconditional frame, all belonging to the same slot */
+    for (uint8_t i = 0u; i < nr_of_events; i++) {
+        if (i > 0u) {
+            memcpy(&results[i], &results[0], sizeof(linsched_result_t));
+        }
+        results[i].frameid = events[i].frameid;
+        results[i].status = events[i].status;
+        results[i].datalength = events[i].datalength;
+        memcpy(results[i].data, events[i].data, sizeof(results[i].data));
+    }
+
+    return (nr_of_events > 0u) ? nr_of_events : 1u;
+}
+
+static lin_err_t linsched_execute_sporadic(const linsched_table_t *table,
+                                           const linsched_entry_t *entry,
+                                           linsched_result_t *result) {
+    lin_err_t error = LIN_OK;
+    uint8_t datalength = 0u;
+
+    taskENTER_CRITICAL(&sporadic_lock);
+    uint8_t frameid = linsched_sporadic_select(entry, sporadic_pending);
+    if (frameid != LINSCHED_NO_FRAME) {
+        sporadic_pending &= ~(1ull << frameid);
+        datalength = sporadic_length[frameid];
+        memcpy(result->data, sporadic_data[frameid], datalength);
+    }
+    taskEXIT_CRITICAL(&sporadic_lock);
+
+    /* the slot is silent when none of the associated frames was updated */
+    result->frameid = frameid;
+    if (frameid != LINSCHED_NO_FRAME) {
+        error = lintiming_send_m2s(table->baudrate, entry->enhanced_crc != 0u, frameid, result->data, datalength);
+        result->datalength = datalength;
+    }
+
+    return error;
+}
+
+static void linsched_execute_slot(void) {
+    uint64_t now = 0u;
+    uint32_t late_us = 0u;
+
+    (void)gptimer_get_raw_count(slot_timer, &now);
+    if (now < cursor.slot_start) {
+        /* woken before the slot starts, the alarm is still armed */
+        return;
+    }
+
+    uint8_t index = linsched_cursor_next(&cursor, tables, now, &late_us);
+    const linsched_table_t *table = &tables[cursor.table];
+    const linsched_entry_t *entry = &table->entries[index];
+
+    /* arm the alarm for the next slot before the frame takes time */
+    gptimer_alarm_config_t alarm = {
+        .alarm_count = cursor.slot_start,
+        .reload_count = 0u,
+        .flags.auto_reload_on_alarm = false,
+    };
+    (void)gptimer_set_alarm_action(slot_timer, &alarm);
+
+    linsched_result_t results[LINSCHED_MAX_ASSOCIATED];
+    linsched_result_t *result = &results[0];
+    uint8_t nr_of_results = 1u;
+    memset(result, 0, sizeof(linsched_result_t));
+    result->timestamp_us = (uint32_t)(now - late_us - start_time);
+    result->sequence = cursor.sequence - 1u;
+    result->late_us = (late_us > UINT16_MAX) ? UINT16_MAX : (uint16_t)late_us;
+    result->table = cursor.table;
+    result->entry = index;
+    result->type = entry->type;
+    result->frameid = entry->frameid;
+
+    lin_err_t error = LIN_OK;
+    switch ((linsched_frame_type_t)entry->type) {
+        case LINSCHED_M2S:
+            error = lintiming_send_m2s(table->baudrate,
+                                       entry->enhanced_crc != 0u,
+                                       entry->frameid,
+                                       entry->payload,
+                                       entry->datalength);
+            memcpy(result->data, entry->payload, entry->datalength);
+            result->datalength = entry->datalength;
+            break;
+
+        case LINSCHED_S2M:
+            error = lincache_send_s2m(table->baudrate,
+                                      entry->enhanced_crc != 0u,
+                                      entry->frameid,
+                                      result->data,
+                                      entry->datalength);
+            if (error == LIN_OK) {
+                result->datalength = entry->datalength;
+            }
+            break;
+
+        case LINSCHED_EVENT_TRIGGERED:
+            nr_of_results = linsched_execute_event(table, entry, results);
+            error = (lin_err_t)result->status;
+            break;
+
+        case LINSCHED_SPORADIC:
+            error = linsched_execute_sporadic(table, entry, result);
+            break;
+
+        case LINSCHED_WAKEUP:
+        default:
+            error = linmaster_send_wakeup((uint16_t)entry->payload[0] | ((uint16_t)entry->payload[1] << 8));
+            break;
+    }
+    result->status = (int16_t)error;
+
+    uint32_t errors = 0u;
+    uint32_t dropped = 0u;
+    for (uint8_t i = 0u; i < nr_of_results; i++) {
+        if (results[i].status != LIN_OK) {
+            errors++;
+        }
+        if (xQueueSend(result_queue, &results[i], 0) != pdTRUE) {
+            dropped++;
+        }
+    }
+
+    taskENTER_CRITICAL(&status_lock);
+    status.table = cursor.table;
+    status.pending = cursor.pending;
+    status.slots = cursor.sequence;
+    status.overruns = cursor.overruns;
+    status.errors += errors;
+    if (late_us > status.max_late_us) {
+        status.max_late_us = late_us;
+    }
+    status.results_dropped += dropped;
+    taskEXIT_CRITICAL(&status_lock);
+}
+
+static void linsched_task(void *arg) {
+    (void)arg;
+
+    while (1) {
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        (void)xSemaphoreTake(sched_lock, portMAX_DELAY);
+        if (running) {
+            linsched_execute_slot();
+        }
+        (void)xSemaphoreGive(sched_lock);
+    }
+}
+
+static void linsched_report_task(void *arg) {
+    (void)arg;
+    static linsched_result_t results[LINSCHED_REPORT_BATCH];
+
+    while (1) {
+        if (xQueueReceive(result_queue, &results[0], portMAX_DELAY) == pdTRUE) {
+            if (uxQueueMessagesWaiting(result_queue) < (LINSCHED_REPORT_BATCH - 1u)) {
+                /* collect the results of the next slots such that listeners get fewer, larger batches */
+                vTaskDelay(pdMS_TO_TICKS(CONFIG_LIN_SCHEDULE_REPORT_INTERVAL));
+            }
+            size_t nr_of_results = 1u;
+            while ((nr_of_results < LINSCHED_REPORT_BATCH) &&
+                   (xQueueReceive(result_queue, &results[nr_of_results], 0) == pdTRUE)) {
+                nr_of_results++;
+            }
+
+            (void)xSemaphoreTake(listener_lock, portMAX_DELAY);
+            for (size_t i = 0; i < LINSCHED_MAX_LISTENERS; i++) {
+                if (listeners[i].listener != NULL) {
+                    listeners[i].listener(results, nr_of_results, listeners[i].ctx);
+                }
+            }
+            (void)xSemaphoreGive(listener_lock);
+        }
+    }
+}
+
+static esp_err_t linsched_check_table(uint8_t table) {
+    esp_err_t retval = ESP_OK;
+    if (table >= CONFIG_LIN_SCHEDULE_MAX_TABLES) {
+        retval = ESP_ERR_INVALID_ARG;
+    } else if (tables[table].nr_of_entries == 0u) {
+        retval = ESP_ERR_NOT_FOUND;
+    }
+    return retval;
+}
+
+void linsched_init(void) {
+    memset(tables, 0, sizeof(tables));
+    memset(listeners, 0, sizeof(listeners));
+    memset(&status, 0, sizeof(status));
+    status.pending = LINSCHED_NO_TABLE;
+
+    sched_lock = xSemaphoreCreateMutex();
+    listener_lock = xSemaphoreCreateMutex();
+    result_queue = xQueueCreate(CONFIG_LIN_SCHEDULE_RESULT_QUEUE_LEN, sizeof(linsched_result_t));
+
+    xTaskCreate(linsched_task, "lin_schedule_task", 2048 * 2, NULL, CONFIG_LIN_SCHEDULE_TASK_PRIORITY, &schedTaskHandle);
+    xTaskCreate(linsched_report_task, "lin_report_task", 2048 * 2, NULL, 5, NULL);
+
+    gptimer_config_t timer_config = {
+        .clk_src = GPTIMER_CLK_SRC_DEFAULT,
+        .direction = GPTIMER_COUNT_UP,
+        .resolution_hz = LINSCHED_TIMER_RESOLUTION_HZ,
+    };
+    ESP_ERROR_CHECK(gptimer_new_timer(&timer_config, &slot_timer));
+    gptimer_event_callbacks_t callbacks = {
+        .on_alarm = linsched_slot_alarm,
+    };
+    ESP_ERROR_CHECK(gptimer_register_event_callbacks(slot_timer, &callbacks, NULL));
+    ESP_ERROR_CHECK(gptimer_enable(slot_timer));
+    ESP_ERROR_CHECK(gptimer_start(slot_timer));
+}
+
+esp_err_t linsched_upload(uint8_t table, uint16_t baudrate, const linsched_entry_t *entries, uint8_t nr_of_entries) {
+    esp_err_t retval = ESP_OK;
+
+    if ((table >= CONFIG_LIN_SCHEDULE_MAX_TABLES) || (nr_of_entries > CONFIG_LIN_SCHEDULE_MAX_ENTRIES)) {
+        retval = ESP_ERR_INVALID_ARG;
+    }
+    for (uint8_t i = 0u; (retval == ESP_OK) && (i < nr_of_entries); i++) {
+        if (!linsched_entry_valid(&entries[i], CONFIG_LIN_SCHEDULE_MIN_SLOT_TIME)) {
+            ESP_LOGE(TAG, "table %u entry %u is invalid", table, i);
+            retval = ESP_ERR_INVALID_ARG;
+        }
+    }
+
+    linsched_entry_t *copy = NULL;
+    if ((retval == ESP_OK) && (nr_of_entries > 0u)) {
+        copy = malloc(nr_of_entries * sizeof(linsched_entry_t));
+        if (copy != NULL) {
+            memcpy(copy, entries, nr_of_entries * sizeof(linsched_entry_t));
+        } else {
+            retval = ESP_ERR_NO_MEM;
+        }
+    }
+
+    if (retval == ESP_OK) {
+        if (xSemaphoreTake(sched_lock, LINSCHED_LOCK_TIMEOUT) == pdTRUE) {
+            if (running && ((cursor.table == table) || (cursor.pending == table))) {
+                retval = ESP_ERR_INVALID_STATE;
+            } else {
+                free(tables[table].entries);
+                tables[table].entries = copy;
+                tables[table].nr_of_entries = nr_of_entries;
+                tables[table].baudrate = baudrate;
+                copy = NULL;
+                ESP_LOGI(TAG, "table %u uploaded with %u entries", table, nr_of_entries);
+            }
+            (void)xSemaphoreGive(sched_lock);
+        } else {
+            retval = ESP_ERR_TIMEOUT;
+        }
+    }
+
+    free(copy);
+    return retval;
+}
+
+esp_err_t linsched_sporadic_update(uint8_t frameid, const uint8_t *data, uint8_t datalength) {
+    esp_err_t retval = ESP_ERR_INVALID_ARG;
+
+    if ((frameid < LINSCHED_NR_OF_FRAMES) && (datalength > 0u) && (datalength <= LINSCHED_MAX_DATA_LEN)) {
+        taskENTER_CRITICAL(&sporadic_lock);
+        memcpy(sporadic_data[frameid], data, datalength);
+        sporadic_length[frameid] = datalength;
+        sporadic_pending |= 1ull << frameid;
+        taskEXIT_CRITICAL(&sporadic_lock);
+        retval = ESP_OK;
+    }
+
+    return retval;
+}
+
+esp_err_t linsched_event_triggered(uint16_t baudrate,
+                                   const linsched_entry_t *entry,
+                                   linsched_event_result_t *results,
+                                   uint8_t *nr_of_results,
+                                   linsched_event_outcome_t *outcome) {
+    esp_err_t retval = ESP_ERR_INVALID_ARG;
+
+    if ((entry->type == LINSCHED_EVENT_TRIGGERED) && linsched_entry_valid(entry, 0u)) {
+        linsched_bus_ctx_t bus = {
+            .baudrate = baudrate,
+            .enhanced_crc = entry->enhanced_crc != 0u,
+        };
+        *outcome = linsched_event_execute(entry, linsched_event_s2m, &bus, results, nr_of_results);
+        retval = ESP_OK;
+    }
+
+    return retval;
+}
+
+esp_err_t linsched_start(uint8_t table) {
+    esp_err_t retval = ESP_ERR_TIMEOUT;
+
+    if (xSemaphoreTake(sched_lock, LINSCHED_LOCK_TIMEOUT) == pdTRUE) {
+        retval = linsched_check_table(table);
+        if ((retval == ESP_OK) && running) {
+            retval = ESP_ERR_INVALID_STATE;
+        }
+        if (retval == ESP_OK) {
+            (void)gptimer_get_raw_count(slot_timer, &start_time);
+            linsched_cursor_start(&cursor, table, start_time);
+
+            taskENTER_CRITICAL(&status_lock);
+            memset(&status, 0, sizeof(status));
+            status.running = 1u;
+            status.table = table;
+            status.pending = LINSCHED_NO_TABLE;
+            taskEXIT_CRITICAL(&status_lock);
+
+            running = true;
+            /* the first slot starts right away */
+            xTaskNotifyGive(schedTaskHandle);
+            ESP_LOGI(TAG, "table %u started", table);
+        }
+        (void)xSemaphoreGive(sched_lock);
+    }
+
+    return retval;
+}
+
+esp_err_t linsched_switch(uint8_t table) {
+    esp_err_t retval = ESP_ERR_TIMEOUT;
+
+    if (xSemaphoreTake(sched_lock, LINSCHED_LOCK_TIMEOUT) == pdTRUE) {
+        retval = linsched_check_table(table);
+        if ((retval == ESP_OK) && !running) {
+            retval = ESP_ERR_INVALID_STATE;
+        }
+        if (retval == ESP_OK) {
+            linsched_cursor_switch(&cursor, table);
+            taskENTER_CRITICAL(&status_lock);
+            status.pending = table;
+            taskEXIT_CRITICAL(&status_lock);
+            ESP_LOGI(TAG, "switch to table %u", table);
+        }
+        (void)xSemaphoreGive(sched_lock);
+    }
+
+    return retval;
+}
+
+esp_err_t linsched_stop(void) {
+    esp_err_t retval = ESP_ERR_TIMEOUT;
+
+    /* the schedule task holds the lock while executing a slot */
+    if (xSemaphoreTake(sched_lock, LINSCHED_LOCK_TIMEOUT) == pdTRUE) {
+        if (running) {
+            running = false;
+            (void)gptimer_set_alarm_action(slot_timer, NULL);
+            taskENTER_CRITICAL(&status_lock);
+            status.running = 0u;
+            status.pending = LINSCHED_NO_TABLE;
+            taskEXIT_CRITICAL(&status_lock);
+            ESP_LOGI(TAG, "stopped");
+        }
+        (void)xSemaphoreGive(sched_lock);
+        retval = ESP_OK;
+    }
+
+    return retval;
+}
+
+bool linsched_running(void) {
+    return running;
+}
+
+void linsched_get_status(linsched_status_t *stat) {
+    taskENTER_CRITICAL(&status_lock);
+    *stat = status;
+    taskEXIT_CRITICAL(&status_lock);
+}
+
+esp_err_t linsched_add_listener(linsched_listener_t listener, void *ctx) {
+    esp_err_t retval = ESP_ERR_NO_MEM;
+
+    (void)xSemaphoreTake(listener_lock, portMAX_DELAY);
+    size_t free_slot = LINSCHED_MAX_LISTENERS;
+    for (size_t i = 0; i < LINSCHED_MAX_LISTENERS; i++) {
+        if ((listeners[i].listener == listener) && (listeners[i].ctx == ctx)) {
+            /* registered already, e.g. by a previous enable of the interface */
+            retval = ESP_OK;
+        } else if ((listeners[i].listener == NULL) && (free_slot == LINSCHED_MAX_LISTENERS)) {
+            free_slot = i;
+        }
+    }
+    if ((retval != ESP_OK) && (free_slot < LINSCHED_MAX_LISTENERS)) {
+        listeners[free_slot].listener = listener;
+        listeners[free_slot].ctx = ctx;
+        retval = ESP_OK;
+    }
+    (void)xSemaphoreGive(listener_lock);
+
+    return retval;
+}
+
+void linsched_remove_listener(linsched_listener_t listener, void *ctx) {
+    (void)xSemaphoreTake(listener_lock, portMAX_DELAY);
+    for (size_t i = 0; i < LINSCHED_MAX_LISTENERS; i++) {
+        if ((listeners[i].listener == listener) && (listeners[i].ctx == ctx)) {
+            listeners[i].listener = NULL;
+            listeners[i].ctx = NULL;
+        }
+    }
+    (void)xSemaphoreGive(listener_lock);
+}
@@ -0,0 +1,131 @@
+/**
+ * @file
+ * @brief LIN event triggered and sporadic frame routines.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the implementations of the event triggered and sporadic frame handling.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "mlx_err.h"
+
+#include "lin_schedule_event.h"
+
+/** highest frame identifier on a LIN bus */
+#define LIN_MAX_FRAME_ID 0x3Fu
+
+/** Check whether the response of an event triggered frame was corrupted by a collision
+ *
+ * @param[in]  status  lin error code of the event triggered frame.
+ * @retval  true  more slaves answered at once.
+ * @retval  false  the error is not caused by a collision.
+ */
+static bool linsched_event_collision(int16_t status);
+
+/** Find the associated frame of which the protected identifier is in the response
+ *
+ * @param[in]  entry  event triggered entry.
+ * @param[in]  pid  first data byte of the response.
+ * @returns  frame identifier, or LINSCHED_NO_FRAME when no associated frame matches.
+ */
+static uint8_t linsched_event_source(const linsched_entry_t *entry, uint8_t pid);
+
+
+static bool linsched_event_collision(int16_t status) {
+    return (status == MLX_FAIL_TX_COLLISION) || (status == MLX_FAIL_RX_STOPBIT) || (status == MLX_FAIL_CHECKSUM);
+}
+
+static uint8_t linsched_event_source(const linsched_entry_t *entry, uint8_t pid) {
+    uint8_t retval = LINSCHED_NO_FRAME;
+
+    for (uint8_t i = 0u; (i < LINSCHED_MAX_ASSOCIATED) && (entry->payload[i] != LINSCHED_NO_FRAME); i++) {
+        if (linsched_protected_id(entry->payload[i]) == pid) {
+            retval = entry->payload[i];
+            break;
+        }
+    }
+
+    return retval;
+}
+
+uint8_t linsched_protected_id(uint8_t frameid) {
+    uint8_t id = frameid & LIN_MAX_FRAME_ID;
+    uint8_t p0 = (id ^ (id >> 1) ^ (id >> 2) ^ (id >> 4)) & 0x01u;
+    uint8_t p1 = ~((id >> 1) ^ (id >> 3) ^ (id >> 4) ^ (id >> 5)) & 0x01u;
+    return id | (uint8_t)(p0 << 6) | (uint8_t)(p1 << 7);
+}
+
+linsched_event_outcome_t linsched_event_execute(const linsched_entry_t *entry,
+                                                linsched_s2m_handler_t s2m,
+                                                void *ctx,
+                                                linsched_event_result_t *results,
+                                                uint8_t *nr_of_results) {
+    linsched_event_outcome_t outcome;
+    linsched_event_result_t *result = &results[0];
+
+    memset(result, 0, sizeof(linsched_event_result_t));
+    result->frameid = entry->frameid;
+    result->status = s2m(entry->frameid, result->data, entry->datalength, ctx);
+    *nr_of_results = 1u;
+
+    uint8_t source = LINSCHED_NO_FRAME;
+    if (result->status == MLX_OK) {
+        source = linsched_event_source(entry, result->data[0]);
+    }
+
+    if (source != LINSCHED_NO_FRAME) {
+        /* one slave answered, report it as its unconditional frame */
+        result->frameid = source;
+        result->datalength = entry->datalength;
+        outcome = LINSCHED_EVENT_RESPONSE;
+    } else if (result->status == MLX_FAIL_RX_TIMEOUT) {
+        *nr_of_results = 0u;
+        outcome = LINSCHED_EVENT_NONE;
+    } else if ((result->status == MLX_OK) || linsched_event_collision(result->status)) {
+        /* a valid checksum with an unknown identifier is a collision of slaves sending the same bytes */
+        uint8_t count = linsched_nr_of_associated(entry);
+        for (uint8_t i = 0u; i < count; i++) {
+            result = &results[i];
+            memset(result, 0, sizeof(linsched_event_result_t));
+            result->frameid = entry->payload[i];
+            result->status = s2m(entry->payload[i], result->data, entry->datalength, ctx);
+            if (result->status == MLX_OK) {
+                result->datalength = entry->datalength;
+            }
+        }
+        *nr_of_results = count;
+        outcome = LINSCHED_EVENT_COLLISION;
+    } else {
+        outcome = LINSCHED_EVENT_ERROR;
+    }
+
+    return outcome;
+}
+
+uint8_t linsched_sporadic_select(const linsched_entry_t *entry, uint64_t pending) {
+    uint8_t retval = LINSCHED_NO_FRAME;
+
+    for (uint8_t i = 0u; (i < LINSCHED_MAX_ASSOCIATED) && (entry->payload[i] != LINSCHED_NO_FRAME); i++) {
+        if ((entry->payload[i] <= LIN_MAX_FRAME_ID) && ((pending & (1ull << entry->payload[i])) != 0u)) {
+            retval = entry->payload[i];
+            break;
+        }
+    }
+
+    return retval;
+}
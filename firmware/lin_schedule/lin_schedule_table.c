@@ -0,0 +1,125 @@
+/**
+ * @file
+ * @brief LIN schedule table routines.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the implementations of the schedule table validation and cursor.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "lin_schedule_table.h"
+
+/** highest frame identifier on a LIN bus */
+#define LIN_MAX_FRAME_ID 0x3Fu
+
+bool linsched_entry_valid(const linsched_entry_t *entry, uint32_t min_slot_us) {
+    bool retval = false;
+
+    if (entry->slot_us >= min_slot_us) {
+        switch ((linsched_frame_type_t)entry->type) {
+            case LINSCHED_M2S:
+            case LINSCHED_S2M:
+                retval = (entry->frameid <= LIN_MAX_FRAME_ID) &&
+                         (entry->datalength > 0u) &&
+                         (entry->datalength <= LINSCHED_MAX_DATA_LEN);
+                break;
+
+            case LINSCHED_WAKEUP:
+                retval = true;
+                break;
+
+            case LINSCHED_EVENT_TRIGGERED:
+                /* the first data byte holds the protected identifier of the associated frame */
+                retval = (entry->frameid <= LIN_MAX_FRAME_ID) &&
+                         (entry->datalength > 1u) &&
+                         (entry->datalength <= LINSCHED_MAX_DATA_LEN) &&
+                         (linsched_nr_of_associated(entry) > 0u);
+                break;
+
+            case LINSCHED_SPORADIC:
+                retval = (linsched_nr_of_associated(entry) > 0u);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    return retval;
+}
+
+uint8_t linsched_nr_of_associated(const linsched_entry_t *entry) {
+    uint8_t count = 0u;
+    uint64_t seen = 0u;
+    bool valid = true;
+
+    for (uint8_t i = 0u; valid && (i < LINSCHED_MAX_DATA_LEN); i++) {
+        uint8_t frameid = entry->payload[i];
+        if (frameid == LINSCHED_NO_FRAME) {
+            /* the list ends at the first unused position */
+            continue;
+        } else if ((count < i) || (frameid > LIN_MAX_FRAME_ID) || ((seen & (1ull << frameid)) != 0u)) {
+            valid = false;
+        } else {
+            seen |= 1ull << frameid;
+            count++;
+        }
+    }
+
+    return valid ? count : 0u;
+}
+
+void linsched_cursor_start(linsched_cursor_t *cursor, uint8_t table, uint64_t now) {
+    cursor->table = table;
+    cursor->pending = LINSCHED_NO_TABLE;
+    cursor->position = 0u;
+    cursor->slot_start = now;
+    cursor->sequence = 0u;
+    cursor->overruns = 0u;
+}
+
+void linsched_cursor_switch(linsched_cursor_t *cursor, uint8_t table) {
+    cursor->pending = table;
+}
+
+uint8_t linsched_cursor_next(linsched_cursor_t *cursor,
+                             const linsched_table_t *tables,
+                             uint64_t now,
+                             uint32_t *late_us) {
+    if (cursor->pending != LINSCHED_NO_TABLE) {
+        cursor->table = cursor->pending;
+        cursor->pending = LINSCHED_NO_TABLE;
+        cursor->position = 0u;
+    }
+
+    const linsched_table_t *table = &tables[cursor->table];
+    uint8_t position = cursor->position;
+    uint64_t start = cursor->slot_start;
+
+    if (now >= (start + table->entries[position].slot_us)) {
+        /* the previous slot ran past the end of this one, restart timing from now */
+        cursor->overruns++;
+        start = now;
+    }
+    *late_us = (now > start) ? (uint32_t)(now - start) : 0u;
+
+    cursor->slot_start = start + table->entries[position].slot_us;
+    cursor->position = (uint8_t)((position + 1u) % table->nr_of_entries);
+    cursor->sequence++;
+
+    return position;
+}
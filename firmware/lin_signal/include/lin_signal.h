@@ -0,0 +1,130 @@
+/**
+ * @file
+ * @brief LIN signal decoding definitions.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the definitions of the on-device signal decoding.
+ *
+ * A compiled LDF (see lin_signal_db.h) is uploaded once. A reporting task picks up the slave
+ * responses from the last-value cache, decodes the signals of the frames in the database and hands
+ * the signals of which the value changed in batches over to the registered listeners (USB bulk,
+ * websocket). Each upload increments the generation such that listeners can detect that signal
+ * indexes from before are no longer valid.
+ */
+
+#ifndef LIN_SIGNAL_H_
+    #define LIN_SIGNAL_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+#include "lin_signal_db.h"
+
+/** signal decoding status */
+typedef struct linsig_status_s {
+    uint16_t nr_of_signals;                     /**< number of signals in the database */
+    uint8_t nr_of_frames;                       /**< number of frames in the database */
+    uint8_t reserved;
+    uint32_t generation;                        /**< number of uploads since the start */
+    uint32_t frames_decoded;                    /**< number of frames decoded since the upload */
+    uint32_t changes;                           /**< number of value changes since the upload */
+} linsig_status_t;
+
+/** Signal change listener
+ *
+ * Called from the reporting task, a listener shall not block for long.
+ *
+ * @param[in]  values  values of the changed signals.
+ * @param[in]  nr_of_values  number of values.
+ * @param[in]  generation  generation of the database the indexes belong to.
+ * @param[in]  ctx  context pointer as passed during registration.
+ */
+typedef void (* linsig_listener_t)(const linsig_value_t *values, size_t nr_of_values, uint32_t generation, void *ctx);
+
+/** initialize the LIN signal decoding module */
+void linsig_init(void);
+
+/** Upload a signal database
+ *
+ * Replaces the current database, the values of the previous database are discarded.
+ *
+ * @param[in]  blob  database in the upload format.
+ * @param[in]  length  length of the blob.
+ * @retval  ESP_OK  database is loaded.
+ * @retval  ESP_ERR_INVALID_ARG  upload is invalid.
+ * @retval  ESP_ERR_NO_MEM  not enough memory to store the database.
+ */
+esp_err_t linsig_upload(const uint8_t *blob, size_t length);
+
+/** Find a signal by its name
+ *
+ * @param[in]  name  name of the signal.
+ * @returns  index of the signal, or -1 when the signal is not in the database.
+ */
+int linsig_find(const char *name);
+
+/** Get the name of a signal
+ *
+ * @param[in]  index  index of the signal.
+ * @param[out]  name  buffer for the name (LINSIG_NAME_LEN bytes).
+ * @retval  true  name holds the name of the signal.
+ * @retval  false  index is invalid.
+ */
+bool linsig_get_name(uint16_t index, char *name);
+
+/** Get the last value of a signal
+ *
+ * @param[in]  index  index of the signal.
+ * @param[out]  value  last value of the signal.
+ * @retval  true  value holds the last value.
+ * @retval  false  index is invalid or no value was received yet.
+ */
+bool linsig_get_value(uint16_t index, linsig_value_t *value);
+
+/** Get the generation of the database
+ *
+ * @returns  number of uploads since the start.
+ */
+uint32_t linsig_generation(void);
+
+/** Get the status of the signal decoding
+ *
+ * @param[out]  status  status of the signal decoding.
+ */
+void linsig_get_status(linsig_status_t *status);
+
+/** Register a signal change listener
+ *
+ * A listener which is registered already with the same context stays registered once.
+ *
+ * @param[in]  listener  listener to register.
+ * @param[in]  ctx  context pointer passed to the listener.
+ * @retval  ESP_OK  listener is registered (or was registered already).
+ * @retval  ESP_ERR_NO_MEM  maximum number of listeners is reached.
+ */
+esp_err_t linsig_add_listener(linsig_listener_t listener, void *ctx);
+
+/** Unregister a signal change listener
+ *
+ * @param[in]  listener  listener to unregister.
+ * @param[in]  ctx  context pointer as passed during registration.
+ */
+void linsig_remove_listener(linsig_listener_t listener, void *ctx);
+
+#endif /* LIN_SIGNAL_H_ */
@@ -0,0 +1,181 @@
+/**
+ * @file
+ * @brief LIN signal database definitions.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the definitions of the signal database, the compiled form of the
+ * frames and signals of an LDF which is uploaded to the device.
+ *
+ * The upload format is little endian and consists of:
+ * - a header (linsig_blob_header_t).
+ * - nr_of_frames frame descriptions (linsig_blob_frame_t).
+ * - nr_of_signals signal descriptions (linsig_blob_signal_t), in the order of the frames, each frame
+ *   taking the next nr_of_signals signals of its description.
+ *
+ * During loading the extraction shift and mask of every signal are precomputed. A received frame is
+ * loaded once into a 64 bit word (LIN sends the least significant bit of byte 0 first), after which
+ * each raw signal value is a shift and a mask. The database keeps the last raw value of every signal
+ * and marks the signals of which the value changed.
+ *
+ * This part has no dependencies on the ESP-IDF such that it can be built and tested on the host.
+ */
+
+#ifndef LIN_SIGNAL_DB_H_
+    #define LIN_SIGNAL_DB_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** version of the upload format */
+#define LINSIG_FORMAT_VERSION 1u
+
+/** maximum number of frames in the database */
+#define LINSIG_MAX_FRAMES 64u
+
+/** maximum number of signals in the database */
+#define LINSIG_MAX_SIGNALS 256u
+
+/** size of a signal name including the terminating zero */
+#define LINSIG_NAME_LEN 20u
+
+/** maximum width of a signal in bits */
+#define LINSIG_MAX_WIDTH 32u
+
+/** frame index used for frame identifiers which are not in the database */
+#define LINSIG_NO_FRAME 0xFFu
+
+/** signal encoding enum */
+typedef enum linsig_encoding_e {
+    LINSIG_ENCODING_RAW = 0,                    /**< raw value (logical values, byte arrays) */
+    LINSIG_ENCODING_PHYSICAL = 1,               /**< physical value = raw * factor + offset */
+} linsig_encoding_t;                            /**< signal encoding type */
+
+/** upload format: header */
+typedef struct linsig_blob_header_s {
+    uint8_t version;                            /**< LINSIG_FORMAT_VERSION */
+    uint8_t nr_of_frames;                       /**< number of frame descriptions */
+    uint16_t nr_of_signals;                     /**< number of signal descriptions */
+} linsig_blob_header_t;
+
+/** upload format: frame description */
+typedef struct linsig_blob_frame_s {
+    uint8_t frameid;                            /**< frame identifier (0..63) */
+    uint8_t datalength;                         /**< number of data bytes (1..8) */
+    uint8_t nr_of_signals;                      /**< number of signals in the frame */
+    uint8_t reserved;
+} linsig_blob_frame_t;
+
+/** upload format: signal description */
+typedef struct linsig_blob_signal_s {
+    char name[LINSIG_NAME_LEN];                 /**< zero terminated signal name */
+    uint8_t start_bit;                          /**< bit offset of the signal in the frame */
+    uint8_t width;                              /**< width of the signal in bits (1..32) */
+    uint8_t encoding;                           /**< signal encoding (linsig_encoding_t) */
+    uint8_t reserved;
+    float factor;                               /**< scaling factor of a physical value */
+    float offset;                               /**< offset of a physical value */
+} linsig_blob_signal_t;
+
+/** compiled signal */
+typedef struct linsig_signal_s {
+    char name[LINSIG_NAME_LEN];                 /**< zero terminated signal name */
+    uint32_t mask;                              /**< mask of the raw value after shifting */
+    float factor;                               /**< scaling factor of a physical value */
+    float offset;                               /**< offset of a physical value */
+    uint8_t shift;                              /**< bit offset of the signal in the frame */
+    uint8_t frame;                              /**< index of the frame holding the signal */
+    uint8_t encoding;                           /**< signal encoding (linsig_encoding_t) */
+    uint8_t reserved;
+} linsig_signal_t;
+
+/** compiled frame */
+typedef struct linsig_frame_s {
+    uint8_t frameid;                            /**< frame identifier */
+    uint8_t datalength;                         /**< number of data bytes */
+    uint16_t first_signal;                      /**< index of the first signal of the frame */
+    uint16_t nr_of_signals;                     /**< number of signals in the frame */
+} linsig_frame_t;
+
+/** decoded signal value */
+typedef struct linsig_value_s {
+    uint16_t index;                             /**< index of the signal in the database */
+    uint8_t frameid;                            /**< frame identifier holding the signal */
+    uint8_t encoding;                           /**< signal encoding (linsig_encoding_t) */
+    uint32_t raw;                               /**< raw value */
+    float value;                                /**< physical value (raw value for raw signals) */
+} linsig_value_t;
+
+/** signal database */
+typedef struct linsig_db_s {
+    uint16_t nr_of_signals;                     /**< number of signals */
+    uint8_t nr_of_frames;                       /**< number of frames */
+    uint8_t frame_of_id[LINSIG_MAX_FRAMES];     /**< frame index per frame identifier, or LINSIG_NO_FRAME */
+    linsig_frame_t frames[LINSIG_MAX_FRAMES];
+    linsig_signal_t signals[LINSIG_MAX_SIGNALS];
+    uint32_t raw[LINSIG_MAX_SIGNALS];           /**< last raw value per signal */
+    uint32_t valid[LINSIG_MAX_SIGNALS / 32u];   /**< bitmap of the signals of which a value was received */
+    uint32_t changed[LINSIG_MAX_SIGNALS / 32u]; /**< bitmap of the signals changed since the last collection */
+} linsig_db_t;
+
+/** Load a database from the upload format
+ *
+ * @param[out]  db  database to load, empty when the upload is invalid.
+ * @param[in]  blob  database in the upload format.
+ * @param[in]  length  length of the blob.
+ * @retval  true  database is loaded.
+ * @retval  false  upload is invalid.
+ */
+bool linsig_db_load(linsig_db_t *db, const uint8_t *blob, size_t length);
+
+/** Find a signal by its name
+ *
+ * @param[in]  db  database.
+ * @param[in]  name  name of the signal.
+ * @returns  index of the signal, or -1 when the signal is not in the database.
+ */
+int linsig_db_find(const linsig_db_t *db, const char *name);
+
+/** Decode a received frame
+ *
+ * @param[in|out]  db  database.
+ * @param[in]  frameid  frame identifier.
+ * @param[in]  data  received data.
+ * @param[in]  datalength  number of received bytes, must match the frame description.
+ * @returns  number of signals of which the value changed.
+ */
+size_t linsig_db_update(linsig_db_t *db, uint8_t frameid, const uint8_t *data, uint8_t datalength);
+
+/** Get the last value of a signal
+ *
+ * @param[in]  db  database.
+ * @param[in]  index  index of the signal.
+ * @param[out]  value  last value of the signal.
+ * @retval  true  value holds the last value.
+ * @retval  false  index is invalid or no value was received yet.
+ */
+bool linsig_db_value(const linsig_db_t *db, uint16_t index, linsig_value_t *value);
+
+/** Collect the signals which changed since the last collection
+ *
+ * @param[in|out]  db  database, the changed marks of the collected signals are cleared.
+ * @param[out]  values  values of the changed signals, in order of their index.
+ * @param[in]  max  maximum number of values to collect.
+ * @returns  number of collected values.
+ */
+size_t linsig_db_collect(linsig_db_t *db, linsig_value_t *values, size_t max);
+
+#endif /* LIN_SIGNAL_DB_H_ */
@@ -0,0 +1,247 @@
+/**
+ * @file
+ * @brief LIN signal decoding.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the implementations of the on-device signal decoding.
+ *
+ * The reporting task polls the last-value cache for the frames in the database. A frame is decoded
+ * when its receive count changed since the previous poll, as such the decoding does not add any
+ * load to the tasks handling the bus.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_err.h"
+#include "esp_log.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+#include "sdkconfig.h"
+
+#include "lin_cache.h"
+
+#include "lin_signal.h"
+
+/** maximum number of signal change listeners */
+#define LINSIG_MAX_LISTENERS 4u
+
+/** maximum number of values handed over to the listeners at once */
+#define LINSIG_REPORT_BATCH 64u
+
+static const char *TAG = "lin-signal";
+
+typedef struct linsig_listener_entry_s {
+    linsig_listener_t listener;                 /**< registered listener, or NULL */
+    void *ctx;                                  /**< context for the listener */
+} linsig_listener_entry_t;
+
+static linsig_db_t *db = NULL;
+static uint32_t last_count[LINSIG_MAX_FRAMES];
+static linsig_status_t status;
+
+static SemaphoreHandle_t db_lock = NULL;
+static SemaphoreHandle_t listener_lock = NULL;
+static linsig_listener_entry_t listeners[LINSIG_MAX_LISTENERS];
+
+/** Decode the frames which were received since the previous poll
+ *
+ * Must be called with the database lock taken.
+ */
+static void linsig_poll_cache(void);
+
+/** Signal reporting task
+ *
+ * @param[in]  arg  task argument (not used).
+ */
+static void linsig_report_task(void *arg);
+
+
+static void linsig_poll_cache(void) {
+    lincache_entry_t entry;
+
+    for (uint8_t frame = 0u; frame < db->nr_of_frames; frame++) {
+        if (lincache_get(db->frames[frame].frameid, &entry) && (entry.count != last_count[frame])) {
+            last_count[frame] = entry.count;
+            status.changes += linsig_db_update(db, entry.frameid, entry.data, entry.datalength);
+            status.frames_decoded++;
+        }
+    }
+}
+
+static void linsig_report_task(void *arg) {
+    (void)arg;
+    static linsig_value_t values[LINSIG_REPORT_BATCH];
+
+    while (1) {
+        vTaskDelay(pdMS_TO_TICKS(CONFIG_LIN_SIGNAL_REPORT_INTERVAL));
+
+        size_t nr_of_values;
+        do {
+            uint32_t generation;
+
+            (void)xSemaphoreTake(db_lock, portMAX_DELAY);
+            nr_of_values = 0u;
+            if (db != NULL) {
+                linsig_poll_cache();
+                nr_of_values = linsig_db_collect(db, values, LINSIG_REPORT_BATCH);
+            }
+            generation = status.generation;
+            (void)xSemaphoreGive(db_lock);
+
+            if (nr_of_values > 0u) {
+                (void)xSemaphoreTake(listener_lock, portMAX_DELAY);
+                for (size_t i = 0; i < LINSIG_MAX_LISTENERS; i++) {
+                    if (listeners[i].listener != NULL) {
+                        listeners[i].listener(values, nr_of_values, generation, listeners[i].ctx);
+                    }
+                }
+                (void)xSemaphoreGive(listener_lock);
+            }
+        } while (nr_of_values == LINSIG_REPORT_BATCH);
+    }
+}
+
+void linsig_init(void) {
+    memset(listeners, 0, sizeof(listeners));
+    memset(&status, 0, sizeof(status));
+
+    db_lock = xSemaphoreCreateMutex();
+    listener_lock = xSemaphoreCreateMutex();
+
+    xTaskCreate(linsig_report_task, "lin_signal_task", 2048 * 2, NULL, CONFIG_LIN_SIGNAL_TASK_PRIORITY, NULL);
+}
+
+esp_err_t linsig_upload(const uint8_t *blob, size_t length) {
+    esp_err_t retval = ESP_OK;
+
+    linsig_db_t *loaded = malloc(sizeof(linsig_db_t));
+    if (loaded == NULL) {
+        retval = ESP_ERR_NO_MEM;
+    } else if (!linsig_db_load(loaded, blob, length)) {
+        retval = ESP_ERR_INVALID_ARG;
+    }
+
+    if (retval == ESP_OK) {
+        (void)xSemaphoreTake(db_lock, portMAX_DELAY);
+        free(db);
+        db = loaded;
+        loaded = NULL;
+        /* decode the responses which are already in the cache at the next poll */
+        memset(last_count, 0, sizeof(last_count));
+        status.nr_of_signals = db->nr_of_signals;
+        status.nr_of_frames = db->nr_of_frames;
+        status.generation++;
+        status.frames_decoded = 0u;
+        status.changes = 0u;
+        (void)xSemaphoreGive(db_lock);
+        ESP_LOGI(TAG, "database uploaded with %u frames and %u signals", status.nr_of_frames, status.nr_of_signals);
+    }
+
+    free(loaded);
+
+    return retval;
+}
+
+int linsig_find(const char *name) {
+    int retval = -1;
+
+    (void)xSemaphoreTake(db_lock, portMAX_DELAY);
+    if (db != NULL) {
+        retval = linsig_db_find(db, name);
+    }
+    (void)xSemaphoreGive(db_lock);
+
+    return retval;
+}
+
+bool linsig_get_name(uint16_t index, char *name) {
+    bool retval = false;
+
+    (void)xSemaphoreTake(db_lock, portMAX_DELAY);
+    if ((db != NULL) && (index < db->nr_of_signals)) {
+        memcpy(name, db->signals[index].name, LINSIG_NAME_LEN);
+        retval = true;
+    }
+    (void)xSemaphoreGive(db_lock);
+
+    return retval;
+}
+
+bool linsig_get_value(uint16_t index, linsig_value_t *value) {
+    bool retval = false;
+
+    (void)xSemaphoreTake(db_lock, portMAX_DELAY);
+    if (db != NULL) {
+        retval = linsig_db_value(db, index, value);
+    }
+    (void)xSemaphoreGive(db_lock);
+
+    return retval;
+}
+
+uint32_t linsig_generation(void) {
+    (void)xSemaphoreTake(db_lock, portMAX_DELAY);
+    uint32_t retval = status.generation;
+    (void)xSemaphoreGive(db_lock);
+
+    return retval;
+}
+
+void linsig_get_status(linsig_status_t *result) {
+    (void)xSemaphoreTake(db_lock, portMAX_DELAY);
+    memcpy(result, &status, sizeof(linsig_status_t));
+    (void)xSemaphoreGive(db_lock);
+}
+
+esp_err_t linsig_add_listener(linsig_listener_t listener, void *ctx) {
+    esp_err_t retval = ESP_ERR_NO_MEM;
+
+    (void)xSemaphoreTake(listener_lock, portMAX_DELAY);
+    size_t free_slot = LINSIG_MAX_LISTENERS;
+    for (size_t i = 0; i < LINSIG_MAX_LISTENERS; i++) {
+        if ((listeners[i].listener == listener) && (listeners[i].ctx == ctx)) {
+            /* registered already, e.g. by a previous enable of the interface */
+            retval = ESP_OK;
+        } else if ((listeners[i].listener == NULL) && (free_slot == LINSIG_MAX_LISTENERS)) {
+            free_slot = i;
+        }
+    }
+    if ((retval != ESP_OK) && (free_slot < LINSIG_MAX_LISTENERS)) {
+        listeners[free_slot].listener = listener;
+        listeners[free_slot].ctx = ctx;
+        retval = ESP_OK;
+    }
+    (void)xSemaphoreGive(listener_lock);
+
+    return retval;
+}
+
+void linsig_remove_listener(linsig_listener_t listener, void *ctx) {
+    (void)xSemaphoreTake(listener_lock, portMAX_DELAY);
+    for (size_t i = 0; i < LINSIG_MAX_LISTENERS; i++) {
+        if ((listeners[i].listener == listener) && (listeners[i].ctx == ctx)) {
+            listeners[i].listener = NULL;
+            listeners[i].ctx = NULL;
+        }
+    }
+    (void)xSemaphoreGive(listener_lock);
+}
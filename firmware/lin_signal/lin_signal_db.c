@@ -0,0 +1,220 @@
+/**
+ * @file
+ * @brief LIN signal database routines.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the implementations of the signal database.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lin_signal_db.h"
+
+/** Check whether a bit is set in a signal bitmap */
+#define LINSIG_BIT_TEST(map, index) (((map)[(index) >> 5] & (1u << ((index) & 31u))) != 0u)
+
+/** Set a bit in a signal bitmap */
+#define LINSIG_BIT_SET(map, index) ((map)[(index) >> 5] |= (1u << ((index) & 31u)))
+
+/** Compile a signal description
+ *
+ * @param[out]  signal  compiled signal.
+ * @param[in]  blob_signal  signal description.
+ * @param[in]  frame  index of the frame holding the signal.
+ * @param[in]  datalength  number of data bytes of the frame.
+ * @retval  true  signal is valid.
+ * @retval  false  signal does not fit in the frame or has an invalid name or encoding.
+ */
+static bool linsig_compile_signal(linsig_signal_t *signal,
+                                  const linsig_blob_signal_t *blob_signal,
+                                  uint8_t frame,
+                                  uint8_t datalength);
+
+/** Calculate the value of a signal from its raw value
+ *
+ * @param[in]  db  database.
+ * @param[in]  index  index of the signal.
+ * @param[out]  value  value of the signal.
+ */
+static void linsig_fill_value(const linsig_db_t *db, uint16_t index, linsig_value_t *value);
+
+
+static bool linsig_compile_signal(linsig_signal_t *signal,
+                                  const linsig_blob_signal_t *blob_signal,
+                                  uint8_t frame,
+                                  uint8_t datalength) {
+    bool retval = (blob_signal->name[0] != '\0') &&
+                  (memchr(blob_signal->name, '\0', LINSIG_NAME_LEN) != NULL) &&
+                  (blob_signal->width > 0u) && (blob_signal->width <= LINSIG_MAX_WIDTH) &&
+                  (((uint16_t)blob_signal->start_bit + blob_signal->width) <= ((uint16_t)datalength * 8u)) &&
+                  (blob_signal->encoding <= LINSIG_ENCODING_PHYSICAL);
+
+    if (retval) {
+        memcpy(signal->name, blob_signal->name, LINSIG_NAME_LEN);
+        signal->mask = (blob_signal->width == 32u) ? UINT32_MAX : ((1u << blob_signal->width) - 1u);
+        signal->factor = blob_signal->factor;
+        signal->offset = blob_signal->offset;
+        signal->shift = blob_signal->start_bit;
+        signal->frame = frame;
+        signal->encoding = blob_signal->encoding;
+        signal->reserved = 0u;
+    }
+
+    return retval;
+}
+
+static void linsig_fill_value(const linsig_db_t *db, uint16_t index, linsig_value_t *value) {
+    const linsig_signal_t *signal = &db->signals[index];
+
+    value->index = index;
+    value->frameid = db->frames[signal->frame].frameid;
+    value->encoding = signal->encoding;
+    value->raw = db->raw[index];
+    if (signal->encoding == LINSIG_ENCODING_PHYSICAL) {
+        value->value = ((float)value->raw * signal->factor) + signal->offset;
+    } else {
+        value->value = (float)value->raw;
+    }
+}
+
+bool linsig_db_load(linsig_db_t *db, const uint8_t *blob, size_t length) {
+    linsig_blob_header_t header;
+    bool retval = (length >= sizeof(header));
+
+    memset(&header, 0, sizeof(header));
+    memset(db, 0, sizeof(linsig_db_t));
+    memset(db->frame_of_id, LINSIG_NO_FRAME, sizeof(db->frame_of_id));
+
+    if (retval) {
+        memcpy(&header, blob, sizeof(header));
+        retval = (header.version == LINSIG_FORMAT_VERSION) &&
+                 (header.nr_of_frames <= LINSIG_MAX_FRAMES) &&
+                 (header.nr_of_signals <= LINSIG_MAX_SIGNALS) &&
+                 (length == (sizeof(header) +
+                             (header.nr_of_frames * sizeof(linsig_blob_frame_t)) +
+                             (header.nr_of_signals * sizeof(linsig_blob_signal_t))));
+    }
+
+    const uint8_t *blob_frames = &blob[sizeof(header)];
+    const uint8_t *blob_signals = &blob_frames[header.nr_of_frames * sizeof(linsig_blob_frame_t)];
+    uint16_t nr_of_signals = 0u;
+
+    for (uint8_t frame = 0u; retval && (frame < header.nr_of_frames); frame++) {
+        /* the blob is not necessarily aligned, copy the descriptions before use */
+        linsig_blob_frame_t blob_frame;
+        memcpy(&blob_frame, &blob_frames[frame * sizeof(linsig_blob_frame_t)], sizeof(blob_frame));
+
+        retval = (blob_frame.frameid < LINSIG_MAX_FRAMES) &&
+                 (db->frame_of_id[blob_frame.frameid] == LINSIG_NO_FRAME) &&
+                 (blob_frame.datalength > 0u) && (blob_frame.datalength <= 8u) &&
+                 ((nr_of_signals + blob_frame.nr_of_signals) <= header.nr_of_signals);
+
+        if (retval) {
+            db->frame_of_id[blob_frame.frameid] = frame;
+            db->frames[frame].frameid = blob_frame.frameid;
+            db->frames[frame].datalength = blob_frame.datalength;
+            db->frames[frame].first_signal = nr_of_signals;
+            db->frames[frame].nr_of_signals = blob_frame.nr_of_signals;
+        }
+
+        for (uint8_t i = 0u; retval && (i < blob_frame.nr_of_signals); i++) {
+            linsig_blob_signal_t blob_signal;
+            memcpy(&blob_signal, &blob_signals[nr_of_signals * sizeof(linsig_blob_signal_t)], sizeof(blob_signal));
+            retval = linsig_compile_signal(&db->signals[nr_of_signals], &blob_signal, frame, blob_frame.datalength) &&
+                     (linsig_db_find(db, blob_signal.name) < 0);
+            nr_of_signals++;
+            db->nr_of_signals = nr_of_signals;
+        }
+    }
+
+    if (retval && (nr_of_signals == header.nr_of_signals)) {
+        db->nr_of_frames = header.nr_of_frames;
+        db->nr_of_signals = nr_of_signals;
+    } else {
+        memset(db, 0, sizeof(linsig_db_t));
+        memset(db->frame_of_id, LINSIG_NO_FRAME, sizeof(db->frame_of_id));
+        retval = false;
+    }
+
+    return retval;
+}
+
+int linsig_db_find(const linsig_db_t *db, const char *name) {
+    int retval = -1;
+
+    for (uint16_t i = 0u; i < db->nr_of_signals; i++) {
+        if (strncmp(db->signals[i].name, name, LINSIG_NAME_LEN) == 0) {
+            retval = (int)i;
+            break;
+        }
+    }
+
+    return retval;
+}
+
+size_t linsig_db_update(linsig_db_t *db, uint8_t frameid, const uint8_t *data, uint8_t datalength) {
+    size_t retval = 0u;
+    uint8_t frame = (frameid < LINSIG_MAX_FRAMES) ? db->frame_of_id[frameid] : LINSIG_NO_FRAME;
+
+    if ((frame != LINSIG_NO_FRAME) && (db->frames[frame].datalength == datalength)) {
+        uint64_t word = 0u;
+        for (uint8_t i = datalength; i > 0u; i--) {
+            word = (word << 8) | data[i - 1u];
+        }
+
+        uint16_t end = db->frames[frame].first_signal + db->frames[frame].nr_of_signals;
+        for (uint16_t index = db->frames[frame].first_signal; index < end; index++) {
+            const linsig_signal_t *signal = &db->signals[index];
+            uint32_t raw = (uint32_t)(word >> signal->shift) & signal->mask;
+
+            if (!LINSIG_BIT_TEST(db->valid, index) || (db->raw[index] != raw)) {
+                db->raw[index] = raw;
+                LINSIG_BIT_SET(db->valid, index);
+                LINSIG_BIT_SET(db->changed, index);
+                retval++;
+            }
+        }
+    }
+
+    return retval;
+}
+
+bool linsig_db_value(const linsig_db_t *db, uint16_t index, linsig_value_t *value) {
+    bool retval = (index < db->nr_of_signals) && LINSIG_BIT_TEST(db->valid, index);
+
+    if (retval) {
+        linsig_fill_value(db, index, value);
+    }
+
+    return retval;
+}
+
+size_t linsig_db_collect(linsig_db_t *db, linsig_value_t *values, size_t max) {
+    size_t count = 0u;
+
+    for (uint16_t word = 0u; (word < (LINSIG_MAX_SIGNALS / 32u)) && (count < max); word++) {
+        while ((db->changed[word] != 0u) && (count < max)) {
+            uint16_t index = (uint16_t)((word * 32u) + (uint16_t)__builtin_ctz(db->changed[word]));
+            db->changed[word] &= db->changed[word] - 1u;
+            linsig_fill_value(db, index, &values[count]);
+            count++;
+        }
+    }
+
+    return count;
+}
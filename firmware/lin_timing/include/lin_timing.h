@@ -0,0 +1,92 @@
+/**
+ * @file
+ * @brief LIN frame timing definitions.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the definitions of the frame timing instrumentation.
+ *
+ * All frames of the front ends, the schedule executor and the transport layer go through
+ * lintiming_send_m2s and lintiming_send_s2m, which time the LIN master call and record the duration
+ * per frame identifier (see lin_timing_stats.h). With CONFIG_LIN_TIMING_PHASES the bus echo is
+ * received during the frame as well, which splits the frame in its phases (break, sync field,
+ * response space, inter-byte space, ...).
+ */
+
+#ifndef LIN_TIMING_H_
+    #define LIN_TIMING_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "lin_err.h"
+
+#include "lin_timing_stats.h"
+
+/** initialize the LIN frame timing module */
+void lintiming_init(void);
+
+/** Handle a master to slave frame on the bus and record its duration
+ *
+ * The caller has to own the bus, see linmaster_send_m2s.
+ *
+ * @param[in]  baudrate  baudrate to use.
+ * @param[in]  enhanced_crc  true: use enhanced checksum.
+ * @param[in]  frameid  frame identifier.
+ * @param[in]  data  data to send.
+ * @param[in]  datalength  number of data bytes to send.
+ * @returns  lin error code of the transaction.
+ */
+lin_err_t lintiming_send_m2s(uint16_t baudrate,
+                             bool enhanced_crc,
+                             uint8_t frameid,
+                             const uint8_t *data,
+                             uint8_t datalength);
+
+/** Handle a slave to master frame on the bus and record its duration
+ *
+ * The caller has to own the bus, see linmaster_send_s2m.
+ *
+ * @param[in]  baudrate  baudrate to use.
+ * @param[in]  enhanced_crc  true: use enhanced checksum.
+ * @param[in]  frameid  frame identifier.
+ * @param[out]  data  received data.
+ * @param[in]  datalength  number of data bytes to receive.
+ * @returns  lin error code of the transaction.
+ */
+lin_err_t lintiming_send_s2m(uint16_t baudrate, bool enhanced_crc, uint8_t frameid, uint8_t *data, uint8_t datalength);
+
+/** Get the timing statistics of a frame identifier
+ *
+ * @param[in]  frameid  frame identifier (0..63).
+ * @param[out]  entry  statistics of the frame.
+ * @retval  true  entry holds the statistics.
+ * @retval  false  frame identifier is invalid or no frame was recorded for it.
+ */
+bool lintiming_get(uint8_t frameid, lintiming_entry_t *entry);
+
+/** Get the phase statistics of a frame identifier
+ *
+ * @param[in]  frameid  frame identifier (0..63).
+ * @param[out]  entry  phase statistics of the frame.
+ * @retval  true  entry holds the phase statistics.
+ * @retval  false  frame identifier is invalid or no phases were recorded for it.
+ */
+bool lintiming_get_phases(uint8_t frameid, lintiming_phase_entry_t *entry);
+
+/** Clear the timing statistics of all frames */
+void lintiming_clear(void);
+
+#endif /* LIN_TIMING_H_ */
@@ -0,0 +1,250 @@
+/**
+ * @file
+ * @brief LIN frame timing statistics definitions.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the definitions of the per frame identifier timing statistics.
+ *
+ * The duration of every frame handled by the LIN master is compared with its nominal duration as
+ * defined by the LIN specification for the baudrate and data length:
+ * - header: 34 bit times (break, break delimiter, sync and protected identifier).
+ * - response: 10 * (N + 1) bit times (N data bytes and the checksum).
+ * - maximum frame time: 1.4 times the nominal frame time.
+ *
+ * The time above the nominal frame time holds the response space, the inter-byte spaces and the
+ * latency added by the firmware. It is aggregated per frame identifier in a histogram, the frames
+ * which exceed the maximum frame time are counted separately.
+ *
+ * When the bus echo is captured during the frame, the frame is also split in phases (see
+ * lintiming_phase_t) which are aggregated per frame identifier as well. The receiver only time stamps
+ * the detection of the break field and the end of every byte, the start of a byte is taken one byte
+ * time (10 bit times) before its end.
+ *
+ * This part has no dependencies on the ESP-IDF such that it can be built and tested on the host.
+ */
+
+#ifndef LIN_TIMING_STATS_H_
+    #define LIN_TIMING_STATS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** number of frame identifiers */
+#define LINTIMING_NR_OF_FRAMES 64u
+
+/** number of histogram bins */
+#define LINTIMING_HISTOGRAM_BINS 8u
+
+/** upper limits (us, exclusive) of the histogram bins of the time above nominal, the last bin is open */
+#define LINTIMING_HISTOGRAM_LIMITS {50u, 100u, 200u, 500u, 1000u, 2000u, 5000u, UINT32_MAX}
+
+/** timing statistics of one frame identifier (64 bytes, the entries of all frames fit in one bulk response) */
+typedef struct lintiming_entry_s {
+    uint32_t count;                             /**< number of frames measured */
+    uint32_t errors;                            /**< number of frames which failed */
+    uint32_t min_us;                            /**< shortest frame duration (us) */
+    uint32_t max_us;                            /**< longest frame duration (us) */
+    uint32_t avg_us;                            /**< average frame duration (us) */
+    uint32_t nominal_us;                        /**< nominal duration of the last frame (us) */
+    uint32_t over_max;                          /**< number of frames exceeding the maximum frame time */
+    uint32_t histogram[LINTIMING_HISTOGRAM_BINS];  /**< frames per bin of time above nominal */
+    uint8_t frameid;                            /**< frame identifier */
+    uint8_t datalength;                         /**< data length of the last frame */
+    uint16_t baudrate;                          /**< baudrate of the last frame */
+} lintiming_entry_t;
+
+/** maximum number of bytes of a frame echo (sync, protected identifier, 8 data bytes and the checksum) */
+#define LINTIMING_ECHO_MAX_BYTES 11u
+
+/** frame phases */
+typedef enum lintiming_phase_e {
+    LINTIMING_PHASE_SETUP = 0,                  /**< start of the transaction to the start of the break field */
+    LINTIMING_PHASE_BREAK,                      /**< break field and break delimiter */
+    LINTIMING_PHASE_SYNC,                       /**< sync field and the space up to the protected identifier */
+    LINTIMING_PHASE_HEADER,                     /**< start of the break field to the end of the protected identifier */
+    LINTIMING_PHASE_RESPONSE_SPACE,             /**< end of the protected identifier to the start of the response */
+    LINTIMING_PHASE_INTERBYTE,                  /**< longest space between two bytes of the response */
+    LINTIMING_PHASE_RESPONSE,                   /**< start of the response to the end of the checksum */
+    LINTIMING_PHASE_COMPLETION,                 /**< end of the checksum to the end of the transaction */
+    LINTIMING_NR_OF_PHASES
+} lintiming_phase_t;
+
+/** bus echo of a frame, times are relative to the start of the transaction */
+typedef struct lintiming_echo_s {
+    uint32_t break_us;                          /**< start of the break field (us) */
+    uint32_t byte_us[LINTIMING_ECHO_MAX_BYTES]; /**< end of every byte from the sync field on (us) */
+    uint8_t bytes[LINTIMING_ECHO_MAX_BYTES];    /**< received bytes from the sync field on */
+    uint8_t count;                              /**< number of received bytes */
+    bool break_seen;                            /**< break field was received */
+} lintiming_echo_t;
+
+/** time stamps of the phases of a frame, relative to the start of the transaction (24 bytes) */
+typedef struct lintiming_timestamps_s {
+    uint32_t break_us;                          /**< start of the break field (us) */
+    uint32_t sync_us;                           /**< end of the sync field (us) */
+    uint32_t pid_us;                            /**< end of the protected identifier (us) */
+    uint32_t response_us;                       /**< start of the response (us) */
+    uint32_t checksum_us;                       /**< end of the checksum (us) */
+    uint32_t end_us;                            /**< end of the transaction (us) */
+} lintiming_timestamps_t;
+
+/** phases of one frame */
+typedef struct lintiming_phases_s {
+    lintiming_timestamps_t timestamps;          /**< phase time stamps */
+    uint32_t duration_us[LINTIMING_NR_OF_PHASES];  /**< phase durations (us) */
+} lintiming_phases_t;
+
+/** statistics of one phase duration */
+typedef struct lintiming_range_s {
+    uint32_t min_us;                            /**< shortest duration (us) */
+    uint32_t avg_us;                            /**< average duration (us) */
+    uint32_t max_us;                            /**< longest duration (us) */
+} lintiming_range_t;
+
+/** phase statistics of one frame identifier (132 bytes) */
+typedef struct lintiming_phase_entry_s {
+    uint32_t count;                             /**< number of frames of which the phases were measured */
+    uint32_t missed;                            /**< number of frames without a complete bus echo */
+    lintiming_range_t phases[LINTIMING_NR_OF_PHASES];  /**< statistics per lintiming_phase_t */
+    lintiming_timestamps_t last;                /**< phase time stamps of the last measured frame */
+    uint8_t frameid;                            /**< frame identifier */
+    uint8_t reserved[3];
+} lintiming_phase_entry_t;
+
+/** timing statistics slot of one frame identifier */
+typedef struct lintiming_slot_s {
+    lintiming_entry_t entry;                    /**< statistics, avg_us is calculated on reading */
+    uint64_t sum_us;                            /**< sum of the frame durations (us) */
+    lintiming_phase_entry_t phases;             /**< phase statistics, avg_us is calculated on reading */
+    uint64_t phase_sum_us[LINTIMING_NR_OF_PHASES];  /**< sum of the phase durations (us) */
+} lintiming_slot_t;
+
+/** timing statistics of all frame identifiers */
+typedef struct lintiming_stats_s {
+    lintiming_slot_t slots[LINTIMING_NR_OF_FRAMES];
+} lintiming_stats_t;
+
+/** Calculate the nominal header and response durations of a frame
+ *
+ * @param[in]  baudrate  baudrate of the frame.
+ * @param[in]  datalength  number of data bytes.
+ * @param[out]  header_us  nominal header duration (us).
+ * @param[out]  response_us  nominal response duration (us).
+ */
+void lintiming_nominal(uint16_t baudrate, uint8_t datalength, uint32_t *header_us, uint32_t *response_us);
+
+/** Clear all statistics
+ *
+ * @param[out]  stats  statistics to clear.
+ */
+void lintiming_stats_clear(lintiming_stats_t *stats);
+
+/** Record the duration of a frame
+ *
+ * Frames which failed are only counted, their duration is not included in the statistics.
+ *
+ * @param[in|out]  stats  statistics to update.
+ * @param[in]  frameid  frame identifier (0..63).
+ * @param[in]  baudrate  baudrate of the frame.
+ * @param[in]  datalength  number of data bytes.
+ * @param[in]  success  true when the frame was handled without error.
+ * @param[in]  duration_us  duration of the frame (us).
+ */
+void lintiming_stats_record(lintiming_stats_t *stats,
+                            uint8_t frameid,
+                            uint16_t baudrate,
+                            uint8_t datalength,
+                            bool success,
+                            uint32_t duration_us);
+
+/** Get the statistics of a frame identifier
+ *
+ * @param[in]  stats  statistics to read from.
+ * @param[in]  frameid  frame identifier (0..63).
+ * @param[out]  entry  statistics of the frame.
+ * @retval  true  entry holds the statistics.
+ * @retval  false  frame identifier is invalid or no frame was recorded for it.
+ */
+bool lintiming_stats_get(const lintiming_stats_t *stats, uint8_t frameid, lintiming_entry_t *entry);
+
+/** Get the name of a frame phase
+ *
+ * @param[in]  phase  frame phase.
+ * @returns  name of the phase, as used in the json interfaces.
+ */
+const char *lintiming_phase_name(lintiming_phase_t phase);
+
+/** Reset a bus echo
+ *
+ * @param[out]  echo  bus echo to reset.
+ */
+void lintiming_echo_init(lintiming_echo_t *echo);
+
+/** Handle the detection of a break field in the bus echo
+ *
+ * Only the first break field is used, the frame ends at the next break field.
+ *
+ * @param[in|out]  echo  bus echo.
+ * @param[in]  timestamp_us  start of the break field.
+ */
+void lintiming_echo_break(lintiming_echo_t *echo, uint32_t timestamp_us);
+
+/** Handle a received byte of the bus echo
+ *
+ * Bytes before the break field are ignored, as are the bytes before the sync field since the
+ * receiver reports the break field as a zero byte.
+ *
+ * @param[in|out]  echo  bus echo.
+ * @param[in]  byte  received byte.
+ * @param[in]  timestamp_us  end of the byte.
+ */
+void lintiming_echo_byte(lintiming_echo_t *echo, uint8_t byte, uint32_t timestamp_us);
+
+/** Split the bus echo of a frame in its phases
+ *
+ * @param[in]  echo  bus echo of the frame.
+ * @param[in]  baudrate  baudrate of the frame.
+ * @param[in]  datalength  number of data bytes.
+ * @param[in]  end_us  end of the transaction.
+ * @param[out]  phases  phases of the frame.
+ * @retval  true  phases holds the phases of the frame.
+ * @retval  false  the bus echo is incomplete.
+ */
+bool lintiming_phases_analyze(const lintiming_echo_t *echo,
+                              uint16_t baudrate,
+                              uint8_t datalength,
+                              uint32_t end_us,
+                              lintiming_phases_t *phases);
+
+/** Record the phases of a frame
+ *
+ * @param[in|out]  stats  statistics to update.
+ * @param[in]  frameid  frame identifier (0..63).
+ * @param[in]  phases  phases of the frame, NULL when the bus echo of the frame was incomplete.
+ */
+void lintiming_stats_record_phases(lintiming_stats_t *stats, uint8_t frameid, const lintiming_phases_t *phases);
+
+/** Get the phase statistics of a frame identifier
+ *
+ * @param[in]  stats  statistics to read from.
+ * @param[in]  frameid  frame identifier (0..63).
+ * @param[out]  entry  phase statistics of the frame.
+ * @retval  true  entry holds the phase statistics.
+ * @retval  false  frame identifier is invalid or no phases were recorded for it.
+ */
+bool lintiming_stats_get_phases(const lintiming_stats_t *stats, uint8_t frameid, lintiming_phase_entry_t *entry);
+
+#endif /* LIN_TIMING_STATS_H_ */
@@ -0,0 +1,361 @@
+/**
+ * @file
+ * @brief LIN frame timing.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the implementations of the frame timing instrumentation.
+ *
+ * The phases of a frame are taken from the bus echo: a second UART receives the bus while the LIN
+ * master handles the frame, in the same way as the bus monitor does. The echo task installs the UART
+ * driver itself, as such the UART interrupt runs on the same core as the echo task, and the receiver
+ * reports every byte separately which keeps the latency between the end of a byte and its time stamp
+ * low. The time stamp of a break detection is corrected with the time the UART needs to detect the
+ * break.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "esp_timer.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "sdkconfig.h"
+
+#include "lin_err.h"
+#include "lin_master.h"
+
+#include "lin_timing.h"
+
+#if CONFIG_LIN_TIMING_PHASES
+#include "driver/uart.h"
+#include "esp_log.h"
+
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+
+/** number of bit times the UART needs to detect a break field */
+#define LINTIMING_BREAK_DETECT_BITS 10u
+
+/** idle time of the receiver (in symbols) before the received bytes are reported */
+#define LINTIMING_RX_TIMEOUT_SYMBOLS 2u
+
+/** size of the UART receive buffer */
+#define LINTIMING_UART_RX_BUFFER 256u
+
+/** number of UART events which can be queued */
+#define LINTIMING_UART_QUEUE_LEN 32u
+
+/** maximum time to wait for the end of the bus echo after the LIN master finished the frame */
+#define LINTIMING_ECHO_TIMEOUT (pdMS_TO_TICKS(2) + 1u)
+
+static const char *TAG = "lin-timing";
+
+static lintiming_echo_t echo;
+static bool echo_armed = false;
+static bool echo_complete = false;
+static uint8_t echo_expected = 0u;
+static int64_t echo_start = 0;
+static uint16_t echo_baudrate = 0u;
+static portMUX_TYPE echo_lock = portMUX_INITIALIZER_UNLOCKED;
+static SemaphoreHandle_t echo_done = NULL;
+static volatile bool echo_ready = false;
+#endif /* CONFIG_LIN_TIMING_PHASES */
+
+static lintiming_stats_t stats;
+static portMUX_TYPE stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+#if CONFIG_LIN_TIMING_PHASES
+/** Read the received bytes from the UART into the bus echo
+ *
+ * @param[in]  now  time of the UART event (us).
+ */
+static void lintiming_echo_read(int64_t now);
+
+/** Echo task, receives the bus
+ *
+ * @param[in]  arg  task argument (not used).
+ */
+static void lintiming_echo_task(void *arg);
+
+/** Start capturing the bus echo of a frame
+ *
+ * @param[in]  baudrate  baudrate of the frame.
+ * @param[in]  datalength  number of data bytes.
+ * @param[in]  start  time at the start of the transaction (us).
+ */
+static void lintiming_echo_begin(uint16_t baudrate, uint8_t datalength, int64_t start);
+
+/** Stop capturing the bus echo of a frame
+ *
+ * @param[in]  wait  wait for the end of the bus echo.
+ * @param[out]  result  captured bus echo.
+ */
+static void lintiming_echo_end(bool wait, lintiming_echo_t *result);
+#endif /* CONFIG_LIN_TIMING_PHASES */
+
+/** Record the duration and the phases of a frame
+ *
+ * @param[in]  frameid  frame identifier.
+ * @param[in]  baudrate  baudrate of the frame.
+ * @param[in]  datalength  number of data bytes.
+ * @param[in]  error  lin error code of the transaction.
+ * @param[in]  start  time at the start of the transaction (us).
+ */
+static void lintiming_record(uint8_t frameid, uint16_t baudrate, uint8_t datalength, lin_err_t error, int64_t start);
+
+
+#if CONFIG_LIN_TIMING_PHASES
+static void lintiming_echo_read(int64_t now) {
+    uint8_t buffer[LINTIMING_ECHO_MAX_BYTES + 1u];
+    size_t available = 0u;
+    bool complete = false;
+
+    (void)uart_get_buffered_data_len(CONFIG_LIN_TIMING_ECHO_UART_NUM, &available);
+    while (available > 0u) {
+        size_t chunk = (available < sizeof(buffer)) ? available : sizeof(buffer);
+        int length = uart_read_bytes(CONFIG_LIN_TIMING_ECHO_UART_NUM, buffer, chunk, 0);
+        if (length <= 0) {
+            break;
+        }
+        available -= (size_t)length;
+
+        taskENTER_CRITICAL(&echo_lock);
+        if (echo_armed) {
+            /* the event is for the last byte, the bytes before it were received back to back */
+            int64_t byte_time_us = (10 * 1000000) / echo_baudrate;
+            for (int i = 0; i < length; i++) {
+                int64_t later = (int64_t)(available + (size_t)(length - 1 - i));
+                int64_t timestamp = (now - echo_start) - (later * byte_time_us);
+                lintiming_echo_byte(&echo, buffer[i], (timestamp > 0) ? (uint32_t)timestamp : 0u);
+            }
+            if (!echo_complete && (echo.count >= echo_expected)) {
+                echo_complete = true;
+                complete = true;
+            }
+        }
+        taskEXIT_CRITICAL(&echo_lock);
+    }
+
+    if (complete) {
+        (void)xSemaphoreGive(echo_done);
+    }
+}
+
+static void lintiming_echo_task(void *arg) {
+    (void)arg;
+    QueueHandle_t uart_queue = NULL;
+    uart_event_t event;
+    uart_config_t uart_config = {
+        .baud_rate = 19200,
+        .data_bits = UART_DATA_8_BITS,
+        .parity = UART_PARITY_DISABLE,
+        .stop_bits = UART_STOP_BITS_1,
+        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
+        .source_clk = UART_SCLK_DEFAULT,
+    };
+
+    esp_err_t error = uart_driver_install(CONFIG_LIN_TIMING_ECHO_UART_NUM,
+                                          LINTIMING_UART_RX_BUFFER,
+                                          0,
+                                          LINTIMING_UART_QUEUE_LEN,
+                                          &uart_queue,
+                                          0);
+    if (error == ESP_OK) {
+        error = uart_param_config(CONFIG_LIN_TIMING_ECHO_UART_NUM, &uart_config);
+    }
+    if (error == ESP_OK) {
+        error = uart_set_pin(CONFIG_LIN_TIMING_ECHO_UART_NUM,
+                             UART_PIN_NO_CHANGE,
+                             CONFIG_LIN_TIMING_ECHO_RX_PIN,
+                             UART_PIN_NO_CHANGE,
+                             UART_PIN_NO_CHANGE);
+    }
+    if (error == ESP_OK) {
+        /* report every byte such that its time stamp is taken right after its stop bit */
+        error = uart_set_rx_full_threshold(CONFIG_LIN_TIMING_ECHO_UART_NUM, 1);
+    }
+    if (error == ESP_OK) {
+        error = uart_set_rx_timeout(CONFIG_LIN_TIMING_ECHO_UART_NUM, LINTIMING_RX_TIMEOUT_SYMBOLS);
+    }
+
+    if (error != ESP_OK) {
+        ESP_LOGE(TAG, "receiver setup failed, no frame phases: %s", esp_err_to_name(error));
+        if (uart_is_driver_installed(CONFIG_LIN_TIMING_ECHO_UART_NUM)) {
+            (void)uart_driver_delete(CONFIG_LIN_TIMING_ECHO_UART_NUM);
+        }
+        vTaskDelete(NULL);
+    }
+
+    echo_baudrate = (uint16_t)uart_config.baud_rate;
+    echo_ready = true;
+
+    while (1) {
+        if (xQueueReceive(uart_queue, &event, portMAX_DELAY) == pdTRUE) {
+            int64_t now = esp_timer_get_time();
+            switch (event.type) {
+                case UART_DATA:
+                    lintiming_echo_read(now);
+                    break;
+
+                case UART_BREAK:
+                    /* the bytes before the break belong to the previous frame */
+                    lintiming_echo_read(now);
+                    taskENTER_CRITICAL(&echo_lock);
+                    if (echo_armed) {
+                        int64_t timestamp = (now - echo_start) -
+                                            ((LINTIMING_BREAK_DETECT_BITS * 1000000) / echo_baudrate);
+                        lintiming_echo_break(&echo, (timestamp > 0) ? (uint32_t)timestamp : 0u);
+                    }
+                    taskEXIT_CRITICAL(&echo_lock);
+                    break;
+
+                case UART_FIFO_OVF:
+                case UART_BUFFER_FULL:
+                    (void)uart_flush_input(CONFIG_LIN_TIMING_ECHO_UART_NUM);
+                    (void)xQueueReset(uart_queue);
+                    break;
+
+                default:
+                    break;
+            }
+        }
+    }
+}
+
+static void lintiming_echo_begin(uint16_t baudrate, uint8_t datalength, int64_t start) {
+    if (!echo_ready || (baudrate == 0u)) {
+        return;
+    }
+
+    if (baudrate != echo_baudrate) {
+        (void)uart_set_baudrate(CONFIG_LIN_TIMING_ECHO_UART_NUM, baudrate);
+    }
+    (void)xSemaphoreTake(echo_done, 0);
+
+    taskENTER_CRITICAL(&echo_lock);
+    lintiming_echo_init(&echo);
+    echo_baudrate = baudrate;
+    echo_expected = datalength + 3u;
+    echo_start = start;
+    echo_complete = false;
+    echo_armed = true;
+    taskEXIT_CRITICAL(&echo_lock);
+}
+
+static void lintiming_echo_end(bool wait, lintiming_echo_t *result) {
+    if (!echo_ready) {
+        lintiming_echo_init(result);
+        return;
+    }
+
+    if (wait) {
+        /* the echo task may still be handling the last bytes */
+        (void)xSemaphoreTake(echo_done, LINTIMING_ECHO_TIMEOUT);
+    }
+
+    taskENTER_CRITICAL(&echo_lock);
+    echo_armed = false;
+    memcpy(result, &echo, sizeof(lintiming_echo_t));
+    taskEXIT_CRITICAL(&echo_lock);
+}
+#endif /* CONFIG_LIN_TIMING_PHASES */
+
+static void lintiming_record(uint8_t frameid, uint16_t baudrate, uint8_t datalength, lin_err_t error, int64_t start) {
+    uint32_t duration = (uint32_t)(esp_timer_get_time() - start);
+#if CONFIG_LIN_TIMING_PHASES
+    lintiming_echo_t frame_echo;
+    lintiming_phases_t phases;
+    bool measured = false;
+
+    lintiming_echo_end(error == LIN_OK, &frame_echo);
+    if (error == LIN_OK) {
+        measured = lintiming_phases_analyze(&frame_echo, baudrate, datalength, duration, &phases);
+    }
+#endif /* CONFIG_LIN_TIMING_PHASES */
+
+    taskENTER_CRITICAL(&stats_lock);
+    lintiming_stats_record(&stats, frameid, baudrate, datalength, error == LIN_OK, duration);
+#if CONFIG_LIN_TIMING_PHASES
+    if (echo_ready && (error == LIN_OK)) {
+        lintiming_stats_record_phases(&stats, frameid, measured ? &phases : NULL);
+    }
+#endif /* CONFIG_LIN_TIMING_PHASES */
+    taskEXIT_CRITICAL(&stats_lock);
+}
+
+void lintiming_init(void) {
+    lintiming_clear();
+#if CONFIG_LIN_TIMING_PHASES
+    echo_done = xSemaphoreCreateBinary();
+    xTaskCreatePinnedToCore(lintiming_echo_task,
+                            "lin_timing_task",
+                            2048 * 2,
+                            NULL,
+                            CONFIG_LIN_TIMING_ECHO_TASK_PRIORITY,
+                            NULL,
+                            CONFIG_LIN_TIMING_ECHO_TASK_CORE);
+#endif /* CONFIG_LIN_TIMING_PHASES */
+}
+
+lin_err_t lintiming_send_m2s(uint16_t baudrate,
+                             bool enhanced_crc,
+                             uint8_t frameid,
+                             const uint8_t *data,
+                             uint8_t datalength) {
+    int64_t start = esp_timer_get_time();
+#if CONFIG_LIN_TIMING_PHASES
+    lintiming_echo_begin(baudrate, datalength, start);
+#endif /* CONFIG_LIN_TIMING_PHASES */
+    lin_err_t error = linmaster_send_m2s(baudrate, enhanced_crc, frameid, data, datalength);
+    lintiming_record(frameid, baudrate, datalength, error, start);
+
+    return error;
+}
+
+lin_err_t lintiming_send_s2m(uint16_t baudrate, bool enhanced_crc, uint8_t frameid, uint8_t *data, uint8_t datalength) {
+    int64_t start = esp_timer_get_time();
+#if CONFIG_LIN_TIMING_PHASES
+    lintiming_echo_begin(baudrate, datalength, start);
+#endif /* CONFIG_LIN_TIMING_PHASES */
+    lin_err_t error = linmaster_send_s2m(baudrate, enhanced_crc, frameid, data, datalength);
+    lintiming_record(frameid, baudrate, datalength, error, start);
+
+    return error;
+}
+
+bool lintiming_get(uint8_t frameid, lintiming_entry_t *entry) {
+    taskENTER_CRITICAL(&stats_lock);
+    bool retval = lintiming_stats_get(&stats, frameid, entry);
+    taskEXIT_CRITICAL(&stats_lock);
+
+    return retval;
+}
+
+bool lintiming_get_phases(uint8_t frameid, lintiming_phase_entry_t *entry) {
+    taskENTER_CRITICAL(&stats_lock);
+    bool retval = lintiming_stats_get_phases(&stats, frameid, entry);
+    taskEXIT_CRITICAL(&stats_lock);
+
+    return retval;
+}
+
+void lintiming_clear(void) {
+    taskENTER_CRITICAL(&stats_lock);
+    lintiming_stats_clear(&stats);
+    taskEXIT_CRITICAL(&stats_lock);
+}
@@ -0,0 +1,251 @@
+/**
+ * @file
+ * @brief LIN frame timing statistics routines.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the implementations of the per frame identifier timing statistics.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lin_timing_stats.h"
+
+/** number of bit times of a frame header */
+#define LINTIMING_HEADER_BITS 34u
+
+/** number of bit times per byte (start bit, 8 data bits and stop bit) */
+#define LINTIMING_BYTE_BITS 10u
+
+/** value of the sync field */
+#define LINTIMING_SYNC_BYTE 0x55u
+
+static const uint32_t histogram_limits[LINTIMING_HISTOGRAM_BINS] = LINTIMING_HISTOGRAM_LIMITS;
+
+static const char * const phase_names[LINTIMING_NR_OF_PHASES] = {
+    "setup", "break", "sync", "header", "response_space", "interbyte", "response", "completion"
+};
+
+/** Get the time between two moments
+ *
+ * @param[in]  later  later moment (us).
+ * @param[in]  earlier  earlier moment (us).
+ * @returns  time between the moments, 0 when the moments are out of order.
+ */
+static uint32_t lintiming_between(uint32_t later, uint32_t earlier);
+
+
+static uint32_t lintiming_between(uint32_t later, uint32_t earlier) {
+    return (later > earlier) ? (later - earlier) : 0u;
+}
+
+void lintiming_nominal(uint16_t baudrate, uint8_t datalength, uint32_t *header_us, uint32_t *response_us) {
+    if (baudrate == 0u) {
+        *header_us = 0u;
+        *response_us = 0u;
+    } else {
+        *header_us = ((LINTIMING_HEADER_BITS * 1000000u) + (baudrate / 2u)) / baudrate;
+        *response_us = ((LINTIMING_BYTE_BITS * ((uint32_t)datalength + 1u) * 1000000u) + (baudrate / 2u)) / baudrate;
+    }
+}
+
+void lintiming_stats_clear(lintiming_stats_t *stats) {
+    memset(stats, 0, sizeof(lintiming_stats_t));
+}
+
+void lintiming_stats_record(lintiming_stats_t *stats,
+                            uint8_t frameid,
+                            uint16_t baudrate,
+                            uint8_t datalength,
+                            bool success,
+                            uint32_t duration_us) {
+    if (frameid >= LINTIMING_NR_OF_FRAMES) {
+        return;
+    }
+
+    lintiming_slot_t *slot = &stats->slots[frameid];
+    lintiming_entry_t *entry = &slot->entry;
+
+    if (!success) {
+        entry->errors++;
+        return;
+    }
+
+    uint32_t header_us;
+    uint32_t response_us;
+    lintiming_nominal(baudrate, datalength, &header_us, &response_us);
+    entry->nominal_us = header_us + response_us;
+    entry->baudrate = baudrate;
+    entry->datalength = datalength;
+
+    if ((entry->count == 0u) || (duration_us < entry->min_us)) {
+        entry->min_us = duration_us;
+    }
+    if (duration_us > entry->max_us) {
+        entry->max_us = duration_us;
+    }
+    entry->count++;
+    slot->sum_us += duration_us;
+
+    /* maximum frame time is 1.4 times the nominal frame time */
+    if (((uint64_t)duration_us * 10u) > ((uint64_t)entry->nominal_us * 14u)) {
+        entry->over_max++;
+    }
+
+    uint32_t above = (duration_us > entry->nominal_us) ? (duration_us - entry->nominal_us) : 0u;
+    uint8_t bin = 0u;
+    while ((bin < (LINTIMING_HISTOGRAM_BINS - 1u)) && (above >= histogram_limits[bin])) {
+        bin++;
+    }
+    entry->histogram[bin]++;
+}
+
+bool lintiming_stats_get(const lintiming_stats_t *stats, uint8_t frameid, lintiming_entry_t *entry) {
+    bool retval = false;
+
+    if (frameid < LINTIMING_NR_OF_FRAMES) {
+        const lintiming_slot_t *slot = &stats->slots[frameid];
+
+        if ((slot->entry.count + slot->entry.errors) > 0u) {
+            memcpy(entry, &slot->entry, sizeof(lintiming_entry_t));
+            entry->frameid = frameid;
+            entry->avg_us = (slot->entry.count > 0u) ? (uint32_t)(slot->sum_us / slot->entry.count) : 0u;
+            retval = true;
+        }
+    }
+
+    return retval;
+}
+
+const char *lintiming_phase_name(lintiming_phase_t phase) {
+    return (phase < LINTIMING_NR_OF_PHASES) ? phase_names[phase] : "unknown";
+}
+
+void lintiming_echo_init(lintiming_echo_t *echo) {
+    memset(echo, 0, sizeof(lintiming_echo_t));
+}
+
+void lintiming_echo_break(lintiming_echo_t *echo, uint32_t timestamp_us) {
+    if (!echo->break_seen) {
+        echo->break_seen = true;
+        echo->break_us = timestamp_us;
+    }
+}
+
+void lintiming_echo_byte(lintiming_echo_t *echo, uint8_t byte, uint32_t timestamp_us) {
+    if (!echo->break_seen || (echo->count >= LINTIMING_ECHO_MAX_BYTES)) {
+        return;
+    }
+    if ((echo->count == 0u) && (byte != LINTIMING_SYNC_BYTE)) {
+        return;
+    }
+
+    echo->bytes[echo->count] = byte;
+    echo->byte_us[echo->count] = timestamp_us;
+    echo->count++;
+}
+
+bool lintiming_phases_analyze(const lintiming_echo_t *echo,
+                              uint16_t baudrate,
+                              uint8_t datalength,
+                              uint32_t end_us,
+                              lintiming_phases_t *phases) {
+    /* sync field, protected identifier, data and checksum */
+    uint32_t nr_of_bytes = (uint32_t)datalength + 3u;
+
+    if ((baudrate == 0u) || !echo->break_seen || (nr_of_bytes > echo->count)) {
+        return false;
+    }
+
+    uint32_t byte_time_us = ((LINTIMING_BYTE_BITS * 1000000u) + (baudrate / 2u)) / baudrate;
+    lintiming_timestamps_t *timestamps = &phases->timestamps;
+    timestamps->break_us = echo->break_us;
+    timestamps->sync_us = echo->byte_us[0];
+    timestamps->pid_us = echo->byte_us[1];
+    timestamps->response_us = lintiming_between(echo->byte_us[2], byte_time_us);
+    timestamps->checksum_us = echo->byte_us[nr_of_bytes - 1u];
+    timestamps->end_us = end_us;
+
+    uint32_t interbyte_us = 0u;
+    for (uint32_t i = 3u; i < nr_of_bytes; i++) {
+        uint32_t space_us = lintiming_between(lintiming_between(echo->byte_us[i], byte_time_us), echo->byte_us[i - 1u]);
+        if (space_us > interbyte_us) {
+            interbyte_us = space_us;
+        }
+    }
+
+    uint32_t *duration_us = phases->duration_us;
+    duration_us[LINTIMING_PHASE_SETUP] = timestamps->break_us;
+    duration_us[LINTIMING_PHASE_BREAK] = lintiming_between(lintiming_between(timestamps->sync_us, byte_time_us),
+                                                           timestamps->break_us);
+    duration_us[LINTIMING_PHASE_SYNC] = lintiming_between(timestamps->pid_us, timestamps->sync_us);
+    duration_us[LINTIMING_PHASE_HEADER] = lintiming_between(timestamps->pid_us, timestamps->break_us);
+    duration_us[LINTIMING_PHASE_RESPONSE_SPACE] = lintiming_between(timestamps->response_us, timestamps->pid_us);
+    duration_us[LINTIMING_PHASE_INTERBYTE] = interbyte_us;
+    duration_us[LINTIMING_PHASE_RESPONSE] = lintiming_between(timestamps->checksum_us, timestamps->response_us);
+    duration_us[LINTIMING_PHASE_COMPLETION] = lintiming_between(timestamps->end_us, timestamps->checksum_us);
+
+    return true;
+}
+
+void lintiming_stats_record_phases(lintiming_stats_t *stats, uint8_t frameid, const lintiming_phases_t *phases) {
+    if (frameid >= LINTIMING_NR_OF_FRAMES) {
+        return;
+    }
+
+    lintiming_slot_t *slot = &stats->slots[frameid];
+    lintiming_phase_entry_t *entry = &slot->phases;
+
+    if (phases == NULL) {
+        entry->missed++;
+        return;
+    }
+
+    for (uint8_t phase = 0u; phase < LINTIMING_NR_OF_PHASES; phase++) {
+        uint32_t duration_us = phases->duration_us[phase];
+        lintiming_range_t *range = &entry->phases[phase];
+
+        if ((entry->count == 0u) || (duration_us < range->min_us)) {
+            range->min_us = duration_us;
+        }
+        if (duration_us > range->max_us) {
+            range->max_us = duration_us;
+        }
+        slot->phase_sum_us[phase] += duration_us;
+    }
+    entry->count++;
+    memcpy(&entry->last, &phases->timestamps, sizeof(lintiming_timestamps_t));
+}
+
+bool lintiming_stats_get_phases(const lintiming_stats_t *stats, uint8_t frameid, lintiming_phase_entry_t *entry) {
+    bool retval = false;
+
+    if (frameid < LINTIMING_NR_OF_FRAMES) {
+        const lintiming_slot_t *slot = &stats->slots[frameid];
+
+        if ((slot->phases.count + slot->phases.missed) > 0u) {
+            memcpy(entry, &slot->phases, sizeof(lintiming_phase_entry_t));
+            entry->frameid = frameid;
+            for (uint8_t phase = 0u; phase < LINTIMING_NR_OF_PHASES; phase++) {
+                entry->phases[phase].avg_us = (slot->phases.count > 0u) ?
+                                              (uint32_t)(slot->phase_sum_us[phase] / slot->phases.count) : 0u;
+            }
+            retval = true;
+        }
+    }
+
+    return retval;
+}
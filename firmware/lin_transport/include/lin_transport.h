@@ -0,0 +1,114 @@
+/**
+ * @file
+ * @brief LIN diagnostic transport layer definitions.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the definitions of the LIN diagnostic transport layer (ISO 17987-2).
+ *
+ * Complete diagnostic messages (up to 4095 bytes) are segmented in master request frames and the
+ * responses are reassembled from slave response frames on the device, as such a diagnostic service
+ * takes a single request from the host. The caller has to claim the bus before use.
+ */
+
+#ifndef LIN_TRANSPORT_H_
+    #define LIN_TRANSPORT_H_
+
+#include <stdint.h>
+
+#include "mlx_err.h"
+
+#include "lin_transport_frame.h"
+
+/** negative response service identifier */
+#define LINTP_NEGATIVE_RESPONSE 0x7Fu
+
+/** negative response code: request correctly received, response pending */
+#define LINTP_NRC_RESPONSE_PENDING 0x78u
+
+/** transport layer timing parameters */
+typedef struct lintp_timing_s {
+    uint16_t st_min_ms;                         /**< minimum time between two frames of a message */
+    uint16_t p2_min_ms;                         /**< time between the request and the first slave response header */
+    uint16_t n_cr_max_ms;                       /**< maximum time to wait for the next frame of a response */
+    uint16_t p2_pending_ms;                     /**< maximum time to wait for a response after a response pending */
+} lintp_timing_t;
+
+/** Get the default timing parameters (from the configuration)
+ *
+ * @param[out]  timing  default timing parameters.
+ */
+void lintp_default_timing(lintp_timing_t *timing);
+
+/** Send a diagnostic message in master request frames
+ *
+ * @param[in]  baudrate  baudrate to use.
+ * @param[in]  nad  node address to send the message to.
+ * @param[in]  data  message to send (service identifier followed by the parameters).
+ * @param[in]  length  length of the message (1..LINTP_MAX_MESSAGE_LEN).
+ * @param[in]  timing  timing parameters, NULL for the default ones.
+ * @returns  MLX_OK, or the error code of the failing frame.
+ */
+mlx_err_t lintp_send_message(uint16_t baudrate,
+                             uint8_t nad,
+                             const uint8_t *data,
+                             uint16_t length,
+                             const lintp_timing_t *timing);
+
+/** Receive a diagnostic message from slave response frames
+ *
+ * Slave response headers are sent until the message is complete. Headers without response are
+ * repeated until n_cr_max_ms has elapsed without receiving a frame.
+ *
+ * @param[in]  baudrate  baudrate to use.
+ * @param[in]  nad  node address to receive the message from, or LINTP_NAD_WILDCARD.
+ * @param[out]  buffer  buffer for the message.
+ * @param[in]  size  size of the buffer.
+ * @param[out]  length  length of the received message.
+ * @param[in]  timing  timing parameters, NULL for the default ones.
+ * @returns  MLX_OK, MLX_FAIL_RX_TIMEOUT, a MLX_FAIL_TL_x error or the error code of the failing frame.
+ */
+mlx_err_t lintp_receive_message(uint16_t baudrate,
+                                uint8_t nad,
+                                uint8_t *buffer,
+                                uint16_t size,
+                                uint16_t *length,
+                                const lintp_timing_t *timing);
+
+/** Handle a diagnostic service: send the request and receive the response
+ *
+ * Response pending negative responses are handled on the device, the response which follows is
+ * returned. No response is received for requests to the functional NAD.
+ *
+ * @param[in]  baudrate  baudrate to use.
+ * @param[in]  nad  node address to send the request to.
+ * @param[in]  request  request message (service identifier followed by the parameters).
+ * @param[in]  request_len  length of the request.
+ * @param[out]  response  buffer for the response message.
+ * @param[in]  size  size of the response buffer.
+ * @param[out]  response_len  length of the response message (0 for the functional NAD).
+ * @param[in]  timing  timing parameters, NULL for the default ones.
+ * @returns  MLX_OK or the error code of the failing step.
+ */
+mlx_err_t lintp_diagnostic(uint16_t baudrate,
+                           uint8_t nad,
+                           const uint8_t *request,
+                           uint16_t request_len,
+                           uint8_t *response,
+                           uint16_t size,
+                           uint16_t *response_len,
+                           const lintp_timing_t *timing);
+
+#endif /* LIN_TRANSPORT_H_ */
@@ -0,0 +1,119 @@
+/**
+ * @file
+ * @brief LIN transport layer frame definitions.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the definitions of the segmentation and reassembly of diagnostic
+ * messages in master request (0x3C) and slave response (0x3D) frames as defined by ISO 17987-2.
+ *
+ * Each frame holds the NAD, the PCI and up to 6 data bytes:
+ * - single frame (SF): PCI 0x0L, L = 1..6 data bytes.
+ * - first frame (FF): PCI 0x1H, next byte L, message length (H << 8) + L = 7..4095, 5 data bytes.
+ * - consecutive frame (CF): PCI 0x2N, N = frame counter (1, 2, ..15, 0, 1, ..), 6 data bytes.
+ *
+ * Unused bytes are filled with 0xFF. This part has no dependencies on the ESP-IDF such that it can
+ * be built and tested on the host.
+ */
+
+#ifndef LIN_TRANSPORT_FRAME_H_
+    #define LIN_TRANSPORT_FRAME_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** frame identifier of the master request frame */
+#define LINTP_MASTER_REQUEST_ID 0x3Cu
+
+/** frame identifier of the slave response frame */
+#define LINTP_SLAVE_RESPONSE_ID 0x3Du
+
+/** length of a diagnostic frame */
+#define LINTP_FRAME_LEN 8u
+
+/** maximum length of a diagnostic message */
+#define LINTP_MAX_MESSAGE_LEN 4095u
+
+/** wildcard NAD, a response from any node is accepted */
+#define LINTP_NAD_WILDCARD 0x7Fu
+
+/** functional NAD, no response is expected */
+#define LINTP_NAD_FUNCTIONAL 0x7Eu
+
+/** reception is ongoing, more frames are expected */
+#define LINTP_RX_PENDING 0
+
+/** reception of the message is complete */
+#define LINTP_RX_COMPLETE 1
+
+/** segmentation state of a message to be sent */
+typedef struct lintp_tx_s {
+    const uint8_t *data;                        /**< message to send */
+    uint16_t length;                            /**< length of the message */
+    uint16_t offset;                            /**< number of message bytes already segmented */
+    uint8_t nad;                                /**< node address */
+    uint8_t frame_counter;                      /**< frame counter of the next consecutive frame */
+} lintp_tx_t;
+
+/** reassembly state of a message being received */
+typedef struct lintp_rx_s {
+    uint8_t *buffer;                            /**< buffer for the message */
+    uint16_t size;                              /**< size of the buffer */
+    uint16_t length;                            /**< length of the message (0 before the first frame) */
+    uint16_t offset;                            /**< number of message bytes received */
+    uint8_t nad;                                /**< expected node address, or LINTP_NAD_WILDCARD */
+    uint8_t frame_counter;                      /**< expected frame counter of the next consecutive frame */
+} lintp_rx_t;
+
+/** Start the segmentation of a message
+ *
+ * @param[out]  tx  segmentation state to initialize.
+ * @param[in]  nad  node address to send the message to.
+ * @param[in]  data  message to send (must remain valid during the segmentation).
+ * @param[in]  length  length of the message (1..LINTP_MAX_MESSAGE_LEN).
+ * @retval  true  segmentation is started.
+ * @retval  false  message length is invalid.
+ */
+bool lintp_tx_init(lintp_tx_t *tx, uint8_t nad, const uint8_t *data, uint16_t length);
+
+/** Get the next frame of a message
+ *
+ * @param[in|out]  tx  segmentation state.
+ * @param[out]  frame  frame data (LINTP_FRAME_LEN bytes).
+ * @retval  true  frame holds the next frame to send.
+ * @retval  false  all frames are sent.
+ */
+bool lintp_tx_next(lintp_tx_t *tx, uint8_t *frame);
+
+/** Start the reassembly of a message
+ *
+ * @param[out]  rx  reassembly state to initialize.
+ * @param[in]  nad  node address from which the message is expected, or LINTP_NAD_WILDCARD.
+ * @param[in]  buffer  buffer for the message.
+ * @param[in]  size  size of the buffer.
+ */
+void lintp_rx_init(lintp_rx_t *rx, uint8_t nad, uint8_t *buffer, uint16_t size);
+
+/** Handle a received slave response frame
+ *
+ * @param[in|out]  rx  reassembly state.
+ * @param[in]  frame  received frame (LINTP_FRAME_LEN bytes).
+ * @retval  LINTP_RX_PENDING  more frames are expected.
+ * @retval  LINTP_RX_COMPLETE  message is complete, rx->length holds its length.
+ * @retval  <0  reception failed with the MLX_FAIL_TL_x error code.
+ */
+int lintp_rx_frame(lintp_rx_t *rx, const uint8_t *frame);
+
+#endif /* LIN_TRANSPORT_FRAME_H_ */
@@ -0,0 +1,182 @@
+/**
+ * @file
+ * @brief LIN diagnostic transport layer routines.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the implementations of the LIN diagnostic transport layer.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_rom_sys.h"
+#include "esp_timer.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "sdkconfig.h"
+
+#include "lin_err.h"
+#include "lin_timing.h"
+#include "mlx_err.h"
+
+#include "lin_transport.h"
+
+/** Wait in between frames
+ *
+ * @param[in]  delay_ms  time to wait in milli seconds.
+ */
+static void lintp_delay(uint16_t delay_ms);
+
+
+static void lintp_delay(uint16_t delay_ms) {
+    uint32_t ticks = delay_ms / portTICK_PERIOD_MS;
+    uint32_t remainder_ms = delay_ms % portTICK_PERIOD_MS;
+    if (ticks > 0u) {
+        vTaskDelay(ticks);
+    }
+    if (remainder_ms > 0u) {
+        esp_rom_delay_us(remainder_ms * 1000u);
+    }
+}
+
+void lintp_default_timing(lintp_timing_t *timing) {
+    timing->st_min_ms = CONFIG_LIN_TRANSPORT_ST_MIN;
+    timing->p2_min_ms = CONFIG_LIN_TRANSPORT_P2_MIN;
+    timing->n_cr_max_ms = CONFIG_LIN_TRANSPORT_N_CR_MAX;
+    timing->p2_pending_ms = CONFIG_LIN_TRANSPORT_P2_PENDING;
+}
+
+mlx_err_t lintp_send_message(uint16_t baudrate,
+                             uint8_t nad,
+                             const uint8_t *data,
+                             uint16_t length,
+                             const lintp_timing_t *timing) {
+    mlx_err_t retval = MLX_OK;
+    lintp_timing_t default_timing;
+    lintp_tx_t tx;
+    uint8_t frame[LINTP_FRAME_LEN];
+
+    if (timing == NULL) {
+        lintp_default_timing(&default_timing);
+        timing = &default_timing;
+    }
+
+    if (!lintp_tx_init(&tx, nad, data, length)) {
+        retval = MLX_FAIL_TL_INV_DATALEN;
+    }
+
+    bool first = true;
+    while ((retval == MLX_OK) && lintp_tx_next(&tx, frame)) {
+        if (!first) {
+            lintp_delay(timing->st_min_ms);
+        }
+        first = false;
+        /* diagnostic frames always use the classic checksum */
+        retval = (mlx_err_t)lintiming_send_m2s(baudrate, false, LINTP_MASTER_REQUEST_ID, frame, LINTP_FRAME_LEN);
+    }
+
+    return retval;
+}
+
+mlx_err_t lintp_receive_message(uint16_t baudrate,
+                                uint8_t nad,
+                                uint8_t *buffer,
+                                uint16_t size,
+                                uint16_t *length,
+                                const lintp_timing_t *timing) {
+    mlx_err_t retval = MLX_OK;
+    lintp_timing_t default_timing;
+    lintp_rx_t rx;
+    uint8_t frame[LINTP_FRAME_LEN];
+
+    if (timing == NULL) {
+        lintp_default_timing(&default_timing);
+        timing = &default_timing;
+    }
+
+    lintp_rx_init(&rx, nad, buffer, size);
+    *length = 0u;
+
+    int64_t deadline = esp_timer_get_time() + ((int64_t)timing->n_cr_max_ms * 1000);
+    bool complete = false;
+    while ((retval == MLX_OK) && !complete) {
+        lin_err_t error = lintiming_send_s2m(baudrate, false, LINTP_SLAVE_RESPONSE_ID, frame, LINTP_FRAME_LEN);
+        if (error == LIN_OK) {
+            int rx_state = lintp_rx_frame(&rx, frame);
+            if (rx_state == LINTP_RX_COMPLETE) {
+                *length = rx.length;
+                complete = true;
+            } else if (rx_state < 0) {
+                retval = (mlx_err_t)rx_state;
+            } else {
+                deadline = esp_timer_get_time() + ((int64_t)timing->n_cr_max_ms * 1000);
+            }
+        } else if ((mlx_err_t)error == MLX_FAIL_RX_TIMEOUT) {
+            /* the slave did not respond (yet) */
+            if (esp_timer_get_time() >= deadline) {
+                retval = MLX_FAIL_RX_TIMEOUT;
+            }
+        } else {
+            retval = (mlx_err_t)error;
+        }
+
+        if ((retval == MLX_OK) && !complete) {
+            lintp_delay(timing->st_min_ms);
+        }
+    }
+
+    return retval;
+}
+
+mlx_err_t lintp_diagnostic(uint16_t baudrate,
+                           uint8_t nad,
+                           const uint8_t *request,
+                           uint16_t request_len,
+                           uint8_t *response,
+                           uint16_t size,
+                           uint16_t *response_len,
+                           const lintp_timing_t *timing) {
+    lintp_timing_t used_timing;
+
+    if (timing == NULL) {
+        lintp_default_timing(&used_timing);
+    } else {
+        used_timing = *timing;
+    }
+
+    *response_len = 0u;
+    mlx_err_t retval = lintp_send_message(baudrate, nad, request, request_len, &used_timing);
+
+    if ((retval == MLX_OK) && (nad != LINTP_NAD_FUNCTIONAL)) {
+        lintp_delay(used_timing.p2_min_ms);
+        bool pending = true;
+        while ((retval == MLX_OK) && pending) {
+            retval = lintp_receive_message(baudrate, nad, response, size, response_len, &used_timing);
+            pending = (retval == MLX_OK) &&
+                      (*response_len == 3u) &&
+                      (response[0] == LINTP_NEGATIVE_RESPONSE) &&
+                      (response[1] == request[0]) &&
+                      (response[2] == LINTP_NRC_RESPONSE_PENDING);
+            if (pending) {
+                /* the slave needs more time, wait for the actual response */
+                used_timing.n_cr_max_ms = used_timing.p2_pending_ms;
+            }
+        }
+    }
+
+    return retval;
+}
@@ -0,0 +1,161 @@
+/**
+ * @file
+ * @brief LIN transport layer frame routines.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the implementations of the segmentation and reassembly of diagnostic
+ * messages.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "mlx_err.h"
+
+#include "lin_transport_frame.h"
+
+#define PCI_TYPE_MASK 0xF0u
+#define PCI_TYPE_SF 0x00u
+#define PCI_TYPE_FF 0x10u
+#define PCI_TYPE_CF 0x20u
+
+/** number of data bytes in a single frame or consecutive frame */
+#define SF_CF_DATA_LEN 6u
+
+/** number of data bytes in a first frame */
+#define FF_DATA_LEN 5u
+
+bool lintp_tx_init(lintp_tx_t *tx, uint8_t nad, const uint8_t *data, uint16_t length) {
+    tx->data = data;
+    tx->length = length;
+    tx->offset = 0u;
+    tx->nad = nad;
+    tx->frame_counter = 1u;
+    return (length > 0u) && (length <= LINTP_MAX_MESSAGE_LEN);
+}
+
+bool lintp_tx_next(lintp_tx_t *tx, uint8_t *frame) {
+    bool retval = false;
+
+    if (tx->offset < tx->length) {
+        uint16_t count;
+        memset(frame, 0xFF, LINTP_FRAME_LEN);
+        frame[0] = tx->nad;
+
+        if (tx->length <= SF_CF_DATA_LEN) {
+            frame[1] = (uint8_t)(PCI_TYPE_SF | tx->length);
+            count = tx->length;
+            memcpy(&frame[2], tx->data, count);
+        } else if (tx->offset == 0u) {
+            frame[1] = (uint8_t)(PCI_TYPE_FF | (tx->length >> 8));
+            frame[2] = (uint8_t)(tx->length & 0xFFu);
+            count = FF_DATA_LEN;
+            memcpy(&frame[3], tx->data, count);
+        } else {
+            frame[1] = (uint8_t)(PCI_TYPE_CF | tx->frame_counter);
+            tx->frame_counter = (tx->frame_counter + 1u) & 0x0Fu;
+            count = tx->length - tx->offset;
+            if (count > SF_CF_DATA_LEN) {
+                count = SF_CF_DATA_LEN;
+            }
+            memcpy(&frame[2], &tx->data[tx->offset], count);
+        }
+
+        tx->offset += count;
+        retval = true;
+    }
+
+    return retval;
+}
+
+void lintp_rx_init(lintp_rx_t *rx, uint8_t nad, uint8_t *buffer, uint16_t size) {
+    rx->buffer = buffer;
+    rx->size = size;
+    rx->length = 0u;
+    rx->offset = 0u;
+    rx->nad = nad;
+    rx->frame_counter = 1u;
+}
+
+int lintp_rx_frame(lintp_rx_t *rx, const uint8_t *frame) {
+    int retval = LINTP_RX_PENDING;
+    uint8_t pci = frame[1];
+
+    if ((rx->nad != LINTP_NAD_WILDCARD) && (frame[0] != rx->nad)) {
+        retval = MLX_FAIL_TL_INV_NAD;
+    } else {
+        switch (pci & PCI_TYPE_MASK) {
+            case PCI_TYPE_SF:
+            {
+                uint8_t length = pci & 0x0Fu;
+                if (rx->length != 0u) {
+                    retval = MLX_FAIL_TL_NOT_EXPECTED;
+                } else if ((length == 0u) || (length > SF_CF_DATA_LEN) || (length > rx->size)) {
+                    retval = MLX_FAIL_TL_INV_DATALEN;
+                } else {
+                    memcpy(rx->buffer, &frame[2], length);
+                    rx->length = length;
+                    rx->offset = length;
+                    retval = LINTP_RX_COMPLETE;
+                }
+                break;
+            }
+
+            case PCI_TYPE_FF:
+            {
+                uint16_t length = (uint16_t)(((uint16_t)(pci & 0x0Fu) << 8) | frame[2]);
+                if (rx->length != 0u) {
+                    retval = MLX_FAIL_TL_NOT_EXPECTED;
+                } else if ((length <= SF_CF_DATA_LEN) || (length > rx->size)) {
+                    retval = MLX_FAIL_TL_INV_DATALEN;
+                } else {
+                    memcpy(rx->buffer, &frame[3], FF_DATA_LEN);
+                    rx->length = length;
+                    rx->offset = FF_DATA_LEN;
+                    rx->frame_counter = 1u;
+                    /* the consecutive frames must come from the same node */
+                    rx->nad = frame[0];
+                }
+                break;
+            }
+
+            case PCI_TYPE_CF:
+                if (rx->length == 0u) {
+                    retval = MLX_FAIL_TL_NOT_EXPECTED;
+                } else if ((pci & 0x0Fu) != rx->frame_counter) {
+                    retval = MLX_FAIL_TL_INV_FRAMECOUNTER;
+                } else {
+                    uint16_t count = rx->length - rx->offset;
+                    if (count > SF_CF_DATA_LEN) {
+                        count = SF_CF_DATA_LEN;
+                    }
+                    memcpy(&rx->buffer[rx->offset], &frame[2], count);
+                    rx->offset += count;
+                    rx->frame_counter = (rx->frame_counter + 1u) & 0x0Fu;
+                    if (rx->offset >= rx->length) {
+                        retval = LINTP_RX_COMPLETE;
+                    }
+                }
+                break;
+
+            default:
+                retval = MLX_FAIL_TL_INV_PCI;
+                break;
+        }
+    }
+
+    return retval;
+}
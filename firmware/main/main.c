@@ -32,12 +32,21 @@
 #include "bus_manager.h"
 #include "device_info.h"
 #include "device_status.h"
+#include "fw_cache.h"
 #include "networking.h"
 #include "http_webserver.h"
+#include "jobs.h"
+#include "lin_cache.h"
 #include "lin_master.h"
+#include "lin_monitor.h"
+#include "lin_schedule.h"
+#include "lin_signal.h"
+#include "lin_timing.h"
 #include "ota_support.h"
 #include "ppm_bootloader.h"
 #include "power_ctrl.h"
+#include "progress.h"
+#include "standalone.h"
 #include "usb_device.h"
 #include "webserver.h"
 
@@ -59,6 +68,10 @@ void app_main(void) {
     }
     ESP_ERROR_CHECK(ret);
 
+    (void)progress_init();
+
+    (void)jobs_init();
+
     usbdevice_init();
 
     ESP_ERROR_CHECK(networking_init());
@@ -67,8 +80,22 @@ void app_main(void) {
 
     linmaster_init();
 
+    lintiming_init();
+
+    lincache_init();
+
+    linsched_init();
+
+    linmon_init();
+
+    linsig_init();
+
     ppmbtl_init();
 
+    (void)fwcache_init();
+
+    (void)standalone_init();
+
     (void)otasupport_ImageBootSuccess();
 
     while (1) {
@@ -35,6 +35,8 @@ typedef enum mlx_error_e {
     MLX_FAIL_INCORRECT_MODE = -12,              /**< uart module is not in correct mode to handle request */
     MLX_FAIL_UNKNOWN_BTL_VERSION = -13,         /**< not supported bootloader protocol version */
     MLX_FAIL_INTERFACE_NOT_FREE = -14,          /**< interface is not available at the moment */
+    MLX_FAIL_JOB_QUEUE_FULL = -15,              /**< job queue is full, try again later */
+    MLX_FAIL_JOB_CANCELLED = -16,               /**< job was cancelled */
     MLX_FAIL_INV_DATA_LEN = -0x7C,              /**< invalid message data length */
     MLX_FAIL_UNKNOWN_ERROR = -0x7D,             /**< unknown error */
     MLX_FAIL_INTERNAL = -0x7E,                  /**< internal error */
@@ -73,6 +75,7 @@ typedef enum mlx_error_e {
     MLX_FAIL_BTL_PROGRAMMING_FAILED = -0x208,   /**< btl error: programming failed */
     MLX_FAIL_BTL_CHIP_NOT_SUPPORTED = -0x209,   /**< btl error: connected chip is not supported */
     MLX_FAIL_BTL_ACTION_NOT_SUPPORTED = -0x20A, /**< btl error: requested action is not supported by connected chip */
+    MLX_FAIL_BTL_IMAGE_NOT_CACHED = -0x20B,     /**< btl error: image is not in the image cache */
     /* application master : -0x300..-0x3FF */
     MLX_FAIL_APP_INV_DATA_LEN = -0x300          /**< app error: invalid message data length */
 } mlx_err_t;                                    /**< Melexis error code type */
@@ -37,6 +37,8 @@ const struct {
     {MLX_FAIL_INCORRECT_MODE, "Physical layer error: module is not in correct mode to handle request"},
     {MLX_FAIL_UNKNOWN_BTL_VERSION, "Physical layer error: not supported bootloader protocol version"},
     {MLX_FAIL_INTERFACE_NOT_FREE, "interface is not available at the moment"},
+    {MLX_FAIL_JOB_QUEUE_FULL, "job queue is full, try again later"},
+    {MLX_FAIL_JOB_CANCELLED, "job was cancelled"},
     {MLX_FAIL_INV_DATA_LEN, "invalid message data length"},
     {MLX_FAIL_UNKNOWN_ERROR, "unknown error"},
     {MLX_FAIL_INTERNAL, "internal error"},
@@ -75,6 +77,7 @@ const struct {
     {MLX_FAIL_BTL_PROGRAMMING_FAILED, "Bootloader error: programming failed"},
     {MLX_FAIL_BTL_CHIP_NOT_SUPPORTED, "Bootloader error: connected chip is not supported"},
     {MLX_FAIL_BTL_ACTION_NOT_SUPPORTED, "Bootloader error: requested action is not supported by connected chip"},
+    {MLX_FAIL_BTL_IMAGE_NOT_CACHED, "Bootloader error: image is not in the image cache"},
     /* application master : -0x300..-0x3FF */
     {MLX_FAIL_APP_INV_DATA_LEN, "App error: invalid message data length"},
 };
@@ -25,11 +25,17 @@
 #include "esp_ota_ops.h"
 #include "esp_system.h"
 
+#include "progress.h"
+
 #include "ota_support.h"
 
+/** rough throughput of the image validation (bytes/s), to estimate its progress until it is measured */
+#define OTASUPPORT_VALIDATE_RATE 1000000u
+
 static const char *TAG = "ota-support";
 static esp_ota_handle_t update_handle;
 static const esp_partition_t *update_partition;
+static uint32_t update_written = 0u;
 
 esp_err_t otasupport_ImageBootSuccess(void) {
     const esp_partition_t *running = esp_ota_get_running_partition();
@@ -44,20 +50,38 @@ esp_err_t otasupport_ImageBootSuccess(void) {
 
 esp_err_t otasupport_Start(void) {
     update_partition = esp_ota_get_next_update_partition(NULL);
+    progress_start(PROGRESS_OP_OTA);
     esp_err_t err = esp_ota_begin(update_partition, OTA_WITH_SEQUENTIAL_WRITES, &update_handle);
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "esp_ota_begin failed (%s)", esp_err_to_name(err));
+        progress_finish(false);
+    } else {
+        /* the size of the new firmware is not known up front */
+        update_written = 0u;
+        progress_phase(PROGRESS_PHASE_WRITE, 0u, 0u, 0u);
     }
     return err;
 }
 
 esp_err_t otasupport_Write(const void *data, size_t size) {
-    return esp_ota_write(update_handle, data, size);
+    esp_err_t err = esp_ota_write(update_handle, data, size);
+    if (err == ESP_OK) {
+        update_written += size;
+        progress_update(update_written);
+    } else {
+        progress_finish(false);
+    }
+    return err;
 }
 
 esp_err_t otasupport_ValidatePartition(void) {
+    progress_phase(PROGRESS_PHASE_VALIDATE, update_written, 0u, OTASUPPORT_VALIDATE_RATE);
     esp_err_t err = esp_ota_end(update_handle);
     update_handle = (esp_ota_handle_t)NULL;
+    if (err == ESP_OK) {
+        progress_phase_end();
+    }
+    progress_finish(err == ESP_OK);
     if (err != ESP_OK) {
         if (err == ESP_ERR_OTA_VALIDATE_FAILED) {
             ESP_LOGE(TAG, "Image validation failed, image is corrupted");
@@ -0,0 +1,93 @@
+/**
+ * @file
+ * @brief Operation progress reporting definitions.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the definitions of the progress reporting of long running operations,
+ * such as a bootloader action or a firmware update.
+ *
+ * The code which runs the operation marks its start, phases and end, and reports the progress when
+ * it knows it. The listeners, e.g. the websocket and the USB bulk interface, receive a report at
+ * every phase change and at most every CONFIG_PROGRESS_REPORT_INTERVAL in between. A timer
+ * estimates the progress of phases which cannot report it.
+ */
+
+#ifndef PROGRESS_H_
+    #define PROGRESS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+#include "progress_tracker.h"
+
+/** Initialize the progress reporting
+ *
+ * @returns  ESP_OK when progress can be reported.
+ */
+esp_err_t progress_init(void);
+
+/** Register a progress listener
+ *
+ * A listener which is registered with the same context already is not added again.
+ *
+ * @param[in]  listener  listener to register.
+ * @param[in]  ctx  context pointer to be passed to the listener.
+ * @retval  ESP_OK  listener is registered.
+ * @retval  ESP_ERR_NO_MEM  maximum number of listeners is reached.
+ */
+esp_err_t progress_add_listener(progress_listener_t listener, void *ctx);
+
+/** Unregister a progress listener
+ *
+ * @param[in]  listener  listener to unregister.
+ * @param[in]  ctx  context pointer as passed during registration.
+ */
+void progress_remove_listener(progress_listener_t listener, void *ctx);
+
+/** Start reporting an operation, a running operation is replaced
+ *
+ * @param[in]  operation  operation.
+ */
+void progress_start(progress_operation_t operation);
+
+/** Enter a phase of the running operation
+ *
+ * @param[in]  phase  phase.
+ * @param[in]  bytes_total  bytes of the phase, 0 when unknown.
+ * @param[in]  page_size  bytes per page, 0 when the phase has no pages.
+ * @param[in]  default_rate  throughput (bytes/s) to estimate the progress with until the phase
+ *                           completed once, 0 when unknown.
+ */
+void progress_phase(progress_phase_t phase, uint32_t bytes_total, uint32_t page_size, uint32_t default_rate);
+
+/** Mark the current phase of the running operation as completed */
+void progress_phase_end(void);
+
+/** Report the progress of the current phase of the running operation
+ *
+ * @param[in]  bytes_done  bytes done in the phase.
+ */
+void progress_update(uint32_t bytes_done);
+
+/** Finish the running operation
+ *
+ * @param[in]  success  true: the operation succeeded.
+ */
+void progress_finish(bool success);
+
+#endif /* PROGRESS_H_ */
@@ -0,0 +1,202 @@
+/**
+ * @file
+ * @brief Operation progress tracker definitions.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the definitions of the progress tracker of a long running operation.
+ *
+ * An operation runs through phases. The progress within a phase is either reported by the caller,
+ * or estimated from the elapsed time when the phase runs in a library without progress reporting,
+ * such as a bootloader action. An estimate uses the throughput measured the last time the phase
+ * completed, or the default throughput given by the caller. This part has no dependencies on the
+ * ESP-IDF such that it can be built and tested on the host, the caller passes the time and locks
+ * the listener table.
+ */
+
+#ifndef PROGRESS_TRACKER_H_
+    #define PROGRESS_TRACKER_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** time left when it cannot be estimated */
+#define PROGRESS_ETA_UNKNOWN UINT32_MAX
+
+/** tracked operation */
+typedef enum progress_operation_e {
+    PROGRESS_OP_NONE = 0,                       /**< no operation */
+    PROGRESS_OP_BOOTLOADER,                     /**< PPM bootloader action */
+    PROGRESS_OP_OTA,                            /**< firmware update of the device */
+} progress_operation_t;
+
+/** phase of an operation */
+typedef enum progress_phase_e {
+    PROGRESS_PHASE_PREPARE = 0,                 /**< image is loaded */
+    PROGRESS_PHASE_PROGRAM,                     /**< pages are programmed */
+    PROGRESS_PHASE_VERIFY,                      /**< pages are verified */
+    PROGRESS_PHASE_WRITE,                       /**< firmware is written */
+    PROGRESS_PHASE_VALIDATE,                    /**< firmware is validated */
+    PROGRESS_PHASE_DONE,                        /**< operation succeeded */
+    PROGRESS_PHASE_FAILED,                      /**< operation failed */
+    PROGRESS_NR_OF_PHASES
+} progress_phase_t;
+
+/** progress report, also the payload of the USB bulk progress message */
+typedef struct progress_report_s {
+    uint8_t operation;                          /**< progress_operation_t */
+    uint8_t phase;                              /**< progress_phase_t */
+    uint8_t estimated;                          /**< 1: done counters are estimated from the elapsed time */
+    uint8_t reserved;                           /**< reserved, 0 */
+    uint32_t bytes_done;                        /**< bytes done in the phase */
+    uint32_t bytes_total;                       /**< bytes of the phase, 0 when unknown */
+    uint32_t pages_done;                        /**< pages done in the phase */
+    uint32_t pages_total;                       /**< pages of the phase, 0 when the phase has no pages */
+    uint32_t elapsed_ms;                        /**< time since the start of the operation (ms) */
+    uint32_t eta_ms;                            /**< time left in the phase (ms), PROGRESS_ETA_UNKNOWN when unknown */
+} progress_report_t;
+
+/** progress tracker */
+typedef struct progress_tracker_s {
+    progress_report_t report;                   /**< current progress */
+    uint32_t start_ms;                          /**< start of the operation */
+    uint32_t phase_start_ms;                    /**< start of the phase */
+    uint32_t last_report_ms;                    /**< time of the last report */
+    uint32_t interval_ms;                       /**< minimum time between periodic reports */
+    uint32_t page_size;                         /**< bytes per page of the phase, 0 when the phase has no pages */
+    uint32_t expected_ms;                       /**< expected duration of the phase, 0 when unknown */
+    uint32_t rates[PROGRESS_NR_OF_PHASES];      /**< measured throughput per phase (bytes/s), 0 when unknown */
+} progress_tracker_t;
+
+/** Progress listener
+ *
+ * Called from the task which runs the operation or from the timer task, a listener shall not
+ * block for long as the operation waits for it.
+ *
+ * @param[in]  report  progress of the operation.
+ * @param[in]  ctx  context pointer as passed during registration.
+ */
+typedef void (* progress_listener_t)(const progress_report_t *report, void *ctx);
+
+/** registered progress listener */
+typedef struct progress_listener_entry_s {
+    progress_listener_t listener;               /**< registered listener, or NULL */
+    void *ctx;                                  /**< context for the listener */
+} progress_listener_entry_t;
+
+/** Initialize a tracker, forgetting the measured throughputs
+ *
+ * @param[out]  tracker  tracker.
+ * @param[in]  interval_ms  minimum time between periodic reports (ms).
+ */
+void progress_tracker_init(progress_tracker_t *tracker, uint32_t interval_ms);
+
+/** Start an operation in the prepare phase
+ *
+ * @param[in|out]  tracker  tracker.
+ * @param[in]  operation  operation.
+ * @param[in]  now_ms  current time (ms).
+ */
+void progress_tracker_start(progress_tracker_t *tracker, progress_operation_t operation, uint32_t now_ms);
+
+/** Enter a phase, its progress is estimated until the caller reports it
+ *
+ * @param[in|out]  tracker  tracker.
+ * @param[in]  phase  phase.
+ * @param[in]  bytes_total  bytes of the phase, 0 when unknown.
+ * @param[in]  page_size  bytes per page, 0 when the phase has no pages.
+ * @param[in]  default_rate  throughput (bytes/s) used until the phase completed once, 0 when unknown.
+ * @param[in]  now_ms  current time (ms).
+ */
+void progress_tracker_phase(progress_tracker_t *tracker,
+                            progress_phase_t phase,
+                            uint32_t bytes_total,
+                            uint32_t page_size,
+                            uint32_t default_rate,
+                            uint32_t now_ms);
+
+/** Mark the current phase as completed, its throughput is used for the next estimates
+ *
+ * @param[in|out]  tracker  tracker.
+ * @param[in]  now_ms  current time (ms).
+ */
+void progress_tracker_phase_end(progress_tracker_t *tracker, uint32_t now_ms);
+
+/** Report the progress of the current phase
+ *
+ * @param[in|out]  tracker  tracker.
+ * @param[in]  bytes_done  bytes done in the phase.
+ * @param[in]  now_ms  current time (ms).
+ * @retval  true  a report is due.
+ * @retval  false  the last report is more recent than the report interval.
+ */
+bool progress_tracker_update(progress_tracker_t *tracker, uint32_t bytes_done, uint32_t now_ms);
+
+/** Update the elapsed time, and the estimated progress when the caller does not report it
+ *
+ * The estimate stays below the total of the phase, as only the caller knows when it completed.
+ *
+ * @param[in|out]  tracker  tracker.
+ * @param[in]  now_ms  current time (ms).
+ * @retval  true  a report is due.
+ * @retval  false  the last report is more recent than the report interval.
+ */
+bool progress_tracker_tick(progress_tracker_t *tracker, uint32_t now_ms);
+
+/** Finish the operation in the done or failed phase
+ *
+ * @param[in|out]  tracker  tracker.
+ * @param[in]  success  true: the operation succeeded.
+ * @param[in]  now_ms  current time (ms).
+ */
+void progress_tracker_finish(progress_tracker_t *tracker, bool success, uint32_t now_ms);
+
+/** Get the name of a phase
+ *
+ * @param[in]  phase  phase.
+ * @returns  name of the phase.
+ */
+const char *progress_phase_to_string(progress_phase_t phase);
+
+/** Register a listener in a listener table
+ *
+ * A listener which is registered with the same context already is not added again.
+ *
+ * @param[in|out]  listeners  listener table.
+ * @param[in]  nr_of_listeners  number of entries in the table.
+ * @param[in]  listener  listener to register.
+ * @param[in]  ctx  context pointer to be passed to the listener.
+ * @retval  true  listener is registered.
+ * @retval  false  table is full.
+ */
+bool progress_listeners_add(progress_listener_entry_t *listeners,
+                            size_t nr_of_listeners,
+                            progress_listener_t listener,
+                            void *ctx);
+
+/** Remove a listener from a listener table
+ *
+ * @param[in|out]  listeners  listener table.
+ * @param[in]  nr_of_listeners  number of entries in the table.
+ * @param[in]  listener  listener to remove.
+ * @param[in]  ctx  context pointer the listener was registered with.
+ */
+void progress_listeners_remove(progress_listener_entry_t *listeners,
+                               size_t nr_of_listeners,
+                               progress_listener_t listener,
+                               void *ctx);
+
+#endif /* PROGRESS_TRACKER_H_ */
@@ -0,0 +1,187 @@
+/**
+ * @file
+ * @brief Operation progress reporting routines.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the implementations of the progress reporting of long running
+ * operations. The listeners are called with the lock taken, such that a finished operation is
+ * never followed by a late periodic report.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+#include "sdkconfig.h"
+
+#include "progress.h"
+
+/** maximum number of progress listeners */
+#define PROGRESS_MAX_LISTENERS 4u
+
+static const char *TAG = "progress";
+
+static progress_tracker_t tracker;
+static bool active = false;
+static SemaphoreHandle_t progress_lock = NULL;
+static esp_timer_handle_t progress_timer = NULL;
+static progress_listener_entry_t listeners[PROGRESS_MAX_LISTENERS];
+
+/** Get the current time for the tracker
+ *
+ * @returns  time since boot (ms).
+ */
+static uint32_t progress_now_ms(void) {
+    return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
+/** Hand the current progress over to the listeners, to be called with the lock taken */
+static void progress_notify(void) {
+    for (size_t i = 0; i < PROGRESS_MAX_LISTENERS; i++) {
+        if (listeners[i].listener != NULL) {
+            listeners[i].listener(&tracker.report, listeners[i].ctx);
+        }
+    }
+}
+
+/** Report timer callback, reports the (estimated) progress of the running operation
+ *
+ * @param[in]  arg  timer argument (not used).
+ */
+static void progress_timer_callback(void *arg) {
+    (void)arg;
+
+    (void)xSemaphoreTake(progress_lock, portMAX_DELAY);
+    if (active && progress_tracker_tick(&tracker, progress_now_ms())) {
+        progress_notify();
+    }
+    (void)xSemaphoreGive(progress_lock);
+}
+
+esp_err_t progress_init(void) {
+    esp_err_t retval = ESP_OK;
+
+    if (progress_lock == NULL) {
+        progress_tracker_init(&tracker, CONFIG_PROGRESS_REPORT_INTERVAL);
+
+        const esp_timer_create_args_t timer_args = {
+            .callback = progress_timer_callback,
+            .arg = NULL,
+            .dispatch_method = ESP_TIMER_TASK,
+            .name = "progress",
+            .skip_unhandled_events = true,
+        };
+        retval = esp_timer_create(&timer_args, &progress_timer);
+        if (retval == ESP_OK) {
+            progress_lock = xSemaphoreCreateMutex();
+            if (progress_lock == NULL) {
+                retval = ESP_ERR_NO_MEM;
+            }
+        }
+        if (retval != ESP_OK) {
+            ESP_LOGE(TAG, "initialization failed (%s)", esp_err_to_name(retval));
+        }
+    }
+
+    return retval;
+}
+
+esp_err_t progress_add_listener(progress_listener_t listener, void *ctx) {
+    esp_err_t retval = ESP_ERR_NO_MEM;
+
+    if (progress_lock == NULL) {
+        retval = ESP_ERR_INVALID_STATE;
+    } else {
+        (void)xSemaphoreTake(progress_lock, portMAX_DELAY);
+        if (progress_listeners_add(listeners, PROGRESS_MAX_LISTENERS, listener, ctx)) {
+            retval = ESP_OK;
+        }
+        (void)xSemaphoreGive(progress_lock);
+    }
+
+    return retval;
+}
+
+void progress_remove_listener(progress_listener_t listener, void *ctx) {
+    if (progress_lock != NULL) {
+        (void)xSemaphoreTake(progress_lock, portMAX_DELAY);
+        progress_listeners_remove(listeners, PROGRESS_MAX_LISTENERS, listener, ctx);
+        (void)xSemaphoreGive(progress_lock);
+    }
+}
+
+void progress_start(progress_operation_t operation) {
+    if (progress_lock != NULL) {
+        (void)xSemaphoreTake(progress_lock, portMAX_DELAY);
+        if (active) {
+            (void)esp_timer_stop(progress_timer);
+        }
+        progress_tracker_start(&tracker, operation, progress_now_ms());
+        active = true;
+        progress_notify();
+        (void)esp_timer_start_periodic(progress_timer, CONFIG_PROGRESS_REPORT_INTERVAL * 1000u);
+        (void)xSemaphoreGive(progress_lock);
+    }
+}
+
+void progress_phase(progress_phase_t phase, uint32_t bytes_total, uint32_t page_size, uint32_t default_rate) {
+    if (progress_lock != NULL) {
+        (void)xSemaphoreTake(progress_lock, portMAX_DELAY);
+        if (active) {
+            progress_tracker_phase(&tracker, phase, bytes_total, page_size, default_rate, progress_now_ms());
+            progress_notify();
+        }
+        (void)xSemaphoreGive(progress_lock);
+    }
+}
+
+void progress_phase_end(void) {
+    if (progress_lock != NULL) {
+        (void)xSemaphoreTake(progress_lock, portMAX_DELAY);
+        if (active) {
+            progress_tracker_phase_end(&tracker, progress_now_ms());
+        }
+        (void)xSemaphoreGive(progress_lock);
+    }
+}
+
+void progress_update(uint32_t bytes_done) {
+    if (progress_lock != NULL) {
+        (void)xSemaphoreTake(progress_lock, portMAX_DELAY);
+        if (active && progress_tracker_update(&tracker, bytes_done, progress_now_ms())) {
+            progress_notify();
+        }
+        (void)xSemaphoreGive(progress_lock);
+    }
+}
+
+void progress_finish(bool success) {
+    if (progress_lock != NULL) {
+        (void)xSemaphoreTake(progress_lock, portMAX_DELAY);
+        if (active) {
+            (void)esp_timer_stop(progress_timer);
+            progress_tracker_finish(&tracker, success, progress_now_ms());
+            progress_notify();
+            active = false;
+        }
+        (void)xSemaphoreGive(progress_lock);
+    }
+}
@@ -0,0 +1,249 @@
+/**
+ * @file
+ * @brief Operation progress tracker routines.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the implementations of the progress tracker of a long running operation.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "progress_tracker.h"
+
+/** Check whether a periodic report is due, and restart the report interval when it is
+ *
+ * @param[in|out]  tracker  tracker.
+ * @param[in]  now_ms  current time (ms).
+ * @retval  true  a report is due.
+ * @retval  false  the last report is more recent than the report interval.
+ */
+static bool progress_tracker_due(progress_tracker_t *tracker, uint32_t now_ms) {
+    bool retval = false;
+
+    if ((now_ms - tracker->last_report_ms) >= tracker->interval_ms) {
+        tracker->last_report_ms = now_ms;
+        retval = true;
+    }
+
+    return retval;
+}
+
+/** Set the bytes done in the current phase and derive the pages done
+ *
+ * @param[in|out]  tracker  tracker.
+ * @param[in]  bytes_done  bytes done in the phase.
+ */
+static void progress_tracker_set_done(progress_tracker_t *tracker, uint32_t bytes_done) {
+    progress_report_t *report = &tracker->report;
+
+    if ((report->bytes_total != 0u) && (bytes_done > report->bytes_total)) {
+        bytes_done = report->bytes_total;
+    }
+    report->bytes_done = bytes_done;
+    report->pages_done = (tracker->page_size != 0u) ? (bytes_done / tracker->page_size) : 0u;
+}
+
+void progress_tracker_init(progress_tracker_t *tracker, uint32_t interval_ms) {
+    memset(tracker, 0, sizeof(progress_tracker_t));
+    tracker->interval_ms = interval_ms;
+    tracker->report.eta_ms = PROGRESS_ETA_UNKNOWN;
+}
+
+void progress_tracker_start(progress_tracker_t *tracker, progress_operation_t operation, uint32_t now_ms) {
+    memset(&tracker->report, 0, sizeof(progress_report_t));
+    tracker->report.operation = (uint8_t)operation;
+    tracker->report.phase = (uint8_t)PROGRESS_PHASE_PREPARE;
+    tracker->report.eta_ms = PROGRESS_ETA_UNKNOWN;
+    tracker->start_ms = now_ms;
+    tracker->phase_start_ms = now_ms;
+    tracker->last_report_ms = now_ms;
+    tracker->page_size = 0u;
+    tracker->expected_ms = 0u;
+}
+
+void progress_tracker_phase(progress_tracker_t *tracker,
+                            progress_phase_t phase,
+                            uint32_t bytes_total,
+                            uint32_t page_size,
+                            uint32_t default_rate,
+                            uint32_t now_ms) {
+    progress_report_t *report = &tracker->report;
+
+    uint32_t rate = default_rate;
+    if ((phase < PROGRESS_NR_OF_PHASES) && (tracker->rates[phase] != 0u)) {
+        rate = tracker->rates[phase];
+    }
+
+    tracker->page_size = page_size;
+    tracker->phase_start_ms = now_ms;
+    tracker->last_report_ms = now_ms;
+    tracker->expected_ms = 0u;
+    if (rate != 0u) {
+        uint64_t expected_ms = ((uint64_t)bytes_total * 1000u) / rate;
+        tracker->expected_ms = (expected_ms < PROGRESS_ETA_UNKNOWN) ? (uint32_t)expected_ms : 0u;
+    }
+
+    report->phase = (uint8_t)phase;
+    report->bytes_total = bytes_total;
+    report->pages_total = (page_size != 0u) ? ((bytes_total + page_size - 1u) / page_size) : 0u;
+    progress_tracker_set_done(tracker, 0u);
+    report->estimated = (tracker->expected_ms != 0u) ? 1u : 0u;
+    report->eta_ms = (tracker->expected_ms != 0u) ? tracker->expected_ms : PROGRESS_ETA_UNKNOWN;
+    report->elapsed_ms = now_ms - tracker->start_ms;
+}
+
+void progress_tracker_phase_end(progress_tracker_t *tracker, uint32_t now_ms) {
+    progress_report_t *report = &tracker->report;
+    uint32_t elapsed_ms = now_ms - tracker->phase_start_ms;
+    uint32_t bytes = (report->estimated != 0u) ? report->bytes_total : report->bytes_done;
+
+    if ((elapsed_ms != 0u) && (bytes != 0u) && (report->phase < (uint8_t)PROGRESS_NR_OF_PHASES)) {
+        uint64_t rate = ((uint64_t)bytes * 1000u) / elapsed_ms;
+        tracker->rates[report->phase] = (rate < UINT32_MAX) ? (uint32_t)((rate != 0u) ? rate : 1u) : UINT32_MAX;
+    }
+
+    report->estimated = 0u;
+    progress_tracker_set_done(tracker, (report->bytes_total != 0u) ? report->bytes_total : report->bytes_done);
+    report->eta_ms = 0u;
+    report->elapsed_ms = now_ms - tracker->start_ms;
+}
+
+bool progress_tracker_update(progress_tracker_t *tracker, uint32_t bytes_done, uint32_t now_ms) {
+    progress_report_t *report = &tracker->report;
+    uint32_t elapsed_ms = now_ms - tracker->phase_start_ms;
+
+    report->estimated = 0u;
+    progress_tracker_set_done(tracker, bytes_done);
+    report->eta_ms = PROGRESS_ETA_UNKNOWN;
+    if (report->bytes_total != 0u) {
+        if (report->bytes_done >= report->bytes_total) {
+            report->eta_ms = 0u;
+        } else if (report->bytes_done != 0u) {
+            /* extrapolate the throughput measured so far in this phase */
+            uint64_t eta_ms = ((uint64_t)(report->bytes_total - report->bytes_done) * elapsed_ms) / report->bytes_done;
+            report->eta_ms = (eta_ms < PROGRESS_ETA_UNKNOWN) ? (uint32_t)eta_ms : PROGRESS_ETA_UNKNOWN;
+        }
+    }
+    report->elapsed_ms = now_ms - tracker->start_ms;
+
+    return progress_tracker_due(tracker, now_ms);
+}
+
+bool progress_tracker_tick(progress_tracker_t *tracker, uint32_t now_ms) {
+    progress_report_t *report = &tracker->report;
+
+    if ((report->estimated != 0u) && (tracker->expected_ms != 0u)) {
+        uint32_t elapsed_ms = now_ms - tracker->phase_start_ms;
+        if (elapsed_ms < tracker->expected_ms) {
+            uint64_t bytes_done = ((uint64_t)report->bytes_total * elapsed_ms) / tracker->expected_ms;
+            progress_tracker_set_done(tracker, (uint32_t)bytes_done);
+            report->eta_ms = tracker->expected_ms - elapsed_ms;
+        } else {
+            /* slower than expected, keep waiting just before the end */
+            progress_tracker_set_done(tracker, report->bytes_total - 1u);
+            report->eta_ms = PROGRESS_ETA_UNKNOWN;
+        }
+    }
+    report->elapsed_ms = now_ms - tracker->start_ms;
+
+    return progress_tracker_due(tracker, now_ms);
+}
+
+void progress_tracker_finish(progress_tracker_t *tracker, bool success, uint32_t now_ms) {
+    progress_report_t *report = &tracker->report;
+
+    if (success) {
+        report->phase = (uint8_t)PROGRESS_PHASE_DONE;
+        progress_tracker_set_done(tracker, (report->bytes_total != 0u) ? report->bytes_total : report->bytes_done);
+    } else {
+        report->phase = (uint8_t)PROGRESS_PHASE_FAILED;
+    }
+    report->estimated = 0u;
+    report->eta_ms = 0u;
+    report->elapsed_ms = now_ms - tracker->start_ms;
+    tracker->expected_ms = 0u;
+    tracker->last_report_ms = now_ms;
+}
+
+const char *progress_phase_to_string(progress_phase_t phase) {
+    const char *retval = "unknown";
+
+    switch (phase) {
+        case PROGRESS_PHASE_PREPARE:
+            retval = "prepare";
+            break;
+        case PROGRESS_PHASE_PROGRAM:
+            retval = "program";
+            break;
+        case PROGRESS_PHASE_VERIFY:
+            retval = "verify";
+            break;
+        case PROGRESS_PHASE_WRITE:
+            retval = "write";
+            break;
+        case PROGRESS_PHASE_VALIDATE:
+            retval = "validate";
+            break;
+        case PROGRESS_PHASE_DONE:
+            retval = "done";
+            break;
+        case PROGRESS_PHASE_FAILED:
+            retval = "failed";
+            break;
+        default:
+            break;
+    }
+
+    return retval;
+}
+
+bool progress_listeners_add(progress_listener_entry_t *listeners,
+                            size_t nr_of_listeners,
+                            progress_listener_t listener,
+                            void *ctx) {
+    bool retval = false;
+    size_t free_slot = nr_of_listeners;
+
+    for (size_t i = 0; i < nr_of_listeners; i++) {
+        if ((listeners[i].listener == listener) && (listeners[i].ctx == ctx)) {
+            /* registered already, e.g. by a previous enable of the interface */
+            retval = true;
+        } else if ((listeners[i].listener == NULL) && (free_slot == nr_of_listeners)) {
+            free_slot = i;
+        }
+    }
+    if (!retval && (free_slot < nr_of_listeners)) {
+        listeners[free_slot].listener = listener;
+        listeners[free_slot].ctx = ctx;
+        retval = true;
+    }
+
+    return retval;
+}
+
+void progress_listeners_remove(progress_listener_entry_t *listeners,
+                               size_t nr_of_listeners,
+                               progress_listener_t listener,
+                               void *ctx) {
+    for (size_t i = 0; i < nr_of_listeners; i++) {
+        if ((listeners[i].listener == listener) && (listeners[i].ctx == ctx)) {
+            listeners[i].listener = NULL;
+            listeners[i].ctx = NULL;
+        }
+    }
+}
@@ -0,0 +1,116 @@
+/**
+ * @file
+ * @brief Stand-alone programming mode definitions.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the definitions of the stand-alone programming mode.
+ *
+ * In the stand-alone mode the device programs a preloaded image without a host driving the
+ * bootloader, e.g. at a production line. The image is kept pinned in the image cache and the job
+ * parameters are stored in NVS. A job is started with the REST API or with an edge on the trigger
+ * input, the status LED shows the state of the last job. Every job is logged with its duration and
+ * result in a cycle-time log which survives a reboot.
+ */
+
+#ifndef STANDALONE_H_
+    #define STANDALONE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+#include "fw_cache.h"
+#include "ppm_bootloader.h"
+
+#include "standalone_log.h"
+
+/** job parameters of the stand-alone mode */
+typedef struct standalone_config_s {
+    uint8_t hash[FWCACHE_HASH_LEN];             /**< content hash of the cached image to program */
+    uint32_t bitrate;                           /**< bitrate of the bootloader */
+    ppm_memory_t memory;                        /**< memory to program */
+    bool broadcast;                             /**< program in broadcast mode */
+    bool manpow;                                /**< manual power cycling */
+    bool differential;                          /**< only program the pages which differ */
+    bool enabled;                               /**< jobs can be triggered */
+} standalone_config_t;
+
+/** Read the stored job parameters and log, and start the stand-alone task
+ *
+ * The image cache must be initialized before.
+ *
+ * @returns  ESP_OK when the stand-alone mode can be used.
+ */
+esp_err_t standalone_init(void);
+
+/** Get the job parameters
+ *
+ * @param[out]  config  job parameters.
+ */
+void standalone_get_config(standalone_config_t *config);
+
+/** Set and store the job parameters
+ *
+ * The image is pinned in the image cache while the mode is enabled, such that it is not removed to
+ * make room for other images.
+ *
+ * @param[in]  config  job parameters.
+ * @returns  ESP_OK when the parameters are stored, ESP_ERR_INVALID_ARG for invalid parameters,
+ *           ESP_ERR_NOT_FOUND when the image is not cached, ESP_ERR_INVALID_STATE while a job runs.
+ */
+esp_err_t standalone_set_config(const standalone_config_t *config);
+
+/** Start a job
+ *
+ * The job is run by the job engine, a trigger by the input is debounced first.
+ *
+ * @param[in]  trigger  source of the job.
+ * @param[out]  job_id  id of the job in the job engine, may be NULL, not set for the trigger input.
+ * @returns  ESP_OK when the job is started, ESP_ERR_INVALID_STATE when the mode is disabled or a job
+ *           is running already, ESP_ERR_NO_MEM when the job queue is full.
+ */
+esp_err_t standalone_trigger(standalone_trigger_t trigger, uint32_t *job_id);
+
+/** Check whether a job is queued or running
+ *
+ * @retval  true  a job is queued or running.
+ * @retval  false  no job is queued or running.
+ */
+bool standalone_busy(void);
+
+/** Get the counters of all jobs
+ *
+ * @param[out]  counters  counters.
+ */
+void standalone_get_counters(standalone_counters_t *counters);
+
+/** Get a logged job
+ *
+ * @param[in]  position  position of the job, 0 is the oldest job.
+ * @param[out]  record  job.
+ * @retval  true  job is copied.
+ * @retval  false  position is not in the log.
+ */
+bool standalone_get_record(uint32_t position, standalone_record_t *record);
+
+/** Clear the log and the counters
+ *
+ * @returns  ESP_OK when the cleared log is stored.
+ */
+esp_err_t standalone_clear_log(void);
+
+#endif /* STANDALONE_H_ */
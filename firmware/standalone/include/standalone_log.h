@@ -0,0 +1,154 @@
+/**
+ * @file
+ * @brief Stand-alone programming cycle-time log definitions.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the definitions of the cycle-time log of the stand-alone mode. The log
+ * keeps the last jobs in a ring and counts all jobs since the log was cleared. This part has no
+ * dependencies on the ESP-IDF such that it can be built and tested on the host, the caller stores
+ * the log. The log is stored as its header and one entry per job in the ring, such that a new job
+ * only writes its own entry and the header.
+ */
+
+#ifndef STANDALONE_LOG_H_
+    #define STANDALONE_LOG_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** number of jobs kept in the log */
+#define STANDALONE_LOG_MAX_RECORDS 64u
+
+/** magic of a stored log, changes with the layout of the log */
+#define STANDALONE_LOG_MAGIC 0x32474C53u
+
+/** stored length of the log header, the part of the log in front of the jobs */
+#define STANDALONE_LOG_HEADER_LEN offsetof(standalone_log_t, records)
+
+/** header line of the log as comma separated values */
+#define STANDALONE_LOG_CSV_HEADER "job,uptime_s,trigger,result,error,duration_ms,pages,skipped\n"
+
+/** maximum length of one line of the log as comma separated values, including the terminating zero */
+#define STANDALONE_LOG_CSV_LINE_LEN 96u
+
+/** result of a job */
+typedef enum standalone_result_e {
+    STANDALONE_RESULT_PASS = 0,                 /**< memory holds the image */
+    STANDALONE_RESULT_FAIL_INTERFACE,           /**< bus is used by another interface */
+    STANDALONE_RESULT_FAIL_IMAGE,               /**< image is not available or meant for another memory */
+    STANDALONE_RESULT_FAIL_PROGRAM,             /**< bootloader failed */
+    STANDALONE_RESULT_CANCELLED,                /**< job was cancelled before the memory was programmed */
+} standalone_result_t;
+
+/** source which started a job */
+typedef enum standalone_trigger_e {
+    STANDALONE_TRIGGER_REST = 0,                /**< REST API request */
+    STANDALONE_TRIGGER_GPIO,                    /**< edge on the trigger input */
+} standalone_trigger_t;
+
+/** logged job */
+typedef struct standalone_record_s {
+    uint32_t job;                               /**< sequence number of the job, starting at 1 */
+    uint32_t uptime_s;                          /**< uptime at the start of the job (s) */
+    uint32_t duration_ms;                       /**< duration of the job (ms) */
+    uint16_t pages;                             /**< number of programmed pages */
+    uint16_t skipped;                           /**< number of pages skipped by a differential program */
+    uint8_t trigger;                            /**< standalone_trigger_t */
+    uint8_t result;                             /**< standalone_result_t */
+    int16_t error;                              /**< error code of the bootloader (ppm_err_t) */
+} standalone_record_t;
+
+/** counters of all jobs since the log was cleared */
+typedef struct standalone_counters_s {
+    uint32_t jobs;                              /**< number of jobs */
+    uint32_t passed;                            /**< number of passed jobs */
+    uint32_t failed;                            /**< number of failed jobs */
+    uint32_t min_ms;                            /**< shortest passed job (ms), 0 when none passed */
+    uint32_t max_ms;                            /**< longest passed job (ms) */
+    uint64_t total_ms;                          /**< total duration of the passed jobs (ms) */
+} standalone_counters_t;
+
+/** cycle-time log */
+typedef struct standalone_log_s {
+    uint32_t magic;                             /**< STANDALONE_LOG_MAGIC */
+    uint32_t nr_of_records;                     /**< number of jobs in the ring */
+    uint32_t next;                              /**< position of the next job in the ring */
+    standalone_counters_t counters;             /**< counters of all jobs */
+    standalone_record_t records[STANDALONE_LOG_MAX_RECORDS];  /**< last jobs */
+} standalone_log_t;
+
+/** Clear the log
+ *
+ * @param[out]  log  log to clear.
+ */
+void standalone_log_init(standalone_log_t *log);
+
+/** Check a log read back from storage
+ *
+ * @param[in]  log  log to check.
+ * @retval  true  log can be used.
+ * @retval  false  log is corrupt or has another layout.
+ */
+bool standalone_log_valid(const standalone_log_t *log);
+
+/** Add a job to the log, the oldest job is dropped when the ring is full
+ *
+ * @param[in|out]  log  log to add to.
+ * @param[in|out]  record  job to add, the job number is assigned.
+ * @returns  index of the job in the ring.
+ */
+uint32_t standalone_log_add(standalone_log_t *log, standalone_record_t *record);
+
+/** Get the index in the ring of a job in the log
+ *
+ * @param[in]  log  log.
+ * @param[in]  position  position of the job, 0 is the oldest job.
+ * @returns  index of the job in the ring, STANDALONE_LOG_MAX_RECORDS when the position is not in the log.
+ */
+uint32_t standalone_log_index(const standalone_log_t *log, uint32_t position);
+
+/** Get a job from the log
+ *
+ * @param[in]  log  log.
+ * @param[in]  position  position of the job, 0 is the oldest job.
+ * @returns  job, NULL when the position is not in the log.
+ */
+const standalone_record_t *standalone_log_get(const standalone_log_t *log, uint32_t position);
+
+/** Get the average duration of the passed jobs
+ *
+ * @param[in]  counters  counters of the log.
+ * @returns  average duration (ms), 0 when none passed.
+ */
+uint32_t standalone_log_average_ms(const standalone_counters_t *counters);
+
+/** Get the name of a job result
+ *
+ * @param[in]  result  result.
+ * @returns  name of the result.
+ */
+const char *standalone_result_to_string(standalone_result_t result);
+
+/** Format a job as a line of comma separated values, in the order of STANDALONE_LOG_CSV_HEADER
+ *
+ * @param[in]  record  job.
+ * @param[out]  line  line of STANDALONE_LOG_CSV_LINE_LEN characters.
+ * @returns  length of the line.
+ */
+size_t standalone_log_format(const standalone_record_t *record, char *line);
+
+#endif /* STANDALONE_LOG_H_ */
@@ -0,0 +1,511 @@
+/**
+ * @file
+ * @brief Stand-alone programming mode routines.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the implementations of the stand-alone programming mode. A trigger
+ * from the REST API or the trigger input submits a bootloader job with the stored parameters to
+ * the job engine. A task debounces the trigger input before it submits the job.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "driver/gpio.h"
+#include "esp_attr.h"
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "nvs.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+#include "sdkconfig.h"
+
+#include "bus_manager.h"
+#include "device_status.h"
+#include "fw_cache.h"
+#include "fw_image.h"
+#include "jobs.h"
+#include "mlx_err.h"
+#include "ppm_bootloader.h"
+#include "progress.h"
+
+#include "standalone.h"
+
+static const char *TAG = "standalone";
+
+/** key of the job parameters in NVS */
+#define STANDALONE_NVS_CONFIG "config"
+
+/** key of the header of the cycle-time log in NVS */
+#define STANDALONE_NVS_LOG "log"
+
+/** key of a job of the cycle-time log in NVS, formatted with its index in the ring */
+#define STANDALONE_NVS_RECORD "rec%lu"
+
+
+/** notification bit of an edge on the trigger input */
+#define STANDALONE_NOTIFY_GPIO (1u << 0)
+
+/** job parameters */
+static standalone_config_t config;
+
+/** cycle-time log */
+static standalone_log_t job_log;
+
+/** lock of the job parameters and the log */
+static SemaphoreHandle_t standalone_lock = NULL;
+
+/** a job is triggered, queued or running */
+static volatile bool busy = false;
+static portMUX_TYPE busy_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static TaskHandle_t standaloneTaskHandle = NULL;
+
+/** Read a blob from NVS
+ *
+ * @param[in]  key  key of the blob.
+ * @param[out]  data  blob.
+ * @param[in]  length  expected length of the blob.
+ * @retval  true  blob is read and has the expected length.
+ * @retval  false  blob is missing or has another layout.
+ */
+static bool standalone_nvs_read(const char *key, void *data, size_t length);
+
+/** Write a blob to NVS
+ *
+ * @param[in]  key  key of the blob.
+ * @param[in]  data  blob.
+ * @param[in]  length  length of the blob.
+ * @returns  ESP_OK when the blob is stored.
+ */
+static esp_err_t standalone_nvs_write(const char *key, const void *data, size_t length);
+
+/** Read the cycle-time log from NVS, the log is cleared when it is missing or corrupt */
+static void standalone_log_load(void);
+
+/** Write a job and the header of the cycle-time log to NVS
+ *
+ * Only the changed job is written, such that the flash is not worn by rewriting the whole log.
+ *
+ * @param[in]  index  index of the job in the ring, STANDALONE_LOG_MAX_RECORDS to write the header only.
+ * @returns  ESP_OK when the log is stored.
+ */
+static esp_err_t standalone_log_store(uint32_t index);
+
+/** Check whether the stand-alone mode is enabled
+ *
+ * @retval  true  jobs can be triggered.
+ * @retval  false  the mode is disabled.
+ */
+static bool standalone_enabled(void);
+
+/** Trigger input interrupt handler
+ *
+ * @param[in]  arg  not used.
+ */
+static void standalone_gpio_isr(void *arg);
+
+/** Run a job with the current job parameters, in the job worker task
+ *
+ * @param[in]  id  job id.
+ * @param[in]  arg  source of the job (standalone_trigger_t).
+ * @param[out]  error  error code of a failed job.
+ * @retval  true  memory holds the image.
+ * @retval  false  job failed.
+ */
+static bool standalone_run(uint32_t id, void *arg, int32_t *error);
+
+/** Mark the end of a job, also when it was cancelled before it ran
+ *
+ * @param[in]  id  job id.
+ * @param[in]  state  final state of the job.
+ * @param[in]  error  error code of a failed job.
+ * @param[in]  arg  source of the job (standalone_trigger_t).
+ */
+static void standalone_done(uint32_t id, job_state_t state, int32_t error, void *arg);
+
+/** Submit a job, the busy flag is set by the caller
+ *
+ * @param[in]  trigger  source of the job.
+ * @param[out]  job_id  id of the submitted job, may be NULL.
+ * @returns  ESP_OK when the job is submitted, the busy flag is cleared otherwise.
+ */
+static esp_err_t standalone_submit(standalone_trigger_t trigger, uint32_t *job_id);
+
+/** Stand-alone task, debounces the trigger input and submits a job per edge
+ *
+ * @param[in]  pvParameters  not used.
+ */
+static void standalone_task(void *pvParameters);
+
+
+static bool standalone_nvs_read(const char *key, void *data, size_t length) {
+    nvs_handle_t handle;
+    size_t stored = length;
+    esp_err_t err = nvs_open(TAG, NVS_READONLY, &handle);
+
+    if (err == ESP_OK) {
+        err = nvs_get_blob(handle, key, data, &stored);
+        nvs_close(handle);
+    }
+
+    return (err == ESP_OK) && (stored == length);
+}
+
+static esp_err_t standalone_nvs_write(const char *key, const void *data, size_t length) {
+    nvs_handle_t handle;
+    esp_err_t err = nvs_open(TAG, NVS_READWRITE, &handle);
+
+    if (err == ESP_OK) {
+        err = nvs_set_blob(handle, key, data, length);
+        if (err == ESP_OK) {
+            err = nvs_commit(handle);
+        }
+        nvs_close(handle);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "storing %s failed (%s)", key, esp_err_to_name(err));
+    }
+
+    return err;
+}
+
+static void standalone_log_load(void) {
+    bool valid = standalone_nvs_read(STANDALONE_NVS_LOG, &job_log, STANDALONE_LOG_HEADER_LEN) &&
+                 standalone_log_valid(&job_log);
+
+    for (uint32_t position = 0u; valid && (position < job_log.nr_of_records); position++) {
+        char key[NVS_KEY_NAME_MAX_SIZE];
+        uint32_t index = standalone_log_index(&job_log, position);
+        (void)snprintf(key, sizeof(key), STANDALONE_NVS_RECORD, (unsigned long)index);
+        valid = standalone_nvs_read(key, &job_log.records[index], sizeof(standalone_record_t));
+    }
+    if (!valid) {
+        standalone_log_init(&job_log);
+    }
+}
+
+static esp_err_t standalone_log_store(uint32_t index) {
+    esp_err_t retval = ESP_OK;
+
+    if (index < STANDALONE_LOG_MAX_RECORDS) {
+        char key[NVS_KEY_NAME_MAX_SIZE];
+        (void)snprintf(key, sizeof(key), STANDALONE_NVS_RECORD, (unsigned long)index);
+        retval = standalone_nvs_write(key, &job_log.records[index], sizeof(standalone_record_t));
+    }
+    if (retval == ESP_OK) {
+        /* the header is written last, it only counts jobs which are stored */
+        retval = standalone_nvs_write(STANDALONE_NVS_LOG, &job_log, STANDALONE_LOG_HEADER_LEN);
+    }
+
+    return retval;
+}
+
+static bool standalone_enabled(void) {
+    (void)xSemaphoreTake(standalone_lock, portMAX_DELAY);
+    bool enabled = config.enabled;
+    (void)xSemaphoreGive(standalone_lock);
+
+    return enabled;
+}
+
+static void IRAM_ATTR standalone_gpio_isr(void *arg) {
+    BaseType_t woken = pdFALSE;
+    bool start = false;
+
+    (void)arg;
+    portENTER_CRITICAL_ISR(&busy_lock);
+    if (!busy) {
+        busy = true;
+        start = true;
+    }
+    portEXIT_CRITICAL_ISR(&busy_lock);
+
+    if (start) {
+        (void)xTaskNotifyFromISR(standaloneTaskHandle, STANDALONE_NOTIFY_GPIO, eSetBits, &woken);
+        portYIELD_FROM_ISR(woken);
+    }
+}
+
+static bool standalone_run(uint32_t id, void *arg, int32_t *error) {
+    standalone_trigger_t trigger = (standalone_trigger_t)(uintptr_t)arg;
+    standalone_config_t job;
+    standalone_record_t record;
+    fwimg_t image;
+
+    (void)xSemaphoreTake(standalone_lock, portMAX_DELAY);
+    job = config;
+    (void)xSemaphoreGive(standalone_lock);
+
+    memset(&record, 0, sizeof(record));
+    record.trigger = (uint8_t)trigger;
+    record.result = (uint8_t)STANDALONE_RESULT_PASS;
+    int64_t start = esp_timer_get_time();
+    record.uptime_s = (uint32_t)(start / 1000000);
+    devstat_setJobStatus(DEVSTAT_JOB_BUSY);
+
+    fwimg_init_psram(&image);
+    if (jobs_cancel_requested(id)) {
+        record.result = (uint8_t)STANDALONE_RESULT_CANCELLED;
+        *error = MLX_FAIL_JOB_CANCELLED;
+    } else if (busmngr_ClaimInterface(USER_STANDALONE, MODE_BOOTLOADER) != ESP_OK) {
+        record.result = (uint8_t)STANDALONE_RESULT_FAIL_INTERFACE;
+        *error = MLX_FAIL_INTERFACE_NOT_FREE;
+    } else {
+        progress_start(PROGRESS_OP_BOOTLOADER);
+        if ((fwcache_load(job.hash, &image) != ESP_OK) || !fwimg_memory_matches(&image, job.memory)) {
+            record.result = (uint8_t)STANDALONE_RESULT_FAIL_IMAGE;
+            *error = MLX_FAIL_BTL_IMAGE_NOT_CACHED;
+        } else if (jobs_cancel_requested(id)) {
+            /* last point to stop, the program itself cannot be interrupted */
+            record.result = (uint8_t)STANDALONE_RESULT_CANCELLED;
+            *error = MLX_FAIL_JOB_CANCELLED;
+        } else {
+            uint32_t skipped = 0u;
+            ppm_err_t ppmstat = fwcache_ppm_program(job.manpow,
+                                                    job.broadcast,
+                                                    job.bitrate,
+                                                    job.memory,
+                                                    &image,
+                                                    job.differential,
+                                                    &skipped);
+            if (ppmstat == PPM_OK) {
+                record.pages = (uint16_t)(fwimg_pages_present(&image) - skipped);
+                record.skipped = (uint16_t)skipped;
+            } else {
+                record.result = (uint8_t)STANDALONE_RESULT_FAIL_PROGRAM;
+                record.error = (int16_t)ppmstat;
+                *error = MLX_FAIL_BTL_PROGRAMMING_FAILED;
+            }
+        }
+        progress_finish(record.result == (uint8_t)STANDALONE_RESULT_PASS);
+        (void)busmngr_ReleaseInterface(USER_STANDALONE, MODE_BOOTLOADER);
+    }
+    fwimg_free(&image);
+    record.duration_ms = (uint32_t)((esp_timer_get_time() - start) / 1000);
+
+    (void)xSemaphoreTake(standalone_lock, portMAX_DELAY);
+    (void)standalone_log_store(standalone_log_add(&job_log, &record));
+    (void)xSemaphoreGive(standalone_lock);
+
+    devstat_setJobStatus((record.result == (uint8_t)STANDALONE_RESULT_PASS) ? DEVSTAT_JOB_PASS : DEVSTAT_JOB_FAIL);
+    ESP_LOGI(TAG, "job %lu: %s in %lu ms",
+             record.job,
+             standalone_result_to_string((standalone_result_t)record.result),
+             record.duration_ms);
+
+    return (record.result == (uint8_t)STANDALONE_RESULT_PASS);
+}
+
+static void standalone_done(uint32_t id, job_state_t state, int32_t error, void *arg) {
+    (void)id;
+    (void)state;
+    (void)error;
+    (void)arg;
+
+    portENTER_CRITICAL(&busy_lock);
+    busy = false;
+    portEXIT_CRITICAL(&busy_lock);
+}
+
+static esp_err_t standalone_submit(standalone_trigger_t trigger, uint32_t *job_id) {
+    esp_err_t retval = jobs_submit(JOB_KIND_BOOTLOADER,
+                                   standalone_run,
+                                   standalone_done,
+                                   (void *)(uintptr_t)trigger,
+                                   job_id);
+
+    if (retval != ESP_OK) {
+        ESP_LOGW(TAG, "job not submitted (%s)", esp_err_to_name(retval));
+        portENTER_CRITICAL(&busy_lock);
+        busy = false;
+        portEXIT_CRITICAL(&busy_lock);
+    }
+
+    return retval;
+}
+
+static void standalone_task(void *pvParameters) {
+    (void)pvParameters;
+
+    while (1) {
+        uint32_t notification = 0u;
+        (void)xTaskNotifyWait(0u, UINT32_MAX, &notification, portMAX_DELAY);
+
+#if CONFIG_STANDALONE_TRIGGER_GPIO >= 0
+        if ((notification & STANDALONE_NOTIFY_GPIO) != 0u) {
+            /* bouncing and glitches are ignored, the input has to stay active */
+            vTaskDelay(pdMS_TO_TICKS(CONFIG_STANDALONE_TRIGGER_DEBOUNCE));
+            if ((gpio_get_level((gpio_num_t)CONFIG_STANDALONE_TRIGGER_GPIO) != 0) || !standalone_enabled()) {
+                notification &= ~STANDALONE_NOTIFY_GPIO;
+            }
+        }
+#endif
+
+        if ((notification & STANDALONE_NOTIFY_GPIO) != 0u) {
+            (void)standalone_submit(STANDALONE_TRIGGER_GPIO, NULL);
+        } else {
+            portENTER_CRITICAL(&busy_lock);
+            busy = false;
+            portEXIT_CRITICAL(&busy_lock);
+        }
+    }
+}
+
+esp_err_t standalone_init(void) {
+    esp_err_t retval = ESP_OK;
+
+    standalone_lock = xSemaphoreCreateMutex();
+
+    if (!standalone_nvs_read(STANDALONE_NVS_CONFIG, &config, sizeof(config))) {
+        memset(&config, 0, sizeof(config));
+        config.bitrate = 300000u;
+        config.memory = PPM_MEM_FLASH;
+    }
+    standalone_log_load();
+
+    /* the index of the cache is rebuilt after a corruption, the pin is restored */
+    if (config.enabled && (fwcache_pin(config.hash, true) != ESP_OK)) {
+        ESP_LOGW(TAG, "image is not cached, jobs will fail");
+    }
+
+    if (xTaskCreate(standalone_task, "standalone", 2048 * 2, NULL, 5, &standaloneTaskHandle) != pdPASS) {
+        retval = ESP_ERR_NO_MEM;
+    }
+
+#if CONFIG_STANDALONE_TRIGGER_GPIO >= 0
+    if (retval == ESP_OK) {
+        const gpio_config_t io_conf = {
+            .pin_bit_mask = 1ull << CONFIG_STANDALONE_TRIGGER_GPIO,
+            .mode = GPIO_MODE_INPUT,
+            .pull_up_en = GPIO_PULLUP_ENABLE,
+            .pull_down_en = GPIO_PULLDOWN_DISABLE,
+            .intr_type = GPIO_INTR_NEGEDGE,
+        };
+        retval = gpio_config(&io_conf);
+        if (retval == ESP_OK) {
+            /* the service may have been installed by another module */
+            retval = gpio_install_isr_service(0);
+            if (retval == ESP_ERR_INVALID_STATE) {
+                retval = ESP_OK;
+            }
+        }
+        if (retval == ESP_OK) {
+            retval = gpio_isr_handler_add((gpio_num_t)CONFIG_STANDALONE_TRIGGER_GPIO, standalone_gpio_isr, NULL);
+        }
+    }
+#endif
+
+    if (retval == ESP_OK) {
+        ESP_LOGI(TAG, "%s, %lu jobs logged", config.enabled ? "enabled" : "disabled", job_log.counters.jobs);
+    } else {
+        ESP_LOGE(TAG, "initialization failed (%s)", esp_err_to_name(retval));
+    }
+
+    return retval;
+}
+
+void standalone_get_config(standalone_config_t *config_out) {
+    (void)xSemaphoreTake(standalone_lock, portMAX_DELAY);
+    *config_out = config;
+    (void)xSemaphoreGive(standalone_lock);
+}
+
+esp_err_t standalone_set_config(const standalone_config_t *config_in) {
+    esp_err_t retval = ESP_OK;
+
+    if ((config_in->bitrate == 0u) ||
+        ((config_in->memory != PPM_MEM_NVRAM) &&
+         (config_in->memory != PPM_MEM_FLASH) &&
+         (config_in->memory != PPM_MEM_FLASH_CS))) {
+        retval = ESP_ERR_INVALID_ARG;
+    } else if (busy) {
+        retval = ESP_ERR_INVALID_STATE;
+    } else {
+        (void)xSemaphoreTake(standalone_lock, portMAX_DELAY);
+        if (config_in->enabled) {
+            retval = fwcache_pin(config_in->hash, true);
+        }
+        if (retval == ESP_OK) {
+            bool same_image = (memcmp(config.hash, config_in->hash, FWCACHE_HASH_LEN) == 0);
+            if (config.enabled && (!config_in->enabled || !same_image)) {
+                (void)fwcache_pin(config.hash, false);
+            }
+            config = *config_in;
+            retval = standalone_nvs_write(STANDALONE_NVS_CONFIG, &config, sizeof(config));
+        }
+        (void)xSemaphoreGive(standalone_lock);
+    }
+
+    return retval;
+}
+
+esp_err_t standalone_trigger(standalone_trigger_t trigger, uint32_t *job_id) {
+    esp_err_t retval = ESP_ERR_INVALID_STATE;
+
+    if ((standaloneTaskHandle != NULL) && standalone_enabled()) {
+        portENTER_CRITICAL(&busy_lock);
+        if (!busy) {
+            busy = true;
+            retval = ESP_OK;
+        }
+        portEXIT_CRITICAL(&busy_lock);
+    }
+    if (retval == ESP_OK) {
+        if (trigger == STANDALONE_TRIGGER_GPIO) {
+            (void)xTaskNotify(standaloneTaskHandle, STANDALONE_NOTIFY_GPIO, eSetBits);
+        } else {
+            retval = standalone_submit(trigger, job_id);
+        }
+    }
+
+    return retval;
+}
+
+bool standalone_busy(void) {
+    return busy;
+}
+
+void standalone_get_counters(standalone_counters_t *counters) {
+    (void)xSemaphoreTake(standalone_lock, portMAX_DELAY);
+    *counters = job_log.counters;
+    (void)xSemaphoreGive(standalone_lock);
+}
+
+bool standalone_get_record(uint32_t position, standalone_record_t *record) {
+    (void)xSemaphoreTake(standalone_lock, portMAX_DELAY);
+    const standalone_record_t *logged = standalone_log_get(&job_log, position);
+    if (logged != NULL) {
+        *record = *logged;
+    }
+    (void)xSemaphoreGive(standalone_lock);
+
+    return (logged != NULL);
+}
+
+esp_err_t standalone_clear_log(void) {
+    (void)xSemaphoreTake(standalone_lock, portMAX_DELAY);
+    standalone_log_init(&job_log);
+    esp_err_t retval = standalone_log_store(STANDALONE_LOG_MAX_RECORDS);
+    (void)xSemaphoreGive(standalone_lock);
+
+    return retval;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file
+ * @brief Stand-alone programming cycle-time log routines.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @ingroup application
+ *
+ * @details This file contains the implementations of the cycle-time log of the stand-alone mode.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "standalone_log.h"
+
+void standalone_log_init(standalone_log_t *log) {
+    memset(log, 0, sizeof(standalone_log_t));
+    log->magic = STANDALONE_LOG_MAGIC;
+}
+
+bool standalone_log_valid(const standalone_log_t *log) {
+    return (log->magic == STANDALONE_LOG_MAGIC) &&
+           (log->nr_of_records <= STANDALONE_LOG_MAX_RECORDS) &&
+           (log->next < STANDALONE_LOG_MAX_RECORDS) &&
+           (log->counters.jobs == (log->counters.passed + log->counters.failed)) &&
+           (log->nr_of_records <= log->counters.jobs);
+}
+
+uint32_t standalone_log_add(standalone_log_t *log, standalone_record_t *record) {
+    standalone_counters_t *counters = &log->counters;
+    uint32_t index = log->next;
+
+    counters->jobs++;
+    record->job = counters->jobs;
+    if (record->result == (uint8_t)STANDALONE_RESULT_PASS) {
+        counters->passed++;
+        if ((counters->passed == 1u) || (record->duration_ms < counters->min_ms)) {
+            counters->min_ms = record->duration_ms;
+        }
+        if (record->duration_ms > counters->max_ms) {
+            counters->max_ms = record->duration_ms;
+        }
+        counters->total_ms += record->duration_ms;
+    } else {
+        counters->failed++;
+    }
+
+    log->records[index] = *record;
+    log->next = (index + 1u) % STANDALONE_LOG_MAX_RECORDS;
+    if (log->nr_of_records < STANDALONE_LOG_MAX_RECORDS) {
+        log->nr_of_records++;
+    }
+
+    return index;
+}
+
+uint32_t standalone_log_index(const standalone_log_t *log, uint32_t position) {
+    uint32_t retval = STANDALONE_LOG_MAX_RECORDS;
+
+    if (position < log->nr_of_records) {
+        /* the oldest job is at next once the ring is full */
+        uint32_t oldest = (log->next + STANDALONE_LOG_MAX_RECORDS - log->nr_of_records) % STANDALONE_LOG_MAX_RECORDS;
+        retval = (oldest + position) % STANDALONE_LOG_MAX_RECORDS;
+    }
+
+    return retval;
+}
+
+const standalone_record_t *standalone_log_get(const standalone_log_t *log, uint32_t position) {
+    const standalone_record_t *retval = NULL;
+    uint32_t index = standalone_log_index(log, position);
+
+    if (index < STANDALONE_LOG_MAX_RECORDS) {
+        retval = &log->records[index];
+    }
+
+    return retval;
+}
+
+uint32_t standalone_log_average_ms(const standalone_counters_t *counters) {
+    uint32_t retval = 0u;
+
+    if (counters->passed > 0u) {
+        retval = (uint32_t)(counters->total_ms / counters->passed);
+    }
+
+    return retval;
+}
+
+const char *standalone_result_to_string(standalone_result_t result) {
+    const char *retval = "unknown";
+
+    switch (result) {
+        case STANDALONE_RESULT_PASS:
+            retval = "pass";
+            break;
+        case STANDALONE_RESULT_FAIL_INTERFACE:
+            retval = "interface_busy";
+            break;
+        case STANDALONE_RESULT_FAIL_IMAGE:
+            retval = "image_unavailable";
+            break;
+        case STANDALONE_RESULT_FAIL_PROGRAM:
+            retval = "program_failed";
+            break;
+        case STANDALONE_RESULT_CANCELLED:
+            retval = "cancelled";
+            break;
+        default:
+            break;
+    }
+
+    return retval;
+}
+
+size_t standalone_log_format(const standalone_record_t *record, char *line) {
+    int length = snprintf(line,
+                          STANDALONE_LOG_CSV_LINE_LEN,
+                          "%lu,%lu,%s,%s,%d,%lu,%u,%u\n",
+                          (unsigned long)record->job,
+                          (unsigned long)record->uptime_s,
+                          (record->trigger == (uint8_t)STANDALONE_TRIGGER_GPIO) ? "gpio" : "rest",
+                          standalone_result_to_string((standalone_result_t)record->result),
+                          (int)record->error,
+                          (unsigned long)record->duration_ms,
+                          (unsigned int)record->pages,
+                          (unsigned int)record->skipped);
+
+    return (length > 0) ? (size_t)length : 0u;
+}
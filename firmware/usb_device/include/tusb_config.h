@@ -35,6 +35,14 @@
 extern "C" {
 #endif
 
+#ifndef CONFIG_VENDOR_BULK_RX_FIFO_SIZE
+#   define CONFIG_VENDOR_BULK_RX_FIFO_SIZE 512
+#endif
+
+#ifndef CONFIG_VENDOR_BULK_TX_FIFO_SIZE
+#   define CONFIG_VENDOR_BULK_TX_FIFO_SIZE 1024
+#endif
+
 #ifndef CONFIG_TINYUSB_CDC_ENABLED
 #   define CONFIG_TINYUSB_CDC_ENABLED 0
 #endif
@@ -129,8 +137,8 @@ extern "C" {
 
 // Vendor FIFO size of TX and RX
 // If not configured vendor endpoints will not be buffered
-#define CFG_TUD_VENDOR_RX_BUFSIZE   64
-#define CFG_TUD_VENDOR_TX_BUFSIZE   64
+#define CFG_TUD_VENDOR_RX_BUFSIZE   CONFIG_VENDOR_BULK_RX_FIFO_SIZE
+#define CFG_TUD_VENDOR_TX_BUFSIZE   CONFIG_VENDOR_BULK_TX_FIFO_SIZE
 
 // DFU macros
 #define CFG_TUD_DFU_XFER_BUFSIZE    CONFIG_TINYUSB_DFU_BUFSIZE
@@ -25,37 +25,81 @@
  */
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "esp_log.h"
 #include "esp_system.h"
+#include "esp_timer.h"
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/ringbuf.h"
+#include "freertos/semphr.h"
 #include "freertos/task.h"
 #include "tinyusb.h"
 
 #include "sdkconfig.h"
-#include "mlx_crc.h"
 #include "mlx_err.h"
 
+#include "jobs.h"
+
+#include "usb_vendor_bulk_crc.h"
+#include "usb_vendor_bulk_parser.h"
+
 #include "usb_vendor_bulk.h"
 
 static const char *TAG = "usb-vendor-bulk";
 
+/** number of frames in the transmit frame pool */
+#define BULK_TX_POOL_SIZE 4u
+
+/** time to wait for a frame of the transmit frame pool to become available */
+#define BULK_TX_POOL_TIMEOUT pdMS_TO_TICKS(20)
+
+/** maximum time the bulk task waits for data before the active handler is called again */
+#define BULK_TASK_IDLE_TIMEOUT pdMS_TO_TICKS(1000)
+
+/** frame of the transmit frame pool */
+typedef union bulk_tx_frame_u {
+    bulk_msg_header_t header;
+    uint32_t raw[(BULK_MSG_MAX_LEN + 3u) / 4u];
+} bulk_tx_frame_t;
+
 RingbufHandle_t bulk_rx_buf_handle;
 RingbufHandle_t bulk_tx_buf_handle;
 
 static TaskHandle_t taskHandle;
 static bulk_task_handle_t bulk_task_handle = NULL;
+static volatile uint32_t bulk_task_generation = 0u;
 static mlx_command_handle_t command_handle = NULL;
-
-#define USB_PACKET_HEADER 0xAA55AA55
-typedef struct bulk_msg_header_s {
-    uint32_t header;
-    uint16_t length;
-    uint16_t command;
-    uint32_t reserved;
-} bulk_msg_header_t;
+static bulk_parser_t command_parser;
+static uint32_t command_tag = 0u;
+static TaskHandle_t command_task = NULL;
+static portMUX_TYPE command_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static bulk_tx_frame_t tx_pool[BULK_TX_POOL_SIZE];
+static uint32_t tx_pool_free;
+static StaticSemaphore_t tx_pool_sem_buffer;
+static SemaphoreHandle_t tx_pool_sem;
+/* the transmit statistics are updated from every task which writes, they share the pool lock */
+static portMUX_TYPE tx_pool_lock = portMUX_INITIALIZER_UNLOCKED;
+static bulk_tx_stats_t tx_stats;
+static StaticSemaphore_t tx_lock_buffer;
+static SemaphoreHandle_t tx_lock;
+
+static bulk_rx_stats_t rx_stats;
+static volatile bool rx_stalled = false;
+static StaticSemaphore_t rx_lock_buffer;
+static SemaphoreHandle_t rx_lock;
+
+/* upper bounds (us) of the latency histogram buckets, the last bucket holds all others */
+static const uint32_t latency_bucket_limits[BULK_LATENCY_NR_OF_BUCKETS - 1u] = {
+    100u, 200u, 500u, 1000u, 2000u, 5000u, 10000u, 20000u, 50000u
+};
+/* timestamps are kept as 32 bit (wrapping) values such that they are read atomically */
+static volatile uint32_t rx_timestamp = 0u;
+static uint32_t command_rx_timestamp = 0u;
+static bool command_latency_pending = false;
+static bulk_latency_stats_t latency_stats;
 
 /** Flush the Vendor device ring buffers */
 static void usb_vendor_bulk_flush_buffers(void);
@@ -74,6 +118,66 @@ static void usb_vendor_bulk_task(void *arg);
  */
 static int32_t usb_vendor_bulk_command_handler(char *buffer, int32_t buffer_wr_ptr);
 
+/** Find the transmit pool frame a payload pointer belongs to
+ *
+ * @param[in]  payload  payload pointer as returned by usb_vendor_bulk_response_acquire.
+ * @returns  index in the pool, or BULK_TX_POOL_SIZE when the pointer is not part of the pool.
+ */
+static uint32_t usb_vendor_bulk_pool_index(const uint8_t *payload);
+
+/** Move received data from the endpoint FIFO into the receive ring buffer
+ *
+ * Only the data which fits in the ring buffer is moved. The remainder stays in the FIFO, once the
+ * FIFO is full TinyUSB does not accept new packets and the endpoint NAKs the host.
+ */
+static void usb_vendor_bulk_rx_drain(void);
+
+/** Move pending transmit data from the ring buffer into the endpoint FIFO
+ *
+ * The FIFO is filled as far as possible, as such small messages which are pending at the same time
+ * share USB packets. A short packet is only sent when no more data is pending.
+ */
+static void usb_vendor_bulk_tx_refill(void);
+
+/** Add a command-to-response latency to the histogram
+ *
+ * @param[in]  latency_us  latency in micro seconds.
+ */
+static void usb_vendor_bulk_record_latency(uint32_t latency_us);
+
+/** Encode a message in an acquired frame, queue it for transmission and release the frame
+ *
+ * @param[in]  payload  payload location as returned by usb_vendor_bulk_response_acquire.
+ * @param[in]  tag  tag of the message.
+ * @param[in]  command  command identifier of the message.
+ * @param[in]  datalen  length of the payload.
+ * @retval  true  message is queued for transmission.
+ * @retval  false  message could not be queued.
+ */
+static bool usb_vendor_bulk_frame_send(uint8_t *payload, uint32_t tag, uint16_t command, uint16_t datalen);
+
+/** Handle the commands which are available in every command mode
+ *
+ * @param[in]  command  command identifier.
+ * @param[in]  payload  payload of the received message.
+ * @param[in]  payload_len  length of the payload.
+ * @retval  true  command is handled.
+ * @retval  false  command is not a core command.
+ */
+static bool usb_vendor_bulk_core_command(uint16_t command, const uint8_t *payload, uint16_t payload_len);
+
+/** Handle a valid frame received by the command parser
+ *
+ * @param[in]  ctx  parser context (unused).
+ * @param[in]  header  header of the received message.
+ * @param[in]  payload  payload of the received message.
+ * @param[in]  payload_len  length of the payload.
+ */
+static void usb_vendor_bulk_command_frame(void *ctx,
+                                          const bulk_msg_header_t *header,
+                                          const uint8_t *payload,
+                                          uint16_t payload_len);
+
 
 static void usb_vendor_bulk_flush_buffers(void) {
     size_t item_size;
@@ -90,90 +194,256 @@ static void usb_vendor_bulk_flush_buffers(void) {
     if (item != NULL) {
         vRingbufferReturnItem(bulk_rx_buf_handle, (void *)item);
     }
+
+#if CFG_TUD_VENDOR_RX_BUFSIZE > 0
+    (void)xSemaphoreTake(rx_lock, portMAX_DELAY);
+    tud_vendor_read_flush();
+    rx_stalled = false;
+    (void)xSemaphoreGive(rx_lock);
+#endif
 }
 
 static void usb_vendor_bulk_task(void *arg) {
     (void)arg;
     char *buffer = (char*) malloc(BULK_TASK_BUFFER_LEN);
     int32_t buffer_wr_ptr = 0;
+    uint32_t generation = bulk_task_generation;
 
     while (1) {
-        if (bulk_task_handle != NULL) {
-            buffer_wr_ptr = bulk_task_handle(buffer, buffer_wr_ptr);
-            if (buffer_wr_ptr < 0) {
+        bulk_task_handle_t handle = bulk_task_handle;
+        if (generation != bulk_task_generation) {
+            /* a handler was (re)started */
+            generation = bulk_task_generation;
+            buffer_wr_ptr = 0;
+        }
+        if (handle != NULL) {
+            buffer_wr_ptr = handle(buffer, buffer_wr_ptr);
+            if ((buffer_wr_ptr < 0) && (generation == bulk_task_generation)) {
                 bulk_task_handle = NULL;
             }
         } else {
-            vTaskSuspend(NULL);
-            buffer_wr_ptr = 0;
+            (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
         }
     }
 
     free(buffer);
 }
 
-static int32_t usb_vendor_bulk_command_handler(char *buffer, int32_t buffer_wr_ptr) {
-    int32_t buffer_rd_ptr = 0;
-    size_t item_size = 0;
-    char *item = (char *)xRingbufferReceiveUpTo(bulk_rx_buf_handle,
-                                                &item_size,
-                                                pdMS_TO_TICKS(25),
-                                                BULK_TASK_BUFFER_LEN / 4);
-    if (item != NULL) {
-        if (item_size > 0) {
-            memcpy(&buffer[buffer_wr_ptr], item, item_size);
-            buffer_wr_ptr += item_size;
-            buffer[buffer_wr_ptr] = 0;
+static uint32_t usb_vendor_bulk_pool_index(const uint8_t *payload) {
+    for (uint32_t i = 0; i < BULK_TX_POOL_SIZE; i++) {
+        if (payload == (const uint8_t *)&tx_pool[i].raw[sizeof(bulk_msg_header_t) / 4u]) {
+            return i;
         }
-        vRingbufferReturnItem(bulk_rx_buf_handle, (void *)item);
-    } else {
-        vTaskDelay(pdMS_TO_TICKS(50));
     }
+    return BULK_TX_POOL_SIZE;
+}
 
-    /* TODO add timeout ? */
-    if (buffer_wr_ptr >= (sizeof(bulk_msg_header_t) + 2)) {
-        bulk_msg_header_t * test_header = NULL;
-        while ((buffer_rd_ptr + sizeof(bulk_msg_header_t) + 2) <= buffer_wr_ptr) {
-            test_header = (bulk_msg_header_t*)&buffer[buffer_rd_ptr];
-            if ((test_header->header != USB_PACKET_HEADER) ||
-                (test_header->length > (4096 + sizeof(bulk_msg_header_t) + 2))) {
-                buffer_rd_ptr++;
-            } else {
-                break;
+static void usb_vendor_bulk_rx_drain(void) {
+    static uint8_t chunk[64];
+    /* called from the bulk task and from the TinyUSB task, keep the byte order */
+    (void)xSemaphoreTake(rx_lock, portMAX_DELAY);
+#if CFG_TUD_VENDOR_RX_BUFSIZE > 0
+    uint32_t pending = tud_vendor_available();
+    while (pending > 0u) {
+        size_t room = xRingbufferGetCurFreeSize(bulk_rx_buf_handle);
+        if (room == 0u) {
+            /* keep the data in the FIFO, the bulk task drains it after consuming the ring buffer */
+            if (!rx_stalled) {
+                rx_stats.stalls++;
             }
+            rx_stalled = true;
+            break;
+        }
+        uint32_t count = (pending < sizeof(chunk)) ? pending : sizeof(chunk);
+        if (count > room) {
+            count = room;
         }
+        count = tud_vendor_read(chunk, count);
+        if (count == 0u) {
+            break;
+        }
+        if (xRingbufferSend(bulk_rx_buf_handle, chunk, count, 0) == pdFALSE) {
+            rx_stats.overflows++;
+        }
+        rx_stats.bytes += count;
+        pending -= count;
+    }
+    if (pending == 0u) {
+        rx_stalled = false;
+    }
+    uint32_t used = BULK_TASK_BUFFER_LEN - xRingbufferGetCurFreeSize(bulk_rx_buf_handle);
+    if (used > rx_stats.ring_high_water) {
+        rx_stats.ring_high_water = used;
+    }
+#endif
+    (void)xSemaphoreGive(rx_lock);
+}
 
-        if ((test_header != NULL) &&
-            (test_header->header == USB_PACKET_HEADER) &&
-            ((buffer_wr_ptr - buffer_rd_ptr) >= test_header->length)) {
-            /* handle message */
-            uint16_t calc_crc = crc_calc16bitCrc((const uint8_t*)&buffer[buffer_rd_ptr],
-                                                 test_header->length - 2,
-                                                 0x1D0Fu);
-            uint16_t mess_crc = *((uint16_t*)&buffer[buffer_rd_ptr + test_header->length - 2u]);
-            if (mess_crc == calc_crc) {
-                bool handled = false;
-                if (command_handle != NULL) {
-                    handled = command_handle(test_header->command,
-                                             (const uint8_t*)&buffer[buffer_rd_ptr + sizeof(bulk_msg_header_t)],
-                                             test_header->length - sizeof(bulk_msg_header_t) - 2);
-                }
-                if (handled == false) {
-                    usb_vendor_bulk_write_error(test_header->command,
-                                                MLX_FAIL_COMMAND_UNKNOWN,
-                                                mlxerr_ErrorCodeToName(MLX_FAIL_COMMAND_UNKNOWN));
+static void usb_vendor_bulk_tx_refill(void) {
+    /* called from the bulk task and from the TinyUSB task, keep the byte order */
+    (void)xSemaphoreTake(tx_lock, portMAX_DELAY);
+    uint32_t available = tud_vendor_write_available();
+    bool written = false;
+    while (available > 0u) {
+        size_t item_size;
+        char *item = (char *)xRingbufferReceiveUpTo(bulk_tx_buf_handle, &item_size, 0, available);
+        if (item == NULL) {
+            break;
+        }
+        /* a wrapped ring buffer is received as two items */
+        (void)tud_vendor_write(item, item_size);
+        vRingbufferReturnItem(bulk_tx_buf_handle, (void *)item);
+        available -= item_size;
+        taskENTER_CRITICAL(&tx_pool_lock);
+        tx_stats.usb_bytes += item_size;
+        taskEXIT_CRITICAL(&tx_pool_lock);
+        written = true;
+    }
+    if (written) {
+        taskENTER_CRITICAL(&tx_pool_lock);
+        tx_stats.usb_refills++;
+        taskEXIT_CRITICAL(&tx_pool_lock);
+        tud_vendor_write_flush();
+    }
+    (void)xSemaphoreGive(tx_lock);
+}
+
+static void usb_vendor_bulk_record_latency(uint32_t latency_us) {
+    uint32_t bucket = 0u;
+    while ((bucket < (BULK_LATENCY_NR_OF_BUCKETS - 1u)) && (latency_us >= latency_bucket_limits[bucket])) {
+        bucket++;
+    }
+    latency_stats.buckets[bucket]++;
+    if ((latency_stats.count == 0u) || (latency_us < latency_stats.min_us)) {
+        latency_stats.min_us = latency_us;
+    }
+    if (latency_us > latency_stats.max_us) {
+        latency_stats.max_us = latency_us;
+    }
+    latency_stats.count++;
+}
+
+static bool usb_vendor_bulk_core_command(uint16_t command, const uint8_t *payload, uint16_t payload_len) {
+    bool handled = true;
+
+    switch (command) {
+        case MCM_BULK_MSG_GET_STATS:
+        {
+            bulk_stats_t *stats = (bulk_stats_t *)usb_vendor_bulk_response_acquire();
+            if (stats != NULL) {
+                usb_vendor_bulk_get_stats(stats);
+                (void)usb_vendor_bulk_response_send((uint8_t *)stats, command, sizeof(bulk_stats_t));
+            }
+            break;
+        }
+
+        case MCM_BULK_MSG_GET_CREDITS:
+        {
+            bulk_credits_t credits = {
+                .credits = usb_vendor_bulk_rx_credits(),
+                .ring_size = BULK_TASK_BUFFER_LEN,
+            };
+            (void)usb_vendor_bulk_write_response(command, (const uint8_t *)&credits, sizeof(credits));
+            break;
+        }
+
+        case MCM_BULK_MSG_GET_LATENCY:
+        {
+            bulk_latency_stats_t *stats = (bulk_latency_stats_t *)usb_vendor_bulk_response_acquire();
+            if (stats != NULL) {
+                /* the request itself is not part of the reported histogram */
+                taskENTER_CRITICAL(&command_lock);
+                command_latency_pending = false;
+                memcpy(stats, &latency_stats, sizeof(bulk_latency_stats_t));
+                if ((payload_len > 0u) && (payload[0] != 0u)) {
+                    memset(&latency_stats, 0, sizeof(bulk_latency_stats_t));
                 }
-                /* frame handled, drop it */
-                buffer_rd_ptr += test_header->length;
-            } else {
-                buffer_rd_ptr++;
+                taskEXIT_CRITICAL(&command_lock);
+                (void)usb_vendor_bulk_response_send((uint8_t *)stats, command, sizeof(bulk_latency_stats_t));
             }
+            break;
         }
 
-        if (buffer_rd_ptr != 0) {
-            memcpy(&buffer[0], &buffer[buffer_rd_ptr], buffer_wr_ptr - buffer_rd_ptr);
-            buffer_wr_ptr -= buffer_rd_ptr;
+        case MCM_BULK_MSG_JOB_LIST:
+        {
+            job_info_t *infos = (job_info_t *)usb_vendor_bulk_response_acquire();
+            if (infos != NULL) {
+                size_t count = jobs_list(infos, BULK_MSG_MAX_PAYLOAD_LEN / sizeof(job_info_t));
+                (void)usb_vendor_bulk_response_send((uint8_t *)infos,
+                                                    command,
+                                                    (uint16_t)(count * sizeof(job_info_t)));
+            }
+            break;
         }
+
+        case MCM_BULK_MSG_JOB_CANCEL:
+        {
+            uint32_t id;
+            if (payload_len != sizeof(id)) {
+                (void)usb_vendor_bulk_write_error(command,
+                                                  MLX_FAIL_INV_DATA_LEN,
+                                                  mlxerr_ErrorCodeToName(MLX_FAIL_INV_DATA_LEN));
+                break;
+            }
+            memcpy(&id, payload, sizeof(id));
+            job_cancel_result_t result = jobs_cancel(id);
+            if (result == JOB_CANCEL_UNKNOWN) {
+                (void)usb_vendor_bulk_write_error(command, MLX_FAIL_UNKNOWN_ERROR, "Job unknown");
+            } else if (result == JOB_CANCEL_TOO_LATE) {
+                (void)usb_vendor_bulk_write_error(command, MLX_FAIL_UNKNOWN_ERROR, "Job already finished");
+            } else {
+                uint8_t cancelled = (result == JOB_CANCEL_DONE) ? 1u : 0u;
+                (void)usb_vendor_bulk_write_response(command, &cancelled, sizeof(cancelled));
+            }
+            break;
+        }
+
+        default:
+            handled = false;
+            break;
+    }
+
+    return handled;
+}
+
+static void usb_vendor_bulk_command_frame(void *ctx,
+                                          const bulk_msg_header_t *header,
+                                          const uint8_t *payload,
+                                          uint16_t payload_len) {
+    (void)ctx;
+    bool handled = false;
+    /* commands are handled one after the other, the responses written meanwhile by this task carry its tag */
+    taskENTER_CRITICAL(&command_lock);
+    command_tag = header->tag;
+    command_task = xTaskGetCurrentTaskHandle();
+    command_latency_pending = true;
+    taskEXIT_CRITICAL(&command_lock);
+    handled = usb_vendor_bulk_core_command(header->command, payload, payload_len);
+    if ((handled == false) && (command_handle != NULL)) {
+        handled = command_handle(header->command, payload, payload_len);
+    }
+    if (handled == false) {
+        usb_vendor_bulk_write_error(header->command,
+                                    MLX_FAIL_COMMAND_UNKNOWN,
+                                    mlxerr_ErrorCodeToName(MLX_FAIL_COMMAND_UNKNOWN));
+    }
+    taskENTER_CRITICAL(&command_lock);
+    command_tag = 0u;
+    command_task = NULL;
+    command_latency_pending = false;
+    taskEXIT_CRITICAL(&command_lock);
+}
+
+static int32_t usb_vendor_bulk_command_handler(char *buffer, int32_t buffer_wr_ptr) {
+    (void)buffer;
+    size_t item_size = 0;
+    const uint8_t *item = (const uint8_t *)usb_vendor_bulk_receive(&item_size, BULK_TASK_IDLE_TIMEOUT);
+    if (item != NULL) {
+        /* all received data arrived at or before the last receive callback */
+        command_rx_timestamp = rx_timestamp;
+        /* parse in place, a wrapped ring buffer is received as two items */
+        usb_vendor_bulk_parser_feed(&command_parser, item, item_size);
+        vRingbufferReturnItem(bulk_rx_buf_handle, (void *)item);
     }
 
     return buffer_wr_ptr;
@@ -181,6 +451,15 @@ static int32_t usb_vendor_bulk_command_handler(char *buffer, int32_t buffer_wr_p
 
 esp_err_t usb_vendor_bulk_init(void) {
     bulk_task_handle = NULL;
+    if (!usb_vendor_bulk_crc_init()) {
+        ESP_LOGW(TAG, "crc tables do not match crc_calc16bitCrc, using the reference routine");
+    }
+    usb_vendor_bulk_parser_init(&command_parser, usb_vendor_bulk_command_frame, NULL);
+
+    tx_pool_free = (1u << BULK_TX_POOL_SIZE) - 1u;
+    tx_pool_sem = xSemaphoreCreateCountingStatic(BULK_TX_POOL_SIZE, BULK_TX_POOL_SIZE, &tx_pool_sem_buffer);
+    tx_lock = xSemaphoreCreateMutexStatic(&tx_lock_buffer);
+    rx_lock = xSemaphoreCreateMutexStatic(&rx_lock_buffer);
 
     bulk_rx_buf_handle = xRingbufferCreate(BULK_TASK_BUFFER_LEN, RINGBUF_TYPE_BYTEBUF);
     if (bulk_rx_buf_handle == NULL) {
@@ -201,7 +480,8 @@ esp_err_t usb_vendor_bulk_start_raw(bulk_task_handle_t handle) {
     if (bulk_task_handle == NULL) {
         usb_vendor_bulk_flush_buffers();
         bulk_task_handle = handle;
-        vTaskResume(taskHandle);
+        bulk_task_generation++;
+        usb_vendor_bulk_wake();
         retval = ESP_OK;
     }
 
@@ -213,6 +493,7 @@ esp_err_t usb_vendor_bulk_start_command(mlx_command_handle_t handle) {
 
     if (bulk_task_handle == NULL) {
         command_handle = handle;
+        usb_vendor_bulk_parser_reset(&command_parser);
         retval = usb_vendor_bulk_start_raw(usb_vendor_bulk_command_handler);
     }
 
@@ -222,76 +503,242 @@ esp_err_t usb_vendor_bulk_start_command(mlx_command_handle_t handle) {
 esp_err_t usb_vendor_bulk_stop(void) {
     bulk_task_handle = NULL;
     command_handle = NULL;
+    usb_vendor_bulk_wake();
     return ESP_OK;
 }
 
+uint32_t usb_vendor_bulk_rx_credits(void) {
+    uint32_t credits = xRingbufferGetCurFreeSize(bulk_rx_buf_handle);
+#if CFG_TUD_VENDOR_RX_BUFSIZE > 0
+    uint32_t pending = tud_vendor_available();
+    credits = (credits > pending) ? (credits - pending) : 0u;
+#endif
+    return credits;
+}
+
+uint32_t usb_vendor_bulk_current_tag(void) {
+    taskENTER_CRITICAL(&command_lock);
+    uint32_t tag = command_tag;
+    taskEXIT_CRITICAL(&command_lock);
+
+    return tag;
+}
+
+void usb_vendor_bulk_wake(void) {
+    (void)xTaskNotifyGive(taskHandle);
+}
+
+void *usb_vendor_bulk_receive(size_t *item_size, TickType_t timeout) {
+    if (rx_stalled) {
+        /* the previous items are returned, continue with the data held back in the FIFO */
+        usb_vendor_bulk_rx_drain();
+    }
+    void *item = xRingbufferReceiveUpTo(bulk_rx_buf_handle, item_size, 0, BULK_TASK_BUFFER_LEN / 4);
+    if (item == NULL) {
+        /* data received meanwhile has left a notification pending, as such nothing is missed */
+        (void)ulTaskNotifyTake(pdTRUE, timeout);
+        item = xRingbufferReceiveUpTo(bulk_rx_buf_handle, item_size, 0, BULK_TASK_BUFFER_LEN / 4);
+    }
+    if (item == NULL) {
+        *item_size = 0u;
+    }
+    return item;
+}
+
 void usb_vendor_bulk_write_raw(const char *buffer, uint32_t length) {
-    (void)xRingbufferSend(bulk_tx_buf_handle, buffer, length, pdMS_TO_TICKS(20));
-    if (tud_vendor_write_available()) {
-        tud_vendor_tx_cb(0u, 0u);
+    if (xRingbufferSend(bulk_tx_buf_handle, buffer, length, pdMS_TO_TICKS(20)) == pdFALSE) {
+        taskENTER_CRITICAL(&tx_pool_lock);
+        tx_stats.ring_full++;
+        taskEXIT_CRITICAL(&tx_pool_lock);
+    } else {
+        uint32_t pending = BULK_TASK_BUFFER_LEN - xRingbufferGetCurFreeSize(bulk_tx_buf_handle);
+        taskENTER_CRITICAL(&tx_pool_lock);
+        if (pending > tx_stats.ring_high_water) {
+            tx_stats.ring_high_water = pending;
+        }
+        taskEXIT_CRITICAL(&tx_pool_lock);
     }
+    usb_vendor_bulk_tx_refill();
 }
 
 void usb_vendor_bulk_write_string(const char *buffer) {
     usb_vendor_bulk_write_raw(buffer, strlen(buffer));
 }
 
-bool usb_vendor_bulk_write_response(uint16_t command, const uint8_t * data, uint16_t datalen) {
+uint8_t *usb_vendor_bulk_response_acquire(void) {
+    if (xSemaphoreTake(tx_pool_sem, 0) == pdFALSE) {
+        taskENTER_CRITICAL(&tx_pool_lock);
+        tx_stats.pool_exhausted++;
+        taskEXIT_CRITICAL(&tx_pool_lock);
+        if (xSemaphoreTake(tx_pool_sem, BULK_TX_POOL_TIMEOUT) == pdFALSE) {
+            taskENTER_CRITICAL(&tx_pool_lock);
+            tx_stats.pool_failures++;
+            taskEXIT_CRITICAL(&tx_pool_lock);
+            return NULL;
+        }
+    }
+
+    taskENTER_CRITICAL(&tx_pool_lock);
+    uint32_t index = (uint32_t)__builtin_ctz(tx_pool_free);
+    tx_pool_free &= ~(1u << index);
+    tx_stats.pool_in_use++;
+    if (tx_stats.pool_in_use > tx_stats.pool_high_water) {
+        tx_stats.pool_high_water = tx_stats.pool_in_use;
+    }
+    taskEXIT_CRITICAL(&tx_pool_lock);
+
+    return (uint8_t *)&tx_pool[index].raw[sizeof(bulk_msg_header_t) / 4u];
+}
+
+void usb_vendor_bulk_response_release(uint8_t *payload) {
+    uint32_t index = usb_vendor_bulk_pool_index(payload);
+    if (index < BULK_TX_POOL_SIZE) {
+        taskENTER_CRITICAL(&tx_pool_lock);
+        tx_pool_free |= (1u << index);
+        tx_stats.pool_in_use--;
+        taskEXIT_CRITICAL(&tx_pool_lock);
+        (void)xSemaphoreGive(tx_pool_sem);
+    }
+}
+
+static bool usb_vendor_bulk_frame_send(uint8_t *payload, uint32_t tag, uint16_t command, uint16_t datalen) {
     bool retval = false;
-    uint16_t messlen = sizeof(bulk_msg_header_t) + datalen + 2u;
-    uint8_t *message = calloc(messlen, sizeof(uint8_t));
-    if (message != NULL) {
-        bulk_msg_header_t *messheader = (bulk_msg_header_t*)message;
-        messheader->header = USB_PACKET_HEADER;
-        messheader->length = messlen;
-        messheader->command = command;
-        messheader->reserved = 0u;
-        memcpy(&message[sizeof(bulk_msg_header_t)], data, datalen);
-        *((uint16_t*)&message[messlen - 2u]) = crc_calc16bitCrc(message, messlen - 2u, 0x1D0Fu);
+    uint32_t index = usb_vendor_bulk_pool_index(payload);
+    if ((index < BULK_TX_POOL_SIZE) && (datalen <= BULK_MSG_MAX_PAYLOAD_LEN)) {
+        uint8_t *message = (uint8_t *)tx_pool[index].raw;
+        uint16_t messlen = usb_vendor_bulk_parser_encode(message, tag, command, payload, datalen);
         usb_vendor_bulk_write_raw((const char*)message, messlen);
+        taskENTER_CRITICAL(&tx_pool_lock);
+        tx_stats.frames++;
+        taskEXIT_CRITICAL(&tx_pool_lock);
         retval = true;
     }
+    usb_vendor_bulk_response_release(payload);
+    return retval;
+}
+
+bool usb_vendor_bulk_response_send(uint8_t *payload, uint16_t command, uint16_t datalen) {
+    uint32_t tag = 0u;
+    bool own_command = false;
+
+    /* only the task handling the command answers it, a response of another task (e.g. a listener
+     * or a job) neither gets its tag nor ends its latency measurement */
+    taskENTER_CRITICAL(&command_lock);
+    if ((command_task != NULL) && (command_task == xTaskGetCurrentTaskHandle())) {
+        tag = command_tag;
+        own_command = true;
+    }
+    taskEXIT_CRITICAL(&command_lock);
+
+    bool retval = usb_vendor_bulk_frame_send(payload, tag, command, datalen);
+    if (retval && own_command) {
+        uint32_t latency_us = (uint32_t)esp_timer_get_time() - command_rx_timestamp;
+        taskENTER_CRITICAL(&command_lock);
+        if (command_latency_pending) {
+            command_latency_pending = false;
+            usb_vendor_bulk_record_latency(latency_us);
+        }
+        taskEXIT_CRITICAL(&command_lock);
+    }
+    return retval;
+}
+
+bool usb_vendor_bulk_write_response(uint16_t command, const uint8_t * data, uint16_t datalen) {
+    bool retval = false;
+    if (datalen <= BULK_MSG_MAX_PAYLOAD_LEN) {
+        uint8_t *payload = usb_vendor_bulk_response_acquire();
+        if (payload != NULL) {
+            if (datalen > 0u) {
+                memcpy(payload, data, datalen);
+            }
+            retval = usb_vendor_bulk_response_send(payload, command, datalen);
+        }
+    }
     return retval;
 }
 
+bool usb_vendor_bulk_write_notification(uint32_t tag, uint16_t command, const uint8_t * data, uint16_t datalen) {
+    bool retval = false;
+    if (datalen <= BULK_MSG_MAX_PAYLOAD_LEN) {
+        uint8_t *payload = usb_vendor_bulk_response_acquire();
+        if (payload != NULL) {
+            if (datalen > 0u) {
+                memcpy(payload, data, datalen);
+            }
+            retval = usb_vendor_bulk_frame_send(payload, tag, command, datalen);
+        }
+    }
+    return retval;
+}
+
+/** Build the payload of an error report
+ *
+ * @param[out]  payload  payload location as returned by usb_vendor_bulk_response_acquire.
+ * @param[in]  command  command identifier which failed.
+ * @param[in]  error  error code.
+ * @param[in]  error_msg  error message.
+ * @returns  length of the payload.
+ */
+static uint16_t usb_vendor_bulk_error_payload(uint8_t *payload, uint16_t command, int error, const char *error_msg) {
+    size_t msglen = strnlen(error_msg, BULK_MSG_MAX_PAYLOAD_LEN - 4u);
+    payload[0] = (uint8_t)(command & 0xFFu);
+    payload[1] = (uint8_t)(command >> 8);
+    payload[2] = (uint8_t)((uint16_t)error & 0xFFu);
+    payload[3] = (uint8_t)((uint16_t)error >> 8);
+    memcpy(&payload[4], error_msg, msglen);
+    return (uint16_t)(4u + msglen);
+}
+
 bool usb_vendor_bulk_write_error(uint16_t command, int error, const char *error_msg) {
-    uint16_t datalen = 2u + 2u + strlen(error_msg);
-    uint8_t *data = calloc(datalen, sizeof(uint8_t));
-    if (data != NULL) {
-        *(uint16_t*)(&data[0]) = command;
-        *(uint16_t*)(&data[2]) = error;
-        memcpy(&data[4], error_msg, strlen(error_msg));
-        return usb_vendor_bulk_write_response(MCM_BULK_MSG_ERROR_REPORT, (const uint8_t*)data, datalen);
-    }
-    return false;
+    bool retval = false;
+    uint8_t *payload = usb_vendor_bulk_response_acquire();
+    if (payload != NULL) {
+        uint16_t datalen = usb_vendor_bulk_error_payload(payload, command, error, error_msg);
+        retval = usb_vendor_bulk_response_send(payload, MCM_BULK_MSG_ERROR_REPORT, datalen);
+    }
+    return retval;
+}
+
+bool usb_vendor_bulk_write_error_notification(uint32_t tag, uint16_t command, int error, const char *error_msg) {
+    bool retval = false;
+    uint8_t *payload = usb_vendor_bulk_response_acquire();
+    if (payload != NULL) {
+        uint16_t datalen = usb_vendor_bulk_error_payload(payload, command, error, error_msg);
+        retval = usb_vendor_bulk_frame_send(payload, tag, MCM_BULK_MSG_ERROR_REPORT, datalen);
+    }
+    return retval;
+}
+
+void usb_vendor_bulk_get_stats(bulk_stats_t *stats) {
+    stats->parser = command_parser.stats;
+    stats->rx = rx_stats;
+    taskENTER_CRITICAL(&tx_pool_lock);
+    stats->tx = tx_stats;
+    taskEXIT_CRITICAL(&tx_pool_lock);
 }
 
 void tud_vendor_rx_cb(uint8_t itf, uint8_t const* buffer, uint16_t bufsize) {
     (void)itf;
+#if CFG_TUD_VENDOR_RX_BUFSIZE > 0
+    /* the received data is buffered in the endpoint FIFO, move what fits in the ring buffer */
+    (void)buffer;
+    (void)bufsize;
+    usb_vendor_bulk_rx_drain();
+#else
     BaseType_t pxHigherPriorityTaskWoken;
     if (xRingbufferSendFromISR(bulk_rx_buf_handle, buffer, (size_t)bufsize,
                                &pxHigherPriorityTaskWoken) == pdFALSE) {
+        rx_stats.overflows++;
         ESP_LOGE(TAG, "not enough room in buffer");
     }
-    /** seems CFG_TUD_TASK_QUEUE_SZ is 16 as such this callback shall not take to much time to not drop frames */
-
-    /* if using RX buffered is enabled, we need to flush the buffer to make room for new data */
-#if CFG_TUD_VENDOR_RX_BUFSIZE > 0
-    tud_vendor_read_flush();
 #endif
+    rx_timestamp = (uint32_t)esp_timer_get_time();
+    /* the callback runs in the TinyUSB task, the bulk task has a higher priority and runs right away */
+    (void)xTaskNotifyGive(taskHandle);
 }
 
 void tud_vendor_tx_cb(uint8_t itf, uint32_t sent_bytes) {
     (void)itf;
     (void)sent_bytes;
-    size_t item_size;
-    char *item = (char *)xRingbufferReceiveUpTo(bulk_tx_buf_handle,
-                                                &item_size,
-                                                0,
-                                                tud_vendor_write_available());
-    if (item != NULL) {
-        (void)tud_vendor_write(item, item_size);
-        tud_vendor_write_flush();
-        vRingbufferReturnItem(bulk_tx_buf_handle, (void *)item);
-    }
+    usb_vendor_bulk_tx_refill();
 }
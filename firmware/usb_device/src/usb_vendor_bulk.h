@@ -22,6 +22,13 @@
  * @ingroup lib_usb_device
  *
  * @details Definitions of the vendor device class for the bulk interface.
+ *
+ * In command mode the host can send several commands without waiting for their responses, the
+ * commands are queued in the receive ring buffer and handled in order of arrival. Each response
+ * (and error report) carries the tag of the command it answers, as such the host can match them.
+ *
+ * Received data is never dropped: when the receive ring buffer is full, the data stays in the
+ * endpoint FIFO and the endpoint NAKs the host until the bulk task has made room.
  * @{
  */
 #pragma once
@@ -32,6 +39,8 @@
 #include "freertos/ringbuf.h"
 #include "tinyusb.h"
 
+#include "usb_vendor_bulk_parser.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -51,8 +60,79 @@ typedef int32_t (* bulk_task_handle_t)(char *buffer, int32_t buffer_wr_ptr);
 
 typedef bool (* mlx_command_handle_t)(uint16_t command, const uint8_t * data, uint16_t datalen);
 
+/** bulk interface statistics request, available in every command mode (response: bulk_stats_t) */
+#define MCM_BULK_MSG_GET_STATS 0xFF00
+
+/** receive credits request, available in every command mode (response: bulk_credits_t) */
+#define MCM_BULK_MSG_GET_CREDITS 0xFF02
+
+/** command-to-response latency histogram request, available in every command mode
+ * (optional payload: uint8_t reset after read, response: bulk_latency_stats_t) */
+#define MCM_BULK_MSG_GET_LATENCY 0xFF01
+
+/** job list request, available in every command mode (response: job_info_t array, oldest first) */
+#define MCM_BULK_MSG_JOB_LIST 0xFF03
+
+/** job cancel request, available in every command mode (payload: uint32_t job id,
+ * response: uint8_t 1 when cancelled, 0 when the running job is requested to stop) */
+#define MCM_BULK_MSG_JOB_CANCEL 0xFF04
+
 #define MCM_BULK_MSG_ERROR_REPORT 0xFFFF
 
+/** number of buckets in the latency histogram */
+#define BULK_LATENCY_NR_OF_BUCKETS 10u
+
+/** bulk transmit path statistics */
+typedef struct bulk_tx_stats_s {
+    uint32_t frames;                            /**< number of responses written */
+    uint32_t pool_exhausted;                    /**< number of times no pool frame was available right away */
+    uint32_t pool_failures;                     /**< number of responses dropped as no pool frame became available */
+    uint16_t pool_in_use;                       /**< number of pool frames in use */
+    uint16_t pool_high_water;                   /**< maximum number of pool frames in use at once */
+    uint32_t ring_full;                         /**< number of writes dropped due to a full transmit ring buffer */
+    uint32_t ring_high_water;                   /**< maximum number of bytes pending in the transmit ring buffer */
+    uint32_t usb_bytes;                         /**< number of bytes moved into the endpoint FIFO */
+    uint32_t usb_refills;                       /**< number of times data was moved into the endpoint FIFO */
+} bulk_tx_stats_t;
+
+/** command-to-response latency histogram
+ *
+ * The latency is measured from the reception of the last USB packet of a command up to the moment
+ * its first response is queued for transmission. Bucket upper bounds are 100, 200, 500, 1000, 2000,
+ * 5000, 10000, 20000 and 50000 us, the last bucket holds the longer latencies.
+ */
+typedef struct bulk_latency_stats_s {
+    uint32_t count;                             /**< number of measured commands */
+    uint32_t min_us;                            /**< minimum latency */
+    uint32_t max_us;                            /**< maximum latency */
+    uint32_t buckets[BULK_LATENCY_NR_OF_BUCKETS]; /**< number of commands per latency bucket */
+} bulk_latency_stats_t;
+
+/** bulk receive path statistics */
+typedef struct bulk_rx_stats_s {
+    uint32_t bytes;                             /**< number of bytes moved into the receive ring buffer */
+    uint32_t stalls;                            /**< number of times reception was held back by a full ring buffer */
+    uint32_t overflows;                         /**< number of received packets which were lost */
+    uint32_t ring_high_water;                   /**< maximum number of bytes pending in the receive ring buffer */
+} bulk_rx_stats_t;
+
+/** bulk interface statistics */
+typedef struct bulk_stats_s {
+    bulk_parser_stats_t parser;                 /**< command parser statistics */
+    bulk_rx_stats_t rx;                         /**< receive path statistics */
+    bulk_tx_stats_t tx;                         /**< transmit path statistics */
+} bulk_stats_t;
+
+/** receive credits
+ *
+ * The host can send up to credits bytes without the device holding back reception (NAK). When
+ * more is sent, no data is lost but the transfer is slowed down by the NAKs.
+ */
+typedef struct bulk_credits_s {
+    uint32_t credits;                           /**< number of bytes which can be accepted right away */
+    uint32_t ring_size;                         /**< size of the receive ring buffer */
+} bulk_credits_t;
+
 
 esp_err_t usb_vendor_bulk_init(void);
 
@@ -62,6 +142,34 @@ esp_err_t usb_vendor_bulk_start_command(mlx_command_handle_t handle);
 
 esp_err_t usb_vendor_bulk_stop(void);
 
+/** Get the number of bytes the receive path can accept right away
+ *
+ * @returns  receive credits in bytes.
+ */
+uint32_t usb_vendor_bulk_rx_credits(void);
+
+/** Get the tag of the command which is being handled
+ *
+ * @returns  tag of the command (0 outside of command handling).
+ */
+uint32_t usb_vendor_bulk_current_tag(void);
+
+/** Wake the bulk task such that the active handler is called again
+ *
+ * To be used when a handler has to act on a state change which is not caused by received data.
+ */
+void usb_vendor_bulk_wake(void);
+
+/** Receive data from the bulk interface in a bulk task handler
+ *
+ * Blocks until data is received, the task is woken or the timeout expires.
+ *
+ * @param[out]  item_size  number of received bytes (0 when nothing is received).
+ * @param[in]  timeout  maximum time to wait for data.
+ * @returns  received data to be returned with vRingbufferReturnItem, or NULL.
+ */
+void *usb_vendor_bulk_receive(size_t *item_size, TickType_t timeout);
+
 /**
  *
  */
@@ -69,10 +177,91 @@ void usb_vendor_bulk_write_raw(const char *buffer, uint32_t length);
 
 void usb_vendor_bulk_write_string(const char *buffer);
 
+/** Acquire a frame of the transmit frame pool to build a response in
+ *
+ * Waits shortly when all frames are in use. The acquired frame must be passed to either
+ * usb_vendor_bulk_response_send or usb_vendor_bulk_response_release.
+ *
+ * @returns  payload location of the frame (4 byte aligned, BULK_MSG_MAX_PAYLOAD_LEN bytes), or NULL
+ *           when no frame became available.
+ */
+uint8_t *usb_vendor_bulk_response_acquire(void);
+
+/** Release an acquired frame without sending it
+ *
+ * @param[in]  payload  payload location as returned by usb_vendor_bulk_response_acquire.
+ */
+void usb_vendor_bulk_response_release(uint8_t *payload);
+
+/** Send a response built in an acquired frame and release the frame
+ *
+ * The message is tagged with the tag of the command which is being handled, and ends its latency
+ * measurement, when written by the task handling the command. Otherwise the tag is 0.
+ *
+ * @param[in]  payload  payload location as returned by usb_vendor_bulk_response_acquire.
+ * @param[in]  command  command identifier of the response.
+ * @param[in]  datalen  length of the payload.
+ * @retval  true  response is queued for transmission.
+ * @retval  false  response could not be queued.
+ */
+bool usb_vendor_bulk_response_send(uint8_t *payload, uint16_t command, uint16_t datalen);
+
+/** Write a response message to the host
+ *
+ * The message is tagged with the tag of the command which is being handled.
+ *
+ * @param[in]  command  command identifier of the response.
+ * @param[in]  data  payload of the response.
+ * @param[in]  datalen  length of the payload.
+ * @retval  true  response is queued for transmission.
+ * @retval  false  response could not be queued.
+ */
 bool usb_vendor_bulk_write_response(uint16_t command, const uint8_t * data, uint16_t datalen);
 
+/** Write an unsolicited message to the host
+ *
+ * Can be used from any task, e.g. to stream results of an operation which was started by a command.
+ *
+ * @param[in]  tag  tag of the message (typically the tag of the command which started the operation).
+ * @param[in]  command  command identifier of the message.
+ * @param[in]  data  payload of the message.
+ * @param[in]  datalen  length of the payload.
+ * @retval  true  message is queued for transmission.
+ * @retval  false  message could not be queued.
+ */
+bool usb_vendor_bulk_write_notification(uint32_t tag, uint16_t command, const uint8_t * data, uint16_t datalen);
+
+/** Write an error report to the host
+ *
+ * The report is tagged with the tag of the command which is being handled.
+ *
+ * @param[in]  command  command identifier which failed.
+ * @param[in]  error  error code.
+ * @param[in]  error_msg  error message.
+ * @retval  true  report is queued for transmission.
+ * @retval  false  report could not be queued.
+ */
 bool usb_vendor_bulk_write_error(uint16_t command, int error, const char *error_msg);
 
+/** Write an unsolicited error report to the host
+ *
+ * Can be used from any task, e.g. to report the failure of an operation which was started by a command.
+ *
+ * @param[in]  tag  tag of the report (typically the tag of the command which started the operation).
+ * @param[in]  command  command identifier which failed.
+ * @param[in]  error  error code.
+ * @param[in]  error_msg  error message.
+ * @retval  true  report is queued for transmission.
+ * @retval  false  report could not be queued.
+ */
+bool usb_vendor_bulk_write_error_notification(uint32_t tag, uint16_t command, int error, const char *error_msg);
+
+/** Get the statistics of the bulk interface
+ *
+ * @param[out]  stats  statistics.
+ */
+void usb_vendor_bulk_get_stats(bulk_stats_t *stats);
+
 /** @} */
 
 #ifdef __cplusplus
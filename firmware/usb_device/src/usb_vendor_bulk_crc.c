@@ -0,0 +1,126 @@
+/**
+ * @file
+ * @brief vendor device class - bulk message crc.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @endinternal
+ *
+ * @ingroup lib_usb_device
+ *
+ * @details Implementations of the slice-by-8 crc engine for the vendor bulk command protocol.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mlx_crc.h"
+
+#include "usb_vendor_bulk_crc.h"
+
+#define CRC_POLYNOMIAL 0x1021u
+#define CRC_SLICES 8u
+
+/** state of the crc engine */
+typedef enum crc_engine_state_e {
+    CRC_ENGINE_UNINITIALIZED = 0,               /**< tables are not built yet */
+    CRC_ENGINE_TABLES,                          /**< slice-by-8 tables are in use */
+    CRC_ENGINE_FALLBACK,                        /**< crc_calc16bitCrc is in use */
+} crc_engine_state_t;
+
+static crc_engine_state_t engine_state = CRC_ENGINE_UNINITIALIZED;
+
+/* crc_table[k][b] is the crc contribution of byte b followed by k zero bytes */
+static uint16_t crc_table[CRC_SLICES][256];
+
+/** Update a crc with the slice-by-8 tables
+ *
+ * @param[in]  crc  crc of the preceding data.
+ * @param[in]  data  next chunk of data.
+ * @param[in]  len  length of the chunk.
+ * @returns  crc including the chunk.
+ */
+static uint16_t usb_vendor_bulk_crc_tables(uint16_t crc, const uint8_t *data, size_t len);
+
+
+static uint16_t usb_vendor_bulk_crc_tables(uint16_t crc, const uint8_t *data, size_t len) {
+    while (len >= CRC_SLICES) {
+        /* the crc register overlaps with the first two bytes of the slice */
+        uint16_t first = crc ^ (uint16_t)(((uint16_t)data[0] << 8) | data[1]);
+        crc = crc_table[7][first >> 8] ^
+              crc_table[6][first & 0xFFu] ^
+              crc_table[5][data[2]] ^
+              crc_table[4][data[3]] ^
+              crc_table[3][data[4]] ^
+              crc_table[2][data[5]] ^
+              crc_table[1][data[6]] ^
+              crc_table[0][data[7]];
+        data += CRC_SLICES;
+        len -= CRC_SLICES;
+    }
+    while (len > 0u) {
+        crc = (uint16_t)(crc << 8) ^ crc_table[0][(crc >> 8) ^ *data];
+        data++;
+        len--;
+    }
+    return crc;
+}
+
+bool usb_vendor_bulk_crc_init(void) {
+    if (engine_state != CRC_ENGINE_UNINITIALIZED) {
+        return engine_state == CRC_ENGINE_TABLES;
+    }
+
+    for (uint32_t byte = 0u; byte < 256u; byte++) {
+        uint16_t crc = (uint16_t)(byte << 8);
+        for (uint32_t bit = 0u; bit < 8u; bit++) {
+            crc = ((crc & 0x8000u) != 0u) ? (uint16_t)((crc << 1) ^ CRC_POLYNOMIAL) : (uint16_t)(crc << 1);
+        }
+        crc_table[0][byte] = crc;
+    }
+    for (uint32_t slice = 1u; slice < CRC_SLICES; slice++) {
+        for (uint32_t byte = 0u; byte < 256u; byte++) {
+            uint16_t prev = crc_table[slice - 1u][byte];
+            crc_table[slice][byte] = (uint16_t)(prev << 8) ^ crc_table[0][prev >> 8];
+        }
+    }
+
+    /* check the tables against the reference routine, including the chaining of chunks */
+    uint8_t pattern[67];
+    for (uint32_t i = 0u; i < sizeof(pattern); i++) {
+        pattern[i] = (uint8_t)((i * 151u) + 7u);
+    }
+    uint16_t expected = crc_calc16bitCrc(pattern, sizeof(pattern), 0x1D0Fu);
+    uint16_t chained = usb_vendor_bulk_crc_tables(0x1D0Fu, pattern, 13u);
+    chained = usb_vendor_bulk_crc_tables(chained, &pattern[13], sizeof(pattern) - 13u);
+    if ((usb_vendor_bulk_crc_tables(0x1D0Fu, pattern, sizeof(pattern)) == expected) && (chained == expected)) {
+        engine_state = CRC_ENGINE_TABLES;
+    } else {
+        engine_state = CRC_ENGINE_FALLBACK;
+    }
+
+    return engine_state == CRC_ENGINE_TABLES;
+}
+
+uint16_t usb_vendor_bulk_crc_update(uint16_t crc, const uint8_t *data, size_t len) {
+    if (engine_state == CRC_ENGINE_UNINITIALIZED) {
+        (void)usb_vendor_bulk_crc_init();
+    }
+    if (engine_state == CRC_ENGINE_TABLES) {
+        return usb_vendor_bulk_crc_tables(crc, data, len);
+    }
+    return crc_calc16bitCrc(data, len, crc);
+}
@@ -0,0 +1,67 @@
+/**
+ * @file
+ * @brief vendor device class - bulk message crc.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @endinternal
+ *
+ * @ingroup lib_usb_device
+ *
+ * @details Definitions of the incremental crc engine for the vendor bulk command protocol.
+ *
+ * The engine calculates the same 16 bit crc as crc_calc16bitCrc (polynomial 0x1021, MSB first),
+ * using slice-by-8 lookup tables. The crc can be fed chunk by chunk as the data arrives: the crc
+ * of the preceding chunks is the seed for the next chunk.
+ *
+ * The tables are built on first use and checked against crc_calc16bitCrc. When the check fails,
+ * the engine falls back to crc_calc16bitCrc such that the protocol keeps working.
+ * @{
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Build the lookup tables of the crc engine
+ *
+ * Calling this function is optional (the tables are built on first use), it allows to move the
+ * table generation out of the time critical path.
+ *
+ * @retval  true  table based engine is in use.
+ * @retval  false  engine falls back to crc_calc16bitCrc.
+ */
+bool usb_vendor_bulk_crc_init(void);
+
+/** Update a crc with the next chunk of data
+ *
+ * @param[in]  crc  crc of the preceding data (BULK_MSG_CRC_SEED at the start of a message).
+ * @param[in]  data  next chunk of data.
+ * @param[in]  len  length of the chunk.
+ * @returns  crc including the chunk.
+ */
+uint16_t usb_vendor_bulk_crc_update(uint16_t crc, const uint8_t *data, size_t len);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,330 @@
+/**
+ * @file
+ * @brief vendor device class - bulk frame parser.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @endinternal
+ *
+ * @ingroup lib_usb_device
+ *
+ * @details Implementations of the streaming frame parser for the vendor bulk command protocol.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "usb_vendor_bulk_crc.h"
+
+#include "usb_vendor_bulk_parser.h"
+
+#define BULK_SYNC_LEN 4u
+#define BULK_HDR_LEN sizeof(bulk_msg_header_t)
+
+/** part of the buffered frame which is to be validated next */
+typedef enum bulk_parser_stage_e {
+    STAGE_SYNC = 0,                             /**< synchronization word */
+    STAGE_HEADER,                               /**< remainder of the header */
+    STAGE_FRAME,                                /**< payload and crc */
+} bulk_parser_stage_t;
+
+/* little endian representation of USB_PACKET_HEADER */
+static const uint8_t sync_word[BULK_SYNC_LEN] = {0x55, 0xAA, 0x55, 0xAA};
+
+/** Search the next (partial) synchronization word
+ *
+ * @param[in]  data  data to search in.
+ * @param[in]  len  length of data.
+ * @param[in]  pos  position to start searching from.
+ * @returns  position of the synchronization word, or of a partial one at the end of data, or len.
+ */
+static size_t usb_vendor_bulk_parser_find_sync(const uint8_t *data, size_t len, size_t pos);
+
+/** Check whether the length field of a header is valid
+ *
+ * @param[in]  length  length field of the header.
+ * @retval  true  length is valid.
+ * @retval  false  length is invalid.
+ */
+static bool usb_vendor_bulk_parser_valid_length(uint16_t length);
+
+/** Process a segment while no partial frame is buffered
+ *
+ * @param[in|out]  parser  parser to use.
+ * @param[in]  data  received segment.
+ * @param[in]  len  length of the received segment.
+ * @param[in]  pos  position in the segment to start from.
+ * @returns  new position in the segment.
+ */
+static size_t usb_vendor_bulk_parser_scan(bulk_parser_t *parser, const uint8_t *data, size_t len, size_t pos);
+
+/** Extend the buffered partial frame with data from a segment
+ *
+ * @param[in|out]  parser  parser to use.
+ * @param[in]  data  received segment.
+ * @param[in]  len  length of the received segment.
+ * @returns  number of bytes consumed from the segment.
+ */
+static size_t usb_vendor_bulk_parser_append(bulk_parser_t *parser, const uint8_t *data, size_t len);
+
+/** Drop the first byte of the buffered frame and search for the next synchronization word in it
+ *
+ * @param[in|out]  parser  parser to use.
+ */
+static void usb_vendor_bulk_parser_resync(bulk_parser_t *parser);
+
+/** Update the running crc of the buffered frame with newly appended bytes
+ *
+ * @param[in|out]  parser  parser to use.
+ */
+static void usb_vendor_bulk_parser_update_crc(bulk_parser_t *parser);
+
+
+static size_t usb_vendor_bulk_parser_find_sync(const uint8_t *data, size_t len, size_t pos) {
+    while (pos < len) {
+        const uint8_t *hit = memchr(&data[pos], sync_word[0], len - pos);
+        if (hit == NULL) {
+            break;
+        }
+        pos = (size_t)(hit - data);
+        size_t cmp_len = len - pos;
+        if (cmp_len > BULK_SYNC_LEN) {
+            cmp_len = BULK_SYNC_LEN;
+        }
+        if (memcmp(hit, sync_word, cmp_len) == 0) {
+            return pos;
+        }
+        pos++;
+    }
+    return len;
+}
+
+static bool usb_vendor_bulk_parser_valid_length(uint16_t length) {
+    return (length >= BULK_MSG_MIN_LEN) && (length <= BULK_MSG_MAX_LEN);
+}
+
+static size_t usb_vendor_bulk_parser_scan(bulk_parser_t *parser, const uint8_t *data, size_t len, size_t pos) {
+    size_t start = usb_vendor_bulk_parser_find_sync(data, len, pos);
+    parser->stats.skipped_bytes += start - pos;
+
+    if ((len - start) >= BULK_HDR_LEN) {
+        bulk_msg_header_t header;
+        memcpy(&header, &data[start], BULK_HDR_LEN);
+        if (!usb_vendor_bulk_parser_valid_length(header.length)) {
+            parser->stats.length_errors++;
+            parser->stats.skipped_bytes++;
+            return start + 1u;
+        }
+
+        if ((len - start) >= header.length) {
+            /* complete frame is available in the segment, handle it in place */
+            const uint8_t *frame = &data[start];
+            uint16_t calc_crc = usb_vendor_bulk_crc_update(BULK_MSG_CRC_SEED, frame, header.length - BULK_MSG_CRC_LEN);
+            uint16_t mess_crc = (uint16_t)frame[header.length - 2u] |
+                                (uint16_t)((uint16_t)frame[header.length - 1u] << 8);
+            if (calc_crc != mess_crc) {
+                parser->stats.crc_errors++;
+                parser->stats.skipped_bytes++;
+                return start + 1u;
+            }
+
+            const uint8_t *payload = &frame[BULK_HDR_LEN];
+            uint16_t payload_len = header.length - BULK_MSG_MIN_LEN;
+            if (((uintptr_t)payload & 0x3u) != 0u) {
+                /* command handlers cast the payload to structures, keep it aligned */
+                memcpy(parser->frame, frame, header.length - BULK_MSG_CRC_LEN);
+                payload = &((const uint8_t *)parser->frame)[BULK_HDR_LEN];
+                parser->stats.frames_copied++;
+            }
+            parser->stats.frames++;
+            parser->frame_cb(parser->ctx, &header, payload, payload_len);
+            return start + header.length;
+        }
+    }
+
+    if (start < len) {
+        /* frame continues in the next segment */
+        size_t remaining = len - start;
+        memcpy(parser->frame, &data[start], remaining);
+        parser->frame_len = (uint16_t)remaining;
+        parser->stage = STAGE_SYNC;
+    }
+
+    return len;
+}
+
+static void usb_vendor_bulk_parser_update_crc(bulk_parser_t *parser) {
+    uint16_t end = parser->expected_len - BULK_MSG_CRC_LEN;
+    if (parser->frame_len < end) {
+        end = parser->frame_len;
+    }
+    if (end > parser->crc_len) {
+        parser->crc = usb_vendor_bulk_crc_update(parser->crc,
+                                                 &((const uint8_t *)parser->frame)[parser->crc_len],
+                                                 end - parser->crc_len);
+        parser->crc_len = end;
+    }
+}
+
+static void usb_vendor_bulk_parser_resync(bulk_parser_t *parser) {
+    uint8_t *frame = (uint8_t *)parser->frame;
+    size_t start = usb_vendor_bulk_parser_find_sync(frame, parser->frame_len, 1u);
+
+    parser->stats.skipped_bytes += start;
+    parser->frame_len -= (uint16_t)start;
+    if (parser->frame_len > 0u) {
+        memmove(frame, &frame[start], parser->frame_len);
+    }
+    parser->stage = STAGE_SYNC;
+    parser->expected_len = 0u;
+    parser->crc_len = 0u;
+}
+
+static size_t usb_vendor_bulk_parser_append(bulk_parser_t *parser, const uint8_t *data, size_t len) {
+    uint8_t *frame = (uint8_t *)parser->frame;
+    size_t used = 0u;
+
+    while (parser->frame_len > 0u) {
+        uint16_t target;
+        if (parser->stage == STAGE_SYNC) {
+            target = BULK_SYNC_LEN;
+        } else if (parser->stage == STAGE_HEADER) {
+            target = BULK_HDR_LEN;
+        } else {
+            target = parser->expected_len;
+        }
+
+        if (parser->frame_len < target) {
+            if (used >= len) {
+                /* wait for the next segment */
+                break;
+            }
+            size_t count = target - parser->frame_len;
+            if (count > (len - used)) {
+                count = len - used;
+            }
+            memcpy(&frame[parser->frame_len], &data[used], count);
+            parser->frame_len += (uint16_t)count;
+            used += count;
+            if (parser->stage == STAGE_FRAME) {
+                usb_vendor_bulk_parser_update_crc(parser);
+            }
+            continue;
+        }
+
+        switch ((bulk_parser_stage_t)parser->stage) {
+            case STAGE_SYNC:
+                if (memcmp(frame, sync_word, BULK_SYNC_LEN) == 0) {
+                    parser->stage = STAGE_HEADER;
+                } else {
+                    usb_vendor_bulk_parser_resync(parser);
+                }
+                break;
+
+            case STAGE_HEADER:
+            {
+                bulk_msg_header_t *header = (bulk_msg_header_t *)frame;
+                if (usb_vendor_bulk_parser_valid_length(header->length)) {
+                    parser->expected_len = header->length;
+                    parser->crc = BULK_MSG_CRC_SEED;
+                    parser->crc_len = 0u;
+                    parser->stage = STAGE_FRAME;
+                    usb_vendor_bulk_parser_update_crc(parser);
+                } else {
+                    parser->stats.length_errors++;
+                    usb_vendor_bulk_parser_resync(parser);
+                }
+                break;
+            }
+
+            case STAGE_FRAME:
+            default:
+            {
+                uint16_t length = parser->expected_len;
+                uint16_t mess_crc = (uint16_t)frame[length - 2u] | (uint16_t)((uint16_t)frame[length - 1u] << 8);
+                if (mess_crc == parser->crc) {
+                    bulk_msg_header_t header;
+                    memcpy(&header, frame, BULK_HDR_LEN);
+                    parser->stats.frames++;
+                    parser->stats.frames_copied++;
+                    parser->frame_cb(parser->ctx, &header, &frame[BULK_HDR_LEN], length - BULK_MSG_MIN_LEN);
+                    /* after a resync more than one frame can be buffered, keep the remainder */
+                    parser->frame_len -= length;
+                    if (parser->frame_len > 0u) {
+                        memmove(frame, &frame[length], parser->frame_len);
+                    }
+                    parser->stage = STAGE_SYNC;
+                    parser->expected_len = 0u;
+                    parser->crc_len = 0u;
+                } else {
+                    parser->stats.crc_errors++;
+                    usb_vendor_bulk_parser_resync(parser);
+                }
+                break;
+            }
+        }
+    }
+
+    return used;
+}
+
+void usb_vendor_bulk_parser_init(bulk_parser_t *parser, bulk_parser_frame_cb_t frame_cb, void *ctx) {
+    memset(parser, 0, sizeof(bulk_parser_t));
+    (void)usb_vendor_bulk_crc_init();
+    parser->frame_cb = frame_cb;
+    parser->ctx = ctx;
+}
+
+void usb_vendor_bulk_parser_reset(bulk_parser_t *parser) {
+    parser->stage = STAGE_SYNC;
+    parser->frame_len = 0u;
+    parser->expected_len = 0u;
+    parser->crc_len = 0u;
+}
+
+void usb_vendor_bulk_parser_feed(bulk_parser_t *parser, const uint8_t *data, size_t len) {
+    size_t pos = 0u;
+
+    while (pos < len) {
+        if (parser->frame_len == 0u) {
+            pos = usb_vendor_bulk_parser_scan(parser, data, len, pos);
+        } else {
+            pos += usb_vendor_bulk_parser_append(parser, &data[pos], len - pos);
+        }
+    }
+}
+
+uint16_t usb_vendor_bulk_parser_encode(uint8_t *buffer,
+                                       uint32_t tag,
+                                       uint16_t command,
+                                       const uint8_t *data,
+                                       uint16_t datalen) {
+    bulk_msg_header_t header = {
+        .header = USB_PACKET_HEADER,
+        .length = (uint16_t)(BULK_MSG_MIN_LEN + datalen),
+        .command = command,
+        .tag = tag,
+    };
+    memcpy(buffer, &header, BULK_HDR_LEN);
+    if ((datalen > 0u) && (data != &buffer[BULK_HDR_LEN])) {
+        memcpy(&buffer[BULK_HDR_LEN], data, datalen);
+    }
+    uint16_t crc = usb_vendor_bulk_crc_update(BULK_MSG_CRC_SEED, buffer, header.length - BULK_MSG_CRC_LEN);
+    buffer[header.length - 2u] = (uint8_t)(crc & 0xFFu);
+    buffer[header.length - 1u] = (uint8_t)(crc >> 8);
+    return header.length;
+}
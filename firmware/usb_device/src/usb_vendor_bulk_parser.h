@@ -0,0 +1,150 @@
+/**
+ * @file
+ * @brief vendor device class - bulk frame parser.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @endinternal
+ *
+ * @ingroup lib_usb_device
+ *
+ * @details Definitions of the streaming frame parser for the vendor bulk command protocol.
+ *
+ * The parser is fed with the segments as they are received from the ring buffer. Frames which
+ * are completely available in one segment are validated and handed over in place, only frames
+ * which straddle two segments (or are not aligned for the command handlers) are copied in the
+ * internal frame buffer. The CRC of such a frame is computed while the segments arrive.
+ *
+ * Next to the parser, the module holds the encoder for the messages sent to the host.
+ *
+ * The module has no dependencies on the ESP-IDF such that it can be built and tested on the host.
+ * @{
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** bulk message synchronization word */
+#define USB_PACKET_HEADER 0xAA55AA55
+
+/** seed used for the CRC calculation over a bulk message */
+#define BULK_MSG_CRC_SEED 0x1D0Fu
+
+/** length of the CRC at the end of a bulk message */
+#define BULK_MSG_CRC_LEN 2u
+
+/** maximum payload length of a bulk message */
+#define BULK_MSG_MAX_PAYLOAD_LEN 4096u
+
+typedef struct bulk_msg_header_s {
+    uint32_t header;                            /**< synchronization word (USB_PACKET_HEADER) */
+    uint16_t length;                            /**< length of the message including header and crc */
+    uint16_t command;                           /**< command identifier */
+    uint32_t tag;                               /**< host chosen tag, echoed in the response to the command */
+} bulk_msg_header_t;
+
+/** minimum length of a bulk message (no payload) */
+#define BULK_MSG_MIN_LEN (sizeof(bulk_msg_header_t) + BULK_MSG_CRC_LEN)
+
+/** maximum length of a bulk message */
+#define BULK_MSG_MAX_LEN (sizeof(bulk_msg_header_t) + BULK_MSG_MAX_PAYLOAD_LEN + BULK_MSG_CRC_LEN)
+
+/** Bulk frame handler
+ *
+ * @param[in]  ctx  context pointer as passed during initialization.
+ * @param[in]  header  header of the received message.
+ * @param[in]  payload  payload of the received message (4 byte aligned).
+ * @param[in]  payload_len  length of the payload.
+ */
+typedef void (* bulk_parser_frame_cb_t)(void *ctx,
+                                        const bulk_msg_header_t *header,
+                                        const uint8_t *payload,
+                                        uint16_t payload_len);
+
+/** bulk parser statistics */
+typedef struct bulk_parser_stats_s {
+    uint32_t frames;                            /**< number of valid frames handed over */
+    uint32_t frames_copied;                     /**< number of valid frames which needed a copy */
+    uint32_t crc_errors;                        /**< number of frames dropped due to a CRC mismatch */
+    uint32_t length_errors;                     /**< number of headers dropped due to an invalid length */
+    uint32_t skipped_bytes;                     /**< number of bytes dropped while searching a header */
+} bulk_parser_stats_t;
+
+/** bulk parser state (to be treated as opaque) */
+typedef struct bulk_parser_s {
+    bulk_parser_frame_cb_t frame_cb;            /**< handler for valid frames */
+    void *ctx;                                  /**< context for the frame handler */
+    uint8_t stage;                              /**< part of the frame to be validated next */
+    uint16_t frame_len;                         /**< number of bytes in the frame buffer */
+    uint16_t expected_len;                      /**< length of the frame in the frame buffer */
+    uint16_t crc_len;                           /**< number of bytes of the frame buffer covered by crc */
+    uint16_t crc;                               /**< crc over the first crc_len bytes of the frame buffer */
+    bulk_parser_stats_t stats;                  /**< parser statistics */
+    uint32_t frame[(BULK_MSG_MAX_LEN + 3u) / 4u]; /**< buffer for frames straddling segments */
+} bulk_parser_t;
+
+/** Initialize a bulk parser
+ *
+ * @param[out]  parser  parser to initialize.
+ * @param[in]  frame_cb  handler to be called for each valid frame.
+ * @param[in]  ctx  context pointer to be passed to the frame handler.
+ */
+void usb_vendor_bulk_parser_init(bulk_parser_t *parser, bulk_parser_frame_cb_t frame_cb, void *ctx);
+
+/** Drop any partially received frame
+ *
+ * @param[in|out]  parser  parser to reset.
+ */
+void usb_vendor_bulk_parser_reset(bulk_parser_t *parser);
+
+/** Feed the next received segment to the parser
+ *
+ * All valid frames which get completed by the segment are passed to the frame handler before
+ * this function returns, as such the segment can be released afterwards.
+ *
+ * @param[in|out]  parser  parser to feed.
+ * @param[in]  data  received segment.
+ * @param[in]  len  length of the received segment.
+ */
+void usb_vendor_bulk_parser_feed(bulk_parser_t *parser, const uint8_t *data, size_t len);
+
+/** Encode a bulk message
+ *
+ * @param[out]  buffer  buffer to encode the message in (at least BULK_MSG_MIN_LEN + datalen).
+ * @param[in]  tag  tag of the command this message responds to.
+ * @param[in]  command  command identifier.
+ * @param[in]  data  payload of the message (can be NULL when datalen is 0, or point to the payload
+ *                   location in buffer when the payload is already in place).
+ * @param[in]  datalen  length of the payload.
+ * @returns  length of the encoded message.
+ */
+uint16_t usb_vendor_bulk_parser_encode(uint8_t *buffer,
+                                       uint32_t tag,
+                                       uint16_t command,
+                                       const uint8_t *data,
+                                       uint16_t datalen);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
@@ -31,6 +31,7 @@
 #include "usb_descriptors.h"
 #include "usb_vendor_bulk.h"
 
+#include "vendor_req_hndl/usb_vendor_benchmark.h"
 #include "vendor_req_hndl/usb_vendor_btl_ppm.h"
 #include "vendor_req_hndl/usb_vendor_config.h"
 #include "vendor_req_hndl/usb_vendor_hex_transfer.h"
@@ -59,6 +60,7 @@ typedef enum vendor_request_e {
     MCM_VENDOR_REQUEST_IDENTIFY = 0x00,
     MCM_VENDOR_REQUEST_INFO = 0x01,
     MCM_VENDOR_REQUEST_CONFIG = 0x02,
+    MCM_VENDOR_REQUEST_BULK_BENCHMARK = 0x03,
     MCM_VENDOR_REQUEST_SLAVE_CTRL = 0x10,
     MCM_VENDOR_REQUEST_BARE_UART_MODE = 0x20,
     MCM_VENDOR_REQUEST_PWM_COMM = 0x21,
@@ -94,6 +96,7 @@ static const struct {
     {MCM_VENDOR_REQUEST_IDENTIFY, vendor_handle_class_control_request_identify},
     {MCM_VENDOR_REQUEST_INFO, vendor_handle_class_control_request_info},
     {MCM_VENDOR_REQUEST_CONFIG, vendor_handle_class_control_request_config},
+    {MCM_VENDOR_REQUEST_BULK_BENCHMARK, vendor_handle_class_control_request_benchmark},
     {MCM_VENDOR_REQUEST_SLAVE_CTRL, vendor_handle_class_control_request_slave_pwr},
     {MCM_VENDOR_REQUEST_LIN_COMM, vendor_handle_class_control_request_lin_comm},
     {MCM_VENDOR_REQUEST_BOOTLOADER_DO_TRANSFER, vendor_handle_class_control_request_hex_transfer},
@@ -0,0 +1,261 @@
+/**
+ * @file
+ * @brief vendor device class - bulk benchmark interface.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @endinternal
+ *
+ * @ingroup lib_usb_device
+ *
+ * @details Implementations of the vendor device class for the bulk benchmark interface.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+
+#include "tinyusb.h"
+
+#include "sdkconfig.h"
+#include "mlx_err.h"
+#include "usb_vendor_bulk.h"
+
+#include "usb_vendor_benchmark.h"
+
+static const char *TAG = "usb-vendor-bench";
+
+typedef enum vendor_request_benchmark_e {
+    /* (MCM_VENDOR_REQUEST_BULK_BENCHMARK << 8) + [0x00..0xFF] */
+    MCM_BENCHMARK_ECHO = 0x0300,
+    MCM_BENCHMARK_SOURCE = 0x0301,
+    MCM_BENCHMARK_SOURCE_DATA = 0x0302,
+    MCM_BENCHMARK_SINK = 0x0303,
+    MCM_BENCHMARK_SINK_DATA = 0x0304,
+    MCM_BENCHMARK_RESULT = 0x0310,
+    /* MCM_BULK_MSG_ERROR_REPORT = 0xFFFF, */
+} vendor_request_benchmark_t;
+
+typedef struct bulk_benchmark_source_s {
+    uint32_t nr_of_bytes;                       /**< number of payload bytes to send */
+    uint16_t chunk_len;                         /**< payload length per message */
+    uint16_t reserved;
+} bulk_benchmark_source_t;
+
+typedef struct bulk_benchmark_sink_s {
+    uint32_t nr_of_bytes;                       /**< number of payload bytes to receive */
+} bulk_benchmark_sink_t;
+
+typedef struct bulk_benchmark_result_s {
+    uint32_t nr_of_bytes;                       /**< number of payload bytes transferred */
+    uint32_t nr_of_messages;                    /**< number of messages transferred */
+    uint32_t duration_us;                       /**< device side duration of the transfer */
+    uint32_t drops;                             /**< number of messages dropped or missed */
+} bulk_benchmark_result_t;
+
+/** state of a running sink benchmark */
+static struct {
+    bool active;                                /**< sink is armed */
+    bool started;                               /**< first data message is received */
+    uint32_t expected_bytes;                    /**< number of payload bytes to receive */
+    uint32_t next_tag;                          /**< tag expected for the next data message */
+    uint32_t parser_errors;                     /**< parser error count at the start */
+    int64_t start_time;                         /**< time of the first data message */
+    bulk_benchmark_result_t result;             /**< result being collected */
+} sink;
+
+/** Get the number of messages dropped by the bulk interface so far
+ *
+ * @param[in]  rx  count receive side drops (else transmit side).
+ * @returns  number of dropped messages.
+ */
+static uint32_t bulk_benchmark_drops(bool rx);
+
+/** Send messages with a known pattern to the host
+ *
+ * @param[in]  command  bulk command which was received.
+ * @param[in]  data  source request.
+ * @param[in]  datalen  length of the source request.
+ */
+static void bulk_benchmark_source(uint16_t command, const uint8_t * data, uint16_t datalen);
+
+/** Handle a data message of a sink benchmark
+ *
+ * @param[in]  datalen  payload length of the data message.
+ */
+static void bulk_benchmark_sink_data(uint16_t datalen);
+
+/** Handle a bulk command of the benchmark interface
+ *
+ * @param[in]  command  bulk command which was received.
+ * @param[in]  data  payload of the command.
+ * @param[in]  datalen  length of the payload.
+ * @retval  true  command is handled.
+ * @retval  false  command is unknown.
+ */
+static bool bulk_benchmark_command_handler(uint16_t command, const uint8_t * data, uint16_t datalen);
+
+
+static uint32_t bulk_benchmark_drops(bool rx) {
+    bulk_stats_t stats;
+    usb_vendor_bulk_get_stats(&stats);
+    if (rx) {
+        return stats.parser.crc_errors + stats.parser.length_errors;
+    }
+    return stats.tx.ring_full + stats.tx.pool_failures;
+}
+
+static void bulk_benchmark_source(uint16_t command, const uint8_t * data, uint16_t datalen) {
+    const bulk_benchmark_source_t *request = (const bulk_benchmark_source_t*)data;
+
+    if ((datalen != sizeof(bulk_benchmark_source_t)) ||
+        (request->chunk_len == 0u) ||
+        (request->chunk_len > BULK_MSG_MAX_PAYLOAD_LEN)) {
+        usb_vendor_bulk_write_error(command, MLX_FAIL_INV_DATA_LEN, mlxerr_ErrorCodeToName(MLX_FAIL_INV_DATA_LEN));
+        return;
+    }
+
+    bulk_benchmark_result_t result = {0};
+    uint32_t drops = bulk_benchmark_drops(false);
+    int64_t start_time = esp_timer_get_time();
+
+    uint32_t offset = 0u;
+    while (offset < request->nr_of_bytes) {
+        uint32_t chunk_len = request->nr_of_bytes - offset;
+        if (chunk_len > request->chunk_len) {
+            chunk_len = request->chunk_len;
+        }
+        uint8_t *payload = usb_vendor_bulk_response_acquire();
+        if (payload == NULL) {
+            result.drops++;
+        } else {
+            for (uint32_t i = 0; i < chunk_len; i++) {
+                payload[i] = (uint8_t)(offset + i);
+            }
+            if (usb_vendor_bulk_response_send(payload, MCM_BENCHMARK_SOURCE_DATA, (uint16_t)chunk_len)) {
+                /* only the queued chunks count towards the reported throughput */
+                result.nr_of_messages++;
+                result.nr_of_bytes += chunk_len;
+            } else {
+                result.drops++;
+            }
+        }
+        offset += chunk_len;
+    }
+
+    result.duration_us = (uint32_t)(esp_timer_get_time() - start_time);
+    result.drops += bulk_benchmark_drops(false) - drops;
+    ESP_LOGI(TAG, "source: %lu bytes in %lu us", (unsigned long)result.nr_of_bytes, (unsigned long)result.duration_us);
+    usb_vendor_bulk_write_response(MCM_BENCHMARK_RESULT, (const uint8_t*)&result, sizeof(result));
+}
+
+static void bulk_benchmark_sink_data(uint16_t datalen) {
+    uint32_t tag = usb_vendor_bulk_current_tag();
+
+    if (!sink.started) {
+        sink.started = true;
+        sink.start_time = esp_timer_get_time();
+        sink.next_tag = tag;
+    }
+    if (tag != sink.next_tag) {
+        /* the host numbers the data messages using the tag */
+        sink.result.drops += tag - sink.next_tag;
+    }
+    sink.next_tag = tag + 1u;
+    sink.result.nr_of_messages++;
+    sink.result.nr_of_bytes += datalen;
+
+    if (sink.result.nr_of_bytes >= sink.expected_bytes) {
+        sink.active = false;
+        sink.result.duration_us = (uint32_t)(esp_timer_get_time() - sink.start_time);
+        sink.result.drops += bulk_benchmark_drops(true) - sink.parser_errors;
+        ESP_LOGI(TAG, "sink: %lu bytes in %lu us",
+                 (unsigned long)sink.result.nr_of_bytes,
+                 (unsigned long)sink.result.duration_us);
+        usb_vendor_bulk_write_response(MCM_BENCHMARK_RESULT, (const uint8_t*)&sink.result, sizeof(sink.result));
+    }
+}
+
+static bool bulk_benchmark_command_handler(uint16_t command, const uint8_t * data, uint16_t datalen) {
+    bool handled = true;
+
+    switch ((vendor_request_benchmark_t)command) {
+        case MCM_BENCHMARK_ECHO:
+            usb_vendor_bulk_write_response(command, data, datalen);
+            break;
+
+        case MCM_BENCHMARK_SOURCE:
+            bulk_benchmark_source(command, data, datalen);
+            break;
+
+        case MCM_BENCHMARK_SINK:
+            if (datalen == sizeof(bulk_benchmark_sink_t)) {
+                memset(&sink, 0, sizeof(sink));
+                sink.expected_bytes = ((const bulk_benchmark_sink_t*)data)->nr_of_bytes;
+                sink.parser_errors = bulk_benchmark_drops(true);
+                sink.active = sink.expected_bytes > 0u;
+                usb_vendor_bulk_write_response(command, NULL, 0u);
+            } else {
+                usb_vendor_bulk_write_error(command,
+                                            MLX_FAIL_INV_DATA_LEN,
+                                            mlxerr_ErrorCodeToName(MLX_FAIL_INV_DATA_LEN));
+            }
+            break;
+
+        case MCM_BENCHMARK_SINK_DATA:
+            if (sink.active) {
+                /* data messages are not acknowledged, only the result is reported */
+                bulk_benchmark_sink_data(datalen);
+            } else {
+                handled = false;
+            }
+            break;
+
+        default:
+            handled = false;
+            break;
+    }
+
+    return handled;
+}
+
+
+bool vendor_handle_class_control_request_benchmark(uint8_t rhport,
+                                                   uint8_t stage,
+                                                   tusb_control_request_t const * request,
+                                                   uint8_t * buffer) {
+    (void)buffer;
+
+    if (request->bmRequestType_bit.direction == TUSB_DIR_OUT) {
+        if ((stage == CONTROL_STAGE_SETUP) && (request->wLength == 0)) {
+            if (request->wValue == 1) {
+                ESP_LOGI(TAG, "enable benchmark mode");
+                memset(&sink, 0, sizeof(sink));
+                (void)usb_vendor_bulk_start_command(bulk_benchmark_command_handler);
+            } else {
+                ESP_LOGI(TAG, "disable benchmark mode");
+                (void)usb_vendor_bulk_stop();
+            }
+            return tud_control_status(rhport, request);
+        }
+    }
+
+    /* stall unknown request */
+    return false;
+}
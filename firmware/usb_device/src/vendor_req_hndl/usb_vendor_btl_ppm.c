@@ -25,17 +25,24 @@
  */
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdlib.h>
 
 #include "esp_log.h"
 #include "esp_system.h"
 
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "tinyusb.h"
 
 #include "sdkconfig.h"
 #include "bus_manager.h"
+#include "fw_cache.h"
+#include "fw_image.h"
+#include "jobs.h"
 #include "mlx_err.h"
 #include "ppm_err.h"
 #include "ppm_bootloader.h"
+#include "progress.h"
 #include "usb_vendor_bulk.h"
 #include "usb_vendor_hex_transfer.h"
 
@@ -47,6 +54,9 @@ typedef enum vendor_request_bulk_msg_e {
     /* (MCM_VENDOR_REQUEST_BOOTLOADER_PPM << 8) + [0x00..0xFF] */
     PPM_DO_BTL_ACTION = 0x3300,
     PPM_READ_PROJECT_INFO = 0x3301,
+    PPM_READ_IMAGE_HASH = 0x3302,
+    PPM_DO_CACHED_BTL_ACTION = 0x3303,
+    PPM_BTL_PROGRESS = 0x3304,
     /* MCM_BULK_MSG_ERROR_REPORT = 0xFFFF */
 } vendor_request_bulk_msg_t;
 
@@ -55,52 +65,277 @@ typedef struct vendor_btl_request_s {
     uint8_t manpow;           /**< 1: manual power cycling */
     uint8_t broadcast;        /**< 1: bootloading shall be done in broadcast mode */
     uint8_t memory;           /**< memory type to perform action on (0: NVRAM; 1: flash; 2: flash_cs) */
-    uint8_t action;           /**< action type to perform (0: program; 1: verify) */
+    uint8_t action;           /**< action type to perform (0: program; 1: verify; 2: differential program) */
 } vendor_btl_request_t;
 
+/** tag of the command which started the running bootloader action, used for the progress messages */
+static uint32_t progress_tag = 0u;
+
+/** Progress listener, streams the progress of a bootloader action started over USB
+ *
+ * @param[in]  report  progress of the operation (sent as progress_report_t).
+ * @param[in]  ctx  listener context (not used).
+ */
+static void bulk_btl_progress_listener(const progress_report_t *report, void *ctx) {
+    (void)ctx;
+    if ((progress_tag != 0u) && (report->operation == (uint8_t)PROGRESS_OP_BOOTLOADER)) {
+        (void)usb_vendor_bulk_write_notification(progress_tag,
+                                                 PPM_BTL_PROGRESS,
+                                                 (const uint8_t*)report,
+                                                 sizeof(progress_report_t));
+    }
+}
+
+/** bootloader job, owns a copy of the firmware image such that a new upload does not disturb it */
+typedef struct bulk_btl_job_s {
+    uint32_t tag;                               /**< tag of the command which started the job */
+    uint16_t command;                           /**< bulk command which requested the action */
+    vendor_btl_request_t request;               /**< bootloader action request */
+    ppm_memory_t memory;                        /**< memory to perform the action on */
+    ppm_action_t action;                        /**< bootloader action */
+    fwimg_t image;                              /**< image of the job, owned by the job */
+    uint32_t pages[2];                          /**< programmed and skipped pages */
+    ppm_err_t ppmstat;                          /**< status of the bootloader, reported to the host */
+    const char *message;                        /**< error message of a failed job, NULL if none */
+} bulk_btl_job_t;
+
+/** protects the bootloader job state, shared by the bulk task, the job worker and the control requests */
+static portMUX_TYPE btl_job_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/** true from the submission of a bootloader job until its done callback */
+static bool btl_job_pending = false;
+
+/** id of the pending bootloader job, JOB_ID_NONE if none or not handed out yet */
+static uint32_t btl_job_id = JOB_ID_NONE;
+
+/** true when the bootloader mode was stopped while a job was pending */
+static bool btl_mode_stopped = false;
+
+/** End the pending bootloader job and release the interface when the mode was stopped meanwhile */
+static void bulk_btl_job_end(void) {
+    taskENTER_CRITICAL(&btl_job_lock);
+    bool stopped = btl_mode_stopped;
+    btl_job_pending = false;
+    btl_job_id = JOB_ID_NONE;
+    btl_mode_stopped = false;
+    taskEXIT_CRITICAL(&btl_job_lock);
+
+    if (stopped) {
+        (void)busmngr_ReleaseInterface(USER_USB_VENDOR, MODE_BOOTLOADER);
+    }
+}
+
+/** Run a bootloader job, in the job worker task
+ *
+ * @param[in]  id  job id.
+ * @param[in]  arg  job context (bulk_btl_job_t).
+ * @param[out]  error  error code of a failed job.
+ * @retval  true  action succeeded.
+ * @retval  false  action failed.
+ */
+static bool bulk_btl_job_run(uint32_t id, void *arg, int32_t *error) {
+    bulk_btl_job_t *job = (bulk_btl_job_t *)arg;
+    ppm_err_t ppmstat = PPM_OK;
+
+    progress_tag = job->tag;
+    progress_start(PROGRESS_OP_BOOTLOADER);
+    if (jobs_cancel_requested(id)) {
+        /* last point to stop, the action itself cannot be interrupted */
+        *error = MLX_FAIL_JOB_CANCELLED;
+    } else if (job->action == PPM_ACT_PROGRAM) {
+        ppmstat = fwcache_ppm_program(job->request.manpow != 0,
+                                      job->request.broadcast != 0,
+                                      job->request.bitrate,
+                                      job->memory,
+                                      &job->image,
+                                      job->request.action == 2,
+                                      &job->pages[1]);
+        job->pages[0] = fwimg_pages_present(&job->image) - job->pages[1];
+    } else {
+        ppmstat = fwimg_ppm_action(job->request.manpow != 0,
+                                   job->request.broadcast != 0,
+                                   job->request.bitrate,
+                                   job->memory,
+                                   job->action,
+                                   &job->image);
+    }
+    if (ppmstat != PPM_OK) {
+        /* the job reports an MLX code, the host is answered with the status of the bootloader */
+        *error = (job->action == PPM_ACT_VERIFY) ? MLX_FAIL_BTL_VERIFY_FAILED : MLX_FAIL_BTL_PROGRAMMING_FAILED;
+        job->ppmstat = ppmstat;
+        job->message = ppm_err_to_string(ppmstat);
+    }
+    bool retval = (ppmstat == PPM_OK) && (*error == 0);
+    progress_finish(retval);
+    progress_tag = 0u;
+
+    return retval;
+}
+
+/** Answer the command of a finished bootloader job and release the job, in the job worker task
+ *
+ * @param[in]  id  job id.
+ * @param[in]  state  final state of the job.
+ * @param[in]  error  error code of a failed job.
+ * @param[in]  arg  job context (bulk_btl_job_t).
+ */
+static void bulk_btl_job_done(uint32_t id, job_state_t state, int32_t error, void *arg) {
+    (void)id;
+    bulk_btl_job_t *job = (bulk_btl_job_t *)arg;
+
+    if (state == JOB_STATE_DONE) {
+        if (job->request.action == 2) {
+            (void)usb_vendor_bulk_write_notification(job->tag,
+                                                     job->command,
+                                                     (const uint8_t*)job->pages,
+                                                     sizeof(job->pages));
+        } else {
+            (void)usb_vendor_bulk_write_notification(job->tag, job->command, NULL, 0u);
+        }
+    } else if ((state == JOB_STATE_CANCELLED) || (job->message == NULL)) {
+        mlx_err_t result = (state == JOB_STATE_CANCELLED) ? MLX_FAIL_JOB_CANCELLED : (mlx_err_t)error;
+        (void)usb_vendor_bulk_write_error_notification(job->tag,
+                                                       job->command,
+                                                       result,
+                                                       mlxerr_ErrorCodeToName(result));
+    } else {
+        (void)usb_vendor_bulk_write_error_notification(job->tag, job->command, job->ppmstat, job->message);
+    }
+
+    fwimg_free(&job->image);
+    free(job);
+
+    /* when the mode was stopped while the job was pending, the interface is released now */
+    bulk_btl_job_end();
+}
+
+/** Submit a bootloader action with the current firmware image as a job
+ *
+ * The command is answered by the job when it finishes, such that the bulk interface stays
+ * responsive during the action. A differential program responds with the number of programmed
+ * (uint32) and skipped (uint32) pages. While the action runs, PPM_BTL_PROGRESS messages with the
+ * tag of the command report its progress.
+ *
+ * @param[in]  command  bulk command which requested the action.
+ * @param[in]  req_data  bootloader action request.
+ * @returns  MLX_OK when the job is submitted, error code to report otherwise.
+ */
+static mlx_err_t bulk_btl_do_action(uint16_t command, const vendor_btl_request_t *req_data) {
+    mlx_err_t result = MLX_OK;
+
+    ppm_memory_t memory = PPM_MEM_INVALID;
+    if (req_data->memory == 0) {
+        memory = PPM_MEM_NVRAM;
+    } else if (req_data->memory == 1) {
+        memory = PPM_MEM_FLASH;
+    } else if (req_data->memory == 2) {
+        memory = PPM_MEM_FLASH_CS;
+    }
+
+    ppm_action_t action = PPM_ACT_INVALID;
+    if ((req_data->action == 0) || (req_data->action == 2)) {
+        action = PPM_ACT_PROGRAM;
+    } else if (req_data->action == 1) {
+        action = PPM_ACT_VERIFY;
+    }
+
+    const fwimg_t *image = usb_vendor_hex_transfer_get_image();
+    if (fwimg_memory_matches(image, memory)) {
+        bulk_btl_job_t *job = calloc(1, sizeof(bulk_btl_job_t));
+        if (job != NULL) {
+            fwimg_init_psram(&job->image);
+        }
+        if ((job != NULL) && fwimg_copy(image, &job->image)) {
+            job->tag = usb_vendor_bulk_current_tag();
+            job->command = command;
+            job->request = *req_data;
+            job->memory = memory;
+            job->action = action;
+            /* the job is pending before it can run, only its done callback ends it */
+            taskENTER_CRITICAL(&btl_job_lock);
+            btl_job_pending = true;
+            taskEXIT_CRITICAL(&btl_job_lock);
+            uint32_t id = JOB_ID_NONE;
+            if (jobs_submit(JOB_KIND_BOOTLOADER, bulk_btl_job_run, bulk_btl_job_done, job, &id) != ESP_OK) {
+                fwimg_free(&job->image);
+                free(job);
+                bulk_btl_job_end();
+                result = MLX_FAIL_JOB_QUEUE_FULL;
+            } else {
+                /* the job may have finished already, or the mode was stopped before its id was known */
+                taskENTER_CRITICAL(&btl_job_lock);
+                bool cancel = btl_job_pending && btl_mode_stopped;
+                if (btl_job_pending) {
+                    btl_job_id = id;
+                }
+                taskEXIT_CRITICAL(&btl_job_lock);
+                if (cancel) {
+                    (void)jobs_cancel(id);
+                }
+            }
+        } else {
+            if (job != NULL) {
+                fwimg_free(&job->image);
+            }
+            free(job);
+            result = MLX_FAIL_SERVER_ERR;
+        }
+    } else {
+        /* binary image of another memory */
+        result = MLX_FAIL_BTL_MISSING_DATA;
+    }
+
+    return result;
+}
 
 static bool bulk_btl_command_handler(uint16_t command, const uint8_t * data, uint16_t datalen) {
     bool handled = false;
     mlx_err_t result = MLX_FAIL_COMMAND_UNKNOWN;
 
-    if (busmngr_ClaimInterface(USER_USB_VENDOR, MODE_BOOTLOADER) == ESP_OK) {
+    taskENTER_CRITICAL(&btl_job_lock);
+    bool job_pending = btl_job_pending;
+    taskEXIT_CRITICAL(&btl_job_lock);
+
+    if (busmngr_ClaimInterface(USER_USB_VENDOR, MODE_BOOTLOADER) != ESP_OK) {
+        result = MLX_FAIL_INTERFACE_NOT_FREE;
+    } else if (job_pending && (command != PPM_READ_IMAGE_HASH)) {
+        /* the bus and the current image are in use by the pending bootloader job */
+        result = MLX_FAIL_INTERFACE_NOT_FREE;
+    } else {
         switch ((vendor_request_bulk_msg_t)command) {
             case PPM_DO_BTL_ACTION:
                 if (datalen == sizeof(vendor_btl_request_t)) {
-                    vendor_btl_request_t *req_data = (vendor_btl_request_t*)data;
-
-                    ppm_memory_t memory = PPM_MEM_INVALID;
-                    if (req_data->memory == 0) {
-                        memory = PPM_MEM_NVRAM;
-                    } else if (req_data->memory == 1) {
-                        memory = PPM_MEM_FLASH;
-                    } else if (req_data->memory == 2) {
-                        memory = PPM_MEM_FLASH_CS;
-                    }
+                    result = bulk_btl_do_action(command, (const vendor_btl_request_t*)data);
+                    handled = (result == MLX_OK);
+                } else {
+                    result = MLX_FAIL_INV_DATA_LEN;
+                }
+                break;
 
-                    ppm_action_t action = PPM_ACT_INVALID;
-                    if (req_data->action == 0) {
-                        action = PPM_ACT_PROGRAM;
-                    } else if (req_data->action == 1) {
-                        action = PPM_ACT_VERIFY;
+            case PPM_DO_CACHED_BTL_ACTION:
+                /* the request followed by the content hash of the cached image */
+                if (datalen == (sizeof(vendor_btl_request_t) + FWCACHE_HASH_LEN)) {
+                    if (usb_vendor_hex_transfer_load_cached(&data[sizeof(vendor_btl_request_t)]) == ESP_OK) {
+                        result = bulk_btl_do_action(command, (const vendor_btl_request_t*)data);
+                        handled = (result == MLX_OK);
+                    } else {
+                        result = MLX_FAIL_BTL_IMAGE_NOT_CACHED;
                     }
+                } else {
+                    result = MLX_FAIL_INV_DATA_LEN;
+                }
+                break;
 
-                    ppm_err_t ppmstat = ppmbtl_doAction(req_data->manpow != 0,
-                                                        req_data->broadcast != 0,
-                                                        req_data->bitrate,
-                                                        memory,
-                                                        action,
-                                                        usb_vendor_hex_transfer_get_container());
-                    if (ppmstat == PPM_OK) {
-                        usb_vendor_bulk_write_response(command, NULL, 0u);
+            case PPM_READ_IMAGE_HASH:
+                if (datalen == 0u) {
+                    uint8_t hash[FWCACHE_HASH_LEN];
+                    if (fwcache_hash(usb_vendor_hex_transfer_get_image(), hash) == ESP_OK) {
+                        usb_vendor_bulk_write_response(command, hash, sizeof(hash));
+                        handled = true;
+                        result = MLX_OK;
                     } else {
-                        usb_vendor_bulk_write_error(command,
-                                                    ppmstat,
-                                                    ppm_err_to_string(ppmstat));
+                        result = MLX_FAIL_BTL_MISSING_DATA;
                     }
-
-                    handled = true;
-                    result = MLX_OK;
                 } else {
                     result = MLX_FAIL_INV_DATA_LEN;
                 }
@@ -125,8 +360,6 @@ static bool bulk_btl_command_handler(uint16_t command, const uint8_t * data, uin
             default:
                 break;
         }
-    } else {
-        result = MLX_FAIL_INTERFACE_NOT_FREE;
     }
 
     if (result < MLX_OK) {
@@ -150,12 +383,31 @@ bool vendor_handle_class_control_request_btl_ppm(uint8_t rhport,
         if ((stage == CONTROL_STAGE_SETUP) && (request->wLength == 0)) {
             if (request->wValue == 1) {
                 ESP_LOGI(TAG, "request btl ppm mode");
+                /* a job still pending from the previous session keeps its claim for this one */
+                taskENTER_CRITICAL(&btl_job_lock);
+                btl_mode_stopped = false;
+                if (!btl_job_pending) {
+                    btl_job_id = JOB_ID_NONE;
+                }
+                taskEXIT_CRITICAL(&btl_job_lock);
+                (void)progress_add_listener(bulk_btl_progress_listener, NULL);
                 (void)usb_vendor_bulk_start_command(bulk_btl_command_handler);
                 return tud_control_xfer(rhport, request, NULL, 0);
             } else {
                 ESP_LOGI(TAG, "stop btl ppm mode");
+                progress_remove_listener(bulk_btl_progress_listener, NULL);
                 (void)usb_vendor_bulk_stop();
-                (void)busmngr_ReleaseInterface(USER_USB_VENDOR, MODE_BOOTLOADER);
+                /* a running job cannot be interrupted, its done callback releases the interface */
+                taskENTER_CRITICAL(&btl_job_lock);
+                bool pending = btl_job_pending;
+                uint32_t id = btl_job_id;
+                btl_mode_stopped = pending;
+                taskEXIT_CRITICAL(&btl_job_lock);
+                if (!pending) {
+                    (void)busmngr_ReleaseInterface(USER_USB_VENDOR, MODE_BOOTLOADER);
+                } else if (id != JOB_ID_NONE) {
+                    (void)jobs_cancel(id);
+                }
                 return tud_control_status(rhport, request);
             }
         }
@@ -32,7 +32,8 @@
 #include "tinyusb.h"
 
 #include "sdkconfig.h"
-#include "intelhex.h"
+#include "fw_cache.h"
+#include "fw_image.h"
 #include "usb_vendor_bulk.h"
 
 #include "usb_vendor_hex_transfer.h"
@@ -41,13 +42,12 @@ static const char *TAG = "usb-vendor-hex";
 
 static bool btl_transfer_mode = false;
 
-static uint32_t btl_ihex_ext_address = 0u;
-static ihexContainer_t * btl_ihex_first_container = NULL;
-static ihexContainer_t * btl_ihex_prev_container = NULL;
+static fwimg_t btl_image = {0};
+static fwimg_loader_t btl_loader;
 
 /** Intelhex transfer bulk USB communication handler
  *
- * @param[in]  buffer  buffer used for storing temp data.
+ * @param[in]  buffer  buffer used for storing temp data (unused).
  * @param[in]  buffer_wr_ptr  pointer to the current writing location in buffer.
  * @returns  new write pointer in buffer (negative number for task stop).
  */
@@ -55,65 +55,31 @@ static int32_t usb_vendor_hex_transfer_handler(char *buffer, int32_t buffer_wr_p
 
 
 static int32_t usb_vendor_hex_transfer_handler(char *buffer, int32_t buffer_wr_ptr) {
-    int32_t buffer_rd_ptr = 0;
+    (void)buffer;
     size_t item_size = 0;
-    char *item = (char *)xRingbufferReceiveUpTo(bulk_rx_buf_handle,
-                                                &item_size,
-                                                pdMS_TO_TICKS(25),
-                                                BULK_TASK_BUFFER_LEN / 4);
+    const uint8_t *item = (const uint8_t *)usb_vendor_bulk_receive(&item_size, pdMS_TO_TICKS(1000));
     if (item != NULL) {
-        if (item_size > 0) {
-            memcpy(&buffer[buffer_wr_ptr], item, item_size);
-            buffer_wr_ptr += item_size;
-            buffer[buffer_wr_ptr] = 0;
-        }
+        /* an Intel HEX file or a binary image, parsed in place, a wrapped ring buffer is received as two items */
+        (void)fwimg_loader_feed(&btl_loader, item, item_size);
         vRingbufferReturnItem(bulk_rx_buf_handle, (void *)item);
-
-        /* replace newline chars for later strlen usage */
-        size_t temp_ptr = 0;
-        while (temp_ptr < buffer_wr_ptr) {
-            if ((buffer[temp_ptr] == '\n') || (buffer[temp_ptr] == '\r')) {
-                buffer[temp_ptr] = 0;
-            }
-            temp_ptr++;
-        }
-    }
-
-    if (buffer_wr_ptr > 9) {
-        /* one line of intelhex has at least 9 chars for the start */
-        while (buffer_rd_ptr < buffer_wr_ptr) {
-            /* todo add a sleep every x loops to allow other processes to trigger? */
-            while ((buffer[buffer_rd_ptr] == '\0') && (buffer_rd_ptr < buffer_wr_ptr)) {
-                buffer_rd_ptr++;
-            }
-            ihexContainer_t * container = NULL;
-            if (intelhex_readLine(&buffer[buffer_rd_ptr], &btl_ihex_ext_address, &container) == true) {
-                buffer_rd_ptr += strlen(&buffer[buffer_rd_ptr]);
-                if (container != NULL) {
-                    container->prev = btl_ihex_prev_container;
-                    if (btl_ihex_prev_container != NULL) {
-                        btl_ihex_prev_container->next = container;
-                    } else {
-                        btl_ihex_first_container = container;
-                    }
-                    btl_ihex_prev_container = container;
-                } else {
-                    break;
-                }
-            } else {
-                break;
-            }
-        }
-
-        if (buffer_rd_ptr != 0) {
-            buffer_wr_ptr -= buffer_rd_ptr;
-            memcpy(&buffer[0], &buffer[buffer_rd_ptr], buffer_wr_ptr);
-            buffer[buffer_wr_ptr] = 0;
-        }
     } else if (!btl_transfer_mode) {
         /* done transferring and processing */
         buffer_wr_ptr = -1;
-        usb_vendor_bulk_write_string("OK\n");
+        fwimg_load_result_t result = fwimg_loader_finish(&btl_loader);
+        if (result == FWIMG_LOAD_OK) {
+            /* keep the image such that it can be programmed again without upload, the flash
+             * writes are done by a job as the host waits for the answer */
+            uint8_t hash[FWCACHE_HASH_LEN];
+            esp_err_t cached = fwcache_store_background(&btl_image, hash);
+            if (cached != ESP_OK) {
+                ESP_LOGW(TAG, "image not cached (%s)", esp_err_to_name(cached));
+            }
+            usb_vendor_bulk_write_string("OK\n");
+        } else {
+            ESP_LOGE(TAG, "%s after %lu bytes", fwimg_loader_result_to_string(result), btl_loader.bytes);
+            fwimg_free(&btl_image);
+            usb_vendor_bulk_write_string("ERROR\n");
+        }
     }
 
     return buffer_wr_ptr;
@@ -129,18 +95,16 @@ bool vendor_handle_class_control_request_hex_transfer(uint8_t rhport,
         if ((stage == CONTROL_STAGE_SETUP) && (request->wLength == 0)) {
             if (request->wValue == 1) {
                 ESP_LOGI(TAG, "do hex transfer");
-                /* clear current intelhex object if it exists */
-                btl_ihex_ext_address = 0u;
-                if (btl_ihex_first_container != NULL) {
-                    intelhex_free(btl_ihex_first_container);
-                }
-                btl_ihex_first_container = NULL;
-                btl_ihex_prev_container = NULL;
+                /* clear current image if it exists */
+                fwimg_free(&btl_image);
+                fwimg_init_psram(&btl_image);
+                fwimg_loader_init(&btl_loader, &btl_image);
                 btl_transfer_mode = true;
                 (void)usb_vendor_bulk_start_raw(usb_vendor_hex_transfer_handler);
             } else {
                 ESP_LOGI(TAG, "stop hex transfer");
                 btl_transfer_mode = false;
+                usb_vendor_bulk_wake();
             }
             return tud_control_status(rhport, request);
         }
@@ -150,7 +114,18 @@ bool vendor_handle_class_control_request_hex_transfer(uint8_t rhport,
     return false;
 }
 
-ihexContainer_t * usb_vendor_hex_transfer_get_container(void) {
-    return btl_ihex_first_container;
+const fwimg_t * usb_vendor_hex_transfer_get_image(void) {
+    return &btl_image;
+}
+
+esp_err_t usb_vendor_hex_transfer_load_cached(const uint8_t *hash) {
+    fwimg_free(&btl_image);
+    fwimg_init_psram(&btl_image);
+    esp_err_t retval = fwcache_load(hash, &btl_image);
+    if (retval != ESP_OK) {
+        fwimg_free(&btl_image);
+    }
+
+    return retval;
 }
 
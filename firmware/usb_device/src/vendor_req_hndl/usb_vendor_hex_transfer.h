@@ -29,9 +29,10 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "esp_err.h"
 #include "tinyusb.h"
 
-#include "intelhex.h"
+#include "fw_image.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -51,11 +52,18 @@ bool vendor_handle_class_control_request_hex_transfer(uint8_t rhport,
                                                       tusb_control_request_t const * request,
                                                       uint8_t * buffer);
 
-/** get a pointer to the currently available intelhex container
+/** get a pointer to the currently available firmware image
  *
- * @returns  pointer to current container.
+ * @returns  pointer to current image.
  */
-ihexContainer_t * usb_vendor_hex_transfer_get_container(void);
+const fwimg_t * usb_vendor_hex_transfer_get_image(void);
+
+/** replace the current firmware image by an image of the image cache
+ *
+ * @param[in]  hash  content hash of the cached image.
+ * @returns  ESP_OK when the image is loaded, the current image is empty otherwise.
+ */
+esp_err_t usb_vendor_hex_transfer_load_cached(const uint8_t *hash);
 
 /** @} */
 
@@ -24,17 +24,31 @@
  * @details Implementations of the vendor device class for the LIN communication interface.
  */
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "esp_log.h"
+#include "esp_rom_sys.h"
 #include "esp_system.h"
 
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "tinyusb.h"
 
 #include "sdkconfig.h"
 #include "bus_manager.h"
+#include "jobs.h"
 #include "lin_master.h"
+#include "lin_cache.h"
 #include "lin_err.h"
+#include "lin_monitor.h"
+#include "lin_schedule.h"
+#include "lin_signal.h"
+#include "lin_timing.h"
+#include "lin_transport.h"
+#include "mlx_err.h"
 #include "power_ctrl.h"
 #include "usb_vendor_bulk.h"
 
@@ -46,6 +60,33 @@ typedef enum vendor_request_lin_comm_e {
     /* (MCM_VENDOR_REQUEST_LIN_COMM << 8) + [0x00..0xFF] */
     MCM_LIN_COMM_SEND_WAKEUP = 0x2200,
     MCM_LIN_COMM_HANDLE_MESSAGE = 0x2201,
+    MCM_LIN_COMM_HANDLE_BATCH = 0x2202,
+    MCM_LIN_COMM_HANDLE_EVENT_FRAME = 0x2203,
+    MCM_LIN_COMM_SCHEDULE_UPLOAD = 0x2210,
+    MCM_LIN_COMM_SCHEDULE_START = 0x2211,
+    MCM_LIN_COMM_SCHEDULE_STOP = 0x2212,
+    MCM_LIN_COMM_SCHEDULE_SWITCH = 0x2213,
+    MCM_LIN_COMM_SCHEDULE_RESULT = 0x2214,
+    MCM_LIN_COMM_SCHEDULE_STATUS = 0x2215,
+    MCM_LIN_COMM_SCHEDULE_SPORADIC = 0x2216,
+    MCM_LIN_COMM_LD_DIAGNOSTIC = 0x2220,
+    MCM_LIN_COMM_LD_SEND_MESSAGE = 0x2221,
+    MCM_LIN_COMM_LD_RECEIVE_MESSAGE = 0x2222,
+    MCM_LIN_COMM_MONITOR_START = 0x2230,
+    MCM_LIN_COMM_MONITOR_STOP = 0x2231,
+    MCM_LIN_COMM_MONITOR_RECORDS = 0x2232,
+    MCM_LIN_COMM_MONITOR_STATUS = 0x2233,
+    MCM_LIN_COMM_CACHE_READ = 0x2240,
+    MCM_LIN_COMM_CACHE_MESSAGE = 0x2241,
+    MCM_LIN_COMM_CACHE_CLEAR = 0x2242,
+    MCM_LIN_COMM_SIGNAL_UPLOAD = 0x2250,
+    MCM_LIN_COMM_SIGNAL_SUBSCRIBE = 0x2251,
+    MCM_LIN_COMM_SIGNAL_VALUES = 0x2252,
+    MCM_LIN_COMM_SIGNAL_READ = 0x2253,
+    MCM_LIN_COMM_SIGNAL_STATUS = 0x2254,
+    MCM_LIN_COMM_TIMING_READ = 0x2260,
+    MCM_LIN_COMM_TIMING_CLEAR = 0x2261,
+    MCM_LIN_COMM_TIMING_PHASES = 0x2262,
     /* MCM_BULK_MSG_ERROR_REPORT = 0xFFFF, */
 } vendor_request_lin_comm_t;
 
@@ -58,9 +99,947 @@ typedef struct bulk_lin_transfer_message_s {
     uint8_t payload[8];
 } bulk_lin_transfer_message_t;
 
+/** maximum number of entries in one batch transfer */
+#define LIN_BATCH_MAX_ENTRIES 64u
+
+/** batch transfer: do not continue with the next entries after a failing entry */
+#define LIN_BATCH_FLAG_STOP_ON_ERROR 0x01u
+
+typedef enum bulk_lin_batch_type_e {
+    LIN_BATCH_M2S = 0,                          /**< master to slave frame */
+    LIN_BATCH_S2M = 1,                          /**< slave to master frame */
+    LIN_BATCH_WAKEUP = 2,                       /**< wake up pulse, pulse time (us) in payload[0..1] */
+} bulk_lin_batch_type_t;
+
+typedef struct bulk_lin_batch_header_s {
+    uint16_t baudrate;                          /**< baudrate to be used for all frames in the batch */
+    uint8_t nr_of_entries;                      /**< number of entries following the header */
+    uint8_t flags;                              /**< LIN_BATCH_FLAG_x flags */
+} bulk_lin_batch_header_t;
+
+typedef struct bulk_lin_batch_entry_s {
+    uint8_t type;                               /**< entry type (bulk_lin_batch_type_t) */
+    uint8_t frameid;                            /**< frame identifier */
+    uint8_t datalength;                         /**< number of data bytes */
+    uint8_t enhanced_crc;                       /**< 1: use enhanced checksum */
+    uint16_t delay_us;                          /**< delay after handling the entry (us) */
+    uint8_t payload[8];                         /**< data for M2S frames */
+} bulk_lin_batch_entry_t;
+
+typedef struct bulk_lin_batch_result_s {
+    int16_t status;                             /**< lin error code of the sent entry, LIN_OK when refused */
+    int16_t error;                              /**< MLX error code of a refused entry, MLX_OK otherwise */
+    uint8_t frameid;                            /**< frame identifier */
+    uint8_t datalength;                         /**< number of valid bytes in data */
+    uint8_t data[8];                            /**< data received for S2M frames */
+} bulk_lin_batch_result_t;
+
+typedef struct bulk_lin_batch_response_s {
+    uint8_t nr_of_entries;                      /**< number of handled entries */
+    uint8_t nr_of_failures;                     /**< number of handled entries which failed */
+    uint16_t reserved;
+    bulk_lin_batch_result_t results[LIN_BATCH_MAX_ENTRIES];
+} bulk_lin_batch_response_t;
+
+/** batch job, owns a copy of the request as the command data is only valid in the handler */
+typedef struct bulk_lin_batch_job_s {
+    uint32_t tag;                               /**< tag of the command which started the job */
+    uint16_t command;                           /**< bulk command which was received */
+    bulk_lin_batch_header_t header;             /**< batch header */
+    bulk_lin_batch_entry_t entries[LIN_BATCH_MAX_ENTRIES]; /**< batch entries */
+    bulk_lin_batch_response_t response;         /**< aggregated result */
+} bulk_lin_batch_job_t;
+
+typedef struct bulk_lin_schedule_header_s {
+    uint8_t table;                              /**< index of the schedule table */
+    uint8_t nr_of_entries;                      /**< number of entries (linsched_entry_t) following the header */
+    uint16_t baudrate;                          /**< baudrate to be used for all frames in the table */
+} bulk_lin_schedule_header_t;
+
+typedef struct bulk_lin_event_request_s {
+    uint16_t baudrate;                          /**< baudrate to be used for all frames */
+    uint8_t frameid;                            /**< event triggered frame identifier */
+    uint8_t datalength;                         /**< number of data bytes of the associated frames (incl. pid) */
+    uint8_t enhanced_crc;                       /**< 1: use enhanced checksum */
+    uint8_t reserved[3];
+    uint8_t associated[LINSCHED_MAX_ASSOCIATED];  /**< associated frame identifiers, unused: LINSCHED_NO_FRAME */
+} bulk_lin_event_request_t;
+
+typedef struct bulk_lin_event_response_s {
+    uint8_t outcome;                            /**< outcome of the event triggered frame (linsched_event_outcome_t) */
+    uint8_t nr_of_results;                      /**< number of results */
+    uint16_t reserved;
+    linsched_event_result_t results[LINSCHED_MAX_ASSOCIATED];
+} bulk_lin_event_response_t;
+
+typedef struct bulk_lin_sporadic_update_s {
+    uint8_t frameid;                            /**< frame identifier of the associated unconditional frame */
+    uint8_t datalength;                         /**< number of data bytes */
+    uint16_t reserved;
+    uint8_t data[LINSCHED_MAX_DATA_LEN];        /**< data of the frame */
+} bulk_lin_sporadic_update_t;
+
+typedef struct bulk_lin_diag_header_s {
+    uint16_t baudrate;                          /**< baudrate to be used for the diagnostic frames */
+    uint8_t nad;                                /**< node address */
+    uint8_t reserved;
+} bulk_lin_diag_header_t;
+
+typedef struct bulk_lin_cache_request_s {
+    uint16_t baudrate;                          /**< baudrate to be used when the bus is accessed */
+    uint8_t datalength;                         /**< number of data bytes */
+    uint8_t enhanced_crc;                       /**< 1: use enhanced checksum */
+    uint8_t frameid;                            /**< frame identifier */
+    uint8_t reserved;
+    uint16_t max_age_ms;                        /**< maximum age of a cached response (ms) */
+} bulk_lin_cache_request_t;
+
+/** tag of the command which started the running schedule, used for the result messages */
+static uint32_t schedule_tag = 0u;
+
+/** tag of the command which started the monitor, used for the record messages */
+static uint32_t monitor_tag = 0u;
+
+/** tag of the last signal subscribe command, used for the signal value messages */
+static uint32_t signal_tag = 0u;
+
+/** database generation the signal subscriptions belong to */
+static uint32_t signal_generation = 0u;
+
+/** bitmap of the signals the host subscribed to */
+static uint32_t signal_subscriptions[LINSIG_MAX_SIGNALS / 32u];
+
+/** protects the batch job state, shared by the bulk task, the job worker and the control requests */
+static portMUX_TYPE batch_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/** true from the submission of a batch job until its done callback */
+static bool batch_pending = false;
+
+/** id of the pending batch job, JOB_ID_NONE if none or not handed out yet */
+static uint32_t batch_job_id = JOB_ID_NONE;
+
+/** true when the lin mode was disabled while a batch job was pending */
+static bool lin_mode_stopped = false;
+
+/** Wait in between batch entries
+ *
+ * @param[in]  delay_us  time to wait in micro seconds.
+ */
+static void bulk_lin_batch_delay(uint16_t delay_us);
+
+/** Run the entries of a batch, in the job worker task
+ *
+ * @param[in]  id  job id.
+ * @param[in]  arg  job context (bulk_lin_batch_job_t).
+ * @param[out]  error  lin error code of the first failing entry.
+ * @retval  true  all entries succeeded.
+ * @retval  false  an entry failed or the batch was cancelled.
+ */
+static bool bulk_lin_batch_run(uint32_t id, void *arg, int32_t *error);
+
+/** Report the aggregated result of a batch and release the job, in the job worker task
+ *
+ * @param[in]  id  job id.
+ * @param[in]  state  final state of the job.
+ * @param[in]  error  error code of a failed job.
+ * @param[in]  arg  job context (bulk_lin_batch_job_t).
+ */
+static void bulk_lin_batch_done(uint32_t id, job_state_t state, int32_t error, void *arg);
+
+/** Submit a batch of LIN transfers as a job, the job reports the aggregated result
+ *
+ * @param[in]  command  bulk command which was received.
+ * @param[in]  data  batch request (header followed by entries).
+ * @param[in]  datalen  length of the batch request.
+ */
+static void bulk_lin_handle_batch(uint16_t command, const uint8_t * data, uint16_t datalen);
+
+/** End the pending batch job
+ *
+ * @retval  true  the lin mode was disabled meanwhile, the caller releases the bus.
+ * @retval  false  the bus stays claimed.
+ */
+static bool bulk_lin_batch_end(void);
+
+/** Release the bus and power off the slaves at the end of the lin mode */
+static void bulk_lin_release(void);
+
+/** Handle an event triggered frame including the collision resolution
+ *
+ * @param[in]  command  bulk command which was received.
+ * @param[in]  data  event triggered frame request.
+ * @param[in]  datalen  length of the request.
+ */
+static void bulk_lin_handle_event_frame(uint16_t command, const uint8_t * data, uint16_t datalen);
+
+/** Handle the schedule table commands
+ *
+ * @param[in]  command  bulk command which was received.
+ * @param[in]  data  payload of the command.
+ * @param[in]  datalen  length of the payload.
+ */
+static void bulk_lin_handle_schedule(uint16_t command, const uint8_t * data, uint16_t datalen);
+
+/** Handle the diagnostic transport layer commands
+ *
+ * The request message follows the header, the response message is reassembled in place in the
+ * response frame such that a complete diagnostic service takes a single bulk transfer.
+ *
+ * @param[in]  command  bulk command which was received.
+ * @param[in]  data  payload of the command (header followed by the request message).
+ * @param[in]  datalen  length of the payload.
+ */
+static void bulk_lin_handle_diagnostic(uint16_t command, const uint8_t * data, uint16_t datalen);
+
+/** Handle the bus monitor commands
+ *
+ * While monitoring, the bus is claimed in monitor mode instead of application mode.
+ *
+ * @param[in]  command  bulk command which was received.
+ * @param[in]  data  payload of the command.
+ * @param[in]  datalen  length of the payload.
+ */
+static void bulk_lin_handle_monitor(uint16_t command, const uint8_t * data, uint16_t datalen);
+
+/** Handle the last-value cache commands
+ *
+ * Reading the cache does not use the bus and is possible while the schedule or the monitor runs. A
+ * cache message only uses the bus when the cached response is older than the requested maximum age.
+ *
+ * @param[in]  command  bulk command which was received.
+ * @param[in]  data  payload of the command.
+ * @param[in]  datalen  length of the payload.
+ */
+static void bulk_lin_handle_cache(uint16_t command, const uint8_t * data, uint16_t datalen);
+
+/** Handle the signal decoding commands
+ *
+ * Signals are identified by their index in the uploaded database. A subscribe command replaces the
+ * subscriptions by the listed signals (an empty list unsubscribes from all signals).
+ *
+ * @param[in]  command  bulk command which was received.
+ * @param[in]  data  payload of the command.
+ * @param[in]  datalen  length of the payload.
+ */
+static void bulk_lin_handle_signal(uint16_t command, const uint8_t * data, uint16_t datalen);
+
+/** Handle the frame timing commands
+ *
+ * The timing statistics don't use the bus and can be read while the schedule or the monitor runs.
+ *
+ * @param[in]  command  bulk command which was received.
+ * @param[in]  data  payload of the command.
+ * @param[in]  datalen  length of the payload.
+ */
+static void bulk_lin_handle_timing(uint16_t command, const uint8_t * data, uint16_t datalen);
+
+/** Check whether a command can not be handled since the bus is in use by a batch, the schedule or the monitor
+ *
+ * @param[in]  command  bulk command which was received.
+ * @retval  true  bus is in use, the command is to be refused.
+ * @retval  false  command can be handled.
+ */
+static bool bulk_lin_bus_busy(uint16_t command);
+
+/** Schedule result listener, streams the results to the host
+ *
+ * The results are sent as MCM_LIN_COMM_SCHEDULE_RESULT messages carrying an array of
+ * linsched_result_t, tagged with the tag of the command which started the schedule.
+ *
+ * @param[in]  results  results of the executed slots.
+ * @param[in]  nr_of_results  number of results.
+ * @param[in]  ctx  listener context (not used).
+ */
+static void bulk_lin_schedule_listener(const linsched_result_t *results, size_t nr_of_results, void *ctx);
+
+/** Monitor record listener, streams the records to the host
+ *
+ * The records are sent as MCM_LIN_COMM_MONITOR_RECORDS messages carrying an array of
+ * linmon_record_t, tagged with the tag of the command which started the monitor.
+ *
+ * @param[in]  records  captured records.
+ * @param[in]  nr_of_records  number of records.
+ * @param[in]  ctx  listener context (not used).
+ * @retval  true  records are queued for transmission.
+ * @retval  false  no transmit frame was available, the records are offered again later.
+ */
+static bool bulk_lin_monitor_listener(const linmon_record_t *records, size_t nr_of_records, void *ctx);
+
+/** Signal change listener, streams the subscribed signals to the host
+ *
+ * The values are sent as MCM_LIN_COMM_SIGNAL_VALUES messages carrying an array of linsig_value_t,
+ * tagged with the tag of the last subscribe command.
+ *
+ * @param[in]  values  values of the changed signals.
+ * @param[in]  nr_of_values  number of values.
+ * @param[in]  generation  generation of the database the indexes belong to.
+ * @param[in]  ctx  listener context (not used).
+ */
+static void bulk_lin_signal_listener(const linsig_value_t *values,
+                                     size_t nr_of_values,
+                                     uint32_t generation,
+                                     void *ctx);
+
+
+static void bulk_lin_batch_delay(uint16_t delay_us) {
+    uint32_t tick_us = portTICK_PERIOD_MS * 1000u;
+    if (delay_us >= tick_us) {
+        vTaskDelay(delay_us / tick_us);
+        delay_us %= tick_us;
+    }
+    if (delay_us > 0u) {
+        esp_rom_delay_us(delay_us);
+    }
+}
+
+static bool bulk_lin_batch_run(uint32_t id, void *arg, int32_t *error) {
+    bulk_lin_batch_job_t *job = (bulk_lin_batch_job_t *)arg;
+    const bulk_lin_batch_header_t *header = &job->header;
+    bulk_lin_batch_response_t *response = &job->response;
+
+    for (uint8_t i = 0u; i < header->nr_of_entries; i++) {
+        const bulk_lin_batch_entry_t *entry = &job->entries[i];
+        bulk_lin_batch_result_t *result = &response->results[i];
+        lin_err_t status = LIN_OK;
+        mlx_err_t refused = MLX_OK;
+
+        if (jobs_cancel_requested(id)) {
+            *error = MLX_FAIL_JOB_CANCELLED;
+            break;
+        }
+
+        result->frameid = entry->frameid;
+
+        if (entry->datalength > sizeof(entry->payload)) {
+            refused = MLX_FAIL_INV_DATA_LEN;
+        } else {
+            switch ((bulk_lin_batch_type_t)entry->type) {
+                case LIN_BATCH_M2S:
+                    status = lintiming_send_m2s(header->baudrate,
+                                                entry->enhanced_crc != 0u,
+                                                entry->frameid,
+                                                entry->payload,
+                                                entry->datalength);
+                    break;
+
+                case LIN_BATCH_S2M:
+                    status = lincache_send_s2m(header->baudrate,
+                                               entry->enhanced_crc != 0u,
+                                               entry->frameid,
+                                               result->data,
+                                               entry->datalength);
+                    if (status == LIN_OK) {
+                        result->datalength = entry->datalength;
+                    }
+                    break;
+
+                case LIN_BATCH_WAKEUP:
+                    status = linmaster_send_wakeup((uint16_t)entry->payload[0] | ((uint16_t)entry->payload[1] << 8));
+                    break;
+
+                default:
+                    refused = MLX_FAIL_COMMAND_UNKNOWN;
+                    break;
+            }
+        }
+
+        result->status = (int16_t)status;
+        result->error = (int16_t)refused;
+        response->nr_of_entries++;
+        if ((status != LIN_OK) || (refused != MLX_OK)) {
+            if (response->nr_of_failures == 0u) {
+                *error = (refused != MLX_OK) ? (int32_t)refused : (int32_t)status;
+            }
+            response->nr_of_failures++;
+            if ((header->flags & LIN_BATCH_FLAG_STOP_ON_ERROR) != 0u) {
+                break;
+            }
+        }
+
+        if (entry->delay_us > 0u) {
+            bulk_lin_batch_delay(entry->delay_us);
+        }
+    }
+
+    return (response->nr_of_failures == 0u) && (*error != MLX_FAIL_JOB_CANCELLED);
+}
+
+static void bulk_lin_batch_done(uint32_t id, job_state_t state, int32_t error, void *arg) {
+    (void)id;
+    (void)error;
+    bulk_lin_batch_job_t *job = (bulk_lin_batch_job_t *)arg;
+
+    if (state == JOB_STATE_CANCELLED) {
+        (void)usb_vendor_bulk_write_error_notification(job->tag,
+                                                       job->command,
+                                                       MLX_FAIL_JOB_CANCELLED,
+                                                       mlxerr_ErrorCodeToName(MLX_FAIL_JOB_CANCELLED));
+    } else {
+        /* failing entries are reported in the result of the batch */
+        (void)usb_vendor_bulk_write_notification(job->tag,
+                                                 job->command,
+                                                 (const uint8_t*)&job->response,
+                                                 offsetof(bulk_lin_batch_response_t, results) +
+                                                 (job->response.nr_of_entries * sizeof(bulk_lin_batch_result_t)));
+    }
+    free(job);
+
+    if (bulk_lin_batch_end()) {
+        /* the lin mode was disabled while the batch was pending, the bus is released now */
+        bulk_lin_release();
+    }
+}
+
+static bool bulk_lin_batch_end(void) {
+    taskENTER_CRITICAL(&batch_lock);
+    bool stopped = lin_mode_stopped;
+    batch_pending = false;
+    batch_job_id = JOB_ID_NONE;
+    lin_mode_stopped = false;
+    taskEXIT_CRITICAL(&batch_lock);
+
+    return stopped;
+}
+
+static void bulk_lin_handle_batch(uint16_t command, const uint8_t * data, uint16_t datalen) {
+    const bulk_lin_batch_header_t *header = (const bulk_lin_batch_header_t*)data;
+
+    if ((datalen < sizeof(bulk_lin_batch_header_t)) ||
+        (header->nr_of_entries > LIN_BATCH_MAX_ENTRIES) ||
+        (datalen != (sizeof(bulk_lin_batch_header_t) + (header->nr_of_entries * sizeof(bulk_lin_batch_entry_t))))) {
+        usb_vendor_bulk_write_error(command, MLX_FAIL_INV_DATA_LEN, mlxerr_ErrorCodeToName(MLX_FAIL_INV_DATA_LEN));
+        return;
+    }
+
+    bulk_lin_batch_job_t *job = calloc(1, sizeof(bulk_lin_batch_job_t));
+    if (job == NULL) {
+        usb_vendor_bulk_write_error(command, MLX_FAIL_SERVER_ERR, mlxerr_ErrorCodeToName(MLX_FAIL_SERVER_ERR));
+        return;
+    }
+
+    job->tag = usb_vendor_bulk_current_tag();
+    job->command = command;
+    memcpy(&job->header, data, sizeof(bulk_lin_batch_header_t));
+    memcpy(job->entries, &data[sizeof(bulk_lin_batch_header_t)], datalen - sizeof(bulk_lin_batch_header_t));
+
+    /* the batch is pending before the job can run, only its done callback ends it */
+    taskENTER_CRITICAL(&batch_lock);
+    batch_pending = true;
+    taskEXIT_CRITICAL(&batch_lock);
+
+    uint32_t id = JOB_ID_NONE;
+    if (jobs_submit(JOB_KIND_LIN_BATCH, bulk_lin_batch_run, bulk_lin_batch_done, job, &id) != ESP_OK) {
+        free(job);
+        if (bulk_lin_batch_end()) {
+            bulk_lin_release();
+        }
+        usb_vendor_bulk_write_error(command,
+                                    MLX_FAIL_JOB_QUEUE_FULL,
+                                    mlxerr_ErrorCodeToName(MLX_FAIL_JOB_QUEUE_FULL));
+    } else {
+        /* the job may have finished already, or the lin mode was disabled before its id was known */
+        taskENTER_CRITICAL(&batch_lock);
+        bool cancel = batch_pending && lin_mode_stopped;
+        if (batch_pending) {
+            batch_job_id = id;
+        }
+        taskEXIT_CRITICAL(&batch_lock);
+        if (cancel) {
+            (void)jobs_cancel(id);
+        }
+    }
+}
+
+static void bulk_lin_handle_event_frame(uint16_t command, const uint8_t * data, uint16_t datalen) {
+    const bulk_lin_event_request_t *request = (const bulk_lin_event_request_t*)data;
+    bulk_lin_event_response_t response;
+    linsched_event_outcome_t outcome = LINSCHED_EVENT_NONE;
+    linsched_entry_t entry;
+    esp_err_t error = ESP_ERR_INVALID_SIZE;
+
+    memset(&response, 0, sizeof(response));
+    if (datalen == sizeof(bulk_lin_event_request_t)) {
+        memset(&entry, 0, sizeof(entry));
+        entry.type = LINSCHED_EVENT_TRIGGERED;
+        entry.frameid = request->frameid;
+        entry.datalength = request->datalength;
+        entry.enhanced_crc = request->enhanced_crc;
+        memcpy(entry.payload, request->associated, sizeof(entry.payload));
+        error = linsched_event_triggered(request->baudrate,
+                                         &entry,
+                                         response.results,
+                                         &response.nr_of_results,
+                                         &outcome);
+    }
+
+    if (error == ESP_ERR_INVALID_SIZE) {
+        (void)usb_vendor_bulk_write_error(command,
+                                          MLX_FAIL_INV_DATA_LEN,
+                                          mlxerr_ErrorCodeToName(MLX_FAIL_INV_DATA_LEN));
+    } else if (error != ESP_OK) {
+        (void)usb_vendor_bulk_write_error(command, MLX_FAIL_SERVER_ERR, esp_err_to_name(error));
+    } else if (outcome == LINSCHED_EVENT_ERROR) {
+        lin_err_t lin_error = (lin_err_t)response.results[0].status;
+        (void)usb_vendor_bulk_write_error(command, lin_error, lin_err_to_string(lin_error));
+    } else {
+        response.outcome = (uint8_t)outcome;
+        (void)usb_vendor_bulk_write_response(command,
+                                             (const uint8_t*)&response,
+                                             offsetof(bulk_lin_event_response_t, results) +
+                                             (response.nr_of_results * sizeof(linsched_event_result_t)));
+    }
+}
+
+static void bulk_lin_handle_schedule(uint16_t command, const uint8_t * data, uint16_t datalen) {
+    esp_err_t error = ESP_ERR_INVALID_SIZE;
+    linsched_status_t status;
+    uint16_t status_len = 0u;
+
+    switch ((vendor_request_lin_comm_t)command) {
+        case MCM_LIN_COMM_SCHEDULE_UPLOAD:
+        {
+            const bulk_lin_schedule_header_t *header = (const bulk_lin_schedule_header_t*)data;
+            if ((datalen >= sizeof(bulk_lin_schedule_header_t)) &&
+                (datalen == (sizeof(bulk_lin_schedule_header_t) + (header->nr_of_entries * sizeof(linsched_entry_t))))) {
+                error = linsched_upload(header->table,
+                                        header->baudrate,
+                                        (const linsched_entry_t*)&data[sizeof(bulk_lin_schedule_header_t)],
+                                        header->nr_of_entries);
+            }
+            break;
+        }
+
+        case MCM_LIN_COMM_SCHEDULE_START:
+            if (datalen == 1u) {
+                schedule_tag = usb_vendor_bulk_current_tag();
+                error = linsched_start(data[0]);
+            }
+            break;
+
+        case MCM_LIN_COMM_SCHEDULE_STOP:
+            error = linsched_stop();
+            break;
+
+        case MCM_LIN_COMM_SCHEDULE_SWITCH:
+            if (datalen == 1u) {
+                error = linsched_switch(data[0]);
+            }
+            break;
+
+        case MCM_LIN_COMM_SCHEDULE_SPORADIC:
+        {
+            const bulk_lin_sporadic_update_t *update = (const bulk_lin_sporadic_update_t*)data;
+            if (datalen == sizeof(bulk_lin_sporadic_update_t)) {
+                error = linsched_sporadic_update(update->frameid, update->data, update->datalength);
+            }
+            break;
+        }
+
+        case MCM_LIN_COMM_SCHEDULE_STATUS:
+        default:
+            linsched_get_status(&status);
+            error = ESP_OK;
+            status_len = sizeof(status);
+            break;
+    }
+
+    if (error == ESP_OK) {
+        (void)usb_vendor_bulk_write_response(command, (const uint8_t*)&status, status_len);
+    } else if (error == ESP_ERR_INVALID_SIZE) {
+        (void)usb_vendor_bulk_write_error(command, MLX_FAIL_INV_DATA_LEN, mlxerr_ErrorCodeToName(MLX_FAIL_INV_DATA_LEN));
+    } else {
+        (void)usb_vendor_bulk_write_error(command, MLX_FAIL_SERVER_ERR, esp_err_to_name(error));
+    }
+}
+
+static void bulk_lin_handle_diagnostic(uint16_t command, const uint8_t * data, uint16_t datalen) {
+    const bulk_lin_diag_header_t *header = (const bulk_lin_diag_header_t*)data;
+    const uint8_t *request = &data[sizeof(bulk_lin_diag_header_t)];
+    uint16_t request_len = datalen - sizeof(bulk_lin_diag_header_t);
+
+    if ((datalen < sizeof(bulk_lin_diag_header_t)) ||
+        ((command == MCM_LIN_COMM_LD_RECEIVE_MESSAGE) && (request_len != 0u)) ||
+        ((command != MCM_LIN_COMM_LD_RECEIVE_MESSAGE) && ((request_len == 0u) || (request_len > LINTP_MAX_MESSAGE_LEN)))) {
+        usb_vendor_bulk_write_error(command, MLX_FAIL_INV_DATA_LEN, mlxerr_ErrorCodeToName(MLX_FAIL_INV_DATA_LEN));
+        return;
+    }
+
+    uint8_t *response = NULL;
+    uint16_t response_len = 0u;
+    mlx_err_t error = MLX_OK;
+
+    if (command != MCM_LIN_COMM_LD_SEND_MESSAGE) {
+        response = usb_vendor_bulk_response_acquire();
+        if (response == NULL) {
+            return;
+        }
+    }
+
+    switch ((vendor_request_lin_comm_t)command) {
+        case MCM_LIN_COMM_LD_DIAGNOSTIC:
+            error = lintp_diagnostic(header->baudrate,
+                                     header->nad,
+                                     request,
+                                     request_len,
+                                     response,
+                                     LINTP_MAX_MESSAGE_LEN,
+                                     &response_len,
+                                     NULL);
+            break;
+
+        case MCM_LIN_COMM_LD_SEND_MESSAGE:
+            error = lintp_send_message(header->baudrate, header->nad, request, request_len, NULL);
+            break;
+
+        case MCM_LIN_COMM_LD_RECEIVE_MESSAGE:
+        default:
+            error = lintp_receive_message(header->baudrate,
+                                          header->nad,
+                                          response,
+                                          LINTP_MAX_MESSAGE_LEN,
+                                          &response_len,
+                                          NULL);
+            break;
+    }
+
+    if (error == MLX_OK) {
+        if (response != NULL) {
+            (void)usb_vendor_bulk_response_send(response, command, response_len);
+        } else {
+            (void)usb_vendor_bulk_write_response(command, NULL, 0u);
+        }
+    } else {
+        if (response != NULL) {
+            usb_vendor_bulk_response_release(response);
+        }
+        (void)usb_vendor_bulk_write_error(command, error, mlxerr_ErrorCodeToName(error));
+    }
+}
+
+static void bulk_lin_handle_monitor(uint16_t command, const uint8_t * data, uint16_t datalen) {
+    esp_err_t error = ESP_OK;
+    mlx_err_t refused = MLX_OK;
+    linmon_status_t status;
+    uint16_t status_len = 0u;
+
+    switch ((vendor_request_lin_comm_t)command) {
+        case MCM_LIN_COMM_MONITOR_START:
+            if (datalen != sizeof(uint16_t)) {
+                refused = MLX_FAIL_INV_DATA_LEN;
+            } else {
+                monitor_tag = usb_vendor_bulk_current_tag();
+                (void)busmngr_ReleaseInterface(USER_USB_VENDOR, MODE_APPLICATION);
+                if (busmngr_ClaimInterface(USER_USB_VENDOR, MODE_MONITOR) != ESP_OK) {
+                    /* only a failing claim means the bus is used by another interface */
+                    refused = MLX_FAIL_INTERFACE_NOT_FREE;
+                } else {
+                    error = linmon_start((uint16_t)data[0] | ((uint16_t)data[1] << 8));
+                    if (error != ESP_OK) {
+                        (void)busmngr_ReleaseInterface(USER_USB_VENDOR, MODE_MONITOR);
+                    }
+                }
+                if ((refused != MLX_OK) || (error != ESP_OK)) {
+                    (void)busmngr_ClaimInterface(USER_USB_VENDOR, MODE_APPLICATION);
+                }
+            }
+            break;
+
+        case MCM_LIN_COMM_MONITOR_STOP:
+            if (busmngr_CheckClaim(USER_USB_VENDOR, MODE_MONITOR)) {
+                error = linmon_stop();
+                (void)busmngr_ReleaseInterface(USER_USB_VENDOR, MODE_MONITOR);
+                (void)busmngr_ClaimInterface(USER_USB_VENDOR, MODE_APPLICATION);
+            }
+            break;
+
+        case MCM_LIN_COMM_MONITOR_STATUS:
+        default:
+            linmon_get_status(&status);
+            status_len = sizeof(status);
+            break;
+    }
+
+    if (refused != MLX_OK) {
+        (void)usb_vendor_bulk_write_error(command, refused, mlxerr_ErrorCodeToName(refused));
+    } else if (error != ESP_OK) {
+        (void)usb_vendor_bulk_write_error(command, MLX_FAIL_SERVER_ERR, esp_err_to_name(error));
+    } else {
+        (void)usb_vendor_bulk_write_response(command, (const uint8_t*)&status, status_len);
+    }
+}
+
+static void bulk_lin_handle_cache(uint16_t command, const uint8_t * data, uint16_t datalen) {
+    switch ((vendor_request_lin_comm_t)command) {
+        case MCM_LIN_COMM_CACHE_READ:
+            if (datalen == 1u) {
+                lincache_entry_t entry;
+                bool cached = lincache_get(data[0], &entry);
+                (void)usb_vendor_bulk_write_response(command, (const uint8_t*)&entry, cached ? sizeof(entry) : 0u);
+            } else if (datalen == 0u) {
+                /* all frames which were handled at least once */
+                lincache_entry_t *entries = (lincache_entry_t*)usb_vendor_bulk_response_acquire();
+                if (entries != NULL) {
+                    uint16_t count = 0u;
+                    for (uint8_t frameid = 0u; frameid < LINCACHE_NR_OF_FRAMES; frameid++) {
+                        if (lincache_get(frameid, &entries[count])) {
+                            count++;
+                        }
+                    }
+                    (void)usb_vendor_bulk_response_send((uint8_t*)entries, command, count * sizeof(lincache_entry_t));
+                }
+            } else {
+                (void)usb_vendor_bulk_write_error(command,
+                                                  MLX_FAIL_INV_DATA_LEN,
+                                                  mlxerr_ErrorCodeToName(MLX_FAIL_INV_DATA_LEN));
+            }
+            break;
+
+        case MCM_LIN_COMM_CACHE_MESSAGE:
+        {
+            const bulk_lin_cache_request_t *request = (const bulk_lin_cache_request_t*)data;
+            lincache_entry_t entry;
+
+            if ((datalen != sizeof(bulk_lin_cache_request_t)) || (request->datalength > LINCACHE_MAX_DATA_LEN)) {
+                (void)usb_vendor_bulk_write_error(command,
+                                                  MLX_FAIL_INV_DATA_LEN,
+                                                  mlxerr_ErrorCodeToName(MLX_FAIL_INV_DATA_LEN));
+            } else if (lincache_get_fresh(request->frameid, request->datalength, request->max_age_ms, &entry)) {
+                (void)usb_vendor_bulk_write_response(command, (const uint8_t*)&entry, sizeof(entry));
+            } else if (linsched_running() || linmon_running()) {
+                (void)usb_vendor_bulk_write_error(command,
+                                                  MLX_FAIL_INTERFACE_NOT_FREE,
+                                                  mlxerr_ErrorCodeToName(MLX_FAIL_INTERFACE_NOT_FREE));
+            } else {
+                uint8_t resp[LINCACHE_MAX_DATA_LEN];
+                lin_err_t error = lincache_send_s2m(request->baudrate,
+                                                    request->enhanced_crc != 0u,
+                                                    request->frameid,
+                                                    resp,
+                                                    request->datalength);
+
+                if ((error == LIN_OK) && lincache_get(request->frameid, &entry)) {
+                    (void)usb_vendor_bulk_write_response(command, (const uint8_t*)&entry, sizeof(entry));
+                } else {
+                    (void)usb_vendor_bulk_write_error(command, error, lin_err_to_string(error));
+                }
+            }
+            break;
+        }
+
+        case MCM_LIN_COMM_CACHE_CLEAR:
+        default:
+            lincache_clear();
+            (void)usb_vendor_bulk_write_response(command, NULL, 0u);
+            break;
+    }
+}
+
+static void bulk_lin_handle_signal(uint16_t command, const uint8_t * data, uint16_t datalen) {
+    const uint16_t *indexes = (const uint16_t*)data;
+    uint16_t nr_of_indexes = datalen / sizeof(uint16_t);
+
+    switch ((vendor_request_lin_comm_t)command) {
+        case MCM_LIN_COMM_SIGNAL_UPLOAD:
+        {
+            esp_err_t error = linsig_upload(data, datalen);
+            if (error == ESP_OK) {
+                (void)usb_vendor_bulk_write_response(command, NULL, 0u);
+            } else if (error == ESP_ERR_INVALID_ARG) {
+                (void)usb_vendor_bulk_write_error(command,
+                                                  MLX_FAIL_INV_DATA_LEN,
+                                                  mlxerr_ErrorCodeToName(MLX_FAIL_INV_DATA_LEN));
+            } else {
+                (void)usb_vendor_bulk_write_error(command, MLX_FAIL_SERVER_ERR, esp_err_to_name(error));
+            }
+            break;
+        }
+
+        case MCM_LIN_COMM_SIGNAL_SUBSCRIBE:
+            if (((datalen % sizeof(uint16_t)) != 0u) || (nr_of_indexes > LINSIG_MAX_SIGNALS)) {
+                (void)usb_vendor_bulk_write_error(command,
+                                                  MLX_FAIL_INV_DATA_LEN,
+                                                  mlxerr_ErrorCodeToName(MLX_FAIL_INV_DATA_LEN));
+            } else {
+                memset(signal_subscriptions, 0, sizeof(signal_subscriptions));
+                for (uint16_t i = 0u; i < nr_of_indexes; i++) {
+                    if (indexes[i] < LINSIG_MAX_SIGNALS) {
+                        signal_subscriptions[indexes[i] >> 5] |= 1u << (indexes[i] & 31u);
+                    }
+                }
+                signal_generation = linsig_generation();
+                signal_tag = usb_vendor_bulk_current_tag();
+                (void)usb_vendor_bulk_write_response(command, NULL, 0u);
+            }
+            break;
+
+        case MCM_LIN_COMM_SIGNAL_READ:
+            if (((datalen % sizeof(uint16_t)) != 0u) || (nr_of_indexes > LINSIG_MAX_SIGNALS)) {
+                (void)usb_vendor_bulk_write_error(command,
+                                                  MLX_FAIL_INV_DATA_LEN,
+                                                  mlxerr_ErrorCodeToName(MLX_FAIL_INV_DATA_LEN));
+            } else {
+                /* the values are collected in place in the response frame, unknown signals are left out */
+                linsig_value_t *values = (linsig_value_t*)usb_vendor_bulk_response_acquire();
+                if (values != NULL) {
+                    uint16_t count = 0u;
+                    for (uint16_t i = 0u; i < nr_of_indexes; i++) {
+                        if (linsig_get_value(indexes[i], &values[count])) {
+                            count++;
+                        }
+                    }
+                    (void)usb_vendor_bulk_response_send((uint8_t*)values, command, count * sizeof(linsig_value_t));
+                }
+            }
+            break;
+
+        case MCM_LIN_COMM_SIGNAL_STATUS:
+        default:
+        {
+            linsig_status_t status;
+            linsig_get_status(&status);
+            (void)usb_vendor_bulk_write_response(command, (const uint8_t*)&status, sizeof(status));
+            break;
+        }
+    }
+}
+
+static void bulk_lin_handle_timing(uint16_t command, const uint8_t * data, uint16_t datalen) {
+    switch ((vendor_request_lin_comm_t)command) {
+        case MCM_LIN_COMM_TIMING_READ:
+            if (datalen == 1u) {
+                lintiming_entry_t entry;
+                bool measured = lintiming_get(data[0], &entry);
+                (void)usb_vendor_bulk_write_response(command, (const uint8_t*)&entry, measured ? sizeof(entry) : 0u);
+            } else if (datalen == 0u) {
+                /* all frames which were handled at least once */
+                lintiming_entry_t *entries = (lintiming_entry_t*)usb_vendor_bulk_response_acquire();
+                if (entries != NULL) {
+                    uint16_t count = 0u;
+                    for (uint8_t frameid = 0u; frameid < LINTIMING_NR_OF_FRAMES; frameid++) {
+                        if (lintiming_get(frameid, &entries[count])) {
+                            count++;
+                        }
+                    }
+                    (void)usb_vendor_bulk_response_send((uint8_t*)entries, command, count * sizeof(lintiming_entry_t));
+                }
+            } else {
+                (void)usb_vendor_bulk_write_error(command,
+                                                  MLX_FAIL_INV_DATA_LEN,
+                                                  mlxerr_ErrorCodeToName(MLX_FAIL_INV_DATA_LEN));
+            }
+            break;
+
+        case MCM_LIN_COMM_TIMING_PHASES:
+            if (datalen == 1u) {
+                lintiming_phase_entry_t entry;
+                bool measured = lintiming_get_phases(data[0], &entry);
+                (void)usb_vendor_bulk_write_response(command, (const uint8_t*)&entry, measured ? sizeof(entry) : 0u);
+            } else if (datalen == 0u) {
+                /* the frames which were measured, as far as they fit in one response */
+                lintiming_phase_entry_t *entries = (lintiming_phase_entry_t*)usb_vendor_bulk_response_acquire();
+                if (entries != NULL) {
+                    uint16_t count = 0u;
+                    uint8_t frameid = 0u;
+                    while ((frameid < LINTIMING_NR_OF_FRAMES) &&
+                           (count < (BULK_MSG_MAX_PAYLOAD_LEN / sizeof(lintiming_phase_entry_t)))) {
+                        if (lintiming_get_phases(frameid, &entries[count])) {
+                            count++;
+                        }
+                        frameid++;
+                    }
+                    (void)usb_vendor_bulk_response_send((uint8_t*)entries, command, count * sizeof(lintiming_phase_entry_t));
+                }
+            } else {
+                (void)usb_vendor_bulk_write_error(command,
+                                                  MLX_FAIL_INV_DATA_LEN,
+                                                  mlxerr_ErrorCodeToName(MLX_FAIL_INV_DATA_LEN));
+            }
+            break;
+
+        case MCM_LIN_COMM_TIMING_CLEAR:
+        default:
+            lintiming_clear();
+            (void)usb_vendor_bulk_write_response(command, NULL, 0u);
+            break;
+    }
+}
+
+static bool bulk_lin_bus_busy(uint16_t command) {
+    bool schedule_command = (command >= MCM_LIN_COMM_SCHEDULE_UPLOAD) && (command <= MCM_LIN_COMM_SCHEDULE_SPORADIC);
+    bool monitor_command = (command >= MCM_LIN_COMM_MONITOR_START) && (command <= MCM_LIN_COMM_MONITOR_STATUS);
+    /* the cache commands check by themselves whether the bus is needed, the signal and timing commands don't use it */
+    bool cache_command = (command >= MCM_LIN_COMM_CACHE_READ) && (command <= MCM_LIN_COMM_CACHE_CLEAR);
+    bool signal_command = (command >= MCM_LIN_COMM_SIGNAL_UPLOAD) && (command <= MCM_LIN_COMM_SIGNAL_STATUS);
+    bool timing_command = (command >= MCM_LIN_COMM_TIMING_READ) && (command <= MCM_LIN_COMM_TIMING_PHASES);
+
+    taskENTER_CRITICAL(&batch_lock);
+    bool batch_busy = batch_pending;
+    taskEXIT_CRITICAL(&batch_lock);
+
+    return !cache_command && !signal_command && !timing_command &&
+           (batch_busy ||
+            (linsched_running() && !schedule_command && (command != MCM_LIN_COMM_MONITOR_STATUS)) ||
+            (linmon_running() && !monitor_command));
+}
+
+static void bulk_lin_release(void) {
+    (void)busmngr_ReleaseInterface(USER_USB_VENDOR, MODE_APPLICATION);
+    powerctrl_slaveDisable();
+}
+
+static void bulk_lin_schedule_listener(const linsched_result_t *results, size_t nr_of_results, void *ctx) {
+    (void)ctx;
+    (void)usb_vendor_bulk_write_notification(schedule_tag,
+                                             MCM_LIN_COMM_SCHEDULE_RESULT,
+                                             (const uint8_t*)results,
+                                             (uint16_t)(nr_of_results * sizeof(linsched_result_t)));
+}
+
+static bool bulk_lin_monitor_listener(const linmon_record_t *records, size_t nr_of_records, void *ctx) {
+    (void)ctx;
+    return usb_vendor_bulk_write_notification(monitor_tag,
+                                              MCM_LIN_COMM_MONITOR_RECORDS,
+                                              (const uint8_t*)records,
+                                              (uint16_t)(nr_of_records * sizeof(linmon_record_t)));
+}
+
+static void bulk_lin_signal_listener(const linsig_value_t *values,
+                                     size_t nr_of_values,
+                                     uint32_t generation,
+                                     void *ctx) {
+    (void)ctx;
+    static linsig_value_t subscribed[LINSIG_MAX_SIGNALS];
+    uint16_t count = 0u;
+
+    if (generation == signal_generation) {
+        for (size_t i = 0u; (i < nr_of_values) && (count < LINSIG_MAX_SIGNALS); i++) {
+            uint16_t index = values[i].index;
+            if ((signal_subscriptions[index >> 5] & (1u << (index & 31u))) != 0u) {
+                subscribed[count] = values[i];
+                count++;
+            }
+        }
+    }
+
+    if (count > 0u) {
+        (void)usb_vendor_bulk_write_notification(signal_tag,
+                                                 MCM_LIN_COMM_SIGNAL_VALUES,
+                                                 (const uint8_t*)subscribed,
+                                                 (uint16_t)(count * sizeof(linsig_value_t)));
+    }
+}
+
 static bool bulk_lin_command_handler(uint16_t command, const uint8_t * data, uint16_t datalen) {
     bool handled = false;
 
+    if (bulk_lin_bus_busy(command)) {
+        /* the bus is owned by a batch, the schedule or the monitor */
+        usb_vendor_bulk_write_error(command,
+                                    MLX_FAIL_INTERFACE_NOT_FREE,
+                                    mlxerr_ErrorCodeToName(MLX_FAIL_INTERFACE_NOT_FREE));
+        return true;
+    }
+
     switch ((vendor_request_lin_comm_t)command) {
         case MCM_LIN_COMM_SEND_WAKEUP:
             lin_err_t error = linmaster_send_wakeup(*((uint16_t*)data));
@@ -77,7 +1056,7 @@ static bool bulk_lin_command_handler(uint16_t command, const uint8_t * data, uin
             bulk_lin_transfer_message_t * message = (bulk_lin_transfer_message_t*)data;
             if (message->m2s != 0u) {
                 /* M2S message */
-                lin_err_t error = linmaster_send_m2s(message->baudrate,
+                lin_err_t error = lintiming_send_m2s(message->baudrate,
                                                      message->enhanced_crc != 0u,
                                                      message->frameid,
                                                      message->payload,
@@ -91,13 +1070,13 @@ static bool bulk_lin_command_handler(uint16_t command, const uint8_t * data, uin
                 handled = true;
             } else {
                 /* S2M message */
-                uint8_t *resp = calloc(message->datalength, sizeof(uint8_t));
-                if (resp != NULL) {
-                    lin_err_t error = linmaster_send_s2m(message->baudrate,
-                                                         message->enhanced_crc != 0u,
-                                                         message->frameid,
-                                                         resp,
-                                                         message->datalength);
+                uint8_t resp[sizeof(message->payload)];
+                if (message->datalength <= sizeof(resp)) {
+                    lin_err_t error = lincache_send_s2m(message->baudrate,
+                                                        message->enhanced_crc != 0u,
+                                                        message->frameid,
+                                                        resp,
+                                                        message->datalength);
 
                     if (error == LIN_OK) {
                         /* Report the received message */
@@ -105,13 +1084,72 @@ static bool bulk_lin_command_handler(uint16_t command, const uint8_t * data, uin
                     } else {
                         usb_vendor_bulk_write_error(command, error, lin_err_to_string(error));
                     }
-                    handled = true;
-                    free(resp);
+                } else {
+                    usb_vendor_bulk_write_error(command,
+                                                MLX_FAIL_INV_DATA_LEN,
+                                                mlxerr_ErrorCodeToName(MLX_FAIL_INV_DATA_LEN));
                 }
+                handled = true;
             }
             break;
         }
 
+        case MCM_LIN_COMM_HANDLE_BATCH:
+            bulk_lin_handle_batch(command, data, datalen);
+            handled = true;
+            break;
+
+        case MCM_LIN_COMM_HANDLE_EVENT_FRAME:
+            bulk_lin_handle_event_frame(command, data, datalen);
+            handled = true;
+            break;
+
+        case MCM_LIN_COMM_SCHEDULE_UPLOAD:
+        case MCM_LIN_COMM_SCHEDULE_START:
+        case MCM_LIN_COMM_SCHEDULE_STOP:
+        case MCM_LIN_COMM_SCHEDULE_SWITCH:
+        case MCM_LIN_COMM_SCHEDULE_STATUS:
+        case MCM_LIN_COMM_SCHEDULE_SPORADIC:
+            bulk_lin_handle_schedule(command, data, datalen);
+            handled = true;
+            break;
+
+        case MCM_LIN_COMM_LD_DIAGNOSTIC:
+        case MCM_LIN_COMM_LD_SEND_MESSAGE:
+        case MCM_LIN_COMM_LD_RECEIVE_MESSAGE:
+            bulk_lin_handle_diagnostic(command, data, datalen);
+            handled = true;
+            break;
+
+        case MCM_LIN_COMM_MONITOR_START:
+        case MCM_LIN_COMM_MONITOR_STOP:
+        case MCM_LIN_COMM_MONITOR_STATUS:
+            bulk_lin_handle_monitor(command, data, datalen);
+            handled = true;
+            break;
+
+        case MCM_LIN_COMM_CACHE_READ:
+        case MCM_LIN_COMM_CACHE_MESSAGE:
+        case MCM_LIN_COMM_CACHE_CLEAR:
+            bulk_lin_handle_cache(command, data, datalen);
+            handled = true;
+            break;
+
+        case MCM_LIN_COMM_SIGNAL_UPLOAD:
+        case MCM_LIN_COMM_SIGNAL_SUBSCRIBE:
+        case MCM_LIN_COMM_SIGNAL_READ:
+        case MCM_LIN_COMM_SIGNAL_STATUS:
+            bulk_lin_handle_signal(command, data, datalen);
+            handled = true;
+            break;
+
+        case MCM_LIN_COMM_TIMING_READ:
+        case MCM_LIN_COMM_TIMING_CLEAR:
+        case MCM_LIN_COMM_TIMING_PHASES:
+            bulk_lin_handle_timing(command, data, datalen);
+            handled = true;
+            break;
+
         default:
             break;
     }
@@ -130,16 +1168,46 @@ bool vendor_handle_class_control_request_lin_comm(uint8_t rhport,
         if ((stage == CONTROL_STAGE_SETUP) && (request->wLength == 0)) {
             if (request->wValue == 1) {
                 ESP_LOGI(TAG, "enable lin mode");
+                /* a batch still pending from the previous session keeps the bus for this one */
+                taskENTER_CRITICAL(&batch_lock);
+                lin_mode_stopped = false;
+                if (!batch_pending) {
+                    batch_job_id = JOB_ID_NONE;
+                }
+                taskEXIT_CRITICAL(&batch_lock);
                 if (busmngr_ClaimInterface(USER_USB_VENDOR, MODE_APPLICATION) == ESP_OK) {
                     powerctrl_slaveEnable();
+                    (void)linsched_add_listener(bulk_lin_schedule_listener, NULL);
+                    (void)linmon_add_listener(bulk_lin_monitor_listener, NULL);
+                    memset(signal_subscriptions, 0, sizeof(signal_subscriptions));
+                    (void)linsig_add_listener(bulk_lin_signal_listener, NULL);
                     (void)usb_vendor_bulk_start_command(bulk_lin_command_handler);
                 }
                 return tud_control_xfer(rhport, request, NULL, 0);
             } else {
                 ESP_LOGI(TAG, "disable lin mode");
                 (void)usb_vendor_bulk_stop();
-                (void)busmngr_ReleaseInterface(USER_USB_VENDOR, MODE_APPLICATION);
-                powerctrl_slaveDisable();
+                if (busmngr_CheckClaim(USER_USB_VENDOR, MODE_APPLICATION)) {
+                    (void)linsched_stop();
+                }
+                linsched_remove_listener(bulk_lin_schedule_listener, NULL);
+                if (busmngr_CheckClaim(USER_USB_VENDOR, MODE_MONITOR)) {
+                    (void)linmon_stop();
+                    (void)busmngr_ReleaseInterface(USER_USB_VENDOR, MODE_MONITOR);
+                }
+                linmon_remove_listener(bulk_lin_monitor_listener, NULL);
+                linsig_remove_listener(bulk_lin_signal_listener, NULL);
+                /* a pending batch stops at its next entry, its done callback releases the bus */
+                taskENTER_CRITICAL(&batch_lock);
+                bool pending = batch_pending;
+                uint32_t id = batch_job_id;
+                lin_mode_stopped = pending;
+                taskEXIT_CRITICAL(&batch_lock);
+                if (!pending) {
+                    bulk_lin_release();
+                } else if (id != JOB_ID_NONE) {
+                    (void)jobs_cancel(id);
+                }
                 return tud_control_status(rhport, request);
             }
         }
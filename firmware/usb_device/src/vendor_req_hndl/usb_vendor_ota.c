@@ -33,6 +33,8 @@
 #include "tinyusb.h"
 
 #include "sdkconfig.h"
+#include "jobs.h"
+#include "mlx_err.h"
 #include "ota_support.h"
 #include "usb_vendor_bulk.h"
 
@@ -42,6 +44,50 @@ static const char *TAG = "usb-vendor-ota";
 
 static bool ota_transfer_mode = false;
 
+/** id of the pending validation job, JOB_ID_NONE if none */
+static uint32_t ota_job_id = JOB_ID_NONE;
+
+/** Validate the transferred firmware update, in the job worker task
+ *
+ * @param[in]  id  job id.
+ * @param[in]  arg  job argument (not used).
+ * @param[out]  error  MLX error code of a failed validation.
+ * @retval  true  image is valid.
+ * @retval  false  image is invalid.
+ */
+static bool usb_vendor_ota_validate_run(uint32_t id, void *arg, int32_t *error) {
+    (void)id;
+    (void)arg;
+    esp_err_t result = otasupport_ValidatePartition();
+    if (result != ESP_OK) {
+        /* the job reports an MLX code like the other jobs, the cause is logged */
+        ESP_LOGE(TAG, "ota validation failed (%s)", esp_err_to_name(result));
+        *error = MLX_FAIL_SERVER_ERR;
+    }
+    return result == ESP_OK;
+}
+
+/** Report the result of the validation to the host, in the job worker task
+ *
+ * @param[in]  id  job id.
+ * @param[in]  state  final state of the job.
+ * @param[in]  error  error code of a failed validation.
+ * @param[in]  arg  job argument (not used).
+ */
+static void usb_vendor_ota_validate_done(uint32_t id, job_state_t state, int32_t error, void *arg) {
+    (void)id;
+    (void)error;
+    (void)arg;
+    if (state == JOB_STATE_DONE) {
+        usb_vendor_bulk_write_string("VALID\n");
+        ESP_LOGI(TAG, "ota transfer done and image valid");
+    } else {
+        usb_vendor_bulk_write_string("FAIL\n");
+        ESP_LOGI(TAG, "ota transfer done and image %s", job_state_to_string(state));
+    }
+    ota_job_id = JOB_ID_NONE;
+}
+
 /** OTA bulk USB communication handler
  *
  * @param[in]  buffer  buffer used for storing temp data.
@@ -53,10 +99,7 @@ static int32_t usb_vendor_bulk_ota_task_handler(char *buffer, int32_t buffer_wr_
 
 static int32_t usb_vendor_bulk_ota_task_handler(char *buffer, int32_t buffer_wr_ptr) {
     size_t item_size = 0;
-    const char *item = (const char *)xRingbufferReceiveUpTo(bulk_rx_buf_handle,
-                                                            &item_size,
-                                                            pdMS_TO_TICKS(25),
-                                                            BULK_TASK_BUFFER_LEN / 4);
+    const char *item = (const char *)usb_vendor_bulk_receive(&item_size, pdMS_TO_TICKS(50));
     if (item != NULL) {
         if (item_size > 0) {
             if (otasupport_Write(item, item_size) != ESP_OK) {
@@ -72,15 +115,17 @@ static int32_t usb_vendor_bulk_ota_task_handler(char *buffer, int32_t buffer_wr_
     if (item_size == 0) {
         if (ota_transfer_mode) {
             usb_vendor_bulk_write_string("EMPTY\n");
-            vTaskDelay(pdMS_TO_TICKS(50));
         } else {
             buffer_wr_ptr = -1;
-            if (otasupport_ValidatePartition() == ESP_OK) {
-                usb_vendor_bulk_write_string("VALID\n");
-                ESP_LOGI(TAG, "ota transfer done and image valid");
-            } else {
+            /* the validation reads back the whole partition, the job answers the host; the id is set
+             * before the job can run, its done callback clears it */
+            if (jobs_submit(JOB_KIND_OTA_VALIDATE,
+                            usb_vendor_ota_validate_run,
+                            usb_vendor_ota_validate_done,
+                            NULL,
+                            &ota_job_id) != ESP_OK) {
                 usb_vendor_bulk_write_string("FAIL\n");
-                ESP_LOGI(TAG, "ota transfer done and image invalid");
+                ESP_LOGI(TAG, "ota transfer done but validation could not be queued");
             }
         }
     }
@@ -98,7 +143,8 @@ bool vendor_handle_class_control_request_ota_transfer(uint8_t rhport,
         if ((stage == CONTROL_STAGE_SETUP) && (request->wLength == 0)) {
             if (request->wValue == 1) {
                 ESP_LOGI(TAG, "do ota transfer");
-                if (otasupport_Start() == ESP_OK) {
+                /* the previous update is still being validated */
+                if ((ota_job_id == JOB_ID_NONE) && (otasupport_Start() == ESP_OK)) {
                     ota_transfer_mode = true;
                     (void)usb_vendor_bulk_start_raw(usb_vendor_bulk_ota_task_handler);
                     return tud_control_status(rhport, request);
@@ -106,6 +152,7 @@ bool vendor_handle_class_control_request_ota_transfer(uint8_t rhport,
             } else {
                 ESP_LOGI(TAG, "stop ota transfer");
                 ota_transfer_mode = false;
+                usb_vendor_bulk_wake();
                 return tud_control_status(rhport, request);
             }
         }
@@ -123,7 +170,7 @@ bool vendor_handle_class_control_request_ota_boot(uint8_t rhport,
 
     if (request->bmRequestType_bit.direction == TUSB_DIR_OUT) {
         if ((stage == CONTROL_STAGE_SETUP) && (request->wLength == 0)) {
-            if (otasupport_UpdateBootPartition() == ESP_OK) {
+            if ((ota_job_id == JOB_ID_NONE) && (otasupport_UpdateBootPartition() == ESP_OK)) {
                 return tud_control_status(rhport, request);
             }
         }
@@ -26,7 +26,7 @@
 #include "esp_http_server.h"
 
 /** number of uri handlers consumed by REST API */
-#define REST_NR_OF_URI_HANDLERS 6
+#define REST_NR_OF_URI_HANDLERS 13
 
 /** Register all REST API URI handlers
  *
@@ -18,6 +18,7 @@
  *
  * @details This file contains the implementations of the REST API URI handlers.
  */
+#include <stdlib.h>
 #include <string.h>
 #include <fcntl.h>
 
@@ -32,7 +33,12 @@
 #include "sdkconfig.h"
 #include "device_info.h"
 #include "device_status.h"
+#include "jobs.h"
+#include "lin_cache.h"
+#include "lin_err.h"
+#include "lin_timing.h"
 #include "networking.h"
+#include "standalone.h"
 #include "webserver.h"
 #include "wifi.h"
 
@@ -242,6 +248,475 @@ static esp_err_t api_system_identify_handler(httpd_req_t *req) {
     return err;
 }
 
+/** Add a cached entry to a json object */
+static void api_lin_cache_entry_to_json(const lincache_entry_t *entry, cJSON *object) {
+    cJSON_AddNumberToObject(object, "frameid", entry->frameid);
+    cJSON_AddNumberToObject(object, "age", entry->age_ms);
+    cJSON_AddNumberToObject(object, "count", entry->count);
+    cJSON_AddNumberToObject(object, "errors", entry->errors);
+    cJSON_AddStringToObject(object, "status", lin_err_to_string((lin_err_t)entry->status));
+    cJSON *data = cJSON_AddArrayToObject(object, "data");
+    for (uint8_t i = 0u; i < entry->datalength; i++) {
+        cJSON_AddItemToArray(data, cJSON_CreateNumber(entry->data[i]));
+    }
+}
+
+/** URI Handler: LIN last-value cache */
+static esp_err_t api_lin_cache_handler(httpd_req_t *req) {
+    if (req->method != HTTP_GET) {
+        return api_method_not_allowed(req);
+    }
+
+    int frameid = -1;
+    uint32_t max_age = UINT32_MAX;
+    char query[48];
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
+        char value[12];
+        if (httpd_query_key_value(query, "frameid", value, sizeof(value)) == ESP_OK) {
+            frameid = atoi(value);
+            if ((frameid < 0) || (frameid >= (int)LINCACHE_NR_OF_FRAMES)) {
+                return api_bad_request(req);
+            }
+        }
+        if (httpd_query_key_value(query, "max_age", value, sizeof(value)) == ESP_OK) {
+            max_age = (uint32_t)strtoul(value, NULL, 10);
+        }
+    }
+
+    cJSON *root = NULL;
+    lincache_entry_t entry;
+    if (frameid >= 0) {
+        if (!lincache_get((uint8_t)frameid, &entry) || (entry.age_ms > max_age)) {
+            httpd_resp_set_status(req, "404 Not Found");
+            return httpd_resp_send(req, NULL, 0);
+        }
+        root = cJSON_CreateObject();
+        if (root != NULL) {
+            api_lin_cache_entry_to_json(&entry, root);
+        }
+    } else {
+        root = cJSON_CreateArray();
+        for (uint8_t id = 0u; (root != NULL) && (id < LINCACHE_NR_OF_FRAMES); id++) {
+            if (lincache_get(id, &entry) && (entry.age_ms <= max_age)) {
+                cJSON *entry_json = cJSON_CreateObject();
+                api_lin_cache_entry_to_json(&entry, entry_json);
+                cJSON_AddItemToArray(root, entry_json);
+            }
+        }
+    }
+    if (root == NULL) {
+        return api_internal_server_error(req);
+    }
+
+    /* create response */
+    httpd_resp_set_type(req, "application/json");
+    const char *cache = cJSON_Print(root);
+    httpd_resp_sendstr(req, cache);
+    free((void *)cache);
+
+    cJSON_Delete(root);
+
+    return ESP_OK;
+}
+
+/** Add the timing statistics of a frame to a json object */
+static void api_lin_timing_entry_to_json(const lintiming_entry_t *entry, cJSON *object) {
+    cJSON_AddNumberToObject(object, "frameid", entry->frameid);
+    cJSON_AddNumberToObject(object, "baudrate", entry->baudrate);
+    cJSON_AddNumberToObject(object, "datalength", entry->datalength);
+    cJSON_AddNumberToObject(object, "count", entry->count);
+    cJSON_AddNumberToObject(object, "errors", entry->errors);
+    cJSON_AddNumberToObject(object, "min", entry->min_us);
+    cJSON_AddNumberToObject(object, "avg", entry->avg_us);
+    cJSON_AddNumberToObject(object, "max", entry->max_us);
+    cJSON_AddNumberToObject(object, "nominal", entry->nominal_us);
+    cJSON_AddNumberToObject(object, "over_max", entry->over_max);
+    cJSON *histogram = cJSON_AddArrayToObject(object, "histogram");
+    for (uint8_t i = 0u; i < LINTIMING_HISTOGRAM_BINS; i++) {
+        cJSON_AddItemToArray(histogram, cJSON_CreateNumber(entry->histogram[i]));
+    }
+
+    lintiming_phase_entry_t phase_entry;
+    if (lintiming_get_phases(entry->frameid, &phase_entry)) {
+        cJSON *phases_json = cJSON_AddObjectToObject(object, "phases");
+        cJSON_AddNumberToObject(phases_json, "count", phase_entry.count);
+        cJSON_AddNumberToObject(phases_json, "missed", phase_entry.missed);
+        for (uint8_t phase = 0u; phase < LINTIMING_NR_OF_PHASES; phase++) {
+            cJSON *phase_json = cJSON_AddObjectToObject(phases_json, lintiming_phase_name((lintiming_phase_t)phase));
+            cJSON_AddNumberToObject(phase_json, "min", phase_entry.phases[phase].min_us);
+            cJSON_AddNumberToObject(phase_json, "avg", phase_entry.phases[phase].avg_us);
+            cJSON_AddNumberToObject(phase_json, "max", phase_entry.phases[phase].max_us);
+        }
+        cJSON *last_json = cJSON_AddObjectToObject(phases_json, "last");
+        cJSON_AddNumberToObject(last_json, "break", phase_entry.last.break_us);
+        cJSON_AddNumberToObject(last_json, "sync", phase_entry.last.sync_us);
+        cJSON_AddNumberToObject(last_json, "pid", phase_entry.last.pid_us);
+        cJSON_AddNumberToObject(last_json, "response", phase_entry.last.response_us);
+        cJSON_AddNumberToObject(last_json, "checksum", phase_entry.last.checksum_us);
+        cJSON_AddNumberToObject(last_json, "end", phase_entry.last.end_us);
+    }
+}
+
+/** URI Handler: LIN frame timing statistics */
+static esp_err_t api_lin_timing_handler(httpd_req_t *req) {
+    if (req->method == HTTP_DELETE) {
+        lintiming_clear();
+        httpd_resp_set_status(req, "204 No Content");
+        return httpd_resp_send(req, NULL, 0);
+    } else if (req->method != HTTP_GET) {
+        return api_method_not_allowed(req);
+    }
+
+    int frameid = -1;
+    char query[32];
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
+        char value[12];
+        if (httpd_query_key_value(query, "frameid", value, sizeof(value)) == ESP_OK) {
+            frameid = atoi(value);
+            if ((frameid < 0) || (frameid >= (int)LINTIMING_NR_OF_FRAMES)) {
+                return api_bad_request(req);
+            }
+        }
+    }
+
+    cJSON *root = NULL;
+    lintiming_entry_t entry;
+    if (frameid >= 0) {
+        if (!lintiming_get((uint8_t)frameid, &entry)) {
+            httpd_resp_set_status(req, "404 Not Found");
+            return httpd_resp_send(req, NULL, 0);
+        }
+        root = cJSON_CreateObject();
+        if (root != NULL) {
+            api_lin_timing_entry_to_json(&entry, root);
+        }
+    } else {
+        root = cJSON_CreateArray();
+        for (uint8_t id = 0u; (root != NULL) && (id < LINTIMING_NR_OF_FRAMES); id++) {
+            if (lintiming_get(id, &entry)) {
+                cJSON *entry_json = cJSON_CreateObject();
+                api_lin_timing_entry_to_json(&entry, entry_json);
+                cJSON_AddItemToArray(root, entry_json);
+            }
+        }
+    }
+    if (root == NULL) {
+        return api_internal_server_error(req);
+    }
+
+    /* create response */
+    httpd_resp_set_type(req, "application/json");
+    const char *timing = cJSON_Print(root);
+    httpd_resp_sendstr(req, timing);
+    free((void *)timing);
+
+    cJSON_Delete(root);
+
+    return ESP_OK;
+}
+
+/** Convert the stand-alone job parameters to a json object */
+static void api_standalone_config_to_json(const standalone_config_t *config, cJSON *object) {
+    char hash_str[FWCACHE_HASH_STR_LEN];
+    const char *memory = "flash";
+
+    if (config->memory == PPM_MEM_NVRAM) {
+        memory = "nvram";
+    } else if (config->memory == PPM_MEM_FLASH_CS) {
+        memory = "flash_cs";
+    }
+    fwcache_hash_to_string(config->hash, hash_str);
+    cJSON_AddBoolToObject(object, "enabled", config->enabled);
+    cJSON_AddStringToObject(object, "image", hash_str);
+    cJSON_AddStringToObject(object, "memory", memory);
+    cJSON_AddNumberToObject(object, "bitrate", config->bitrate);
+    cJSON_AddBoolToObject(object, "broadcast", config->broadcast);
+    cJSON_AddBoolToObject(object, "manpow", config->manpow);
+    cJSON_AddBoolToObject(object, "differential", config->differential);
+}
+
+/** Update the stand-alone job parameters from a json object
+ *
+ * @returns  false when a parameter is invalid.
+ */
+static bool api_standalone_config_from_json(const cJSON *object, standalone_config_t *config) {
+    bool retval = true;
+    cJSON *item;
+
+    if ((item = cJSON_GetObjectItem(object, "enabled")) != NULL) {
+        retval = cJSON_IsBool(item);
+        config->enabled = cJSON_IsTrue(item);
+    }
+    if (retval && ((item = cJSON_GetObjectItem(object, "image")) != NULL)) {
+        retval = cJSON_IsString(item) && fwcache_hash_from_string(cJSON_GetStringValue(item), config->hash);
+    }
+    if (retval && ((item = cJSON_GetObjectItem(object, "memory")) != NULL)) {
+        const char *memory = cJSON_GetStringValue(item);
+        if (memory == NULL) {
+            retval = false;
+        } else if (strcasecmp(memory, "flash") == 0) {
+            config->memory = PPM_MEM_FLASH;
+        } else if (strcasecmp(memory, "flash_cs") == 0) {
+            config->memory = PPM_MEM_FLASH_CS;
+        } else if ((strcasecmp(memory, "nvram") == 0) || (strcasecmp(memory, "eeprom") == 0)) {
+            config->memory = PPM_MEM_NVRAM;
+        } else {
+            retval = false;
+        }
+    }
+    if (retval && ((item = cJSON_GetObjectItem(object, "bitrate")) != NULL)) {
+        retval = cJSON_IsNumber(item) && (cJSON_GetNumberValue(item) > 0);
+        config->bitrate = (uint32_t)cJSON_GetNumberValue(item);
+    }
+    if ((item = cJSON_GetObjectItem(object, "broadcast")) != NULL) {
+        config->broadcast = cJSON_IsTrue(item);
+    }
+    if ((item = cJSON_GetObjectItem(object, "manpow")) != NULL) {
+        config->manpow = cJSON_IsTrue(item);
+    }
+    if ((item = cJSON_GetObjectItem(object, "differential")) != NULL) {
+        config->differential = cJSON_IsTrue(item);
+    }
+
+    return retval;
+}
+
+/** URI Handler: stand-alone programming job parameters and counters */
+static esp_err_t api_standalone_handler(httpd_req_t *req) {
+    if ((req->method != HTTP_PUT) && (req->method != HTTP_GET)) {
+        return api_method_not_allowed(req);
+    }
+
+    standalone_config_t config;
+    standalone_get_config(&config);
+
+    if (req->method == HTTP_PUT) {
+        cJSON *root = NULL;
+        if ((get_post_json_payload(req, &root) != ESP_OK) || (root == NULL)) {
+            return api_bad_request(req);
+        }
+        bool valid = api_standalone_config_from_json(root, &config);
+        cJSON_Delete(root);
+        if (!valid) {
+            return api_bad_request(req);
+        }
+
+        esp_err_t err = standalone_set_config(&config);
+        if (err == ESP_ERR_NOT_FOUND) {
+            httpd_resp_set_status(req, "404 Not Found");
+            return httpd_resp_sendstr(req, "image is not cached");
+        } else if (err == ESP_ERR_INVALID_STATE) {
+            httpd_resp_set_status(req, "409 Conflict");
+            return httpd_resp_send(req, NULL, 0);
+        } else if (err == ESP_ERR_INVALID_ARG) {
+            return api_bad_request(req);
+        } else if (err != ESP_OK) {
+            return api_internal_server_error(req);
+        }
+    }
+
+    cJSON *resp = cJSON_CreateObject();
+    if (resp == NULL) {
+        return api_internal_server_error(req);
+    }
+
+    api_standalone_config_to_json(&config, resp);
+    const char *state = "disabled";
+    if (standalone_busy()) {
+        state = "busy";
+    } else if (config.enabled) {
+        state = "idle";
+    }
+    cJSON_AddStringToObject(resp, "state", state);
+
+    standalone_counters_t counters;
+    standalone_get_counters(&counters);
+    cJSON *counters_json = cJSON_AddObjectToObject(resp, "counters");
+    cJSON_AddNumberToObject(counters_json, "jobs", counters.jobs);
+    cJSON_AddNumberToObject(counters_json, "passed", counters.passed);
+    cJSON_AddNumberToObject(counters_json, "failed", counters.failed);
+    cJSON_AddNumberToObject(counters_json, "min", counters.min_ms);
+    cJSON_AddNumberToObject(counters_json, "avg", standalone_log_average_ms(&counters));
+    cJSON_AddNumberToObject(counters_json, "max", counters.max_ms);
+
+    /* the last job is the newest job in the log */
+    standalone_record_t record;
+    uint32_t logged = (counters.jobs < STANDALONE_LOG_MAX_RECORDS) ? counters.jobs : STANDALONE_LOG_MAX_RECORDS;
+    if ((logged > 0u) && standalone_get_record(logged - 1u, &record)) {
+        cJSON *last = cJSON_AddObjectToObject(resp, "last");
+        cJSON_AddNumberToObject(last, "job", record.job);
+        cJSON_AddStringToObject(last, "result", standalone_result_to_string((standalone_result_t)record.result));
+        cJSON_AddNumberToObject(last, "duration", record.duration_ms);
+    }
+
+    /* create response */
+    httpd_resp_set_type(req, "application/json");
+    const char *standalone_info = cJSON_Print(resp);
+    httpd_resp_sendstr(req, standalone_info);
+    free((void *)standalone_info);
+
+    cJSON_Delete(resp);
+
+    return ESP_OK;
+}
+
+/** URI Handler: start a stand-alone programming job */
+static esp_err_t api_standalone_trigger_handler(httpd_req_t *req) {
+    if (req->method != HTTP_PUT) {
+        return api_method_not_allowed(req);
+    }
+
+    uint32_t job_id = JOB_ID_NONE;
+    esp_err_t err = standalone_trigger(STANDALONE_TRIGGER_REST, &job_id);
+    if (err == ESP_ERR_NO_MEM) {
+        httpd_resp_set_status(req, "503 Service Unavailable");
+        return httpd_resp_send(req, NULL, 0);
+    } else if (err != ESP_OK) {
+        httpd_resp_set_status(req, "409 Conflict");
+        return httpd_resp_send(req, NULL, 0);
+    }
+
+    /* create response */
+    cJSON *resp = cJSON_CreateObject();
+    if (resp == NULL) {
+        return api_internal_server_error(req);
+    }
+    cJSON_AddNumberToObject(resp, "job", job_id);
+
+    httpd_resp_set_status(req, "202 Accepted");
+    httpd_resp_set_type(req, "application/json");
+    const char *trigger_info = cJSON_Print(resp);
+    httpd_resp_sendstr(req, trigger_info);
+    free((void *)trigger_info);
+
+    cJSON_Delete(resp);
+
+    return ESP_OK;
+}
+
+/** URI Handler: stand-alone programming cycle-time log */
+static esp_err_t api_standalone_log_handler(httpd_req_t *req) {
+    if (req->method == HTTP_DELETE) {
+        if (standalone_clear_log() != ESP_OK) {
+            return api_internal_server_error(req);
+        }
+        httpd_resp_set_status(req, "204 No Content");
+        return httpd_resp_send(req, NULL, 0);
+    } else if (req->method != HTTP_GET) {
+        return api_method_not_allowed(req);
+    }
+
+    httpd_resp_set_type(req, "text/csv");
+    httpd_resp_set_hdr(req, "Content-Disposition", "attachment; filename=\"standalone_log.csv\"");
+    esp_err_t err = httpd_resp_sendstr_chunk(req, STANDALONE_LOG_CSV_HEADER);
+
+    standalone_record_t record;
+    char line[STANDALONE_LOG_CSV_LINE_LEN];
+    for (uint32_t position = 0u; (err == ESP_OK) && standalone_get_record(position, &record); position++) {
+        (void)standalone_log_format(&record, line);
+        err = httpd_resp_sendstr_chunk(req, line);
+    }
+    if (err == ESP_OK) {
+        err = httpd_resp_sendstr_chunk(req, NULL);
+    }
+
+    return err;
+}
+
+/** Add the information of a job to a json object */
+static void api_job_to_json(const job_info_t *info, cJSON *object) {
+    cJSON_AddNumberToObject(object, "job", info->id);
+    cJSON_AddStringToObject(object, "kind", job_kind_to_string((job_kind_t)info->kind));
+    cJSON_AddStringToObject(object, "state", job_state_to_string((job_state_t)info->state));
+    cJSON_AddBoolToObject(object, "cancel_requested", info->cancel_requested != 0u);
+    cJSON_AddNumberToObject(object, "error", info->error);
+    cJSON_AddNumberToObject(object, "created_ms", info->created_ms);
+    cJSON_AddNumberToObject(object, "started_ms", info->started_ms);
+    cJSON_AddNumberToObject(object, "finished_ms", info->finished_ms);
+}
+
+/** URI Handler: queued, running and recently finished jobs */
+static esp_err_t api_jobs_handler(httpd_req_t *req) {
+    if (req->method != HTTP_GET) {
+        return api_method_not_allowed(req);
+    }
+
+    /* static, the uri handlers run in the httpd task */
+    static job_info_t infos[JOB_TABLE_SIZE];
+    size_t nr_of_jobs = jobs_list(infos, JOB_TABLE_SIZE);
+
+    cJSON *root = cJSON_CreateArray();
+    for (size_t i = 0u; (root != NULL) && (i < nr_of_jobs); i++) {
+        cJSON *info_json = cJSON_CreateObject();
+        api_job_to_json(&infos[i], info_json);
+        cJSON_AddItemToArray(root, info_json);
+    }
+    if (root == NULL) {
+        return api_internal_server_error(req);
+    }
+
+    /* create response */
+    httpd_resp_set_type(req, "application/json");
+    const char *jobs_info = cJSON_Print(root);
+    httpd_resp_sendstr(req, jobs_info);
+    free((void *)jobs_info);
+
+    cJSON_Delete(root);
+
+    return ESP_OK;
+}
+
+/** URI Handler: state of a job, or cancel it */
+static esp_err_t api_job_handler(httpd_req_t *req) {
+    if ((req->method != HTTP_GET) && (req->method != HTTP_DELETE)) {
+        return api_method_not_allowed(req);
+    }
+
+    const char *id_str = req->uri + strlen("/api/v1/jobs/");
+    char *end = NULL;
+    unsigned long id = strtoul(id_str, &end, 10);
+    if ((end == id_str) || ((*end != '\0') && (*end != '/') && (*end != '?'))) {
+        return api_bad_request(req);
+    }
+
+    if (req->method == HTTP_DELETE) {
+        job_cancel_result_t cancel = jobs_cancel((uint32_t)id);
+        if (cancel == JOB_CANCEL_UNKNOWN) {
+            httpd_resp_set_status(req, "404 Not Found");
+        } else if (cancel == JOB_CANCEL_TOO_LATE) {
+            httpd_resp_set_status(req, "409 Conflict");
+        } else if (cancel == JOB_CANCEL_REQUESTED) {
+            /* the job stops at its next cancel check */
+            httpd_resp_set_status(req, "202 Accepted");
+        } else {
+            httpd_resp_set_status(req, "204 No Content");
+        }
+        return httpd_resp_send(req, NULL, 0);
+    }
+
+    job_info_t info;
+    if (jobs_get((uint32_t)id, &info) != ESP_OK) {
+        httpd_resp_set_status(req, "404 Not Found");
+        return httpd_resp_send(req, NULL, 0);
+    }
+
+    cJSON *root = cJSON_CreateObject();
+    if (root == NULL) {
+        return api_internal_server_error(req);
+    }
+    api_job_to_json(&info, root);
+
+    /* create response */
+    httpd_resp_set_type(req, "application/json");
+    const char *job_info = cJSON_Print(root);
+    httpd_resp_sendstr(req, job_info);
+    free((void *)job_info);
+
+    cJSON_Delete(root);
+
+    return ESP_OK;
+}
+
 esp_err_t rest_register_uri(httpd_handle_t server, void *user_ctx) {
     esp_err_t retval;
 
@@ -310,6 +785,97 @@ esp_err_t rest_register_uri(httpd_handle_t server, void *user_ctx) {
         return retval;
     }
 
+    httpd_uri_t lin_cache_uri = {
+        .uri = "/api/v1/lin/cache/?",
+        .method = HTTP_ANY,
+        .handler = api_lin_cache_handler,
+        .user_ctx = user_ctx,
+        .is_websocket = false,
+        .handle_ws_control_frames = false
+    };
+    retval = httpd_register_uri_handler(server, &lin_cache_uri);
+    if (retval != ESP_OK) {
+        return retval;
+    }
+
+    httpd_uri_t lin_timing_uri = {
+        .uri = "/api/v1/lin/timing/?",
+        .method = HTTP_ANY,
+        .handler = api_lin_timing_handler,
+        .user_ctx = user_ctx,
+        .is_websocket = false,
+        .handle_ws_control_frames = false
+    };
+    retval = httpd_register_uri_handler(server, &lin_timing_uri);
+    if (retval != ESP_OK) {
+        return retval;
+    }
+
+    httpd_uri_t standalone_uri = {
+        .uri = "/api/v1/standalone/?",
+        .method = HTTP_ANY,
+        .handler = api_standalone_handler,
+        .user_ctx = user_ctx,
+        .is_websocket = false,
+        .handle_ws_control_frames = false
+    };
+    retval = httpd_register_uri_handler(server, &standalone_uri);
+    if (retval != ESP_OK) {
+        return retval;
+    }
+
+    httpd_uri_t standalone_trigger_uri = {
+        .uri = "/api/v1/standalone/trigger/?",
+        .method = HTTP_ANY,
+        .handler = api_standalone_trigger_handler,
+        .user_ctx = user_ctx,
+        .is_websocket = false,
+        .handle_ws_control_frames = false
+    };
+    retval = httpd_register_uri_handler(server, &standalone_trigger_uri);
+    if (retval != ESP_OK) {
+        return retval;
+    }
+
+    httpd_uri_t standalone_log_uri = {
+        .uri = "/api/v1/standalone/log/?",
+        .method = HTTP_ANY,
+        .handler = api_standalone_log_handler,
+        .user_ctx = user_ctx,
+        .is_websocket = false,
+        .handle_ws_control_frames = false
+    };
+    retval = httpd_register_uri_handler(server, &standalone_log_uri);
+    if (retval != ESP_OK) {
+        return retval;
+    }
+
+    httpd_uri_t jobs_uri = {
+        .uri = "/api/v1/jobs/?",
+        .method = HTTP_ANY,
+        .handler = api_jobs_handler,
+        .user_ctx = user_ctx,
+        .is_websocket = false,
+        .handle_ws_control_frames = false
+    };
+    retval = httpd_register_uri_handler(server, &jobs_uri);
+    if (retval != ESP_OK) {
+        return retval;
+    }
+
+    httpd_uri_t job_uri = {
+        .uri = "/api/v1/jobs/*",
+        .method = HTTP_ANY,
+        .handler = api_job_handler,
+        .user_ctx = user_ctx,
+        .is_websocket = false,
+        .handle_ws_control_frames = false
+    };
+    retval = httpd_register_uri_handler(server, &job_uri);
+    if (retval != ESP_OK) {
+        return retval;
+    }
+
     httpd_uri_t api_not_implemented_uri = {
         .uri = "/api/?*",
         .method = HTTP_ANY,
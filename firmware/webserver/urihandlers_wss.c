@@ -31,10 +31,20 @@
 
 #include "bus_manager.h"
 #include "device_info.h"
+#include "fw_cache.h"
+#include "fw_image.h"
+#include "jobs.h"
+#include "lin_cache.h"
 #include "lin_master.h"
+#include "lin_monitor.h"
+#include "lin_schedule.h"
+#include "lin_signal.h"
+#include "lin_timing.h"
+#include "lin_transport.h"
 #include "mlx_err.h"
 #include "power_ctrl.h"
 #include "ppm_bootloader.h"
+#include "progress.h"
 #include "wifi.h"
 
 #include "webserver.h"
@@ -50,14 +60,55 @@ static const char *TAG = "wss";
 struct async_resp_arg {
     httpd_handle_t hd;
     int fd;
+    uint32_t session;
+    char *message;
+    size_t length;
+    httpd_ws_type_t type;
 };
 
 typedef struct wss_client_info_s {
     int sockfd;                                 /**< socket fd of the client connection */
+    uint32_t session;                           /**< session number, tells connections on a reused socket apart */
     uint8_t *message;                           /**< pointer to buffer where the fragmented message is stored */
     size_t message_len;                         /**< length of the message */
+    bool discarding;                            /**< the continuation frames of a refused binary message are dropped */
+    bool monitor_subscribed;                    /**< client receives the bus monitor records */
+    uint32_t signal_generation;                 /**< signal database generation of the subscriptions */
+    uint32_t signal_subscriptions[LINSIG_MAX_SIGNALS / 32u];  /**< bitmap of the subscribed signals */
 } wss_client_info_t;
 
+/** binary message identifier of the bus monitor records (same as the USB bulk command) */
+#define WSS_BINARY_MONITOR_RECORDS 0x2232u
+
+/** maximum number of binary monitor messages waiting to be sent */
+#define WSS_MONITOR_MAX_INFLIGHT 8u
+
+/** binary message identifier of an image upload chunk */
+#define WSS_BINARY_HEX_CHUNK 0x3000u
+
+/** maximum length of the image data in one upload chunk */
+#define WSS_HEX_CHUNK_MAX_LEN 8192u
+
+/** length of the image upload chunk header: identifier (uint16), reserved (uint16), offset (uint32) */
+#define WSS_HEX_CHUNK_HEADER_LEN 8u
+
+/** maximum length of a binary message */
+#define WSS_BINARY_MAX_LEN (WSS_HEX_CHUNK_HEADER_LEN + WSS_HEX_CHUNK_MAX_LEN)
+
+/** Image upload state
+ *
+ * The upload is an Intel HEX file or a binary image. It is parsed into the image as the chunks arrive,
+ * only the image and the incomplete record at the end of the last chunk are kept, not the file.
+ */
+typedef struct wss_hex_upload_s {
+    int sockfd;                                 /**< socket of the client owning the upload, 0 if none */
+    bool committed;                             /**< all chunks are received and parsed */
+    const char *error;                          /**< first error of the upload, NULL if none */
+    uint32_t offset;                            /**< offset expected for the next chunk */
+    fwimg_t image;                              /**< parsed image */
+    fwimg_loader_t loader;                      /**< file loader */
+} wss_hex_upload_t;
+
 wss_client_info_t open_clients[MAX_WWW_CLIENTS];  // todo this should be 2 dimensional including httpd_handle_t
 
 /** wss handler error code enum */
@@ -67,9 +118,43 @@ typedef enum wss_error_code_e {
     WSS_ERR_COMMAND_UNKNOWN,                    /**< wss handler: received unknown command */
     WSS_ERR_ALREADY_SET,                        /**< wss handler: error json already populated */
     WSS_ERR_ITF_NOT_AVAILABLE,                  /**< wss handler: lin interface is not available */
+    WSS_ERR_DEFERRED,                           /**< wss handler: response is sent when the job finishes */
     WSS_ERR_UNKNOWN,                            /**< wss handler: unknown error */
 } wss_error_code_t;                             /**< wss handler error code type */
 
+/** server the websocket handlers are registered with */
+static httpd_handle_t wss_server = NULL;
+
+/** true when the schedule result listener is registered */
+static bool wss_schedule_listener_registered = false;
+
+/** true when the monitor record listener is registered */
+static bool wss_monitor_listener_registered = false;
+
+/** number of binary monitor messages waiting to be sent */
+static uint32_t wss_monitor_inflight = 0u;
+
+/** true when the signal change listener is registered */
+static bool wss_signal_listener_registered = false;
+
+/** true when the progress listener is registered */
+static bool wss_progress_listener_registered = false;
+
+/** true when the job listener is registered */
+static bool wss_jobs_listener_registered = false;
+
+/** session number of the last opened connection */
+static uint32_t wss_last_session = 0u;
+
+/** socket of the client whose message is being handled */
+static int wss_current_sockfd = 0;
+
+/** id of the message being handled, NULL if it has none */
+static const char *wss_current_id = NULL;
+
+/** image upload, only one client can upload at a time */
+static wss_hex_upload_t wss_hex_upload = {0};
+
 static wss_client_info_t* wss_get_client_connection_info(int sockfd) {
     wss_client_info_t *retval = NULL;
     for (int client = 0; client < MAX_WWW_CLIENTS; client++) {
@@ -124,92 +209,1150 @@ static wss_error_code_t wss_lin_ifc_wake_up(const cJSON * const params, cJSON *
             retval = WSS_ERR_ALREADY_SET;
         }
     } else {
-        cJSON_AddStringToObject(result, "message", mlxerr_ErrorCodeToName(MLX_FAIL_INTERFACE_NOT_FREE));
-        retval = WSS_ERR_ALREADY_SET;
+        cJSON_AddStringToObject(result, "message", mlxerr_ErrorCodeToName(MLX_FAIL_INTERFACE_NOT_FREE));
+        retval = WSS_ERR_ALREADY_SET;
+    }
+
+    return retval;
+}
+
+/** Fill the associated frame list of an event triggered or sporadic entry
+ *
+ * @param[in]  frames_json  array of frame identifiers, in order of priority.
+ * @param[out]  entry  entry of which the payload holds the associated frames afterwards.
+ */
+static void wss_lin_associated_frames(const cJSON *frames_json, linsched_entry_t *entry) {
+    int nr_of_frames = cJSON_GetArraySize(frames_json);
+
+    memset(entry->payload, LINSCHED_NO_FRAME, sizeof(entry->payload));
+    for (int i = 0; (i < nr_of_frames) && (i < LINSCHED_MAX_ASSOCIATED); i++) {
+        entry->payload[i] = (uint8_t)cJSON_GetArrayItem(frames_json, i)->valueint;
+    }
+    if (nr_of_frames > LINSCHED_MAX_ASSOCIATED) {
+        /* too many frames, caught by the validation */
+        entry->payload[0] = LINSCHED_NO_FRAME;
+    }
+}
+
+static wss_error_code_t wss_lin_event_triggered(const cJSON * const params, cJSON * result) {
+    static const char * const outcome_names[] = {"none", "response", "collision", "error"};
+    wss_error_code_t retval = WSS_ERR_ALREADY_SET;
+
+    if (busmngr_ClaimInterface(USER_WIFI, MODE_APPLICATION) == ESP_OK) {
+        cJSON *baudrate_json = cJSON_GetObjectItem(params, "baudrate");
+        cJSON *frameid_json = cJSON_GetObjectItem(params, "frameid");
+        cJSON *datalength_json = cJSON_GetObjectItem(params, "datalength");
+        cJSON *frames_json = cJSON_GetObjectItem(params, "frames");
+
+        if ((baudrate_json != NULL) && (frameid_json != NULL) && (datalength_json != NULL) &&
+            cJSON_IsArray(frames_json)) {
+            linsched_entry_t entry;
+            linsched_event_result_t events[LINSCHED_MAX_ASSOCIATED];
+            linsched_event_outcome_t outcome = LINSCHED_EVENT_NONE;
+            uint8_t nr_of_events = 0u;
+
+            memset(&entry, 0, sizeof(entry));
+            entry.type = LINSCHED_EVENT_TRIGGERED;
+            entry.frameid = (uint8_t)cJSON_GetNumberValue(frameid_json);
+            entry.datalength = (uint8_t)cJSON_GetNumberValue(datalength_json);
+            entry.enhanced_crc = cJSON_IsTrue(cJSON_GetObjectItem(params, "enhanced_crc")) ? 1u : 0u;
+            wss_lin_associated_frames(frames_json, &entry);
+
+            if (linsched_event_triggered((uint16_t)cJSON_GetNumberValue(baudrate_json),
+                                         &entry,
+                                         events,
+                                         &nr_of_events,
+                                         &outcome) != ESP_OK) {
+                cJSON_AddStringToObject(result, "message", "Corrupted request");
+            } else if (outcome == LINSCHED_EVENT_ERROR) {
+                cJSON_AddStringToObject(result, "message", lin_err_to_string((lin_err_t)events[0].status));
+            } else {
+                cJSON_AddStringToObject(result, "event", outcome_names[outcome]);
+                cJSON *results_json = cJSON_AddArrayToObject(result, "results");
+                for (uint8_t i = 0u; i < nr_of_events; i++) {
+                    cJSON *event_json = cJSON_CreateObject();
+                    cJSON_AddNumberToObject(event_json, "frameid", events[i].frameid);
+                    if (events[i].status == LIN_OK) {
+                        cJSON *data_json = cJSON_AddArrayToObject(event_json, "data");
+                        for (uint8_t byte = 0u; byte < events[i].datalength; byte++) {
+                            cJSON_AddItemToArray(data_json, cJSON_CreateNumber(events[i].data[byte]));
+                        }
+                    } else {
+                        cJSON_AddStringToObject(event_json, "message", lin_err_to_string((lin_err_t)events[i].status));
+                    }
+                    cJSON_AddItemToArray(results_json, event_json);
+                }
+                retval = WSS_ERR_NONE;
+            }
+        } else {
+            cJSON_AddStringToObject(result, "message", "Corrupted request");
+        }
+    } else {
+        cJSON_AddStringToObject(result, "message", mlxerr_ErrorCodeToName(MLX_FAIL_INTERFACE_NOT_FREE));
+    }
+
+    return retval;
+}
+
+static wss_error_code_t wss_lin_sporadic_update(const cJSON * const params, cJSON * result) {
+    wss_error_code_t retval = WSS_ERR_ALREADY_SET;
+    cJSON *frameid_json = cJSON_GetObjectItem(params, "frameid");
+    cJSON *payload_json = cJSON_GetObjectItem(params, "payload");
+    int datalength = cJSON_GetArraySize(payload_json);
+
+    if ((frameid_json != NULL) && cJSON_IsArray(payload_json) && (datalength <= LINSCHED_MAX_DATA_LEN)) {
+        uint8_t payload[LINSCHED_MAX_DATA_LEN];
+        for (int i = 0; i < datalength; i++) {
+            payload[i] = (uint8_t)cJSON_GetArrayItem(payload_json, i)->valueint;
+        }
+        if (linsched_sporadic_update((uint8_t)cJSON_GetNumberValue(frameid_json),
+                                     payload,
+                                     (uint8_t)datalength) == ESP_OK) {
+            retval = WSS_ERR_NONE;
+        } else {
+            cJSON_AddStringToObject(result, "message", "Corrupted request");
+        }
+    } else {
+        cJSON_AddStringToObject(result, "message", mlxerr_ErrorCodeToName(MLX_FAIL_INV_DATA_LEN));
+    }
+
+    return retval;
+}
+
+static wss_error_code_t wss_lin_handle_message_on_bus(const cJSON * const params, cJSON * result) {
+    wss_error_code_t retval = WSS_ERR_COMMAND_UNKNOWN;
+
+    if (busmngr_ClaimInterface(USER_WIFI, MODE_APPLICATION) == ESP_OK) {
+        cJSON *datalength_json = cJSON_GetObjectItem(params, "datalength");
+        cJSON *m2s_json = cJSON_GetObjectItem(params, "m2s");
+        cJSON *baudrate_json = cJSON_GetObjectItem(params, "baudrate");
+        cJSON *enhanced_crc_json = cJSON_GetObjectItem(params, "enhanced_crc");
+        cJSON *frameid_json = cJSON_GetObjectItem(params, "frameid");
+
+        if ((datalength_json != NULL) && (m2s_json != NULL) &&
+            (baudrate_json != NULL) && (enhanced_crc_json != NULL) &&
+            (frameid_json != NULL)) {
+            size_t datalength = (int)cJSON_GetNumberValue(datalength_json);
+            bool m2s = cJSON_IsTrue(m2s_json);
+            int baudrate = (int)cJSON_GetNumberValue(baudrate_json);
+            bool enhanced_crc = cJSON_IsTrue(enhanced_crc_json);
+            uint8_t frameid = (int)cJSON_GetNumberValue(frameid_json);
+
+            if (m2s) {
+                cJSON *payload_json = cJSON_GetObjectItem(params, "payload");
+                if (payload_json != NULL) {
+                    uint8_t *payload = calloc(datalength, sizeof(uint8_t));
+                    if (payload != NULL) {
+                        for (int i = 0; i < cJSON_GetArraySize(payload_json); i++) {
+                            payload[i] = cJSON_GetArrayItem(payload_json, i)->valueint;
+                        }
+
+                        lin_err_t error = lintiming_send_m2s(baudrate,
+                                                             enhanced_crc,
+                                                             frameid,
+                                                             payload,
+                                                             datalength);
+
+                        if (error == LIN_OK) {
+                            retval = WSS_ERR_NONE;
+                        } else {
+                            cJSON_AddStringToObject(result, "message", lin_err_to_string(error));
+                            retval = WSS_ERR_ALREADY_SET;
+                        }
+                    } else {
+                        cJSON_AddStringToObject(result, "message", mlxerr_ErrorCodeToName(MLX_FAIL_INTERNAL));
+                        retval = WSS_ERR_ALREADY_SET;
+                    }
+                    free(payload);
+                } else {
+                    cJSON_AddStringToObject(result, "message", "Corrupted request");
+                    retval = WSS_ERR_ALREADY_SET;
+                }
+            } else {
+                uint8_t *data = calloc(datalength, sizeof(uint8_t));
+                if (data != NULL) {
+                    lin_err_t error = lincache_send_s2m(baudrate, enhanced_crc, frameid, data, datalength);
+
+                    if (error == LIN_OK) {
+                        /* Copy data into json */
+                        cJSON *result_json = cJSON_AddArrayToObject(result, "data");
+                        for (int i = 0; i < datalength; i++) {
+                            cJSON *number_json = cJSON_CreateNumber(data[i]);
+                            cJSON_AddItemToArray(result_json, number_json);
+                        }
+                        retval = WSS_ERR_NONE;
+                    } else {
+                        cJSON_AddStringToObject(result, "message", lin_err_to_string(error));
+                        retval = WSS_ERR_ALREADY_SET;
+                    }
+                } else {
+                    cJSON_AddStringToObject(result, "message", mlxerr_ErrorCodeToName(MLX_FAIL_INTERNAL));
+                    retval = WSS_ERR_ALREADY_SET;
+                }
+                free(data);
+            }
+        } else {
+            cJSON_AddStringToObject(result, "message", "Corrupted request");
+            retval = WSS_ERR_ALREADY_SET;
+        }
+    } else {
+        cJSON_AddStringToObject(result, "message", mlxerr_ErrorCodeToName(MLX_FAIL_INTERFACE_NOT_FREE));
+        retval = WSS_ERR_ALREADY_SET;
+    }
+
+    return retval;
+}
+
+/** Send a queued message to a websocket client, to be run in the httpd task
+ *
+ * @param[in]  arg  message to send (struct async_resp_arg), freed afterwards.
+ */
+static void wss_async_send(void *arg) {
+    struct async_resp_arg *resp_arg = (struct async_resp_arg *)arg;
+    bool same_session = true;
+
+    if (resp_arg->session != 0u) {
+        /* a response is only for the connection which sent the request, not a later one on the same socket */
+        wss_client_info_t *client_info = wss_get_client_connection_info(resp_arg->fd);
+        same_session = (client_info != NULL) && (client_info->session == resp_arg->session);
+    }
+
+    if (same_session && (httpd_ws_get_fd_info(resp_arg->hd, resp_arg->fd) == HTTPD_WS_CLIENT_WEBSOCKET)) {
+        httpd_ws_frame_t ws_pkt;
+        memset(&ws_pkt, 0, sizeof(httpd_ws_frame_t));
+        ws_pkt.payload = (uint8_t*)resp_arg->message;
+        ws_pkt.len = resp_arg->length;
+        ws_pkt.type = resp_arg->type;
+        ws_pkt.final = true;
+        esp_err_t ret = httpd_ws_send_frame_async(resp_arg->hd, resp_arg->fd, &ws_pkt);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "httpd_ws_send_frame_async failed with %d", ret);
+        }
+    }
+
+    if (resp_arg->type == HTTPD_WS_TYPE_BINARY) {
+        (void)__atomic_fetch_sub(&wss_monitor_inflight, 1u, __ATOMIC_RELAXED);
+    }
+
+    free(resp_arg->message);
+    free(resp_arg);
+}
+
+/** Queue a text message for a websocket client
+ *
+ * @param[in]  sockfd  socket of the client.
+ * @param[in]  session  session of the client the message is meant for, 0 for any.
+ * @param[in]  message  message to send (copied).
+ * @retval  true  message is queued.
+ * @retval  false  message could not be queued.
+ */
+static bool wss_queue_text(int sockfd, uint32_t session, const char *message) {
+    bool retval = false;
+    struct async_resp_arg *resp_arg = (wss_server != NULL) ? malloc(sizeof(struct async_resp_arg)) : NULL;
+
+    if (resp_arg != NULL) {
+        resp_arg->hd = wss_server;
+        resp_arg->fd = sockfd;
+        resp_arg->session = session;
+        resp_arg->message = strdup(message);
+        resp_arg->length = strlen(message);
+        resp_arg->type = HTTPD_WS_TYPE_TEXT;
+        if ((resp_arg->message != NULL) && (httpd_queue_work(wss_server, wss_async_send, resp_arg) == ESP_OK)) {
+            retval = true;
+        } else {
+            free(resp_arg->message);
+            free(resp_arg);
+        }
+    }
+
+    return retval;
+}
+
+/** Create an unsolicited event message
+ *
+ * @param[in]  endpoint  endpoint which raises the event.
+ * @param[in]  event  name of the event.
+ * @param[in]  data  event data (ownership is taken).
+ * @returns  event message to be freed with cJSON_free, or NULL when out of memory.
+ */
+static char *wss_event_message(const char *endpoint, const char *event, cJSON *data) {
+    cJSON *root = cJSON_CreateObject();
+    cJSON *payload = cJSON_CreateObject();
+    cJSON_AddStringToObject(root, "type", "event");
+    cJSON_AddItemToObject(root, "payload", payload);
+    cJSON_AddStringToObject(payload, "endpoint", endpoint);
+    cJSON_AddStringToObject(payload, "event", event);
+    cJSON_AddItemToObject(payload, "data", data);
+
+    char *message = cJSON_PrintUnformatted(root);
+    cJSON_Delete(root);
+
+    return message;
+}
+
+/** Send an unsolicited event message to all connected websocket clients
+ *
+ * Can be called from any task, the message is sent from the httpd task.
+ *
+ * @param[in]  endpoint  endpoint which raises the event.
+ * @param[in]  event  name of the event.
+ * @param[in]  data  event data (ownership is taken).
+ */
+static void wss_send_event(const char *endpoint, const char *event, cJSON *data) {
+    char *message = wss_event_message(endpoint, event, data);
+
+    if ((message != NULL) && (wss_server != NULL)) {
+        for (int client = 0; client < MAX_WWW_CLIENTS; client++) {
+            int sockfd = open_clients[client].sockfd;
+            if ((sockfd != 0) && !wss_queue_text(sockfd, 0u, message)) {
+                break;
+            }
+        }
+    }
+
+    cJSON_free(message);
+}
+
+/** Progress listener, sends the progress as "progress" events of the bootloader or ota endpoint
+ *
+ * @param[in]  report  progress of the operation.
+ * @param[in]  ctx  listener context (not used).
+ */
+static void wss_progress_listener(const progress_report_t *report, void *ctx) {
+    (void)ctx;
+    cJSON *data = cJSON_CreateObject();
+    cJSON_AddStringToObject(data, "phase", progress_phase_to_string((progress_phase_t)report->phase));
+    cJSON_AddNumberToObject(data, "bytes_done", report->bytes_done);
+    cJSON_AddNumberToObject(data, "bytes_total", report->bytes_total);
+    cJSON_AddNumberToObject(data, "pages_done", report->pages_done);
+    cJSON_AddNumberToObject(data, "pages_total", report->pages_total);
+    cJSON_AddNumberToObject(data, "elapsed_ms", report->elapsed_ms);
+    if (report->eta_ms != PROGRESS_ETA_UNKNOWN) {
+        cJSON_AddNumberToObject(data, "eta_ms", report->eta_ms);
+    } else {
+        cJSON_AddNullToObject(data, "eta_ms");
+    }
+    cJSON_AddBoolToObject(data, "estimated", report->estimated != 0u);
+    const char *endpoint = (report->operation == (uint8_t)PROGRESS_OP_OTA) ? "ota" : "bootloader";
+
+    wss_send_event(endpoint, "progress", data);
+}
+
+/** Add the information of a job to a json object
+ *
+ * @param[in]  info  job information.
+ * @param[out]  object  json object to add the information to.
+ */
+static void wss_job_to_json(const job_info_t *info, cJSON *object) {
+    cJSON_AddNumberToObject(object, "job", info->id);
+    cJSON_AddStringToObject(object, "kind", job_kind_to_string((job_kind_t)info->kind));
+    cJSON_AddStringToObject(object, "state", job_state_to_string((job_state_t)info->state));
+    cJSON_AddBoolToObject(object, "cancel_requested", info->cancel_requested != 0u);
+    cJSON_AddNumberToObject(object, "error", info->error);
+    cJSON_AddNumberToObject(object, "created_ms", info->created_ms);
+    cJSON_AddNumberToObject(object, "started_ms", info->started_ms);
+    cJSON_AddNumberToObject(object, "finished_ms", info->finished_ms);
+}
+
+/** Job listener, sends the state changes of all jobs as "state" events of the jobs endpoint
+ *
+ * @param[in]  info  job information.
+ * @param[in]  ctx  listener context (not used).
+ */
+static void wss_jobs_listener(const job_info_t *info, void *ctx) {
+    (void)ctx;
+    cJSON *data = cJSON_CreateObject();
+    wss_job_to_json(info, data);
+    wss_send_event("jobs", "state", data);
+}
+
+/** Schedule result listener, streams the results as "schedule_results" events
+ *
+ * @param[in]  results  results of the executed slots.
+ * @param[in]  nr_of_results  number of results.
+ * @param[in]  ctx  listener context (not used).
+ */
+static void wss_lin_schedule_listener(const linsched_result_t *results, size_t nr_of_results, void *ctx) {
+    (void)ctx;
+    static const char * const type_names[] = {"m2s", "s2m", "wakeup", "event_triggered", "sporadic"};
+    static const char * const outcome_names[] = {"none", "response", "collision", "error"};
+
+    cJSON *data = cJSON_CreateObject();
+    cJSON *results_json = cJSON_AddArrayToObject(data, "results");
+    for (size_t i = 0; i < nr_of_results; i++) {
+        const linsched_result_t *result = &results[i];
+        cJSON *result_json = cJSON_CreateObject();
+        cJSON_AddNumberToObject(result_json, "timestamp", result->timestamp_us);
+        cJSON_AddNumberToObject(result_json, "sequence", result->sequence);
+        cJSON_AddNumberToObject(result_json, "late", result->late_us);
+        cJSON_AddNumberToObject(result_json, "table", result->table);
+        cJSON_AddNumberToObject(result_json, "entry", result->entry);
+        cJSON_AddStringToObject(result_json, "type", type_names[result->type % 5u]);
+        if (result->type == LINSCHED_EVENT_TRIGGERED) {
+            cJSON_AddStringToObject(result_json, "event", outcome_names[result->event % 4u]);
+        }
+        if (result->frameid != LINSCHED_NO_FRAME) {
+            cJSON_AddNumberToObject(result_json, "frameid", result->frameid);
+        }
+        if (result->status == LIN_OK) {
+            cJSON *data_json = cJSON_AddArrayToObject(result_json, "data");
+            for (int byte = 0; byte < result->datalength; byte++) {
+                cJSON_AddItemToArray(data_json, cJSON_CreateNumber(result->data[byte]));
+            }
+        } else {
+            cJSON_AddStringToObject(result_json, "message", lin_err_to_string((lin_err_t)result->status));
+        }
+        cJSON_AddItemToArray(results_json, result_json);
+    }
+
+    wss_send_event("lin", "schedule_results", data);
+}
+
+/** Monitor record listener, streams the records as binary messages to the subscribed clients
+ *
+ * A binary message holds the message identifier (uint16 WSS_BINARY_MONITOR_RECORDS), the number of
+ * records (uint16), followed by the records (linmon_record_t), all little endian.
+ *
+ * @param[in]  records  captured records.
+ * @param[in]  nr_of_records  number of records.
+ * @param[in]  ctx  listener context (not used).
+ * @retval  true  records are queued for at least one client.
+ * @retval  false  no client is subscribed or too many messages are waiting to be sent.
+ */
+static bool wss_lin_monitor_listener(const linmon_record_t *records, size_t nr_of_records, void *ctx) {
+    (void)ctx;
+    bool retval = false;
+    size_t length = (2u * sizeof(uint16_t)) + (nr_of_records * sizeof(linmon_record_t));
+
+    if ((wss_server == NULL) ||
+        (__atomic_load_n(&wss_monitor_inflight, __ATOMIC_RELAXED) >= WSS_MONITOR_MAX_INFLIGHT)) {
+        /* keep the records in the monitor until the messages are sent */
+        return false;
+    }
+
+    for (int client = 0; client < MAX_WWW_CLIENTS; client++) {
+        int sockfd = open_clients[client].sockfd;
+        if ((sockfd == 0) || !open_clients[client].monitor_subscribed) {
+            continue;
+        }
+        struct async_resp_arg *resp_arg = malloc(sizeof(struct async_resp_arg));
+        if (resp_arg == NULL) {
+            break;
+        }
+        resp_arg->hd = wss_server;
+        resp_arg->fd = sockfd;
+        resp_arg->session = 0u;
+        resp_arg->message = malloc(length);
+        resp_arg->length = length;
+        resp_arg->type = HTTPD_WS_TYPE_BINARY;
+        if (resp_arg->message != NULL) {
+            uint8_t *message = (uint8_t*)resp_arg->message;
+            message[0] = (uint8_t)(WSS_BINARY_MONITOR_RECORDS & 0xFFu);
+            message[1] = (uint8_t)(WSS_BINARY_MONITOR_RECORDS >> 8);
+            message[2] = (uint8_t)(nr_of_records & 0xFFu);
+            message[3] = (uint8_t)(nr_of_records >> 8);
+            memcpy(&message[4], records, nr_of_records * sizeof(linmon_record_t));
+            (void)__atomic_fetch_add(&wss_monitor_inflight, 1u, __ATOMIC_RELAXED);
+            if (httpd_queue_work(wss_server, wss_async_send, resp_arg) == ESP_OK) {
+                retval = true;
+                continue;
+            }
+            (void)__atomic_fetch_sub(&wss_monitor_inflight, 1u, __ATOMIC_RELAXED);
+        }
+        free(resp_arg->message);
+        free(resp_arg);
+    }
+
+    return retval;
+}
+
+/** Add a signal value to a json object, named after the signal
+ *
+ * @param[in]  name  name of the signal.
+ * @param[in]  value  value of the signal.
+ * @param[out]  object  json object to add the value to.
+ */
+static void wss_lin_signal_to_json(const char *name, const linsig_value_t *value, cJSON *object) {
+    if (value->encoding == LINSIG_ENCODING_PHYSICAL) {
+        cJSON_AddNumberToObject(object, name, value->value);
+    } else {
+        cJSON_AddNumberToObject(object, name, value->raw);
+    }
+}
+
+/** Signal change listener, sends the changed signals as "signals" event to the subscribed clients
+ *
+ * Each client only receives the signals it subscribed to, clients without changed signals do not
+ * receive an event.
+ *
+ * @param[in]  values  values of the changed signals.
+ * @param[in]  nr_of_values  number of values.
+ * @param[in]  generation  generation of the database the indexes belong to.
+ * @param[in]  ctx  listener context (not used).
+ */
+static void wss_lin_signal_listener(const linsig_value_t *values, size_t nr_of_values, uint32_t generation, void *ctx) {
+    (void)ctx;
+
+    if (wss_server == NULL) {
+        return;
+    }
+
+    for (int client = 0; client < MAX_WWW_CLIENTS; client++) {
+        wss_client_info_t *client_info = &open_clients[client];
+        if ((client_info->sockfd == 0) || (client_info->signal_generation != generation)) {
+            continue;
+        }
+
+        cJSON *data = cJSON_CreateObject();
+        cJSON *values_json = cJSON_AddObjectToObject(data, "values");
+        bool changed = false;
+        for (size_t i = 0u; i < nr_of_values; i++) {
+            uint16_t index = values[i].index;
+            char name[LINSIG_NAME_LEN];
+            if (((client_info->signal_subscriptions[index >> 5] & (1u << (index & 31u))) != 0u) &&
+                linsig_get_name(index, name)) {
+                wss_lin_signal_to_json(name, &values[i], values_json);
+                changed = true;
+            }
+        }
+
+        if (changed) {
+            char *message = wss_event_message("lin", "signals", data);
+            if (message != NULL) {
+                (void)wss_queue_text(client_info->sockfd, 0u, message);
+            }
+            cJSON_free(message);
+        } else {
+            cJSON_Delete(data);
+        }
+    }
+}
+
+static wss_error_code_t wss_lin_schedule_esp_err(esp_err_t error, cJSON * result) {
+    wss_error_code_t retval = WSS_ERR_NONE;
+    if (error != ESP_OK) {
+        cJSON_AddStringToObject(result, "message", esp_err_to_name(error));
+        retval = WSS_ERR_ALREADY_SET;
+    }
+    return retval;
+}
+
+static wss_error_code_t wss_lin_schedule_upload(const cJSON * const params, cJSON * result) {
+    wss_error_code_t retval = WSS_ERR_ALREADY_SET;
+
+    cJSON *table_json = cJSON_GetObjectItem(params, "table");
+    cJSON *baudrate_json = cJSON_GetObjectItem(params, "baudrate");
+    cJSON *entries_json = cJSON_GetObjectItem(params, "entries");
+
+    if ((table_json != NULL) && (baudrate_json != NULL) && cJSON_IsArray(entries_json)) {
+        int nr_of_entries = cJSON_GetArraySize(entries_json);
+        linsched_entry_t *entries = NULL;
+        if ((nr_of_entries > 0) && (nr_of_entries <= CONFIG_LIN_SCHEDULE_MAX_ENTRIES)) {
+            entries = calloc(nr_of_entries, sizeof(linsched_entry_t));
+        }
+        if (entries != NULL) {
+            for (int i = 0; i < nr_of_entries; i++) {
+                const cJSON *entry_json = cJSON_GetArrayItem(entries_json, i);
+                linsched_entry_t *entry = &entries[i];
+                cJSON *type_json = cJSON_GetObjectItem(entry_json, "type");
+                cJSON *payload_json = cJSON_GetObjectItem(entry_json, "payload");
+
+                /* invalid fields are caught by the table validation */
+                entry->type = 0xFFu;
+                if (cJSON_IsString(type_json)) {
+                    if (strcasecmp(type_json->valuestring, "m2s") == 0) {
+                        entry->type = LINSCHED_M2S;
+                    } else if (strcasecmp(type_json->valuestring, "s2m") == 0) {
+                        entry->type = LINSCHED_S2M;
+                    } else if (strcasecmp(type_json->valuestring, "wakeup") == 0) {
+                        entry->type = LINSCHED_WAKEUP;
+                    } else if (strcasecmp(type_json->valuestring, "event_triggered") == 0) {
+                        entry->type = LINSCHED_EVENT_TRIGGERED;
+                    } else if (strcasecmp(type_json->valuestring, "sporadic") == 0) {
+                        entry->type = LINSCHED_SPORADIC;
+                    }
+                }
+                entry->frameid = (uint8_t)cJSON_GetNumberValue(cJSON_GetObjectItem(entry_json, "frameid"));
+                entry->enhanced_crc = cJSON_IsTrue(cJSON_GetObjectItem(entry_json, "enhanced_crc")) ? 1u : 0u;
+                entry->slot_us = (uint32_t)cJSON_GetNumberValue(cJSON_GetObjectItem(entry_json, "slot_time"));
+                if (entry->type == LINSCHED_WAKEUP) {
+                    int pulse_time = 200;
+                    cJSON *pulse_time_json = cJSON_GetObjectItem(entry_json, "pulse_time");
+                    if (pulse_time_json != NULL) {
+                        pulse_time = (int)cJSON_GetNumberValue(pulse_time_json);
+                    }
+                    entry->payload[0] = (uint8_t)(pulse_time & 0xFF);
+                    entry->payload[1] = (uint8_t)((pulse_time >> 8) & 0xFF);
+                } else if (entry->type == LINSCHED_M2S) {
+                    int datalength = cJSON_GetArraySize(payload_json);
+                    entry->datalength = (datalength > 0xFF) ? 0xFFu : (uint8_t)datalength;
+                    for (int byte = 0; (byte < datalength) && (byte < LINSCHED_MAX_DATA_LEN); byte++) {
+                        entry->payload[byte] = (uint8_t)cJSON_GetArrayItem(payload_json, byte)->valueint;
+                    }
+                } else if (entry->type == LINSCHED_SPORADIC) {
+                    wss_lin_associated_frames(cJSON_GetObjectItem(entry_json, "frames"), entry);
+                } else if (entry->type == LINSCHED_EVENT_TRIGGERED) {
+                    wss_lin_associated_frames(cJSON_GetObjectItem(entry_json, "frames"), entry);
+                    entry->datalength = (uint8_t)cJSON_GetNumberValue(cJSON_GetObjectItem(entry_json, "datalength"));
+                } else {
+                    entry->datalength = (uint8_t)cJSON_GetNumberValue(cJSON_GetObjectItem(entry_json, "datalength"));
+                }
+            }
+
+            retval = wss_lin_schedule_esp_err(linsched_upload((uint8_t)cJSON_GetNumberValue(table_json),
+                                                              (uint16_t)cJSON_GetNumberValue(baudrate_json),
+                                                              entries,
+                                                              (uint8_t)nr_of_entries),
+                                              result);
+            free(entries);
+        } else {
+            cJSON_AddStringToObject(result, "message", mlxerr_ErrorCodeToName(MLX_FAIL_INV_DATA_LEN));
+        }
+    } else {
+        cJSON_AddStringToObject(result, "message", "Corrupted request");
+    }
+
+    return retval;
+}
+
+static wss_error_code_t wss_lin_schedule_start(const cJSON * const params, cJSON * result) {
+    wss_error_code_t retval = WSS_ERR_ALREADY_SET;
+
+    if (busmngr_ClaimInterface(USER_WIFI, MODE_APPLICATION) == ESP_OK) {
+        cJSON *table_json = cJSON_GetObjectItem(params, "table");
+        if (table_json != NULL) {
+            if (!wss_schedule_listener_registered) {
+                wss_schedule_listener_registered = (linsched_add_listener(wss_lin_schedule_listener, NULL) == ESP_OK);
+            }
+            retval = wss_lin_schedule_esp_err(linsched_start((uint8_t)cJSON_GetNumberValue(table_json)), result);
+        } else {
+            cJSON_AddStringToObject(result, "message", "Corrupted request");
+        }
+    } else {
+        cJSON_AddStringToObject(result, "message", mlxerr_ErrorCodeToName(MLX_FAIL_INTERFACE_NOT_FREE));
+    }
+
+    return retval;
+}
+
+static wss_error_code_t wss_lin_schedule_switch(const cJSON * const params, cJSON * result) {
+    wss_error_code_t retval = WSS_ERR_ALREADY_SET;
+
+    if (busmngr_CheckClaim(USER_WIFI, MODE_APPLICATION)) {
+        cJSON *table_json = cJSON_GetObjectItem(params, "table");
+        if (table_json != NULL) {
+            retval = wss_lin_schedule_esp_err(linsched_switch((uint8_t)cJSON_GetNumberValue(table_json)), result);
+        } else {
+            cJSON_AddStringToObject(result, "message", "Corrupted request");
+        }
+    } else {
+        cJSON_AddStringToObject(result, "message", mlxerr_ErrorCodeToName(MLX_FAIL_INTERFACE_NOT_FREE));
+    }
+
+    return retval;
+}
+
+static wss_error_code_t wss_lin_schedule_stop(const cJSON * const params, cJSON * result) {
+    wss_error_code_t retval = WSS_ERR_ALREADY_SET;
+    (void)params;
+
+    if (busmngr_CheckClaim(USER_WIFI, MODE_APPLICATION)) {
+        retval = wss_lin_schedule_esp_err(linsched_stop(), result);
+    } else {
+        cJSON_AddStringToObject(result, "message", mlxerr_ErrorCodeToName(MLX_FAIL_INTERFACE_NOT_FREE));
+    }
+
+    return retval;
+}
+
+static wss_error_code_t wss_lin_schedule_status(const cJSON * const params, cJSON * result) {
+    (void)params;
+    linsched_status_t status;
+    linsched_get_status(&status);
+
+    cJSON_AddBoolToObject(result, "running", status.running != 0u);
+    cJSON_AddNumberToObject(result, "table", status.table);
+    if (status.pending != LINSCHED_NO_TABLE) {
+        cJSON_AddNumberToObject(result, "pending", status.pending);
+    }
+    cJSON_AddNumberToObject(result, "slots", status.slots);
+    cJSON_AddNumberToObject(result, "errors", status.errors);
+    cJSON_AddNumberToObject(result, "overruns", status.overruns);
+    cJSON_AddNumberToObject(result, "max_late", status.max_late_us);
+    cJSON_AddNumberToObject(result, "results_dropped", status.results_dropped);
+
+    return WSS_ERR_NONE;
+}
+
+/** Subscribe the client whose message is being handled to the monitor records
+ *
+ * @param[in]  subscribe  true to subscribe, false to unsubscribe.
+ */
+static void wss_lin_monitor_subscribe(bool subscribe) {
+    if (!wss_monitor_listener_registered) {
+        wss_monitor_listener_registered = (linmon_add_listener(wss_lin_monitor_listener, NULL) == ESP_OK);
+    }
+    wss_client_info_t *client_info = wss_get_client_connection_info(wss_current_sockfd);
+    if (client_info != NULL) {
+        client_info->monitor_subscribed = subscribe;
+    }
+}
+
+static wss_error_code_t wss_lin_monitor_start(const cJSON * const params, cJSON * result) {
+    wss_error_code_t retval = WSS_ERR_ALREADY_SET;
+    cJSON *baudrate_json = cJSON_GetObjectItem(params, "baudrate");
+
+    if (baudrate_json != NULL) {
+        (void)busmngr_ReleaseInterface(USER_WIFI, MODE_APPLICATION);
+        if (busmngr_ClaimInterface(USER_WIFI, MODE_MONITOR) == ESP_OK) {
+            wss_lin_monitor_subscribe(true);
+            retval = wss_lin_schedule_esp_err(linmon_start((uint16_t)cJSON_GetNumberValue(baudrate_json)), result);
+            if (retval != WSS_ERR_NONE) {
+                (void)busmngr_ReleaseInterface(USER_WIFI, MODE_MONITOR);
+            }
+        } else {
+            cJSON_AddStringToObject(result, "message", mlxerr_ErrorCodeToName(MLX_FAIL_INTERFACE_NOT_FREE));
+        }
+    } else {
+        cJSON_AddStringToObject(result, "message", "Corrupted request");
+    }
+
+    return retval;
+}
+
+static wss_error_code_t wss_lin_monitor_stop(const cJSON * const params, cJSON * result) {
+    (void)params;
+    wss_error_code_t retval = WSS_ERR_NONE;
+
+    if (busmngr_CheckClaim(USER_WIFI, MODE_MONITOR)) {
+        retval = wss_lin_schedule_esp_err(linmon_stop(), result);
+        (void)busmngr_ReleaseInterface(USER_WIFI, MODE_MONITOR);
+    }
+
+    return retval;
+}
+
+static wss_error_code_t wss_lin_monitor_status(const cJSON * const params, cJSON * result) {
+    (void)params;
+    linmon_status_t status;
+    linmon_get_status(&status);
+
+    cJSON_AddBoolToObject(result, "running", status.running != 0u);
+    cJSON_AddNumberToObject(result, "baudrate", status.baudrate);
+    cJSON_AddNumberToObject(result, "records", status.records);
+    cJSON_AddNumberToObject(result, "records_lost", status.records_lost);
+    cJSON_AddNumberToObject(result, "rx_overflows", status.rx_overflows);
+    cJSON_AddNumberToObject(result, "ring_used", status.ring_used);
+    cJSON_AddNumberToObject(result, "ring_size", status.ring_size);
+
+    return WSS_ERR_NONE;
+}
+
+/** Add a cached entry to a json object
+ *
+ * @param[in]  entry  cached entry.
+ * @param[out]  object  json object to add the fields to.
+ */
+static void wss_lin_cache_entry_to_json(const lincache_entry_t *entry, cJSON *object) {
+    cJSON_AddNumberToObject(object, "frameid", entry->frameid);
+    cJSON_AddNumberToObject(object, "age", entry->age_ms);
+    cJSON_AddNumberToObject(object, "count", entry->count);
+    cJSON_AddNumberToObject(object, "errors", entry->errors);
+    cJSON_AddStringToObject(object, "status", lin_err_to_string((lin_err_t)entry->status));
+    cJSON *data_json = cJSON_AddArrayToObject(object, "data");
+    for (uint8_t i = 0u; i < entry->datalength; i++) {
+        cJSON_AddItemToArray(data_json, cJSON_CreateNumber(entry->data[i]));
+    }
+}
+
+static wss_error_code_t wss_lin_cache_read(const cJSON * const params, cJSON * result) {
+    cJSON *frameid_json = cJSON_GetObjectItem(params, "frameid");
+    cJSON *max_age_json = cJSON_GetObjectItem(params, "max_age");
+    uint32_t max_age_ms = UINT32_MAX;
+    lincache_entry_t entry;
+
+    if (max_age_json != NULL) {
+        max_age_ms = (uint32_t)cJSON_GetNumberValue(max_age_json);
+    }
+
+    if (frameid_json != NULL) {
+        bool cached = lincache_get((uint8_t)cJSON_GetNumberValue(frameid_json), &entry) && (entry.age_ms <= max_age_ms);
+        cJSON_AddBoolToObject(result, "cached", cached);
+        if (cached) {
+            wss_lin_cache_entry_to_json(&entry, result);
+        }
+    } else {
+        cJSON *entries_json = cJSON_AddArrayToObject(result, "entries");
+        for (uint8_t frameid = 0u; frameid < LINCACHE_NR_OF_FRAMES; frameid++) {
+            if (lincache_get(frameid, &entry) && (entry.age_ms <= max_age_ms)) {
+                cJSON *entry_json = cJSON_CreateObject();
+                wss_lin_cache_entry_to_json(&entry, entry_json);
+                cJSON_AddItemToArray(entries_json, entry_json);
+            }
+        }
+    }
+
+    return WSS_ERR_NONE;
+}
+
+/** Add the timing statistics of a frame to a json object
+ *
+ * @param[in]  entry  timing statistics.
+ * @param[out]  object  json object to add the fields to.
+ */
+static void wss_lin_timing_entry_to_json(const lintiming_entry_t *entry, cJSON *object) {
+    cJSON_AddNumberToObject(object, "frameid", entry->frameid);
+    cJSON_AddNumberToObject(object, "baudrate", entry->baudrate);
+    cJSON_AddNumberToObject(object, "datalength", entry->datalength);
+    cJSON_AddNumberToObject(object, "count", entry->count);
+    cJSON_AddNumberToObject(object, "errors", entry->errors);
+    cJSON_AddNumberToObject(object, "min", entry->min_us);
+    cJSON_AddNumberToObject(object, "avg", entry->avg_us);
+    cJSON_AddNumberToObject(object, "max", entry->max_us);
+    cJSON_AddNumberToObject(object, "nominal", entry->nominal_us);
+    cJSON_AddNumberToObject(object, "over_max", entry->over_max);
+    cJSON *histogram_json = cJSON_AddArrayToObject(object, "histogram");
+    for (uint8_t i = 0u; i < LINTIMING_HISTOGRAM_BINS; i++) {
+        cJSON_AddItemToArray(histogram_json, cJSON_CreateNumber(entry->histogram[i]));
+    }
+
+    lintiming_phase_entry_t phase_entry;
+    if (lintiming_get_phases(entry->frameid, &phase_entry)) {
+        cJSON *phases_json = cJSON_AddObjectToObject(object, "phases");
+        cJSON_AddNumberToObject(phases_json, "count", phase_entry.count);
+        cJSON_AddNumberToObject(phases_json, "missed", phase_entry.missed);
+        for (uint8_t phase = 0u; phase < LINTIMING_NR_OF_PHASES; phase++) {
+            cJSON *phase_json = cJSON_AddObjectToObject(phases_json, lintiming_phase_name((lintiming_phase_t)phase));
+            cJSON_AddNumberToObject(phase_json, "min", phase_entry.phases[phase].min_us);
+            cJSON_AddNumberToObject(phase_json, "avg", phase_entry.phases[phase].avg_us);
+            cJSON_AddNumberToObject(phase_json, "max", phase_entry.phases[phase].max_us);
+        }
+        cJSON *last_json = cJSON_AddObjectToObject(phases_json, "last");
+        cJSON_AddNumberToObject(last_json, "break", phase_entry.last.break_us);
+        cJSON_AddNumberToObject(last_json, "sync", phase_entry.last.sync_us);
+        cJSON_AddNumberToObject(last_json, "pid", phase_entry.last.pid_us);
+        cJSON_AddNumberToObject(last_json, "response", phase_entry.last.response_us);
+        cJSON_AddNumberToObject(last_json, "checksum", phase_entry.last.checksum_us);
+        cJSON_AddNumberToObject(last_json, "end", phase_entry.last.end_us);
+    }
+}
+
+static wss_error_code_t wss_lin_timing_read(const cJSON * const params, cJSON * result) {
+    cJSON *frameid_json = cJSON_GetObjectItem(params, "frameid");
+    lintiming_entry_t entry;
+
+    if (frameid_json != NULL) {
+        bool measured = lintiming_get((uint8_t)cJSON_GetNumberValue(frameid_json), &entry);
+        cJSON_AddBoolToObject(result, "measured", measured);
+        if (measured) {
+            wss_lin_timing_entry_to_json(&entry, result);
+        }
+    } else {
+        cJSON *entries_json = cJSON_AddArrayToObject(result, "entries");
+        for (uint8_t frameid = 0u; frameid < LINTIMING_NR_OF_FRAMES; frameid++) {
+            if (lintiming_get(frameid, &entry)) {
+                cJSON *entry_json = cJSON_CreateObject();
+                wss_lin_timing_entry_to_json(&entry, entry_json);
+                cJSON_AddItemToArray(entries_json, entry_json);
+            }
+        }
+    }
+
+    return WSS_ERR_NONE;
+}
+
+/** Answer a slave response request with a maximum age from the cache
+ *
+ * @param[in]  params  parameters of the handle_message_on_bus request.
+ * @param[out]  result  result of the request, only modified when answered from the cache.
+ * @retval  true  request is answered from the cache.
+ * @retval  false  request needs the bus.
+ */
+static bool wss_lin_cached_message(const cJSON * const params, cJSON * result) {
+    bool retval = false;
+    cJSON *m2s_json = cJSON_GetObjectItem(params, "m2s");
+    cJSON *max_age_json = cJSON_GetObjectItem(params, "max_age");
+    cJSON *frameid_json = cJSON_GetObjectItem(params, "frameid");
+    cJSON *datalength_json = cJSON_GetObjectItem(params, "datalength");
+    lincache_entry_t entry;
+
+    if ((m2s_json != NULL) && !cJSON_IsTrue(m2s_json) &&
+        (max_age_json != NULL) && (frameid_json != NULL) && (datalength_json != NULL) &&
+        lincache_get_fresh((uint8_t)cJSON_GetNumberValue(frameid_json),
+                           (uint8_t)cJSON_GetNumberValue(datalength_json),
+                           (uint32_t)cJSON_GetNumberValue(max_age_json),
+                           &entry)) {
+        cJSON *data_json = cJSON_AddArrayToObject(result, "data");
+        for (uint8_t i = 0u; i < entry.datalength; i++) {
+            cJSON_AddItemToArray(data_json, cJSON_CreateNumber(entry.data[i]));
+        }
+        cJSON_AddBoolToObject(result, "cached", true);
+        cJSON_AddNumberToObject(result, "age", entry.age_ms);
+        retval = true;
+    }
+
+    return retval;
+}
+
+static wss_error_code_t wss_lin_signal_upload(const cJSON * const params, cJSON * result) {
+    wss_error_code_t retval = WSS_ERR_ALREADY_SET;
+    cJSON *frames_json = cJSON_GetObjectItem(params, "frames");
+    int nr_of_frames = cJSON_GetArraySize(frames_json);
+    int nr_of_signals = 0;
+
+    cJSON *frame_json = NULL;
+    cJSON_ArrayForEach(frame_json, frames_json) {
+        nr_of_signals += cJSON_GetArraySize(cJSON_GetObjectItem(frame_json, "signals"));
+    }
+
+    if (!cJSON_IsArray(frames_json) ||
+        (nr_of_frames > (int)LINSIG_MAX_FRAMES) || (nr_of_signals > (int)LINSIG_MAX_SIGNALS)) {
+        cJSON_AddStringToObject(result, "message", "Corrupted request");
+        return retval;
+    }
+
+    /* convert to the upload format, the database validates the content */
+    size_t length = sizeof(linsig_blob_header_t) +
+                    (nr_of_frames * sizeof(linsig_blob_frame_t)) +
+                    (nr_of_signals * sizeof(linsig_blob_signal_t));
+    uint8_t *blob = calloc(1u, length);
+    if (blob == NULL) {
+        cJSON_AddStringToObject(result, "message", mlxerr_ErrorCodeToName(MLX_FAIL_INTERNAL));
+        return retval;
+    }
+
+    linsig_blob_header_t *header = (linsig_blob_header_t*)blob;
+    linsig_blob_frame_t *frames = (linsig_blob_frame_t*)&blob[sizeof(linsig_blob_header_t)];
+    linsig_blob_signal_t *signals = (linsig_blob_signal_t*)&frames[nr_of_frames];
+    header->version = LINSIG_FORMAT_VERSION;
+    header->nr_of_frames = (uint8_t)nr_of_frames;
+    header->nr_of_signals = (uint16_t)nr_of_signals;
+
+    linsig_blob_signal_t *signal = signals;
+    linsig_blob_frame_t *frame = frames;
+    cJSON_ArrayForEach(frame_json, frames_json) {
+        cJSON *signals_json = cJSON_GetObjectItem(frame_json, "signals");
+        frame->frameid = (uint8_t)cJSON_GetNumberValue(cJSON_GetObjectItem(frame_json, "frameid"));
+        frame->datalength = (uint8_t)cJSON_GetNumberValue(cJSON_GetObjectItem(frame_json, "datalength"));
+        frame->nr_of_signals = (uint8_t)cJSON_GetArraySize(signals_json);
+
+        cJSON *signal_json = NULL;
+        cJSON_ArrayForEach(signal_json, signals_json) {
+            const char *name = cJSON_GetStringValue(cJSON_GetObjectItem(signal_json, "name"));
+            const char *encoding = cJSON_GetStringValue(cJSON_GetObjectItem(signal_json, "encoding"));
+            cJSON *factor_json = cJSON_GetObjectItem(signal_json, "factor");
+            cJSON *offset_json = cJSON_GetObjectItem(signal_json, "offset");
+
+            if (name != NULL) {
+                /* a name which is too long is left without terminating zero, which is refused */
+                strncpy(signal->name, name, LINSIG_NAME_LEN);
+            }
+            signal->start_bit = (uint8_t)cJSON_GetNumberValue(cJSON_GetObjectItem(signal_json, "start_bit"));
+            signal->width = (uint8_t)cJSON_GetNumberValue(cJSON_GetObjectItem(signal_json, "width"));
+            signal->encoding = LINSIG_ENCODING_RAW;
+            if ((encoding != NULL) && (strcasecmp(encoding, "physical") == 0)) {
+                signal->encoding = LINSIG_ENCODING_PHYSICAL;
+            }
+            signal->factor = (factor_json != NULL) ? (float)cJSON_GetNumberValue(factor_json) : 1.0f;
+            signal->offset = (offset_json != NULL) ? (float)cJSON_GetNumberValue(offset_json) : 0.0f;
+            signal++;
+        }
+        frame++;
+    }
+
+    esp_err_t error = linsig_upload(blob, length);
+    free(blob);
+
+    if (error == ESP_OK) {
+        cJSON_AddNumberToObject(result, "generation", linsig_generation());
+        retval = WSS_ERR_NONE;
+    } else if (error == ESP_ERR_INVALID_ARG) {
+        cJSON_AddStringToObject(result, "message", "Invalid signal database");
+    } else {
+        cJSON_AddStringToObject(result, "message", esp_err_to_name(error));
+    }
+
+    return retval;
+}
+
+/** Add the values of signals to a json object
+ *
+ * @param[in]  names_json  array of signal names, or NULL for all signals.
+ * @param[out]  result  json object to add the "values" object to, and "unknown" for names which
+ *                      are not in the database.
+ * @param[in|out]  client_info  client to (un)subscribe to the signals, or NULL.
+ * @param[in]  subscribe  true to subscribe, false to unsubscribe the client.
+ */
+static void wss_lin_signal_values(const cJSON * const names_json,
+                                  cJSON * result,
+                                  wss_client_info_t *client_info,
+                                  bool subscribe) {
+    cJSON *values_json = cJSON_AddObjectToObject(result, "values");
+    cJSON *unknown_json = NULL;
+    linsig_value_t value;
+    char name[LINSIG_NAME_LEN];
+
+    if (names_json == NULL) {
+        for (uint16_t index = 0u; linsig_get_name(index, name); index++) {
+            if (linsig_get_value(index, &value)) {
+                wss_lin_signal_to_json(name, &value, values_json);
+            }
+        }
+        return;
+    }
+
+    cJSON *name_json = NULL;
+    cJSON_ArrayForEach(name_json, names_json) {
+        const char *signal_name = cJSON_GetStringValue(name_json);
+        int index = (signal_name != NULL) ? linsig_find(signal_name) : -1;
+
+        if (index < 0) {
+            if (unknown_json == NULL) {
+                unknown_json = cJSON_AddArrayToObject(result, "unknown");
+            }
+            cJSON_AddItemToArray(unknown_json, cJSON_Duplicate(name_json, false));
+            continue;
+        }
+
+        if (client_info != NULL) {
+            uint32_t bit = 1u << ((uint32_t)index & 31u);
+            if (subscribe) {
+                client_info->signal_subscriptions[index >> 5] |= bit;
+            } else {
+                client_info->signal_subscriptions[index >> 5] &= ~bit;
+            }
+        }
+        if ((client_info == NULL) || subscribe) {
+            if (linsig_get_value((uint16_t)index, &value)) {
+                wss_lin_signal_to_json(signal_name, &value, values_json);
+            }
+        }
+    }
+}
+
+static wss_error_code_t wss_lin_signal_subscribe(const cJSON * const params, cJSON * result) {
+    wss_error_code_t retval = WSS_ERR_ALREADY_SET;
+    cJSON *signals_json = cJSON_GetObjectItem(params, "signals");
+    cJSON *enable_json = cJSON_GetObjectItem(params, "enable");
+    wss_client_info_t *client_info = wss_get_client_connection_info(wss_current_sockfd);
+
+    if (!cJSON_IsArray(signals_json) || (client_info == NULL)) {
+        cJSON_AddStringToObject(result, "message", "Corrupted request");
+    } else {
+        if (!wss_signal_listener_registered) {
+            wss_signal_listener_registered = (linsig_add_listener(wss_lin_signal_listener, NULL) == ESP_OK);
+        }
+        uint32_t generation = linsig_generation();
+        if (client_info->signal_generation != generation) {
+            /* subscriptions to a previous database are void */
+            memset(client_info->signal_subscriptions, 0, sizeof(client_info->signal_subscriptions));
+            client_info->signal_generation = generation;
+        }
+        wss_lin_signal_values(signals_json, result, client_info, (enable_json == NULL) || cJSON_IsTrue(enable_json));
+        retval = WSS_ERR_NONE;
     }
 
     return retval;
 }
 
-static wss_error_code_t wss_lin_handle_message_on_bus(const cJSON * const params, cJSON * result) {
-    wss_error_code_t retval = WSS_ERR_COMMAND_UNKNOWN;
+static wss_error_code_t wss_lin_signal_status(const cJSON * const params, cJSON * result) {
+    (void)params;
+    linsig_status_t status;
+    linsig_get_status(&status);
+
+    cJSON_AddNumberToObject(result, "signals", status.nr_of_signals);
+    cJSON_AddNumberToObject(result, "frames", status.nr_of_frames);
+    cJSON_AddNumberToObject(result, "generation", status.generation);
+    cJSON_AddNumberToObject(result, "frames_decoded", status.frames_decoded);
+    cJSON_AddNumberToObject(result, "changes", status.changes);
+
+    return WSS_ERR_NONE;
+}
+
+static wss_error_code_t wss_lin_diagnostic(const char* function, const cJSON * const params, cJSON * result) {
+    wss_error_code_t retval = WSS_ERR_ALREADY_SET;
 
     if (busmngr_ClaimInterface(USER_WIFI, MODE_APPLICATION) == ESP_OK) {
-        cJSON *datalength_json = cJSON_GetObjectItem(params, "datalength");
-        cJSON *m2s_json = cJSON_GetObjectItem(params, "m2s");
+        bool receive_only = (strcasecmp(function, "ld_receive_message") == 0);
+        bool send_only = (strcasecmp(function, "ld_send_message") == 0);
+        cJSON *nad_json = cJSON_GetObjectItem(params, "nad");
         cJSON *baudrate_json = cJSON_GetObjectItem(params, "baudrate");
-        cJSON *enhanced_crc_json = cJSON_GetObjectItem(params, "enhanced_crc");
-        cJSON *frameid_json = cJSON_GetObjectItem(params, "frameid");
-
-        if ((datalength_json != NULL) && (m2s_json != NULL) &&
-            (baudrate_json != NULL) && (enhanced_crc_json != NULL) &&
-            (frameid_json != NULL)) {
-            size_t datalength = (int)cJSON_GetNumberValue(datalength_json);
-            bool m2s = cJSON_IsTrue(m2s_json);
-            int baudrate = (int)cJSON_GetNumberValue(baudrate_json);
-            bool enhanced_crc = cJSON_IsTrue(enhanced_crc_json);
-            uint8_t frameid = (int)cJSON_GetNumberValue(frameid_json);
+        cJSON *payload_json = cJSON_GetObjectItem(params, "payload");
+        int request_len = cJSON_GetArraySize(payload_json);
+
+        if ((nad_json != NULL) && (baudrate_json != NULL) &&
+            (receive_only || (cJSON_IsArray(payload_json) &&
+                              (request_len > 0) && (request_len <= (int)LINTP_MAX_MESSAGE_LEN)))) {
+            uint8_t nad = (uint8_t)cJSON_GetNumberValue(nad_json);
+            uint16_t baudrate = (uint16_t)cJSON_GetNumberValue(baudrate_json);
+            lintp_timing_t timing;
+            lintp_default_timing(&timing);
+            cJSON *timing_json = cJSON_GetObjectItem(params, "st_min");
+            if (timing_json != NULL) {
+                timing.st_min_ms = (uint16_t)cJSON_GetNumberValue(timing_json);
+            }
+            timing_json = cJSON_GetObjectItem(params, "p2_min");
+            if (timing_json != NULL) {
+                timing.p2_min_ms = (uint16_t)cJSON_GetNumberValue(timing_json);
+            }
 
-            if (m2s) {
-                cJSON *payload_json = cJSON_GetObjectItem(params, "payload");
-                if (payload_json != NULL) {
-                    uint8_t *payload = calloc(datalength, sizeof(uint8_t));
-                    if (payload != NULL) {
-                        for (int i = 0; i < cJSON_GetArraySize(payload_json); i++) {
-                            payload[i] = cJSON_GetArrayItem(payload_json, i)->valueint;
-                        }
+            uint8_t *request = NULL;
+            uint8_t *response = NULL;
+            if (!receive_only) {
+                request = malloc(request_len);
+            }
+            if (!send_only) {
+                response = malloc(LINTP_MAX_MESSAGE_LEN);
+            }
 
-                        lin_err_t error = linmaster_send_m2s(baudrate,
-                                                             enhanced_crc,
-                                                             frameid,
-                                                             payload,
-                                                             datalength);
+            if ((receive_only || (request != NULL)) && (send_only || (response != NULL))) {
+                for (int i = 0; i < request_len; i++) {
+                    request[i] = (uint8_t)cJSON_GetArrayItem(payload_json, i)->valueint;
+                }
 
-                        if (error == LIN_OK) {
-                            retval = WSS_ERR_NONE;
-                        } else {
-                            cJSON_AddStringToObject(result, "message", lin_err_to_string(error));
-                            retval = WSS_ERR_ALREADY_SET;
-                        }
-                    } else {
-                        cJSON_AddStringToObject(result, "message", mlxerr_ErrorCodeToName(MLX_FAIL_INTERNAL));
-                        retval = WSS_ERR_ALREADY_SET;
-                    }
-                    free(payload);
+                uint16_t response_len = 0u;
+                mlx_err_t error = MLX_OK;
+                if (send_only) {
+                    error = lintp_send_message(baudrate, nad, request, request_len, &timing);
+                } else if (receive_only) {
+                    error = lintp_receive_message(baudrate,
+                                                  nad,
+                                                  response,
+                                                  LINTP_MAX_MESSAGE_LEN,
+                                                  &response_len,
+                                                  &timing);
                 } else {
-                    cJSON_AddStringToObject(result, "message", "Corrupted request");
-                    retval = WSS_ERR_ALREADY_SET;
+                    error = lintp_diagnostic(baudrate,
+                                             nad,
+                                             request,
+                                             request_len,
+                                             response,
+                                             LINTP_MAX_MESSAGE_LEN,
+                                             &response_len,
+                                             &timing);
                 }
-            } else {
-                uint8_t *data = calloc(datalength, sizeof(uint8_t));
-                if (data != NULL) {
-                    lin_err_t error = linmaster_send_s2m(baudrate, enhanced_crc, frameid, data, datalength);
 
-                    if (error == LIN_OK) {
-                        /* Copy data into json */
-                        cJSON *result_json = cJSON_AddArrayToObject(result, "data");
-                        for (int i = 0; i < datalength; i++) {
-                            cJSON *number_json = cJSON_CreateNumber(data[i]);
-                            cJSON_AddItemToArray(result_json, number_json);
+                if (error == MLX_OK) {
+                    if (!send_only) {
+                        cJSON *data_json = cJSON_AddArrayToObject(result, "data");
+                        for (uint16_t i = 0u; i < response_len; i++) {
+                            cJSON_AddItemToArray(data_json, cJSON_CreateNumber(response[i]));
                         }
-                        retval = WSS_ERR_NONE;
-                    } else {
-                        cJSON_AddStringToObject(result, "message", lin_err_to_string(error));
-                        retval = WSS_ERR_ALREADY_SET;
                     }
+                    retval = WSS_ERR_NONE;
                 } else {
-                    cJSON_AddStringToObject(result, "message", mlxerr_ErrorCodeToName(MLX_FAIL_INTERNAL));
-                    retval = WSS_ERR_ALREADY_SET;
+                    cJSON_AddStringToObject(result, "message", mlxerr_ErrorCodeToName(error));
                 }
-                free(data);
+            } else {
+                cJSON_AddStringToObject(result, "message", mlxerr_ErrorCodeToName(MLX_FAIL_INTERNAL));
             }
+            free(request);
+            free(response);
         } else {
             cJSON_AddStringToObject(result, "message", "Corrupted request");
-            retval = WSS_ERR_ALREADY_SET;
         }
     } else {
         cJSON_AddStringToObject(result, "message", mlxerr_ErrorCodeToName(MLX_FAIL_INTERFACE_NOT_FREE));
-        retval = WSS_ERR_ALREADY_SET;
     }
 
     return retval;
@@ -220,85 +1363,501 @@ static wss_error_code_t wss_lin_handler(const char* function, const cJSON * cons
 
     ESP_LOGI(TAG, "LIN task received: %s", function);
 
-    if (strcasecmp(function, "l_ifc_wake_up") == 0) {
+    if (strcasecmp(function, "schedule_upload") == 0) {
+        retval = wss_lin_schedule_upload(params, result);
+    } else if (strcasecmp(function, "schedule_start") == 0) {
+        retval = wss_lin_schedule_start(params, result);
+    } else if (strcasecmp(function, "schedule_switch") == 0) {
+        retval = wss_lin_schedule_switch(params, result);
+    } else if (strcasecmp(function, "schedule_stop") == 0) {
+        retval = wss_lin_schedule_stop(params, result);
+    } else if (strcasecmp(function, "schedule_status") == 0) {
+        retval = wss_lin_schedule_status(params, result);
+    } else if (strcasecmp(function, "monitor_stop") == 0) {
+        retval = wss_lin_monitor_stop(params, result);
+    } else if (strcasecmp(function, "monitor_subscribe") == 0) {
+        cJSON *enable_json = cJSON_GetObjectItem(params, "enable");
+        wss_lin_monitor_subscribe((enable_json == NULL) || cJSON_IsTrue(enable_json));
+        retval = WSS_ERR_NONE;
+    } else if (strcasecmp(function, "monitor_status") == 0) {
+        retval = wss_lin_monitor_status(params, result);
+    } else if (strcasecmp(function, "signal_upload") == 0) {
+        retval = wss_lin_signal_upload(params, result);
+    } else if (strcasecmp(function, "signal_subscribe") == 0) {
+        retval = wss_lin_signal_subscribe(params, result);
+    } else if (strcasecmp(function, "signal_read") == 0) {
+        wss_lin_signal_values(cJSON_GetObjectItem(params, "signals"), result, NULL, false);
+        retval = WSS_ERR_NONE;
+    } else if (strcasecmp(function, "signal_status") == 0) {
+        retval = wss_lin_signal_status(params, result);
+    } else if (strcasecmp(function, "sporadic_update") == 0) {
+        retval = wss_lin_sporadic_update(params, result);
+    } else if (strcasecmp(function, "timing_read") == 0) {
+        retval = wss_lin_timing_read(params, result);
+    } else if (strcasecmp(function, "timing_clear") == 0) {
+        lintiming_clear();
+        retval = WSS_ERR_NONE;
+    } else if (strcasecmp(function, "cache_read") == 0) {
+        retval = wss_lin_cache_read(params, result);
+    } else if (strcasecmp(function, "cache_clear") == 0) {
+        lincache_clear();
+        retval = WSS_ERR_NONE;
+    } else if ((strcasecmp(function, "handle_message_on_bus") == 0) && wss_lin_cached_message(params, result)) {
+        retval = WSS_ERR_NONE;
+    } else if (linsched_running()) {
+        /* the bus is owned by the schedule */
+        cJSON_AddStringToObject(result, "message", mlxerr_ErrorCodeToName(MLX_FAIL_INTERFACE_NOT_FREE));
+        retval = WSS_ERR_ALREADY_SET;
+    } else if (strcasecmp(function, "l_ifc_wake_up") == 0) {
         retval = wss_lin_ifc_wake_up(params, result);
     } else if (strcasecmp(function, "handle_message_on_bus") == 0) {
         retval = wss_lin_handle_message_on_bus(params, result);
+    } else if (strcasecmp(function, "event_triggered") == 0) {
+        retval = wss_lin_event_triggered(params, result);
+    } else if (strcasecmp(function, "monitor_start") == 0) {
+        retval = wss_lin_monitor_start(params, result);
+    } else if ((strcasecmp(function, "ld_send_message") == 0) ||
+               (strcasecmp(function, "ld_receive_message") == 0) ||
+               (strcasecmp(function, "ld_diagnostic") == 0)) {
+        retval = wss_lin_diagnostic(function, params, result);
     }
-    /* TODO
-     * "ld_send_message"
-     * "ld_receive_message",
-     * "ld_diagnostic"
-     */
 
     return retval;
 }
 
-static wss_error_code_t wss_btl_handler(const char* function, const cJSON * const params, cJSON * result) {
-    wss_error_code_t retval = WSS_ERR_COMMAND_UNKNOWN;
+/** Drop the image upload and release its image */
+static void wss_hex_upload_reset(void) {
+    fwimg_free(&wss_hex_upload.image);
+    memset(&wss_hex_upload, 0, sizeof(wss_hex_upload));
+    fwimg_init_psram(&wss_hex_upload.image);
+}
 
-    ESP_LOGI(TAG, "bootloader task received: %s", function);
+/** Handle a binary image upload chunk
+ *
+ * The data in the chunk is parsed right away, errors are kept and reported by the commit.
+ *
+ * @param[in]  sockfd  socket of the client which sent the chunk.
+ * @param[in]  message  binary message, starting with the chunk header.
+ * @param[in]  length  length of the message.
+ */
+static void wss_hex_upload_chunk(int sockfd, const uint8_t *message, size_t length) {
+    if ((wss_hex_upload.sockfd != sockfd) || wss_hex_upload.committed) {
+        ESP_LOGW(TAG, "upload chunk of client %d without an upload", sockfd);
+    } else if (wss_hex_upload.error == NULL) {
+        uint32_t offset = (uint32_t)message[4] |
+                          ((uint32_t)message[5] << 8) |
+                          ((uint32_t)message[6] << 16) |
+                          ((uint32_t)message[7] << 24);
+        if (offset != wss_hex_upload.offset) {
+            wss_hex_upload.error = "Chunk out of order";
+        } else {
+            size_t data_len = length - WSS_HEX_CHUNK_HEADER_LEN;
+            fwimg_load_result_t load = fwimg_loader_feed(&wss_hex_upload.loader,
+                                                         &message[WSS_HEX_CHUNK_HEADER_LEN],
+                                                         data_len);
+            if (load != FWIMG_LOAD_OK) {
+                wss_hex_upload.error = fwimg_loader_result_to_string(load);
+            }
+            wss_hex_upload.offset += (uint32_t)data_len;
+        }
+    }
+}
+
+/** Handle a binary message
+ *
+ * @param[in]  sockfd  socket of the client which sent the message.
+ * @param[in]  message  binary message.
+ * @param[in]  length  length of the message.
+ */
+static void wss_binary_handler(int sockfd, const uint8_t *message, size_t length) {
+    uint16_t id = 0u;
+    if (length >= sizeof(uint16_t)) {
+        id = (uint16_t)message[0] | (uint16_t)((uint16_t)message[1] << 8);
+    }
+
+    if ((id == WSS_BINARY_HEX_CHUNK) && (length >= WSS_HEX_CHUNK_HEADER_LEN)) {
+        wss_hex_upload_chunk(sockfd, message, length);
+    } else {
+        ESP_LOGW(TAG, "unknown binary message 0x%04x of client %d", id, sockfd);
+    }
+}
+
+static wss_error_code_t wss_btl_upload_start(const cJSON * const params, cJSON * result) {
+    (void)params;
+    wss_error_code_t retval = WSS_ERR_NONE;
+
+    if ((wss_hex_upload.sockfd != 0) && (wss_hex_upload.sockfd != wss_current_sockfd)) {
+        cJSON_AddStringToObject(result, "message", "Upload in progress by another client");
+        retval = WSS_ERR_ALREADY_SET;
+    } else {
+        wss_hex_upload_reset();
+        wss_hex_upload.sockfd = wss_current_sockfd;
+        fwimg_loader_init(&wss_hex_upload.loader, &wss_hex_upload.image);
+        cJSON_AddNumberToObject(result, "chunk_size", WSS_HEX_CHUNK_MAX_LEN);
+    }
+
+    return retval;
+}
+
+static wss_error_code_t wss_btl_upload_commit(const cJSON * const params, cJSON * result) {
+    wss_error_code_t retval = WSS_ERR_ALREADY_SET;
+    cJSON *size_json = cJSON_GetObjectItem(params, "size");
+
+    if ((wss_hex_upload.sockfd != wss_current_sockfd) || (wss_current_sockfd == 0)) {
+        cJSON_AddStringToObject(result, "message", "No upload in progress");
+    } else {
+        if (!wss_hex_upload.committed && (wss_hex_upload.error == NULL)) {
+            if ((size_json != NULL) && ((uint32_t)cJSON_GetNumberValue(size_json) != wss_hex_upload.offset)) {
+                wss_hex_upload.error = "Upload incomplete";
+            } else {
+                fwimg_load_result_t load = fwimg_loader_finish(&wss_hex_upload.loader);
+                if (load != FWIMG_LOAD_OK) {
+                    wss_hex_upload.error = fwimg_loader_result_to_string(load);
+                }
+            }
+        }
+
+        if (wss_hex_upload.error != NULL) {
+            cJSON_AddStringToObject(result, "message", wss_hex_upload.error);
+            wss_hex_upload_reset();
+        } else {
+            wss_hex_upload.committed = true;
+            cJSON_AddNumberToObject(result, "size", wss_hex_upload.offset);
+            if (wss_hex_upload.loader.format == FWIMG_FORMAT_HEX) {
+                cJSON_AddStringToObject(result, "format", "hex");
+                cJSON_AddNumberToObject(result, "records", wss_hex_upload.loader.hex.lines);
+            } else {
+                cJSON_AddStringToObject(result, "format", "binary");
+                cJSON_AddNumberToObject(result, "records", wss_hex_upload.loader.pages);
+            }
+            cJSON_AddNumberToObject(result, "pages", fwimg_pages_present(&wss_hex_upload.image));
+            /* stored by a job, the httpd task does not wait for the flash writes; a repeated
+             * upload of the same image only marks it as recently used */
+            uint8_t hash[FWCACHE_HASH_LEN];
+            esp_err_t cached = fwcache_store_background(&wss_hex_upload.image, hash);
+            if (cached == ESP_OK) {
+                char hash_str[FWCACHE_HASH_STR_LEN];
+                fwcache_hash_to_string(hash, hash_str);
+                cJSON_AddStringToObject(result, "hash", hash_str);
+            } else {
+                ESP_LOGW(TAG, "image not cached (%s)", esp_err_to_name(cached));
+            }
+            cJSON_AddBoolToObject(result, "cached", cached == ESP_OK);
+            retval = WSS_ERR_NONE;
+        }
+    }
+
+    return retval;
+}
+
+static wss_error_code_t wss_btl_upload_abort(const cJSON * const params, cJSON * result) {
+    (void)params;
+    (void)result;
 
+    if (wss_hex_upload.sockfd == wss_current_sockfd) {
+        wss_hex_upload_reset();
+    }
+
+    return WSS_ERR_NONE;
+}
+
+static wss_error_code_t wss_btl_cache_list(const cJSON * const params, cJSON * result) {
+    (void)params;
+    /* static, the websocket handlers run in the httpd task */
+    static fwcache_entry_t entries[FWCACHE_MAX_ENTRIES];
+    uint32_t nr_of_entries = fwcache_list(entries);
+    cJSON *images = cJSON_AddArrayToObject(result, "images");
+
+    for (uint32_t i = 0u; i < nr_of_entries; i++) {
+        char hash_str[FWCACHE_HASH_STR_LEN];
+        cJSON *image = cJSON_CreateObject();
+        fwcache_hash_to_string(entries[i].hash, hash_str);
+        cJSON_AddStringToObject(image, "hash", hash_str);
+        cJSON_AddNumberToObject(image, "size", entries[i].size);
+        cJSON_AddBoolToObject(image, "pinned", entries[i].pinned != 0u);
+        cJSON_AddItemToArray(images, image);
+    }
+
+    return WSS_ERR_NONE;
+}
+
+/** Bootloader job started over the websocket */
+typedef struct wss_btl_job_s {
+    int sockfd;                                 /**< socket of the client which started the job */
+    uint32_t session;                           /**< session of the client which started the job */
+    char *request_id;                           /**< id of the request, NULL if it has none */
+    bool wait;                                  /**< true: the request is answered when the job finishes */
+    bool manpow;                                /**< manual power cycling */
+    bool broadcast;                             /**< program all slaves at once */
+    bool differential;                          /**< skip the pages which are in the memory already */
+    bool cached;                                /**< true: the image is loaded from the cache by the job */
+    uint8_t hash[FWCACHE_HASH_LEN];             /**< hash of the cached image */
+    uint32_t bitrate;                           /**< bootloader bitrate */
+    ppm_memory_t memory;                        /**< memory to program or verify */
+    ppm_action_t action;                        /**< bootloader action */
+    fwimg_t image;                              /**< image of the job, owned by the job */
+    uint32_t pages;                             /**< pages programmed */
+    uint32_t skipped;                           /**< pages skipped as they are in the memory already */
+    const char *message;                        /**< error message of a failed job, NULL if none */
+} wss_btl_job_t;
+
+/** true while a bootloader job is pending, the job holds the bootloader claim */
+static bool wss_btl_pending = false;
+
+/** Run a bootloader job, in the job worker task
+ *
+ * @param[in]  id  job id.
+ * @param[in]  arg  job context (wss_btl_job_t).
+ * @param[out]  error  error code of a failed job.
+ * @retval  true  action succeeded.
+ * @retval  false  action failed.
+ */
+static bool wss_btl_job_run(uint32_t id, void *arg, int32_t *error) {
+    wss_btl_job_t *job = (wss_btl_job_t *)arg;
+    bool retval = false;
+
+    /* the bus was claimed for the bootloader when the job was submitted */
+    progress_start(PROGRESS_OP_BOOTLOADER);
+    if (job->cached && (fwcache_load(job->hash, &job->image) != ESP_OK)) {
+        *error = MLX_FAIL_BTL_IMAGE_NOT_CACHED;
+        job->message = mlxerr_ErrorCodeToName(MLX_FAIL_BTL_IMAGE_NOT_CACHED);
+    } else if (!fwimg_memory_matches(&job->image, job->memory)) {
+        *error = MLX_FAIL_BTL_MISSING_DATA;
+        job->message = "Image is meant for another memory";
+    } else if (jobs_cancel_requested(id)) {
+        /* last point to stop, the action itself cannot be interrupted */
+        *error = MLX_FAIL_JOB_CANCELLED;
+        job->message = mlxerr_ErrorCodeToName(MLX_FAIL_JOB_CANCELLED);
+    } else {
+        ppm_err_t ppmstat = PPM_OK;
+        if (job->action == PPM_ACT_PROGRAM) {
+            ppmstat = fwcache_ppm_program(job->manpow,
+                                          job->broadcast,  /* todo pass id */
+                                          job->bitrate,
+                                          job->memory,
+                                          &job->image,
+                                          job->differential,
+                                          &job->skipped);
+            job->pages = fwimg_pages_present(&job->image) - job->skipped;
+        } else {
+            ppmstat = fwimg_ppm_action(job->manpow,
+                                       job->broadcast,  /* todo pass id */
+                                       job->bitrate,
+                                       job->memory,
+                                       job->action,
+                                       &job->image);
+        }
+        if (ppmstat == PPM_OK) {
+            retval = true;
+        } else {
+            /* the job reports an MLX code, the message tells the status of the bootloader */
+            *error = (job->action == PPM_ACT_VERIFY) ? MLX_FAIL_BTL_VERIFY_FAILED : MLX_FAIL_BTL_PROGRAMMING_FAILED;
+            job->message = ppm_err_to_string(ppmstat);
+        }
+    }
+    progress_finish(retval);
+
+    return retval;
+}
+
+/** Answer the request of a finished bootloader job and release the job, in the job worker task
+ *
+ * @param[in]  id  job id.
+ * @param[in]  state  final state of the job.
+ * @param[in]  error  error code of a failed job.
+ * @param[in]  arg  job context (wss_btl_job_t).
+ */
+static void wss_btl_job_done(uint32_t id, job_state_t state, int32_t error, void *arg) {
+    (void)error;
+    wss_btl_job_t *job = (wss_btl_job_t *)arg;
+
+    if (job->wait) {
+        cJSON *response = cJSON_CreateObject();
+        cJSON *result = cJSON_CreateObject();
+        if (job->request_id != NULL) {
+            cJSON_AddStringToObject(response, "id", job->request_id);
+        }
+        cJSON_AddItemToObject(response, "payload", result);
+        cJSON_AddNumberToObject(result, "job", id);
+        if (state == JOB_STATE_DONE) {
+            if (job->action == PPM_ACT_PROGRAM) {
+                cJSON_AddNumberToObject(result, "pages", job->pages);
+                cJSON_AddNumberToObject(result, "skipped", job->skipped);
+            }
+            cJSON_AddStringToObject(response, "type", "ack");
+        } else {
+            if (state == JOB_STATE_CANCELLED) {
+                cJSON_AddStringToObject(result, "message", mlxerr_ErrorCodeToName(MLX_FAIL_JOB_CANCELLED));
+            } else if (job->message != NULL) {
+                cJSON_AddStringToObject(result, "message", job->message);
+            } else {
+                cJSON_AddStringToObject(result, "message", "Error unknown");
+            }
+            cJSON_AddStringToObject(response, "type", "error");
+        }
+
+        char *message = cJSON_PrintUnformatted(response);
+        if ((message == NULL) || !wss_queue_text(job->sockfd, job->session, message)) {
+            ESP_LOGE(TAG, "response of job %lu could not be sent", (unsigned long)id);
+        }
+        cJSON_free(message);
+        cJSON_Delete(response);
+    }
+
+    fwimg_free(&job->image);
+    free(job->request_id);
+    free(job);
+
+    /* the claim is released before a new job can be accepted */
+    (void)busmngr_ReleaseInterface(USER_WIFI, MODE_BOOTLOADER);
+    wss_btl_pending = false;
+}
+
+/** Claim the bus for a bootloader job, in the httpd task which owns the application claim
+ *
+ * @retval  true  bus is claimed for the bootloader.
+ * @retval  false  bus is in use by another interface.
+ */
+static bool wss_btl_claim(void) {
+    if (busmngr_CheckClaim(USER_WIFI, MODE_APPLICATION)) {
+        (void)linsched_stop();
+    }
     (void)busmngr_ReleaseInterface(USER_WIFI, MODE_APPLICATION);
 
-    if (busmngr_ClaimInterface(USER_WIFI, MODE_BOOTLOADER) == ESP_OK) {
-        char *hexfile = cJSON_GetObjectItem(params, "hexfile")->valuestring;
-        char *memory_str = cJSON_GetObjectItem(params, "memory")->valuestring;
+    return busmngr_ClaimInterface(USER_WIFI, MODE_BOOTLOADER) == ESP_OK;
+}
+
+static wss_error_code_t wss_btl_program(const char* function, const cJSON * const params, cJSON * result) {
+    wss_error_code_t retval = WSS_ERR_COMMAND_UNKNOWN;
+
+    ppm_action_t action = PPM_ACT_INVALID;
+    if (strcasecmp(function, "program") == 0) {
+        action = PPM_ACT_PROGRAM;
+    } else if (strcasecmp(function, "verify") == 0) {
+        action = PPM_ACT_VERIFY;
+    }
+
+    if (action != PPM_ACT_INVALID) {
+        char *hexfile = cJSON_GetStringValue(cJSON_GetObjectItem(params, "hexfile"));
+        char *memory_str = cJSON_GetStringValue(cJSON_GetObjectItem(params, "memory"));
         cJSON *manpow_json = cJSON_GetObjectItem(params, "manpow");
         cJSON *bitrate_json = cJSON_GetObjectItem(params, "bitrate");
         cJSON *project_json = cJSON_GetObjectItem(params, "project");
+        cJSON *wait_json = cJSON_GetObjectItem(params, "wait");
+        char *image_str = cJSON_GetStringValue(cJSON_GetObjectItem(params, "image"));
+
+        /* image selects a cached image by its hash */
+        uint8_t hash[FWCACHE_HASH_LEN];
+        bool cached = (hexfile == NULL) && (image_str != NULL) && fwcache_hash_from_string(image_str, hash);
+
+        /* without hexfile and image the image of the committed binary upload is used */
+        bool uploaded = (hexfile == NULL) &&
+                        (image_str == NULL) &&
+                        wss_hex_upload.committed &&
+                        (wss_hex_upload.sockfd == wss_current_sockfd);
+
+        wss_btl_job_t *job = NULL;
+        if ((memory_str != NULL) && ((hexfile != NULL) || uploaded || cached)) {
+            job = calloc(1, sizeof(wss_btl_job_t));
+        }
 
-        if ((memory_str != NULL) && (hexfile != NULL)) {
-            bool manpow = false;
-            if (manpow_json != NULL) {
-                manpow = cJSON_IsTrue(manpow_json);
-            }
-            uint32_t bitrate = 300000u;
+        if (job != NULL) {
+            wss_client_info_t *client_info = wss_get_client_connection_info(wss_current_sockfd);
+            job->sockfd = wss_current_sockfd;
+            job->session = (client_info != NULL) ? client_info->session : 0u;
+            job->request_id = (wss_current_id != NULL) ? strdup(wss_current_id) : NULL;
+            job->wait = (wait_json == NULL) || cJSON_IsTrue(wait_json);
+            job->manpow = cJSON_IsTrue(manpow_json);
+            job->bitrate = 300000u;
             if (bitrate_json != NULL) {
-                bitrate = (uint32_t)cJSON_GetNumberValue(bitrate_json);
+                job->bitrate = (uint32_t)cJSON_GetNumberValue(bitrate_json);
             }
-            uint16_t project = 0x0000u;
             if (project_json != NULL) {
-                project = (uint16_t)cJSON_GetNumberValue(project_json);
+                job->broadcast = ((uint16_t)cJSON_GetNumberValue(project_json) != 0x0000u);
             }
-            ppm_memory_t memory = PPM_MEM_INVALID;
+            job->differential = cJSON_IsTrue(cJSON_GetObjectItem(params, "differential"));
+            job->memory = PPM_MEM_INVALID;
             if (strcasecmp(memory_str, "flash") == 0) {
-                memory = PPM_MEM_FLASH;
+                job->memory = PPM_MEM_FLASH;
             } else if ((strcasecmp(memory_str, "nvram") == 0) || (strcasecmp(memory_str, "eeprom") == 0)) {
-                memory = PPM_MEM_NVRAM;
+                job->memory = PPM_MEM_NVRAM;
             }
-            ppm_action_t action = PPM_ACT_INVALID;
-            if (strcasecmp(function, "program") == 0) {
-                action = PPM_ACT_PROGRAM;
-            } else if (strcasecmp(function, "verify") == 0) {
-                action = PPM_ACT_VERIFY;
+            job->action = action;
+
+            /* the job gets its own image, such that a new upload cannot change it while the job waits */
+            bool available = true;
+            const char *load_error = NULL;
+            fwimg_init_psram(&job->image);
+            if (uploaded) {
+                available = fwimg_copy(&wss_hex_upload.image, &job->image);
+            } else if (cached) {
+                job->cached = true;
+                memcpy(job->hash, hash, sizeof(job->hash));
+            } else {
+                fwimg_loader_t loader;
+                fwimg_loader_init(&loader, &job->image);
+                (void)fwimg_loader_feed(&loader, (const uint8_t *)hexfile, strlen(hexfile));
+                fwimg_load_result_t load = fwimg_loader_finish(&loader);
+                if (load != FWIMG_LOAD_OK) {
+                    /* an invalid file is refused before a job is submitted */
+                    load_error = fwimg_loader_result_to_string(load);
+                }
             }
 
-            ihexContainer_t * iHex = intelhex_read(hexfile, strlen(hexfile));
-            ppm_err_t ppmstat = ppmbtl_doAction(manpow,
-                                                project != 0x0000,  /* todo pass id */
-                                                bitrate,
-                                                memory,
-                                                action,
-                                                iHex);
-            intelhex_free(iHex);
-
-            if (ppmstat == PPM_OK) {
-                retval = WSS_ERR_NONE;
+            /* the job is owned by the worker once it is submitted */
+            bool wait = job->wait;
+            uint32_t id = JOB_ID_NONE;
+            retval = WSS_ERR_ALREADY_SET;
+            if (!available) {
+                cJSON_AddStringToObject(result, "message", mlxerr_ErrorCodeToName(MLX_FAIL_SERVER_ERR));
+            } else if (load_error != NULL) {
+                cJSON_AddStringToObject(result, "message", load_error);
+            } else if (wss_btl_pending || !wss_btl_claim()) {
+                cJSON_AddStringToObject(result, "message", mlxerr_ErrorCodeToName(MLX_FAIL_INTERFACE_NOT_FREE));
             } else {
-                cJSON_AddStringToObject(result, "message", ppm_err_to_string(ppmstat));
-                retval = WSS_ERR_ALREADY_SET;
+                /* pending before the job can run, the done callback clears it */
+                wss_btl_pending = true;
+                if (jobs_submit(JOB_KIND_BOOTLOADER, wss_btl_job_run, wss_btl_job_done, job, &id) != ESP_OK) {
+                    wss_btl_pending = false;
+                    (void)busmngr_ReleaseInterface(USER_WIFI, MODE_BOOTLOADER);
+                    cJSON_AddStringToObject(result, "message", mlxerr_ErrorCodeToName(MLX_FAIL_JOB_QUEUE_FULL));
+                } else if (wait) {
+                    retval = WSS_ERR_DEFERRED;
+                } else {
+                    cJSON_AddNumberToObject(result, "job", id);
+                    retval = WSS_ERR_NONE;
+                }
+            }
+            if (retval == WSS_ERR_ALREADY_SET) {
+                fwimg_free(&job->image);
+                free(job->request_id);
+                free(job);
             }
         } else {
             cJSON_AddStringToObject(result, "message", "Corrupted request");
             retval = WSS_ERR_ALREADY_SET;
         }
-    } else {
-        cJSON_AddStringToObject(result, "message", mlxerr_ErrorCodeToName(MLX_FAIL_INTERFACE_NOT_FREE));
-        retval = WSS_ERR_ALREADY_SET;
     }
 
-    (void)busmngr_ReleaseInterface(USER_WIFI, MODE_BOOTLOADER);
+    return retval;
+}
+
+static wss_error_code_t wss_btl_handler(const char* function, const cJSON * const params, cJSON * result) {
+    wss_error_code_t retval = WSS_ERR_COMMAND_UNKNOWN;
+
+    ESP_LOGI(TAG, "bootloader task received: %s", function);
+
+    if (strcasecmp(function, "upload_start") == 0) {
+        retval = wss_btl_upload_start(params, result);
+    } else if (strcasecmp(function, "upload_commit") == 0) {
+        retval = wss_btl_upload_commit(params, result);
+    } else if (strcasecmp(function, "upload_abort") == 0) {
+        retval = wss_btl_upload_abort(params, result);
+    } else if (strcasecmp(function, "cache_list") == 0) {
+        retval = wss_btl_cache_list(params, result);
+    } else {
+        retval = wss_btl_program(function, params, result);
+    }
 
     return retval;
 }
@@ -329,7 +1888,57 @@ static wss_error_code_t wss_power_out_handler(const char* function, const cJSON
     return retval;
 }
 
-/** WebSocket Message Handler */
+static wss_error_code_t wss_jobs_handler(const char* function, const cJSON * const params, cJSON * result) {
+    wss_error_code_t retval = WSS_ERR_COMMAND_UNKNOWN;
+
+    ESP_LOGI(TAG, "jobs task received: %s", function);
+
+    cJSON *job_json = cJSON_GetObjectItem(params, "job");
+    uint32_t id = (job_json != NULL) ? (uint32_t)cJSON_GetNumberValue(job_json) : JOB_ID_NONE;
+
+    if (strcasecmp(function, "list") == 0) {
+        /* static, the websocket handlers run in the httpd task */
+        static job_info_t infos[JOB_TABLE_SIZE];
+        size_t nr_of_jobs = jobs_list(infos, JOB_TABLE_SIZE);
+        cJSON *jobs_json = cJSON_AddArrayToObject(result, "jobs");
+        for (size_t i = 0u; i < nr_of_jobs; i++) {
+            cJSON *info_json = cJSON_CreateObject();
+            wss_job_to_json(&infos[i], info_json);
+            cJSON_AddItemToArray(jobs_json, info_json);
+        }
+        retval = WSS_ERR_NONE;
+    } else if (strcasecmp(function, "status") == 0) {
+        job_info_t info;
+        if (jobs_get(id, &info) == ESP_OK) {
+            wss_job_to_json(&info, result);
+            retval = WSS_ERR_NONE;
+        } else {
+            cJSON_AddStringToObject(result, "message", "Job unknown");
+            retval = WSS_ERR_ALREADY_SET;
+        }
+    } else if (strcasecmp(function, "cancel") == 0) {
+        job_cancel_result_t cancel = jobs_cancel(id);
+        if ((cancel == JOB_CANCEL_DONE) || (cancel == JOB_CANCEL_REQUESTED)) {
+            cJSON_AddBoolToObject(result, "cancelled", cancel == JOB_CANCEL_DONE);
+            retval = WSS_ERR_NONE;
+        } else {
+            cJSON_AddStringToObject(result, "message",
+                                    (cancel == JOB_CANCEL_TOO_LATE) ? "Job already finished" : "Job unknown");
+            retval = WSS_ERR_ALREADY_SET;
+        }
+    }
+
+    return retval;
+}
+
+/** WebSocket Message Handler
+ *
+ * @param[in]  input  received message.
+ * @param[out]  output  response to the message.
+ * @retval  ESP_OK  response is to be sent.
+ * @retval  ESP_ERR_NOT_FINISHED  response is sent by a job when it finishes.
+ * @retval  ESP_FAIL  message has no response.
+ */
 static esp_err_t wss_message_handler(const cJSON * const input, cJSON * output) {
     esp_err_t retval = ESP_FAIL;
 
@@ -365,10 +1974,15 @@ static esp_err_t wss_message_handler(const cJSON * const input, cJSON * output)
                 wss_err = wss_btl_handler(command->valuestring, params, result);
             } else if (strcasecmp(endpoint->valuestring, "power_out") == 0) {
                 wss_err = wss_power_out_handler(command->valuestring, params, result);
+            } else if (strcasecmp(endpoint->valuestring, "jobs") == 0) {
+                wss_err = wss_jobs_handler(command->valuestring, params, result);
             }
 
+            retval = ESP_OK;
             if (wss_err == WSS_ERR_NONE) {
                 cJSON_AddStringToObject(output, "type", "ack");
+            } else if (wss_err == WSS_ERR_DEFERRED) {
+                retval = ESP_ERR_NOT_FINISHED;
             } else if (wss_err == WSS_ERR_ENDPOINT_UNKNOWN) {
                 cJSON_AddStringToObject(output, "type", "error");
                 cJSON_AddStringToObject(result, "message", "Endpoint unknown");
@@ -381,7 +1995,6 @@ static esp_err_t wss_message_handler(const cJSON * const input, cJSON * output)
                 cJSON_AddStringToObject(output, "type", "error");
                 cJSON_AddStringToObject(result, "message", "Error unknown");
             }
-            retval = ESP_OK;
         } else {
             cJSON_AddStringToObject(output, "type", "error");
             cJSON_AddStringToObject(result, "message", "Protocol unknown");
@@ -417,6 +2030,36 @@ static esp_err_t wss_handler(httpd_req_t *req) {
     }
 
     ESP_LOGI(TAG, "frame len is %d", ws_pkt.len);
+    wss_client_info_t *client_info = wss_get_client_connection_info(httpd_req_to_sockfd(req));
+    if (client_info == NULL) {
+        ESP_LOGE(TAG, "client %d is unknown", httpd_req_to_sockfd(req));
+        return ESP_FAIL;
+    }
+
+    /* binary messages are handled per frame, fragmented or oversized ones are refused */
+    const char *refusal = NULL;
+    bool discard = false;
+    if (ws_pkt.type == HTTPD_WS_TYPE_CONTINUE) {
+        /* the continuation frames of a refused message are dropped up to its final frame */
+        discard = client_info->discarding || (client_info->message == NULL);
+        if (ws_pkt.final) {
+            client_info->discarding = false;
+        }
+    } else {
+        client_info->discarding = false;
+        if ((ws_pkt.type == HTTPD_WS_TYPE_BINARY) && !ws_pkt.final) {
+            refusal = "Chunk fragmented";
+            client_info->discarding = true;
+        } else if ((ws_pkt.type == HTTPD_WS_TYPE_BINARY) && (ws_pkt.len > WSS_BINARY_MAX_LEN)) {
+            refusal = "Chunk too large";
+        }
+    }
+    if (refusal != NULL) {
+        ESP_LOGE(TAG, "binary frame of %d bytes refused: %s", ws_pkt.len, refusal);
+        if ((wss_hex_upload.sockfd == httpd_req_to_sockfd(req)) && (wss_hex_upload.error == NULL)) {
+            wss_hex_upload.error = refusal;
+        }
+    }
     if (ws_pkt.len) {
         /* ws_pkt.len + 1 is for NULL termination as we are expecting a string */
         buf = calloc(ws_pkt.len + 1, sizeof(uint8_t));
@@ -435,15 +2078,38 @@ static esp_err_t wss_handler(httpd_req_t *req) {
         }
     }
 
-    if ((ws_pkt.type == HTTPD_WS_TYPE_TEXT) || (ws_pkt.type == HTTPD_WS_TYPE_CONTINUE)) {
-        ESP_LOGD(TAG, "ws frame received for client %d", httpd_req_to_sockfd(req));
+    if (discard) {
+        /* the payload is read and dropped such that the session stays in sync */
+        free(buf);
+        return ESP_OK;
+    }
 
-        wss_client_info_t *client_info = wss_get_client_connection_info(httpd_req_to_sockfd(req));
-        if (client_info == NULL) {
-            ESP_LOGE(TAG, "client %d is unknown", httpd_req_to_sockfd(req));
-            free(buf);
-            return ESP_FAIL;
+    if (refusal != NULL) {
+        /* the payload is read and dropped such that the session stays open, the client is told why */
+        cJSON *response = cJSON_CreateObject();
+        cJSON *result = cJSON_CreateObject();
+        cJSON_AddStringToObject(response, "type", "error");
+        cJSON_AddStringToObject(result, "message", refusal);
+        cJSON_AddItemToObject(response, "payload", result);
+        char *json_resp = cJSON_PrintUnformatted(response);
+        if (json_resp != NULL) {
+            ws_pkt.payload = (uint8_t*)json_resp;
+            ws_pkt.len = strlen(json_resp);
+            ws_pkt.type = HTTPD_WS_TYPE_TEXT;
+            ws_pkt.final = true;
+            ret = httpd_ws_send_frame(req, &ws_pkt);
+            if (ret != ESP_OK) {
+                ESP_LOGE(TAG, "httpd_ws_send_frame failed with %d", ret);
+            }
         }
+        cJSON_free(json_resp);
+        cJSON_Delete(response);
+        free(buf);
+        return ESP_OK;
+    }
+
+    if ((ws_pkt.type == HTTPD_WS_TYPE_TEXT) || (ws_pkt.type == HTTPD_WS_TYPE_CONTINUE)) {
+        ESP_LOGD(TAG, "ws frame received for client %d", httpd_req_to_sockfd(req));
 
         if (ws_pkt.type == HTTPD_WS_TYPE_TEXT) {
             if (client_info->message != NULL) {
@@ -455,11 +2121,13 @@ static esp_err_t wss_handler(httpd_req_t *req) {
             client_info->message_len = ws_pkt.len + 1;
         } else {
             /* extend buffered frame with extra content */
-            client_info->message = realloc(client_info->message,
-                                           client_info->message_len + ws_pkt.len);
-            memcpy(&client_info->message[client_info->message_len - 1], buf, ws_pkt.len + 1);
-            client_info->message_len += ws_pkt.len;
-            free(buf);
+            if (buf != NULL) {
+                client_info->message = realloc(client_info->message,
+                                               client_info->message_len + ws_pkt.len);
+                memcpy(&client_info->message[client_info->message_len - 1], buf, ws_pkt.len + 1);
+                client_info->message_len += ws_pkt.len;
+                free(buf);
+            }
         }
         ESP_LOGD(TAG, "ws buffered message len now is %d", client_info->message_len - 1);
 
@@ -473,9 +2141,10 @@ static esp_err_t wss_handler(httpd_req_t *req) {
                 if (id != NULL) {
                     cJSON_AddStringToObject(response, "id", id->valuestring);
                 }
+                wss_current_sockfd = httpd_req_to_sockfd(req);
+                wss_current_id = (id != NULL) ? id->valuestring : NULL;
+                /* long running commands are handed over to a job, which sends the response itself */
                 if (wss_message_handler(root, response) == ESP_OK) {
-                    /* TODO handling should be moved to another thread so that ping pong can continue
-                     * and STR `this.state.isBootloading` commit can be reverted */
                     char *json_resp = NULL;
                     json_resp = cJSON_PrintUnformatted(response);
                     if (json_resp != NULL) {
@@ -493,6 +2162,7 @@ static esp_err_t wss_handler(httpd_req_t *req) {
                     }
                     cJSON_free(json_resp);
                 }
+                wss_current_id = NULL;
                 cJSON_Delete(response);
             }
             cJSON_Delete(root);
@@ -502,6 +2172,9 @@ static esp_err_t wss_handler(httpd_req_t *req) {
         }
         return ret;
     }
+    if (ws_pkt.type == HTTPD_WS_TYPE_BINARY) {
+        wss_binary_handler(httpd_req_to_sockfd(req), buf, ws_pkt.len);
+    }
     free(buf);
     return ESP_OK;
 }
@@ -529,8 +2202,17 @@ static esp_err_t wss_open_fd(httpd_handle_t hd, int sockfd) {
     wss_client_info_t *client_info = wss_get_client_connection_info(0);
     if (client_info != NULL) {
         client_info->sockfd = sockfd;
+        wss_last_session++;
+        if (wss_last_session == 0u) {
+            wss_last_session++;
+        }
+        client_info->session = wss_last_session;
         client_info->message = NULL;
         client_info->message_len = 0;
+        client_info->discarding = false;
+        client_info->monitor_subscribed = false;
+        client_info->signal_generation = 0u;
+        memset(client_info->signal_subscriptions, 0, sizeof(client_info->signal_subscriptions));
     }
 
     return ESP_OK;
@@ -560,17 +2242,36 @@ static void wss_close_fd(httpd_handle_t hd, int sockfd) {
     wss_client_info_t *client_info = wss_get_client_connection_info(sockfd);
     if (client_info != NULL) {
         client_info->sockfd = 0;
+        client_info->session = 0u;
         if (client_info->message != NULL) {
             free(client_info->message);
         }
         client_info->message = NULL;
         client_info->message_len = 0;
+        client_info->discarding = false;
+        client_info->monitor_subscribed = false;
+        client_info->signal_generation = 0u;
+        memset(client_info->signal_subscriptions, 0, sizeof(client_info->signal_subscriptions));
     }
 
     close(sockfd);
 
+    /* drop the hex upload of the client */
+    if (wss_hex_upload.sockfd == sockfd) {
+        wss_hex_upload_reset();
+    }
+
     /* release lin interface if it was taken */
+    if (busmngr_CheckClaim(USER_WIFI, MODE_APPLICATION)) {
+        (void)linsched_stop();
+    }
     (void)busmngr_ReleaseInterface(USER_WIFI, MODE_APPLICATION);
+
+    /* stop the monitor if it was started over the websocket */
+    if (busmngr_CheckClaim(USER_WIFI, MODE_MONITOR)) {
+        (void)linmon_stop();
+    }
+    (void)busmngr_ReleaseInterface(USER_WIFI, MODE_MONITOR);
 }
 
 esp_err_t wss_init(httpd_config_t *httpd) {
@@ -596,9 +2297,18 @@ esp_err_t wss_register_uri(httpd_handle_t server, void *user_ctx) {
 }
 
 esp_err_t wss_start(httpd_handle_t server) {
+    wss_server = server;
+    if (!wss_progress_listener_registered) {
+        wss_progress_listener_registered = (progress_add_listener(wss_progress_listener, NULL) == ESP_OK);
+    }
+    if (!wss_jobs_listener_registered) {
+        wss_jobs_listener_registered = (jobs_add_listener(wss_jobs_listener, NULL) == ESP_OK);
+    }
     return ESP_OK;
 }
 
 esp_err_t wss_stop(httpd_handle_t server) {
+    (void)server;
+    wss_server = NULL;
     return ESP_OK;
 }
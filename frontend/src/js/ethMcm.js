@@ -39,17 +39,14 @@ export class EthMcm extends EthernetTransport {
       txpin: txPin,
       flashkeys: flashKeys
     };
-    this.pausePing = true;
     this.mode = 'bootloader';
     return this.sendTask('bootloader', operation, params)
       .then((response) => {
         this.mode = null;
-        this.pausePing = false;
         return Promise.resolve(response);
       })
       .catch((error) => {
         this.mode = null;
-        this.pausePing = false;
         return Promise.reject(error);
       });
   }
@@ -9,26 +9,15 @@ export class EthernetTransport {
       clientTaskQueue: {},
       keepAliveTimer: null,
       isAlive: false,
-      pausePing: false,
       events: {
         error: null,
-        disconnect: null
+        disconnect: null,
+        event: null,
+        binary: null
       }
     };
   }
 
-  /** Pause or resume sending ping messages.
-   *
-   * @type {boolean}
-   */
-  get pausePing () {
-    return this.state.pausePing;
-  }
-
-  set pausePing (value) {
-    this.state.pausePing = value;
-  }
-
   /* Register an event handler to a specific event.
    *
    * @param {string} eventName - name of the event to register a handler for.
@@ -64,12 +53,19 @@ export class EthernetTransport {
         protocol = 'ws';
       }
       this.state.socket = new window.WebSocket(`${protocol}://${hostname}/ws/v1`);
+      this.state.socket.binaryType = 'arraybuffer';
 
       this.state.socket.addEventListener('open', () => {
         resolve();
       });
 
       this.state.socket.addEventListener('message', (event) => {
+        if (event.data instanceof ArrayBuffer) {
+          if (typeof (this.state.events.binary) === 'function') {
+            this.state.events.binary(event.data);
+          }
+          return;
+        }
         let data;
         try {
           data = JSON.parse(event.data);
@@ -185,7 +181,11 @@ export class EthernetTransport {
    * @param {Object} data - Parsed JSON message
    */
   onMessage (data) {
-    if (typeof (data.id) !== 'undefined' && `id_${data.id}` in this.state.clientTaskQueue) {
+    if (data.type === 'event') {
+      if (typeof (this.state.events.event) === 'function') {
+        this.state.events.event(data.payload);
+      }
+    } else if (typeof (data.id) !== 'undefined' && `id_${data.id}` in this.state.clientTaskQueue) {
       const execFuncs = this.state.clientTaskQueue[`id_${data.id}`];
       if (data.type === 'ack') {
         if (typeof (execFuncs.resolve) === 'function') {
@@ -204,7 +204,7 @@ export class EthernetTransport {
 
   /** Send a ping to the connected hardware. */
   sendPing () {
-    if (this.isConnected() && !this.state.pausePing) {
+    if (this.isConnected()) {
       if (!this.state.isAlive) {
         this.disconnect('connection lost');
       } else {
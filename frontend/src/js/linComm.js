@@ -15,7 +15,7 @@ export function lM2s (master, baudrate, enhancedCrc, frameid, payload) {
   return master.sendTask('lin', 'handle_message_on_bus', params);
 }
 
-export function lS2m (master, baudrate, enhancedCrc, frameid, datalength) {
+export function lS2m (master, baudrate, enhancedCrc, frameid, datalength, maxAge = null) {
   const params = {
     datalength,
     m2s: false,
@@ -23,74 +23,171 @@ export function lS2m (master, baudrate, enhancedCrc, frameid, datalength) {
     enhanced_crc: enhancedCrc,
     frameid
   };
+  if (maxAge !== null) {
+    params.max_age = maxAge;
+  }
   return master.sendTask('lin', 'handle_message_on_bus', params)
     .then((result) => {
       return result.data;
     });
 }
 
-export function ldDiagnostic (master, nad, baudrate, sid, payload) {
-  payload.splice(0, 0, sid);
-  const data = {
-    protocol: 'lin',
-    function: 'ld_diagnostic',
-    args: {
-      nad,
-      baudrate,
-      payload
-    }
+/** Handle an event triggered frame, collisions are resolved on the device.
+ *
+ * @param {object} master - connected master.
+ * @param {number} baudrate - baudrate to use.
+ * @param {boolean} enhancedCrc - use the enhanced checksum.
+ * @param {number} frameid - event triggered frame identifier.
+ * @param {number} datalength - data length of the associated frames, including the protected identifier.
+ * @param {Array<number>} frames - associated frame identifiers in order of priority.
+ */
+export function lEventTriggered (master, baudrate, enhancedCrc, frameid, datalength, frames) {
+  const params = {
+    baudrate,
+    enhanced_crc: enhancedCrc,
+    frameid,
+    datalength,
+    frames
   };
-  return master.sendTask(data)
+  return master.sendTask('lin', 'event_triggered', params);
+}
+
+export function linCacheRead (master, frameid = null, maxAge = null) {
+  const params = {};
+  if (frameid !== null) {
+    params.frameid = frameid;
+  }
+  if (maxAge !== null) {
+    params.max_age = maxAge;
+  }
+  return master.sendTask('lin', 'cache_read', params);
+}
+
+export function linCacheClear (master) {
+  return master.sendTask('lin', 'cache_clear');
+}
+
+export function linTimingRead (master, frameid = null) {
+  return master.sendTask('lin', 'timing_read', (frameid !== null) ? { frameid } : {});
+}
+
+export function linTimingClear (master) {
+  return master.sendTask('lin', 'timing_clear');
+}
+
+/** Upload the compiled signal database.
+ *
+ * @param {object} master - connected master.
+ * @param {Array} frames - frames as { frameid, datalength, signals: [{ name, start_bit, width,
+ *  encoding: 'raw' | 'physical', factor, offset }] }.
+ */
+export function linSignalUpload (master, frames) {
+  return master.sendTask('lin', 'signal_upload', { frames });
+}
+
+export function linSignalSubscribe (master, signals, enable = true) {
+  return master.sendTask('lin', 'signal_subscribe', { signals, enable });
+}
+
+export function linSignalRead (master, signals = null) {
+  return master.sendTask('lin', 'signal_read', (signals !== null) ? { signals } : {})
     .then((result) => {
-      const data = result.data;
-      if (data[0] === 0x7F) {
-        // slave reported an error
-        return Promise.reject(new Error(`Error 0x${data[2].toString(16)} was reported by ` +
-                                        `the device for SID 0x${data[1].toString(16)}`));
-      } else if (data[0] !== ((sid + 0x40) & 0xFF)) {
-        return Promise.reject(new Error(`An incorrect RSID was received (0x${data[0].toString(16)})`));
-      } else {
-        return Promise.resolve(data.slice(1));
-      }
+      return result.values;
+    });
+}
+
+export function linSignalStatus (master) {
+  return master.sendTask('lin', 'signal_status');
+}
+
+export function linScheduleUpload (master, table, baudrate, entries) {
+  const params = { table, baudrate, entries };
+  return master.sendTask('lin', 'schedule_upload', params);
+}
+
+export function linScheduleStart (master, table) {
+  return master.sendTask('lin', 'schedule_start', { table });
+}
+
+export function linScheduleSwitch (master, table) {
+  return master.sendTask('lin', 'schedule_switch', { table });
+}
+
+export function linSporadicUpdate (master, frameid, payload) {
+  return master.sendTask('lin', 'sporadic_update', { frameid, payload });
+}
+
+export function linScheduleStop (master) {
+  return master.sendTask('lin', 'schedule_stop');
+}
+
+export function linMonitorStart (master, baudrate) {
+  return master.sendTask('lin', 'monitor_start', { baudrate });
+}
+
+export function linMonitorStop (master) {
+  return master.sendTask('lin', 'monitor_stop');
+}
+
+export function linMonitorSubscribe (master, enable = true) {
+  return master.sendTask('lin', 'monitor_subscribe', { enable });
+}
+
+export function linMonitorStatus (master) {
+  return master.sendTask('lin', 'monitor_status');
+}
+
+/** Decode a binary monitor records message.
+ *
+ * @param {ArrayBuffer} buffer - binary message as received.
+ * @returns {Array<Object>|null} decoded records, or null for another message.
+ */
+export function decodeMonitorRecords (buffer) {
+  const view = new DataView(buffer);
+  if (buffer.byteLength < 4 || view.getUint16(0, true) !== 0x2232) {
+    return null;
+  }
+  const count = view.getUint16(2, true);
+  const records = [];
+  for (let i = 0; i < count; i++) {
+    const offset = 4 + i * 20;
+    const datalength = view.getUint8(offset + 8);
+    records.push({
+      timestamp: view.getUint32(offset, true),
+      sequence: view.getUint16(offset + 4, true),
+      pid: view.getUint8(offset + 6),
+      flags: view.getUint8(offset + 7),
+      checksum: view.getUint8(offset + 9),
+      data: Array.from(new Uint8Array(buffer, offset + 12, datalength))
     });
+  }
+  return records;
+}
+
+function checkResponse (sid, data) {
+  if (data[0] === 0x7F) {
+    // slave reported an error
+    return Promise.reject(new Error(`Error 0x${data[2].toString(16)} was reported by ` +
+                                    `the device for SID 0x${data[1].toString(16)}`));
+  } else if (data[0] !== ((sid + 0x40) & 0xFF)) {
+    return Promise.reject(new Error(`An incorrect RSID was received (0x${data[0].toString(16)})`));
+  } else {
+    return Promise.resolve(data.slice(1));
+  }
+}
+
+export function ldDiagnostic (master, nad, baudrate, sid, payload) {
+  return master.sendTask('lin', 'ld_diagnostic', { nad, baudrate, payload: [sid, ...payload] })
+    .then((result) => checkResponse(sid, result.data));
 }
 
 export function ldSendMessage (master, nad, baudrate, sid, payload) {
-  payload.splice(0, 0, sid);
-  const data = {
-    protocol: 'lin',
-    function: 'ld_send_message',
-    args: {
-      nad,
-      baudrate,
-      payload
-    }
-  };
-  return master.sendTask(data);
+  return master.sendTask('lin', 'ld_send_message', { nad, baudrate, payload: [sid, ...payload] });
 }
 
 export function ldReceiveMessage (master, nad, baudrate, sid) {
-  const data = {
-    protocol: 'lin',
-    function: 'ld_receive_message',
-    args: {
-      nad,
-      baudrate
-    }
-  };
-  return master.sendTask(data)
-    .then((result) => {
-      const data = result.data;
-      if (data[0] === 0x7F) {
-        // slave reported an error
-        return Promise.reject(new Error(`Error 0x${data[2].toString(16)} was reported by ` +
-                                        `the device for SID 0x${data[1].toString(16)}`));
-      } else if (data[0] !== ((sid + 0x40) & 0xFF)) {
-        return Promise.reject(new Error(`An incorrect RSID was received (0x${data[0].toString(16)})`));
-      } else {
-        return Promise.resolve(data.slice(1));
-      }
-    });
+  return master.sendTask('lin', 'ld_receive_message', { nad, baudrate })
+    .then((result) => checkResponse(sid, result.data));
 }
 
 export function readById (master, nad, baudrate, identifier, supplierId = 0x7FFF, functionId = 0xFFFF) {
@@ -58,6 +58,60 @@ export const LinScript = function () {
     return vars.script[number];
   };
 
+  /* slot time reserved after a wake up pulse in microseconds */
+  const wakeUpSlotTime = 100000;
+
+  /* Build the schedule table entries for the device.
+   *
+   * Each frame gets a slot of its maximum frame time, the last frame of a sequence is extended
+   * with the delay in between sequences.
+   *
+   * @param {number} delay - delay after each sequence in milliseconds.
+   * @returns {Array<Object>} schedule table entries.
+   */
+  this.getScheduleEntries = function (delay) {
+    const entries = [];
+    vars.script.forEach(function (sequence) {
+      sequence.frames.forEach(function (frame, index) {
+        let entry;
+        switch (frame.type) {
+          case frameTypeWakeUp:
+            entry = { type: 'wakeup', slot_time: wakeUpSlotTime };
+            break;
+          case frameTypeS2M:
+            entry = {
+              type: 's2m',
+              frameid: frame.frameId,
+              enhanced_crc: frame.enhancedCrc,
+              datalength: frame.datalength,
+              slot_time: frameSlotTime(frame.datalength)
+            };
+            break;
+          case frameTypeM2S:
+            entry = {
+              type: 'm2s',
+              frameid: frame.frameId,
+              enhanced_crc: frame.enhancedCrc,
+              payload: frame.payload,
+              slot_time: frameSlotTime(frame.payload.length)
+            };
+            break;
+        }
+        if (index === sequence.frames.length - 1) {
+          entry.slot_time += Math.round(delay * 1000);
+        }
+        entries.push(entry);
+      });
+    });
+    return entries;
+  };
+
+  /* Maximum frame time (nominal time + 40%) rounded up to a millisecond, in microseconds. */
+  function frameSlotTime (datalength) {
+    const nominal = (34 + 10 * (datalength + 1)) * 1000000 / vars.baudrate;
+    return Math.ceil(nominal * 1.4 / 1000) * 1000;
+  }
+
   function parseLinScript (filecontent) {
     let result = false;
     filecontent.split('\n').forEach(function (content) {
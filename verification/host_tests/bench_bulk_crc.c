@@ -0,0 +1,81 @@
+/**
+ * @file
+ * @brief Bulk message crc host benchmark.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @details Micro benchmark of the slice-by-8 crc engine against the bit-wise reference routine
+ * (host stand-in of crc_calc16bitCrc) for 64 B, 512 B and 4 KB frames.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "mlx_crc.h"
+#include "usb_vendor_bulk_crc.h"
+#include "usb_vendor_bulk_parser.h"
+
+#include "test_helpers.h"
+
+/** number of bytes to process per measurement */
+#define BYTES_PER_RUN (32u * 1024u * 1024u)
+
+static uint8_t data[4096];
+static volatile uint16_t sink;
+
+typedef uint16_t (* crc_routine_t)(const uint8_t *data, size_t len);
+
+static uint16_t reference_routine(const uint8_t *buf, size_t len) {
+    return crc_calc16bitCrc(buf, len, BULK_MSG_CRC_SEED);
+}
+
+static uint16_t engine_routine(const uint8_t *buf, size_t len) {
+    return usb_vendor_bulk_crc_update(BULK_MSG_CRC_SEED, buf, len);
+}
+
+static double measure(crc_routine_t routine, size_t frame_len) {
+    uint32_t nr_of_frames = BYTES_PER_RUN / frame_len;
+    uint16_t acc = 0u;
+    double start = test_now();
+    for (uint32_t i = 0; i < nr_of_frames; i++) {
+        data[0] = (uint8_t)i;
+        acc ^= routine(data, frame_len);
+    }
+    double elapsed = test_now() - start;
+    sink = acc;
+    return ((double)nr_of_frames * (double)frame_len) / elapsed;
+}
+
+int main(void) {
+    static const size_t frame_lens[] = {64u, 512u, 4096u};
+    uint32_t seed = 5u;
+    int retval = 0;
+
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)test_rand(&seed);
+    }
+    (void)usb_vendor_bulk_crc_init();
+
+    printf("%-8s %14s %14s %8s\n", "frame", "reference", "slice-by-8", "speedup");
+    for (size_t i = 0; i < (sizeof(frame_lens) / sizeof(frame_lens[0])); i++) {
+        double ref = measure(reference_routine, frame_lens[i]);
+        double eng = measure(engine_routine, frame_lens[i]);
+        printf("%-8zu %9.1f MB/s %9.1f MB/s %7.1fx\n", frame_lens[i], ref / 1e6, eng / 1e6, eng / ref);
+        if (engine_routine(data, frame_lens[i]) != reference_routine(data, frame_lens[i])) {
+            fprintf(stderr, "crc mismatch for %zu byte frames\n", frame_lens[i]);
+            retval = 1;
+        }
+    }
+
+    return retval;
+}
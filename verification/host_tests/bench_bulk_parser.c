@@ -0,0 +1,95 @@
+/**
+ * @file
+ * @brief Bulk frame parser host benchmark.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @details Throughput benchmark of the bulk frame parser with a stream of small LIN commands
+ * delivered in full-speed USB packets (64 bytes).
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "usb_vendor_bulk_parser.h"
+
+#include "test_helpers.h"
+
+/** full-speed USB bulk payload rate (19 packets of 64 bytes per 1 ms frame) */
+#define FULL_SPEED_BULK_BYTES_PER_S (19.0 * 64.0 * 1000.0)
+
+#define NR_OF_FRAMES 20000u
+#define LIN_MESSAGE_LEN 14u
+#define USB_PACKET_LEN 64u
+#define ITERATIONS 20u
+
+static uint32_t frames_seen;
+
+static void count_frame(void *ctx, const bulk_msg_header_t *header, const uint8_t *payload, uint16_t payload_len) {
+    (void)ctx;
+    (void)header;
+    (void)payload;
+    (void)payload_len;
+    frames_seen++;
+}
+
+int main(void) {
+    static bulk_parser_t parser;
+    size_t frame_len = sizeof(bulk_msg_header_t) + LIN_MESSAGE_LEN + BULK_MSG_CRC_LEN;
+    size_t stream_len = frame_len * NR_OF_FRAMES;
+    uint8_t *stream = malloc(stream_len);
+    if (stream == NULL) {
+        return 1;
+    }
+
+    uint32_t seed = 42u;
+    for (uint32_t i = 0; i < NR_OF_FRAMES; i++) {
+        uint8_t payload[LIN_MESSAGE_LEN];
+        for (size_t j = 0; j < sizeof(payload); j++) {
+            payload[j] = (uint8_t)test_rand(&seed);
+        }
+        (void)test_build_frame(&stream[i * frame_len], 0x2201, i, payload, sizeof(payload));
+    }
+
+    usb_vendor_bulk_parser_init(&parser, count_frame, NULL);
+    frames_seen = 0;
+    double start = test_now();
+    for (uint32_t it = 0; it < ITERATIONS; it++) {
+        for (size_t pos = 0; pos < stream_len; pos += USB_PACKET_LEN) {
+            size_t chunk = ((stream_len - pos) < USB_PACKET_LEN) ? (stream_len - pos) : USB_PACKET_LEN;
+            usb_vendor_bulk_parser_feed(&parser, &stream[pos], chunk);
+        }
+    }
+    double elapsed = test_now() - start;
+    free(stream);
+
+    double bytes_per_s = ((double)stream_len * ITERATIONS) / elapsed;
+    double frames_per_s = (double)frames_seen / elapsed;
+    printf("bulk parser: %u frames of %zu bytes in %u byte packets\n",
+           NR_OF_FRAMES * ITERATIONS, frame_len, USB_PACKET_LEN);
+    printf("bulk parser: %.1f MB/s, %.0f frames/s (%.1fx full-speed USB)\n",
+           bytes_per_s / 1e6, frames_per_s, bytes_per_s / FULL_SPEED_BULK_BYTES_PER_S);
+    printf("bulk parser: %u frames copied, %u crc errors\n",
+           parser.stats.frames_copied, parser.stats.crc_errors);
+
+    if (frames_seen != (NR_OF_FRAMES * ITERATIONS)) {
+        fprintf(stderr, "expected %u frames but parsed %u\n", NR_OF_FRAMES * ITERATIONS, frames_seen);
+        return 1;
+    }
+    if (bytes_per_s < FULL_SPEED_BULK_BYTES_PER_S) {
+        fprintf(stderr, "parser does not sustain full-speed USB\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,176 @@
+/**
+ * @file
+ * @brief Intel HEX stream throughput benchmark.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @details Parses a 1 MB Intel HEX file into a firmware image, fed in USB sized chunks, with the
+ * former line splitting of the USB hex transfer handler (scan of the whole buffer per chunk, strlen
+ * per line, move of the leftover) and with the Intel HEX stream.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fw_image_page.h"
+#include "hex_stream.h"
+
+#include "test_helpers.h"
+
+/** size of the Intel HEX file */
+#define HEX_FILE_LEN (1024u * 1024u)
+
+/** number of data bytes per record */
+#define HEX_RECORD_DATA 32u
+
+/** size of the received chunks */
+#define CHUNK_LEN 512u
+
+/** number of times the file is parsed per measurement */
+#define RUNS 8u
+
+static char hex_file[HEX_FILE_LEN + 128u];
+static size_t hex_file_len;
+static char legacy_buffer[(2u * CHUNK_LEN) + HEXSTREAM_MAX_LINE_LEN + 1u];
+
+typedef bool (* parse_routine_t)(fwimg_t *image);
+
+static size_t append_record(size_t pos, uint8_t type, uint16_t address, const uint8_t *data, uint8_t count) {
+    uint8_t sum = (uint8_t)(count + (address >> 8) + address + type);
+
+    pos += (size_t)sprintf(&hex_file[pos], ":%02X%04X%02X", count, address, type);
+    for (uint8_t i = 0u; i < count; i++) {
+        pos += (size_t)sprintf(&hex_file[pos], "%02X", data[i]);
+        sum += data[i];
+    }
+    pos += (size_t)sprintf(&hex_file[pos], "%02X\r\n", (uint8_t)(0u - sum));
+
+    return pos;
+}
+
+static void build_hex_file(void) {
+    uint8_t data[HEX_RECORD_DATA];
+    uint32_t seed = 3u;
+    uint32_t address = 0u;
+    size_t pos = 0u;
+
+    while (pos < (HEX_FILE_LEN - 100u)) {
+        if ((address & 0xFFFFu) == 0u) {
+            uint8_t ext[2] = {(uint8_t)(address >> 24), (uint8_t)(address >> 16)};
+            pos = append_record(pos, 0x04u, 0u, ext, 2u);
+        }
+        for (size_t i = 0u; i < sizeof(data); i++) {
+            data[i] = (uint8_t)test_rand(&seed);
+        }
+        pos = append_record(pos, 0x00u, (uint16_t)address, data, HEX_RECORD_DATA);
+        address += HEX_RECORD_DATA;
+    }
+    pos = append_record(pos, 0x01u, 0u, NULL, 0u);
+    hex_file_len = pos;
+}
+
+/** Former line splitting of usb_vendor_hex_transfer_handler */
+static bool legacy_routine(fwimg_t *image) {
+    int32_t buffer_wr_ptr = 0;
+    bool retval = true;
+
+    for (size_t chunk = 0u; chunk < hex_file_len; chunk += CHUNK_LEN) {
+        size_t item_size = ((hex_file_len - chunk) < CHUNK_LEN) ? (hex_file_len - chunk) : CHUNK_LEN;
+        memcpy(&legacy_buffer[buffer_wr_ptr], &hex_file[chunk], item_size);
+        buffer_wr_ptr += (int32_t)item_size;
+        legacy_buffer[buffer_wr_ptr] = 0;
+
+        for (int32_t temp_ptr = 0; temp_ptr < buffer_wr_ptr; temp_ptr++) {
+            if ((legacy_buffer[temp_ptr] == '\n') || (legacy_buffer[temp_ptr] == '\r')) {
+                legacy_buffer[temp_ptr] = 0;
+            }
+        }
+
+        int32_t buffer_rd_ptr = 0;
+        while (buffer_rd_ptr < buffer_wr_ptr) {
+            while ((legacy_buffer[buffer_rd_ptr] == '\0') && (buffer_rd_ptr < buffer_wr_ptr)) {
+                buffer_rd_ptr++;
+            }
+            size_t line_len = strlen(&legacy_buffer[buffer_rd_ptr]);
+            if (fwimg_write_hex_record(image, &legacy_buffer[buffer_rd_ptr], line_len)) {
+                buffer_rd_ptr += (int32_t)line_len;
+            } else {
+                break;
+            }
+        }
+        buffer_wr_ptr -= buffer_rd_ptr;
+        memmove(&legacy_buffer[0], &legacy_buffer[buffer_rd_ptr], (size_t)buffer_wr_ptr);
+        legacy_buffer[buffer_wr_ptr] = 0;
+    }
+    retval = (buffer_wr_ptr == 0);
+
+    return retval;
+}
+
+static bool stream_line(const char *line, size_t length, void *ctx) {
+    return fwimg_write_hex_record((fwimg_t *)ctx, line, length);
+}
+
+static bool stream_routine(fwimg_t *image) {
+    hexstream_t stream;
+
+    hexstream_init(&stream);
+    for (size_t chunk = 0u; chunk < hex_file_len; chunk += CHUNK_LEN) {
+        size_t item_size = ((hex_file_len - chunk) < CHUNK_LEN) ? (hex_file_len - chunk) : CHUNK_LEN;
+        (void)hexstream_feed(&stream, (const uint8_t *)&hex_file[chunk], item_size, stream_line, image);
+    }
+
+    return hexstream_finish(&stream, stream_line, image) == HEXSTREAM_OK;
+}
+
+static double measure(parse_routine_t routine, fwimg_t *image, bool *valid) {
+    double start = test_now();
+    *valid = true;
+    for (uint32_t run = 0u; run < RUNS; run++) {
+        fwimg_free(image);
+        *valid = routine(image) && *valid;
+    }
+    double elapsed = test_now() - start;
+    return ((double)RUNS * (double)hex_file_len) / elapsed;
+}
+
+int main(void) {
+    fwimg_t legacy_image;
+    fwimg_t stream_image;
+    bool legacy_valid;
+    bool stream_valid;
+    int retval = 0;
+
+    build_hex_file();
+    fwimg_init(&legacy_image, 128u, 1024u * 1024u, realloc);
+    fwimg_init(&stream_image, 128u, 1024u * 1024u, realloc);
+
+    double legacy = measure(legacy_routine, &legacy_image, &legacy_valid);
+    double streamed = measure(stream_routine, &stream_image, &stream_valid);
+
+    printf("%-8s %14s %14s %8s\n", "file", "legacy", "stream", "speedup");
+    printf("%-8zu %9.1f MB/s %9.1f MB/s %7.1fx\n", hex_file_len, legacy / 1e6, streamed / 1e6, streamed / legacy);
+
+    if (!legacy_valid || !stream_valid ||
+        (legacy_image.nr_of_pages != stream_image.nr_of_pages) ||
+        (memcmp(legacy_image.data, stream_image.data, (size_t)stream_image.nr_of_pages * 128u) != 0)) {
+        fprintf(stderr, "images differ\n");
+        retval = 1;
+    }
+    fwimg_free(&legacy_image);
+    fwimg_free(&stream_image);
+
+    return retval;
+}
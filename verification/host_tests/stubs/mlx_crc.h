@@ -0,0 +1,36 @@
+/**
+ * @file
+ * @brief Host stand-in for the mlx_crc component.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @details Bit-wise CRC-16/CCITT (polynomial 0x1021, MSB first, no final xor) as used by the
+ * bulk protocol, such that firmware modules depending on mlx_crc can be built on the host.
+ */
+
+#ifndef MLX_CRC_H_
+    #define MLX_CRC_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** Calculate the 16 bit crc over a buffer
+ *
+ * @param[in]  data  data to calculate the crc over.
+ * @param[in]  length  length of data.
+ * @param[in]  seed  initial crc value (or crc of the preceding data).
+ * @returns  calculated crc.
+ */
+uint16_t crc_calc16bitCrc(const uint8_t *data, size_t length, uint16_t seed);
+
+#endif /* MLX_CRC_H_ */
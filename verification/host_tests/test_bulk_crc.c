@@ -0,0 +1,95 @@
+/**
+ * @file
+ * @brief Bulk message crc host tests.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @details Host tests comparing the slice-by-8 crc engine with the reference crc routine.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "mlx_crc.h"
+#include "usb_vendor_bulk_crc.h"
+#include "usb_vendor_bulk_parser.h"
+
+#include "test_helpers.h"
+
+static uint8_t data[8192];
+
+static void fill_data(uint32_t seed) {
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)test_rand(&seed);
+    }
+}
+
+static void test_tables_in_use(void) {
+    TEST_ASSERT(usb_vendor_bulk_crc_init());
+}
+
+static void test_check_value(void) {
+    /* CRC-16/AUG-CCITT check value */
+    const uint8_t check[] = "123456789";
+    TEST_ASSERT_EQUAL(0xE5CC, usb_vendor_bulk_crc_update(BULK_MSG_CRC_SEED, check, 9u));
+}
+
+static void test_empty_chunk_keeps_crc(void) {
+    TEST_ASSERT_EQUAL(0x1234, usb_vendor_bulk_crc_update(0x1234, data, 0u));
+}
+
+static void test_matches_reference_for_all_lengths(void) {
+    fill_data(1u);
+    for (size_t len = 0; len <= 600u; len++) {
+        TEST_ASSERT_EQUAL(crc_calc16bitCrc(data, len, BULK_MSG_CRC_SEED),
+                          usb_vendor_bulk_crc_update(BULK_MSG_CRC_SEED, data, len));
+    }
+}
+
+static void test_matches_reference_for_all_offsets(void) {
+    fill_data(2u);
+    for (size_t offset = 0; offset < 16u; offset++) {
+        TEST_ASSERT_EQUAL(crc_calc16bitCrc(&data[offset], 4096u, 0xFFFFu),
+                          usb_vendor_bulk_crc_update(0xFFFFu, &data[offset], 4096u));
+    }
+}
+
+static void test_chunked_equals_whole(void) {
+    uint32_t seed = 3u;
+    fill_data(4u);
+    uint16_t expected = crc_calc16bitCrc(data, sizeof(data), BULK_MSG_CRC_SEED);
+    for (int run = 0; run < 50; run++) {
+        uint16_t crc = BULK_MSG_CRC_SEED;
+        size_t pos = 0u;
+        while (pos < sizeof(data)) {
+            size_t chunk = 1u + (test_rand(&seed) % 200u);
+            if (chunk > (sizeof(data) - pos)) {
+                chunk = sizeof(data) - pos;
+            }
+            crc = usb_vendor_bulk_crc_update(crc, &data[pos], chunk);
+            pos += chunk;
+        }
+        TEST_ASSERT_EQUAL(expected, crc);
+    }
+}
+
+int main(void) {
+    RUN_TEST(test_tables_in_use);
+    RUN_TEST(test_check_value);
+    RUN_TEST(test_empty_chunk_keeps_crc);
+    RUN_TEST(test_matches_reference_for_all_lengths);
+    RUN_TEST(test_matches_reference_for_all_offsets);
+    RUN_TEST(test_chunked_equals_whole);
+
+    return (test_failures == 0) ? 0 : 1;
+}
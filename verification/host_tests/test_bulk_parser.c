@@ -0,0 +1,300 @@
+/**
+ * @file
+ * @brief Bulk frame parser host tests.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @details Host tests for the streaming frame parser of the vendor bulk command protocol.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "usb_vendor_bulk_parser.h"
+
+#include "test_helpers.h"
+
+#define MAX_RECORDED 512
+
+typedef struct recorded_frame_s {
+    uint16_t command;
+    uint32_t tag;
+    uint16_t payload_len;
+    uint32_t payload_sum;
+    int aligned;
+} recorded_frame_t;
+
+static recorded_frame_t recorded[MAX_RECORDED];
+static size_t nr_recorded;
+
+static bulk_parser_t parser;
+static uint8_t stream[256 * 1024] __attribute__((aligned(4)));
+static uint8_t scratch[BULK_MSG_MAX_LEN + 64] __attribute__((aligned(4)));
+
+static void record_frame(void *ctx, const bulk_msg_header_t *header, const uint8_t *payload, uint16_t payload_len) {
+    (void)ctx;
+    if (nr_recorded < MAX_RECORDED) {
+        uint32_t sum = 0u;
+        for (uint16_t i = 0; i < payload_len; i++) {
+            sum = (sum * 31u) + payload[i];
+        }
+        recorded[nr_recorded].command = header->command;
+        recorded[nr_recorded].tag = header->tag;
+        recorded[nr_recorded].payload_len = payload_len;
+        recorded[nr_recorded].payload_sum = sum;
+        recorded[nr_recorded].aligned = (((uintptr_t)payload & 0x3u) == 0u);
+    }
+    nr_recorded++;
+}
+
+static void setup(void) {
+    nr_recorded = 0;
+    memset(recorded, 0, sizeof(recorded));
+    usb_vendor_bulk_parser_init(&parser, record_frame, NULL);
+}
+
+static uint32_t payload_sum(const uint8_t *payload, uint16_t len) {
+    uint32_t sum = 0u;
+    for (uint16_t i = 0; i < len; i++) {
+        sum = (sum * 31u) + payload[i];
+    }
+    return sum;
+}
+
+static void fill_payload(uint8_t *payload, uint16_t len, uint32_t seed) {
+    for (uint16_t i = 0; i < len; i++) {
+        payload[i] = (uint8_t)test_rand(&seed);
+    }
+}
+
+static void test_single_frame(void) {
+    uint8_t payload[14];
+    fill_payload(payload, sizeof(payload), 1u);
+    setup();
+    size_t len = test_build_frame(stream, 0x2201, 7u, payload, sizeof(payload));
+    usb_vendor_bulk_parser_feed(&parser, stream, len);
+    TEST_ASSERT_EQUAL(1, nr_recorded);
+    TEST_ASSERT_EQUAL(0x2201, recorded[0].command);
+    TEST_ASSERT_EQUAL(7, recorded[0].tag);
+    TEST_ASSERT_EQUAL(sizeof(payload), recorded[0].payload_len);
+    TEST_ASSERT_EQUAL(payload_sum(payload, sizeof(payload)), recorded[0].payload_sum);
+    TEST_ASSERT_EQUAL(0, parser.stats.frames_copied);
+}
+
+static void test_empty_payload(void) {
+    setup();
+    size_t len = test_build_frame(stream, 0x2200, 0u, NULL, 0u);
+    usb_vendor_bulk_parser_feed(&parser, stream, len);
+    TEST_ASSERT_EQUAL(1, nr_recorded);
+    TEST_ASSERT_EQUAL(0, recorded[0].payload_len);
+}
+
+static void test_unaligned_payload_is_aligned(void) {
+    uint8_t payload[14];
+    fill_payload(payload, sizeof(payload), 2u);
+    setup();
+    size_t len = test_build_frame(&stream[1], 0x2201, 0u, payload, sizeof(payload));
+    stream[0] = 0x00;
+    usb_vendor_bulk_parser_feed(&parser, stream, len + 1u);
+    TEST_ASSERT_EQUAL(1, nr_recorded);
+    TEST_ASSERT(recorded[0].aligned);
+    TEST_ASSERT_EQUAL(payload_sum(payload, sizeof(payload)), recorded[0].payload_sum);
+    TEST_ASSERT_EQUAL(1, parser.stats.skipped_bytes);
+}
+
+static void test_split_at_every_position(void) {
+    uint8_t payload[100];
+    fill_payload(payload, sizeof(payload), 3u);
+    size_t len = test_build_frame(stream, 0x3300, 0u, payload, sizeof(payload));
+    for (size_t split = 1; split < len; split++) {
+        setup();
+        memcpy(scratch, stream, len);
+        usb_vendor_bulk_parser_feed(&parser, scratch, split);
+        TEST_ASSERT_EQUAL(0, nr_recorded);
+        usb_vendor_bulk_parser_feed(&parser, &scratch[split], len - split);
+        TEST_ASSERT_EQUAL(1, nr_recorded);
+        TEST_ASSERT_EQUAL(payload_sum(payload, sizeof(payload)), recorded[0].payload_sum);
+        TEST_ASSERT(recorded[0].aligned);
+    }
+}
+
+static void test_byte_by_byte(void) {
+    uint8_t payload[BULK_MSG_MAX_PAYLOAD_LEN];
+    fill_payload(payload, sizeof(payload), 4u);
+    setup();
+    size_t len = test_build_frame(stream, 0x3001, 0u, payload, sizeof(payload));
+    for (size_t i = 0; i < len; i++) {
+        usb_vendor_bulk_parser_feed(&parser, &stream[i], 1u);
+    }
+    TEST_ASSERT_EQUAL(1, nr_recorded);
+    TEST_ASSERT_EQUAL(BULK_MSG_MAX_PAYLOAD_LEN, recorded[0].payload_len);
+    TEST_ASSERT_EQUAL(payload_sum(payload, sizeof(payload)), recorded[0].payload_sum);
+}
+
+static void test_garbage_and_false_sync(void) {
+    static const uint8_t garbage[] = {0x01, 0x55, 0xAA, 0x55, 0x00, 0x55, 0x55, 0xAA, 0x55, 0x55, 0xAA};
+    uint8_t payload[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    setup();
+    memcpy(stream, garbage, sizeof(garbage));
+    size_t len = sizeof(garbage) + test_build_frame(&stream[sizeof(garbage)], 0x2201, 0u, payload, sizeof(payload));
+    usb_vendor_bulk_parser_feed(&parser, stream, len);
+    TEST_ASSERT_EQUAL(1, nr_recorded);
+    TEST_ASSERT_EQUAL(sizeof(garbage), parser.stats.skipped_bytes);
+
+    /* same stream but fed in small pieces to exercise the buffered path */
+    setup();
+    for (size_t i = 0; i < len; i += 3) {
+        usb_vendor_bulk_parser_feed(&parser, &stream[i], ((len - i) < 3) ? (len - i) : 3);
+    }
+    TEST_ASSERT_EQUAL(1, nr_recorded);
+    TEST_ASSERT_EQUAL(sizeof(garbage), parser.stats.skipped_bytes);
+}
+
+static void test_crc_error_recovers(void) {
+    uint8_t payload[20];
+    fill_payload(payload, sizeof(payload), 5u);
+    setup();
+    size_t len = test_build_frame(stream, 0x2201, 0u, payload, sizeof(payload));
+    stream[len - 1u] ^= 0xFFu;
+    len += test_build_frame(&stream[len], 0x2202, 0u, payload, sizeof(payload));
+    usb_vendor_bulk_parser_feed(&parser, stream, len);
+    TEST_ASSERT_EQUAL(1, nr_recorded);
+    TEST_ASSERT_EQUAL(0x2202, recorded[0].command);
+    TEST_ASSERT_EQUAL(1, parser.stats.crc_errors);
+
+    setup();
+    for (size_t i = 0; i < len; i += 5) {
+        usb_vendor_bulk_parser_feed(&parser, &stream[i], ((len - i) < 5) ? (len - i) : 5);
+    }
+    TEST_ASSERT_EQUAL(1, nr_recorded);
+    TEST_ASSERT_EQUAL(0x2202, recorded[0].command);
+    TEST_ASSERT_EQUAL(1, parser.stats.crc_errors);
+}
+
+static void test_invalid_length_recovers(void) {
+    uint8_t payload[4] = {0xDE, 0xAD, 0xBE, 0xEF};
+    setup();
+    bulk_msg_header_t bad = {.header = USB_PACKET_HEADER, .length = 5u, .command = 0x1234, .tag = 0u};
+    memcpy(stream, &bad, sizeof(bad));
+    size_t len = sizeof(bad);
+    len += test_build_frame(&stream[len], 0x2201, 0u, payload, sizeof(payload));
+    usb_vendor_bulk_parser_feed(&parser, stream, len);
+    TEST_ASSERT_EQUAL(1, nr_recorded);
+    TEST_ASSERT_EQUAL(0x2201, recorded[0].command);
+    TEST_ASSERT_EQUAL(1, parser.stats.length_errors);
+
+    setup();
+    for (size_t i = 0; i < len; i++) {
+        usb_vendor_bulk_parser_feed(&parser, &stream[i], 1u);
+    }
+    TEST_ASSERT_EQUAL(1, nr_recorded);
+    TEST_ASSERT_EQUAL(0x2201, recorded[0].command);
+}
+
+static void test_frame_nested_in_corrupted_frame(void) {
+    /* a corrupted frame which carries a complete valid frame in its payload */
+    uint8_t inner[40];
+    uint8_t inner_payload[10];
+    fill_payload(inner_payload, sizeof(inner_payload), 6u);
+    size_t inner_len = test_build_frame(inner, 0x2203, 0u, inner_payload, sizeof(inner_payload));
+    uint8_t outer_payload[64];
+    memset(outer_payload, 0x11, sizeof(outer_payload));
+    memcpy(&outer_payload[8], inner, inner_len);
+    size_t len = test_build_frame(stream, 0x2201, 0u, outer_payload, sizeof(outer_payload));
+    stream[len - 2u] ^= 0x5Au;
+
+    setup();
+    usb_vendor_bulk_parser_feed(&parser, stream, len);
+    TEST_ASSERT_EQUAL(1, nr_recorded);
+    TEST_ASSERT_EQUAL(0x2203, recorded[0].command);
+
+    setup();
+    for (size_t i = 0; i < len; i += 7) {
+        usb_vendor_bulk_parser_feed(&parser, &stream[i], ((len - i) < 7) ? (len - i) : 7);
+    }
+    TEST_ASSERT_EQUAL(1, nr_recorded);
+    TEST_ASSERT_EQUAL(0x2203, recorded[0].command);
+}
+
+static void test_random_segmentation(void) {
+    uint32_t seed = 0x1234u;
+    uint16_t lengths[MAX_RECORDED];
+    uint32_t sums[MAX_RECORDED];
+    size_t nr_frames = 0;
+    size_t len = 0;
+    uint8_t payload[BULK_MSG_MAX_PAYLOAD_LEN];
+
+    while (nr_frames < 300) {
+        uint16_t payload_len = (uint16_t)(test_rand(&seed) % 600u);
+        if ((nr_frames % 50u) == 0u) {
+            payload_len = BULK_MSG_MAX_PAYLOAD_LEN;
+        }
+        fill_payload(payload, payload_len, seed);
+        lengths[nr_frames] = payload_len;
+        sums[nr_frames] = payload_sum(payload, payload_len);
+        len += test_build_frame(&stream[len], (uint16_t)nr_frames, (uint32_t)nr_frames, payload, payload_len);
+        nr_frames++;
+    }
+
+    setup();
+    size_t pos = 0;
+    while (pos < len) {
+        /* mimic usb packets and ring buffer wrap around */
+        size_t chunk = 1u + (test_rand(&seed) % 700u);
+        if (chunk > (len - pos)) {
+            chunk = len - pos;
+        }
+        usb_vendor_bulk_parser_feed(&parser, &stream[pos], chunk);
+        pos += chunk;
+    }
+
+    TEST_ASSERT_EQUAL(nr_frames, nr_recorded);
+    for (size_t i = 0; (i < nr_frames) && (i < nr_recorded); i++) {
+        TEST_ASSERT_EQUAL(i, recorded[i].command);
+        TEST_ASSERT_EQUAL(i, recorded[i].tag);
+        TEST_ASSERT_EQUAL(lengths[i], recorded[i].payload_len);
+        TEST_ASSERT_EQUAL(sums[i], recorded[i].payload_sum);
+        TEST_ASSERT(recorded[i].aligned);
+    }
+    TEST_ASSERT_EQUAL(0, parser.stats.crc_errors);
+    TEST_ASSERT_EQUAL(0, parser.stats.skipped_bytes);
+}
+
+static void test_reset_drops_partial_frame(void) {
+    uint8_t payload[30];
+    fill_payload(payload, sizeof(payload), 7u);
+    setup();
+    size_t len = test_build_frame(stream, 0x2201, 0u, payload, sizeof(payload));
+    usb_vendor_bulk_parser_feed(&parser, stream, len / 2u);
+    usb_vendor_bulk_parser_reset(&parser);
+    len = test_build_frame(stream, 0x2202, 0u, payload, sizeof(payload));
+    usb_vendor_bulk_parser_feed(&parser, stream, len);
+    TEST_ASSERT_EQUAL(1, nr_recorded);
+    TEST_ASSERT_EQUAL(0x2202, recorded[0].command);
+}
+
+int main(void) {
+    RUN_TEST(test_single_frame);
+    RUN_TEST(test_empty_payload);
+    RUN_TEST(test_unaligned_payload_is_aligned);
+    RUN_TEST(test_split_at_every_position);
+    RUN_TEST(test_byte_by_byte);
+    RUN_TEST(test_garbage_and_false_sync);
+    RUN_TEST(test_crc_error_recovers);
+    RUN_TEST(test_invalid_length_recovers);
+    RUN_TEST(test_frame_nested_in_corrupted_frame);
+    RUN_TEST(test_random_segmentation);
+    RUN_TEST(test_reset_drops_partial_frame);
+
+    return (test_failures == 0) ? 0 : 1;
+}
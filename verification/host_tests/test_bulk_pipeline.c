@@ -0,0 +1,263 @@
+/**
+ * @file
+ * @brief Tagged bulk command pipelining host tests.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @details Host tests in which a host keeps a window of tagged commands outstanding towards a
+ * device model. The device model handles the commands in the way the bulk interface does (parse,
+ * handle in order, encode the response with the tag of the command). The tests check that every
+ * response arrives in order and carries the tag of the command it answers.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "usb_vendor_bulk_parser.h"
+
+#include "test_helpers.h"
+
+#define MCM_BULK_MSG_ERROR_REPORT 0xFFFF
+
+#define CMD_ECHO 0x2200
+#define CMD_INVERT 0x2201
+#define CMD_UNKNOWN 0x2255
+
+#define USB_PACKET_LEN 64u
+#define MAX_WINDOW 32u
+#define MAX_PAYLOAD 300u
+
+typedef struct pending_cmd_s {
+    uint32_t tag;
+    uint16_t command;
+    uint16_t payload_len;
+    uint8_t payload[MAX_PAYLOAD];
+} pending_cmd_t;
+
+/* device model */
+static bulk_parser_t device_parser;
+static uint8_t device_tx[1024 * 1024] __attribute__((aligned(4)));
+static size_t device_tx_len;
+static uint8_t response[BULK_MSG_MAX_LEN] __attribute__((aligned(4)));
+
+/* host model */
+static bulk_parser_t host_parser;
+static pending_cmd_t pending[MAX_WINDOW];
+static size_t pending_rd;
+static size_t pending_count;
+static uint32_t nr_responses;
+static uint32_t nr_mismatches;
+static uint8_t host_tx[BULK_MSG_MAX_LEN] __attribute__((aligned(4)));
+
+static void device_write_response(uint32_t tag, uint16_t command, const uint8_t *data, uint16_t datalen) {
+    uint16_t len = usb_vendor_bulk_parser_encode(response, tag, command, data, datalen);
+    memcpy(&device_tx[device_tx_len], response, len);
+    device_tx_len += len;
+}
+
+static void device_frame(void *ctx, const bulk_msg_header_t *header, const uint8_t *payload, uint16_t payload_len) {
+    (void)ctx;
+    uint8_t data[MAX_PAYLOAD];
+    switch (header->command) {
+        case CMD_ECHO:
+            device_write_response(header->tag, header->command, payload, payload_len);
+            break;
+
+        case CMD_INVERT:
+            for (uint16_t i = 0; i < payload_len; i++) {
+                data[i] = (uint8_t)~payload[i];
+            }
+            device_write_response(header->tag, header->command, data, payload_len);
+            break;
+
+        default:
+            data[0] = (uint8_t)(header->command & 0xFFu);
+            data[1] = (uint8_t)(header->command >> 8);
+            data[2] = 0x01u;
+            data[3] = 0x00u;
+            device_write_response(header->tag, MCM_BULK_MSG_ERROR_REPORT, data, 4u);
+            break;
+    }
+}
+
+static void host_frame(void *ctx, const bulk_msg_header_t *header, const uint8_t *payload, uint16_t payload_len) {
+    (void)ctx;
+    nr_responses++;
+    if (pending_count == 0u) {
+        nr_mismatches++;
+        return;
+    }
+    pending_cmd_t *cmd = &pending[pending_rd];
+    bool match = (header->tag == cmd->tag);
+    if (cmd->command == CMD_UNKNOWN) {
+        match = match && (header->command == MCM_BULK_MSG_ERROR_REPORT) && (payload_len == 4u) &&
+                (((uint16_t)payload[0] | (uint16_t)((uint16_t)payload[1] << 8)) == cmd->command);
+    } else {
+        match = match && (header->command == cmd->command) && (payload_len == cmd->payload_len);
+        for (uint16_t i = 0; match && (i < payload_len); i++) {
+            uint8_t expected = (cmd->command == CMD_INVERT) ? (uint8_t)~cmd->payload[i] : cmd->payload[i];
+            match = (payload[i] == expected);
+        }
+    }
+    if (!match) {
+        nr_mismatches++;
+    }
+    pending_rd = (pending_rd + 1u) % MAX_WINDOW;
+    pending_count--;
+}
+
+static void setup(void) {
+    usb_vendor_bulk_parser_init(&device_parser, device_frame, NULL);
+    usb_vendor_bulk_parser_init(&host_parser, host_frame, NULL);
+    device_tx_len = 0u;
+    pending_rd = 0u;
+    pending_count = 0u;
+    nr_responses = 0u;
+    nr_mismatches = 0u;
+}
+
+/** Feed data to a parser in USB packets, with random short packets in between */
+static void transfer(bulk_parser_t *parser, const uint8_t *data, size_t len, uint32_t *seed) {
+    size_t pos = 0u;
+    while (pos < len) {
+        size_t chunk = USB_PACKET_LEN;
+        if ((test_rand(seed) % 4u) == 0u) {
+            chunk = 1u + (test_rand(seed) % USB_PACKET_LEN);
+        }
+        if (chunk > (len - pos)) {
+            chunk = len - pos;
+        }
+        usb_vendor_bulk_parser_feed(parser, &data[pos], chunk);
+        pos += chunk;
+    }
+}
+
+/** Send the next command of the host, keeping it in the pending window */
+static void host_send(uint32_t tag, uint32_t *seed) {
+    size_t slot = (pending_rd + pending_count) % MAX_WINDOW;
+    pending_cmd_t *cmd = &pending[slot];
+    uint32_t kind = test_rand(seed) % 8u;
+    cmd->tag = tag;
+    cmd->command = (kind == 0u) ? CMD_UNKNOWN : ((kind & 1u) ? CMD_INVERT : CMD_ECHO);
+    cmd->payload_len = (uint16_t)(test_rand(seed) % MAX_PAYLOAD);
+    for (uint16_t i = 0; i < cmd->payload_len; i++) {
+        cmd->payload[i] = (uint8_t)test_rand(seed);
+    }
+    pending_count++;
+
+    size_t len = test_build_frame(host_tx, cmd->command, cmd->tag, cmd->payload, cmd->payload_len);
+    transfer(&device_parser, host_tx, len, seed);
+}
+
+/** Deliver the responses the device has written so far to the host */
+static void device_flush(uint32_t *seed) {
+    transfer(&host_parser, device_tx, device_tx_len, seed);
+    device_tx_len = 0u;
+}
+
+static void test_encode_matches_reference(void) {
+    uint8_t payload[17];
+    uint8_t reference[64];
+    for (uint16_t i = 0; i < sizeof(payload); i++) {
+        payload[i] = (uint8_t)(i * 13u);
+    }
+    size_t ref_len = test_build_frame(reference, 0x1234, 0xCAFEBABEu, payload, sizeof(payload));
+    uint16_t len = usb_vendor_bulk_parser_encode(response, 0xCAFEBABEu, 0x1234, payload, sizeof(payload));
+    TEST_ASSERT_EQUAL(ref_len, len);
+    TEST_ASSERT(memcmp(reference, response, len) == 0);
+
+    ref_len = test_build_frame(reference, 0xFFFF, 0u, NULL, 0u);
+    len = usb_vendor_bulk_parser_encode(response, 0u, 0xFFFF, NULL, 0u);
+    TEST_ASSERT_EQUAL(BULK_MSG_MIN_LEN, len);
+    TEST_ASSERT(memcmp(reference, response, len) == 0);
+}
+
+static void test_encode_in_place(void) {
+    /* payload built in the frame itself, as done with the transmit frame pool */
+    uint8_t reference[64];
+    uint8_t *payload = &response[sizeof(bulk_msg_header_t)];
+    for (uint16_t i = 0; i < 21u; i++) {
+        payload[i] = (uint8_t)(0xA0u + i);
+    }
+    size_t ref_len = test_build_frame(reference, 0x2202, 42u, payload, 21u);
+    uint16_t len = usb_vendor_bulk_parser_encode(response, 42u, 0x2202, payload, 21u);
+    TEST_ASSERT_EQUAL(ref_len, len);
+    TEST_ASSERT(memcmp(reference, response, len) == 0);
+}
+
+static void test_unknown_command_echoes_tag(void) {
+    uint32_t seed = 3u;
+    setup();
+    pending[0].tag = 0x55AA0001u;
+    pending[0].command = CMD_UNKNOWN;
+    pending[0].payload_len = 0u;
+    pending_count = 1u;
+    size_t len = test_build_frame(host_tx, CMD_UNKNOWN, 0x55AA0001u, NULL, 0u);
+    transfer(&device_parser, host_tx, len, &seed);
+    device_flush(&seed);
+    TEST_ASSERT_EQUAL(1, nr_responses);
+    TEST_ASSERT_EQUAL(0, nr_mismatches);
+    TEST_ASSERT_EQUAL(0, pending_count);
+}
+
+static void test_window_of_outstanding_commands(void) {
+    static const size_t windows[] = {1u, 2u, 8u, MAX_WINDOW};
+    for (size_t w = 0; w < (sizeof(windows) / sizeof(windows[0])); w++) {
+        uint32_t seed = 0x1000u + (uint32_t)w;
+        uint32_t tag = 1u;
+        setup();
+        /* fill the window, then keep it filled while the responses trickle in */
+        while (tag <= 2000u) {
+            while ((pending_count < windows[w]) && (tag <= 2000u)) {
+                host_send(tag++, &seed);
+            }
+            if ((test_rand(&seed) % 3u) == 0u) {
+                device_flush(&seed);
+            }
+        }
+        device_flush(&seed);
+        TEST_ASSERT_EQUAL(2000, nr_responses);
+        TEST_ASSERT_EQUAL(0, nr_mismatches);
+        TEST_ASSERT_EQUAL(0, pending_count);
+    }
+}
+
+static void test_tags_are_not_interpreted(void) {
+    /* the device echoes the tag, whatever value the host picks */
+    static const uint32_t tags[] = {0u, 0xFFFFFFFFu, USB_PACKET_HEADER, 0x00AA55AAu, 7u, 7u};
+    uint32_t seed = 11u;
+    setup();
+    for (size_t i = 0; i < (sizeof(tags) / sizeof(tags[0])); i++) {
+        pending_cmd_t *cmd = &pending[(pending_rd + pending_count) % MAX_WINDOW];
+        cmd->tag = tags[i];
+        cmd->command = CMD_ECHO;
+        cmd->payload_len = 4u;
+        memcpy(cmd->payload, &tags[i], 4u);
+        pending_count++;
+        size_t len = test_build_frame(host_tx, cmd->command, cmd->tag, cmd->payload, cmd->payload_len);
+        transfer(&device_parser, host_tx, len, &seed);
+    }
+    device_flush(&seed);
+    TEST_ASSERT_EQUAL(sizeof(tags) / sizeof(tags[0]), nr_responses);
+    TEST_ASSERT_EQUAL(0, nr_mismatches);
+}
+
+int main(void) {
+    RUN_TEST(test_encode_matches_reference);
+    RUN_TEST(test_encode_in_place);
+    RUN_TEST(test_unknown_command_echoes_tag);
+    RUN_TEST(test_window_of_outstanding_commands);
+    RUN_TEST(test_tags_are_not_interpreted);
+
+    return (test_failures == 0) ? 0 : 1;
+}
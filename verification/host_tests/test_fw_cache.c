@@ -0,0 +1,182 @@
+/**
+ * @file
+ * @brief Firmware image cache index host tests.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @details Host tests for the firmware image cache index: lookup, least recently used eviction by
+ * size and by number of images, pinned images, validation of a stored index and the hash strings.
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "fw_cache_index.h"
+
+#include "test_helpers.h"
+
+static fwcache_index_t index_;
+
+/** Make a distinct hash per number */
+static const uint8_t *test_hash(uint8_t number) {
+    static uint8_t hash[FWCACHE_HASH_LEN];
+
+    memset(hash, 0xA5, sizeof(hash));
+    hash[0] = number;
+    hash[FWCACHE_HASH_LEN - 1u] = (uint8_t)~number;
+
+    return hash;
+}
+
+static void test_add_find(void) {
+    fwcache_index_init(&index_);
+    TEST_ASSERT(fwcache_index_valid(&index_));
+    TEST_ASSERT(fwcache_index_find(&index_, test_hash(1u)) == NULL);
+
+    TEST_ASSERT(fwcache_index_add(&index_, test_hash(1u), 1000u) != NULL);
+    TEST_ASSERT(fwcache_index_add(&index_, test_hash(2u), 2000u) != NULL);
+    TEST_ASSERT_EQUAL(2u, index_.nr_of_entries);
+    TEST_ASSERT_EQUAL(3000u, fwcache_index_used(&index_));
+
+    fwcache_entry_t *entry = fwcache_index_find(&index_, test_hash(2u));
+    TEST_ASSERT(entry != NULL);
+    TEST_ASSERT_EQUAL(2000u, entry->size);
+
+    /* adding a cached image again only marks it as used */
+    TEST_ASSERT(fwcache_index_add(&index_, test_hash(1u), 1000u) != NULL);
+    TEST_ASSERT_EQUAL(2u, index_.nr_of_entries);
+
+    TEST_ASSERT(fwcache_index_remove(&index_, test_hash(1u)));
+    TEST_ASSERT(!fwcache_index_remove(&index_, test_hash(1u)));
+    TEST_ASSERT(fwcache_index_find(&index_, test_hash(1u)) == NULL);
+    TEST_ASSERT(fwcache_index_find(&index_, test_hash(2u)) != NULL);
+}
+
+static void test_evict_lru(void) {
+    fwcache_entry_t evicted;
+
+    fwcache_index_init(&index_);
+    for (uint8_t i = 0u; i < 4u; i++) {
+        (void)fwcache_index_add(&index_, test_hash(i), 1000u);
+    }
+    /* use the oldest image, image 1 becomes the least recently used */
+    fwcache_index_touch(&index_, fwcache_index_find(&index_, test_hash(0u)));
+
+    TEST_ASSERT(!fwcache_index_evict(&index_, 1000u, 5000u, &evicted));
+    TEST_ASSERT(fwcache_index_evict(&index_, 2000u, 5000u, &evicted));
+    TEST_ASSERT(memcmp(evicted.hash, test_hash(1u), FWCACHE_HASH_LEN) == 0);
+    TEST_ASSERT(!fwcache_index_evict(&index_, 2000u, 5000u, &evicted));
+    TEST_ASSERT_EQUAL(3u, index_.nr_of_entries);
+
+    /* everything is evicted for an image which does not fit */
+    uint32_t count = 0u;
+    while (fwcache_index_evict(&index_, 6000u, 5000u, &evicted)) {
+        count++;
+    }
+    TEST_ASSERT_EQUAL(3u, count);
+    TEST_ASSERT_EQUAL(0u, index_.nr_of_entries);
+}
+
+static void test_evict_count(void) {
+    fwcache_entry_t evicted;
+    fwcache_entry_t sorted[FWCACHE_MAX_ENTRIES];
+
+    fwcache_index_init(&index_);
+    for (uint8_t i = 0u; i < FWCACHE_MAX_ENTRIES; i++) {
+        TEST_ASSERT(fwcache_index_add(&index_, test_hash(i), 10u) != NULL);
+    }
+    TEST_ASSERT(fwcache_index_add(&index_, test_hash(0xF0u), 10u) == NULL);
+
+    /* a full index evicts one image although there is room */
+    TEST_ASSERT(fwcache_index_evict(&index_, 10u, UINT32_MAX / 2u, &evicted));
+    TEST_ASSERT(memcmp(evicted.hash, test_hash(0u), FWCACHE_HASH_LEN) == 0);
+    TEST_ASSERT(!fwcache_index_evict(&index_, 10u, UINT32_MAX / 2u, &evicted));
+    TEST_ASSERT(fwcache_index_add(&index_, test_hash(0xF0u), 10u) != NULL);
+
+    TEST_ASSERT_EQUAL(FWCACHE_MAX_ENTRIES, fwcache_index_sorted(&index_, sorted));
+    TEST_ASSERT(memcmp(sorted[0].hash, test_hash(0xF0u), FWCACHE_HASH_LEN) == 0);
+    TEST_ASSERT(memcmp(sorted[FWCACHE_MAX_ENTRIES - 1u].hash, test_hash(1u), FWCACHE_HASH_LEN) == 0);
+    for (uint32_t i = 1u; i < FWCACHE_MAX_ENTRIES; i++) {
+        TEST_ASSERT(sorted[i - 1u].last_used > sorted[i].last_used);
+    }
+}
+
+static void test_pinned(void) {
+    fwcache_entry_t evicted;
+
+    fwcache_index_init(&index_);
+    for (uint8_t i = 0u; i < 3u; i++) {
+        (void)fwcache_index_add(&index_, test_hash(i), 1000u);
+    }
+    TEST_ASSERT(fwcache_index_pin(&index_, test_hash(0u), true));
+    TEST_ASSERT(!fwcache_index_pin(&index_, test_hash(9u), true));
+
+    /* the pinned least recently used image is skipped */
+    TEST_ASSERT(fwcache_index_evict(&index_, 2000u, 4000u, &evicted));
+    TEST_ASSERT(memcmp(evicted.hash, test_hash(1u), FWCACHE_HASH_LEN) == 0);
+    TEST_ASSERT(fwcache_index_evict(&index_, 5000u, 4000u, &evicted));
+    TEST_ASSERT(memcmp(evicted.hash, test_hash(2u), FWCACHE_HASH_LEN) == 0);
+    TEST_ASSERT(!fwcache_index_evict(&index_, 5000u, 4000u, &evicted));
+    TEST_ASSERT_EQUAL(1u, index_.nr_of_entries);
+
+    /* an unpinned image can be evicted again, a re-added image is not pinned */
+    TEST_ASSERT(fwcache_index_pin(&index_, test_hash(0u), false));
+    TEST_ASSERT(fwcache_index_evict(&index_, 5000u, 4000u, &evicted));
+    TEST_ASSERT(fwcache_index_add(&index_, test_hash(3u), 10u) != NULL);
+    TEST_ASSERT_EQUAL(0u, fwcache_index_find(&index_, test_hash(3u))->pinned);
+}
+
+static void test_valid(void) {
+    fwcache_index_init(&index_);
+    (void)fwcache_index_add(&index_, test_hash(1u), 10u);
+    TEST_ASSERT(fwcache_index_valid(&index_));
+
+    index_.magic ^= 1u;
+    TEST_ASSERT(!fwcache_index_valid(&index_));
+    index_.magic ^= 1u;
+    index_.nr_of_entries = FWCACHE_MAX_ENTRIES + 1u;
+    TEST_ASSERT(!fwcache_index_valid(&index_));
+    index_.nr_of_entries = 1u;
+    index_.entries[0].last_used = index_.sequence + 1u;
+    TEST_ASSERT(!fwcache_index_valid(&index_));
+}
+
+static void test_hash_string(void) {
+    char str[FWCACHE_HASH_STR_LEN];
+    uint8_t hash[FWCACHE_HASH_LEN];
+
+    fwcache_hash_to_string(test_hash(0x3Cu), str);
+    TEST_ASSERT_EQUAL(2u * FWCACHE_HASH_LEN, strlen(str));
+    TEST_ASSERT(strncmp(str, "3ca5a5", 6u) == 0);
+    TEST_ASSERT(strcmp(&str[(2u * FWCACHE_HASH_LEN) - 4u], "a5c3") == 0);
+    TEST_ASSERT(fwcache_hash_from_string(str, hash));
+    TEST_ASSERT(memcmp(hash, test_hash(0x3Cu), FWCACHE_HASH_LEN) == 0);
+
+    /* uppercase is accepted, wrong length and other characters are not */
+    str[0] = 'F';
+    TEST_ASSERT(fwcache_hash_from_string(str, hash));
+    TEST_ASSERT_EQUAL(0xFCu, hash[0]);
+    str[1] = 'g';
+    TEST_ASSERT(!fwcache_hash_from_string(str, hash));
+    TEST_ASSERT(!fwcache_hash_from_string("3ca5", hash));
+}
+
+int main(void) {
+    RUN_TEST(test_add_find);
+    RUN_TEST(test_evict_lru);
+    RUN_TEST(test_evict_count);
+    RUN_TEST(test_pinned);
+    RUN_TEST(test_valid);
+    RUN_TEST(test_hash_string);
+
+    return (test_failures == 0) ? 0 : 1;
+}
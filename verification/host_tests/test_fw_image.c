@@ -0,0 +1,440 @@
+/**
+ * @file
+ * @brief Firmware image host tests.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @details Host tests for the page indexed firmware image: page alignment and fill, the presence
+ * bitmap, growing below the base, Intel HEX records, page crcs and the size limit, the delta to a reference image, and of the loader
+ * and writer of Intel HEX files and binary images.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fw_image_loader.h"
+#include "fw_image_page.h"
+
+#include "test_helpers.h"
+
+/** page size used by the tests */
+#define TEST_PAGE_SIZE 128u
+
+/** maximum image size used by the tests */
+#define TEST_MAX_SIZE (64u * 1024u)
+
+/** number of allocations done by the test allocator */
+static uint32_t test_allocations = 0u;
+
+static fwimg_t image;
+static fwimg_loader_t loader;
+
+/** binary image built by the tests: header, two pages and the crc */
+static uint8_t bin_image[FWIMG_BIN_HEADER_LEN + (2u * (4u + TEST_PAGE_SIZE)) + 2u];
+
+static void *test_realloc(void *ptr, size_t size) {
+    void *retval = NULL;
+
+    if (size == 0u) {
+        free(ptr);
+    } else {
+        retval = realloc(ptr, size);
+        test_allocations++;
+    }
+
+    return retval;
+}
+
+static void test_write_pages(void) {
+    const uint8_t data[4] = {0x11, 0x22, 0x33, 0x44};
+
+    fwimg_init(&image, TEST_PAGE_SIZE, TEST_MAX_SIZE, test_realloc);
+
+    /* data over a page boundary marks both pages present */
+    TEST_ASSERT(fwimg_write(&image, 0x4000u + TEST_PAGE_SIZE - 2u, data, sizeof(data)));
+    TEST_ASSERT_EQUAL(0x4000u, image.base);
+    TEST_ASSERT_EQUAL(2u, image.nr_of_pages);
+    TEST_ASSERT_EQUAL(2u, fwimg_pages_present(&image));
+
+    const uint8_t *page = fwimg_page(&image, 0x4000u);
+    TEST_ASSERT(page != NULL);
+    TEST_ASSERT_EQUAL(0xFFu, page[0]);
+    TEST_ASSERT_EQUAL(0x11u, page[TEST_PAGE_SIZE - 2u]);
+    page = fwimg_page(&image, 0x4000u + TEST_PAGE_SIZE + 1u);
+    TEST_ASSERT(page != NULL);
+    TEST_ASSERT_EQUAL(0x33u, page[0]);
+    TEST_ASSERT_EQUAL(0xFFu, page[2]);
+
+    /* a gap leaves the pages in between absent */
+    TEST_ASSERT(fwimg_write(&image, 0x4000u + (5u * TEST_PAGE_SIZE), data, 1u));
+    TEST_ASSERT_EQUAL(6u, image.nr_of_pages);
+    TEST_ASSERT_EQUAL(3u, fwimg_pages_present(&image));
+    TEST_ASSERT(fwimg_page(&image, 0x4000u + (3u * TEST_PAGE_SIZE)) == NULL);
+    TEST_ASSERT(fwimg_page(&image, 0x3000u) == NULL);
+
+    uint32_t index = 2u;
+    TEST_ASSERT(fwimg_next_page(&image, &index));
+    TEST_ASSERT_EQUAL(5u, index);
+    index = 6u;
+    TEST_ASSERT(!fwimg_next_page(&image, &index));
+
+    fwimg_free(&image);
+    TEST_ASSERT_EQUAL(0u, fwimg_pages_present(&image));
+    TEST_ASSERT(image.data == NULL);
+}
+
+static void test_grow_below_base(void) {
+    uint8_t data = 0x5Au;
+
+    fwimg_init(&image, TEST_PAGE_SIZE, TEST_MAX_SIZE, test_realloc);
+    TEST_ASSERT(fwimg_write(&image, 0x8000u, &data, 1u));
+    data = 0xA5u;
+    TEST_ASSERT(fwimg_write(&image, 0x8000u - (40u * TEST_PAGE_SIZE), &data, 1u));
+
+    TEST_ASSERT_EQUAL(0x8000u - (40u * TEST_PAGE_SIZE), image.base);
+    TEST_ASSERT_EQUAL(41u, image.nr_of_pages);
+    TEST_ASSERT_EQUAL(2u, fwimg_pages_present(&image));
+    TEST_ASSERT_EQUAL(0x5Au, fwimg_page(&image, 0x8000u)[0]);
+    TEST_ASSERT_EQUAL(0xA5u, fwimg_page(&image, image.base)[0]);
+    TEST_ASSERT(fwimg_page(&image, 0x8000u - TEST_PAGE_SIZE) == NULL);
+
+    fwimg_free(&image);
+}
+
+static void test_few_allocations(void) {
+    uint8_t data[16];
+    memset(data, 0x00, sizeof(data));
+
+    /* 64 KiB in 16 byte records, as an Intel HEX file would write it */
+    fwimg_init(&image, TEST_PAGE_SIZE, TEST_MAX_SIZE, test_realloc);
+    test_allocations = 0u;
+    for (uint32_t address = 0u; address < TEST_MAX_SIZE; address += sizeof(data)) {
+        TEST_ASSERT(fwimg_write(&image, address, data, sizeof(data)));
+    }
+    TEST_ASSERT_EQUAL(TEST_MAX_SIZE / TEST_PAGE_SIZE, fwimg_pages_present(&image));
+    TEST_ASSERT(test_allocations <= 3u * 6u);
+
+    /* the maximum size is not exceeded */
+    TEST_ASSERT(!fwimg_write(&image, TEST_MAX_SIZE, data, 1u));
+    TEST_ASSERT(!fwimg_write(&image, UINT32_MAX, data, 2u));
+
+    fwimg_free(&image);
+}
+
+static void test_hex_records(void) {
+    fwimg_init(&image, TEST_PAGE_SIZE, TEST_MAX_SIZE, test_realloc);
+
+    TEST_ASSERT(fwimg_write_hex_record(&image, ":020000040001F9", 15u));
+    TEST_ASSERT_EQUAL(0x10000u, image.ext_address);
+    const char *data = ":10010000000102030405060708090A0B0C0D0E0F77";
+    TEST_ASSERT(fwimg_write_hex_record(&image, data, strlen(data)));
+    TEST_ASSERT(fwimg_write_hex_record(&image, ":04000005000000CD2A", 19u));
+    TEST_ASSERT(fwimg_write_hex_record(&image, ":00000001FF", 11u));
+
+    const uint8_t *page = fwimg_page(&image, 0x10100u);
+    TEST_ASSERT(page != NULL);
+    TEST_ASSERT_EQUAL(0x0Fu, page[15]);
+    TEST_ASSERT_EQUAL(0xFFu, page[16]);
+
+    /* lower case hex digits */
+    TEST_ASSERT(fwimg_write_hex_record(&image, ":01002000558a", 13u));
+    TEST_ASSERT_EQUAL(0x55u, fwimg_page(&image, 0x10020u)[0x20u]);
+
+    /* wrong checksum, wrong length, invalid characters, unknown type */
+    TEST_ASSERT(!fwimg_write_hex_record(&image, ":00000001FE", 11u));
+    TEST_ASSERT(!fwimg_write_hex_record(&image, ":0200000400", 11u));
+    TEST_ASSERT(!fwimg_write_hex_record(&image, ":00000001FG", 11u));
+    TEST_ASSERT(!fwimg_write_hex_record(&image, "000000001FF", 11u));
+    TEST_ASSERT(!fwimg_write_hex_record(&image, ":00000006FA", 11u));
+
+    /* extended segment address */
+    TEST_ASSERT(fwimg_write_hex_record(&image, ":020000021000EC", 15u));
+    TEST_ASSERT_EQUAL(0x10000u, image.ext_address);
+
+    fwimg_free(&image);
+}
+
+static void test_page_crc(void) {
+    uint8_t data[TEST_PAGE_SIZE];
+    memset(data, 0xFF, sizeof(data));
+    data[3] = 0x12u;
+
+    fwimg_init(&image, TEST_PAGE_SIZE, TEST_MAX_SIZE, test_realloc);
+    TEST_ASSERT(fwimg_write(&image, 0x1000u + 3u, &data[3], 1u));
+    TEST_ASSERT(fwimg_write(&image, 0x2000u, data, sizeof(data)));
+    fwimg_finalize(&image);
+
+    TEST_ASSERT(image.finalized);
+    uint16_t crc = crc_calc16bitCrc(data, sizeof(data), 0xFFFFu);
+    TEST_ASSERT_EQUAL(crc, image.page_crc[0]);
+    TEST_ASSERT_EQUAL(crc, image.page_crc[(0x2000u - 0x1000u) / TEST_PAGE_SIZE]);
+
+    /* writing invalidates the crcs */
+    TEST_ASSERT(fwimg_write(&image, 0x2000u, data, 1u));
+    TEST_ASSERT(!image.finalized);
+
+    fwimg_free(&image);
+}
+
+static void test_delta(void) {
+    static fwimg_t reference;
+    static fwimg_t delta;
+    uint8_t data[TEST_PAGE_SIZE];
+    uint32_t skipped = 0u;
+
+    /* reference of 8 pages, the image changes one byte of page 2 and adds page 9 */
+    fwimg_init(&reference, TEST_PAGE_SIZE, TEST_MAX_SIZE, test_realloc);
+    fwimg_init(&image, TEST_PAGE_SIZE, TEST_MAX_SIZE, test_realloc);
+    fwimg_init(&delta, TEST_PAGE_SIZE, TEST_MAX_SIZE, test_realloc);
+    for (uint32_t page = 0u; page < 8u; page++) {
+        memset(data, (int)page, sizeof(data));
+        TEST_ASSERT(fwimg_write(&reference, 0x4000u + (page * TEST_PAGE_SIZE), data, sizeof(data)));
+        TEST_ASSERT(fwimg_write(&image, 0x4000u + (page * TEST_PAGE_SIZE), data, sizeof(data)));
+    }
+    data[0] = 0x55u;
+    TEST_ASSERT(fwimg_write(&image, 0x4000u + (2u * TEST_PAGE_SIZE) + 7u, data, 1u));
+    TEST_ASSERT(fwimg_write(&image, 0x4000u + (9u * TEST_PAGE_SIZE), data, sizeof(data)));
+    image.memory = FWIMG_MEMORY_FLASH;
+
+    /* both images must be finalized */
+    TEST_ASSERT(!fwimg_delta(&image, &reference, &delta, &skipped));
+    fwimg_finalize(&reference);
+    fwimg_finalize(&image);
+
+    TEST_ASSERT(fwimg_delta(&image, &reference, &delta, &skipped));
+    TEST_ASSERT_EQUAL(7u, skipped);
+    TEST_ASSERT_EQUAL(2u, fwimg_pages_present(&delta));
+    TEST_ASSERT(delta.finalized);
+    TEST_ASSERT_EQUAL(FWIMG_MEMORY_FLASH, delta.memory);
+    TEST_ASSERT(fwimg_page(&delta, 0x4000u + (2u * TEST_PAGE_SIZE)) != NULL);
+    TEST_ASSERT_EQUAL(0x55u, fwimg_page(&delta, 0x4000u + (2u * TEST_PAGE_SIZE))[7]);
+    TEST_ASSERT(fwimg_page(&delta, 0x4000u + (9u * TEST_PAGE_SIZE)) != NULL);
+    TEST_ASSERT(fwimg_page(&delta, 0x4000u) == NULL);
+
+    /* an image equal to the reference has an empty delta */
+    fwimg_free(&delta);
+    TEST_ASSERT(fwimg_delta(&reference, &reference, &delta, &skipped));
+    TEST_ASSERT_EQUAL(8u, skipped);
+    TEST_ASSERT_EQUAL(0u, fwimg_pages_present(&delta));
+
+    /* a reference holding pages which the image does not hold has no delta */
+    fwimg_free(&delta);
+    TEST_ASSERT(!fwimg_delta(&reference, &image, &delta, &skipped));
+
+    fwimg_free(&delta);
+    fwimg_free(&reference);
+    fwimg_free(&image);
+}
+
+static void test_copy(void) {
+    static fwimg_t copy;
+    uint8_t data[TEST_PAGE_SIZE];
+
+    /* two pages with a gap between them */
+    fwimg_init(&image, TEST_PAGE_SIZE, TEST_MAX_SIZE, test_realloc);
+    fwimg_init(&copy, TEST_PAGE_SIZE, TEST_MAX_SIZE, test_realloc);
+    memset(data, 0x11, sizeof(data));
+    TEST_ASSERT(fwimg_write(&image, 0x1000u, data, sizeof(data)));
+    memset(data, 0x22, sizeof(data));
+    TEST_ASSERT(fwimg_write(&image, 0x1000u + (4u * TEST_PAGE_SIZE), data, sizeof(data)));
+    image.memory = FWIMG_MEMORY_NVRAM;
+    fwimg_finalize(&image);
+
+    TEST_ASSERT(fwimg_copy(&image, &copy));
+    TEST_ASSERT(copy.finalized);
+    TEST_ASSERT_EQUAL(FWIMG_MEMORY_NVRAM, copy.memory);
+    TEST_ASSERT_EQUAL(2u, fwimg_pages_present(&copy));
+    TEST_ASSERT(fwimg_page(&copy, 0x1000u + TEST_PAGE_SIZE) == NULL);
+    TEST_ASSERT_EQUAL(0x22u, fwimg_page(&copy, 0x1000u + (4u * TEST_PAGE_SIZE))[0]);
+    TEST_ASSERT_EQUAL(image.page_crc[0], copy.page_crc[0]);
+
+    /* the copy does not follow later changes of the image */
+    data[0] = 0x33u;
+    TEST_ASSERT(fwimg_write(&image, 0x1000u, data, 1u));
+    TEST_ASSERT_EQUAL(0x11u, fwimg_page(&copy, 0x1000u)[0]);
+
+    /* page sizes must match */
+    fwimg_free(&copy);
+    fwimg_init(&copy, TEST_PAGE_SIZE * 2u, TEST_MAX_SIZE, test_realloc);
+    TEST_ASSERT(!fwimg_copy(&image, &copy));
+
+    fwimg_free(&copy);
+    fwimg_free(&image);
+}
+
+static void test_put_le(uint8_t *data, uint32_t value, size_t length) {
+    for (size_t i = 0u; i < length; i++) {
+        data[i] = (uint8_t)(value >> (8u * i));
+    }
+}
+
+static void test_build_bin_image(void) {
+    uint8_t *pos = bin_image;
+
+    memcpy(pos, "MCMI", 4u);
+    pos[4] = FWIMG_BIN_VERSION;
+    pos[5] = FWIMG_MEMORY_FLASH;
+    test_put_le(&pos[6], TEST_PAGE_SIZE, 2u);
+    test_put_le(&pos[8], 2u, 4u);
+    test_put_le(&pos[12], 0u, 4u);
+    pos += FWIMG_BIN_HEADER_LEN;
+    for (uint32_t page = 0u; page < 2u; page++) {
+        test_put_le(pos, 0x10000u + (page * 4u * TEST_PAGE_SIZE), 4u);
+        pos += 4u;
+        for (uint32_t i = 0u; i < TEST_PAGE_SIZE; i++) {
+            *pos++ = (uint8_t)(page + i);
+        }
+    }
+    test_put_le(pos, crc_calc16bitCrc(bin_image, (size_t)(pos - bin_image), FWIMG_BIN_CRC_SEED), 2u);
+}
+
+static fwimg_load_result_t test_load(const uint8_t *data, size_t length, size_t chunk) {
+    fwimg_free(&image);
+    fwimg_loader_init(&loader, &image);
+    for (size_t pos = 0u; pos < length; pos += chunk) {
+        (void)fwimg_loader_feed(&loader, &data[pos], ((length - pos) < chunk) ? (length - pos) : chunk);
+    }
+
+    return fwimg_loader_finish(&loader);
+}
+
+static void test_loader_binary(void) {
+    fwimg_init(&image, TEST_PAGE_SIZE, TEST_MAX_SIZE, test_realloc);
+    test_build_bin_image();
+
+    for (size_t chunk = 1u; chunk <= sizeof(bin_image); chunk += 7u) {
+        TEST_ASSERT_EQUAL(FWIMG_LOAD_OK, test_load(bin_image, sizeof(bin_image), chunk));
+        TEST_ASSERT_EQUAL(FWIMG_FORMAT_BINARY, loader.format);
+        TEST_ASSERT_EQUAL(2u, loader.pages);
+        TEST_ASSERT_EQUAL(2u, fwimg_pages_present(&image));
+        TEST_ASSERT_EQUAL(FWIMG_MEMORY_FLASH, image.memory);
+        TEST_ASSERT(image.finalized);
+        const uint8_t *page = fwimg_page(&image, 0x10000u + (4u * TEST_PAGE_SIZE));
+        TEST_ASSERT(page != NULL);
+        TEST_ASSERT_EQUAL(1u, page[0]);
+        TEST_ASSERT_EQUAL((uint8_t)TEST_PAGE_SIZE, page[TEST_PAGE_SIZE - 1u]);
+    }
+
+    fwimg_free(&image);
+}
+
+static void test_loader_binary_errors(void) {
+    uint8_t data[sizeof(bin_image) + 1u];
+
+    fwimg_init(&image, TEST_PAGE_SIZE, TEST_MAX_SIZE, test_realloc);
+    test_build_bin_image();
+
+    /* crc mismatch */
+    memcpy(data, bin_image, sizeof(bin_image));
+    data[FWIMG_BIN_HEADER_LEN + 10u] ^= 0x01u;
+    TEST_ASSERT_EQUAL(FWIMG_LOAD_ERR_CRC, test_load(data, sizeof(bin_image), 64u));
+
+    /* invalid magic, version and page size */
+    memcpy(data, bin_image, sizeof(bin_image));
+    data[1] = 'X';
+    TEST_ASSERT_EQUAL(FWIMG_LOAD_ERR_HEADER, test_load(data, sizeof(bin_image), 64u));
+    memcpy(data, bin_image, sizeof(bin_image));
+    data[4] = FWIMG_BIN_VERSION + 1u;
+    TEST_ASSERT_EQUAL(FWIMG_LOAD_ERR_HEADER, test_load(data, sizeof(bin_image), 64u));
+    memcpy(data, bin_image, sizeof(bin_image));
+    data[6] = 100u;
+    TEST_ASSERT_EQUAL(FWIMG_LOAD_ERR_HEADER, test_load(data, sizeof(bin_image), 64u));
+
+    /* truncated, and data after the end */
+    memcpy(data, bin_image, sizeof(bin_image));
+    TEST_ASSERT_EQUAL(FWIMG_LOAD_ERR_INCOMPLETE, test_load(data, sizeof(bin_image) - 1u, 64u));
+    data[sizeof(bin_image)] = 0u;
+    TEST_ASSERT_EQUAL(FWIMG_LOAD_ERR_INCOMPLETE, test_load(data, sizeof(data), 64u));
+
+    fwimg_free(&image);
+}
+
+/** Output of the binary image writer into a buffer */
+typedef struct test_output_s {
+    uint8_t data[sizeof(bin_image) + 16u];
+    size_t length;
+} test_output_t;
+
+static bool test_output(const uint8_t *data, size_t length, void *ctx) {
+    test_output_t *output = (test_output_t *)ctx;
+    bool retval = (output->length + length) <= sizeof(output->data);
+
+    if (retval) {
+        memcpy(&output->data[output->length], data, length);
+        output->length += length;
+    }
+
+    return retval;
+}
+
+static void test_bin_write(void) {
+    static test_output_t output;
+
+    fwimg_init(&image, TEST_PAGE_SIZE, TEST_MAX_SIZE, test_realloc);
+    test_build_bin_image();
+
+    /* a loaded binary image is written back unchanged */
+    TEST_ASSERT_EQUAL(FWIMG_LOAD_OK, test_load(bin_image, sizeof(bin_image), sizeof(bin_image)));
+    output.length = 0u;
+    TEST_ASSERT(fwimg_bin_write(&image, test_output, &output));
+    TEST_ASSERT_EQUAL(sizeof(bin_image), output.length);
+    TEST_ASSERT(memcmp(output.data, bin_image, sizeof(bin_image)) == 0);
+
+    /* and loads into the same pages */
+    TEST_ASSERT_EQUAL(FWIMG_LOAD_OK, test_load(output.data, output.length, 3u));
+    TEST_ASSERT_EQUAL(2u, fwimg_pages_present(&image));
+
+    /* a failing output stops the writer */
+    output.length = sizeof(output.data) - 20u;
+    TEST_ASSERT(!fwimg_bin_write(&image, test_output, &output));
+
+    fwimg_free(&image);
+}
+
+static void test_loader_hex(void) {
+    static const char hex_file[] = ":020000040001F9\r\n:10010000000102030405060708090A0B0C0D0E0F77\r\n:00000001FF\r\n";
+
+    fwimg_init(&image, TEST_PAGE_SIZE, TEST_MAX_SIZE, test_realloc);
+
+    TEST_ASSERT_EQUAL(FWIMG_LOAD_OK, test_load((const uint8_t *)hex_file, strlen(hex_file), 5u));
+    TEST_ASSERT_EQUAL(FWIMG_FORMAT_HEX, loader.format);
+    TEST_ASSERT_EQUAL(3u, loader.hex.lines);
+    TEST_ASSERT_EQUAL(FWIMG_MEMORY_ANY, image.memory);
+    TEST_ASSERT(fwimg_page(&image, 0x10100u) != NULL);
+
+    /* unknown format, empty file and invalid record */
+    TEST_ASSERT_EQUAL(FWIMG_LOAD_ERR_FORMAT, test_load((const uint8_t *)"x", 1u, 1u));
+    TEST_ASSERT_EQUAL(FWIMG_LOAD_ERR_EMPTY, test_load((const uint8_t *)"", 0u, 1u));
+    TEST_ASSERT_EQUAL(FWIMG_LOAD_ERR_EMPTY, test_load((const uint8_t *)":00000001FF\n", 12u, 4u));
+    TEST_ASSERT_EQUAL(FWIMG_LOAD_ERR_RECORD, test_load((const uint8_t *)":00000001FE\n", 12u, 4u));
+
+    fwimg_free(&image);
+}
+
+int main(void) {
+    RUN_TEST(test_write_pages);
+    RUN_TEST(test_grow_below_base);
+    RUN_TEST(test_few_allocations);
+    RUN_TEST(test_hex_records);
+    RUN_TEST(test_page_crc);
+    RUN_TEST(test_delta);
+    RUN_TEST(test_copy);
+    RUN_TEST(test_loader_binary);
+    RUN_TEST(test_loader_binary_errors);
+    RUN_TEST(test_loader_hex);
+    RUN_TEST(test_bin_write);
+
+    return (test_failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file
+ * @brief Host test helpers.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @details Minimal assertion and timing helpers shared by the host tests and benchmarks.
+ */
+
+#ifndef TEST_HELPERS_H_
+    #define TEST_HELPERS_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "mlx_crc.h"
+#include "usb_vendor_bulk_parser.h"
+
+static int test_failures __attribute__((unused)) = 0;
+
+#define TEST_ASSERT(cond) \
+    do { \
+        if (!(cond)) { \
+            fprintf(stderr, "%s:%d: assertion failed: %s\n", __FILE__, __LINE__, #cond); \
+            test_failures++; \
+        } \
+    } while (0)
+
+#define TEST_ASSERT_EQUAL(expected, actual) \
+    do { \
+        long long exp_ = (long long)(expected); \
+        long long act_ = (long long)(actual); \
+        if (exp_ != act_) { \
+            fprintf(stderr, "%s:%d: expected %lld but got %lld (%s)\n", __FILE__, __LINE__, exp_, act_, #actual); \
+            test_failures++; \
+        } \
+    } while (0)
+
+#define RUN_TEST(func) \
+    do { \
+        int before_ = test_failures; \
+        func(); \
+        printf("%-50s %s\n", #func, (before_ == test_failures) ? "PASS" : "FAIL"); \
+    } while (0)
+
+/** Get a monotonic timestamp in seconds */
+static inline double test_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec / 1e9);
+}
+
+/** Deterministic pseudo random generator (LCG) */
+static inline uint32_t test_rand(uint32_t *state) {
+    *state = (*state * 1664525u) + 1013904223u;
+    return *state >> 8;
+}
+
+/** Build a bulk message in a buffer
+ *
+ * @param[out]  buffer  buffer to build the message in.
+ * @param[in]  command  command of the message.
+ * @param[in]  tag  tag of the message.
+ * @param[in]  payload  payload of the message.
+ * @param[in]  payload_len  length of the payload.
+ * @returns  length of the message.
+ */
+static inline size_t test_build_frame(uint8_t *buffer,
+                                      uint16_t command,
+                                      uint32_t tag,
+                                      const uint8_t *payload,
+                                      uint16_t payload_len) {
+    bulk_msg_header_t header = {
+        .header = USB_PACKET_HEADER,
+        .length = (uint16_t)(sizeof(bulk_msg_header_t) + payload_len + BULK_MSG_CRC_LEN),
+        .command = command,
+        .tag = tag,
+    };
+    memcpy(buffer, &header, sizeof(header));
+    if (payload_len > 0u) {
+        memcpy(&buffer[sizeof(header)], payload, payload_len);
+    }
+    uint16_t crc = crc_calc16bitCrc(buffer, header.length - BULK_MSG_CRC_LEN, BULK_MSG_CRC_SEED);
+    buffer[header.length - 2u] = (uint8_t)(crc & 0xFFu);
+    buffer[header.length - 1u] = (uint8_t)(crc >> 8);
+    return header.length;
+}
+
+#endif /* TEST_HELPERS_H_ */
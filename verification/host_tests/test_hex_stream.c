@@ -0,0 +1,155 @@
+/**
+ * @file
+ * @brief Intel HEX stream host tests.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @details Host tests for the Intel HEX stream line splitter: records split over chunks of any size,
+ * mixed line endings, over long records and refused records.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "hex_stream.h"
+
+#include "test_helpers.h"
+
+/** maximum number of records collected by the test handler */
+#define TEST_MAX_RECORDS 8u
+
+/** Intel HEX file used by the tests */
+static const char test_file[] =
+    ":020000040000FA\r\n"
+    ":10000000000102030405060708090A0B0C0D0E0F78\r\n"
+    ":0400100010111213A6\n"
+    "\n"
+    ":00000001FF";
+
+/** records the test file consists of */
+static const char *const test_records[] = {
+    ":020000040000FA",
+    ":10000000000102030405060708090A0B0C0D0E0F78",
+    ":0400100010111213A6",
+    ":00000001FF",
+};
+
+/** records collected by the test handler */
+typedef struct test_collect_s {
+    char records[TEST_MAX_RECORDS][HEXSTREAM_MAX_LINE_LEN + 1u];
+    size_t count;
+    size_t refuse;
+} test_collect_t;
+
+static hexstream_t stream;
+static test_collect_t collect;
+
+static bool test_handler(const char *line, size_t length, void *ctx) {
+    test_collect_t *coll = ctx;
+    bool retval = false;
+
+    if ((coll->count < TEST_MAX_RECORDS) && (coll->count != coll->refuse)) {
+        TEST_ASSERT(length <= HEXSTREAM_MAX_LINE_LEN);
+        memcpy(coll->records[coll->count], line, length);
+        coll->records[coll->count][length] = '\0';
+        coll->count++;
+        retval = true;
+    }
+
+    return retval;
+}
+
+static void test_collect_reset(void) {
+    memset(&collect, 0, sizeof(collect));
+    collect.refuse = SIZE_MAX;
+    hexstream_init(&stream);
+}
+
+static void test_check_records(void) {
+    TEST_ASSERT_EQUAL(4u, collect.count);
+    TEST_ASSERT_EQUAL(4u, stream.lines);
+    for (size_t i = 0u; i < 4u; i++) {
+        TEST_ASSERT(strcmp(test_records[i], collect.records[i]) == 0);
+    }
+}
+
+static void test_single_chunk(void) {
+    test_collect_reset();
+    TEST_ASSERT_EQUAL(HEXSTREAM_OK,
+                      hexstream_feed(&stream, (const uint8_t *)test_file, strlen(test_file), test_handler, &collect));
+    TEST_ASSERT_EQUAL(3u, collect.count);
+    TEST_ASSERT_EQUAL(HEXSTREAM_OK, hexstream_finish(&stream, test_handler, &collect));
+    TEST_ASSERT_EQUAL(strlen(test_file), stream.bytes);
+    test_check_records();
+}
+
+static void test_chunk_sizes(void) {
+    size_t total = strlen(test_file);
+
+    for (size_t chunk = 1u; chunk <= total; chunk++) {
+        test_collect_reset();
+        for (size_t pos = 0u; pos < total; pos += chunk) {
+            size_t len = ((total - pos) < chunk) ? (total - pos) : chunk;
+            TEST_ASSERT_EQUAL(HEXSTREAM_OK,
+                              hexstream_feed(&stream, (const uint8_t *)&test_file[pos], len, test_handler, &collect));
+        }
+        TEST_ASSERT_EQUAL(HEXSTREAM_OK, hexstream_finish(&stream, test_handler, &collect));
+        test_check_records();
+    }
+}
+
+static void test_line_too_long(void) {
+    uint8_t data[HEXSTREAM_MAX_LINE_LEN + 2u];
+
+    /* a record of the maximum length is accepted */
+    test_collect_reset();
+    memset(data, 'F', sizeof(data));
+    data[HEXSTREAM_MAX_LINE_LEN] = '\n';
+    TEST_ASSERT_EQUAL(HEXSTREAM_OK, hexstream_feed(&stream, data, HEXSTREAM_MAX_LINE_LEN + 1u, test_handler, &collect));
+    TEST_ASSERT_EQUAL(1u, collect.count);
+    TEST_ASSERT_EQUAL(HEXSTREAM_MAX_LINE_LEN, strlen(collect.records[0]));
+
+    /* one more character is refused, also when split over chunks */
+    test_collect_reset();
+    data[HEXSTREAM_MAX_LINE_LEN] = 'F';
+    TEST_ASSERT_EQUAL(HEXSTREAM_OK, hexstream_feed(&stream, data, 300u, test_handler, &collect));
+    TEST_ASSERT_EQUAL(HEXSTREAM_ERR_LINE_TOO_LONG,
+                      hexstream_feed(&stream, &data[300], sizeof(data) - 300u, test_handler, &collect));
+    TEST_ASSERT_EQUAL(0u, collect.count);
+
+    /* the stream stays in error */
+    TEST_ASSERT_EQUAL(HEXSTREAM_ERR_LINE_TOO_LONG,
+                      hexstream_feed(&stream, (const uint8_t *)"\n", 1u, test_handler, &collect));
+    TEST_ASSERT_EQUAL(HEXSTREAM_ERR_LINE_TOO_LONG, hexstream_finish(&stream, test_handler, &collect));
+    TEST_ASSERT_EQUAL(0u, collect.count);
+}
+
+static void test_refused_record(void) {
+    test_collect_reset();
+    collect.refuse = 1u;
+    TEST_ASSERT_EQUAL(HEXSTREAM_ERR_RECORD,
+                      hexstream_feed(&stream, (const uint8_t *)test_file, strlen(test_file), test_handler, &collect));
+    TEST_ASSERT_EQUAL(1u, collect.count);
+    TEST_ASSERT_EQUAL(1u, stream.lines);
+    TEST_ASSERT_EQUAL(HEXSTREAM_ERR_RECORD, hexstream_finish(&stream, test_handler, &collect));
+}
+
+int main(void) {
+    RUN_TEST(test_single_chunk);
+    RUN_TEST(test_chunk_sizes);
+    RUN_TEST(test_line_too_long);
+    RUN_TEST(test_refused_record);
+
+    return (test_failures == 0) ? 0 : 1;
+}
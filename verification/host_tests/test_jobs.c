@@ -0,0 +1,188 @@
+/**
+ * @file
+ * @brief Job table host tests.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @details Host tests for the job table: the job life cycle, cancellation, the pending limit,
+ * recycling of finished jobs and the job listing.
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "job_table.h"
+
+#include "test_helpers.h"
+
+static job_table_t table;
+
+/** A job runs from queued to done or failed */
+static void test_life_cycle(void) {
+    job_table_init(&table);
+
+    int slot = job_table_add(&table, JOB_KIND_BOOTLOADER, 4u, 100u);
+    TEST_ASSERT(slot >= 0);
+    uint32_t id = table.jobs[slot].id;
+    TEST_ASSERT(id != JOB_ID_NONE);
+    TEST_ASSERT_EQUAL(slot, job_table_find(&table, id));
+    TEST_ASSERT_EQUAL(JOB_STATE_QUEUED, table.jobs[slot].state);
+    TEST_ASSERT_EQUAL(JOB_KIND_BOOTLOADER, table.jobs[slot].kind);
+    TEST_ASSERT_EQUAL(100u, table.jobs[slot].created_ms);
+    TEST_ASSERT_EQUAL(1u, job_table_pending(&table));
+
+    TEST_ASSERT(job_table_start(&table, slot, 150u));
+    TEST_ASSERT_EQUAL(JOB_STATE_RUNNING, table.jobs[slot].state);
+    TEST_ASSERT_EQUAL(150u, table.jobs[slot].started_ms);
+
+    TEST_ASSERT_EQUAL(JOB_STATE_DONE, job_table_finish(&table, slot, true, -3, 900u));
+    TEST_ASSERT_EQUAL(0, table.jobs[slot].error);
+    TEST_ASSERT_EQUAL(900u, table.jobs[slot].finished_ms);
+    TEST_ASSERT_EQUAL(0u, job_table_pending(&table));
+
+    slot = job_table_add(&table, JOB_KIND_LIN_BATCH, 4u, 1000u);
+    TEST_ASSERT(table.jobs[slot].id > id);
+    TEST_ASSERT(job_table_start(&table, slot, 1000u));
+    TEST_ASSERT_EQUAL(JOB_STATE_FAILED, job_table_finish(&table, slot, false, -3, 1010u));
+    TEST_ASSERT_EQUAL(-3, table.jobs[slot].error);
+
+    TEST_ASSERT_EQUAL(-1, job_table_find(&table, JOB_ID_NONE));
+    TEST_ASSERT_EQUAL(-1, job_table_find(&table, 12345u));
+}
+
+/** Queued jobs are cancelled at once, running jobs on request, finished jobs not at all */
+static void test_cancel(void) {
+    job_table_init(&table);
+
+    int queued = job_table_add(&table, JOB_KIND_BOOTLOADER, 4u, 0u);
+    int running = job_table_add(&table, JOB_KIND_BOOTLOADER, 4u, 0u);
+    TEST_ASSERT(job_table_start(&table, running, 10u));
+
+    TEST_ASSERT_EQUAL(JOB_CANCEL_DONE, job_table_cancel(&table, table.jobs[queued].id, 20u));
+    TEST_ASSERT_EQUAL(JOB_STATE_CANCELLED, table.jobs[queued].state);
+    TEST_ASSERT_EQUAL(20u, table.jobs[queued].finished_ms);
+    /* the worker skips a cancelled job */
+    TEST_ASSERT(!job_table_start(&table, queued, 30u));
+    TEST_ASSERT_EQUAL(JOB_STATE_CANCELLED, table.jobs[queued].state);
+
+    TEST_ASSERT_EQUAL(JOB_CANCEL_REQUESTED, job_table_cancel(&table, table.jobs[running].id, 20u));
+    TEST_ASSERT_EQUAL(JOB_STATE_RUNNING, table.jobs[running].state);
+    TEST_ASSERT_EQUAL(1u, table.jobs[running].cancel_requested);
+    TEST_ASSERT_EQUAL(JOB_STATE_CANCELLED, job_table_finish(&table, running, false, -16, 40u));
+    TEST_ASSERT_EQUAL(JOB_CANCEL_TOO_LATE, job_table_cancel(&table, table.jobs[running].id, 50u));
+    TEST_ASSERT_EQUAL(JOB_CANCEL_UNKNOWN, job_table_cancel(&table, 999u, 50u));
+
+    /* a job which completes regardless of the request succeeded */
+    int late = job_table_add(&table, JOB_KIND_OTA_VALIDATE, 4u, 60u);
+    TEST_ASSERT(job_table_start(&table, late, 60u));
+    TEST_ASSERT_EQUAL(JOB_CANCEL_REQUESTED, job_table_cancel(&table, table.jobs[late].id, 70u));
+    TEST_ASSERT_EQUAL(JOB_STATE_DONE, job_table_finish(&table, late, true, 0, 80u));
+}
+
+/** The number of pending jobs is bounded, finished jobs make room for new ones */
+static void test_limits(void) {
+    job_table_init(&table);
+
+    for (size_t i = 0; i < 3u; i++) {
+        TEST_ASSERT(job_table_add(&table, JOB_KIND_LIN_BATCH, 3u, 0u) >= 0);
+    }
+    TEST_ASSERT_EQUAL(-1, job_table_add(&table, JOB_KIND_LIN_BATCH, 3u, 0u));
+    TEST_ASSERT_EQUAL(3u, job_table_pending(&table));
+
+    /* finish all but the last one, then fill the table with finished jobs */
+    for (int slot = 0; slot < 2; slot++) {
+        (void)job_table_start(&table, slot, 0u);
+        (void)job_table_finish(&table, slot, true, 0, 0u);
+    }
+    uint32_t oldest = table.jobs[0].id;
+    for (size_t i = 3u; i < JOB_TABLE_SIZE; i++) {
+        int slot = job_table_add(&table, JOB_KIND_LIN_BATCH, 3u, 0u);
+        TEST_ASSERT_EQUAL(i, slot);
+        (void)job_table_start(&table, slot, 0u);
+        (void)job_table_finish(&table, slot, false, -1, 0u);
+    }
+
+    /* the table is full, the oldest finished job is recycled and pending jobs are kept */
+    int slot = job_table_add(&table, JOB_KIND_BOOTLOADER, 3u, 0u);
+    TEST_ASSERT_EQUAL(0, slot);
+    TEST_ASSERT_EQUAL(-1, job_table_find(&table, oldest));
+    TEST_ASSERT_EQUAL(JOB_STATE_QUEUED, table.jobs[2].state);
+    slot = job_table_add(&table, JOB_KIND_BOOTLOADER, 3u, 0u);
+    TEST_ASSERT_EQUAL(1, slot);
+    TEST_ASSERT_EQUAL(3u, job_table_pending(&table));
+    TEST_ASSERT_EQUAL(-1, job_table_add(&table, JOB_KIND_BOOTLOADER, 3u, 0u));
+}
+
+/** Job ids skip the id which never identifies a job when they wrap */
+static void test_id_wrap(void) {
+    job_table_init(&table);
+    table.next_id = UINT32_MAX;
+
+    int slot = job_table_add(&table, JOB_KIND_BOOTLOADER, 4u, 0u);
+    TEST_ASSERT_EQUAL(UINT32_MAX, table.jobs[slot].id);
+    slot = job_table_add(&table, JOB_KIND_BOOTLOADER, 4u, 0u);
+    TEST_ASSERT_EQUAL(1u, table.jobs[slot].id);
+}
+
+/** The listing is sorted on the job id and holds the oldest jobs when the buffer is too small */
+static void test_list(void) {
+    job_info_t infos[JOB_TABLE_SIZE];
+
+    job_table_init(&table);
+    TEST_ASSERT_EQUAL(0u, job_table_list(&table, infos, JOB_TABLE_SIZE));
+
+    for (size_t i = 0; i < 6u; i++) {
+        int slot = job_table_add(&table, JOB_KIND_LIN_BATCH, JOB_TABLE_SIZE, (uint32_t)i);
+        (void)job_table_start(&table, slot, 0u);
+        (void)job_table_finish(&table, slot, true, 0, 0u);
+    }
+    /* shuffle the slots */
+    job_info_t tmp = table.jobs[0];
+    table.jobs[0] = table.jobs[4];
+    table.jobs[4] = tmp;
+    tmp = table.jobs[1];
+    table.jobs[1] = table.jobs[5];
+    table.jobs[5] = tmp;
+    table.jobs[3].id = JOB_ID_NONE;
+
+    size_t count = job_table_list(&table, infos, JOB_TABLE_SIZE);
+    TEST_ASSERT_EQUAL(5u, count);
+    for (size_t i = 1; i < count; i++) {
+        TEST_ASSERT(infos[i - 1u].id < infos[i].id);
+    }
+
+    count = job_table_list(&table, infos, 2u);
+    TEST_ASSERT_EQUAL(2u, count);
+    TEST_ASSERT_EQUAL(1u, infos[0].id);
+    TEST_ASSERT_EQUAL(2u, infos[1].id);
+}
+
+/** Names of the states and kinds */
+static void test_names(void) {
+    TEST_ASSERT(strcmp(job_state_to_string(JOB_STATE_CANCELLED), "cancelled") == 0);
+    TEST_ASSERT(strcmp(job_kind_to_string(JOB_KIND_OTA_VALIDATE), "ota_validate") == 0);
+    TEST_ASSERT(strcmp(job_kind_to_string(JOB_KIND_CACHE_STORE), "cache_store") == 0);
+    TEST_ASSERT(strcmp(job_kind_to_string(JOB_NR_OF_KINDS), "unknown") == 0);
+    TEST_ASSERT(job_state_is_final(JOB_STATE_FAILED));
+    TEST_ASSERT(!job_state_is_final(JOB_STATE_RUNNING));
+}
+
+int main(void) {
+    RUN_TEST(test_life_cycle);
+    RUN_TEST(test_cancel);
+    RUN_TEST(test_limits);
+    RUN_TEST(test_id_wrap);
+    RUN_TEST(test_list);
+    RUN_TEST(test_names);
+
+    return (test_failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file
+ * @brief LIN last-value cache host tests.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @details Host tests for the last-value cache table: recording of successful and failing
+ * transactions, age calculation and the maximum age check.
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "lin_cache_table.h"
+
+#include "test_helpers.h"
+
+/** arbitrary lin error code of a failing transaction */
+#define TEST_LIN_ERROR (-3)
+
+static lincache_table_t table;
+
+static void test_empty(void) {
+    lincache_entry_t entry;
+
+    lincache_table_clear(&table);
+    for (uint8_t frameid = 0u; frameid < LINCACHE_NR_OF_FRAMES; frameid++) {
+        TEST_ASSERT(!lincache_table_get(&table, frameid, 0u, &entry));
+    }
+    TEST_ASSERT(!lincache_table_get(&table, 64u, 0u, &entry));
+    TEST_ASSERT(!lincache_table_fresh(&table, 0u, 0u, UINT32_MAX, 0u, &entry));
+}
+
+static void test_update(void) {
+    const uint8_t first[4] = {1u, 2u, 3u, 4u};
+    const uint8_t second[4] = {5u, 6u, 7u, 8u};
+    lincache_entry_t entry;
+
+    lincache_table_clear(&table);
+    lincache_table_update(&table, 0x10u, 0, first, 4u, 1000000u);
+    TEST_ASSERT(lincache_table_get(&table, 0x10u, 1250000u, &entry));
+    TEST_ASSERT_EQUAL(0x10u, entry.frameid);
+    TEST_ASSERT_EQUAL(250u, entry.age_ms);
+    TEST_ASSERT_EQUAL(1u, entry.count);
+    TEST_ASSERT_EQUAL(0u, entry.errors);
+    TEST_ASSERT_EQUAL(0, entry.status);
+    TEST_ASSERT_EQUAL(4u, entry.datalength);
+    TEST_ASSERT(memcmp(first, entry.data, 4u) == 0);
+
+    /* a failing transaction keeps the last valid data */
+    lincache_table_update(&table, 0x10u, TEST_LIN_ERROR, second, 4u, 2000000u);
+    TEST_ASSERT(lincache_table_get(&table, 0x10u, 2000000u, &entry));
+    TEST_ASSERT_EQUAL(0u, entry.age_ms);
+    TEST_ASSERT_EQUAL(1u, entry.count);
+    TEST_ASSERT_EQUAL(1u, entry.errors);
+    TEST_ASSERT_EQUAL(TEST_LIN_ERROR, entry.status);
+    TEST_ASSERT(memcmp(first, entry.data, 4u) == 0);
+
+    lincache_table_update(&table, 0x10u, 0, second, 2u, 3000000u);
+    TEST_ASSERT(lincache_table_get(&table, 0x10u, 3000000u, &entry));
+    TEST_ASSERT_EQUAL(2u, entry.count);
+    TEST_ASSERT_EQUAL(2u, entry.datalength);
+    TEST_ASSERT(memcmp(second, entry.data, 2u) == 0);
+
+    /* other frames and invalid identifiers are not affected */
+    lincache_table_update(&table, 64u, 0, first, 4u, 3000000u);
+    TEST_ASSERT(!lincache_table_get(&table, 0x11u, 3000000u, &entry));
+
+    /* a failing first transaction is recorded without data */
+    lincache_table_update(&table, 0x3Du, TEST_LIN_ERROR, first, 8u, 3000000u);
+    TEST_ASSERT(lincache_table_get(&table, 0x3Du, 3000000u, &entry));
+    TEST_ASSERT_EQUAL(0u, entry.datalength);
+    TEST_ASSERT_EQUAL(1u, entry.errors);
+}
+
+static void test_fresh(void) {
+    const uint8_t data[8] = {1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u};
+    lincache_entry_t entry;
+
+    lincache_table_clear(&table);
+    lincache_table_update(&table, 0x20u, 0, data, 8u, 5000000u);
+
+    TEST_ASSERT(lincache_table_fresh(&table, 0x20u, 8u, 100u, 5100000u, &entry));
+    TEST_ASSERT_EQUAL(100u, entry.age_ms);
+    TEST_ASSERT(memcmp(data, entry.data, 8u) == 0);
+    TEST_ASSERT(!lincache_table_fresh(&table, 0x20u, 8u, 100u, 5101000u, &entry));
+    TEST_ASSERT(!lincache_table_fresh(&table, 0x20u, 4u, 100u, 5100000u, &entry));
+    TEST_ASSERT(lincache_table_fresh(&table, 0x20u, 8u, 0u, 5000999u, &entry));
+
+    /* a time before the transaction counts as age 0 */
+    TEST_ASSERT(lincache_table_fresh(&table, 0x20u, 8u, 0u, 4000000u, &entry));
+
+    /* the response is not fresh after a failing transaction */
+    lincache_table_update(&table, 0x20u, TEST_LIN_ERROR, data, 8u, 5200000u);
+    TEST_ASSERT(!lincache_table_fresh(&table, 0x20u, 8u, UINT32_MAX, 5200000u, &entry));
+}
+
+int main(void) {
+    RUN_TEST(test_empty);
+    RUN_TEST(test_update);
+    RUN_TEST(test_fresh);
+
+    return (test_failures == 0) ? 0 : 1;
+}
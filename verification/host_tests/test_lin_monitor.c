@@ -0,0 +1,310 @@
+/**
+ * @file
+ * @brief LIN bus monitor host tests.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @details Host tests for the bus monitor frame assembly and record ring buffer: checksum and error
+ * flags, handling of the break field byte, ring buffer wrap around and loss reporting, and a bus at
+ * 20 kbit/s and full load streamed out periodically without losing records.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "lin_monitor_record.h"
+
+#include "test_helpers.h"
+
+static uint8_t classic_checksum(const uint8_t *data, uint8_t length) {
+    uint16_t sum = 0u;
+    for (uint8_t i = 0u; i < length; i++) {
+        sum += data[i];
+        if (sum > 0xFFu) {
+            sum -= 0xFFu;
+        }
+    }
+    return (uint8_t)~sum;
+}
+
+static uint8_t enhanced_checksum(uint8_t pid, const uint8_t *data, uint8_t length) {
+    uint16_t sum = pid;
+    for (uint8_t i = 0u; i < length; i++) {
+        sum += data[i];
+        if (sum > 0xFFu) {
+            sum -= 0xFFu;
+        }
+    }
+    return (uint8_t)~sum;
+}
+
+/** Feed a complete frame as received by the UART: break (zero byte), sync, pid, response */
+static int feed_frame(linmon_parser_t *parser,
+                      uint32_t timestamp,
+                      uint8_t pid,
+                      const uint8_t *response,
+                      uint8_t length,
+                      linmon_record_t *records) {
+    int count = 0;
+    if (linmon_parser_break(parser, timestamp, &records[count])) {
+        count++;
+    }
+    const uint8_t header[] = {0x00u, 0x55u, pid};
+    for (size_t i = 0u; i < sizeof(header); i++) {
+        if (linmon_parser_byte(parser, header[i], &records[count])) {
+            count++;
+        }
+    }
+    for (uint8_t i = 0u; i < length; i++) {
+        if (linmon_parser_byte(parser, response[i], &records[count])) {
+            count++;
+        }
+    }
+    return count;
+}
+
+static void test_protected_id(void) {
+    TEST_ASSERT_EQUAL(0x80u, linmon_protected_id(0x00u));
+    TEST_ASSERT_EQUAL(0xC1u, linmon_protected_id(0x01u));
+    TEST_ASSERT_EQUAL(0x3Cu, linmon_protected_id(0x3Cu));
+    TEST_ASSERT_EQUAL(0x7Du, linmon_protected_id(0x3Du));
+}
+
+static void test_checksum_flags(void) {
+    linmon_parser_t parser;
+    linmon_record_t records[2];
+    uint8_t response[5] = {0x11u, 0x22u, 0x33u, 0x44u, 0x00u};
+    uint8_t pid = linmon_protected_id(0x10u);
+
+    linmon_parser_init(&parser);
+    response[4] = enhanced_checksum(pid, response, 4u);
+    TEST_ASSERT_EQUAL(0, feed_frame(&parser, 1000u, pid, response, 5u, records));
+    TEST_ASSERT(linmon_parser_idle(&parser, &records[0]));
+    TEST_ASSERT_EQUAL(1000u, records[0].timestamp_us);
+    TEST_ASSERT_EQUAL(0u, records[0].sequence);
+    TEST_ASSERT_EQUAL(pid, records[0].pid);
+    TEST_ASSERT_EQUAL(4u, records[0].datalength);
+    TEST_ASSERT_EQUAL(response[4], records[0].checksum);
+    TEST_ASSERT_EQUAL(LINMON_FLAG_CHECKSUM_ENHANCED, records[0].flags);
+    TEST_ASSERT(memcmp(response, records[0].data, 4u) == 0);
+
+    response[4] = classic_checksum(response, 4u);
+    TEST_ASSERT_EQUAL(0, feed_frame(&parser, 2000u, pid, response, 5u, records));
+    TEST_ASSERT(linmon_parser_idle(&parser, &records[0]));
+    TEST_ASSERT_EQUAL(1u, records[0].sequence);
+    TEST_ASSERT_EQUAL(LINMON_FLAG_CHECKSUM_CLASSIC, records[0].flags);
+
+    response[4] = (uint8_t)(classic_checksum(response, 4u) + 1u);
+    TEST_ASSERT_EQUAL(0, feed_frame(&parser, 3000u, pid, response, 5u, records));
+    TEST_ASSERT(linmon_parser_idle(&parser, &records[0]));
+    TEST_ASSERT_EQUAL(0u, records[0].flags);
+
+    /* an 8 byte response completes without waiting for the next break */
+    uint8_t full[9] = {1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u, 0u};
+    full[8] = enhanced_checksum(pid, full, 8u);
+    TEST_ASSERT_EQUAL(1, feed_frame(&parser, 4000u, pid, full, 9u, records));
+    TEST_ASSERT_EQUAL(8u, records[0].datalength);
+    TEST_ASSERT_EQUAL(LINMON_FLAG_CHECKSUM_ENHANCED, records[0].flags);
+    TEST_ASSERT(!linmon_parser_idle(&parser, &records[0]));
+}
+
+static void test_error_flags(void) {
+    linmon_parser_t parser;
+    linmon_record_t records[2];
+    const uint8_t response[2] = {0x5Au, 0x00u};
+
+    linmon_parser_init(&parser);
+
+    /* header without response */
+    TEST_ASSERT_EQUAL(0, feed_frame(&parser, 0u, linmon_protected_id(0x3Du), NULL, 0u, records));
+    TEST_ASSERT(linmon_parser_idle(&parser, &records[0]));
+    TEST_ASSERT_EQUAL(LINMON_FLAG_NO_RESPONSE, records[0].flags);
+
+    /* parity error */
+    TEST_ASSERT_EQUAL(0, feed_frame(&parser, 0u, 0x3Du, NULL, 0u, records));
+    TEST_ASSERT(linmon_parser_idle(&parser, &records[0]));
+    TEST_ASSERT_EQUAL(LINMON_FLAG_PARITY_ERROR | LINMON_FLAG_NO_RESPONSE, records[0].flags);
+
+    /* response of a single byte */
+    TEST_ASSERT_EQUAL(0, feed_frame(&parser, 0u, 0x80u, response, 1u, records));
+    TEST_ASSERT(linmon_parser_idle(&parser, &records[0]));
+    TEST_ASSERT_EQUAL(LINMON_FLAG_FRAMING_ERROR, records[0].flags);
+
+    /* bad sync */
+    TEST_ASSERT(!linmon_parser_break(&parser, 0u, &records[0]));
+    TEST_ASSERT(!linmon_parser_byte(&parser, 0x54u, &records[0]));
+    TEST_ASSERT(!linmon_parser_byte(&parser, 0x80u, &records[0]));
+    TEST_ASSERT(linmon_parser_idle(&parser, &records[0]));
+    TEST_ASSERT_EQUAL(LINMON_FLAG_SYNC_ERROR | LINMON_FLAG_NO_RESPONSE, records[0].flags);
+
+    /* break without header, framing errors of the break itself are ignored */
+    TEST_ASSERT(!linmon_parser_break(&parser, 0u, &records[0]));
+    linmon_parser_error(&parser, LINMON_FLAG_FRAMING_ERROR);
+    TEST_ASSERT(linmon_parser_break(&parser, 10u, &records[0]));
+    TEST_ASSERT_EQUAL(LINMON_FLAG_SYNC_ERROR, records[0].flags);
+
+    /* framing error in the response */
+    TEST_ASSERT(!linmon_parser_byte(&parser, 0x55u, &records[0]));
+    TEST_ASSERT(!linmon_parser_byte(&parser, 0x80u, &records[0]));
+    linmon_parser_error(&parser, LINMON_FLAG_FRAMING_ERROR);
+    TEST_ASSERT(linmon_parser_idle(&parser, &records[0]));
+    TEST_ASSERT_EQUAL(LINMON_FLAG_FRAMING_ERROR | LINMON_FLAG_NO_RESPONSE, records[0].flags);
+
+    /* bytes outside a frame are ignored */
+    TEST_ASSERT(!linmon_parser_byte(&parser, 0x12u, &records[0]));
+    TEST_ASSERT(!linmon_parser_idle(&parser, &records[0]));
+}
+
+static void test_break_byte(void) {
+    linmon_parser_t parser;
+    linmon_record_t records[2];
+    uint8_t pid = linmon_protected_id(0x21u);
+    uint8_t response[4] = {0xA0u, 0x0Bu, 0x00u, 0x00u};
+
+    linmon_parser_init(&parser);
+
+    /* the zero byte of the next break is read before the break is signaled */
+    response[2] = enhanced_checksum(pid, response, 2u);
+    response[3] = 0x00u;
+    TEST_ASSERT_EQUAL(0, feed_frame(&parser, 0u, pid, response, 4u, records));
+    TEST_ASSERT(linmon_parser_break(&parser, 100u, &records[0]));
+    TEST_ASSERT_EQUAL(2u, records[0].datalength);
+    TEST_ASSERT_EQUAL(LINMON_FLAG_CHECKSUM_ENHANCED, records[0].flags);
+
+    /* a zero checksum which completes a valid response is kept */
+    uint8_t zero_sum[2] = {0xFFu, 0x00u};
+    TEST_ASSERT_EQUAL(0u, classic_checksum(zero_sum, 1u));
+    linmon_parser_init(&parser);
+    TEST_ASSERT_EQUAL(0, feed_frame(&parser, 0u, 0x3Cu, zero_sum, 2u, records));
+    TEST_ASSERT(linmon_parser_break(&parser, 100u, &records[0]));
+    TEST_ASSERT_EQUAL(1u, records[0].datalength);
+    TEST_ASSERT_EQUAL(0u, records[0].checksum);
+    TEST_ASSERT((records[0].flags & LINMON_FLAG_CHECKSUM_CLASSIC) != 0u);
+
+    /* when the response is valid with and without the zero byte, the shorter one is taken */
+    uint8_t ambiguous[4] = {0x7Fu, 0x80u, 0x00u, 0x00u};
+    linmon_parser_init(&parser);
+    TEST_ASSERT_EQUAL(0, feed_frame(&parser, 0u, 0x3Cu, ambiguous, 3u, records));
+    TEST_ASSERT(linmon_parser_break(&parser, 100u, &records[0]));
+    TEST_ASSERT_EQUAL(1u, records[0].datalength);
+    TEST_ASSERT_EQUAL(0x80u, records[0].checksum);
+
+    /* header followed by the break byte only */
+    TEST_ASSERT(!linmon_parser_byte(&parser, 0x55u, &records[0]));
+    TEST_ASSERT(!linmon_parser_byte(&parser, pid, &records[0]));
+    TEST_ASSERT(!linmon_parser_byte(&parser, 0x00u, &records[0]));
+    TEST_ASSERT(linmon_parser_break(&parser, 200u, &records[0]));
+    TEST_ASSERT_EQUAL(LINMON_FLAG_NO_RESPONSE, records[0].flags);
+}
+
+static void test_ring_wrap_and_loss(void) {
+    linmon_ring_t ring;
+    linmon_record_t storage[6];
+    linmon_record_t record;
+    linmon_record_t out[8];
+
+    /* capacity is rounded down to a power of two */
+    linmon_ring_init(&ring, storage, 6u);
+    TEST_ASSERT_EQUAL(4u, ring.capacity);
+
+    memset(&record, 0, sizeof(record));
+    for (uint16_t i = 0u; i < 3u; i++) {
+        record.sequence = i;
+        TEST_ASSERT(linmon_ring_push(&ring, &record));
+    }
+    TEST_ASSERT_EQUAL(2u, linmon_ring_peek(&ring, out, 2u));
+    TEST_ASSERT_EQUAL(3u, linmon_ring_used(&ring));
+    linmon_ring_consume(&ring, 2u);
+    TEST_ASSERT_EQUAL(1u, linmon_ring_used(&ring));
+
+    for (uint16_t i = 3u; i < 7u; i++) {
+        record.sequence = i;
+        TEST_ASSERT_EQUAL(i < 6u, linmon_ring_push(&ring, &record));
+    }
+    TEST_ASSERT_EQUAL(1u, ring.lost);
+
+    TEST_ASSERT_EQUAL(4u, linmon_ring_peek(&ring, out, 8u));
+    for (uint16_t i = 0u; i < 4u; i++) {
+        TEST_ASSERT_EQUAL(2u + i, out[i].sequence);
+    }
+    linmon_ring_consume(&ring, 4u);
+
+    record.sequence = 7u;
+    TEST_ASSERT(linmon_ring_push(&ring, &record));
+    TEST_ASSERT_EQUAL(1u, linmon_ring_peek(&ring, out, 8u));
+    TEST_ASSERT_EQUAL(LINMON_FLAG_RECORDS_LOST, out[0].flags);
+}
+
+static void test_full_load_stream(void) {
+    static linmon_record_t storage[4096];
+    static linmon_record_t out[200];
+    linmon_ring_t ring;
+    linmon_parser_t parser;
+    linmon_record_t records[2];
+    uint8_t response[9];
+
+    /* shortest frames at 20 kbit/s: 34 bit header and 20 bit response at 100 % load */
+    const uint32_t frame_us = ((34u + 20u) * 1000000u) / 20000u;
+    const uint32_t report_us = 20000u;
+    const uint32_t bus_seconds = 600u;
+
+    linmon_ring_init(&ring, storage, 4096u);
+    linmon_parser_init(&parser);
+
+    uint32_t frames = (bus_seconds * 1000000u) / frame_us;
+    uint32_t next_report = report_us;
+    uint32_t streamed = 0u;
+    uint16_t expected_sequence = 0u;
+    double start = test_now();
+    for (uint32_t frame = 0u; frame < frames; frame++) {
+        uint32_t timestamp = frame * frame_us;
+        uint8_t pid = linmon_protected_id((uint8_t)(frame & 0x3Bu));
+        response[0] = (uint8_t)frame;
+        response[1] = enhanced_checksum(pid, response, 1u);
+        int count = feed_frame(&parser, timestamp, pid, response, 2u, records);
+        for (int i = 0; i < count; i++) {
+            TEST_ASSERT(linmon_ring_push(&ring, &records[i]));
+        }
+        if (timestamp >= next_report) {
+            uint32_t n;
+            while ((n = linmon_ring_peek(&ring, out, 200u)) > 0u) {
+                for (uint32_t i = 0u; i < n; i++) {
+                    if (out[i].sequence != expected_sequence) {
+                        TEST_ASSERT_EQUAL(expected_sequence, out[i].sequence);
+                    }
+                    expected_sequence++;
+                }
+                linmon_ring_consume(&ring, n);
+                streamed += n;
+            }
+            next_report += report_us;
+        }
+    }
+    double elapsed = test_now() - start;
+
+    TEST_ASSERT_EQUAL(0u, ring.lost);
+    TEST_ASSERT(streamed >= (frames - 1u - (report_us / frame_us) - 1u));
+    printf("  %u frames (%u s of bus time) assembled in %.3f s\n", frames, bus_seconds, elapsed);
+    TEST_ASSERT(elapsed < (double)bus_seconds);
+}
+
+int main(void) {
+    RUN_TEST(test_protected_id);
+    RUN_TEST(test_checksum_flags);
+    RUN_TEST(test_error_flags);
+    RUN_TEST(test_break_byte);
+    RUN_TEST(test_ring_wrap_and_loss);
+    RUN_TEST(test_full_load_stream);
+
+    return (test_failures == 0) ? 0 : 1;
+}
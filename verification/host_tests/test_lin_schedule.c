@@ -0,0 +1,348 @@
+/**
+ * @file
+ * @brief LIN schedule table host tests.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @details Host tests for the schedule table validation and the slot cursor of the schedule
+ * executor: slot start times, table switches at slot boundaries and overrun handling. Also covers
+ * the event triggered frame collision resolution and the sporadic frame selection.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "lin_schedule_event.h"
+#include "lin_schedule_table.h"
+#include "mlx_err.h"
+
+#include "test_helpers.h"
+
+static linsched_entry_t table0_entries[3];
+static linsched_entry_t table1_entries[2];
+static linsched_table_t tables[2];
+
+static void setup(void) {
+    memset(table0_entries, 0, sizeof(table0_entries));
+    memset(table1_entries, 0, sizeof(table1_entries));
+    for (uint8_t i = 0u; i < 3u; i++) {
+        table0_entries[i].type = LINSCHED_M2S;
+        table0_entries[i].frameid = (uint8_t)(0x10u + i);
+        table0_entries[i].datalength = 8u;
+        table0_entries[i].slot_us = 10000u * (i + 1u);
+    }
+    for (uint8_t i = 0u; i < 2u; i++) {
+        table1_entries[i].type = LINSCHED_S2M;
+        table1_entries[i].frameid = (uint8_t)(0x20u + i);
+        table1_entries[i].datalength = 2u;
+        table1_entries[i].slot_us = 5000u;
+    }
+    tables[0].baudrate = 19200u;
+    tables[0].nr_of_entries = 3u;
+    tables[0].entries = table0_entries;
+    tables[1].baudrate = 19200u;
+    tables[1].nr_of_entries = 2u;
+    tables[1].entries = table1_entries;
+}
+
+static void test_entry_validation(void) {
+    linsched_entry_t entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.type = LINSCHED_M2S;
+    entry.frameid = 0x3Cu;
+    entry.datalength = 8u;
+    entry.slot_us = 1000u;
+    TEST_ASSERT(linsched_entry_valid(&entry, 1000u));
+
+    entry.slot_us = 999u;
+    TEST_ASSERT(!linsched_entry_valid(&entry, 1000u));
+    entry.slot_us = 1000u;
+
+    entry.frameid = 0x40u;
+    TEST_ASSERT(!linsched_entry_valid(&entry, 1000u));
+    entry.frameid = 0x3Du;
+
+    entry.datalength = 0u;
+    TEST_ASSERT(!linsched_entry_valid(&entry, 1000u));
+    entry.datalength = 9u;
+    TEST_ASSERT(!linsched_entry_valid(&entry, 1000u));
+
+    entry.type = LINSCHED_WAKEUP;
+    TEST_ASSERT(linsched_entry_valid(&entry, 1000u));
+
+    entry.type = 3u;
+    TEST_ASSERT(!linsched_entry_valid(&entry, 1000u));
+}
+
+static void test_nominal_slot_starts(void) {
+    linsched_cursor_t cursor;
+    uint32_t late_us = 0u;
+    setup();
+    linsched_cursor_start(&cursor, 0u, 1000u);
+
+    /* each slot is woken somewhat late, the next slot start does not drift */
+    uint64_t expected_start = 1000u;
+    for (uint32_t slot = 0u; slot < 30u; slot++) {
+        uint64_t now = expected_start + (slot % 7u) * 100u;
+        uint8_t index = linsched_cursor_next(&cursor, tables, now, &late_us);
+        TEST_ASSERT_EQUAL(slot % 3u, index);
+        TEST_ASSERT_EQUAL((slot % 7u) * 100u, late_us);
+        expected_start += table0_entries[index].slot_us;
+        TEST_ASSERT_EQUAL(expected_start, cursor.slot_start);
+    }
+    TEST_ASSERT_EQUAL(30u, cursor.sequence);
+    TEST_ASSERT_EQUAL(0u, cursor.overruns);
+}
+
+static void test_switch_at_slot_boundary(void) {
+    linsched_cursor_t cursor;
+    uint32_t late_us = 0u;
+    setup();
+    linsched_cursor_start(&cursor, 0u, 0u);
+
+    TEST_ASSERT_EQUAL(0u, linsched_cursor_next(&cursor, tables, 0u, &late_us));
+    TEST_ASSERT_EQUAL(1u, linsched_cursor_next(&cursor, tables, 10000u, &late_us));
+
+    /* the switch is requested in the middle of the slot of entry 1 */
+    linsched_cursor_switch(&cursor, 1u);
+    TEST_ASSERT_EQUAL(0u, cursor.table);
+    TEST_ASSERT_EQUAL(30000u, cursor.slot_start);
+
+    /* the next slot is the first of the new table, starting at the end of the running slot */
+    TEST_ASSERT_EQUAL(0u, linsched_cursor_next(&cursor, tables, 30000u, &late_us));
+    TEST_ASSERT_EQUAL(1u, cursor.table);
+    TEST_ASSERT_EQUAL(LINSCHED_NO_TABLE, cursor.pending);
+    TEST_ASSERT_EQUAL(35000u, cursor.slot_start);
+    TEST_ASSERT_EQUAL(1u, linsched_cursor_next(&cursor, tables, 35000u, &late_us));
+    TEST_ASSERT_EQUAL(0u, linsched_cursor_next(&cursor, tables, 40000u, &late_us));
+    TEST_ASSERT_EQUAL(1u, cursor.table);
+}
+
+static void test_overrun_restarts_timing(void) {
+    linsched_cursor_t cursor;
+    uint32_t late_us = 0u;
+    setup();
+    linsched_cursor_start(&cursor, 0u, 0u);
+
+    TEST_ASSERT_EQUAL(0u, linsched_cursor_next(&cursor, tables, 0u, &late_us));
+    TEST_ASSERT_EQUAL(10000u, cursor.slot_start);
+
+    /* the slot of entry 1 (10000..30000) starts after its nominal end */
+    TEST_ASSERT_EQUAL(1u, linsched_cursor_next(&cursor, tables, 31000u, &late_us));
+    TEST_ASSERT_EQUAL(1u, cursor.overruns);
+    TEST_ASSERT_EQUAL(0u, late_us);
+    TEST_ASSERT_EQUAL(51000u, cursor.slot_start);
+
+    /* a late start within the slot is no overrun */
+    TEST_ASSERT_EQUAL(2u, linsched_cursor_next(&cursor, tables, 52000u, &late_us));
+    TEST_ASSERT_EQUAL(1u, cursor.overruns);
+    TEST_ASSERT_EQUAL(1000u, late_us);
+    TEST_ASSERT_EQUAL(81000u, cursor.slot_start);
+}
+
+/** scripted slave to master frames of the fake bus */
+typedef struct fake_frame_s {
+    int16_t status;
+    uint8_t data[LINSCHED_MAX_DATA_LEN];
+} fake_frame_t;
+
+static fake_frame_t fake_frames[LINSCHED_NR_OF_FRAMES];
+static uint8_t fake_calls[16];
+static uint8_t fake_nr_of_calls;
+
+static int16_t fake_s2m(uint8_t frameid, uint8_t *data, uint8_t datalength, void *ctx) {
+    (void)ctx;
+    if (fake_nr_of_calls < sizeof(fake_calls)) {
+        fake_calls[fake_nr_of_calls] = frameid;
+    }
+    fake_nr_of_calls++;
+    memcpy(data, fake_frames[frameid].data, datalength);
+    return fake_frames[frameid].status;
+}
+
+static void setup_event(linsched_entry_t *entry) {
+    memset(fake_frames, 0, sizeof(fake_frames));
+    fake_nr_of_calls = 0u;
+
+    memset(entry, 0, sizeof(linsched_entry_t));
+    entry->type = LINSCHED_EVENT_TRIGGERED;
+    entry->frameid = 0x3Au;
+    entry->datalength = 4u;
+    entry->slot_us = 10000u;
+    memset(entry->payload, LINSCHED_NO_FRAME, sizeof(entry->payload));
+    entry->payload[0] = 0x10u;
+    entry->payload[1] = 0x11u;
+    entry->payload[2] = 0x12u;
+    for (uint8_t i = 0u; i < 3u; i++) {
+        fake_frames[0x10u + i].data[0] = linsched_protected_id((uint8_t)(0x10u + i));
+        fake_frames[0x10u + i].data[1] = (uint8_t)(0xA0u + i);
+    }
+}
+
+static void test_protected_id(void) {
+    TEST_ASSERT_EQUAL(0x80u, linsched_protected_id(0x00u));
+    TEST_ASSERT_EQUAL(0xC1u, linsched_protected_id(0x01u));
+    TEST_ASSERT_EQUAL(0x3Cu, linsched_protected_id(0x3Cu));
+    TEST_ASSERT_EQUAL(0x7Du, linsched_protected_id(0x3Du));
+    TEST_ASSERT_EQUAL(0x50u, linsched_protected_id(0x10u));
+}
+
+static void test_associated_validation(void) {
+    linsched_entry_t entry;
+
+    setup_event(&entry);
+    TEST_ASSERT_EQUAL(3u, linsched_nr_of_associated(&entry));
+    TEST_ASSERT(linsched_entry_valid(&entry, 1000u));
+
+    /* the response holds at least the protected identifier and one data byte */
+    entry.datalength = 1u;
+    TEST_ASSERT(!linsched_entry_valid(&entry, 1000u));
+    entry.datalength = 4u;
+
+    /* a gap in the list */
+    entry.payload[4] = 0x13u;
+    TEST_ASSERT_EQUAL(0u, linsched_nr_of_associated(&entry));
+    TEST_ASSERT(!linsched_entry_valid(&entry, 1000u));
+    entry.payload[4] = LINSCHED_NO_FRAME;
+
+    /* duplicate and invalid identifiers */
+    entry.payload[2] = 0x10u;
+    TEST_ASSERT_EQUAL(0u, linsched_nr_of_associated(&entry));
+    entry.payload[2] = 0x40u;
+    TEST_ASSERT_EQUAL(0u, linsched_nr_of_associated(&entry));
+
+    /* an empty list */
+    memset(entry.payload, LINSCHED_NO_FRAME, sizeof(entry.payload));
+    TEST_ASSERT_EQUAL(0u, linsched_nr_of_associated(&entry));
+    TEST_ASSERT(!linsched_entry_valid(&entry, 1000u));
+
+    /* a sporadic entry does not use its frame identifier and data length */
+    entry.type = LINSCHED_SPORADIC;
+    entry.frameid = 0xFFu;
+    entry.datalength = 0u;
+    entry.payload[0] = 0x20u;
+    TEST_ASSERT(linsched_entry_valid(&entry, 1000u));
+}
+
+static void test_event_no_response(void) {
+    linsched_entry_t entry;
+    linsched_event_result_t results[LINSCHED_MAX_ASSOCIATED];
+    uint8_t nr_of_results = 0xFFu;
+
+    setup_event(&entry);
+    fake_frames[0x3Au].status = MLX_FAIL_RX_TIMEOUT;
+
+    TEST_ASSERT_EQUAL(LINSCHED_EVENT_NONE, linsched_event_execute(&entry, fake_s2m, NULL, results, &nr_of_results));
+    TEST_ASSERT_EQUAL(0u, nr_of_results);
+    TEST_ASSERT_EQUAL(1u, fake_nr_of_calls);
+}
+
+static void test_event_response(void) {
+    linsched_entry_t entry;
+    linsched_event_result_t results[LINSCHED_MAX_ASSOCIATED];
+    uint8_t nr_of_results = 0u;
+
+    setup_event(&entry);
+    memcpy(fake_frames[0x3Au].data, fake_frames[0x11u].data, sizeof(fake_frames[0x3Au].data));
+
+    TEST_ASSERT_EQUAL(LINSCHED_EVENT_RESPONSE,
+                      linsched_event_execute(&entry, fake_s2m, NULL, results, &nr_of_results));
+    TEST_ASSERT_EQUAL(1u, nr_of_results);
+    TEST_ASSERT_EQUAL(1u, fake_nr_of_calls);
+    TEST_ASSERT_EQUAL(0x11u, results[0].frameid);
+    TEST_ASSERT_EQUAL(MLX_OK, results[0].status);
+    TEST_ASSERT_EQUAL(4u, results[0].datalength);
+    TEST_ASSERT_EQUAL(0xA1u, results[0].data[1]);
+}
+
+static void test_event_collision(void) {
+    const int16_t collisions[] = {MLX_FAIL_TX_COLLISION, MLX_FAIL_RX_STOPBIT, MLX_FAIL_CHECKSUM, MLX_OK};
+    linsched_entry_t entry;
+    linsched_event_result_t results[LINSCHED_MAX_ASSOCIATED];
+    uint8_t nr_of_results = 0u;
+
+    for (uint8_t c = 0u; c < (sizeof(collisions) / sizeof(collisions[0])); c++) {
+        /* MLX_OK: a valid checksum but no associated protected identifier */
+        setup_event(&entry);
+        fake_frames[0x3Au].status = collisions[c];
+        fake_frames[0x3Au].data[0] = 0x55u;
+        fake_frames[0x12u].status = MLX_FAIL_RX_TIMEOUT;
+
+        TEST_ASSERT_EQUAL(LINSCHED_EVENT_COLLISION,
+                          linsched_event_execute(&entry, fake_s2m, NULL, results, &nr_of_results));
+
+        /* all associated frames are handled in order, in the same transaction */
+        TEST_ASSERT_EQUAL(3u, nr_of_results);
+        TEST_ASSERT_EQUAL(4u, fake_nr_of_calls);
+        TEST_ASSERT_EQUAL(0x3Au, fake_calls[0]);
+        for (uint8_t i = 0u; i < 3u; i++) {
+            TEST_ASSERT_EQUAL(0x10u + i, fake_calls[i + 1u]);
+            TEST_ASSERT_EQUAL(0x10u + i, results[i].frameid);
+        }
+        TEST_ASSERT_EQUAL(MLX_OK, results[0].status);
+        TEST_ASSERT_EQUAL(4u, results[0].datalength);
+        TEST_ASSERT_EQUAL(0xA0u, results[0].data[1]);
+        TEST_ASSERT_EQUAL(0xA1u, results[1].data[1]);
+        TEST_ASSERT_EQUAL(MLX_FAIL_RX_TIMEOUT, results[2].status);
+        TEST_ASSERT_EQUAL(0u, results[2].datalength);
+    }
+}
+
+static void test_event_error(void) {
+    linsched_entry_t entry;
+    linsched_event_result_t results[LINSCHED_MAX_ASSOCIATED];
+    uint8_t nr_of_results = 0u;
+
+    setup_event(&entry);
+    fake_frames[0x3Au].status = MLX_FAIL_TX_BUS_DRV_ERROR;
+
+    TEST_ASSERT_EQUAL(LINSCHED_EVENT_ERROR, linsched_event_execute(&entry, fake_s2m, NULL, results, &nr_of_results));
+    TEST_ASSERT_EQUAL(1u, nr_of_results);
+    TEST_ASSERT_EQUAL(1u, fake_nr_of_calls);
+    TEST_ASSERT_EQUAL(MLX_FAIL_TX_BUS_DRV_ERROR, results[0].status);
+}
+
+static void test_sporadic_select(void) {
+    linsched_entry_t entry;
+
+    memset(&entry, 0, sizeof(entry));
+    entry.type = LINSCHED_SPORADIC;
+    memset(entry.payload, LINSCHED_NO_FRAME, sizeof(entry.payload));
+    entry.payload[0] = 0x21u;
+    entry.payload[1] = 0x3Fu;
+    entry.payload[2] = 0x00u;
+
+    TEST_ASSERT_EQUAL(LINSCHED_NO_FRAME, linsched_sporadic_select(&entry, 0u));
+    TEST_ASSERT_EQUAL(LINSCHED_NO_FRAME, linsched_sporadic_select(&entry, 1ull << 0x22u));
+    TEST_ASSERT_EQUAL(0x00u, linsched_sporadic_select(&entry, 1ull << 0x00u));
+    TEST_ASSERT_EQUAL(0x3Fu, linsched_sporadic_select(&entry, (1ull << 0x00u) | (1ull << 0x3Fu)));
+
+    /* the first associated frame has the highest priority */
+    TEST_ASSERT_EQUAL(0x21u, linsched_sporadic_select(&entry, (1ull << 0x21u) | (1ull << 0x3Fu) | 1ull));
+}
+
+int main(void) {
+    RUN_TEST(test_entry_validation);
+    RUN_TEST(test_nominal_slot_starts);
+    RUN_TEST(test_switch_at_slot_boundary);
+    RUN_TEST(test_overrun_restarts_timing);
+    RUN_TEST(test_protected_id);
+    RUN_TEST(test_associated_validation);
+    RUN_TEST(test_event_no_response);
+    RUN_TEST(test_event_response);
+    RUN_TEST(test_event_collision);
+    RUN_TEST(test_event_error);
+    RUN_TEST(test_sporadic_select);
+
+    return (test_failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,242 @@
+/**
+ * @file
+ * @brief LIN signal database host tests.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @details Host tests for the signal database: validation of the upload format, extraction of
+ * signals at arbitrary bit offsets, scaling and change detection.
+ */
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lin_signal_db.h"
+
+#include "test_helpers.h"
+
+/** upload blob under construction */
+typedef struct test_blob_s {
+    uint8_t data[sizeof(linsig_blob_header_t) +
+                 (4u * sizeof(linsig_blob_frame_t)) +
+                 (16u * sizeof(linsig_blob_signal_t))];
+    size_t length;
+    linsig_blob_header_t header;
+    linsig_blob_frame_t frames[4];
+    linsig_blob_signal_t signals[16];
+} test_blob_t;
+
+static linsig_db_t db;
+
+static void blob_frame(test_blob_t *blob, uint8_t frameid, uint8_t datalength) {
+    linsig_blob_frame_t *frame = &blob->frames[blob->header.nr_of_frames];
+    memset(frame, 0, sizeof(*frame));
+    frame->frameid = frameid;
+    frame->datalength = datalength;
+    blob->header.nr_of_frames++;
+}
+
+static void blob_signal(test_blob_t *blob,
+                        const char *name,
+                        uint8_t start_bit,
+                        uint8_t width,
+                        uint8_t encoding,
+                        float factor,
+                        float offset) {
+    linsig_blob_signal_t *signal = &blob->signals[blob->header.nr_of_signals];
+    memset(signal, 0, sizeof(*signal));
+    strncpy(signal->name, name, LINSIG_NAME_LEN);
+    signal->start_bit = start_bit;
+    signal->width = width;
+    signal->encoding = encoding;
+    signal->factor = factor;
+    signal->offset = offset;
+    blob->frames[blob->header.nr_of_frames - 1u].nr_of_signals++;
+    blob->header.nr_of_signals++;
+}
+
+/** Serialize the blob, misaligned by one byte to check the unaligned access */
+static const uint8_t *blob_finish(test_blob_t *blob) {
+    uint8_t *out = &blob->data[0];
+    size_t offset = 0u;
+
+    blob->header.version = LINSIG_FORMAT_VERSION;
+    memcpy(&out[offset], &blob->header, sizeof(blob->header));
+    offset += sizeof(blob->header);
+    memcpy(&out[offset], blob->frames, blob->header.nr_of_frames * sizeof(linsig_blob_frame_t));
+    offset += blob->header.nr_of_frames * sizeof(linsig_blob_frame_t);
+    memcpy(&out[offset], blob->signals, blob->header.nr_of_signals * sizeof(linsig_blob_signal_t));
+    offset += blob->header.nr_of_signals * sizeof(linsig_blob_signal_t);
+    blob->length = offset;
+
+    return out;
+}
+
+static bool blob_load(test_blob_t *blob) {
+    const uint8_t *data = blob_finish(blob);
+    uint8_t *misaligned = malloc(blob->length + 1u);
+    memcpy(&misaligned[1], data, blob->length);
+    bool retval = linsig_db_load(&db, &misaligned[1], blob->length);
+    free(misaligned);
+    return retval;
+}
+
+static void build_valid(test_blob_t *blob) {
+    memset(blob, 0, sizeof(*blob));
+    blob_frame(blob, 0x10u, 8u);
+    blob_signal(blob, "Speed", 0u, 16u, LINSIG_ENCODING_PHYSICAL, 0.5f, -10.0f);
+    blob_signal(blob, "Mode", 16u, 3u, LINSIG_ENCODING_RAW, 1.0f, 0.0f);
+    blob_signal(blob, "Straddle", 29u, 7u, LINSIG_ENCODING_RAW, 1.0f, 0.0f);
+    blob_signal(blob, "Counter", 32u, 32u, LINSIG_ENCODING_RAW, 1.0f, 0.0f);
+    blob_frame(blob, 0x21u, 2u);
+    blob_signal(blob, "Flag", 15u, 1u, LINSIG_ENCODING_RAW, 1.0f, 0.0f);
+}
+
+static void test_load(void) {
+    test_blob_t blob;
+
+    build_valid(&blob);
+    TEST_ASSERT(blob_load(&blob));
+    TEST_ASSERT_EQUAL(2u, db.nr_of_frames);
+    TEST_ASSERT_EQUAL(5u, db.nr_of_signals);
+    TEST_ASSERT_EQUAL(0, linsig_db_find(&db, "Speed"));
+    TEST_ASSERT_EQUAL(4, linsig_db_find(&db, "Flag"));
+    TEST_ASSERT_EQUAL(-1, linsig_db_find(&db, "Unknown"));
+    TEST_ASSERT_EQUAL(0x7Fu, db.signals[2].mask);
+    TEST_ASSERT_EQUAL(UINT32_MAX, db.signals[3].mask);
+
+    /* an empty database is valid */
+    memset(&blob, 0, sizeof(blob));
+    TEST_ASSERT(blob_load(&blob));
+    TEST_ASSERT_EQUAL(0u, db.nr_of_signals);
+
+    /* wrong version */
+    build_valid(&blob);
+    (void)blob_finish(&blob);
+    blob.data[0] = LINSIG_FORMAT_VERSION + 1u;
+    TEST_ASSERT(!linsig_db_load(&db, blob.data, blob.length));
+
+    /* length mismatch */
+    TEST_ASSERT(!linsig_db_load(&db, blob.data, blob.length - 1u));
+    TEST_ASSERT(!linsig_db_load(&db, blob.data, 2u));
+
+    /* signal exceeding the frame */
+    build_valid(&blob);
+    blob.signals[4].start_bit = 15u;
+    blob.signals[4].width = 2u;
+    TEST_ASSERT(!blob_load(&blob));
+    TEST_ASSERT_EQUAL(0u, db.nr_of_signals);
+    TEST_ASSERT_EQUAL(LINSIG_NO_FRAME, db.frame_of_id[0x10u]);
+
+    /* invalid width */
+    build_valid(&blob);
+    blob.signals[1].width = 0u;
+    TEST_ASSERT(!blob_load(&blob));
+    build_valid(&blob);
+    blob.signals[3].start_bit = 24u;
+    blob.signals[3].width = 33u;
+    TEST_ASSERT(!blob_load(&blob));
+
+    /* duplicate signal name */
+    build_valid(&blob);
+    strncpy(blob.signals[4].name, "Mode", LINSIG_NAME_LEN);
+    TEST_ASSERT(!blob_load(&blob));
+
+    /* name without terminating zero */
+    build_valid(&blob);
+    memset(blob.signals[0].name, 'A', LINSIG_NAME_LEN);
+    TEST_ASSERT(!blob_load(&blob));
+
+    /* duplicate frame identifier */
+    build_valid(&blob);
+    blob.frames[1].frameid = 0x10u;
+    TEST_ASSERT(!blob_load(&blob));
+
+    /* invalid encoding */
+    build_valid(&blob);
+    blob.signals[0].encoding = 2u;
+    TEST_ASSERT(!blob_load(&blob));
+
+    /* signal counts of the frames do not add up */
+    build_valid(&blob);
+    blob.frames[0].nr_of_signals--;
+    TEST_ASSERT(!blob_load(&blob));
+}
+
+static void test_decode(void) {
+    test_blob_t blob;
+    linsig_value_t values[8];
+    linsig_value_t value;
+
+    build_valid(&blob);
+    TEST_ASSERT(blob_load(&blob));
+
+    /* nothing received yet */
+    TEST_ASSERT(!linsig_db_value(&db, 0u, &value));
+    TEST_ASSERT_EQUAL(0u, linsig_db_collect(&db, values, 8u));
+
+    const uint8_t frame[8] = {0x34u, 0x12u, 0x05u, 0xA0u, 0x78u, 0x56u, 0x34u, 0x12u};
+    TEST_ASSERT_EQUAL(4u, linsig_db_update(&db, 0x10u, frame, 8u));
+    TEST_ASSERT_EQUAL(4u, linsig_db_collect(&db, values, 8u));
+
+    TEST_ASSERT_EQUAL(0u, values[0].index);
+    TEST_ASSERT_EQUAL(0x10u, values[0].frameid);
+    TEST_ASSERT_EQUAL(0x1234u, values[0].raw);
+    TEST_ASSERT(values[0].value == ((float)0x1234u * 0.5f) - 10.0f);
+    TEST_ASSERT_EQUAL(5u, values[1].raw);
+    /* bits 29..35: 3 bits of byte 3 (0xA0 >> 5) and 4 bits of byte 4 (0x78 & 0x0F) */
+    TEST_ASSERT_EQUAL(0x05u | (0x08u << 3), values[2].raw);
+    TEST_ASSERT_EQUAL(0x12345678u, values[3].raw);
+    TEST_ASSERT_EQUAL(LINSIG_ENCODING_RAW, values[3].encoding);
+
+    /* unchanged frame, no changes */
+    TEST_ASSERT_EQUAL(0u, linsig_db_update(&db, 0x10u, frame, 8u));
+    TEST_ASSERT_EQUAL(0u, linsig_db_collect(&db, values, 8u));
+
+    /* only the changed signal is reported */
+    uint8_t changed[8];
+    memcpy(changed, frame, sizeof(changed));
+    changed[2] = 0x06u;
+    TEST_ASSERT_EQUAL(1u, linsig_db_update(&db, 0x10u, changed, 8u));
+    TEST_ASSERT_EQUAL(1u, linsig_db_collect(&db, values, 8u));
+    TEST_ASSERT_EQUAL(1u, values[0].index);
+    TEST_ASSERT_EQUAL(6u, values[0].raw);
+
+    /* frames which are unknown or have a different length are ignored */
+    TEST_ASSERT_EQUAL(0u, linsig_db_update(&db, 0x11u, frame, 8u));
+    TEST_ASSERT_EQUAL(0u, linsig_db_update(&db, 0x21u, frame, 8u));
+    TEST_ASSERT_EQUAL(0u, linsig_db_update(&db, 0x40u, frame, 8u));
+
+    const uint8_t flag[2] = {0x00u, 0x80u};
+    TEST_ASSERT_EQUAL(1u, linsig_db_update(&db, 0x21u, flag, 2u));
+    TEST_ASSERT(linsig_db_value(&db, 4u, &value));
+    TEST_ASSERT_EQUAL(1u, value.raw);
+    TEST_ASSERT_EQUAL(0x21u, value.frameid);
+
+    /* collection is limited and continues where it stopped */
+    changed[0] = 0x00u;
+    changed[2] = 0x07u;
+    TEST_ASSERT_EQUAL(2u, linsig_db_update(&db, 0x10u, changed, 8u));
+    TEST_ASSERT_EQUAL(1u, linsig_db_collect(&db, values, 1u));
+    TEST_ASSERT_EQUAL(0u, values[0].index);
+    TEST_ASSERT_EQUAL(2u, linsig_db_collect(&db, values, 8u));
+    TEST_ASSERT_EQUAL(1u, values[0].index);
+    TEST_ASSERT_EQUAL(4u, values[1].index);
+}
+
+int main(void) {
+    RUN_TEST(test_load);
+    RUN_TEST(test_decode);
+
+    return (test_failures == 0) ? 0 : 1;
+}
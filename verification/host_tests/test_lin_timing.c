@@ -0,0 +1,260 @@
+/**
+ * @file
+ * @brief LIN frame timing statistics host tests.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @details Host tests for the frame timing statistics: nominal frame times, min/avg/max, the
+ * maximum frame time check, the histogram of time above nominal and the frame phases taken from the
+ * bus echo.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lin_timing_stats.h"
+
+#include "test_helpers.h"
+
+static lintiming_stats_t stats;
+
+static void test_nominal(void) {
+    uint32_t header_us;
+    uint32_t response_us;
+
+    /* 34 bit times header, 10 * (N + 1) bit times response */
+    lintiming_nominal(19200u, 8u, &header_us, &response_us);
+    TEST_ASSERT_EQUAL(1771u, header_us);
+    TEST_ASSERT_EQUAL(4688u, response_us);
+
+    lintiming_nominal(10000u, 2u, &header_us, &response_us);
+    TEST_ASSERT_EQUAL(3400u, header_us);
+    TEST_ASSERT_EQUAL(3000u, response_us);
+
+    lintiming_nominal(0u, 2u, &header_us, &response_us);
+    TEST_ASSERT_EQUAL(0u, header_us);
+    TEST_ASSERT_EQUAL(0u, response_us);
+}
+
+static void test_empty(void) {
+    lintiming_entry_t entry;
+
+    lintiming_stats_clear(&stats);
+    for (uint8_t frameid = 0u; frameid < LINTIMING_NR_OF_FRAMES; frameid++) {
+        TEST_ASSERT(!lintiming_stats_get(&stats, frameid, &entry));
+    }
+    TEST_ASSERT(!lintiming_stats_get(&stats, 64u, &entry));
+
+    /* invalid frame identifiers are ignored */
+    lintiming_stats_record(&stats, 64u, 19200u, 8u, true, 6000u);
+    TEST_ASSERT(!lintiming_stats_get(&stats, 64u, &entry));
+}
+
+static void test_min_avg_max(void) {
+    lintiming_entry_t entry;
+
+    lintiming_stats_clear(&stats);
+    lintiming_stats_record(&stats, 0x10u, 10000u, 2u, true, 6500u);
+    lintiming_stats_record(&stats, 0x10u, 10000u, 2u, true, 6420u);
+    lintiming_stats_record(&stats, 0x10u, 10000u, 2u, true, 7000u);
+    lintiming_stats_record(&stats, 0x10u, 10000u, 2u, false, 100u);
+
+    TEST_ASSERT(lintiming_stats_get(&stats, 0x10u, &entry));
+    TEST_ASSERT_EQUAL(0x10u, entry.frameid);
+    TEST_ASSERT_EQUAL(10000u, entry.baudrate);
+    TEST_ASSERT_EQUAL(2u, entry.datalength);
+    TEST_ASSERT_EQUAL(3u, entry.count);
+    TEST_ASSERT_EQUAL(1u, entry.errors);
+    TEST_ASSERT_EQUAL(6420u, entry.min_us);
+    TEST_ASSERT_EQUAL(6640u, entry.avg_us);
+    TEST_ASSERT_EQUAL(7000u, entry.max_us);
+    TEST_ASSERT_EQUAL(6400u, entry.nominal_us);
+    TEST_ASSERT_EQUAL(0u, entry.over_max);
+
+    /* other frames are not affected */
+    TEST_ASSERT(!lintiming_stats_get(&stats, 0x11u, &entry));
+
+    /* a frame which only failed is reported without measurements */
+    lintiming_stats_record(&stats, 0x11u, 10000u, 2u, false, 100u);
+    TEST_ASSERT(lintiming_stats_get(&stats, 0x11u, &entry));
+    TEST_ASSERT_EQUAL(0u, entry.count);
+    TEST_ASSERT_EQUAL(1u, entry.errors);
+    TEST_ASSERT_EQUAL(0u, entry.avg_us);
+}
+
+static void test_over_max(void) {
+    lintiming_entry_t entry;
+
+    /* nominal 6400 us, maximum frame time 8960 us */
+    lintiming_stats_clear(&stats);
+    lintiming_stats_record(&stats, 0x20u, 10000u, 2u, true, 8960u);
+    lintiming_stats_record(&stats, 0x20u, 10000u, 2u, true, 8961u);
+
+    TEST_ASSERT(lintiming_stats_get(&stats, 0x20u, &entry));
+    TEST_ASSERT_EQUAL(1u, entry.over_max);
+}
+
+static void test_histogram(void) {
+    const uint32_t above[] = {0u, 49u, 50u, 99u, 100u, 199u, 499u, 500u, 999u, 1999u, 4999u, 5000u, 100000u};
+    const uint32_t expected[LINTIMING_HISTOGRAM_BINS] = {2u, 2u, 2u, 1u, 2u, 1u, 1u, 2u};
+    lintiming_entry_t entry;
+
+    lintiming_stats_clear(&stats);
+    /* faster than nominal counts as no time above nominal */
+    lintiming_stats_record(&stats, 0x30u, 10000u, 2u, true, 6000u);
+    for (uint32_t i = 0u; i < (sizeof(above) / sizeof(above[0])); i++) {
+        lintiming_stats_record(&stats, 0x30u, 10000u, 2u, true, 6400u + above[i]);
+    }
+
+    TEST_ASSERT(lintiming_stats_get(&stats, 0x30u, &entry));
+    TEST_ASSERT_EQUAL(1u + (sizeof(above) / sizeof(above[0])), entry.count);
+    for (uint8_t bin = 0u; bin < LINTIMING_HISTOGRAM_BINS; bin++) {
+        TEST_ASSERT_EQUAL(expected[bin] + ((bin == 0u) ? 1u : 0u), entry.histogram[bin]);
+    }
+}
+
+/** Fill a bus echo of a frame at 10 kbit/s (byte time 1000 us)
+ *
+ * @param[out]  echo  bus echo to fill.
+ * @param[in]  datalength  number of data bytes.
+ */
+static void fill_echo(lintiming_echo_t *echo, uint8_t datalength) {
+    lintiming_echo_init(echo);
+    /* zero byte of the break field and bytes before the break are ignored */
+    lintiming_echo_byte(echo, 0x55u, 10u);
+    lintiming_echo_break(echo, 100u);
+    lintiming_echo_byte(echo, 0x00u, 1400u);
+    /* break and delimiter 1400 us, sync, 50 us space, protected identifier */
+    lintiming_echo_byte(echo, 0x55u, 2500u);
+    lintiming_echo_byte(echo, 0x50u, 3550u);
+    /* response space 300 us, inter-byte spaces of 0, 20 and 80 us */
+    uint32_t end_us = 3850u;
+    for (uint8_t i = 0u; i <= datalength; i++) {
+        end_us += 1000u + ((i == 1u) ? 20u : 0u) + ((i == 2u) ? 80u : 0u);
+        lintiming_echo_byte(echo, i, end_us);
+    }
+}
+
+static void test_echo(void) {
+    lintiming_echo_t echo;
+
+    fill_echo(&echo, 2u);
+    TEST_ASSERT(echo.break_seen);
+    TEST_ASSERT_EQUAL(100u, echo.break_us);
+    TEST_ASSERT_EQUAL(5u, echo.count);
+    TEST_ASSERT_EQUAL(0x55u, echo.bytes[0]);
+    TEST_ASSERT_EQUAL(0x50u, echo.bytes[1]);
+    TEST_ASSERT_EQUAL(2500u, echo.byte_us[0]);
+
+    /* a second break field does not restart the echo */
+    lintiming_echo_break(&echo, 9000u);
+    TEST_ASSERT_EQUAL(100u, echo.break_us);
+
+    /* bytes beyond a full frame are ignored */
+    for (uint8_t i = 0u; i < 20u; i++) {
+        lintiming_echo_byte(&echo, i, 10000u + i);
+    }
+    TEST_ASSERT_EQUAL(LINTIMING_ECHO_MAX_BYTES, echo.count);
+}
+
+static void test_phases(void) {
+    lintiming_echo_t echo;
+    lintiming_phases_t phases;
+
+    fill_echo(&echo, 2u);
+    TEST_ASSERT(lintiming_phases_analyze(&echo, 10000u, 2u, 7500u, &phases));
+    TEST_ASSERT_EQUAL(100u, phases.timestamps.break_us);
+    TEST_ASSERT_EQUAL(2500u, phases.timestamps.sync_us);
+    TEST_ASSERT_EQUAL(3550u, phases.timestamps.pid_us);
+    TEST_ASSERT_EQUAL(3850u, phases.timestamps.response_us);
+    TEST_ASSERT_EQUAL(6950u, phases.timestamps.checksum_us);
+    TEST_ASSERT_EQUAL(7500u, phases.timestamps.end_us);
+    TEST_ASSERT_EQUAL(100u, phases.duration_us[LINTIMING_PHASE_SETUP]);
+    TEST_ASSERT_EQUAL(1400u, phases.duration_us[LINTIMING_PHASE_BREAK]);
+    TEST_ASSERT_EQUAL(1050u, phases.duration_us[LINTIMING_PHASE_SYNC]);
+    TEST_ASSERT_EQUAL(3450u, phases.duration_us[LINTIMING_PHASE_HEADER]);
+    TEST_ASSERT_EQUAL(300u, phases.duration_us[LINTIMING_PHASE_RESPONSE_SPACE]);
+    TEST_ASSERT_EQUAL(80u, phases.duration_us[LINTIMING_PHASE_INTERBYTE]);
+    TEST_ASSERT_EQUAL(3100u, phases.duration_us[LINTIMING_PHASE_RESPONSE]);
+    TEST_ASSERT_EQUAL(550u, phases.duration_us[LINTIMING_PHASE_COMPLETION]);
+    TEST_ASSERT(strcmp("response_space", lintiming_phase_name(LINTIMING_PHASE_RESPONSE_SPACE)) == 0);
+    TEST_ASSERT(strcmp("unknown", lintiming_phase_name(LINTIMING_NR_OF_PHASES)) == 0);
+
+    /* a longer frame than echoed is incomplete */
+    TEST_ASSERT(!lintiming_phases_analyze(&echo, 10000u, 3u, 7500u, &phases));
+    TEST_ASSERT(!lintiming_phases_analyze(&echo, 0u, 2u, 7500u, &phases));
+
+    /* no break field */
+    lintiming_echo_init(&echo);
+    lintiming_echo_byte(&echo, 0x55u, 10u);
+    TEST_ASSERT_EQUAL(0u, echo.count);
+    TEST_ASSERT(!lintiming_phases_analyze(&echo, 10000u, 0u, 7500u, &phases));
+}
+
+static void test_phase_stats(void) {
+    lintiming_echo_t echo;
+    lintiming_phases_t phases;
+    lintiming_phase_entry_t entry;
+
+    lintiming_stats_clear(&stats);
+    TEST_ASSERT(!lintiming_stats_get_phases(&stats, 0x10u, &entry));
+    TEST_ASSERT(!lintiming_stats_get_phases(&stats, 64u, &entry));
+
+    lintiming_stats_record_phases(&stats, 0x10u, NULL);
+    TEST_ASSERT(lintiming_stats_get_phases(&stats, 0x10u, &entry));
+    TEST_ASSERT_EQUAL(0x10u, entry.frameid);
+    TEST_ASSERT_EQUAL(0u, entry.count);
+    TEST_ASSERT_EQUAL(1u, entry.missed);
+    TEST_ASSERT_EQUAL(0u, entry.phases[LINTIMING_PHASE_HEADER].avg_us);
+
+    fill_echo(&echo, 2u);
+    TEST_ASSERT(lintiming_phases_analyze(&echo, 10000u, 2u, 7500u, &phases));
+    lintiming_stats_record_phases(&stats, 0x10u, &phases);
+    phases.duration_us[LINTIMING_PHASE_RESPONSE_SPACE] = 500u;
+    phases.timestamps.end_us = 8000u;
+    lintiming_stats_record_phases(&stats, 0x10u, &phases);
+
+    TEST_ASSERT(lintiming_stats_get_phases(&stats, 0x10u, &entry));
+    TEST_ASSERT_EQUAL(2u, entry.count);
+    TEST_ASSERT_EQUAL(1u, entry.missed);
+    TEST_ASSERT_EQUAL(300u, entry.phases[LINTIMING_PHASE_RESPONSE_SPACE].min_us);
+    TEST_ASSERT_EQUAL(400u, entry.phases[LINTIMING_PHASE_RESPONSE_SPACE].avg_us);
+    TEST_ASSERT_EQUAL(500u, entry.phases[LINTIMING_PHASE_RESPONSE_SPACE].max_us);
+    TEST_ASSERT_EQUAL(3450u, entry.phases[LINTIMING_PHASE_HEADER].min_us);
+    TEST_ASSERT_EQUAL(3450u, entry.phases[LINTIMING_PHASE_HEADER].max_us);
+    TEST_ASSERT_EQUAL(8000u, entry.last.end_us);
+
+    /* the frame statistics are kept apart */
+    lintiming_entry_t frame_entry;
+    TEST_ASSERT(!lintiming_stats_get(&stats, 0x10u, &frame_entry));
+}
+
+static void test_entry_size(void) {
+    /* the entries of all frames fit in one bulk response */
+    TEST_ASSERT((sizeof(lintiming_entry_t) * LINTIMING_NR_OF_FRAMES) <= 4096u);
+    TEST_ASSERT_EQUAL(132u, sizeof(lintiming_phase_entry_t));
+}
+
+int main(void) {
+    RUN_TEST(test_nominal);
+    RUN_TEST(test_empty);
+    RUN_TEST(test_min_avg_max);
+    RUN_TEST(test_over_max);
+    RUN_TEST(test_histogram);
+    RUN_TEST(test_echo);
+    RUN_TEST(test_phases);
+    RUN_TEST(test_phase_stats);
+    RUN_TEST(test_entry_size);
+
+    return (test_failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,174 @@
+/**
+ * @file
+ * @brief LIN diagnostic transport layer host tests.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @details Host tests for the segmentation and reassembly of diagnostic messages: single frames,
+ * first and consecutive frames up to the maximum message length, frame counter wrap around and the
+ * transport layer error cases.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "lin_transport_frame.h"
+#include "mlx_err.h"
+
+#include "test_helpers.h"
+
+static uint8_t message[LINTP_MAX_MESSAGE_LEN];
+static uint8_t received[LINTP_MAX_MESSAGE_LEN];
+
+/** Segment a message and feed all frames to the reassembly, returns the number of frames */
+static int round_trip(uint16_t length, int *rx_state) {
+    lintp_tx_t tx;
+    lintp_rx_t rx;
+    uint8_t frame[LINTP_FRAME_LEN];
+    int frames = 0;
+
+    for (uint16_t i = 0u; i < length; i++) {
+        message[i] = (uint8_t)(i * 7u + 3u);
+    }
+    memset(received, 0, sizeof(received));
+
+    TEST_ASSERT(lintp_tx_init(&tx, 0x12u, message, length));
+    lintp_rx_init(&rx, 0x12u, received, sizeof(received));
+    *rx_state = LINTP_RX_PENDING;
+    while (lintp_tx_next(&tx, frame)) {
+        TEST_ASSERT_EQUAL(0x12u, frame[0]);
+        TEST_ASSERT_EQUAL(LINTP_RX_PENDING, *rx_state);
+        *rx_state = lintp_rx_frame(&rx, frame);
+        frames++;
+    }
+    TEST_ASSERT_EQUAL(length, rx.length);
+    TEST_ASSERT(memcmp(message, received, length) == 0);
+
+    return frames;
+}
+
+static void test_single_frame(void) {
+    lintp_tx_t tx;
+    uint8_t frame[LINTP_FRAME_LEN];
+    const uint8_t request[] = {0xB2u, 0x00u, 0xFFu, 0x7Fu};
+
+    TEST_ASSERT(lintp_tx_init(&tx, 0x7Fu, request, sizeof(request)));
+    TEST_ASSERT(lintp_tx_next(&tx, frame));
+    const uint8_t expected[LINTP_FRAME_LEN] = {0x7Fu, 0x04u, 0xB2u, 0x00u, 0xFFu, 0x7Fu, 0xFFu, 0xFFu};
+    TEST_ASSERT(memcmp(expected, frame, LINTP_FRAME_LEN) == 0);
+    TEST_ASSERT(!lintp_tx_next(&tx, frame));
+
+    int rx_state;
+    TEST_ASSERT_EQUAL(1, round_trip(1u, &rx_state));
+    TEST_ASSERT_EQUAL(LINTP_RX_COMPLETE, rx_state);
+    TEST_ASSERT_EQUAL(1, round_trip(6u, &rx_state));
+    TEST_ASSERT_EQUAL(LINTP_RX_COMPLETE, rx_state);
+}
+
+static void test_segmented_message(void) {
+    lintp_tx_t tx;
+    uint8_t frame[LINTP_FRAME_LEN];
+
+    TEST_ASSERT(lintp_tx_init(&tx, 0x12u, message, 13u));
+    TEST_ASSERT(lintp_tx_next(&tx, frame));
+    TEST_ASSERT_EQUAL(0x10u, frame[1]);
+    TEST_ASSERT_EQUAL(13u, frame[2]);
+    TEST_ASSERT(lintp_tx_next(&tx, frame));
+    TEST_ASSERT_EQUAL(0x21u, frame[1]);
+    TEST_ASSERT(lintp_tx_next(&tx, frame));
+    TEST_ASSERT_EQUAL(0x22u, frame[1]);
+    /* last consecutive frame holds 2 bytes, the rest is padded */
+    TEST_ASSERT_EQUAL(0xFFu, frame[4]);
+    TEST_ASSERT_EQUAL(0xFFu, frame[7]);
+    TEST_ASSERT(!lintp_tx_next(&tx, frame));
+
+    int rx_state;
+    TEST_ASSERT_EQUAL(2, round_trip(7u, &rx_state));
+    TEST_ASSERT_EQUAL(LINTP_RX_COMPLETE, rx_state);
+    TEST_ASSERT_EQUAL(3, round_trip(13u, &rx_state));
+    TEST_ASSERT_EQUAL(LINTP_RX_COMPLETE, rx_state);
+    TEST_ASSERT_EQUAL(1 + ((4095 - 5 + 5) / 6), round_trip(LINTP_MAX_MESSAGE_LEN, &rx_state));
+    TEST_ASSERT_EQUAL(LINTP_RX_COMPLETE, rx_state);
+}
+
+static void test_frame_counter_wraps(void) {
+    lintp_tx_t tx;
+    uint8_t frame[LINTP_FRAME_LEN];
+
+    TEST_ASSERT(lintp_tx_init(&tx, 0x12u, message, 200u));
+    TEST_ASSERT(lintp_tx_next(&tx, frame));
+    for (uint8_t cf = 1u; cf <= 17u; cf++) {
+        TEST_ASSERT(lintp_tx_next(&tx, frame));
+        TEST_ASSERT_EQUAL(0x20u | (cf & 0x0Fu), frame[1]);
+    }
+}
+
+static void test_invalid_lengths(void) {
+    lintp_tx_t tx;
+    lintp_rx_t rx;
+    uint8_t small[8];
+
+    TEST_ASSERT(!lintp_tx_init(&tx, 0x12u, message, 0u));
+    TEST_ASSERT(!lintp_tx_init(&tx, 0x12u, message, LINTP_MAX_MESSAGE_LEN + 1u));
+
+    const uint8_t sf_zero[LINTP_FRAME_LEN] = {0x12u, 0x00u, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu};
+    lintp_rx_init(&rx, 0x12u, received, sizeof(received));
+    TEST_ASSERT_EQUAL(MLX_FAIL_TL_INV_DATALEN, lintp_rx_frame(&rx, sf_zero));
+
+    const uint8_t ff_short[LINTP_FRAME_LEN] = {0x12u, 0x10u, 0x06u, 0x01u, 0x02u, 0x03u, 0x04u, 0x05u};
+    lintp_rx_init(&rx, 0x12u, received, sizeof(received));
+    TEST_ASSERT_EQUAL(MLX_FAIL_TL_INV_DATALEN, lintp_rx_frame(&rx, ff_short));
+
+    /* message does not fit the buffer */
+    const uint8_t ff_large[LINTP_FRAME_LEN] = {0x12u, 0x10u, 0x09u, 0x01u, 0x02u, 0x03u, 0x04u, 0x05u};
+    lintp_rx_init(&rx, 0x12u, small, sizeof(small));
+    TEST_ASSERT_EQUAL(MLX_FAIL_TL_INV_DATALEN, lintp_rx_frame(&rx, ff_large));
+}
+
+static void test_reception_errors(void) {
+    lintp_rx_t rx;
+
+    const uint8_t sf[LINTP_FRAME_LEN] = {0x13u, 0x02u, 0xF2u, 0x01u, 0xFFu, 0xFFu, 0xFFu, 0xFFu};
+    lintp_rx_init(&rx, 0x12u, received, sizeof(received));
+    TEST_ASSERT_EQUAL(MLX_FAIL_TL_INV_NAD, lintp_rx_frame(&rx, sf));
+
+    const uint8_t bad_pci[LINTP_FRAME_LEN] = {0x12u, 0x30u, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu};
+    lintp_rx_init(&rx, 0x12u, received, sizeof(received));
+    TEST_ASSERT_EQUAL(MLX_FAIL_TL_INV_PCI, lintp_rx_frame(&rx, bad_pci));
+
+    const uint8_t cf1[LINTP_FRAME_LEN] = {0x12u, 0x21u, 0x06u, 0x07u, 0x08u, 0x09u, 0x0Au, 0x0Bu};
+    lintp_rx_init(&rx, 0x12u, received, sizeof(received));
+    TEST_ASSERT_EQUAL(MLX_FAIL_TL_NOT_EXPECTED, lintp_rx_frame(&rx, cf1));
+
+    /* wildcard locks to the node which sent the first frame */
+    const uint8_t ff[LINTP_FRAME_LEN] = {0x12u, 0x10u, 0x10u, 0x01u, 0x02u, 0x03u, 0x04u, 0x05u};
+    const uint8_t cf2[LINTP_FRAME_LEN] = {0x12u, 0x22u, 0x06u, 0x07u, 0x08u, 0x09u, 0x0Au, 0x0Bu};
+    const uint8_t cf1_other[LINTP_FRAME_LEN] = {0x13u, 0x21u, 0x06u, 0x07u, 0x08u, 0x09u, 0x0Au, 0x0Bu};
+    lintp_rx_init(&rx, LINTP_NAD_WILDCARD, received, sizeof(received));
+    TEST_ASSERT_EQUAL(LINTP_RX_PENDING, lintp_rx_frame(&rx, ff));
+    TEST_ASSERT_EQUAL(MLX_FAIL_TL_INV_NAD, lintp_rx_frame(&rx, cf1_other));
+    TEST_ASSERT_EQUAL(MLX_FAIL_TL_INV_FRAMECOUNTER, lintp_rx_frame(&rx, cf2));
+    TEST_ASSERT_EQUAL(LINTP_RX_PENDING, lintp_rx_frame(&rx, cf1));
+    const uint8_t sf_same[LINTP_FRAME_LEN] = {0x12u, 0x02u, 0xF2u, 0x01u, 0xFFu, 0xFFu, 0xFFu, 0xFFu};
+    TEST_ASSERT_EQUAL(MLX_FAIL_TL_NOT_EXPECTED, lintp_rx_frame(&rx, sf_same));
+}
+
+int main(void) {
+    RUN_TEST(test_single_frame);
+    RUN_TEST(test_segmented_message);
+    RUN_TEST(test_frame_counter_wraps);
+    RUN_TEST(test_invalid_lengths);
+    RUN_TEST(test_reception_errors);
+
+    return (test_failures == 0) ? 0 : 1;
+}
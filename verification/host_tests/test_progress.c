@@ -0,0 +1,206 @@
+/**
+ * @file
+ * @brief Operation progress tracker host tests.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @details Host tests for the progress tracker: reported and estimated progress, the learned
+ * throughput, the report interval and the end of an operation.
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "progress_tracker.h"
+
+#include "test_helpers.h"
+
+static progress_tracker_t tracker;
+
+/** Progress reported by the caller, with the time left extrapolated from the throughput so far */
+static void test_reported(void) {
+    progress_tracker_init(&tracker, 100u);
+    progress_tracker_start(&tracker, PROGRESS_OP_OTA, 1000u);
+    TEST_ASSERT_EQUAL(PROGRESS_OP_OTA, tracker.report.operation);
+    TEST_ASSERT_EQUAL(PROGRESS_PHASE_PREPARE, tracker.report.phase);
+
+    progress_tracker_phase(&tracker, PROGRESS_PHASE_WRITE, 4096u, 1024u, 0u, 1500u);
+    TEST_ASSERT_EQUAL(0u, tracker.report.estimated);
+    TEST_ASSERT_EQUAL(4u, tracker.report.pages_total);
+    TEST_ASSERT_EQUAL(PROGRESS_ETA_UNKNOWN, tracker.report.eta_ms);
+    TEST_ASSERT_EQUAL(500u, tracker.report.elapsed_ms);
+
+    /* a quarter in 200 ms leaves 600 ms */
+    TEST_ASSERT(progress_tracker_update(&tracker, 1024u, 1700u));
+    TEST_ASSERT_EQUAL(1024u, tracker.report.bytes_done);
+    TEST_ASSERT_EQUAL(1u, tracker.report.pages_done);
+    TEST_ASSERT_EQUAL(600u, tracker.report.eta_ms);
+    TEST_ASSERT_EQUAL(700u, tracker.report.elapsed_ms);
+
+    /* more bytes than announced are capped */
+    (void)progress_tracker_update(&tracker, 5000u, 1900u);
+    TEST_ASSERT_EQUAL(4096u, tracker.report.bytes_done);
+    TEST_ASSERT_EQUAL(4u, tracker.report.pages_done);
+    TEST_ASSERT_EQUAL(0u, tracker.report.eta_ms);
+}
+
+/** Unknown totals report the bytes done without a time left */
+static void test_unknown_total(void) {
+    progress_tracker_init(&tracker, 100u);
+    progress_tracker_start(&tracker, PROGRESS_OP_OTA, 0u);
+    progress_tracker_phase(&tracker, PROGRESS_PHASE_WRITE, 0u, 0u, 0u, 0u);
+
+    (void)progress_tracker_update(&tracker, 123456u, 1000u);
+    TEST_ASSERT_EQUAL(123456u, tracker.report.bytes_done);
+    TEST_ASSERT_EQUAL(0u, tracker.report.pages_done);
+    TEST_ASSERT_EQUAL(PROGRESS_ETA_UNKNOWN, tracker.report.eta_ms);
+
+    /* without a total or throughput nothing is estimated */
+    (void)progress_tracker_tick(&tracker, 2000u);
+    TEST_ASSERT_EQUAL(123456u, tracker.report.bytes_done);
+    TEST_ASSERT_EQUAL(2000u, tracker.report.elapsed_ms);
+
+    progress_tracker_finish(&tracker, true, 2500u);
+    TEST_ASSERT_EQUAL(PROGRESS_PHASE_DONE, tracker.report.phase);
+    TEST_ASSERT_EQUAL(123456u, tracker.report.bytes_done);
+}
+
+/** Estimated progress of an opaque phase, which never reaches the total by itself */
+static void test_estimated(void) {
+    progress_tracker_init(&tracker, 100u);
+    progress_tracker_start(&tracker, PROGRESS_OP_BOOTLOADER, 0u);
+
+    /* 10 pages of 128 bytes at 640 bytes/s take 2 s */
+    progress_tracker_phase(&tracker, PROGRESS_PHASE_PROGRAM, 1280u, 128u, 640u, 0u);
+    TEST_ASSERT_EQUAL(1u, tracker.report.estimated);
+    TEST_ASSERT_EQUAL(10u, tracker.report.pages_total);
+    TEST_ASSERT_EQUAL(2000u, tracker.report.eta_ms);
+
+    TEST_ASSERT(progress_tracker_tick(&tracker, 500u));
+    TEST_ASSERT_EQUAL(320u, tracker.report.bytes_done);
+    TEST_ASSERT_EQUAL(2u, tracker.report.pages_done);
+    TEST_ASSERT_EQUAL(1500u, tracker.report.eta_ms);
+
+    /* slower than expected */
+    (void)progress_tracker_tick(&tracker, 2500u);
+    TEST_ASSERT_EQUAL(1279u, tracker.report.bytes_done);
+    TEST_ASSERT_EQUAL(9u, tracker.report.pages_done);
+    TEST_ASSERT_EQUAL(PROGRESS_ETA_UNKNOWN, tracker.report.eta_ms);
+
+    progress_tracker_phase_end(&tracker, 4000u);
+    TEST_ASSERT_EQUAL(0u, tracker.report.estimated);
+    TEST_ASSERT_EQUAL(1280u, tracker.report.bytes_done);
+    TEST_ASSERT_EQUAL(10u, tracker.report.pages_done);
+    TEST_ASSERT_EQUAL(0u, tracker.report.eta_ms);
+}
+
+/** The throughput of a completed phase replaces the default of the next run */
+static void test_learned_rate(void) {
+    progress_tracker_init(&tracker, 100u);
+    progress_tracker_start(&tracker, PROGRESS_OP_BOOTLOADER, 0u);
+    progress_tracker_phase(&tracker, PROGRESS_PHASE_VERIFY, 2048u, 128u, 1024u, 0u);
+    TEST_ASSERT_EQUAL(2000u, tracker.report.eta_ms);
+    progress_tracker_phase_end(&tracker, 4000u);
+    progress_tracker_finish(&tracker, true, 4000u);
+
+    /* the verify ran at 512 bytes/s, programming still uses the default */
+    progress_tracker_start(&tracker, PROGRESS_OP_BOOTLOADER, 10000u);
+    progress_tracker_phase(&tracker, PROGRESS_PHASE_VERIFY, 1024u, 128u, 1024u, 10000u);
+    TEST_ASSERT_EQUAL(2000u, tracker.report.eta_ms);
+    progress_tracker_phase(&tracker, PROGRESS_PHASE_PROGRAM, 1024u, 128u, 1024u, 10000u);
+    TEST_ASSERT_EQUAL(1000u, tracker.report.eta_ms);
+
+    /* a phase which is not marked as completed is not learned */
+    progress_tracker_finish(&tracker, false, 10010u);
+    TEST_ASSERT_EQUAL(PROGRESS_PHASE_FAILED, tracker.report.phase);
+    progress_tracker_start(&tracker, PROGRESS_OP_BOOTLOADER, 20000u);
+    progress_tracker_phase(&tracker, PROGRESS_PHASE_PROGRAM, 1024u, 128u, 1024u, 20000u);
+    TEST_ASSERT_EQUAL(1000u, tracker.report.eta_ms);
+
+    /* init forgets the throughputs */
+    progress_tracker_init(&tracker, 100u);
+    progress_tracker_start(&tracker, PROGRESS_OP_BOOTLOADER, 0u);
+    progress_tracker_phase(&tracker, PROGRESS_PHASE_VERIFY, 1024u, 128u, 1024u, 0u);
+    TEST_ASSERT_EQUAL(1000u, tracker.report.eta_ms);
+}
+
+/** Periodic reports are limited to one per interval, across a wrapping clock */
+static void test_interval(void) {
+    uint32_t start = UINT32_MAX - 150u;
+    uint32_t reports = 0u;
+
+    progress_tracker_init(&tracker, 100u);
+    progress_tracker_start(&tracker, PROGRESS_OP_OTA, start);
+    progress_tracker_phase(&tracker, PROGRESS_PHASE_WRITE, 0u, 0u, 0u, start);
+    for (uint32_t ms = 10u; ms <= 1000u; ms += 10u) {
+        if (progress_tracker_update(&tracker, ms, start + ms)) {
+            reports++;
+        }
+    }
+    TEST_ASSERT_EQUAL(10u, reports);
+    TEST_ASSERT_EQUAL(1000u, tracker.report.elapsed_ms);
+
+    TEST_ASSERT(!progress_tracker_tick(&tracker, start + 1050u));
+    TEST_ASSERT(progress_tracker_tick(&tracker, start + 1100u));
+}
+
+/** Names of the phases */
+static void test_names(void) {
+    TEST_ASSERT(strcmp(progress_phase_to_string(PROGRESS_PHASE_PROGRAM), "program") == 0);
+    TEST_ASSERT(strcmp(progress_phase_to_string(PROGRESS_PHASE_FAILED), "failed") == 0);
+    TEST_ASSERT(strcmp(progress_phase_to_string(PROGRESS_NR_OF_PHASES), "unknown") == 0);
+}
+
+static void test_listener_a(const progress_report_t *report, void *ctx) {
+    (void)report;
+    (void)ctx;
+}
+
+static void test_listener_b(const progress_report_t *report, void *ctx) {
+    (void)report;
+    (void)ctx;
+}
+
+/** A listener is registered once, also when it is added again */
+static void test_listeners(void) {
+    progress_listener_entry_t listeners[2];
+    int ctx = 0;
+
+    memset(listeners, 0, sizeof(listeners));
+    TEST_ASSERT(progress_listeners_add(listeners, 2u, test_listener_a, NULL));
+    TEST_ASSERT(progress_listeners_add(listeners, 2u, test_listener_a, NULL));
+    TEST_ASSERT(listeners[1].listener == NULL);
+
+    /* another context is another registration */
+    TEST_ASSERT(progress_listeners_add(listeners, 2u, test_listener_a, &ctx));
+    TEST_ASSERT(!progress_listeners_add(listeners, 2u, test_listener_b, NULL));
+    TEST_ASSERT(progress_listeners_add(listeners, 2u, test_listener_a, &ctx));
+
+    /* a removed listener frees its slot, an earlier free slot is used first */
+    progress_listeners_remove(listeners, 2u, test_listener_a, NULL);
+    TEST_ASSERT(listeners[0].listener == NULL);
+    TEST_ASSERT(progress_listeners_add(listeners, 2u, test_listener_b, NULL));
+    TEST_ASSERT(listeners[0].listener == test_listener_b);
+    TEST_ASSERT(listeners[1].ctx == &ctx);
+}
+
+int main(void) {
+    RUN_TEST(test_reported);
+    RUN_TEST(test_unknown_total);
+    RUN_TEST(test_estimated);
+    RUN_TEST(test_learned_rate);
+    RUN_TEST(test_interval);
+    RUN_TEST(test_names);
+    RUN_TEST(test_listeners);
+
+    return (test_failures == 0) ? 0 : 1;
+}
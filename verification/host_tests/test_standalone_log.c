@@ -0,0 +1,145 @@
+/**
+ * @file
+ * @brief Stand-alone programming cycle-time log host tests.
+ * @internal
+ *
+ * @copyright (C) 2025 Melexis N.V.
+ *
+ * Melexis N.V. is supplying this code for use with Melexis N.V. processor based microcontrollers only.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.  MELEXIS N.V. SHALL NOT IN ANY CIRCUMSTANCES,
+ * BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ * @endinternal
+ *
+ * @details Host tests for the cycle-time log of the stand-alone mode: counters, wrapping of the
+ * ring, validation of a stored log and the comma separated values.
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "standalone_log.h"
+
+#include "test_helpers.h"
+
+static standalone_log_t log_;
+
+/** Add a job with a result and a duration */
+static uint32_t test_add(standalone_result_t result, uint32_t duration_ms) {
+    standalone_record_t record = {
+        .uptime_s = 100u,
+        .duration_ms = duration_ms,
+        .pages = 12u,
+        .trigger = (uint8_t)STANDALONE_TRIGGER_GPIO,
+        .result = (uint8_t)result,
+    };
+
+    standalone_log_add(&log_, &record);
+
+    return record.job;
+}
+
+static void test_counters(void) {
+    standalone_log_init(&log_);
+    TEST_ASSERT(standalone_log_valid(&log_));
+    TEST_ASSERT(standalone_log_get(&log_, 0u) == NULL);
+    TEST_ASSERT_EQUAL(0u, standalone_log_average_ms(&log_.counters));
+
+    TEST_ASSERT_EQUAL(1u, test_add(STANDALONE_RESULT_PASS, 3000u));
+    TEST_ASSERT_EQUAL(2u, test_add(STANDALONE_RESULT_FAIL_PROGRAM, 500u));
+    TEST_ASSERT_EQUAL(3u, test_add(STANDALONE_RESULT_PASS, 2000u));
+    TEST_ASSERT_EQUAL(4u, test_add(STANDALONE_RESULT_PASS, 4000u));
+
+    /* failed jobs do not count in the cycle time */
+    TEST_ASSERT_EQUAL(4u, log_.counters.jobs);
+    TEST_ASSERT_EQUAL(3u, log_.counters.passed);
+    TEST_ASSERT_EQUAL(1u, log_.counters.failed);
+    TEST_ASSERT_EQUAL(2000u, log_.counters.min_ms);
+    TEST_ASSERT_EQUAL(4000u, log_.counters.max_ms);
+    TEST_ASSERT_EQUAL(3000u, standalone_log_average_ms(&log_.counters));
+    TEST_ASSERT(standalone_log_valid(&log_));
+
+    TEST_ASSERT_EQUAL(4u, log_.nr_of_records);
+    TEST_ASSERT_EQUAL(1u, standalone_log_get(&log_, 0u)->job);
+    TEST_ASSERT_EQUAL(500u, standalone_log_get(&log_, 1u)->duration_ms);
+    TEST_ASSERT(standalone_log_get(&log_, 4u) == NULL);
+}
+
+static void test_wrap(void) {
+    standalone_log_init(&log_);
+    for (uint32_t i = 0u; i < (STANDALONE_LOG_MAX_RECORDS + 5u); i++) {
+        (void)test_add(STANDALONE_RESULT_PASS, 1000u + i);
+    }
+
+    /* a new job is stored at the index of the oldest one */
+    standalone_record_t record = { .result = (uint8_t)STANDALONE_RESULT_CANCELLED };
+    uint32_t oldest = standalone_log_index(&log_, 0u);
+    TEST_ASSERT_EQUAL(oldest, standalone_log_add(&log_, &record));
+    TEST_ASSERT_EQUAL(record.job, standalone_log_get(&log_, STANDALONE_LOG_MAX_RECORDS - 1u)->job);
+    TEST_ASSERT_EQUAL(STANDALONE_LOG_MAX_RECORDS, standalone_log_index(&log_, STANDALONE_LOG_MAX_RECORDS));
+
+    /* the oldest jobs are dropped, the counters keep all jobs */
+    TEST_ASSERT_EQUAL(STANDALONE_LOG_MAX_RECORDS, log_.nr_of_records);
+    TEST_ASSERT_EQUAL(STANDALONE_LOG_MAX_RECORDS + 6u, log_.counters.jobs);
+    TEST_ASSERT_EQUAL(STANDALONE_LOG_MAX_RECORDS + 5u, log_.counters.passed);
+    TEST_ASSERT_EQUAL(7u, standalone_log_get(&log_, 0u)->job);
+    TEST_ASSERT_EQUAL(STANDALONE_LOG_MAX_RECORDS + 6u,
+                      standalone_log_get(&log_, STANDALONE_LOG_MAX_RECORDS - 1u)->job);
+    for (uint32_t i = 1u; i < STANDALONE_LOG_MAX_RECORDS; i++) {
+        TEST_ASSERT_EQUAL(standalone_log_get(&log_, i - 1u)->job + 1u, standalone_log_get(&log_, i)->job);
+    }
+    TEST_ASSERT(standalone_log_valid(&log_));
+}
+
+static void test_valid(void) {
+    standalone_log_init(&log_);
+    (void)test_add(STANDALONE_RESULT_PASS, 1000u);
+    TEST_ASSERT(standalone_log_valid(&log_));
+
+    log_.magic ^= 1u;
+    TEST_ASSERT(!standalone_log_valid(&log_));
+    log_.magic ^= 1u;
+    log_.next = STANDALONE_LOG_MAX_RECORDS;
+    TEST_ASSERT(!standalone_log_valid(&log_));
+    log_.next = 1u;
+    log_.counters.failed++;
+    TEST_ASSERT(!standalone_log_valid(&log_));
+    log_.counters.failed--;
+    log_.nr_of_records = 2u;
+    TEST_ASSERT(!standalone_log_valid(&log_));
+}
+
+static void test_format(void) {
+    char line[STANDALONE_LOG_CSV_LINE_LEN];
+    standalone_record_t record = {
+        .job = 4294967295u,
+        .uptime_s = 4294967295u,
+        .duration_ms = 4294967295u,
+        .pages = 65535u,
+        .skipped = 65535u,
+        .trigger = (uint8_t)STANDALONE_TRIGGER_REST,
+        .result = (uint8_t)STANDALONE_RESULT_FAIL_IMAGE,
+        .error = -32768,
+    };
+
+    /* the longest line fits */
+    size_t length = standalone_log_format(&record, line);
+    TEST_ASSERT_EQUAL(strlen(line), length);
+    TEST_ASSERT(strcmp(line, "4294967295,4294967295,rest,image_unavailable,-32768,4294967295,65535,65535\n") == 0);
+
+    standalone_log_init(&log_);
+    (void)test_add(STANDALONE_RESULT_PASS, 2345u);
+    (void)standalone_log_format(standalone_log_get(&log_, 0u), line);
+    TEST_ASSERT(strcmp(line, "1,100,gpio,pass,0,2345,12,0\n") == 0);
+}
+
+int main(void) {
+    RUN_TEST(test_counters);
+    RUN_TEST(test_wrap);
+    RUN_TEST(test_valid);
+    RUN_TEST(test_format);
+
+    return (test_failures == 0) ? 0 : 1;
+}
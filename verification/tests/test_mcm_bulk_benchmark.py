@@ -0,0 +1,248 @@
+"""MCM vendor bulk interface benchmark.
+
+Copyright Melexis N.V.
+
+This product includes software developed at Melexis N.V. (https://www.melexis.com).
+
+Melexis N.V. has provided this code according to LICENSE file attached to repository
+"""
+import binascii
+import struct
+import time
+
+import pytest
+import usb.core
+import usb.util
+
+MCM_USB_VID = 0x03E9
+MCM_USB_PID = 0x6F09
+
+MCM_VENDOR_REQUEST_BULK_BENCHMARK = 0x03
+
+MCM_BENCHMARK_ECHO = 0x0300
+MCM_BENCHMARK_SOURCE = 0x0301
+MCM_BENCHMARK_SOURCE_DATA = 0x0302
+MCM_BENCHMARK_SINK = 0x0303
+MCM_BENCHMARK_SINK_DATA = 0x0304
+MCM_BENCHMARK_RESULT = 0x0310
+MCM_BULK_MSG_GET_LATENCY = 0xFF01
+MCM_BULK_MSG_ERROR_REPORT = 0xFFFF
+
+BULK_HEADER = 0xAA55AA55
+BULK_HEADER_FORMAT = "<IHHI"
+BULK_HEADER_LEN = struct.calcsize(BULK_HEADER_FORMAT)
+BULK_CRC_SEED = 0x1D0F
+BULK_MAX_PAYLOAD = 4096
+
+LATENCY_BUCKETS_US = [100, 200, 500, 1000, 2000, 5000, 10000, 20000, 50000]
+
+
+def percentile(samples, pct):
+    """Get a percentile of a list of samples."""
+    ordered = sorted(samples)
+    index = min(len(ordered) - 1, int(round(pct / 100.0 * (len(ordered) - 1))))
+    return ordered[index]
+
+
+class BulkBenchmarkClient:
+    """Raw client for the benchmark command group of the vendor bulk interface."""
+
+    def __init__(self, serial=None):
+        kwargs = {"idVendor": MCM_USB_VID, "idProduct": MCM_USB_PID}
+        if serial is not None:
+            kwargs["serial_number"] = serial
+        self.dev = usb.core.find(**kwargs)
+        if self.dev is None:
+            pytest.skip("no MCM connected")
+        cfg = self.dev.get_active_configuration()
+        self.itf = usb.util.find_descriptor(cfg, bInterfaceClass=0xFF)
+        usb.util.claim_interface(self.dev, self.itf.bInterfaceNumber)
+        self.ep_out = usb.util.find_descriptor(
+            self.itf,
+            custom_match=lambda e: usb.util.endpoint_direction(e.bEndpointAddress) == usb.util.ENDPOINT_OUT)
+        self.ep_in = usb.util.find_descriptor(
+            self.itf,
+            custom_match=lambda e: usb.util.endpoint_direction(e.bEndpointAddress) == usb.util.ENDPOINT_IN)
+        self.rx_buffer = bytearray()
+        self.tag = 0
+
+    def close(self):
+        """Leave the benchmark mode and release the interface."""
+        self.set_mode(False)
+        usb.util.release_interface(self.dev, self.itf.bInterfaceNumber)
+        usb.util.dispose_resources(self.dev)
+
+    def set_mode(self, enable):
+        """Enable or disable the benchmark mode on the bulk interface."""
+        self.dev.ctrl_transfer(0x21, MCM_VENDOR_REQUEST_BULK_BENCHMARK, 1 if enable else 0,
+                               self.itf.bInterfaceNumber, None)
+        if enable:
+            self.rx_buffer = bytearray()
+
+    def next_tag(self):
+        """Get the next command tag."""
+        self.tag = (self.tag + 1) & 0xFFFFFFFF
+        return self.tag
+
+    @staticmethod
+    def encode(command, tag, payload=b""):
+        """Encode a bulk message."""
+        length = BULK_HEADER_LEN + len(payload) + 2
+        frame = struct.pack(BULK_HEADER_FORMAT, BULK_HEADER, length, command, tag) + bytes(payload)
+        return frame + struct.pack("<H", binascii.crc_hqx(frame, BULK_CRC_SEED))
+
+    def write(self, data):
+        """Write raw data to the bulk out endpoint."""
+        self.ep_out.write(data, timeout=5000)
+
+    def send(self, command, payload=b"", tag=None):
+        """Send a command and return its tag."""
+        tag = self.next_tag() if tag is None else tag
+        self.write(self.encode(command, tag, payload))
+        return tag
+
+    def receive(self, timeout=5.0):
+        """Receive the next message as (command, tag, payload)."""
+        deadline = time.perf_counter() + timeout
+        while True:
+            if len(self.rx_buffer) >= BULK_HEADER_LEN:
+                header, length, command, tag = struct.unpack_from(BULK_HEADER_FORMAT, self.rx_buffer)
+                assert header == BULK_HEADER, "lost synchronization on the bulk in endpoint"
+                if len(self.rx_buffer) >= length:
+                    frame = bytes(self.rx_buffer[:length])
+                    del self.rx_buffer[:length]
+                    crc = struct.unpack_from("<H", frame, length - 2)[0]
+                    assert crc == binascii.crc_hqx(frame[:-2], BULK_CRC_SEED), "crc error in response"
+                    payload = frame[BULK_HEADER_LEN:-2]
+                    if command == MCM_BULK_MSG_ERROR_REPORT:
+                        failed, error = struct.unpack_from("<HH", payload)
+                        raise AssertionError(f"command 0x{failed:04X} failed with {error}: {payload[4:]}")
+                    return command, tag, payload
+            remaining = deadline - time.perf_counter()
+            assert remaining > 0, "timeout waiting for a bulk message"
+            try:
+                self.rx_buffer += self.ep_in.read(16384, timeout=max(1, int(remaining * 1000)))
+            except usb.core.USBTimeoutError:
+                pass
+
+    def read_result(self):
+        """Read the benchmark result message as (bytes, messages, duration_us, drops)."""
+        while True:
+            command, _, payload = self.receive()
+            if command == MCM_BENCHMARK_RESULT:
+                return struct.unpack("<IIII", payload)
+
+    def read_latency(self, reset=False):
+        """Read the device command-to-response latency histogram."""
+        tag = self.send(MCM_BULK_MSG_GET_LATENCY, bytes([1 if reset else 0]))
+        command, rx_tag, payload = self.receive()
+        assert (command, rx_tag) == (MCM_BULK_MSG_GET_LATENCY, tag)
+        count, min_us, max_us = struct.unpack_from("<III", payload)
+        buckets = struct.unpack_from(f"<{len(LATENCY_BUCKETS_US) + 1}I", payload, 12)
+        return count, min_us, max_us, buckets
+
+
+@pytest.fixture(name="bulk_benchmark")
+def fixture_bulk_benchmark(serial_number):
+    """Connect to the benchmark interface of the MCM."""
+    client = BulkBenchmarkClient(serial_number)
+    client.set_mode(True)
+    client.read_latency(reset=True)
+    yield client
+    count, min_us, max_us, buckets = client.read_latency()
+    limits = [f"<{limit}us" for limit in LATENCY_BUCKETS_US] + [f">={LATENCY_BUCKETS_US[-1]}us"]
+    print(f"\ndevice latency: {count} commands, min {min_us} us, max {max_us} us")
+    print("device latency: " + ", ".join(f"{limit}: {nr}" for limit, nr in zip(limits, buckets)))
+    client.close()
+
+
+@pytest.mark.webusb
+@pytest.mark.benchmark
+@pytest.mark.parametrize("payload_len", [0, 64, 512, BULK_MAX_PAYLOAD])
+def test_bulk_echo_latency(bulk_benchmark, payload_len):
+    """Measure the round trip latency of single echo commands."""
+    payload = bytes(i & 0xFF for i in range(payload_len))
+    samples = []
+    for _ in range(500):
+        start = time.perf_counter()
+        tag = bulk_benchmark.send(MCM_BENCHMARK_ECHO, payload)
+        command, rx_tag, rx_payload = bulk_benchmark.receive()
+        samples.append(time.perf_counter() - start)
+        assert (command, rx_tag, rx_payload) == (MCM_BENCHMARK_ECHO, tag, payload)
+    print(f"\necho {payload_len} B: p50 {percentile(samples, 50) * 1e3:.3f} ms, "
+          f"p99 {percentile(samples, 99) * 1e3:.3f} ms, max {max(samples) * 1e3:.3f} ms")
+
+
+@pytest.mark.webusb
+@pytest.mark.benchmark
+def test_bulk_echo_pipelined(bulk_benchmark):
+    """Measure the loopback throughput with several outstanding echo commands."""
+    payload = bytes(i & 0xFF for i in range(BULK_MAX_PAYLOAD))
+    window = 8
+    nr_of_commands = 1000
+    outstanding = []
+    sent = 0
+    start = time.perf_counter()
+    while sent < nr_of_commands or outstanding:
+        while sent < nr_of_commands and len(outstanding) < window:
+            outstanding.append(bulk_benchmark.send(MCM_BENCHMARK_ECHO, payload))
+            sent += 1
+        command, rx_tag, rx_payload = bulk_benchmark.receive()
+        assert (command, rx_tag) == (MCM_BENCHMARK_ECHO, outstanding.pop(0))
+        assert rx_payload == payload
+    elapsed = time.perf_counter() - start
+    print(f"\nloopback: {2 * nr_of_commands * len(payload) / elapsed / 1e6:.3f} MB/s (both directions)")
+
+
+@pytest.mark.webusb
+@pytest.mark.benchmark
+@pytest.mark.parametrize("chunk_len", [64, 512, BULK_MAX_PAYLOAD])
+def test_bulk_device_source(bulk_benchmark, chunk_len):
+    """Measure the device to host throughput."""
+    nr_of_bytes = 2 * 1024 * 1024
+    start = time.perf_counter()
+    bulk_benchmark.send(MCM_BENCHMARK_SOURCE, struct.pack("<IHH", nr_of_bytes, chunk_len, 0))
+    received = 0
+    while True:
+        command, _, payload = bulk_benchmark.receive()
+        if command == MCM_BENCHMARK_RESULT:
+            break
+        assert command == MCM_BENCHMARK_SOURCE_DATA
+        assert payload == bytes((received + i) & 0xFF for i in range(len(payload)))
+        received += len(payload)
+    elapsed = time.perf_counter() - start
+    nr_bytes, nr_msgs, duration_us, drops = struct.unpack("<IIII", payload)
+    print(f"\nsource {chunk_len} B chunks: host {received / elapsed / 1e6:.3f} MB/s, "
+          f"device {nr_bytes / max(duration_us, 1):.3f} MB/s, {nr_msgs} messages, {drops} drops")
+    assert drops == 0
+    assert received == nr_of_bytes
+
+
+@pytest.mark.webusb
+@pytest.mark.benchmark
+@pytest.mark.parametrize("chunk_len", [64, 512, BULK_MAX_PAYLOAD])
+def test_bulk_device_sink(bulk_benchmark, chunk_len):
+    """Measure the host to device throughput."""
+    nr_of_bytes = 2 * 1024 * 1024
+    tag = bulk_benchmark.send(MCM_BENCHMARK_SINK, struct.pack("<I", nr_of_bytes))
+    assert bulk_benchmark.receive()[:2] == (MCM_BENCHMARK_SINK, tag)
+    chunk = bytes(i & 0xFF for i in range(chunk_len))
+    # send several messages per transfer to keep the bus busy
+    per_write = max(1, 16384 // (chunk_len + BULK_HEADER_LEN + 2))
+    start = time.perf_counter()
+    sent = 0
+    while sent < nr_of_bytes:
+        data = bytearray()
+        for _ in range(per_write):
+            if sent >= nr_of_bytes:
+                break
+            part = chunk[:nr_of_bytes - sent]
+            data += bulk_benchmark.encode(MCM_BENCHMARK_SINK_DATA, bulk_benchmark.next_tag(), part)
+            sent += len(part)
+        bulk_benchmark.write(data)
+    nr_bytes, nr_msgs, duration_us, drops = bulk_benchmark.read_result()
+    elapsed = time.perf_counter() - start
+    print(f"\nsink {chunk_len} B chunks: host {sent / elapsed / 1e6:.3f} MB/s, "
+          f"device {nr_bytes / max(duration_us, 1):.3f} MB/s, {nr_msgs} messages, {drops} drops")
+    assert drops == 0
+    assert nr_bytes == nr_of_bytes